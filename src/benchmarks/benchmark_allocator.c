@@ -0,0 +1,192 @@
+/**
+ * @file benchmark_allocator.c
+ * @brief Library workloads under the default malloc allocator vs the slab allocator
+ *
+ * Each workload runs once with the default allocator and once with a
+ * SylvesSlabAllocator installed through sylves_set_allocator:
+ * - mixed_sizes: replaces random slots of a working set with blocks of
+ *   8-512 bytes, the shape of the library's small bookkeeping allocations
+ * - cache_churn: puts random keys into a small LRU cache so most puts
+ *   evict, churning entries and key copies
+ * - spatial_churn: inserts and removes points in a grid-hash spatial index
+ * - mesh_grids: builds and destroys small mesh grids, as chunk streaming does
+ * - threaded_mixed: mixed_sizes on `threads` workers at once
+ *
+ * Usage: benchmark_allocator [ops=1000000] [threads=4]
+ */
+
+#include <sylves/sylves.h>
+#include <sylves/cache.h>
+#include <sylves/memory_pool.h>
+#include <sylves/spatial_index.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define WORKING_SET 4096
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static unsigned next_random(unsigned* seed) {
+    *seed = *seed * 1103515245u + 12345u;
+    return *seed >> 8;
+}
+
+typedef struct {
+    long ops;
+    unsigned seed;
+    long long checksum;
+} Workload;
+
+static void* mixed_sizes(void* arg) {
+    Workload* w = (Workload*)arg;
+    void* slots[WORKING_SET] = { NULL };
+    for (long i = 0; i < w->ops; i++) {
+        unsigned r = next_random(&w->seed);
+        size_t slot = r % WORKING_SET;
+        sylves_free(slots[slot]);
+        size_t size = 8 + (r >> 12) % 505;
+        slots[slot] = sylves_alloc(size);
+        *(char*)slots[slot] = (char)size;
+        w->checksum += *(char*)slots[slot];
+    }
+    for (int i = 0; i < WORKING_SET; i++) {
+        sylves_free(slots[i]);
+    }
+    return NULL;
+}
+
+static void cache_churn(Workload* w) {
+    SylvesCacheConfig config = { .max_entries = 1024, .policy = SYLVES_CACHE_POLICY_LRU };
+    SylvesCache* cache = sylves_cache_create(&config, sizeof(int) * 4, NULL, NULL, NULL, NULL);
+    for (long i = 0; i < w->ops; i++) {
+        int key[4] = { (int)(next_random(&w->seed) % 100000), 1, 2, 3 };
+        sylves_cache_put(cache, key, &w->checksum);
+        if (sylves_cache_get(cache, key)) w->checksum++;
+    }
+    sylves_cache_destroy(cache);
+}
+
+static void spatial_churn(Workload* w) {
+    SylvesSpatialIndexConfig config = { .type = SYLVES_SPATIAL_INDEX_GRID_HASH, .bucket_size = 1 << 12 };
+    SylvesSpatialIndex* index = sylves_spatial_index_create(&config, 2);
+    for (long i = 0; i < w->ops; i++) {
+        SylvesCell cell = { (int)(next_random(&w->seed) % WORKING_SET), 0, 0 };
+        if (sylves_spatial_index_remove(index, &cell) != SYLVES_SUCCESS) {
+            SylvesVector3 p = { (double)(next_random(&w->seed) % 1000), (double)(next_random(&w->seed) % 1000), 0.0 };
+            sylves_spatial_index_insert(index, &cell, &p, NULL);
+            w->checksum++;
+        }
+    }
+    sylves_spatial_index_destroy(index);
+}
+
+static void mesh_grids(Workload* w) {
+    enum { SIDE = 8 };
+    SylvesVector3 vertices[(SIDE + 1) * (SIDE + 1)];
+    int indices[SIDE * SIDE * 4];
+    int sizes[SIDE * SIDE];
+    for (int y = 0; y <= SIDE; y++) {
+        for (int x = 0; x <= SIDE; x++) {
+            vertices[y * (SIDE + 1) + x] = sylves_vector3_create(x, y, 0.0);
+        }
+    }
+    for (int y = 0; y < SIDE; y++) {
+        for (int x = 0; x < SIDE; x++) {
+            int* face = &indices[(y * SIDE + x) * 4];
+            face[0] = y * (SIDE + 1) + x;
+            face[1] = face[0] + 1;
+            face[2] = face[1] + SIDE + 1;
+            face[3] = face[0] + SIDE + 1;
+            sizes[y * SIDE + x] = 4;
+        }
+    }
+    long grids = w->ops / 1000 > 0 ? w->ops / 1000 : 1;
+    for (long i = 0; i < grids; i++) {
+        SylvesGrid* grid = sylves_mesh_grid_create_from_arrays(vertices, (SIDE + 1) * (SIDE + 1),
+                                                               indices, sizes, SIDE * SIDE);
+        if (grid) {
+            w->checksum += sylves_grid_get_index_count(grid);
+            sylves_grid_destroy(grid);
+        }
+    }
+}
+
+static void threaded_mixed(Workload* w, int threads) {
+    pthread_t ids[64];
+    Workload workers[64];
+    for (int t = 0; t < threads; t++) {
+        workers[t] = (Workload){ w->ops / threads, w->seed + 7919u * (unsigned)t, 0 };
+        pthread_create(&ids[t], NULL, mixed_sizes, &workers[t]);
+    }
+    for (int t = 0; t < threads; t++) {
+        pthread_join(ids[t], NULL);
+        w->checksum += workers[t].checksum;
+    }
+}
+
+static double run(int workload, long ops, int threads, long long* checksum) {
+    Workload w = { ops, 12345u, 0 };
+    double start = now_seconds();
+    switch (workload) {
+        case 0: mixed_sizes(&w); break;
+        case 1: cache_churn(&w); break;
+        case 2: spatial_churn(&w); break;
+        case 3: mesh_grids(&w); break;
+        default: threaded_mixed(&w, threads); break;
+    }
+    *checksum += w.checksum;
+    return (now_seconds() - start) * 1e3;
+}
+
+int main(int argc, char** argv) {
+    long ops = argc > 1 ? atol(argv[1]) : 1000000;
+    int threads = argc > 2 ? atoi(argv[2]) : 4;
+    if (ops <= 0 || threads <= 0 || threads > 64) {
+        fprintf(stderr, "usage: %s [ops] [threads<=64]\n", argv[0]);
+        return 1;
+    }
+
+    static const char* names[] = { "mixed_sizes", "cache_churn", "spatial_churn", "mesh_grids", "threaded_mixed" };
+    SylvesSlabAllocator* slab = sylves_slab_allocator_create(0);
+    if (!slab) {
+        fprintf(stderr, "allocation failed\n");
+        return 1;
+    }
+
+    printf("Allocator workloads, %ld ops, %d threads for threaded_mixed (ms)\n", ops, threads);
+    printf("%-16s %12s %12s %10s\n", "workload", "malloc", "slab", "speedup");
+    long long checksum = 0;
+    for (int workload = 0; workload < 5; workload++) {
+        double malloc_ms = run(workload, ops, threads, &checksum);
+        sylves_set_allocator(sylves_slab_allocator_get_interface(slab));
+        double slab_ms = run(workload, ops, threads, &checksum);
+        sylves_set_allocator(NULL);
+        printf("%-16s %12.1f %12.1f %9.2fx\n", names[workload], malloc_ms, slab_ms, malloc_ms / slab_ms);
+    }
+    printf("checksum %lld\n", checksum);
+
+    printf("\nSlab classes in use\n%-10s %12s %12s %12s\n", "class", "allocs", "active", "bytes");
+    size_t class_count = sylves_slab_allocator_get_class_count(slab);
+    for (size_t i = 0; i <= class_count; i++) {
+        SylvesPoolStats stats;
+        sylves_slab_allocator_get_stats(slab, i, &stats);
+        if (stats.total_allocations == 0) continue;
+        char label[16];
+        if (i < class_count) {
+            snprintf(label, sizeof(label), "%zu", sylves_slab_allocator_get_class_size(slab, i));
+        } else {
+            snprintf(label, sizeof(label), "large");
+        }
+        printf("%-10s %12zu %12zu %12zu\n", label, stats.total_allocations, stats.active_allocations,
+               stats.total_memory_used);
+    }
+
+    sylves_slab_allocator_destroy(slab);
+    return 0;
+}
@@ -0,0 +1,196 @@
+/**
+ * @file benchmark_cache_policies.c
+ * @brief Hit rate and lookup cost of each cache eviction policy on cell traces
+ *
+ * Every trace is replayed against a cell-keyed SylvesCache per policy: a
+ * lookup per access, and a put on each miss, as a per-cell mesh or polygon
+ * cache is used. The built-in traces are synthetic, shaped after the
+ * library's own access patterns on a SIDE x SIDE grid:
+ * - hotspots: cells drawn with a power-law skew around a few points of
+ *   interest, as units crowding objectives produce
+ * - camera_pan: a square viewport sweeping the map row by row, every
+ *   visible cell touched each frame
+ * - agents_scan: agents random-walking between their own cells, broken up
+ *   by full-map sweeps such as a flow field rebuild
+ * A trace recorded from an application can be replayed instead by passing
+ * a file of "x y z" lines.
+ *
+ * Usage: benchmark_cache_policies [capacity=1024] [accesses=1000000] [trace_file]
+ */
+
+#include <sylves/sylves.h>
+#include <sylves/cache.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define SIDE 256
+#define VIEWPORT 24
+#define AGENTS 64
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static unsigned next_random(unsigned* seed) {
+    *seed = *seed * 1103515245u + 12345u;
+    return *seed >> 8;
+}
+
+static double next_unit(unsigned* seed) {
+    return (double)(next_random(seed) & 0xFFFFFF) / (double)0x1000000;
+}
+
+typedef struct {
+    SylvesCell* cells;
+    size_t count;
+} Trace;
+
+static void hotspots(Trace* trace, unsigned seed) {
+    static const int centers[4][2] = { { 40, 60 }, { 200, 30 }, { 128, 128 }, { 70, 210 } };
+    for (size_t i = 0; i < trace->count; i++) {
+        const int* center = centers[next_random(&seed) % 4];
+        /* Cubing a uniform draw piles accesses near the centre and leaves a long tail */
+        double u = next_unit(&seed);
+        int radius = (int)(u * u * u * SIDE / 2);
+        int dx = radius > 0 ? (int)(next_random(&seed) % (2 * radius + 1)) - radius : 0;
+        int dy = radius > 0 ? (int)(next_random(&seed) % (2 * radius + 1)) - radius : 0;
+        trace->cells[i] = (SylvesCell){ (center[0] + dx + SIDE) % SIDE, (center[1] + dy + SIDE) % SIDE, 0 };
+    }
+}
+
+static void camera_pan(Trace* trace, unsigned seed) {
+    (void)seed;
+    size_t i = 0;
+    for (int frame = 0; i < trace->count; frame++) {
+        /* One cell per frame along a row, then down a row: a boustrophedon sweep */
+        int row = (frame / (SIDE - VIEWPORT)) % (SIDE - VIEWPORT);
+        int col = frame % (SIDE - VIEWPORT);
+        if (row % 2 == 1) col = SIDE - VIEWPORT - 1 - col;
+        for (int y = 0; y < VIEWPORT && i < trace->count; y++) {
+            for (int x = 0; x < VIEWPORT && i < trace->count; x++) {
+                trace->cells[i++] = (SylvesCell){ col + x, row + y, 0 };
+            }
+        }
+    }
+}
+
+static void agents_scan(Trace* trace, unsigned seed) {
+    int agents[AGENTS][2];
+    for (int a = 0; a < AGENTS; a++) {
+        agents[a][0] = (int)(next_random(&seed) % SIDE);
+        agents[a][1] = (int)(next_random(&seed) % SIDE);
+    }
+    size_t i = 0;
+    while (i < trace->count) {
+        /* Agents step within a few cells of home, looking at their cell and a neighbour */
+        for (int step = 0; step < 20000 && i < trace->count; step++) {
+            int* agent = agents[next_random(&seed) % AGENTS];
+            int x = (agent[0] + (int)(next_random(&seed) % 7) - 3 + SIDE) % SIDE;
+            int y = (agent[1] + (int)(next_random(&seed) % 7) - 3 + SIDE) % SIDE;
+            trace->cells[i++] = (SylvesCell){ x, y, 0 };
+            if (i < trace->count) trace->cells[i++] = (SylvesCell){ (x + 1) % SIDE, y, 0 };
+        }
+        for (int c = 0; c < SIDE * SIDE && i < trace->count; c++) {
+            trace->cells[i++] = (SylvesCell){ c % SIDE, c / SIDE, 0 };
+        }
+    }
+}
+
+static bool load_trace(Trace* trace, const char* path) {
+    FILE* file = fopen(path, "r");
+    if (!file) return false;
+    size_t capacity = 1 << 16;
+    trace->cells = (SylvesCell*)malloc(capacity * sizeof(SylvesCell));
+    trace->count = 0;
+    SylvesCell cell;
+    while (trace->cells && fscanf(file, "%d %d %d", &cell.x, &cell.y, &cell.z) == 3) {
+        if (trace->count == capacity) {
+            capacity *= 2;
+            SylvesCell* cells = (SylvesCell*)realloc(trace->cells, capacity * sizeof(SylvesCell));
+            if (!cells) break;
+            trace->cells = cells;
+        }
+        trace->cells[trace->count++] = cell;
+    }
+    fclose(file);
+    return trace->cells && trace->count > 0;
+}
+
+static void replay(const Trace* trace, size_t capacity, SylvesCachePolicy policy,
+                   double* hit_rate, double* ns_per_access) {
+    static int value;
+    SylvesCacheConfig config = { .max_entries = capacity, .policy = policy };
+    SylvesCache* cache = sylves_cache_create(&config, sizeof(SylvesCell), NULL, NULL, NULL, NULL);
+    size_t hits = 0;
+    double start = now_seconds();
+    for (size_t i = 0; i < trace->count; i++) {
+        if (sylves_cache_get(cache, &trace->cells[i])) {
+            hits++;
+        } else {
+            sylves_cache_put(cache, &trace->cells[i], &value);
+        }
+    }
+    double elapsed = now_seconds() - start;
+    sylves_cache_destroy(cache);
+    *hit_rate = 100.0 * (double)hits / (double)trace->count;
+    *ns_per_access = elapsed * 1e9 / (double)trace->count;
+}
+
+int main(int argc, char** argv) {
+    long capacity = argc > 1 ? atol(argv[1]) : 1024;
+    long accesses = argc > 2 ? atol(argv[2]) : 1000000;
+    if (capacity <= 0 || accesses <= 0) {
+        fprintf(stderr, "usage: %s [capacity] [accesses] [trace_file]\n", argv[0]);
+        return 1;
+    }
+
+    static const char* policy_names[] = { "lru", "lfu", "fifo", "random", "tinylfu" };
+    static const SylvesCachePolicy policies[] = {
+        SYLVES_CACHE_POLICY_LRU, SYLVES_CACHE_POLICY_LFU, SYLVES_CACHE_POLICY_FIFO,
+        SYLVES_CACHE_POLICY_RANDOM, SYLVES_CACHE_POLICY_TINYLFU
+    };
+    enum { POLICY_COUNT = 5 };
+
+    static const char* trace_names[] = { "hotspots", "camera_pan", "agents_scan" };
+    static void (*generators[])(Trace*, unsigned) = { hotspots, camera_pan, agents_scan };
+    int trace_count = 3;
+    Trace trace = { NULL, 0 };
+    if (argc > 3) {
+        if (!load_trace(&trace, argv[3])) {
+            fprintf(stderr, "could not read a trace from %s\n", argv[3]);
+            free(trace.cells);
+            return 1;
+        }
+        trace_names[0] = argv[3];
+        trace_count = 1;
+    }
+
+    printf("Cache policies, capacity %ld, hit rate %% / ns per access\n", capacity);
+    printf("%-14s", "trace");
+    for (int p = 0; p < POLICY_COUNT; p++) printf(" %16s", policy_names[p]);
+    printf("\n");
+    for (int t = 0; t < trace_count; t++) {
+        if (argc <= 3) {
+            trace.count = (size_t)accesses;
+            trace.cells = (SylvesCell*)malloc(trace.count * sizeof(SylvesCell));
+            if (!trace.cells) {
+                fprintf(stderr, "allocation failed\n");
+                return 1;
+            }
+            generators[t](&trace, 12345u + (unsigned)t);
+        }
+        printf("%-14s", trace_names[t]);
+        for (int p = 0; p < POLICY_COUNT; p++) {
+            double hit_rate, ns;
+            replay(&trace, (size_t)capacity, policies[p], &hit_rate, &ns);
+            printf(" %8.2f /%6.1f", hit_rate, ns);
+        }
+        printf("\n");
+        free(trace.cells);
+        trace.cells = NULL;
+    }
+    return 0;
+}
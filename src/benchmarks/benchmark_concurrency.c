@@ -0,0 +1,278 @@
+/**
+ * @file benchmark_concurrency.c
+ * @brief Read-mostly throughput of the thread-safe spatial index and cache, 1 to N threads
+ *
+ * Each worker runs a fixed number of operations, of which roughly one in
+ * `write_every` mutates (index insert/remove, cache put) and the rest are
+ * lookups (index query_aabb, cache get). The cache runs once with a single
+ * shard and once sharded to show what striping buys.
+ *
+ * A second table compares the mutex-guarded SylvesMemoryPool with the
+ * lock-free SylvesConcurrentPool: "local" workers free their own blocks,
+ * "handoff" workers free the batch their neighbour just allocated, as a
+ * producer/consumer pipeline would.
+ *
+ * Usage: benchmark_concurrency [max_threads=64] [ops_per_thread=200000] [write_every=100]
+ */
+
+#include <sylves/sylves.h>
+#include <sylves/spatial_index.h>
+#include <sylves/cache.h>
+#include <sylves/memory_pool.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define WORLD_SIZE 1000.0
+#define INDEX_POINTS 100000
+#define CACHE_KEYS 50000
+#define POOL_BLOCK 32
+#define POOL_BATCH 256
+
+typedef struct {
+    SylvesSpatialIndex* index;
+    SylvesCache* cache;
+    long ops;
+    long write_every;
+    unsigned seed;
+    long long checksum;
+} Worker;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static unsigned next_random(unsigned* seed) {
+    *seed = *seed * 1103515245u + 12345u;
+    return *seed >> 8;
+}
+
+static double next_uniform(unsigned* seed) {
+    return (next_random(seed) & 0xFFFFFF) / (double)0x1000000;
+}
+
+static bool count_visitor(const SylvesCell* cell, void* data, void* user_data) {
+    (void)data;
+    *(long long*)user_data += cell->x;
+    return true;
+}
+
+static void* index_worker(void* arg) {
+    Worker* w = (Worker*)arg;
+    for (long i = 0; i < w->ops; i++) {
+        double x = next_uniform(&w->seed) * WORLD_SIZE;
+        double y = next_uniform(&w->seed) * WORLD_SIZE;
+        if (i % w->write_every == 0) {
+            /* Move one of the indexed points */
+            SylvesCell cell = { (int)(next_random(&w->seed) % INDEX_POINTS), 0, 0 };
+            SylvesVector3 p = { x, y, 0.0 };
+            sylves_spatial_index_remove(w->index, &cell);
+            sylves_spatial_index_insert(w->index, &cell, &p, NULL);
+        } else {
+            SylvesAabb box = { { x - 2.0, y - 2.0, 0.0 }, { x + 2.0, y + 2.0, 0.0 } };
+            sylves_spatial_index_query_aabb(w->index, &box, count_visitor, &w->checksum);
+        }
+    }
+    return NULL;
+}
+
+static void* cache_worker(void* arg) {
+    Worker* w = (Worker*)arg;
+    for (long i = 0; i < w->ops; i++) {
+        int key = (int)(next_random(&w->seed) % CACHE_KEYS);
+        if (i % w->write_every == 0) {
+            int* value = (int*)malloc(sizeof(int));
+            *value = key;
+            sylves_cache_put(w->cache, &key, value);
+        } else if (sylves_cache_get(w->cache, &key)) {
+            w->checksum++;
+        }
+    }
+    return NULL;
+}
+
+/* Returns thousand operations per second across all threads */
+static double run_threads(int thread_count, void* (*body)(void*), SylvesSpatialIndex* index,
+                          SylvesCache* cache, long ops, long write_every, long long* checksum) {
+    pthread_t threads[256];
+    Worker workers[256];
+    for (int t = 0; t < thread_count; t++) {
+        workers[t] = (Worker){ index, cache, ops, write_every, 1000u + 7919u * (unsigned)t, 0 };
+    }
+
+    double start = now_seconds();
+    for (int t = 0; t < thread_count; t++) {
+        pthread_create(&threads[t], NULL, body, &workers[t]);
+    }
+    for (int t = 0; t < thread_count; t++) {
+        pthread_join(threads[t], NULL);
+        *checksum += workers[t].checksum;
+    }
+    double seconds = now_seconds() - start;
+    return (double)ops * thread_count / seconds / 1e3;
+}
+
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    int count;
+    int waiting;
+    unsigned phase;
+} Barrier;
+
+static void barrier_wait(Barrier* b) {
+    pthread_mutex_lock(&b->lock);
+    unsigned phase = b->phase;
+    if (++b->waiting == b->count) {
+        b->waiting = 0;
+        b->phase++;
+        pthread_cond_broadcast(&b->cond);
+    } else {
+        while (phase == b->phase) pthread_cond_wait(&b->cond, &b->lock);
+    }
+    pthread_mutex_unlock(&b->lock);
+}
+
+typedef struct PoolWorker {
+    SylvesMemoryPool* locked;
+    SylvesConcurrentPool* concurrent;
+    Barrier* barrier;               /* NULL frees locally, otherwise hands off */
+    struct PoolWorker* neighbour;
+    long rounds;
+    void* batch[POOL_BATCH];
+} PoolWorker;
+
+static void* pool_worker(void* arg) {
+    PoolWorker* w = (PoolWorker*)arg;
+    for (long r = 0; r < w->rounds; r++) {
+        for (int i = 0; i < POOL_BATCH; i++) {
+            w->batch[i] = w->concurrent ? sylves_concurrent_pool_alloc(w->concurrent) : sylves_pool_alloc(w->locked);
+            *(long*)w->batch[i] = r;
+        }
+        PoolWorker* owner = w;
+        if (w->barrier) {
+            barrier_wait(w->barrier);
+            owner = w->neighbour;
+        }
+        for (int i = 0; i < POOL_BATCH; i++) {
+            if (w->concurrent) {
+                sylves_concurrent_pool_free(w->concurrent, owner->batch[i]);
+            } else {
+                sylves_pool_free(w->locked, owner->batch[i]);
+            }
+        }
+        if (w->barrier) barrier_wait(w->barrier);
+    }
+    return NULL;
+}
+
+/* Returns thousand alloc/free pairs per second across all threads */
+static double run_pool(int thread_count, bool concurrent, bool handoff, long ops) {
+    pthread_t threads[256];
+    PoolWorker* workers = (PoolWorker*)calloc((size_t)thread_count, sizeof(PoolWorker));
+    Barrier barrier = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, thread_count, 0, 0 };
+    SylvesPoolConfig config = { .block_size = POOL_BLOCK, .initial_capacity = 1024, .thread_safe = true };
+    SylvesMemoryPool* locked = concurrent ? NULL : sylves_memory_pool_create(&config);
+    SylvesConcurrentPool* pool = concurrent ? sylves_concurrent_pool_create(POOL_BLOCK, 0) : NULL;
+    long rounds = ops / POOL_BATCH > 0 ? ops / POOL_BATCH : 1;
+    for (int t = 0; t < thread_count; t++) {
+        workers[t] = (PoolWorker){ locked, pool, handoff ? &barrier : NULL,
+                                   &workers[(t + 1) % thread_count], rounds, { NULL } };
+    }
+
+    double start = now_seconds();
+    for (int t = 0; t < thread_count; t++) {
+        pthread_create(&threads[t], NULL, pool_worker, &workers[t]);
+    }
+    for (int t = 0; t < thread_count; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    double seconds = now_seconds() - start;
+
+    sylves_memory_pool_destroy(locked);
+    sylves_concurrent_pool_destroy(pool);
+    free(workers);
+    return (double)rounds * POOL_BATCH * thread_count / seconds / 1e3;
+}
+
+static SylvesSpatialIndex* build_index(SylvesSpatialIndexType type) {
+    SylvesSpatialIndexConfig config = { .type = type, .bucket_size = 1 << 16, .thread_safe = true };
+    SylvesSpatialIndex* index = sylves_spatial_index_create(&config, 2);
+    SylvesCell* cells = (SylvesCell*)malloc(sizeof(SylvesCell) * INDEX_POINTS);
+    SylvesVector3* points = (SylvesVector3*)malloc(sizeof(SylvesVector3) * INDEX_POINTS);
+    unsigned seed = 42;
+    for (int i = 0; i < INDEX_POINTS; i++) {
+        cells[i] = (SylvesCell){ i, 0, 0 };
+        points[i] = sylves_vector3_create(next_uniform(&seed) * WORLD_SIZE,
+                                          next_uniform(&seed) * WORLD_SIZE, 0.0);
+    }
+    sylves_spatial_index_insert_batch(index, cells, points, INDEX_POINTS);
+    free(cells);
+    free(points);
+    return index;
+}
+
+static SylvesCache* build_cache(size_t shard_count) {
+    SylvesCacheConfig config = {
+        .max_entries = CACHE_KEYS,
+        .policy = SYLVES_CACHE_POLICY_LRU,
+        .thread_safe = true,
+        .track_stats = false,
+        .shard_count = shard_count
+    };
+    SylvesCache* cache = sylves_cache_create(&config, sizeof(int), NULL, NULL, free, NULL);
+    for (int key = 0; key < CACHE_KEYS; key++) {
+        int* value = (int*)malloc(sizeof(int));
+        *value = key;
+        sylves_cache_put(cache, &key, value);
+    }
+    return cache;
+}
+
+int main(int argc, char** argv) {
+    int max_threads = argc > 1 ? atoi(argv[1]) : 64;
+    long ops = argc > 2 ? atol(argv[2]) : 200000;
+    long write_every = argc > 3 ? atol(argv[3]) : 100;
+    if (max_threads <= 0 || max_threads > 256 || ops <= 0 || write_every <= 0) {
+        fprintf(stderr, "usage: %s [max_threads<=256] [ops_per_thread] [write_every]\n", argv[0]);
+        return 1;
+    }
+
+    printf("Read-mostly throughput: %ld ops/thread, 1 write per %ld ops (kops/s)\n", ops, write_every);
+    printf("%-8s %12s %12s %14s %14s\n", "threads", "index kd", "index hash", "cache 1 shard", "cache sharded");
+
+    long long checksum = 0;
+    SylvesSpatialIndex* kd = build_index(SYLVES_SPATIAL_INDEX_KDTREE);
+    SylvesSpatialIndex* hash = build_index(SYLVES_SPATIAL_INDEX_GRID_HASH);
+    SylvesCache* single = build_cache(1);
+    SylvesCache* sharded = build_cache(0);
+
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        double kd_rate = run_threads(threads, index_worker, kd, NULL, ops, write_every, &checksum);
+        double hash_rate = run_threads(threads, index_worker, hash, NULL, ops, write_every, &checksum);
+        double single_rate = run_threads(threads, cache_worker, NULL, single, ops, write_every, &checksum);
+        double sharded_rate = run_threads(threads, cache_worker, NULL, sharded, ops, write_every, &checksum);
+        printf("%-8d %12.1f %12.1f %14.1f %14.1f\n", threads, kd_rate, hash_rate, single_rate, sharded_rate);
+    }
+    printf("checksum %lld\n", checksum);
+
+    printf("\nPool alloc/free pairs: %ld per thread, %d-byte blocks (kops/s)\n", ops, POOL_BLOCK);
+    printf("%-8s %12s %12s %14s %14s\n", "threads", "mutex local", "lockfree loc", "mutex handoff", "lockfree hand");
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        double locked_local = run_pool(threads, false, false, ops);
+        double concurrent_local = run_pool(threads, true, false, ops);
+        double locked_handoff = run_pool(threads, false, true, ops);
+        double concurrent_handoff = run_pool(threads, true, true, ops);
+        printf("%-8d %12.1f %12.1f %14.1f %14.1f\n", threads, locked_local, concurrent_local,
+               locked_handoff, concurrent_handoff);
+    }
+
+    sylves_spatial_index_destroy(kd);
+    sylves_spatial_index_destroy(hash);
+    sylves_cache_destroy(single);
+    sylves_cache_destroy(sharded);
+    return 0;
+}
@@ -0,0 +1,141 @@
+/**
+ * @file benchmark_flow_field.c
+ * @brief Whole-grid distance fields: multi-source Dijkstra vs flow field BFS and fast marching
+ *
+ * Computes the distance from a handful of goals to every cell of a
+ * 2048x2048 bounded square grid with scattered walls. The Dijkstra row
+ * is the sparse per-cell search; the BFS rows repeat the same unit-cost
+ * field on a flow field with 1 to max_threads workers, and the fast
+ * marching row solves the weighted (eikonal) field on one thread with
+ * parallel cost sampling.
+ *
+ * Usage: benchmark_flow_field [max_threads=8] [goals=16] [wall_percent=20]
+ */
+
+#include <sylves/sylves.h>
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define GRID_SIZE 2048
+
+static unsigned char walls[GRID_SIZE][GRID_SIZE];
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static unsigned next_random(unsigned* seed) {
+    *seed = *seed * 1103515245u + 12345u;
+    return *seed >> 8;
+}
+
+static bool is_open(SylvesCell cell, void* user_data) {
+    (void)user_data;
+    return !walls[cell.y][cell.x];
+}
+
+static float wall_step(const SylvesStep* step, void* user_data) {
+    (void)user_data;
+    return walls[step->dest.y][step->dest.x] ? -1.0f : 1.0f;
+}
+
+static float wall_cost(SylvesCell cell, void* user_data) {
+    (void)user_data;
+    return walls[cell.y][cell.x] ? -1.0f : 1.0f;
+}
+
+static void report(const char* variant, double seconds, const float* distances, size_t count) {
+    double checksum = 0.0;
+    int reached = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (distances[i] == FLT_MAX) continue;
+        checksum += distances[i];
+        reached++;
+    }
+    printf("%-28s %12.3f %10d %14.0f\n", variant, seconds, reached, checksum);
+}
+
+int main(int argc, char** argv) {
+    int max_threads = argc > 1 ? atoi(argv[1]) : 8;
+    int goal_count = argc > 2 ? atoi(argv[2]) : 16;
+    int wall_percent = argc > 3 ? atoi(argv[3]) : 20;
+    if (max_threads <= 0 || goal_count <= 0 || wall_percent < 0 || wall_percent >= 100) {
+        fprintf(stderr, "usage: %s [max_threads] [goals] [wall_percent<100]\n", argv[0]);
+        return 1;
+    }
+
+    SylvesGrid* grid = sylves_square_grid_create_bounded(1.0, 0, 0, GRID_SIZE - 1, GRID_SIZE - 1);
+    SylvesCell* goals = (SylvesCell*)malloc(sizeof(SylvesCell) * (size_t)goal_count);
+    float* distances = (float*)malloc(sizeof(float) * GRID_SIZE * GRID_SIZE);
+    if (!grid || !goals || !distances) {
+        fprintf(stderr, "allocation failed\n");
+        return 1;
+    }
+
+    unsigned seed = 12345;
+    for (int y = 0; y < GRID_SIZE; y++) {
+        for (int x = 0; x < GRID_SIZE; x++) {
+            walls[y][x] = (int)(next_random(&seed) % 100) < wall_percent;
+        }
+    }
+    for (int g = 0; g < goal_count; g++) {
+        int x = (int)(next_random(&seed) % GRID_SIZE), y = (int)(next_random(&seed) % GRID_SIZE);
+        walls[y][x] = 0;
+        goals[g] = sylves_cell_create(x, y, 0);
+    }
+
+    printf("Distance fields on %dx%d square grid, %d%% walls, %d goals\n",
+           GRID_SIZE, GRID_SIZE, wall_percent, goal_count);
+    printf("%-28s %12s %10s %14s\n", "variant", "seconds", "reached", "checksum");
+
+    double start = now_seconds();
+    SylvesDijkstraPathfinding* dijkstra = sylves_dijkstra_create_multi_source(grid, goals, (size_t)goal_count,
+                                                                              wall_step, NULL);
+    sylves_dijkstra_run(dijkstra, NULL, FLT_MAX);
+    size_t settled = GRID_SIZE * GRID_SIZE;
+    SylvesCell* cells = (SylvesCell*)malloc(sizeof(SylvesCell) * settled);
+    float* settled_distances = (float*)malloc(sizeof(float) * settled);
+    for (size_t i = 0; i < settled; i++) distances[i] = FLT_MAX;
+    if (cells && settled_distances &&
+        sylves_dijkstra_get_distances(dijkstra, cells, settled_distances, &settled) == SYLVES_SUCCESS) {
+        for (size_t i = 0; i < settled; i++) {
+            distances[sylves_grid_get_index(grid, cells[i])] = settled_distances[i];
+        }
+    }
+    double seconds = now_seconds() - start;
+    report("dijkstra_multi_source", seconds, distances, GRID_SIZE * GRID_SIZE);
+    sylves_dijkstra_destroy(dijkstra);
+    free(cells);
+    free(settled_distances);
+
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        SylvesFlowField* field = sylves_flow_field_create(grid, threads);
+        if (!field) continue;
+        sylves_flow_field_compute_bfs(field, goals, (size_t)goal_count, is_open, NULL);  /* warm up */
+        start = now_seconds();
+        sylves_flow_field_compute_bfs(field, goals, (size_t)goal_count, is_open, NULL);
+        seconds = now_seconds() - start;
+        char variant[32];
+        snprintf(variant, sizeof(variant), "flow_field_bfs_%dt", threads);
+        report(variant, seconds, sylves_flow_field_get_distances(field), GRID_SIZE * GRID_SIZE);
+        sylves_flow_field_destroy(field);
+    }
+
+    SylvesFlowField* field = sylves_flow_field_create(grid, max_threads);
+    if (field) {
+        start = now_seconds();
+        sylves_flow_field_compute_fast_marching(field, goals, (size_t)goal_count, wall_cost, NULL);
+        seconds = now_seconds() - start;
+        report("flow_field_fast_marching", seconds, sylves_flow_field_get_distances(field), GRID_SIZE * GRID_SIZE);
+        sylves_flow_field_destroy(field);
+    }
+
+    sylves_grid_destroy(grid);
+    free(goals);
+    free(distances);
+    return 0;
+}
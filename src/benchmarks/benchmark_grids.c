@@ -0,0 +1,123 @@
+/**
+ * @file benchmark_grids.c
+ * @brief Per-cell vtable path vs struct-of-arrays kernels for cell positions
+ *
+ * Usage: benchmark_grids [cell_count] [repeats]
+ */
+
+#include <sylves/sylves.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+typedef struct {
+    const char* name;
+    SylvesGrid* grid;
+    bool is_3d;
+    SylvesCellCorner corner;
+} BenchGrid;
+
+static double elapsed_ms(clock_t start) {
+    return (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC;
+}
+
+static void bench_grid(const BenchGrid* bg, const SylvesCellBuffer* cells, const SylvesCell* aos,
+                       int repeats, double* xs, double* ys, double* zs) {
+    double checksum = 0.0;
+    size_t n = cells->count;
+
+    clock_t start = clock();
+    for (int r = 0; r < repeats; r++) {
+        for (size_t i = 0; i < n; i++) {
+            SylvesVector3 p = sylves_grid_get_cell_center(bg->grid, aos[i]);
+            xs[i] = p.x; ys[i] = p.y; zs[i] = p.z;
+        }
+        checksum += xs[n - 1];
+    }
+    double center_single = elapsed_ms(start);
+
+    start = clock();
+    for (int r = 0; r < repeats; r++) {
+        sylves_grid_get_cell_centers_soa(bg->grid, cells, xs, ys, zs);
+        checksum += xs[n - 1];
+    }
+    double center_soa = elapsed_ms(start);
+
+    start = clock();
+    for (int r = 0; r < repeats; r++) {
+        for (size_t i = 0; i < n; i++) {
+            SylvesVector3 p = sylves_grid_get_cell_corner(bg->grid, aos[i], bg->corner);
+            xs[i] = p.x; ys[i] = p.y; zs[i] = p.z;
+        }
+        checksum += ys[n - 1];
+    }
+    double corner_single = elapsed_ms(start);
+
+    start = clock();
+    for (int r = 0; r < repeats; r++) {
+        sylves_grid_get_cell_corners_soa(bg->grid, cells, bg->corner, xs, ys, zs);
+        checksum += ys[n - 1];
+    }
+    double corner_soa = elapsed_ms(start);
+
+    printf("%-10s centers %9.2f ms -> %8.2f ms (%5.1fx)   corners %9.2f ms -> %8.2f ms (%5.1fx)  [%g]\n",
+           bg->name, center_single, center_soa, center_single / (center_soa > 0 ? center_soa : 1e-9),
+           corner_single, corner_soa, corner_single / (corner_soa > 0 ? corner_soa : 1e-9), checksum);
+}
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? (size_t)strtoul(argv[1], NULL, 10) : 1000000;
+    int repeats = argc > 2 ? atoi(argv[2]) : 10;
+    if (count == 0 || repeats <= 0) {
+        fprintf(stderr, "usage: %s [cell_count] [repeats]\n", argv[0]);
+        return 1;
+    }
+
+    BenchGrid grids[] = {
+        { "square", sylves_square_grid_create(1.0), false, SYLVES_SQUARE_CORNER_TOP_RIGHT },
+        { "hex", sylves_hex_grid_create(SYLVES_HEX_ORIENTATION_FLAT_TOP, 1.0), false, 2 },
+        { "triangle", sylves_triangle_grid_create(1.0, SYLVES_TRIANGLE_ORIENTATION_FLAT_TOPPED), false, 1 },
+        { "cube", sylves_cube_grid_create(1.0), true, 7 },
+    };
+    size_t grid_count = sizeof(grids) / sizeof(grids[0]);
+
+    SylvesCellBuffer* planar = sylves_cell_buffer_create(count);
+    SylvesCellBuffer* volume = sylves_cell_buffer_create(count);
+    SylvesCell* planar_aos = (SylvesCell*)malloc(count * sizeof(SylvesCell));
+    SylvesCell* volume_aos = (SylvesCell*)malloc(count * sizeof(SylvesCell));
+    double* xs = (double*)sylves_aligned_alloc(count * sizeof(double), SYLVES_CELL_BUFFER_ALIGNMENT);
+    double* ys = (double*)sylves_aligned_alloc(count * sizeof(double), SYLVES_CELL_BUFFER_ALIGNMENT);
+    double* zs = (double*)sylves_aligned_alloc(count * sizeof(double), SYLVES_CELL_BUFFER_ALIGNMENT);
+    if (!planar || !volume || !planar_aos || !volume_aos || !xs || !ys || !zs) {
+        fprintf(stderr, "allocation failed\n");
+        return 1;
+    }
+
+    int side = 1;
+    while ((size_t)side * (size_t)side < count) side++;
+    for (size_t i = 0; i < count; i++) {
+        int x = (int)(i % (size_t)side);
+        int y = (int)(i / (size_t)side);
+        planar_aos[i] = (SylvesCell){ x, y, 0 };
+        volume_aos[i] = (SylvesCell){ x, y & 255, y >> 8 };
+    }
+    sylves_cell_buffer_append(planar, planar_aos, count);
+    sylves_cell_buffer_append(volume, volume_aos, count);
+
+    printf("Cell positions: %zu cells x %d repeats (per-cell vtable -> SoA kernel)\n", count, repeats);
+    for (size_t g = 0; g < grid_count; g++) {
+        const BenchGrid* bg = &grids[g];
+        bench_grid(bg, bg->is_3d ? volume : planar, bg->is_3d ? volume_aos : planar_aos,
+                   repeats, xs, ys, zs);
+        sylves_grid_destroy(bg->grid);
+    }
+
+    sylves_aligned_free(xs);
+    sylves_aligned_free(ys);
+    sylves_aligned_free(zs);
+    free(planar_aos);
+    free(volume_aos);
+    sylves_cell_buffer_destroy(planar);
+    sylves_cell_buffer_destroy(volume);
+    return 0;
+}
@@ -0,0 +1,294 @@
+/**
+ * @file benchmark_pathfinding.c
+ * @brief Short-query throughput of one-shot searches vs a reused pathfinding context
+ *
+ * Runs the same random point-to-point queries on a 256x256 bounded square
+ * grid with scattered walls, first through sylves_find_distance (fresh
+ * search state per query) and then through the *_with_context variants.
+ * The weighted variant adds per-cell terrain costs of 1-9, which routes
+ * queries through Dijkstra and leaves many improved, still-open nodes.
+ * The bidirectional variants repeat the path and weighted queries with
+ * sylves_find_path_bidirectional; raise max_span to see long routes.
+ * The JPS variants answer the unweighted path queries with jump point
+ * search, scanning live and then from a precomputed JPS+ jump table;
+ * lower wall_percent to see open-field routes.
+ *
+ * Usage: benchmark_pathfinding [queries=20000] [max_span=32] [wall_percent=20]
+ */
+
+#include <sylves/sylves.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define GRID_SIZE 256
+
+typedef struct {
+    unsigned char walls[GRID_SIZE][GRID_SIZE];
+    unsigned char costs[GRID_SIZE][GRID_SIZE];
+} WallMap;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static unsigned next_random(unsigned* seed) {
+    *seed = *seed * 1103515245u + 12345u;
+    return *seed >> 8;
+}
+
+static bool is_open(SylvesCell cell, void* user_data) {
+    const WallMap* map = (const WallMap*)user_data;
+    if (cell.x < 0 || cell.y < 0 || cell.x >= GRID_SIZE || cell.y >= GRID_SIZE) return false;
+    return !map->walls[cell.y][cell.x];
+}
+
+static float terrain_cost(const SylvesStep* step, void* user_data) {
+    const WallMap* map = (const WallMap*)user_data;
+    return (float)map->costs[step->dest.y][step->dest.x];
+}
+
+static float manhattan(SylvesCell a, SylvesCell b, void* user_data) {
+    (void)user_data;
+    return sylves_heuristic_manhattan(a, b, 1.0f);
+}
+
+static SylvesCell random_open_cell(const WallMap* map, unsigned* seed, SylvesCell near, int span) {
+    for (;;) {
+        int x = near.x + (int)(next_random(seed) % (unsigned)(2 * span + 1)) - span;
+        int y = near.y + (int)(next_random(seed) % (unsigned)(2 * span + 1)) - span;
+        if (x < 0 || y < 0 || x >= GRID_SIZE || y >= GRID_SIZE) continue;
+        if (!map->walls[y][x]) return sylves_cell_create(x, y, 0);
+    }
+}
+
+int main(int argc, char** argv) {
+    int queries = argc > 1 ? atoi(argv[1]) : 20000;
+    int span = argc > 2 ? atoi(argv[2]) : 32;
+    int wall_percent = argc > 3 ? atoi(argv[3]) : 20;
+    if (queries <= 0 || span <= 0 || wall_percent < 0 || wall_percent >= 100) {
+        fprintf(stderr, "usage: %s [queries] [max_span] [wall_percent<100]\n", argv[0]);
+        return 1;
+    }
+
+    SylvesGrid* grid = sylves_square_grid_create_bounded(1.0, 0, 0, GRID_SIZE - 1, GRID_SIZE - 1);
+    WallMap* map = (WallMap*)calloc(1, sizeof(WallMap));
+    SylvesCell* pairs = (SylvesCell*)malloc(sizeof(SylvesCell) * 2 * (size_t)queries);
+    if (!grid || !map || !pairs) {
+        fprintf(stderr, "allocation failed\n");
+        return 1;
+    }
+
+    unsigned seed = 12345;
+    for (int y = 0; y < GRID_SIZE; y++) {
+        for (int x = 0; x < GRID_SIZE; x++) {
+            map->walls[y][x] = (int)(next_random(&seed) % 100) < wall_percent;
+            map->costs[y][x] = (unsigned char)(1 + next_random(&seed) % 9);
+        }
+    }
+    SylvesCell center = sylves_cell_create(GRID_SIZE / 2, GRID_SIZE / 2, 0);
+    for (int q = 0; q < queries; q++) {
+        pairs[2 * q] = random_open_cell(map, &seed, center, GRID_SIZE / 2);
+        pairs[2 * q + 1] = random_open_cell(map, &seed, pairs[2 * q], span);
+    }
+
+    printf("Pathfinding on %dx%d square grid, %d%% walls, %d queries spanning <= %d cells\n",
+           GRID_SIZE, GRID_SIZE, wall_percent, queries, span);
+    printf("%-28s %12s %10s %12s\n", "variant", "queries/s", "found", "checksum");
+
+    double checksum = 0.0;
+    int found = 0;
+    double start = now_seconds();
+    for (int q = 0; q < queries; q++) {
+        float distance;
+        if (sylves_find_distance(grid, pairs[2 * q], pairs[2 * q + 1], is_open, NULL, map, &distance) == SYLVES_SUCCESS) {
+            checksum += distance;
+            found++;
+        }
+    }
+    double seconds = now_seconds() - start;
+    printf("%-28s %12.0f %10d %12.0f\n", "find_distance", queries / seconds, found, checksum);
+
+    SylvesPathfindingContext* ctx = sylves_pathfinding_context_create(0);
+    checksum = 0.0;
+    found = 0;
+    start = now_seconds();
+    for (int q = 0; q < queries; q++) {
+        float distance;
+        if (sylves_find_distance_with_context(ctx, grid, pairs[2 * q], pairs[2 * q + 1], is_open, NULL, map,
+                                              &distance) == SYLVES_SUCCESS) {
+            checksum += distance;
+            found++;
+        }
+    }
+    seconds = now_seconds() - start;
+    printf("%-28s %12.0f %10d %12.0f\n", "find_distance_with_context", queries / seconds, found, checksum);
+
+    checksum = 0.0;
+    found = 0;
+    start = now_seconds();
+    for (int q = 0; q < queries; q++) {
+        SylvesCellPath* path = sylves_find_path_with_context(ctx, grid, pairs[2 * q], pairs[2 * q + 1], is_open, NULL, map);
+        if (path) {
+            checksum += path->total_length;
+            found++;
+            sylves_cell_path_destroy(path);
+        }
+    }
+    seconds = now_seconds() - start;
+    printf("%-28s %12.0f %10d %12.0f\n", "find_path_with_context", queries / seconds, found, checksum);
+
+    checksum = 0.0;
+    found = 0;
+    start = now_seconds();
+    for (int q = 0; q < queries; q++) {
+        float distance;
+        if (sylves_find_distance_with_context(ctx, grid, pairs[2 * q], pairs[2 * q + 1], is_open, terrain_cost, map,
+                                              &distance) == SYLVES_SUCCESS) {
+            checksum += distance;
+            found++;
+        }
+    }
+    seconds = now_seconds() - start;
+    printf("%-28s %12.0f %10d %12.0f\n", "weighted_with_context", queries / seconds, found, checksum);
+
+    checksum = 0.0;
+    found = 0;
+    start = now_seconds();
+    for (int q = 0; q < queries; q++) {
+        SylvesCellPath* path = sylves_find_path_bidirectional(grid, pairs[2 * q], pairs[2 * q + 1], is_open, NULL, map);
+        if (path) {
+            checksum += path->total_length;
+            found++;
+            sylves_cell_path_destroy(path);
+        }
+    }
+    seconds = now_seconds() - start;
+    printf("%-28s %12.0f %10d %12.0f\n", "find_path_bidirectional", queries / seconds, found, checksum);
+
+    checksum = 0.0;
+    found = 0;
+    start = now_seconds();
+    for (int q = 0; q < queries; q++) {
+        SylvesCellPath* path = sylves_find_path_bidirectional(grid, pairs[2 * q], pairs[2 * q + 1], is_open,
+                                                              terrain_cost, map);
+        if (path) {
+            checksum += path->total_length;
+            found++;
+            sylves_cell_path_destroy(path);
+        }
+    }
+    seconds = now_seconds() - start;
+    printf("%-28s %12.0f %10d %12.0f\n", "weighted_bidirectional", queries / seconds, found, checksum);
+
+    checksum = 0.0;
+    found = 0;
+    start = now_seconds();
+    for (int q = 0; q < queries; q++) {
+        SylvesCellPath* path = sylves_find_path_jps(grid, pairs[2 * q], pairs[2 * q + 1], is_open, map);
+        if (path) {
+            checksum += path->total_length;
+            found++;
+            sylves_cell_path_destroy(path);
+        }
+    }
+    seconds = now_seconds() - start;
+    printf("%-28s %12.0f %10d %12.0f\n", "find_path_jps", queries / seconds, found, checksum);
+
+    SylvesJPSJumpTable* table = sylves_jps_jump_table_create(grid, is_open, map);
+    checksum = 0.0;
+    found = 0;
+    start = now_seconds();
+    for (int q = 0; q < queries; q++) {
+        SylvesJPSPathfinding* jps = sylves_jps_create_with_table(table, pairs[2 * q]);
+        sylves_jps_run(jps, pairs[2 * q + 1]);
+        SylvesCellPath* path = sylves_jps_extract_path(jps, pairs[2 * q + 1]);
+        if (path) {
+            checksum += path->total_length;
+            found++;
+            sylves_cell_path_destroy(path);
+        }
+        sylves_jps_destroy(jps);
+    }
+    seconds = now_seconds() - start;
+    printf("%-28s %12.0f %10d %12.0f\n", "jps_jump_table", queries / seconds, found, checksum);
+    sylves_jps_jump_table_destroy(table);
+
+    start = now_seconds();
+    SylvesHierarchicalPathfinding* hpa = sylves_hpa_create(grid, 16, is_open, NULL, manhattan, map);
+    double build_seconds = now_seconds() - start;
+    checksum = 0.0;
+    found = 0;
+    start = now_seconds();
+    for (int q = 0; q < queries; q++) {
+        SylvesCellPath* path = sylves_hpa_find_path(hpa, pairs[2 * q], pairs[2 * q + 1]);
+        if (path) {
+            checksum += path->total_length;
+            found++;
+            sylves_cell_path_destroy(path);
+        }
+    }
+    seconds = now_seconds() - start;
+    printf("%-28s %12.0f %10d %12.0f\n", "find_path_hpa", queries / seconds, found, checksum);
+    printf("  (%zu abstract nodes built in %.3f s)\n", sylves_hpa_get_node_count(hpa), build_seconds);
+    sylves_hpa_destroy(hpa);
+
+    /* Replanning: a unit walks from one corner region to the other while one wall per tick flips near it */
+    int ticks = queries < 2000 ? queries : 2000;
+    SylvesCell walk_src = random_open_cell(map, &seed, sylves_cell_create(16, 16, 0), 8);
+    SylvesCell walk_dest = random_open_cell(map, &seed, sylves_cell_create(GRID_SIZE - 17, GRID_SIZE - 17, 0), 8);
+    SylvesCell* flips = (SylvesCell*)malloc(sizeof(SylvesCell) * (size_t)ticks);
+    for (int t = 0; t < ticks && flips; t++) {
+        flips[t] = sylves_cell_create((int)(next_random(&seed) % GRID_SIZE), (int)(next_random(&seed) % GRID_SIZE), 0);
+    }
+    for (int variant = 0; variant < 2 && flips; variant++) {
+        unsigned char saved[GRID_SIZE][GRID_SIZE];
+        memcpy(saved, map->walls, sizeof(saved));
+        SylvesCell unit = walk_src;
+        SylvesDStarLite* dstar = variant ? sylves_dstar_create(grid, unit, walk_dest, is_open, NULL, manhattan, map) : NULL;
+        checksum = 0.0;
+        found = 0;
+        start = now_seconds();
+        for (int t = 0; t < ticks; t++) {
+            SylvesCell flip = flips[t];
+            if (!sylves_cell_equals(flip, unit) && !sylves_cell_equals(flip, walk_dest)) {
+                map->walls[flip.y][flip.x] ^= 1;
+                if (dstar) sylves_dstar_notify_cell_changed(dstar, flip);
+            }
+            SylvesCellPath* path;
+            if (dstar) {
+                sylves_dstar_compute(dstar);
+                path = sylves_dstar_extract_path(dstar);
+            } else {
+                path = sylves_find_path(grid, unit, walk_dest, is_open, NULL, map);
+            }
+            if (path) {
+                checksum += path->total_length;
+                found++;
+                if (path->step_count > 0) {
+                    unit = path->steps[0].dest;
+                    if (dstar) sylves_dstar_move_start(dstar, unit);
+                }
+                sylves_cell_path_destroy(path);
+            }
+        }
+        seconds = now_seconds() - start;
+        printf("%-28s %12.0f %10d %12.0f\n", variant ? "replan_dstar_lite" : "replan_find_path",
+               ticks / seconds, found, checksum);
+        if (dstar) {
+            printf("  (%.1f expansions per tick)\n", (double)sylves_dstar_get_expansions(dstar) / ticks);
+        }
+        sylves_dstar_destroy(dstar);
+        memcpy(map->walls, saved, sizeof(saved));
+    }
+    free(flips);
+
+    sylves_pathfinding_context_destroy(ctx);
+    sylves_grid_destroy(grid);
+    free(map);
+    free(pairs);
+    return 0;
+}
@@ -0,0 +1,161 @@
+/**
+ * @file benchmark_spatial_index.c
+ * @brief Compare spatial index backends on uniform and clustered point sets
+ *
+ * Usage: benchmark_spatial_index [point_count] [query_count]
+ */
+
+#include <sylves/sylves.h>
+#include <sylves/spatial_index.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define WORLD_SIZE 1000.0
+
+typedef struct {
+    const char* name;
+    SylvesSpatialIndexType type;
+} Backend;
+
+static double elapsed_ms(clock_t start) {
+    return (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC;
+}
+
+static unsigned bench_seed = 12345;
+
+static double next_uniform(void) {
+    bench_seed = bench_seed * 1103515245u + 12345u;
+    return ((bench_seed >> 8) & 0xFFFFFF) / (double)0x1000000;
+}
+
+static double next_gaussian(void) {
+    double u = next_uniform() + 1e-12, v = next_uniform();
+    return sqrt(-2.0 * log(u)) * cos(2.0 * acos(-1.0) * v);
+}
+
+static void make_uniform(SylvesVector3* points, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        points[i] = sylves_vector3_create(next_uniform() * WORLD_SIZE, next_uniform() * WORLD_SIZE, 0.0);
+    }
+}
+
+/* A few dozen tight Gaussian blobs, like Voronoi seeds around points of interest */
+static void make_clustered(SylvesVector3* points, size_t count) {
+    enum { CLUSTERS = 32 };
+    SylvesVector3 centers[CLUSTERS];
+    for (int c = 0; c < CLUSTERS; c++) {
+        centers[c] = sylves_vector3_create(next_uniform() * WORLD_SIZE, next_uniform() * WORLD_SIZE, 0.0);
+    }
+    for (size_t i = 0; i < count; i++) {
+        const SylvesVector3* c = &centers[i % CLUSTERS];
+        double spread = 0.5 + 4.0 * (double)(i % 7);
+        points[i] = sylves_vector3_create(c->x + next_gaussian() * spread, c->y + next_gaussian() * spread, 0.0);
+    }
+}
+
+static bool count_visitor(const SylvesCell* cell, void* data, void* user_data) {
+    (void)data;
+    *(long long*)user_data += cell->x;
+    return true;
+}
+
+static void bench_backend(const Backend* backend, const SylvesCell* cells, const SylvesVector3* points,
+                          size_t count, const SylvesVector3* queries, size_t query_count) {
+    SylvesSpatialIndexConfig config = { .type = backend->type, .bucket_size = 65536 };
+    SylvesSpatialIndex* index = sylves_spatial_index_create(&config, 2);
+    if (!index) {
+        printf("  %-10s (unavailable)\n", backend->name);
+        return;
+    }
+
+    clock_t start = clock();
+    sylves_spatial_index_insert_batch(index, cells, points, count);
+    sylves_spatial_index_optimize(index);
+    double build = elapsed_ms(start);
+
+    long long checksum = 0;
+    start = clock();
+    for (size_t q = 0; q < query_count; q++) {
+        SylvesAabb box = {
+            { queries[q].x - 5.0, queries[q].y - 5.0, -1.0 },
+            { queries[q].x + 5.0, queries[q].y + 5.0, 1.0 }
+        };
+        sylves_spatial_index_query_aabb(index, &box, count_visitor, &checksum);
+    }
+    double aabb = elapsed_ms(start);
+
+    start = clock();
+    for (size_t q = 0; q < query_count; q++) {
+        sylves_spatial_index_query_radius(index, &queries[q], 5.0, count_visitor, &checksum);
+    }
+    double radius = elapsed_ms(start);
+
+    start = clock();
+    for (size_t q = 0; q < query_count; q++) {
+        SylvesCell found;
+        if (sylves_spatial_index_find_nearest(index, &queries[q], &found, NULL) == SYLVES_SUCCESS) {
+            checksum += found.x;
+        }
+    }
+    double nearest = elapsed_ms(start);
+
+    printf("  %-10s build %8.2f ms  aabb %8.2f ms  radius %8.2f ms  nearest %9.2f ms  [%lld]\n",
+           backend->name, build, aabb, radius, nearest, checksum);
+    sylves_spatial_index_destroy(index);
+}
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? (size_t)strtoul(argv[1], NULL, 10) : 200000;
+    size_t query_count = argc > 2 ? (size_t)strtoul(argv[2], NULL, 10) : 5000;
+    if (count == 0 || query_count == 0) {
+        fprintf(stderr, "usage: %s [point_count] [query_count]\n", argv[0]);
+        return 1;
+    }
+
+    Backend backends[] = {
+        { "grid_hash", SYLVES_SPATIAL_INDEX_GRID_HASH },
+        { "quadtree", SYLVES_SPATIAL_INDEX_QUADTREE },
+        { "octree", SYLVES_SPATIAL_INDEX_OCTREE },
+        { "rtree", SYLVES_SPATIAL_INDEX_RTREE },
+        { "kdtree", SYLVES_SPATIAL_INDEX_KDTREE },
+    };
+    size_t backend_count = sizeof(backends) / sizeof(backends[0]);
+
+    SylvesCell* cells = (SylvesCell*)malloc(count * sizeof(SylvesCell));
+    SylvesVector3* points = (SylvesVector3*)malloc(count * sizeof(SylvesVector3));
+    SylvesVector3* queries = (SylvesVector3*)malloc(query_count * sizeof(SylvesVector3));
+    if (!cells || !points || !queries) {
+        fprintf(stderr, "allocation failed\n");
+        return 1;
+    }
+    for (size_t i = 0; i < count; i++) {
+        cells[i] = (SylvesCell){ (int)i, 0, 0 };
+    }
+
+    for (int set = 0; set < 2; set++) {
+        if (set == 0) {
+            make_uniform(points, count);
+        } else {
+            make_clustered(points, count);
+        }
+        /* Query around existing points so both sets see populated neighbourhoods */
+        for (size_t q = 0; q < query_count; q++) {
+            queries[q] = points[(q * 7919) % count];
+            queries[q].x += next_uniform() - 0.5;
+            queries[q].y += next_uniform() - 0.5;
+        }
+
+        printf("%s points: %zu points, %zu queries per operation\n",
+               set == 0 ? "Uniform" : "Clustered", count, query_count);
+        for (size_t b = 0; b < backend_count; b++) {
+            bench_backend(&backends[b], cells, points, count, queries, query_count);
+        }
+    }
+
+    free(cells);
+    free(points);
+    free(queries);
+    return 0;
+}
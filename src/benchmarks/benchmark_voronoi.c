@@ -0,0 +1,94 @@
+/**
+ * @file benchmark_voronoi.c
+ * @brief Build time of relaxed Voronoi grids
+ *
+ * Uniformly random sites in a square clip box, built with an increasing
+ * number of Lloyd relaxation iterations on one reused relaxer. Each
+ * iteration re-triangulates the moved sites, by edge flips where they
+ * moved little, and walks every site's cell across the workers; a final
+ * run reports how many iterations got away with flips.
+ *
+ * Usage: benchmark_voronoi [sites=100000] [iterations=10] [threads=1]
+ */
+
+#include <sylves/sylves.h>
+#include <sylves/voronoi_grid.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char** argv) {
+    long sites = argc > 1 ? atol(argv[1]) : 100000;
+    int iterations = argc > 2 ? atoi(argv[2]) : 10;
+    int threads = argc > 3 ? atoi(argv[3]) : 1;
+    if (sites < 3 || iterations < 0) {
+        fprintf(stderr, "usage: %s [sites] [iterations] [threads]\n", argv[0]);
+        return 1;
+    }
+
+    SylvesVector2* points = (SylvesVector2*)malloc((size_t)sites * sizeof(SylvesVector2));
+    SylvesVoronoiRelaxer* relaxer = sylves_voronoi_relaxer_create(threads);
+    if (!points || !relaxer) {
+        fprintf(stderr, "allocation failed\n");
+        free(points);
+        sylves_voronoi_relaxer_destroy(relaxer);
+        return 1;
+    }
+    unsigned seed = 12345u;
+    double side = 1000.0;
+    for (long i = 0; i < sites; i++) {
+        seed = seed * 1103515245u + 12345u;
+        points[i].x = (double)(seed >> 8) / (double)(1u << 24) * side;
+        seed = seed * 1103515245u + 12345u;
+        points[i].y = (double)(seed >> 8) / (double)(1u << 24) * side;
+    }
+
+    SylvesVector2 clip_min = { 0, 0 }, clip_max = { side, side };
+    SylvesVoronoiGridOptions options = sylves_voronoi_grid_options_default();
+    options.clip_min = &clip_min;
+    options.clip_max = &clip_max;
+
+    printf("Voronoi grid, %ld sites, %d threads\n", sites, threads);
+    printf("%10s %12s %16s\n", "iterations", "total ms", "ms per iteration");
+    double base_ms = 0;
+    /* 0, 1, 2, 4, ... and finally the requested count */
+    for (int n = 0;; n = n == 0 ? 1 : (n * 2 < iterations ? n * 2 : iterations)) {
+        options.lloyd_relaxation_iterations = n;
+        double start = now_seconds();
+        SylvesGrid* grid = sylves_voronoi_grid_create_with_relaxer(relaxer, points, (size_t)sites, &options);
+        double ms = (now_seconds() - start) * 1e3;
+        if (!grid) {
+            fprintf(stderr, "grid creation failed\n");
+            free(points);
+            sylves_voronoi_relaxer_destroy(relaxer);
+            return 1;
+        }
+        sylves_grid_destroy(grid);
+        if (n == 0) {
+            base_ms = ms;
+            printf("%10d %12.1f %16s\n", n, ms, "-");
+        } else {
+            printf("%10d %12.1f %16.1f\n", n, ms, (ms - base_ms) / n);
+        }
+        if (n >= iterations) {
+            break;
+        }
+    }
+
+    SylvesVoronoiRelaxStats stats;
+    if (iterations > 0 &&
+        sylves_voronoi_relaxer_relax(relaxer, points, (size_t)sites, &options, &stats) == SYLVES_SUCCESS) {
+        printf("%d iterations: %d by edge flips, %d re-triangulated, last max move %.4f\n",
+               stats.iterations, stats.incremental_updates, stats.full_rebuilds, stats.max_displacement);
+    }
+
+    sylves_voronoi_relaxer_destroy(relaxer);
+    free(points);
+    return 0;
+}
@@ -0,0 +1,156 @@
+/**
+ * @file arena.c
+ * @brief Bump-pointer scratch arena with nested marks
+ */
+
+#include "sylves/memory.h"
+#include <string.h>
+#include <stdint.h>
+
+#ifdef _WIN32
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL __thread
+#endif
+
+#define ARENA_DEFAULT_BLOCK_SIZE (64 * 1024)
+
+/* Block header; the payload starts ARENA_HEADER_SIZE bytes in */
+typedef struct ArenaBlock {
+    struct ArenaBlock* prev;    /* older block in the chain, or next spare */
+    size_t size;                /* payload bytes */
+} ArenaBlock;
+
+#define ARENA_ALIGN_UP(n) (((n) + (SYLVES_ARENA_ALIGNMENT - 1)) & ~(size_t)(SYLVES_ARENA_ALIGNMENT - 1))
+#define ARENA_HEADER_SIZE ARENA_ALIGN_UP(sizeof(ArenaBlock))
+
+struct SylvesArena {
+    ArenaBlock* current;        /* block being bumped, NULL before the first alloc */
+    size_t offset;              /* bytes taken from current */
+    ArenaBlock* spare;          /* standard-size blocks released by pops */
+    size_t block_size;
+    size_t used;                /* bytes handed out and not yet popped */
+    size_t capacity;            /* payload bytes held in live and spare blocks */
+};
+
+static THREAD_LOCAL SylvesArena* tls_scratch_arena = NULL;
+
+static inline unsigned char* block_data(ArenaBlock* block) {
+    return (unsigned char*)block + ARENA_HEADER_SIZE;
+}
+
+/* Return a block taken off the chain: standard blocks are kept, oversized ones freed */
+static void release_block(SylvesArena* arena, ArenaBlock* block) {
+    if (block->size == arena->block_size) {
+        block->prev = arena->spare;
+        arena->spare = block;
+    } else {
+        arena->capacity -= block->size;
+        sylves_free(block);
+    }
+}
+
+static ArenaBlock* acquire_block(SylvesArena* arena, size_t size) {
+    if (size <= arena->block_size && arena->spare) {
+        ArenaBlock* block = arena->spare;
+        arena->spare = block->prev;
+        return block;
+    }
+    size_t payload = size > arena->block_size ? ARENA_ALIGN_UP(size) : arena->block_size;
+    if (payload < size || payload > SIZE_MAX - ARENA_HEADER_SIZE) return NULL;
+    ArenaBlock* block = (ArenaBlock*)sylves_alloc(ARENA_HEADER_SIZE + payload);
+    if (!block) return NULL;
+    block->size = payload;
+    arena->capacity += payload;
+    return block;
+}
+
+SylvesArena* sylves_arena_create(size_t block_size) {
+    SylvesArena* arena = (SylvesArena*)sylves_calloc(1, sizeof(SylvesArena));
+    if (!arena) return NULL;
+    arena->block_size = block_size > 0 ? ARENA_ALIGN_UP(block_size) : ARENA_DEFAULT_BLOCK_SIZE;
+    return arena;
+}
+
+void sylves_arena_destroy(SylvesArena* arena) {
+    if (!arena) return;
+    sylves_arena_reset(arena);
+    sylves_arena_trim(arena);
+    sylves_free(arena);
+}
+
+void* sylves_arena_alloc(SylvesArena* arena, size_t size) {
+    if (!arena) return NULL;
+    if (size == 0) size = 1;
+
+    size_t start = ARENA_ALIGN_UP(arena->offset);
+    if (!arena->current || start > arena->current->size || size > arena->current->size - start) {
+        ArenaBlock* block = acquire_block(arena, size);
+        if (!block) return NULL;
+        block->prev = arena->current;
+        arena->current = block;
+        start = 0;
+    }
+
+    arena->offset = start + size;
+    arena->used += size;
+    return block_data(arena->current) + start;
+}
+
+void* sylves_arena_calloc(SylvesArena* arena, size_t count, size_t size) {
+    if (size != 0 && count > SIZE_MAX / size) return NULL;
+    void* ptr = sylves_arena_alloc(arena, count * size);
+    if (ptr) memset(ptr, 0, count * size);
+    return ptr;
+}
+
+SylvesArenaMark sylves_arena_push(const SylvesArena* arena) {
+    SylvesArenaMark mark = { NULL, 0, 0 };
+    if (arena) {
+        mark.block = arena->current;
+        mark.offset = arena->offset;
+        mark.used = arena->used;
+    }
+    return mark;
+}
+
+void sylves_arena_pop(SylvesArena* arena, SylvesArenaMark mark) {
+    if (!arena) return;
+    while (arena->current && arena->current != (ArenaBlock*)mark.block) {
+        ArenaBlock* block = arena->current;
+        arena->current = block->prev;
+        release_block(arena, block);
+    }
+    arena->offset = mark.offset;
+    arena->used = mark.used;
+}
+
+void sylves_arena_reset(SylvesArena* arena) {
+    SylvesArenaMark empty = { NULL, 0, 0 };
+    sylves_arena_pop(arena, empty);
+}
+
+void sylves_arena_trim(SylvesArena* arena) {
+    if (!arena) return;
+    while (arena->spare) {
+        ArenaBlock* block = arena->spare;
+        arena->spare = block->prev;
+        arena->capacity -= block->size;
+        sylves_free(block);
+    }
+}
+
+size_t sylves_arena_get_used(const SylvesArena* arena) {
+    return arena ? arena->used : 0;
+}
+
+size_t sylves_arena_get_capacity(const SylvesArena* arena) {
+    return arena ? arena->capacity : 0;
+}
+
+SylvesArena* sylves_get_thread_scratch_arena(void) {
+    if (!tls_scratch_arena) {
+        tls_scratch_arena = sylves_arena_create(0);
+    }
+    return tls_scratch_arena;
+}
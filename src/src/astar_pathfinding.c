@@ -9,30 +9,13 @@
 #include "sylves/cell.h"
 #include "sylves/grid.h"
 #include "sylves/cell_type.h"
+#include "internal/path_search.h"
 #include <string.h>
 #include <float.h>
 
 /* Forward declaration */
 static float default_step_length(const SylvesStep* step, void* user_data);
 
-/* Hash table for cell lookups */
-#define HASH_TABLE_INITIAL_SIZE 64
-
-typedef struct CellHashEntry {
-    SylvesCell cell;
-    float g_score;      // Distance from start
-    float f_score;      // g_score + heuristic
-    SylvesStep step;    // How we got here
-    bool has_step;      // Whether step is valid
-    struct CellHashEntry* next;
-} CellHashEntry;
-
-typedef struct {
-    CellHashEntry** buckets;
-    size_t bucket_count;
-    size_t entry_count;
-} CellHashTable;
-
 /* A* pathfinding context */
 struct SylvesAStarPathfinding {
     SylvesGrid* grid;
@@ -41,171 +24,47 @@ struct SylvesAStarPathfinding {
     SylvesHeuristicFunc heuristic;
     void* user_data;
     
-    CellHashTable* visited;
-    SylvesHeap* open_set;
+    SylvesPathfindingContext search;
 };
 
-/* Hash function for cells */
-static size_t cell_hash(SylvesCell cell) {
-    // Simple hash combining x, y, z coordinates
-    size_t hash = 0;
-    hash ^= (size_t)cell.x + 0x9e3779b9 + (hash << 6) + (hash >> 2);
-    hash ^= (size_t)cell.y + 0x9e3779b9 + (hash << 6) + (hash >> 2);
-    hash ^= (size_t)cell.z + 0x9e3779b9 + (hash << 6) + (hash >> 2);
-    return hash;
-}
+/* Search core, shared with the context-based sylves_find_path_with_context */
 
-/* Hash table operations */
-static CellHashTable* hash_table_create(size_t initial_size) {
-    CellHashTable* table = (CellHashTable*)sylves_alloc(sizeof(CellHashTable));
-    if (!table) return NULL;
-    
-    table->buckets = (CellHashEntry**)sylves_calloc(initial_size, sizeof(CellHashEntry*));
-    if (!table->buckets) {
-        sylves_free(table);
-        return NULL;
-    }
-    
-    table->bucket_count = initial_size;
-    table->entry_count = 0;
-    
-    return table;
-}
-
-static void hash_table_destroy(CellHashTable* table) {
-    if (!table) return;
-    
-    // Free all entries
-    for (size_t i = 0; i < table->bucket_count; i++) {
-        CellHashEntry* entry = table->buckets[i];
-        while (entry) {
-            CellHashEntry* next = entry->next;
-            sylves_free(entry);
-            entry = next;
-        }
-    }
-    
-    sylves_free(table->buckets);
-    sylves_free(table);
-}
-
-static CellHashEntry* hash_table_find(CellHashTable* table, SylvesCell cell) {
-    size_t index = cell_hash(cell) % table->bucket_count;
-    CellHashEntry* entry = table->buckets[index];
-    
-    while (entry) {
-        if (sylves_cell_equals(entry->cell, cell)) {
-            return entry;
-        }
-        entry = entry->next;
-    }
-    
-    return NULL;
-}
-
-static CellHashEntry* hash_table_insert(CellHashTable* table, SylvesCell cell) {
-    size_t index = cell_hash(cell) % table->bucket_count;
-    
-    // Check if already exists
-    CellHashEntry* existing = hash_table_find(table, cell);
-    if (existing) return existing;
-    
-    // Create new entry
-    CellHashEntry* entry = (CellHashEntry*)sylves_alloc(sizeof(CellHashEntry));
-    if (!entry) return NULL;
-    
-    entry->cell = cell;
-    entry->g_score = FLT_MAX;
-    entry->f_score = FLT_MAX;
-    entry->has_step = false;
-    entry->next = table->buckets[index];
-    table->buckets[index] = entry;
-    table->entry_count++;
-    
-    // TODO: Resize table if load factor gets too high
-    
-    return entry;
-}
-
-/* A* implementation */
-
-SylvesAStarPathfinding* sylves_astar_create(
-    SylvesGrid* grid,
-    SylvesCell src,
-    SylvesStepLengthFunc step_lengths,
-    SylvesHeuristicFunc heuristic,
-    void* user_data) {
-    
-    if (!grid || !heuristic) return NULL;
-    
-    SylvesAStarPathfinding* astar = (SylvesAStarPathfinding*)sylves_alloc(sizeof(SylvesAStarPathfinding));
-    if (!astar) return NULL;
-    
-    astar->grid = grid;
-    astar->src = src;
-    astar->step_lengths = step_lengths ? step_lengths : default_step_length;
-    astar->heuristic = heuristic;
-    astar->user_data = user_data;
-    
-    astar->visited = hash_table_create(HASH_TABLE_INITIAL_SIZE);
-    astar->open_set = sylves_heap_create(16);
-    
-    if (!astar->visited || !astar->open_set) {
-        hash_table_destroy(astar->visited);
-        sylves_heap_destroy(astar->open_set);
-        sylves_free(astar);
-        return NULL;
-    }
+void sylves_path_astar_seed(SylvesPathfindingContext* ctx, SylvesGrid* grid, SylvesCell src,
+                            SylvesHeuristicFunc heuristic, void* user_data) {
+    sylves_pathfinding_context_reset(ctx);
+    sylves_path_map_bind(&ctx->nodes, grid);
     
     // Initialize source cell
-    CellHashEntry* src_entry = hash_table_insert(astar->visited, src);
-    if (src_entry) {
-        src_entry->g_score = 0.0f;
-        src_entry->f_score = heuristic(src, user_data);
+    int32_t src_node = sylves_path_map_insert(&ctx->nodes, src);
+    if (src_node >= 0) {
+        float src_f = heuristic(src, user_data);
+        sylves_path_map_set_score(&ctx->nodes, src_node, 0.0f, src_f);
         
         // Add to open set
-        sylves_heap_insert(astar->open_set, src_entry, src_entry->f_score);
+        sylves_indexed_heap_push(ctx->open_set, (uint32_t)src_node, src_f);
     }
-    
-    return astar;
 }
 
-void sylves_astar_destroy(SylvesAStarPathfinding* astar) {
-    if (!astar) return;
-    
-    hash_table_destroy(astar->visited);
-    sylves_heap_destroy(astar->open_set);
-    sylves_free(astar);
-}
-
-void sylves_astar_run(SylvesAStarPathfinding* astar, SylvesCell target) {
-    if (!astar) return;
-    
-    while (!sylves_heap_is_empty(astar->open_set)) {
-        float current_f;
-        if (!sylves_heap_peek_key(astar->open_set, &current_f)) {
-            break;
-        }
-        
-        CellHashEntry* current_entry = (CellHashEntry*)sylves_heap_pop(astar->open_set);
-        if (!current_entry) break;
-        
-        SylvesCell current = current_entry->cell;
-        float g_score = current_entry->g_score;
-        float f_score = current_entry->f_score;
+void sylves_path_astar_expand(SylvesPathfindingContext* ctx, SylvesGrid* grid, SylvesCell target,
+                              SylvesStepLengthFunc step_lengths, SylvesHeuristicFunc heuristic,
+                              void* user_data) {
+    SylvesPathNodeMap* visited = &ctx->nodes;
+    SylvesIndexedHeap* open_set = ctx->open_set;
+    
+    // Each open node has one entry whose key is lowered in place, so no pop is stale
+    uint32_t handle;
+    while (sylves_indexed_heap_pop(open_set, &handle, NULL)) {
+        int32_t current_node = (int32_t)handle;
+        SylvesCell current = sylves_path_map_cell(visited, current_node);
+        float g_score = sylves_path_map_g(visited, current_node);
         
         // Check if we've reached the target
         if (sylves_cell_equals(current, target)) {
             break;
         }
         
-        // Skip if this is a redundant entry (we've already visited with lower score)
-        if (f_score < current_f) {
-            continue;
-        }
-        
         // Explore neighbors
-        const SylvesCellType* ct = sylves_grid_get_cell_type(astar->grid, current);
+        const SylvesCellType* ct = sylves_grid_get_cell_type(grid, current);
         if (!ct) {
             continue;
         }
@@ -224,7 +83,7 @@ void sylves_astar_run(SylvesAStarPathfinding* astar, SylvesCell target) {
             }
             heap_dirs = true;
         }
-        int dir_count_i = sylves_grid_get_cell_dirs(astar->grid, current, dirs_buf, max_dirs);
+        int dir_count_i = sylves_grid_get_cell_dirs(grid, current, dirs_buf, max_dirs);
         if (dir_count_i < 0) {
             if (heap_dirs) sylves_free(dirs_buf);
             continue;
@@ -234,8 +93,8 @@ void sylves_astar_run(SylvesAStarPathfinding* astar, SylvesCell target) {
         for (size_t i = 0; i < dir_count; i++) {
             SylvesStep step;
             SylvesError err = sylves_step_create(
-                astar->grid, current, dirs_buf[i], 
-                astar->step_lengths, astar->user_data, &step);
+                grid, current, dirs_buf[i], 
+                step_lengths, user_data, &step);
             
             if (err != SYLVES_SUCCESS) continue;
             
@@ -246,21 +105,17 @@ void sylves_astar_run(SylvesAStarPathfinding* astar, SylvesCell target) {
             SylvesCell neighbor = step.dest;
             
             // Get or create neighbor entry
-            CellHashEntry* neighbor_entry = hash_table_find(astar->visited, neighbor);
-            if (!neighbor_entry) {
-                neighbor_entry = hash_table_insert(astar->visited, neighbor);
-                if (!neighbor_entry) continue;
-            }
+            int32_t neighbor_node = sylves_path_map_insert(visited, neighbor);
+            if (neighbor_node < 0) continue;
             
             // Check if this path is better
-            if (tentative_g < neighbor_entry->g_score) {
-                neighbor_entry->g_score = tentative_g;
-                neighbor_entry->f_score = tentative_g + astar->heuristic(neighbor, astar->user_data);
-                neighbor_entry->step = step;
-                neighbor_entry->has_step = true;
+            if (tentative_g < sylves_path_map_g(visited, neighbor_node)) {
+                float neighbor_f = tentative_g + heuristic(neighbor, user_data);
+                sylves_path_map_set_score(visited, neighbor_node, tentative_g, neighbor_f);
+                sylves_path_map_set_step(visited, neighbor_node, &step);
                 
-                // Add to open set
-                sylves_heap_insert(astar->open_set, neighbor_entry, neighbor_entry->f_score);
+                // Add to open set, or move its entry up
+                sylves_indexed_heap_push(open_set, (uint32_t)neighbor_node, neighbor_f);
             }
         }
         
@@ -268,47 +123,57 @@ void sylves_astar_run(SylvesAStarPathfinding* astar, SylvesCell target) {
     }
 }
 
-SylvesCellPath* sylves_astar_extract_path(SylvesAStarPathfinding* astar, SylvesCell target) {
+/* A* implementation */
+
+SylvesAStarPathfinding* sylves_astar_create(
+    SylvesGrid* grid,
+    SylvesCell src,
+    SylvesStepLengthFunc step_lengths,
+    SylvesHeuristicFunc heuristic,
+    void* user_data) {
+    
+    if (!grid || !heuristic) return NULL;
+    
+    SylvesAStarPathfinding* astar = (SylvesAStarPathfinding*)sylves_alloc(sizeof(SylvesAStarPathfinding));
     if (!astar) return NULL;
     
-    // Check if we reached the target
-    CellHashEntry* target_entry = hash_table_find(astar->visited, target);
-    if (!target_entry || !target_entry->has_step) {
-        // Check if target is the source
-        if (sylves_cell_equals(target, astar->src)) {
-            return sylves_cell_path_create(NULL, 0);
-        }
-        return NULL;
-    }
+    astar->grid = grid;
+    astar->src = src;
+    astar->step_lengths = step_lengths ? step_lengths : default_step_length;
+    astar->heuristic = heuristic;
+    astar->user_data = user_data;
     
-    // Count steps
-    size_t step_count = 0;
-    SylvesCell current = target;
-    while (!sylves_cell_equals(current, astar->src)) {
-        CellHashEntry* entry = hash_table_find(astar->visited, current);
-        if (!entry || !entry->has_step) break;
-        step_count++;
-        current = entry->step.src;
+    if (!sylves_path_context_init(&astar->search, 0)) {
+        sylves_free(astar);
+        return NULL;
     }
     
-    if (!sylves_cell_equals(current, astar->src)) {
-        return NULL; // Path reconstruction failed
-    }
+    sylves_path_astar_seed(&astar->search, grid, src, heuristic, user_data);
     
-    // Build path
-    SylvesStep* steps = (SylvesStep*)sylves_alloc(sizeof(SylvesStep) * step_count);
-    if (!steps) return NULL;
+    return astar;
+}
+
+void sylves_astar_destroy(SylvesAStarPathfinding* astar) {
+    if (!astar) return;
     
-    current = target;
-    for (size_t i = step_count; i > 0; i--) {
-        CellHashEntry* entry = hash_table_find(astar->visited, current);
-        steps[i - 1] = entry->step;
-        current = entry->step.src;
-    }
+    sylves_path_context_release(&astar->search);
+    sylves_free(astar);
+}
+
+void sylves_astar_run(SylvesAStarPathfinding* astar, SylvesCell target) {
+    if (!astar) return;
     
-    SylvesCellPath* path = sylves_cell_path_create(steps, step_count);
-    sylves_free(steps);
+    sylves_path_astar_expand(&astar->search, astar->grid, target,
+                             astar->step_lengths, astar->heuristic, astar->user_data);
+}
+
+SylvesCellPath* sylves_astar_extract_path(SylvesAStarPathfinding* astar, SylvesCell target) {
+    if (!astar) return NULL;
     
+    SylvesCellPath* path = sylves_path_map_extract(&astar->search.nodes, target);
+    if (!path && sylves_cell_equals(target, astar->src)) {
+        return sylves_cell_path_create(NULL, 0);
+    }
     return path;
 }
 
@@ -8,36 +8,9 @@
 #include "sylves/errors.h"
 #include "sylves/grid.h"
 #include "sylves/cell_type.h"
+#include "internal/path_search.h"
 #include <string.h>
-#include <limits.h>
-
-/* Hash table for cell lookups */
-#define HASH_TABLE_INITIAL_SIZE 64
-
-typedef struct CellHashEntry {
-    SylvesCell cell;
-    int distance;       // Distance from start (in steps)
-    SylvesStep step;    // How we got here
-    bool has_step;      // Whether step is valid
-    struct CellHashEntry* next;
-} CellHashEntry;
-
-typedef struct {
-    CellHashEntry** buckets;
-    size_t bucket_count;
-    size_t entry_count;
-} CellHashTable;
-
-/* Queue for BFS */
-typedef struct QueueNode {
-    SylvesCell cell;
-    struct QueueNode* next;
-} QueueNode;
-
-typedef struct {
-    QueueNode* head;
-    QueueNode* tail;
-} Queue;
+#include <float.h>
 
 /* BFS pathfinding context */
 struct SylvesBFSPathfinding {
@@ -46,153 +19,9 @@ struct SylvesBFSPathfinding {
     SylvesIsAccessibleFunc is_accessible;
     void* user_data;
     
-    CellHashTable* visited;
-    bool early_termination;
+    SylvesPathNodeMap visited;  // g holds the distance in steps
 };
 
-/* Hash function for cells */
-static size_t cell_hash(SylvesCell cell) {
-    // Simple hash combining x, y, z coordinates
-    size_t hash = 0;
-    hash ^= (size_t)cell.x + 0x9e3779b9 + (hash << 6) + (hash >> 2);
-    hash ^= (size_t)cell.y + 0x9e3779b9 + (hash << 6) + (hash >> 2);
-    hash ^= (size_t)cell.z + 0x9e3779b9 + (hash << 6) + (hash >> 2);
-    return hash;
-}
-
-/* Hash table operations */
-static CellHashTable* hash_table_create(size_t initial_size) {
-    CellHashTable* table = (CellHashTable*)sylves_alloc(sizeof(CellHashTable));
-    if (!table) return NULL;
-    
-    table->buckets = (CellHashEntry**)sylves_calloc(initial_size, sizeof(CellHashEntry*));
-    if (!table->buckets) {
-        sylves_free(table);
-        return NULL;
-    }
-    
-    table->bucket_count = initial_size;
-    table->entry_count = 0;
-    
-    return table;
-}
-
-static void hash_table_destroy(CellHashTable* table) {
-    if (!table) return;
-    
-    // Free all entries
-    for (size_t i = 0; i < table->bucket_count; i++) {
-        CellHashEntry* entry = table->buckets[i];
-        while (entry) {
-            CellHashEntry* next = entry->next;
-            sylves_free(entry);
-            entry = next;
-        }
-    }
-    
-    sylves_free(table->buckets);
-    sylves_free(table);
-}
-
-static CellHashEntry* hash_table_find(CellHashTable* table, SylvesCell cell) {
-    size_t index = cell_hash(cell) % table->bucket_count;
-    CellHashEntry* entry = table->buckets[index];
-    
-    while (entry) {
-        if (sylves_cell_equals(entry->cell, cell)) {
-            return entry;
-        }
-        entry = entry->next;
-    }
-    
-    return NULL;
-}
-
-static CellHashEntry* hash_table_insert(CellHashTable* table, SylvesCell cell) {
-    size_t index = cell_hash(cell) % table->bucket_count;
-    
-    // Check if already exists
-    CellHashEntry* existing = hash_table_find(table, cell);
-    if (existing) return existing;
-    
-    // Create new entry
-    CellHashEntry* entry = (CellHashEntry*)sylves_alloc(sizeof(CellHashEntry));
-    if (!entry) return NULL;
-    
-    entry->cell = cell;
-    entry->distance = INT_MAX;
-    entry->has_step = false;
-    entry->next = table->buckets[index];
-    table->buckets[index] = entry;
-    table->entry_count++;
-    
-    // TODO: Resize table if load factor gets too high
-    
-    return entry;
-}
-
-/* Queue operations */
-static Queue* queue_create(void) {
-    Queue* queue = (Queue*)sylves_alloc(sizeof(Queue));
-    if (!queue) return NULL;
-    
-    queue->head = NULL;
-    queue->tail = NULL;
-    
-    return queue;
-}
-
-static void queue_destroy(Queue* queue) {
-    if (!queue) return;
-    
-    QueueNode* node = queue->head;
-    while (node) {
-        QueueNode* next = node->next;
-        sylves_free(node);
-        node = next;
-    }
-    
-    sylves_free(queue);
-}
-
-static bool queue_enqueue(Queue* queue, SylvesCell cell) {
-    if (!queue) return false;
-    
-    QueueNode* node = (QueueNode*)sylves_alloc(sizeof(QueueNode));
-    if (!node) return false;
-    
-    node->cell = cell;
-    node->next = NULL;
-    
-    if (queue->tail) {
-        queue->tail->next = node;
-    } else {
-        queue->head = node;
-    }
-    queue->tail = node;
-    
-    return true;
-}
-
-static bool queue_dequeue(Queue* queue, SylvesCell* cell) {
-    if (!queue || !queue->head) return false;
-    
-    QueueNode* node = queue->head;
-    *cell = node->cell;
-    
-    queue->head = node->next;
-    if (!queue->head) {
-        queue->tail = NULL;
-    }
-    
-    sylves_free(node);
-    return true;
-}
-
-static bool queue_is_empty(Queue* queue) {
-    return !queue || !queue->head;
-}
-
 /* BFS implementation */
 
 SylvesBFSPathfinding* sylves_bfs_create(
@@ -210,18 +39,18 @@ SylvesBFSPathfinding* sylves_bfs_create(
     bfs->src = src;
     bfs->is_accessible = is_accessible;
     bfs->user_data = user_data;
-    bfs->early_termination = false;
     
-    bfs->visited = hash_table_create(HASH_TABLE_INITIAL_SIZE);
-    if (!bfs->visited) {
+    if (!sylves_path_map_init(&bfs->visited, 0)) {
         sylves_free(bfs);
         return NULL;
     }
     
+    sylves_path_map_bind(&bfs->visited, grid);
+    
     // Initialize source cell
-    CellHashEntry* src_entry = hash_table_insert(bfs->visited, src);
-    if (src_entry) {
-        src_entry->distance = 0;
+    int32_t src_node = sylves_path_map_insert(&bfs->visited, src);
+    if (src_node >= 0) {
+        sylves_path_map_set_score(&bfs->visited, src_node, 0.0f, 0.0f);
     }
     
     return bfs;
@@ -230,7 +59,7 @@ SylvesBFSPathfinding* sylves_bfs_create(
 void sylves_bfs_destroy(SylvesBFSPathfinding* bfs) {
     if (!bfs) return;
     
-    hash_table_destroy(bfs->visited);
+    sylves_path_map_release(&bfs->visited);
     sylves_free(bfs);
 }
 
@@ -242,46 +71,50 @@ void sylves_bfs_run(
     
     if (!bfs) return;
     
-    Queue* queue = queue_create();
-    if (!queue) return;
-    
-    // Start from source
-    queue_enqueue(queue, bfs->src);
-    
     // Check if source is accessible
     if (bfs->is_accessible && !bfs->is_accessible(bfs->src, bfs->user_data)) {
-        queue_destroy(queue);
         return;
     }
     
-    while (!queue_is_empty(queue)) {
-        SylvesCell current;
-        if (!queue_dequeue(queue, &current)) break;
-        
-        CellHashEntry* current_entry = hash_table_find(bfs->visited, current);
-        if (!current_entry) continue;
-        
-        int distance = current_entry->distance;
-        
-        // Check if we've reached max distance
-        if (max_distance >= 0 && distance >= max_distance) {
-            continue;
-        }
+    int32_t src_node = sylves_path_map_find(&bfs->visited, bfs->src);
+    if (src_node < 0) return;
+    
+    SylvesPathQueue queue;
+    if (!sylves_path_queue_init(&queue, 64)) return;
+    
+    // Start from source
+    sylves_path_queue_push(&queue, src_node);
+    
+    // Cells with more directions than the stack buffer holds grow it in the scratch arena
+    SylvesCellDir stack_dirs[16];
+    SylvesCellDir* dirs_buf = stack_dirs;
+    size_t dirs_capacity = sizeof(stack_dirs) / sizeof(stack_dirs[0]);
+    SylvesArena* scratch = sylves_get_thread_scratch_arena();
+    SylvesArenaMark scratch_mark = sylves_arena_push(scratch);
+    
+    size_t targets_found = 0;
+    int32_t current_node;
+    while (sylves_path_queue_pop(&queue, &current_node)) {
+        SylvesCell current = sylves_path_map_cell(&bfs->visited, current_node);
+        int distance = (int)sylves_path_map_g(&bfs->visited, current_node);
         
-        // Check if we've reached a target
+        // Stop once every target has been reached; each cell is dequeued once
         if (targets && target_count > 0) {
-            bool found_target = false;
             for (size_t i = 0; i < target_count; i++) {
                 if (sylves_cell_equals(current, targets[i])) {
-                    found_target = true;
-                    break;
+                    targets_found++;
                 }
             }
-            if (found_target && bfs->early_termination) {
+            if (targets_found >= target_count) {
                 break;
             }
         }
         
+        // Check if we've reached max distance
+        if (max_distance >= 0 && distance >= max_distance) {
+            continue;
+        }
+        
         // Explore neighbors
         const SylvesCellType* ct = sylves_grid_get_cell_type(bfs->grid, current);
         if (!ct) {
@@ -292,19 +125,16 @@ void sylves_bfs_run(
             continue;
         }
         size_t max_dirs = (size_t)max_dirs_i;
-        SylvesCellDir stack_dirs[16];
-        SylvesCellDir* dirs_buf = stack_dirs;
-        bool heap_dirs = false;
-        if (max_dirs > (sizeof(stack_dirs) / sizeof(stack_dirs[0]))) {
-            dirs_buf = (SylvesCellDir*)sylves_alloc(sizeof(SylvesCellDir) * max_dirs);
-            if (!dirs_buf) {
+        if (max_dirs > dirs_capacity) {
+            SylvesCellDir* grown = (SylvesCellDir*)sylves_arena_alloc(scratch, sizeof(SylvesCellDir) * max_dirs);
+            if (!grown) {
                 continue;
             }
-            heap_dirs = true;
+            dirs_buf = grown;
+            dirs_capacity = max_dirs;
         }
         int dir_count_i = sylves_grid_get_cell_dirs(bfs->grid, current, dirs_buf, max_dirs);
         if (dir_count_i < 0) {
-            if (heap_dirs) sylves_free(dirs_buf);
             continue;
         }
         size_t dir_count = (size_t)dir_count_i;
@@ -325,18 +155,13 @@ void sylves_bfs_run(
                 continue;
             }
             
-            // Check if already visited
-            CellHashEntry* neighbor_entry = hash_table_find(bfs->visited, neighbor);
-            if (neighbor_entry && neighbor_entry->distance < INT_MAX) {
+            // Add neighbor to visited, skipping it if already reached
+            int32_t neighbor_node = sylves_path_map_insert(&bfs->visited, neighbor);
+            if (neighbor_node < 0) continue;
+            if (sylves_path_map_g(&bfs->visited, neighbor_node) != FLT_MAX) {
                 continue;
             }
             
-            // Add neighbor to visited
-            if (!neighbor_entry) {
-                neighbor_entry = hash_table_insert(bfs->visited, neighbor);
-                if (!neighbor_entry) continue;
-            }
-            
             // Create step
             SylvesStep step;
             step.src = current;
@@ -346,18 +171,16 @@ void sylves_bfs_run(
             step.connection = connection;
             step.length = 1.0f;
             
-            neighbor_entry->distance = distance + 1;
-            neighbor_entry->step = step;
-            neighbor_entry->has_step = true;
+            sylves_path_map_set_score(&bfs->visited, neighbor_node, (float)(distance + 1), (float)(distance + 1));
+            sylves_path_map_set_step(&bfs->visited, neighbor_node, &step);
             
             // Add to queue
-            queue_enqueue(queue, neighbor);
+            sylves_path_queue_push(&queue, neighbor_node);
         }
-        
-        if (heap_dirs) sylves_free(dirs_buf);
     }
     
-    queue_destroy(queue);
+    sylves_arena_pop(scratch, scratch_mark);
+    sylves_path_queue_release(&queue);
 }
 
 bool sylves_bfs_is_reachable(
@@ -367,13 +190,18 @@ bool sylves_bfs_is_reachable(
     
     if (!bfs) return false;
     
-    CellHashEntry* entry = hash_table_find(bfs->visited, cell);
-    if (!entry || entry->distance == INT_MAX) {
+    int32_t node = sylves_path_map_find(&bfs->visited, cell);
+    if (node < 0) {
+        return false;
+    }
+    
+    float g = sylves_path_map_g(&bfs->visited, node);
+    if (g == FLT_MAX) {
         return false;
     }
     
     if (distance) {
-        *distance = entry->distance;
+        *distance = (int)g;
     }
     
     return true;
@@ -382,43 +210,9 @@ bool sylves_bfs_is_reachable(
 SylvesCellPath* sylves_bfs_extract_path(SylvesBFSPathfinding* bfs, SylvesCell target) {
     if (!bfs) return NULL;
     
-    // Check if we reached the target
-    CellHashEntry* target_entry = hash_table_find(bfs->visited, target);
-    if (!target_entry || target_entry->distance == INT_MAX) {
-        // Check if target is the source
-        if (sylves_cell_equals(target, bfs->src)) {
-            return sylves_cell_path_create(NULL, 0);
-        }
-        return NULL;
-    }
-    
-    // Count steps
-    size_t step_count = 0;
-    SylvesCell current = target;
-    while (!sylves_cell_equals(current, bfs->src)) {
-        CellHashEntry* entry = hash_table_find(bfs->visited, current);
-        if (!entry || !entry->has_step) break;
-        step_count++;
-        current = entry->step.src;
-    }
-    
-    if (!sylves_cell_equals(current, bfs->src)) {
-        return NULL; // Path reconstruction failed
+    SylvesCellPath* path = sylves_path_map_extract(&bfs->visited, target);
+    if (!path && sylves_cell_equals(target, bfs->src)) {
+        return sylves_cell_path_create(NULL, 0);
     }
-    
-    // Build path
-    SylvesStep* steps = (SylvesStep*)sylves_alloc(sizeof(SylvesStep) * step_count);
-    if (!steps) return NULL;
-    
-    current = target;
-    for (size_t i = step_count; i > 0; i--) {
-        CellHashEntry* entry = hash_table_find(bfs->visited, current);
-        steps[i - 1] = entry->step;
-        current = entry->step.src;
-    }
-    
-    SylvesCellPath* path = sylves_cell_path_create(steps, step_count);
-    sylves_free(steps);
-    
     return path;
 }
@@ -0,0 +1,321 @@
+/**
+ * @file bidir_astar_pathfinding.c
+ * @brief Bidirectional A* pathfinding implementation
+ */
+
+#include "sylves/pathfinding.h"
+#include "sylves/memory.h"
+#include "sylves/errors.h"
+#include "sylves/cell.h"
+#include "sylves/grid.h"
+#include "sylves/cell_type.h"
+#include "internal/path_search.h"
+#include <string.h>
+#include <float.h>
+
+/* Forward declaration */
+static float default_step_length(const SylvesStep* step, void* user_data);
+
+/* Bidirectional A* pathfinding context */
+struct SylvesBidirAStarPathfinding {
+    SylvesGrid* grid;
+    SylvesCell src;
+    SylvesCell dest;
+    SylvesStepLengthFunc step_lengths;
+    SylvesCellDistanceFunc heuristic;
+    void* user_data;
+
+    SylvesPathfindingContext forward;   // tree rooted at src
+    SylvesPathfindingContext backward;  // tree rooted at dest, over reversed steps
+
+    float best;         // length of the best src-dest path seen so far
+    SylvesCell meet;    // cell where that path joins the two trees
+    bool done;
+};
+
+/*
+ * Both sides use the averaged potential p(v) = (h(v, dest) - h(v, src)) / 2,
+ * forward adding it and backward subtracting it. A path through v then
+ * has forward plus backward key equal to its length, so the search can
+ * stop as soon as the two smallest keys add up to the best path, the same
+ * rule as bidirectional Dijkstra (which is what a NULL heuristic gives).
+ */
+static float potential(const SylvesBidirAStarPathfinding* bidir, SylvesCell cell) {
+    if (!bidir->heuristic) return 0.0f;
+    return 0.5f * (bidir->heuristic(cell, bidir->dest, bidir->user_data) -
+                   bidir->heuristic(cell, bidir->src, bidir->user_data));
+}
+
+static void seed(SylvesBidirAStarPathfinding* bidir, SylvesPathfindingContext* ctx,
+                 SylvesCell root, float sign) {
+    sylves_pathfinding_context_reset(ctx);
+    sylves_path_map_bind(&ctx->nodes, bidir->grid);
+
+    int32_t node = sylves_path_map_insert(&ctx->nodes, root);
+    if (node >= 0) {
+        float f = sign * potential(bidir, root);
+        sylves_path_map_set_score(&ctx->nodes, node, 0.0f, f);
+        sylves_indexed_heap_push(ctx->open_set, (uint32_t)node, f);
+    }
+}
+
+/* A cell reached with cost g on one side joins a path if the other side has reached it too */
+static void try_meet(SylvesBidirAStarPathfinding* bidir, const SylvesPathfindingContext* other,
+                     SylvesCell cell, float g) {
+    int32_t node = sylves_path_map_find(&other->nodes, cell);
+    if (node < 0) return;
+    float other_g = sylves_path_map_g(&other->nodes, node);
+    if (other_g != FLT_MAX && g + other_g < bidir->best) {
+        bidir->best = g + other_g;
+        bidir->meet = cell;
+    }
+}
+
+/* Fill dirs for cell, spilling to the heap past the stack buffer; returns the count or -1 */
+static int get_dirs(SylvesGrid* grid, SylvesCell cell, SylvesCellDir* stack_dirs, size_t stack_count,
+                    SylvesCellDir** dirs) {
+    *dirs = stack_dirs;
+    const SylvesCellType* ct = sylves_grid_get_cell_type(grid, cell);
+    if (!ct) return -1;
+    int max_dirs = sylves_cell_type_get_dir_count(ct);
+    if (max_dirs <= 0) return -1;
+    if ((size_t)max_dirs > stack_count) {
+        *dirs = (SylvesCellDir*)sylves_alloc(sizeof(SylvesCellDir) * (size_t)max_dirs);
+        if (!*dirs) return -1;
+    }
+    int count = sylves_grid_get_cell_dirs(grid, cell, *dirs, (size_t)max_dirs);
+    if (count < 0 && *dirs != stack_dirs) {
+        sylves_free(*dirs);
+        *dirs = stack_dirs;
+    }
+    return count;
+}
+
+static void expand_forward(SylvesBidirAStarPathfinding* bidir, int32_t current_node) {
+    SylvesPathNodeMap* visited = &bidir->forward.nodes;
+    SylvesCell current = sylves_path_map_cell(visited, current_node);
+    float g_score = sylves_path_map_g(visited, current_node);
+
+    SylvesCellDir stack_dirs[16];
+    SylvesCellDir* dirs;
+    int dir_count = get_dirs(bidir->grid, current, stack_dirs, 16, &dirs);
+
+    for (int i = 0; i < dir_count; i++) {
+        SylvesStep step;
+        if (sylves_step_create(bidir->grid, current, dirs[i], bidir->step_lengths,
+                               bidir->user_data, &step) != SYLVES_SUCCESS) continue;
+        if (step.length < 0) continue;
+
+        float tentative_g = g_score + step.length;
+        int32_t neighbor_node = sylves_path_map_insert(visited, step.dest);
+        if (neighbor_node < 0) continue;
+
+        if (tentative_g < sylves_path_map_g(visited, neighbor_node)) {
+            float neighbor_f = tentative_g + potential(bidir, step.dest);
+            sylves_path_map_set_score(visited, neighbor_node, tentative_g, neighbor_f);
+            sylves_path_map_set_step(visited, neighbor_node, &step);
+            sylves_indexed_heap_push(bidir->forward.open_set, (uint32_t)neighbor_node, neighbor_f);
+            try_meet(bidir, &bidir->backward, step.dest, tentative_g);
+        }
+    }
+
+    if (dirs != stack_dirs) sylves_free(dirs);
+}
+
+/*
+ * Backward expansion finds the cells that step into current: try_move out
+ * of current gives each neighbor and the inverse dir, which is the forward
+ * step from the neighbor back in. That step is measured as a forward step,
+ * and stored reversed so the tree's parent dirs point towards dest.
+ */
+static void expand_backward(SylvesBidirAStarPathfinding* bidir, int32_t current_node) {
+    SylvesPathNodeMap* visited = &bidir->backward.nodes;
+    SylvesCell current = sylves_path_map_cell(visited, current_node);
+    float g_score = sylves_path_map_g(visited, current_node);
+
+    SylvesCellDir stack_dirs[16];
+    SylvesCellDir* dirs;
+    int dir_count = get_dirs(bidir->grid, current, stack_dirs, 16, &dirs);
+
+    for (int i = 0; i < dir_count; i++) {
+        SylvesCell neighbor;
+        SylvesCellDir inverse_dir;
+        if (!sylves_grid_try_move(bidir->grid, current, dirs[i], &neighbor, &inverse_dir, NULL)) continue;
+
+        SylvesStep forward_step;
+        if (sylves_step_create(bidir->grid, neighbor, inverse_dir, bidir->step_lengths,
+                               bidir->user_data, &forward_step) != SYLVES_SUCCESS) continue;
+        if (forward_step.length < 0 || !sylves_cell_equals(forward_step.dest, current)) continue;
+
+        float tentative_g = g_score + forward_step.length;
+        int32_t neighbor_node = sylves_path_map_insert(visited, neighbor);
+        if (neighbor_node < 0) continue;
+
+        if (tentative_g < sylves_path_map_g(visited, neighbor_node)) {
+            SylvesStep reversed = forward_step;
+            reversed.src = current;
+            reversed.dest = neighbor;
+            reversed.dir = dirs[i];
+            reversed.inverse_dir = inverse_dir;
+
+            float neighbor_f = tentative_g - potential(bidir, neighbor);
+            sylves_path_map_set_score(visited, neighbor_node, tentative_g, neighbor_f);
+            sylves_path_map_set_step(visited, neighbor_node, &reversed);
+            sylves_indexed_heap_push(bidir->backward.open_set, (uint32_t)neighbor_node, neighbor_f);
+            try_meet(bidir, &bidir->forward, neighbor, tentative_g);
+        }
+    }
+
+    if (dirs != stack_dirs) sylves_free(dirs);
+}
+
+/* Bidirectional A* implementation */
+
+SylvesBidirAStarPathfinding* sylves_bidir_astar_create(
+    SylvesGrid* grid,
+    SylvesCell src,
+    SylvesCell dest,
+    SylvesStepLengthFunc step_lengths,
+    SylvesCellDistanceFunc heuristic,
+    void* user_data) {
+
+    if (!grid) return NULL;
+
+    SylvesBidirAStarPathfinding* bidir = (SylvesBidirAStarPathfinding*)sylves_alloc(sizeof(SylvesBidirAStarPathfinding));
+    if (!bidir) return NULL;
+
+    bidir->grid = grid;
+    bidir->src = src;
+    bidir->dest = dest;
+    bidir->step_lengths = step_lengths ? step_lengths : default_step_length;
+    bidir->heuristic = heuristic;
+    bidir->user_data = user_data;
+    bidir->best = FLT_MAX;
+    bidir->meet = src;
+    bidir->done = false;
+
+    if (!sylves_path_context_init(&bidir->forward, 0)) {
+        sylves_free(bidir);
+        return NULL;
+    }
+    if (!sylves_path_context_init(&bidir->backward, 0)) {
+        sylves_path_context_release(&bidir->forward);
+        sylves_free(bidir);
+        return NULL;
+    }
+
+    seed(bidir, &bidir->forward, src, 1.0f);
+    seed(bidir, &bidir->backward, dest, -1.0f);
+    try_meet(bidir, &bidir->backward, src, 0.0f);
+
+    return bidir;
+}
+
+void sylves_bidir_astar_destroy(SylvesBidirAStarPathfinding* bidir) {
+    if (!bidir) return;
+
+    sylves_path_context_release(&bidir->forward);
+    sylves_path_context_release(&bidir->backward);
+    sylves_free(bidir);
+}
+
+bool sylves_bidir_astar_run(SylvesBidirAStarPathfinding* bidir) {
+    if (!bidir) return false;
+
+    /*
+     * With a consistent heuristic any path shorter than best would still
+     * have its forward and backward parts open with keys summing below
+     * best, so best is optimal once the smallest keys reach it (or a side
+     * runs dry).
+     */
+    while (!bidir->done) {
+        float forward_f, backward_f;
+        if (!sylves_indexed_heap_peek_key(bidir->forward.open_set, &forward_f) ||
+            !sylves_indexed_heap_peek_key(bidir->backward.open_set, &backward_f) ||
+            forward_f + backward_f >= bidir->best) {
+            bidir->done = true;
+            break;
+        }
+
+        // Grow the smaller frontier
+        uint32_t handle;
+        if (bidir->forward.open_set->size <= bidir->backward.open_set->size) {
+            sylves_indexed_heap_pop(bidir->forward.open_set, &handle, NULL);
+            expand_forward(bidir, (int32_t)handle);
+        } else {
+            sylves_indexed_heap_pop(bidir->backward.open_set, &handle, NULL);
+            expand_backward(bidir, (int32_t)handle);
+        }
+    }
+
+    return bidir->best != FLT_MAX;
+}
+
+SylvesError sylves_bidir_astar_get_distance(SylvesBidirAStarPathfinding* bidir, float* distance) {
+    if (!bidir || !distance) {
+        return SYLVES_ERROR_INVALID_ARGUMENT;
+    }
+    if (bidir->best == FLT_MAX) {
+        return SYLVES_ERROR_CELL_NOT_FOUND;
+    }
+    *distance = bidir->best;
+    return SYLVES_SUCCESS;
+}
+
+SylvesCellPath* sylves_bidir_astar_extract_path(SylvesBidirAStarPathfinding* bidir) {
+    if (!bidir || bidir->best == FLT_MAX) return NULL;
+
+    SylvesCellPath* head = sylves_path_map_extract(&bidir->forward.nodes, bidir->meet);
+    if (!head) return NULL;
+
+    // Count the backward tree's steps from meet to dest
+    const SylvesPathNodeMap* backward = &bidir->backward.nodes;
+    size_t tail_count = 0;
+    SylvesCell current = bidir->meet;
+    int32_t node = sylves_path_map_find(backward, current);
+    SylvesCellDir dir = 0;
+    while (node >= 0 && sylves_path_map_parent_dir(backward, node, &dir)) {
+        SylvesCell next;
+        if (!sylves_grid_try_move(bidir->grid, current, dir, &next, NULL, NULL)) break;
+        tail_count++;
+        current = next;
+        node = sylves_path_map_find(backward, current);
+    }
+    if (!sylves_cell_equals(current, bidir->dest)) {
+        sylves_cell_path_destroy(head);
+        return NULL;
+    }
+
+    size_t step_count = head->step_count + tail_count;
+    if (step_count == 0) {
+        return head;
+    }
+    SylvesStep* steps = (SylvesStep*)sylves_alloc(sizeof(SylvesStep) * step_count);
+    if (!steps) {
+        sylves_cell_path_destroy(head);
+        return NULL;
+    }
+    if (head->step_count > 0) {
+        memcpy(steps, head->steps, sizeof(SylvesStep) * head->step_count);
+    }
+
+    // Re-create the tail as forward steps, which also restores their lengths
+    current = bidir->meet;
+    for (size_t i = head->step_count; i < step_count; i++) {
+        sylves_path_map_parent_dir(backward, sylves_path_map_find(backward, current), &dir);
+        sylves_step_create(bidir->grid, current, dir, bidir->step_lengths, bidir->user_data, &steps[i]);
+        current = steps[i].dest;
+    }
+
+    SylvesCellPath* path = sylves_cell_path_create(steps, step_count);
+    sylves_free(steps);
+    sylves_cell_path_destroy(head);
+    return path;
+}
+
+/* Default step length function */
+static float default_step_length(const SylvesStep* step, void* user_data) {
+    (void)step;
+    (void)user_data;
+    return 1.0f;
+}
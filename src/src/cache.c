@@ -2,14 +2,14 @@
 #include "sylves/memory.h"
 #include "sylves/pathfinding.h"
 #include "sylves/mesh_data.h"
+#include "internal/sync.h"
 #include <string.h>
 #include <stdlib.h>
+#include <stdint.h>
 
 #ifdef _WIN32
-#include <windows.h>
 #define GET_TIME_US() (GetTickCount64() * 1000)
 #else
-#include <pthread.h>
 #include <sys/time.h>
 static uint64_t GET_TIME_US() {
     struct timeval tv;
@@ -18,42 +18,146 @@ static uint64_t GET_TIME_US() {
 }
 #endif
 
+#define CACHE_DEFAULT_SHARDS 16
+#define CACHE_MAX_SHARDS 256
+#define CACHE_MIN_SHARD_ENTRIES 32   /* Fewer shards rather than tiny per-shard budgets */
+#define CACHE_MIN_SHARD_BUCKETS 16
+#define CACHE_MAX_PRESIZED_BUCKETS 4096 /* Bounded shards start this large at most, then grow */
+#define PATH_INDEX_MIN_BUCKETS 64
+#define SKETCH_ROWS 4
+#define SKETCH_MAX_COUNT 15           /* 4-bit counters, kept a byte each */
+#define SKETCH_MIN_WIDTH 64
+#define SKETCH_UNBOUNDED_WIDTH 4096   /* For shards without an entry limit */
+
 /**
- * Cache entry for LRU tracking
+ * Cache entry
+ *
+ * Entries of a shard form a circular list in insertion order that the
+ * CLOCK hand sweeps. Hits only set `referenced`, so LRU and FIFO lookups
+ * never relink anything and can share the shard lock. LFU and TinyLFU
+ * keep entries in rings of their own as well, which hits do reorder.
  */
 typedef struct CacheEntry {
-    void* key;                    /**< Entry key */
     void* value;                  /**< Cached value */
     size_t value_size;            /**< Size of value */
-    uint64_t last_access;         /**< Last access timestamp */
-    uint64_t access_count;        /**< Access count for LFU */
-    struct CacheEntry* prev;      /**< Previous in LRU list */
-    struct CacheEntry* next;      /**< Next in LRU list */
-    struct CacheEntry* hash_next; /**< Next in hash bucket */
+    size_t hash;                  /**< Cached key hash */
+    uint8_t referenced;           /**< CLOCK second-chance bit */
+    uint8_t segment;              /**< TinyLFU segment */
+    size_t slot;                  /**< Index in the RANDOM slot array */
+    struct FreqNode* freq_node;   /**< LFU frequency bucket */
+    struct CacheEntry* prev;      /**< Previous in clock ring */
+    struct CacheEntry* next;      /**< Next in clock ring */
+    struct CacheEntry* policy_prev; /**< Previous in the LFU bucket or TinyLFU segment ring */
+    struct CacheEntry* policy_next; /**< Next in the LFU bucket or TinyLFU segment ring */
+    uint64_t key[];               /**< Key copy, stored inline and padded to whole words */
 } CacheEntry;
 
 /**
- * General cache implementation
+ * Open-addressing hash table bucket
+ *
+ * The hash is kept beside the entry pointer so that probing past other
+ * keys rarely has to touch their entries.
  */
-struct SylvesCache {
-    CacheEntry** buckets;         /**< Hash table buckets */
-    size_t bucket_count;          /**< Number of buckets */
-    CacheEntry* lru_head;         /**< Most recently used */
-    CacheEntry* lru_tail;         /**< Least recently used */
+typedef struct CacheBucket {
+    size_t hash;
+    CacheEntry* entry;            /**< NULL for an empty bucket */
+} CacheBucket;
+
+/* Key layouts whose hash and comparison are compiled in, sparing lookups two indirect calls */
+typedef enum CacheKeyKind {
+    CACHE_KEY_CUSTOM,             /**< The caller's hash_func and compare_func */
+    CACHE_KEY_BYTES,              /**< Default byte hash and memcmp */
+    CACHE_KEY_CELL,               /**< SylvesCell */
+    CACHE_KEY_PATH,               /**< PathCacheKey */
+    CACHE_KEY_U64                 /**< uint64_t mesh id */
+} CacheKeyKind;
+
+/**
+ * LFU frequency bucket
+ *
+ * Buckets form a list in ascending frequency, each holding a ring of the
+ * entries hit exactly that often, oldest first. A hit moves an entry to
+ * the next bucket, so lookups and evictions are O(1).
+ */
+typedef struct FreqNode {
+    uint64_t freq;
+    CacheEntry* entries;          /**< Ring, oldest first */
+    struct FreqNode* prev;
+    struct FreqNode* next;
+} FreqNode;
+
+/**
+ * Count-min sketch of recent key popularity, for TinyLFU admission
+ *
+ * Each key maps to one saturating counter per row and is estimated by
+ * the smallest. After sample_size increments every counter is halved, so
+ * keys that were popular long ago fade out.
+ */
+typedef struct FrequencySketch {
+    uint8_t* counters;            /**< SKETCH_ROWS rows of width counters */
+    size_t width;                 /**< Power of two */
+    size_t additions;
+    size_t sample_size;
+} FrequencySketch;
+
+/* TinyLFU segments */
+enum {
+    SEGMENT_WINDOW,               /**< Recent arrivals, plain LRU */
+    SEGMENT_PROBATION,            /**< Admitted to the main area, not yet hit there */
+    SEGMENT_PROTECTED             /**< Hit again since admission */
+};
+
+/**
+ * Independently locked slice of the cache; keys are assigned by hash
+ */
+typedef struct CacheShard {
+    CacheBucket* buckets;         /**< Linear-probing table, at most 3/4 full */
+    size_t bucket_mask;           /**< Bucket count - 1; the count is a power of two */
+    CacheEntry* hand;             /**< Clock hand; the oldest entry for FIFO */
     size_t entry_count;           /**< Current entries */
     size_t memory_used;           /**< Current memory usage */
+    size_t max_entries;           /**< Share of config.max_entries */
+    size_t max_memory;            /**< Share of config.max_memory */
+    size_t hit_count;
+    size_t miss_count;
+    size_t eviction_count;
+    uint64_t access_time_us;      /**< Summed lookup time, for the average */
+    SylvesRwLock lock;
+    
+    /* LFU */
+    FreqNode* freq_head;          /**< Lowest frequency bucket */
+    FreqNode* spare_node;         /**< An emptied bucket, kept for reuse */
+    
+    /* RANDOM */
+    CacheEntry** slots;           /**< Dense array of the shard's entries */
+    size_t slot_capacity;
+    uint64_t rng;                 /**< xorshift64 state */
+    
+    /* TinyLFU */
+    CacheEntry* window;           /**< LRU ring of the admission window */
+    CacheEntry* probation;        /**< LRU ring of the main area's probation segment */
+    CacheEntry* protected_ring;   /**< LRU ring of the main area's protected segment */
+    CacheEntry* candidate;        /**< Entry just pushed out of the window, pending admission */
+    size_t window_count;
+    size_t protected_count;
+    size_t window_max;
+    size_t protected_max;
+    FrequencySketch sketch;
+} CacheShard;
+
+/**
+ * General cache implementation
+ */
+struct SylvesCache {
+    CacheShard* shards;           /**< Power-of-two shard array */
+    size_t shard_count;
     SylvesCacheConfig config;     /**< Cache configuration */
     size_t key_size;              /**< Size of keys */
+    CacheKeyKind key_kind;
     SylvesCacheHashFunc hash_func;
     SylvesCacheCompareFunc compare_func;
     SylvesCacheDestroyFunc destroy_func;
     SylvesCacheSizeFunc size_func;
-    SylvesCacheStats stats;       /**< Cache statistics */
-#ifdef _WIN32
-    CRITICAL_SECTION lock;
-#else
-    pthread_mutex_t lock;
-#endif
 };
 
 /**
@@ -90,11 +194,55 @@ typedef struct PathCacheKey {
     SylvesCell goal;
 } PathCacheKey;
 
+/**
+ * Link between a cell and a cached path through it
+ *
+ * Links of one cell form a list headed in the path cache's reverse index.
+ */
+typedef struct PathLink {
+    struct PathRecord* record;
+    SylvesCell cell;
+    struct PathLink* prev;
+    struct PathLink* next;
+} PathLink;
+
+/**
+ * Cached path with its links into the reverse index
+ *
+ * Records are the values of the underlying cache, so its destroy hook
+ * unlinks a record however the entry goes: eviction, replacement, removal
+ * or invalidation.
+ */
+typedef struct PathRecord {
+    SylvesCellPath* path;
+    struct SylvesPathCache* owner;
+    PathCacheKey key;
+    uint64_t id;                  /**< Tells apart records that reuse an address */
+    size_t link_count;
+    PathLink links[];             /**< Start cell, then each step's destination */
+} PathRecord;
+
+/**
+ * Reverse index bucket: a cell and the paths through it
+ */
+typedef struct PathIndexBucket {
+    SylvesCell cell;
+    PathLink* head;               /**< NULL for an empty bucket */
+} PathIndexBucket;
+
 /**
  * Path cache implementation
  */
 struct SylvesPathCache {
-    SylvesCache* cache;           /**< Underlying cache */
+    SylvesCache* cache;           /**< Underlying cache of PathRecords */
+    PathIndexBucket* index;       /**< Linear-probing reverse index, at most 3/4 full */
+    size_t index_mask;
+    size_t index_count;           /**< Distinct cells indexed */
+    uint64_t next_id;
+    size_t invalidated_count;
+    size_t kept_count;
+    bool thread_safe;
+    SylvesMutex index_lock;       /**< Guards the index, ids and counters */
 };
 
 /**
@@ -104,45 +252,40 @@ struct SylvesMeshCache {
     SylvesCache* cache;           /**< Underlying cache */
 };
 
+
 /* Helper functions */
 
-static void init_lock(SylvesCache* cache) {
+static void lock_shard(const SylvesCache* cache, CacheShard* shard) {
     if (cache->config.thread_safe) {
-#ifdef _WIN32
-        InitializeCriticalSection(&cache->lock);
-#else
-        pthread_mutex_init(&cache->lock, NULL);
-#endif
+        sylves_rwlock_write(&shard->lock);
     }
 }
 
-static void destroy_lock(SylvesCache* cache) {
+static void unlock_shard(const SylvesCache* cache, CacheShard* shard) {
     if (cache->config.thread_safe) {
-#ifdef _WIN32
-        DeleteCriticalSection(&cache->lock);
-#else
-        pthread_mutex_destroy(&cache->lock);
-#endif
+        sylves_rwlock_write_unlock(&shard->lock);
     }
 }
 
-static void lock_cache(SylvesCache* cache) {
+/* Lookups never restructure a shard, so they only need it shared */
+static void lock_shard_shared(const SylvesCache* cache, CacheShard* shard) {
     if (cache->config.thread_safe) {
-#ifdef _WIN32
-        EnterCriticalSection(&cache->lock);
-#else
-        pthread_mutex_lock(&cache->lock);
-#endif
+        sylves_rwlock_read(&shard->lock);
     }
 }
 
-static void unlock_cache(SylvesCache* cache) {
+static void unlock_shard_shared(const SylvesCache* cache, CacheShard* shard) {
     if (cache->config.thread_safe) {
-#ifdef _WIN32
-        LeaveCriticalSection(&cache->lock);
-#else
-        pthread_mutex_unlock(&cache->lock);
-#endif
+        sylves_rwlock_read_unlock(&shard->lock);
+    }
+}
+
+/* Counters bumped under a shared lock must be atomic; single-threaded caches skip the bus lock */
+static void stat_add(const SylvesCache* cache, size_t* counter, size_t amount) {
+    if (cache->config.thread_safe) {
+        sylves_atomic_add_size(counter, amount);
+    } else {
+        *counter += amount;
     }
 }
 
@@ -161,152 +304,615 @@ static int default_compare(const void* key1, const void* key2, size_t key_size)
     return memcmp(key1, key2, key_size);
 }
 
-/* LRU list operations */
-static void lru_remove(SylvesCache* cache, CacheEntry* entry) {
-    if (entry->prev) {
-        entry->prev->next = entry->next;
+/* Hashes of the wrappers' key layouts */
+static size_t cell_hash(const SylvesCell* cell) {
+    return ((size_t)cell->x * 73856093u) ^ ((size_t)cell->y * 19349663u) ^ ((size_t)cell->z * 83492791u);
+}
+
+static size_t path_key_hash(const PathCacheKey* pk) {
+    size_t h1 = cell_hash(&pk->start);
+    size_t h2 = cell_hash(&pk->goal);
+    return h1 ^ (h2 << 1);
+}
+
+static size_t uint64_hash(uint64_t id) {
+    id = (~id) + (id << 21);
+    id = id ^ (id >> 24);
+    id = (id + (id << 3)) + (id << 8);
+    id = id ^ (id >> 14);
+    id = (id + (id << 2)) + (id << 4);
+    id = id ^ (id >> 28);
+    id = id + (id << 31);
+    return (size_t)id;
+}
+
+static size_t cache_hash(const SylvesCache* cache, const void* key) {
+    switch (cache->key_kind) {
+        case CACHE_KEY_CELL: return cell_hash((const SylvesCell*)key);
+        case CACHE_KEY_PATH: return path_key_hash((const PathCacheKey*)key);
+        case CACHE_KEY_U64: return uint64_hash(*(const uint64_t*)key);
+        case CACHE_KEY_BYTES: return default_hash(key, cache->key_size);
+        default: return cache->hash_func(key, cache->key_size);
+    }
+}
+
+static bool cache_keys_equal(const SylvesCache* cache, const void* stored, const void* key) {
+    switch (cache->key_kind) {
+        case CACHE_KEY_CELL:
+            return sylves_cell_equals(*(const SylvesCell*)stored, *(const SylvesCell*)key);
+        case CACHE_KEY_PATH: {
+            const PathCacheKey* pk1 = (const PathCacheKey*)stored;
+            const PathCacheKey* pk2 = (const PathCacheKey*)key;
+            return sylves_cell_equals(pk1->start, pk2->start) && sylves_cell_equals(pk1->goal, pk2->goal);
+        }
+        case CACHE_KEY_U64:
+            return *(const uint64_t*)stored == *(const uint64_t*)key;
+        case CACHE_KEY_BYTES:
+            return memcmp(stored, key, cache->key_size) == 0;
+        default:
+            return cache->compare_func(stored, key, cache->key_size) == 0;
+    }
+}
+
+/* Shards take the high bits of a multiplicative remix; buckets use the plain hash */
+static CacheShard* shard_for_hash(const SylvesCache* cache, size_t hash) {
+    if (cache->shard_count == 1) {
+        return &cache->shards[0];
+    }
+    uint64_t mixed = (uint64_t)hash * 0x9E3779B97F4A7C15ull;
+    return &cache->shards[(size_t)(mixed >> 40) & (cache->shard_count - 1)];
+}
+
+static size_t resolve_shard_count(const SylvesCacheConfig* config) {
+    if (!config->thread_safe) {
+        return 1;
+    }
+    
+    size_t requested = config->shard_count > 0 ? config->shard_count : CACHE_DEFAULT_SHARDS;
+    if (requested > CACHE_MAX_SHARDS) {
+        requested = CACHE_MAX_SHARDS;
+    }
+    
+    size_t shards = 1;
+    while (shards * 2 <= requested) {
+        shards *= 2;
+    }
+    while (shards > 1 && config->max_entries > 0 &&
+           config->max_entries / shards < CACHE_MIN_SHARD_ENTRIES) {
+        shards /= 2;
+    }
+    return shards;
+}
+
+/* Clock ring operations */
+static void ring_insert(CacheShard* shard, CacheEntry* entry) {
+    if (!shard->hand) {
+        entry->prev = entry;
+        entry->next = entry;
+        shard->hand = entry;
+        return;
+    }
+    
+    /* Just behind the hand, so new entries are swept last */
+    CacheEntry* tail = shard->hand->prev;
+    entry->prev = tail;
+    entry->next = shard->hand;
+    tail->next = entry;
+    shard->hand->prev = entry;
+}
+
+static void ring_remove(CacheShard* shard, CacheEntry* entry) {
+    if (entry->next == entry) {
+        shard->hand = NULL;
+        return;
+    }
+    
+    entry->prev->next = entry->next;
+    entry->next->prev = entry->prev;
+    if (shard->hand == entry) {
+        shard->hand = entry->next;
+    }
+}
+
+/* Policy rings: same layout as the clock ring, over the policy links */
+static void policy_ring_push(CacheEntry** head, CacheEntry* entry) {
+    if (!*head) {
+        entry->policy_prev = entry;
+        entry->policy_next = entry;
+        *head = entry;
+        return;
+    }
+    
+    /* The head is the oldest, so the newest goes just behind it */
+    CacheEntry* tail = (*head)->policy_prev;
+    entry->policy_prev = tail;
+    entry->policy_next = *head;
+    tail->policy_next = entry;
+    (*head)->policy_prev = entry;
+}
+
+static void policy_ring_remove(CacheEntry** head, CacheEntry* entry) {
+    if (entry->policy_next == entry) {
+        *head = NULL;
+        return;
+    }
+    
+    entry->policy_prev->policy_next = entry->policy_next;
+    entry->policy_next->policy_prev = entry->policy_prev;
+    if (*head == entry) {
+        *head = entry->policy_next;
+    }
+}
+
+/* LFU frequency buckets */
+static FreqNode* freq_node_acquire(CacheShard* shard, uint64_t freq) {
+    FreqNode* node = shard->spare_node;
+    if (node) {
+        shard->spare_node = NULL;
     } else {
-        cache->lru_head = entry->next;
+        node = (FreqNode*)sylves_alloc(sizeof(FreqNode));
+        if (!node) {
+            return NULL;
+        }
+    }
+    node->freq = freq;
+    node->entries = NULL;
+    node->prev = NULL;
+    node->next = NULL;
+    return node;
+}
+
+static void freq_node_release(CacheShard* shard, FreqNode* node) {
+    if (node->prev) {
+        node->prev->next = node->next;
+    } else {
+        shard->freq_head = node->next;
+    }
+    if (node->next) {
+        node->next->prev = node->prev;
     }
     
-    if (entry->next) {
-        entry->next->prev = entry->prev;
+    if (!shard->spare_node) {
+        shard->spare_node = node;
     } else {
-        cache->lru_tail = entry->prev;
+        sylves_free(node);
+    }
+}
+
+static bool lfu_insert(CacheShard* shard, CacheEntry* entry) {
+    FreqNode* node = shard->freq_head;
+    if (!node || node->freq != 1) {
+        node = freq_node_acquire(shard, 1);
+        if (!node) {
+            return false;
+        }
+        node->next = shard->freq_head;
+        if (shard->freq_head) {
+            shard->freq_head->prev = node;
+        }
+        shard->freq_head = node;
+    }
+    
+    entry->freq_node = node;
+    policy_ring_push(&node->entries, entry);
+    return true;
+}
+
+static void lfu_remove(CacheShard* shard, CacheEntry* entry) {
+    FreqNode* node = entry->freq_node;
+    policy_ring_remove(&node->entries, entry);
+    if (!node->entries) {
+        freq_node_release(shard, node);
     }
+    entry->freq_node = NULL;
 }
 
-static void lru_add_front(SylvesCache* cache, CacheEntry* entry) {
-    entry->prev = NULL;
-    entry->next = cache->lru_head;
+/* Move a hit entry to the next bucket; without memory for one it keeps its count */
+static void lfu_touch(CacheShard* shard, CacheEntry* entry) {
+    FreqNode* node = entry->freq_node;
+    FreqNode* next = node->next;
     
-    if (cache->lru_head) {
-        cache->lru_head->prev = entry;
+    if (!next || next->freq != node->freq + 1) {
+        if (node->entries == entry && entry->policy_next == entry) {
+            /* Sole entry: bump the bucket in place */
+            node->freq++;
+            return;
+        }
+        next = freq_node_acquire(shard, node->freq + 1);
+        if (!next) {
+            return;
+        }
+        next->prev = node;
+        next->next = node->next;
+        if (node->next) {
+            node->next->prev = next;
+        }
+        node->next = next;
     }
-    cache->lru_head = entry;
     
-    if (!cache->lru_tail) {
-        cache->lru_tail = entry;
+    policy_ring_remove(&node->entries, entry);
+    if (!node->entries) {
+        freq_node_release(shard, node);
     }
+    entry->freq_node = next;
+    policy_ring_push(&next->entries, entry);
 }
 
-static void lru_move_front(SylvesCache* cache, CacheEntry* entry) {
-    if (entry != cache->lru_head) {
-        lru_remove(cache, entry);
-        lru_add_front(cache, entry);
+/* RANDOM slot array: dense, so a victim is one index away */
+static bool random_insert(CacheShard* shard, CacheEntry* entry) {
+    if (shard->entry_count == shard->slot_capacity) {
+        size_t capacity = shard->slot_capacity > 0 ? shard->slot_capacity * 2 : 16;
+        CacheEntry** slots = (CacheEntry**)sylves_realloc(shard->slots, capacity * sizeof(CacheEntry*));
+        if (!slots) {
+            return false;
+        }
+        shard->slots = slots;
+        shard->slot_capacity = capacity;
     }
+    
+    entry->slot = shard->entry_count;
+    shard->slots[entry->slot] = entry;
+    return true;
 }
 
-/* Entry operations */
-static CacheEntry* find_entry(SylvesCache* cache, const void* key) {
-    size_t hash = cache->hash_func(key, cache->key_size);
-    size_t bucket_idx = hash % cache->bucket_count;
+/* Called before entry_count drops, so the last slot is entry_count - 1 */
+static void random_remove(CacheShard* shard, CacheEntry* entry) {
+    CacheEntry* last = shard->slots[shard->entry_count - 1];
+    shard->slots[entry->slot] = last;
+    last->slot = entry->slot;
+}
+
+static uint64_t xorshift64(uint64_t* state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+/* TinyLFU frequency sketch */
+static bool sketch_init(FrequencySketch* sketch, size_t max_entries) {
+    size_t width = SKETCH_MIN_WIDTH;
+    size_t wanted = max_entries > 0 ? max_entries : SKETCH_UNBOUNDED_WIDTH;
+    while (width < wanted) {
+        width *= 2;
+    }
     
-    CacheEntry* entry = cache->buckets[bucket_idx];
-    while (entry) {
-        if (cache->compare_func(entry->key, key, cache->key_size) == 0) {
-            return entry;
+    sketch->counters = (uint8_t*)sylves_calloc(SKETCH_ROWS * width, 1);
+    if (!sketch->counters) {
+        return false;
+    }
+    sketch->width = width;
+    sketch->additions = 0;
+    sketch->sample_size = width * 10;
+    return true;
+}
+
+static size_t sketch_index(const FrequencySketch* sketch, size_t hash, int row) {
+    static const uint64_t seeds[SKETCH_ROWS] = {
+        0x9E3779B97F4A7C15ull, 0xC2B2AE3D27D4EB4Full,
+        0x165667B19E3779F9ull, 0xD6E8FEB86659FD93ull
+    };
+    uint64_t mixed = ((uint64_t)hash + (uint64_t)row) * seeds[row];
+    mixed ^= mixed >> 32;
+    return (size_t)row * sketch->width + ((size_t)mixed & (sketch->width - 1));
+}
+
+static uint8_t sketch_estimate(const FrequencySketch* sketch, size_t hash) {
+    uint8_t estimate = SKETCH_MAX_COUNT;
+    for (int row = 0; row < SKETCH_ROWS; row++) {
+        uint8_t count = sketch->counters[sketch_index(sketch, hash, row)];
+        if (count < estimate) {
+            estimate = count;
+        }
+    }
+    return estimate;
+}
+
+static void sketch_increment(FrequencySketch* sketch, size_t hash) {
+    bool added = false;
+    for (int row = 0; row < SKETCH_ROWS; row++) {
+        uint8_t* counter = &sketch->counters[sketch_index(sketch, hash, row)];
+        if (*counter < SKETCH_MAX_COUNT) {
+            (*counter)++;
+            added = true;
         }
-        entry = entry->hash_next;
     }
     
-    return NULL;
+    if (added && ++sketch->additions >= sketch->sample_size) {
+        /* Age every key so the sketch follows shifts in popularity */
+        for (size_t i = 0; i < SKETCH_ROWS * sketch->width; i++) {
+            sketch->counters[i] >>= 1;
+        }
+        sketch->additions /= 2;
+    }
+}
+
+/* TinyLFU segments */
+static CacheEntry** tinylfu_segment(CacheShard* shard, uint8_t segment) {
+    switch (segment) {
+        case SEGMENT_PROBATION: return &shard->probation;
+        case SEGMENT_PROTECTED: return &shard->protected_ring;
+        default: return &shard->window;
+    }
+}
+
+static void tinylfu_unlink(CacheShard* shard, CacheEntry* entry) {
+    policy_ring_remove(tinylfu_segment(shard, entry->segment), entry);
+    if (entry->segment == SEGMENT_WINDOW) {
+        shard->window_count--;
+    } else if (entry->segment == SEGMENT_PROTECTED) {
+        shard->protected_count--;
+    }
+}
+
+static void tinylfu_link(CacheShard* shard, CacheEntry* entry, uint8_t segment) {
+    entry->segment = segment;
+    policy_ring_push(tinylfu_segment(shard, segment), entry);
+    if (segment == SEGMENT_WINDOW) {
+        shard->window_count++;
+    } else if (segment == SEGMENT_PROTECTED) {
+        shard->protected_count++;
+    }
 }
 
-static void remove_entry(SylvesCache* cache, CacheEntry* entry) {
-    /* Remove from hash table */
-    size_t hash = cache->hash_func(entry->key, cache->key_size);
-    size_t bucket_idx = hash % cache->bucket_count;
+static void tinylfu_touch(CacheShard* shard, CacheEntry* entry) {
+    sketch_increment(&shard->sketch, entry->hash);
     
-    CacheEntry** prev_next = &cache->buckets[bucket_idx];
-    CacheEntry* curr = cache->buckets[bucket_idx];
+    uint8_t segment = entry->segment;
+    tinylfu_unlink(shard, entry);
+    if (segment == SEGMENT_WINDOW) {
+        tinylfu_link(shard, entry, SEGMENT_WINDOW);
+        return;
+    }
     
-    while (curr) {
-        if (curr == entry) {
-            *prev_next = curr->hash_next;
+    /* A second hit in the main area protects the entry, demoting the oldest protected one */
+    tinylfu_link(shard, entry, SEGMENT_PROTECTED);
+    if (shard->protected_count > shard->protected_max) {
+        CacheEntry* demoted = shard->protected_ring;
+        tinylfu_unlink(shard, demoted);
+        tinylfu_link(shard, demoted, SEGMENT_PROBATION);
+    }
+}
+
+/* Push the window's oldest entry into probation, where it must win admission */
+static void tinylfu_make_room(CacheShard* shard) {
+    if (shard->window && shard->window_count >= shard->window_max) {
+        CacheEntry* candidate = shard->window;
+        tinylfu_unlink(shard, candidate);
+        tinylfu_link(shard, candidate, SEGMENT_PROBATION);
+        shard->candidate = candidate;
+    }
+}
+
+static CacheEntry* tinylfu_victim(CacheShard* shard) {
+    CacheEntry* victim = shard->probation;
+    CacheEntry* candidate = shard->candidate;
+    
+    if (victim && candidate && victim != candidate) {
+        /* The candidate only displaces the main area's victim if the sketch has seen it more */
+        if (sketch_estimate(&shard->sketch, candidate->hash) >
+            sketch_estimate(&shard->sketch, victim->hash)) {
+            return victim;
+        }
+        return candidate;
+    }
+    if (victim) {
+        return victim;
+    }
+    return shard->protected_ring ? shard->protected_ring : shard->window;
+}
+
+/* Link a new entry into the policy's structures; false if out of memory */
+static bool policy_insert(const SylvesCache* cache, CacheShard* shard, CacheEntry* entry) {
+    switch (cache->config.policy) {
+        case SYLVES_CACHE_POLICY_LFU:
+            return lfu_insert(shard, entry);
+        case SYLVES_CACHE_POLICY_RANDOM:
+            return random_insert(shard, entry);
+        case SYLVES_CACHE_POLICY_TINYLFU:
+            tinylfu_link(shard, entry, SEGMENT_WINDOW);
+            return true;
+        default:
+            return true;
+    }
+}
+
+static void policy_remove(const SylvesCache* cache, CacheShard* shard, CacheEntry* entry) {
+    switch (cache->config.policy) {
+        case SYLVES_CACHE_POLICY_LFU:
+            lfu_remove(shard, entry);
+            break;
+        case SYLVES_CACHE_POLICY_RANDOM:
+            random_remove(shard, entry);
+            break;
+        case SYLVES_CACHE_POLICY_TINYLFU:
+            tinylfu_unlink(shard, entry);
+            if (shard->candidate == entry) {
+                shard->candidate = NULL;
+            }
+            break;
+        default:
             break;
+    }
+}
+
+/* LFU and TinyLFU reorder entries on every hit, so their lookups need the shard exclusively */
+static bool lookups_restructure(const SylvesCache* cache) {
+    return cache->config.policy == SYLVES_CACHE_POLICY_LFU ||
+           cache->config.policy == SYLVES_CACHE_POLICY_TINYLFU;
+}
+
+/* Release the first `count` shards, which must be empty, and the cache itself */
+static void free_shards(SylvesCache* cache, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        CacheShard* shard = &cache->shards[i];
+        if (cache->config.thread_safe) {
+            sylves_rwlock_destroy(&shard->lock);
+        }
+        sylves_free(shard->buckets);
+        sylves_free(shard->spare_node);
+        sylves_free(shard->slots);
+        sylves_free(shard->sketch.counters);
+    }
+    sylves_free(cache->shards);
+    sylves_free(cache);
+}
+
+/* Hash table operations */
+
+/* Home bucket; a second remix keeps it independent of the bits that chose the shard */
+static size_t bucket_home(size_t hash, size_t mask) {
+    uint64_t x = (uint64_t)hash;
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBull;
+    x ^= x >> 31;
+    return (size_t)x & mask;
+}
+
+static CacheEntry* find_entry(const SylvesCache* cache, const CacheShard* shard,
+                              const void* key, size_t hash) {
+    size_t mask = shard->bucket_mask;
+    for (size_t i = bucket_home(hash, mask); ; i = (i + 1) & mask) {
+        const CacheBucket* bucket = &shard->buckets[i];
+        if (!bucket->entry) {
+            return NULL;
+        }
+        if (bucket->hash == hash && cache_keys_equal(cache, bucket->entry->key, key)) {
+            return bucket->entry;
         }
-        prev_next = &curr->hash_next;
-        curr = curr->hash_next;
+    }
+}
+
+static void table_place(CacheBucket* buckets, size_t mask, CacheEntry* entry) {
+    size_t i = bucket_home(entry->hash, mask);
+    while (buckets[i].entry) {
+        i = (i + 1) & mask;
+    }
+    buckets[i].hash = entry->hash;
+    buckets[i].entry = entry;
+}
+
+/* Double the table once another entry would fill it past 3/4 */
+static bool table_reserve(CacheShard* shard) {
+    size_t count = shard->bucket_mask + 1;
+    if ((shard->entry_count + 1) * 4 <= count * 3) {
+        return true;
+    }
+    
+    size_t new_count = count * 2;
+    CacheBucket* buckets = (CacheBucket*)sylves_calloc(new_count, sizeof(CacheBucket));
+    if (!buckets) {
+        return false;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (shard->buckets[i].entry) {
+            table_place(buckets, new_count - 1, shard->buckets[i].entry);
+        }
+    }
+    sylves_free(shard->buckets);
+    shard->buckets = buckets;
+    shard->bucket_mask = new_count - 1;
+    return true;
+}
+
+/* Backward-shift deletion: later members of the probe run move up, so no tombstones build up */
+static void table_remove(CacheShard* shard, const CacheEntry* entry) {
+    size_t mask = shard->bucket_mask;
+    size_t hole = bucket_home(entry->hash, mask);
+    while (shard->buckets[hole].entry != entry) {
+        hole = (hole + 1) & mask;
     }
     
-    /* Remove from LRU list */
-    lru_remove(cache, entry);
+    for (size_t i = (hole + 1) & mask; shard->buckets[i].entry; i = (i + 1) & mask) {
+        size_t home = bucket_home(shard->buckets[i].hash, mask);
+        /* Movable unless its home lies cyclically between the hole and it */
+        if (((i - home) & mask) >= ((i - hole) & mask)) {
+            shard->buckets[hole] = shard->buckets[i];
+            hole = i;
+        }
+    }
+    shard->buckets[hole].entry = NULL;
+}
+
+/* Entry operations */
+static void remove_entry(SylvesCache* cache, CacheShard* shard, CacheEntry* entry) {
+    table_remove(shard, entry);
+    ring_remove(shard, entry);
+    policy_remove(cache, shard, entry);
     
-    /* Update stats */
-    cache->entry_count--;
-    cache->memory_used -= entry->value_size;
+    shard->entry_count--;
+    shard->memory_used -= entry->value_size;
     
     /* Destroy value */
     if (cache->destroy_func) {
         cache->destroy_func(entry->value);
     }
     
-    /* Free entry */
-    sylves_free(entry->key);
     sylves_free(entry);
 }
 
-static CacheEntry* evict_entry(SylvesCache* cache) {
-    CacheEntry* victim = NULL;
+static CacheEntry* select_victim(const SylvesCache* cache, CacheShard* shard) {
+    if (!shard->hand) {
+        return NULL;
+    }
     
     switch (cache->config.policy) {
         case SYLVES_CACHE_POLICY_LRU:
-            victim = cache->lru_tail;
-            break;
-            
-        case SYLVES_CACHE_POLICY_LFU: {
-            /* Find least frequently used */
-            uint64_t min_count = UINT64_MAX;
-            for (CacheEntry* entry = cache->lru_head; entry; entry = entry->next) {
-                if (entry->access_count < min_count) {
-                    min_count = entry->access_count;
-                    victim = entry;
-                }
+            /* CLOCK: give referenced entries a second chance; ends within one lap */
+            while (shard->hand->referenced) {
+                shard->hand->referenced = 0;
+                shard->hand = shard->hand->next;
             }
-            break;
-        }
+            return shard->hand;
+            
+        case SYLVES_CACHE_POLICY_LFU:
+            /* Oldest entry of the lowest frequency */
+            return shard->freq_head->entries;
         
         case SYLVES_CACHE_POLICY_FIFO:
-            /* Same as LRU but without moving on access */
-            victim = cache->lru_tail;
-            break;
+            /* The hand never sweeps, so it stays on the oldest entry */
+            return shard->hand;
             
-        case SYLVES_CACHE_POLICY_RANDOM: {
-            /* Pick random entry */
-            size_t idx = rand() % cache->entry_count;
-            victim = cache->lru_head;
-            for (size_t i = 0; i < idx && victim; i++) {
-                victim = victim->next;
-            }
-            break;
-        }
+        case SYLVES_CACHE_POLICY_RANDOM:
+            return shard->slots[xorshift64(&shard->rng) % shard->entry_count];
+            
+        case SYLVES_CACHE_POLICY_TINYLFU:
+            return tinylfu_victim(shard);
     }
     
+    return NULL;
+}
+
+static CacheEntry* evict_entry(SylvesCache* cache, CacheShard* shard) {
+    CacheEntry* victim = select_victim(cache, shard);
     if (victim) {
         if (cache->config.track_stats) {
-            cache->stats.eviction_count++;
+            shard->eviction_count++;
         }
-        remove_entry(cache, victim);
+        remove_entry(cache, shard, victim);
     }
     
     return victim;
 }
 
-/* Public API implementation */
+static bool shard_over_budget(const CacheShard* shard, size_t incoming_size) {
+    return (shard->max_entries > 0 && shard->entry_count >= shard->max_entries) ||
+           (shard->max_memory > 0 && shard->memory_used + incoming_size > shard->max_memory);
+}
 
-SylvesCache* sylves_cache_create(
+static SylvesCache* cache_create_keyed(
     const SylvesCacheConfig* config,
     size_t key_size,
+    CacheKeyKind key_kind,
     SylvesCacheHashFunc hash_func,
     SylvesCacheCompareFunc compare_func,
     SylvesCacheDestroyFunc destroy_func,
     SylvesCacheSizeFunc size_func
 ) {
-    if (!config || key_size == 0) {
-        return NULL;
-    }
-    
     SylvesCache* cache = (SylvesCache*)sylves_alloc(sizeof(SylvesCache));
     if (!cache) {
         return NULL;
@@ -315,25 +921,84 @@ SylvesCache* sylves_cache_create(
     memset(cache, 0, sizeof(SylvesCache));
     cache->config = *config;
     cache->key_size = key_size;
+    cache->key_kind = key_kind;
     cache->hash_func = hash_func ? hash_func : default_hash;
     cache->compare_func = compare_func ? compare_func : default_compare;
     cache->destroy_func = destroy_func;
     cache->size_func = size_func;
+    cache->shard_count = resolve_shard_count(config);
+    cache->config.shard_count = cache->shard_count;
     
-    /* Initialize hash table */
-    cache->bucket_count = 1024; /* Default size */
-    cache->buckets = (CacheEntry**)sylves_alloc(sizeof(CacheEntry*) * cache->bucket_count);
-    if (!cache->buckets) {
+    cache->shards = (CacheShard*)sylves_calloc(cache->shard_count, sizeof(CacheShard));
+    if (!cache->shards) {
         sylves_free(cache);
         return NULL;
     }
-    memset(cache->buckets, 0, sizeof(CacheEntry*) * cache->bucket_count);
     
-    init_lock(cache);
+    size_t n = cache->shard_count;
+    for (size_t i = 0; i < n; i++) {
+        CacheShard* shard = &cache->shards[i];
+        /* Limits are split evenly; the total may overshoot by less than one entry per shard */
+        shard->max_entries = (config->max_entries + n - 1) / n;
+        shard->max_memory = (config->max_memory + n - 1) / n;
+        
+        /* Bounded shards start big enough to stay under 3/4 full; the rest grow on demand */
+        size_t buckets = CACHE_MIN_SHARD_BUCKETS;
+        while (buckets < CACHE_MAX_PRESIZED_BUCKETS && buckets * 3 < shard->max_entries * 4) {
+            buckets *= 2;
+        }
+        shard->buckets = (CacheBucket*)sylves_calloc(buckets, sizeof(CacheBucket));
+        if (!shard->buckets) {
+            free_shards(cache, i);
+            return NULL;
+        }
+        shard->bucket_mask = buckets - 1;
+        shard->rng = 0x2545F4914F6CDD1Dull ^ ((uint64_t)(i + 1) * 0x9E3779B97F4A7C15ull);
+        
+        if (config->policy == SYLVES_CACHE_POLICY_TINYLFU) {
+            /* 1% admission window, the rest split 20/80 between probation and protected */
+            shard->window_max = shard->max_entries / 100 > 0 ? shard->max_entries / 100 : 1;
+            size_t main_size = shard->max_entries > shard->window_max ?
+                               shard->max_entries - shard->window_max : 1;
+            shard->protected_max = main_size * 4 / 5 > 0 ? main_size * 4 / 5 : 1;
+            if (shard->max_entries == 0) {
+                /* Only a memory bound: nothing to size segments by, so the window never fills */
+                shard->window_max = SIZE_MAX;
+                shard->protected_max = SIZE_MAX;
+            }
+            if (!sketch_init(&shard->sketch, shard->max_entries)) {
+                sylves_free(shard->buckets);
+                free_shards(cache, i);
+                return NULL;
+            }
+        }
+        
+        if (cache->config.thread_safe) {
+            sylves_rwlock_init(&shard->lock);
+        }
+    }
     
     return cache;
 }
 
+/* Public API implementation */
+
+SylvesCache* sylves_cache_create(
+    const SylvesCacheConfig* config,
+    size_t key_size,
+    SylvesCacheHashFunc hash_func,
+    SylvesCacheCompareFunc compare_func,
+    SylvesCacheDestroyFunc destroy_func,
+    SylvesCacheSizeFunc size_func
+) {
+    if (!config || key_size == 0) {
+        return NULL;
+    }
+    
+    CacheKeyKind key_kind = hash_func || compare_func ? CACHE_KEY_CUSTOM : CACHE_KEY_BYTES;
+    return cache_create_keyed(config, key_size, key_kind, hash_func, compare_func, destroy_func, size_func);
+}
+
 void sylves_cache_destroy(SylvesCache* cache) {
     if (!cache) {
         return;
@@ -342,9 +1007,7 @@ void sylves_cache_destroy(SylvesCache* cache) {
     /* Clear all entries */
     sylves_cache_clear(cache);
     
-    destroy_lock(cache);
-    sylves_free(cache->buckets);
-    sylves_free(cache);
+    free_shards(cache, cache->shard_count);
 }
 
 void* sylves_cache_get(SylvesCache* cache, const void* key) {
@@ -357,38 +1020,57 @@ void* sylves_cache_get(SylvesCache* cache, const void* key) {
         start_time = GET_TIME_US();
     }
     
-    lock_cache(cache);
+    size_t hash = cache_hash(cache, key);
+    CacheShard* shard = shard_for_hash(cache, hash);
     
-    CacheEntry* entry = find_entry(cache, key);
+    bool exclusive = lookups_restructure(cache);
+    if (exclusive) {
+        lock_shard(cache, shard);
+    } else {
+        lock_shard_shared(cache, shard);
+    }
+    
+    CacheEntry* entry = find_entry(cache, shard, key, hash);
     void* value = NULL;
     
+    if (cache->config.policy == SYLVES_CACHE_POLICY_TINYLFU && !entry) {
+        /* Misses count too: a key asked for often deserves admission when it is put */
+        sketch_increment(&shard->sketch, hash);
+    }
+    
     if (entry) {
         /* Cache hit */
         value = entry->value;
-        entry->last_access = GET_TIME_US();
-        entry->access_count++;
         
-        if (cache->config.policy == SYLVES_CACHE_POLICY_LRU) {
-            lru_move_front(cache, entry);
+        if (cache->config.policy == SYLVES_CACHE_POLICY_LFU) {
+            lfu_touch(shard, entry);
+        } else if (cache->config.policy == SYLVES_CACHE_POLICY_TINYLFU) {
+            tinylfu_touch(shard, entry);
+        } else if (!sylves_atomic_load_u8(&entry->referenced)) {
+            /* Test first so hot entries don't bounce their cache line between readers */
+            sylves_atomic_store_u8(&entry->referenced, 1);
         }
         
         if (cache->config.track_stats) {
-            cache->stats.hit_count++;
-        }
-    } else {
-        /* Cache miss */
-        if (cache->config.track_stats) {
-            cache->stats.miss_count++;
+            stat_add(cache, &shard->hit_count, 1);
         }
+    } else if (cache->config.track_stats) {
+        stat_add(cache, &shard->miss_count, 1);
     }
     
-    unlock_cache(cache);
+    if (exclusive) {
+        unlock_shard(cache, shard);
+    } else {
+        unlock_shard_shared(cache, shard);
+    }
     
     if (cache->config.track_stats) {
         uint64_t elapsed = GET_TIME_US() - start_time;
-        cache->stats.average_access_time_us = 
-            (cache->stats.average_access_time_us * (cache->stats.hit_count + cache->stats.miss_count - 1) + elapsed) /
-            (cache->stats.hit_count + cache->stats.miss_count);
+        if (cache->config.thread_safe) {
+            sylves_atomic_add_u64(&shard->access_time_us, elapsed);
+        } else {
+            shard->access_time_us += elapsed;
+        }
     }
     
     return value;
@@ -399,77 +1081,78 @@ SylvesError sylves_cache_put(SylvesCache* cache, const void* key, void* value) {
         return SYLVES_ERROR_INVALID_ARGUMENT;
     }
     
-    lock_cache(cache);
+    size_t hash = cache_hash(cache, key);
+    CacheShard* shard = shard_for_hash(cache, hash);
+    
+    lock_shard(cache, shard);
     
     /* Check if key exists */
-    CacheEntry* entry = find_entry(cache, key);
+    CacheEntry* entry = find_entry(cache, shard, key, hash);
     if (entry) {
         /* Update existing entry */
         if (cache->destroy_func) {
             cache->destroy_func(entry->value);
         }
         
-        cache->memory_used -= entry->value_size;
+        shard->memory_used -= entry->value_size;
         entry->value = value;
         entry->value_size = cache->size_func ? cache->size_func(value) : 0;
-        cache->memory_used += entry->value_size;
+        shard->memory_used += entry->value_size;
         
-        entry->last_access = GET_TIME_US();
-        entry->access_count++;
-        
-        if (cache->config.policy == SYLVES_CACHE_POLICY_LRU) {
-            lru_move_front(cache, entry);
+        entry->referenced = 1;
+        if (cache->config.policy == SYLVES_CACHE_POLICY_LFU) {
+            lfu_touch(shard, entry);
+        } else if (cache->config.policy == SYLVES_CACHE_POLICY_TINYLFU) {
+            tinylfu_touch(shard, entry);
         }
     } else {
         /* Create new entry */
         size_t value_size = cache->size_func ? cache->size_func(value) : 0;
+        if (cache->config.max_memory > 0 && value_size > cache->config.max_memory) {
+            unlock_shard(cache, shard);
+            return SYLVES_ERROR_OUT_OF_MEMORY;
+        }
         
-        /* Check limits and evict if necessary */
-        while ((cache->config.max_entries > 0 && cache->entry_count >= cache->config.max_entries) ||
-               (cache->config.max_memory > 0 && cache->memory_used + value_size > cache->config.max_memory)) {
-            if (!evict_entry(cache)) {
-                unlock_cache(cache);
-                return SYLVES_ERROR_OUT_OF_MEMORY;
-            }
+        if (cache->config.policy == SYLVES_CACHE_POLICY_TINYLFU) {
+            tinylfu_make_room(shard);
         }
         
-        /* Allocate new entry */
-        entry = (CacheEntry*)sylves_alloc(sizeof(CacheEntry));
-        if (!entry) {
-            unlock_cache(cache);
-            return SYLVES_ERROR_OUT_OF_MEMORY;
+        /* Evict within this shard; an oversized value may empty it and still be admitted */
+        while (shard->entry_count > 0 && shard_over_budget(shard, value_size)) {
+            evict_entry(cache, shard);
         }
+        shard->candidate = NULL;
         
-        entry->key = sylves_alloc(cache->key_size);
-        if (!entry->key) {
-            sylves_free(entry);
-            unlock_cache(cache);
+        /* Allocate new entry, with the key in the same block */
+        size_t key_words = (cache->key_size + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+        entry = table_reserve(shard) ?
+                (CacheEntry*)sylves_alloc(sizeof(CacheEntry) + key_words * sizeof(uint64_t)) : NULL;
+        if (!entry) {
+            unlock_shard(cache, shard);
             return SYLVES_ERROR_OUT_OF_MEMORY;
         }
         
         memcpy(entry->key, key, cache->key_size);
         entry->value = value;
         entry->value_size = value_size;
-        entry->last_access = GET_TIME_US();
-        entry->access_count = 1;
+        entry->hash = hash;
+        entry->referenced = 0;
         
-        /* Add to hash table */
-        size_t hash = cache->hash_func(key, cache->key_size);
-        size_t bucket_idx = hash % cache->bucket_count;
-        entry->hash_next = cache->buckets[bucket_idx];
-        cache->buckets[bucket_idx] = entry;
+        if (!policy_insert(cache, shard, entry)) {
+            sylves_free(entry);
+            unlock_shard(cache, shard);
+            return SYLVES_ERROR_OUT_OF_MEMORY;
+        }
         
-        /* Add to LRU list */
-        lru_add_front(cache, entry);
+        table_place(shard->buckets, shard->bucket_mask, entry);
         
-        /* Update stats */
-        cache->entry_count++;
-        cache->memory_used += value_size;
-        cache->stats.total_entries = cache->entry_count;
-        cache->stats.memory_used = cache->memory_used;
+        ring_insert(shard, entry);
+        
+        shard->entry_count++;
+        shard->memory_used += value_size;
     }
     
-    unlock_cache(cache);
+    unlock_shard(cache, shard);
     
     return SYLVES_SUCCESS;
 }
@@ -479,34 +1162,81 @@ SylvesError sylves_cache_remove(SylvesCache* cache, const void* key) {
         return SYLVES_ERROR_INVALID_ARGUMENT;
     }
     
-    lock_cache(cache);
+    size_t hash = cache_hash(cache, key);
+    CacheShard* shard = shard_for_hash(cache, hash);
+    
+    lock_shard(cache, shard);
     
-    CacheEntry* entry = find_entry(cache, key);
+    CacheEntry* entry = find_entry(cache, shard, key, hash);
     if (!entry) {
-        unlock_cache(cache);
-return SYLVES_ERROR_CELL_NOT_FOUND;
+        unlock_shard(cache, shard);
+        return SYLVES_ERROR_CELL_NOT_FOUND;
     }
     
-    remove_entry(cache, entry);
+    remove_entry(cache, shard, entry);
     
-    unlock_cache(cache);
+    unlock_shard(cache, shard);
     
     return SYLVES_SUCCESS;
 }
 
+/* Remove the entry for key only if `matches` accepts its value, tested under the shard lock */
+static bool cache_remove_matching(SylvesCache* cache, const void* key,
+                                  bool (*matches)(const void* value, const void* user_data),
+                                  const void* user_data) {
+    size_t hash = cache_hash(cache, key);
+    CacheShard* shard = shard_for_hash(cache, hash);
+    
+    lock_shard(cache, shard);
+    CacheEntry* entry = find_entry(cache, shard, key, hash);
+    bool removed = entry && matches(entry->value, user_data);
+    if (removed) {
+        remove_entry(cache, shard, entry);
+    }
+    unlock_shard(cache, shard);
+    
+    return removed;
+}
+
+size_t sylves_cache_remove_if(SylvesCache* cache, SylvesCacheEntryPredicate predicate, void* user_data) {
+    if (!cache || !predicate) {
+        return 0;
+    }
+    
+    size_t removed = 0;
+    for (size_t i = 0; i < cache->shard_count; i++) {
+        CacheShard* shard = &cache->shards[i];
+        lock_shard(cache, shard);
+        /* Walk the ring once; removing an entry only unlinks it from its neighbours */
+        size_t remaining = shard->entry_count;
+        CacheEntry* entry = shard->hand;
+        while (remaining-- > 0) {
+            CacheEntry* next = entry->next;
+            if (predicate(entry->key, entry->value, user_data)) {
+                remove_entry(cache, shard, entry);
+                removed++;
+            }
+            entry = next;
+        }
+        unlock_shard(cache, shard);
+    }
+    
+    return removed;
+}
+
 void sylves_cache_clear(SylvesCache* cache) {
     if (!cache) {
         return;
     }
     
-    lock_cache(cache);
-    
-    /* Remove all entries */
-    while (cache->lru_head) {
-        remove_entry(cache, cache->lru_head);
+    for (size_t i = 0; i < cache->shard_count; i++) {
+        CacheShard* shard = &cache->shards[i];
+        lock_shard(cache, shard);
+        while (shard->hand) {
+            remove_entry(cache, shard, shard->hand);
+        }
+        unlock_shard(cache, shard);
     }
-    
-    unlock_cache(cache);
 }
 
 void sylves_cache_get_stats(const SylvesCache* cache, SylvesCacheStats* stats) {
@@ -514,13 +1244,25 @@ void sylves_cache_get_stats(const SylvesCache* cache, SylvesCacheStats* stats) {
         return;
     }
     
-    *stats = cache->stats;
-    stats->total_entries = cache->entry_count;
-    stats->memory_used = cache->memory_used;
+    memset(stats, 0, sizeof(SylvesCacheStats));
+    uint64_t access_time_us = 0;
+    
+    for (size_t i = 0; i < cache->shard_count; i++) {
+        CacheShard* shard = &cache->shards[i];
+        lock_shard_shared(cache, shard);
+        stats->total_entries += shard->entry_count;
+        stats->memory_used += shard->memory_used;
+        stats->hit_count += shard->hit_count;
+        stats->miss_count += shard->miss_count;
+        stats->eviction_count += shard->eviction_count;
+        access_time_us += shard->access_time_us;
+        unlock_shard_shared(cache, shard);
+    }
     
-    if (cache->stats.hit_count + cache->stats.miss_count > 0) {
-        stats->hit_rate = (double)cache->stats.hit_count / 
-                         (cache->stats.hit_count + cache->stats.miss_count) * 100.0;
+    size_t lookups = stats->hit_count + stats->miss_count;
+    if (lookups > 0) {
+        stats->hit_rate = (double)stats->hit_count / lookups * 100.0;
+        stats->average_access_time_us = (double)access_time_us / lookups;
     }
 }
 
@@ -529,25 +1271,19 @@ void sylves_cache_reset_stats(SylvesCache* cache) {
         return;
     }
     
-    lock_cache(cache);
-    memset(&cache->stats, 0, sizeof(SylvesCacheStats));
-    unlock_cache(cache);
+    for (size_t i = 0; i < cache->shard_count; i++) {
+        CacheShard* shard = &cache->shards[i];
+        lock_shard(cache, shard);
+        shard->hit_count = 0;
+        shard->miss_count = 0;
+        shard->eviction_count = 0;
+        shard->access_time_us = 0;
+        unlock_shard(cache, shard);
+    }
 }
 
 /* Cell cache implementation */
 
-static size_t cell_hash(const void* key, size_t key_size) {
-    const SylvesCell* cell = (const SylvesCell*)key;
-    return (size_t)(cell->x * 73856093) ^ (size_t)(cell->y * 19349663) ^ (size_t)(cell->z * 83492791);
-}
-
-static int cell_compare(const void* key1, const void* key2, size_t key_size) {
-    (void)key_size;
-    const SylvesCell* c1 = (const SylvesCell*)key1;
-    const SylvesCell* c2 = (const SylvesCell*)key2;
-    return sylves_cell_equals(*c1, *c2) ? 0 : 1;
-}
-
 static void cached_mesh_destroy(void* value) {
     CachedMeshData* data = (CachedMeshData*)value;
     if (data) {
@@ -600,12 +1336,10 @@ SylvesCellCache* sylves_cell_cache_create(const SylvesGrid* grid, size_t max_ent
         .track_stats = true
     };
     
-    cache->mesh_cache = sylves_cache_create(&config, sizeof(SylvesCell), 
-                                           cell_hash, cell_compare,
+    cache->mesh_cache = cache_create_keyed(&config, sizeof(SylvesCell), CACHE_KEY_CELL, NULL, NULL,
                                            cached_mesh_destroy, cached_mesh_size);
     
-    cache->polygon_cache = sylves_cache_create(&config, sizeof(SylvesCell),
-                                              cell_hash, cell_compare,
+    cache->polygon_cache = cache_create_keyed(&config, sizeof(SylvesCell), CACHE_KEY_CELL, NULL, NULL,
                                               cached_polygon_destroy, cached_polygon_size);
     
     if (!cache->mesh_cache || !cache->polygon_cache) {
@@ -708,28 +1442,131 @@ SylvesError sylves_cell_cache_put_polygon(SylvesCellCache* cache, const SylvesCe
 
 /* Path cache implementation */
 
-static size_t path_key_hash(const void* key, size_t key_size) {
-    const PathCacheKey* pk = (const PathCacheKey*)key;
-    size_t h1 = cell_hash(&pk->start, sizeof(SylvesCell));
-    size_t h2 = cell_hash(&pk->goal, sizeof(SylvesCell));
-    return h1 ^ (h2 << 1);
+static void path_index_lock(SylvesPathCache* cache) {
+    if (cache->thread_safe) {
+        sylves_mutex_lock(&cache->index_lock);
+    }
 }
 
-static int path_key_compare(const void* key1, const void* key2, size_t key_size) {
-    const PathCacheKey* pk1 = (const PathCacheKey*)key1;
-    const PathCacheKey* pk2 = (const PathCacheKey*)key2;
-return (sylves_cell_equals(pk1->start, pk2->start) &&
-            sylves_cell_equals(pk1->goal, pk2->goal)) ? 0 : 1;
+static void path_index_unlock(SylvesPathCache* cache) {
+    if (cache->thread_safe) {
+        sylves_mutex_unlock(&cache->index_lock);
+    }
 }
 
-static void path_destroy(void* value) {
-    sylves_cell_path_destroy((SylvesCellPath*)value);
+static size_t path_index_find(const SylvesPathCache* cache, SylvesCell cell) {
+    size_t mask = cache->index_mask;
+    for (size_t i = bucket_home(cell_hash(&cell), mask); ; i = (i + 1) & mask) {
+        const PathIndexBucket* bucket = &cache->index[i];
+        if (!bucket->head) {
+            return SIZE_MAX;
+        }
+        if (sylves_cell_equals(bucket->cell, cell)) {
+            return i;
+        }
+    }
+}
+
+static void path_index_place(PathIndexBucket* index, size_t mask, SylvesCell cell, PathLink* head) {
+    size_t i = bucket_home(cell_hash(&cell), mask);
+    while (index[i].head) {
+        i = (i + 1) & mask;
+    }
+    index[i].cell = cell;
+    index[i].head = head;
+}
+
+static bool path_index_reserve(SylvesPathCache* cache) {
+    size_t count = cache->index_mask + 1;
+    if ((cache->index_count + 1) * 4 <= count * 3) {
+        return true;
+    }
+    
+    size_t new_count = count * 2;
+    PathIndexBucket* index = (PathIndexBucket*)sylves_calloc(new_count, sizeof(PathIndexBucket));
+    if (!index) {
+        return false;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (cache->index[i].head) {
+            path_index_place(index, new_count - 1, cache->index[i].cell, cache->index[i].head);
+        }
+    }
+    sylves_free(cache->index);
+    cache->index = index;
+    cache->index_mask = new_count - 1;
+    return true;
 }
 
-static size_t path_size(const void* value) {
-    const SylvesCellPath* path = (const SylvesCellPath*)value;
-    return sizeof(SylvesCellPath) + 
-           (path ? path->step_count * sizeof(SylvesStep) : 0);
+static bool path_index_link(SylvesPathCache* cache, PathLink* link) {
+    size_t i = path_index_find(cache, link->cell);
+    link->prev = NULL;
+    if (i == SIZE_MAX) {
+        if (!path_index_reserve(cache)) {
+            return false;
+        }
+        link->next = NULL;
+        path_index_place(cache->index, cache->index_mask, link->cell, link);
+        cache->index_count++;
+        return true;
+    }
+    
+    link->next = cache->index[i].head;
+    link->next->prev = link;
+    cache->index[i].head = link;
+    return true;
+}
+
+static void path_index_unlink(SylvesPathCache* cache, PathLink* link) {
+    if (link->next) {
+        link->next->prev = link->prev;
+    }
+    if (link->prev) {
+        link->prev->next = link->next;
+        return;
+    }
+    
+    size_t hole = path_index_find(cache, link->cell);
+    cache->index[hole].head = link->next;
+    if (link->next) {
+        return;
+    }
+    
+    /* Last path through the cell: drop its bucket by backward shift, as the entry table does */
+    size_t mask = cache->index_mask;
+    for (size_t i = (hole + 1) & mask; cache->index[i].head; i = (i + 1) & mask) {
+        size_t home = bucket_home(cell_hash(&cache->index[i].cell), mask);
+        if (((i - home) & mask) >= ((i - hole) & mask)) {
+            cache->index[hole] = cache->index[i];
+            hole = i;
+        }
+    }
+    cache->index[hole].head = NULL;
+    cache->index_count--;
+}
+
+static void path_record_unlink(SylvesPathCache* cache, PathRecord* record, size_t linked) {
+    for (size_t i = 0; i < linked; i++) {
+        path_index_unlink(cache, &record->links[i]);
+    }
+}
+
+static void path_record_destroy(void* value) {
+    PathRecord* record = (PathRecord*)value;
+    SylvesPathCache* cache = record->owner;
+    
+    path_index_lock(cache);
+    path_record_unlink(cache, record, record->link_count);
+    path_index_unlock(cache);
+    
+    sylves_cell_path_destroy(record->path);
+    sylves_free(record);
+}
+
+static size_t path_record_size(const void* value) {
+    const PathRecord* record = (const PathRecord*)value;
+    return sizeof(SylvesCellPath) + record->path->step_count * sizeof(SylvesStep) +
+           sizeof(PathRecord) + record->link_count * sizeof(PathLink);
 }
 
 SylvesPathCache* sylves_path_cache_create(size_t max_entries, bool thread_safe) {
@@ -738,6 +1575,15 @@ SylvesPathCache* sylves_path_cache_create(size_t max_entries, bool thread_safe)
         return NULL;
     }
     
+    memset(cache, 0, sizeof(SylvesPathCache));
+    cache->thread_safe = thread_safe;
+    cache->index = (PathIndexBucket*)sylves_calloc(PATH_INDEX_MIN_BUCKETS, sizeof(PathIndexBucket));
+    if (!cache->index) {
+        sylves_free(cache);
+        return NULL;
+    }
+    cache->index_mask = PATH_INDEX_MIN_BUCKETS - 1;
+    
     SylvesCacheConfig config = {
         .max_entries = max_entries,
         .max_memory = 0,
@@ -746,15 +1592,19 @@ SylvesPathCache* sylves_path_cache_create(size_t max_entries, bool thread_safe)
         .track_stats = true
     };
     
-    cache->cache = sylves_cache_create(&config, sizeof(PathCacheKey),
-                                      path_key_hash, path_key_compare,
-                                      path_destroy, path_size);
+    cache->cache = cache_create_keyed(&config, sizeof(PathCacheKey), CACHE_KEY_PATH, NULL, NULL,
+                                      path_record_destroy, path_record_size);
     
     if (!cache->cache) {
+        sylves_free(cache->index);
         sylves_free(cache);
         return NULL;
     }
     
+    if (thread_safe) {
+        sylves_mutex_init(&cache->index_lock);
+    }
+    
     return cache;
 }
 
@@ -763,7 +1613,12 @@ void sylves_path_cache_destroy(SylvesPathCache* cache) {
         return;
     }
     
+    /* Records unlink themselves as the cache destroys them */
     sylves_cache_destroy(cache->cache);
+    if (cache->thread_safe) {
+        sylves_mutex_destroy(&cache->index_lock);
+    }
+    sylves_free(cache->index);
     sylves_free(cache);
 }
 
@@ -773,7 +1628,8 @@ SylvesCellPath* sylves_path_cache_get(SylvesPathCache* cache, const SylvesCell*
     }
     
     PathCacheKey key = { *start, *goal };
-    return (SylvesCellPath*)sylves_cache_get(cache->cache, &key);
+    PathRecord* record = (PathRecord*)sylves_cache_get(cache->cache, &key);
+    return record ? record->path : NULL;
 }
 
 SylvesError sylves_path_cache_put(SylvesPathCache* cache, const SylvesCell* start,
@@ -782,40 +1638,168 @@ SylvesError sylves_path_cache_put(SylvesPathCache* cache, const SylvesCell* star
         return SYLVES_ERROR_INVALID_ARGUMENT;
     }
     
-    PathCacheKey key = { *start, *goal };
-    return sylves_cache_put(cache->cache, &key, path);
+    size_t link_count = path->step_count + 1;
+    PathRecord* record = (PathRecord*)sylves_alloc(sizeof(PathRecord) + link_count * sizeof(PathLink));
+    if (!record) {
+        return SYLVES_ERROR_OUT_OF_MEMORY;
+    }
+    
+    record->path = path;
+    record->owner = cache;
+    record->key = (PathCacheKey){ *start, *goal };
+    record->link_count = link_count;
+    for (size_t i = 0; i < link_count; i++) {
+        record->links[i].record = record;
+        record->links[i].cell = i == 0 ? *start : path->steps[i - 1].dest;
+    }
+    
+    /* Indexed before it is cached, so an entry is never reachable without its links */
+    path_index_lock(cache);
+    record->id = cache->next_id++;
+    size_t linked = 0;
+    while (linked < link_count && path_index_link(cache, &record->links[linked])) {
+        linked++;
+    }
+    if (linked < link_count) {
+        path_record_unlink(cache, record, linked);
+    }
+    path_index_unlock(cache);
+    
+    SylvesError err = linked < link_count ? SYLVES_ERROR_OUT_OF_MEMORY :
+                      sylves_cache_put(cache->cache, &record->key, record);
+    if (err != SYLVES_SUCCESS) {
+        /* The path stays the caller's */
+        if (linked == link_count) {
+            path_index_lock(cache);
+            path_record_unlink(cache, record, link_count);
+            path_index_unlock(cache);
+        }
+        sylves_free(record);
+    }
+    return err;
+}
+
+/* A path to drop, named by key and id since its record may go before we get to it */
+typedef struct PathTarget {
+    PathCacheKey key;
+    uint64_t id;
+} PathTarget;
+
+typedef struct PathTargets {
+    PathTarget* items;
+    size_t count;
+    size_t capacity;
+    bool failed;
+} PathTargets;
+
+static void path_targets_add_cell(PathTargets* targets, const PathIndexBucket* bucket) {
+    for (PathLink* link = bucket->head; link && !targets->failed; link = link->next) {
+        if (targets->count == targets->capacity) {
+            size_t capacity = targets->capacity > 0 ? targets->capacity * 2 : 16;
+            PathTarget* items = (PathTarget*)sylves_realloc(targets->items, capacity * sizeof(PathTarget));
+            if (!items) {
+                targets->failed = true;
+                return;
+            }
+            targets->items = items;
+            targets->capacity = capacity;
+        }
+        targets->items[targets->count++] = (PathTarget){ link->record->key, link->record->id };
+    }
+}
+
+static bool path_record_is(const void* value, const void* user_data) {
+    return ((const PathRecord*)value)->id == *(const uint64_t*)user_data;
+}
+
+/*
+ * Targets are collected under the index lock and removed after it is
+ * released, as removal re-enters the index through the destroy hook.
+ * A path collected twice, or replaced meanwhile, fails the id test.
+ */
+static size_t path_cache_drop_targets(SylvesPathCache* cache, PathTargets* targets) {
+    size_t removed = 0;
+    if (targets->failed) {
+        /* Without the full list, dropping everything is the only safe answer */
+        SylvesCacheStats stats;
+        sylves_cache_get_stats(cache->cache, &stats);
+        removed = stats.total_entries;
+        sylves_cache_clear(cache->cache);
+    } else {
+        for (size_t i = 0; i < targets->count; i++) {
+            removed += cache_remove_matching(cache->cache, &targets->items[i].key,
+                                             path_record_is, &targets->items[i].id);
+        }
+    }
+    sylves_free(targets->items);
+    
+    SylvesCacheStats stats;
+    sylves_cache_get_stats(cache->cache, &stats);
+    path_index_lock(cache);
+    cache->invalidated_count += removed;
+    cache->kept_count += stats.total_entries;
+    path_index_unlock(cache);
+    return removed;
 }
 
 void sylves_path_cache_invalidate_cell(SylvesPathCache* cache, const SylvesCell* cell) {
-    if (!cache || !cell) {
-        return;
+    sylves_path_cache_invalidate_cells(cache, cell, 1);
+}
+
+size_t sylves_path_cache_invalidate_cells(SylvesPathCache* cache, const SylvesCell* cells, size_t count) {
+    if (!cache || !cells) {
+        return 0;
     }
     
-    /* This would require iterating all entries to find paths containing the cell
-     * For now, we just clear the entire cache as a simple solution */
-    sylves_cache_clear(cache->cache);
+    PathTargets targets = { NULL, 0, 0, false };
+    path_index_lock(cache);
+    for (size_t i = 0; i < count && !targets.failed; i++) {
+        size_t bucket = path_index_find(cache, cells[i]);
+        if (bucket != SIZE_MAX) {
+            path_targets_add_cell(&targets, &cache->index[bucket]);
+        }
+    }
+    path_index_unlock(cache);
+    
+    return path_cache_drop_targets(cache, &targets);
 }
 
-/* Mesh cache implementation */
-
-static size_t uint64_hash(const void* key, size_t key_size) {
-    uint64_t id = *(const uint64_t*)key;
-    id = (~id) + (id << 21);
-    id = id ^ (id >> 24);
-    id = (id + (id << 3)) + (id << 8);
-    id = id ^ (id >> 14);
-    id = (id + (id << 2)) + (id << 4);
-    id = id ^ (id >> 28);
-    id = id + (id << 31);
-    return (size_t)id;
+size_t sylves_path_cache_invalidate_region(SylvesPathCache* cache,
+                                           bool (*in_region)(SylvesCell cell, void* user_data),
+                                           void* user_data) {
+    if (!cache || !in_region) {
+        return 0;
+    }
+    
+    /* Each distinct cell on a cached path is tested once */
+    PathTargets targets = { NULL, 0, 0, false };
+    path_index_lock(cache);
+    for (size_t i = 0; i <= cache->index_mask && !targets.failed; i++) {
+        if (cache->index[i].head && in_region(cache->index[i].cell, user_data)) {
+            path_targets_add_cell(&targets, &cache->index[i]);
+        }
+    }
+    path_index_unlock(cache);
+    
+    return path_cache_drop_targets(cache, &targets);
 }
 
-static int uint64_compare(const void* key1, const void* key2, size_t key_size) {
-    uint64_t id1 = *(const uint64_t*)key1;
-    uint64_t id2 = *(const uint64_t*)key2;
-    return (id1 == id2) ? 0 : 1;
+void sylves_path_cache_get_invalidation_stats(const SylvesPathCache* cache,
+                                              SylvesPathCacheInvalidationStats* stats) {
+    if (!cache || !stats) {
+        return;
+    }
+    
+    SylvesPathCache* mutable_cache = (SylvesPathCache*)cache;
+    path_index_lock(mutable_cache);
+    stats->invalidated = cache->invalidated_count;
+    stats->kept = cache->kept_count;
+    stats->indexed_cells = cache->index_count;
+    path_index_unlock(mutable_cache);
 }
 
+/* Mesh cache implementation */
+
 static void mesh_destroy(void* value) {
     sylves_mesh_data_destroy((SylvesMeshData*)value);
 }
@@ -845,8 +1829,7 @@ SylvesMeshCache* sylves_mesh_cache_create(size_t max_memory, bool thread_safe) {
         .track_stats = true
     };
     
-    cache->cache = sylves_cache_create(&config, sizeof(uint64_t),
-                                      uint64_hash, uint64_compare,
+    cache->cache = cache_create_keyed(&config, sizeof(uint64_t), CACHE_KEY_U64, NULL, NULL,
                                       mesh_destroy, mesh_size);
     
     if (!cache->cache) {
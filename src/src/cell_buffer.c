@@ -0,0 +1,110 @@
+/**
+ * @file cell_buffer.c
+ * @brief Struct-of-arrays cell storage
+ */
+
+#include "sylves/cell_buffer.h"
+#include "sylves/memory.h"
+#include <string.h>
+
+SylvesCellBuffer* sylves_cell_buffer_create(size_t capacity) {
+    SylvesCellBuffer* buffer = (SylvesCellBuffer*)sylves_calloc(1, sizeof(SylvesCellBuffer));
+    if (!buffer) {
+        return NULL;
+    }
+    if (capacity > 0 && sylves_cell_buffer_reserve(buffer, capacity) != SYLVES_SUCCESS) {
+        sylves_free(buffer);
+        return NULL;
+    }
+    return buffer;
+}
+
+void sylves_cell_buffer_destroy(SylvesCellBuffer* buffer) {
+    if (!buffer) {
+        return;
+    }
+    sylves_aligned_free(buffer->x);
+    sylves_aligned_free(buffer->y);
+    sylves_aligned_free(buffer->z);
+    sylves_free(buffer);
+}
+
+static int* grow_array(int* old, size_t count, size_t capacity) {
+    int* arr = (int*)sylves_aligned_alloc(capacity * sizeof(int), SYLVES_CELL_BUFFER_ALIGNMENT);
+    if (arr && old && count > 0) {
+        memcpy(arr, old, count * sizeof(int));
+    }
+    return arr;
+}
+
+SylvesError sylves_cell_buffer_reserve(SylvesCellBuffer* buffer, size_t capacity) {
+    if (!buffer) {
+        return SYLVES_ERROR_NULL_POINTER;
+    }
+    if (capacity <= buffer->capacity) {
+        return SYLVES_SUCCESS;
+    }
+    
+    int* x = grow_array(buffer->x, buffer->count, capacity);
+    int* y = grow_array(buffer->y, buffer->count, capacity);
+    int* z = grow_array(buffer->z, buffer->count, capacity);
+    if (!x || !y || !z) {
+        sylves_aligned_free(x);
+        sylves_aligned_free(y);
+        sylves_aligned_free(z);
+        return SYLVES_ERROR_OUT_OF_MEMORY;
+    }
+    
+    sylves_aligned_free(buffer->x);
+    sylves_aligned_free(buffer->y);
+    sylves_aligned_free(buffer->z);
+    buffer->x = x;
+    buffer->y = y;
+    buffer->z = z;
+    buffer->capacity = capacity;
+    return SYLVES_SUCCESS;
+}
+
+void sylves_cell_buffer_clear(SylvesCellBuffer* buffer) {
+    if (buffer) {
+        buffer->count = 0;
+    }
+}
+
+SylvesError sylves_cell_buffer_push(SylvesCellBuffer* buffer, SylvesCell cell) {
+    return sylves_cell_buffer_append(buffer, &cell, 1);
+}
+
+SylvesError sylves_cell_buffer_append(SylvesCellBuffer* buffer, const SylvesCell* cells,
+                                      size_t count) {
+    if (!buffer || (!cells && count > 0)) {
+        return SYLVES_ERROR_NULL_POINTER;
+    }
+    size_t needed = buffer->count + count;
+    if (needed > buffer->capacity) {
+        size_t new_capacity = buffer->capacity ? buffer->capacity * 2 : 64;
+        while (new_capacity < needed) {
+            new_capacity *= 2;
+        }
+        SylvesError err = sylves_cell_buffer_reserve(buffer, new_capacity);
+        if (err != SYLVES_SUCCESS) {
+            return err;
+        }
+    }
+    
+    int* x = buffer->x + buffer->count;
+    int* y = buffer->y + buffer->count;
+    int* z = buffer->z + buffer->count;
+    for (size_t i = 0; i < count; i++) {
+        x[i] = cells[i].x;
+        y[i] = cells[i].y;
+        z[i] = cells[i].z;
+    }
+    buffer->count = needed;
+    return SYLVES_SUCCESS;
+}
+
+SylvesCell sylves_cell_buffer_get(const SylvesCellBuffer* buffer, size_t index) {
+    SylvesCell cell = { buffer->x[index], buffer->y[index], buffer->z[index] };
+    return cell;
+}
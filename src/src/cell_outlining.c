@@ -41,14 +41,13 @@ static size_t cell_hash(SylvesCell cell) {
     return hash;
 }
 
-/* Cell set operations */
-static CellSet* cell_set_create(size_t initial_size) {
-    CellSet* set = (CellSet*)sylves_alloc(sizeof(CellSet));
+/* Cell set operations; buckets and entries live in the scratch arena */
+static CellSet* cell_set_create(SylvesArena* arena, size_t initial_size) {
+    CellSet* set = (CellSet*)sylves_arena_alloc(arena, sizeof(CellSet));
     if (!set) return NULL;
     
-    set->buckets = (CellSetEntry**)sylves_calloc(initial_size, sizeof(CellSetEntry*));
+    set->buckets = (CellSetEntry**)sylves_arena_calloc(arena, initial_size, sizeof(CellSetEntry*));
     if (!set->buckets) {
-        sylves_free(set);
         return NULL;
     }
     
@@ -58,22 +57,6 @@ static CellSet* cell_set_create(size_t initial_size) {
     return set;
 }
 
-static void cell_set_destroy(CellSet* set) {
-    if (!set) return;
-    
-    for (size_t i = 0; i < set->bucket_count; i++) {
-        CellSetEntry* entry = set->buckets[i];
-        while (entry) {
-            CellSetEntry* next = entry->next;
-            sylves_free(entry);
-            entry = next;
-        }
-    }
-    
-    sylves_free(set->buckets);
-    sylves_free(set);
-}
-
 static bool cell_set_contains(CellSet* set, SylvesCell cell) {
     size_t index = cell_hash(cell) % set->bucket_count;
     CellSetEntry* entry = set->buckets[index];
@@ -88,14 +71,14 @@ static bool cell_set_contains(CellSet* set, SylvesCell cell) {
     return false;
 }
 
-static bool cell_set_insert(CellSet* set, SylvesCell cell) {
+static bool cell_set_insert(SylvesArena* arena, CellSet* set, SylvesCell cell) {
     if (cell_set_contains(set, cell)) {
         return true; // Already exists
     }
     
     size_t index = cell_hash(cell) % set->bucket_count;
     
-    CellSetEntry* entry = (CellSetEntry*)sylves_alloc(sizeof(CellSetEntry));
+    CellSetEntry* entry = (CellSetEntry*)sylves_arena_alloc(arena, sizeof(CellSetEntry));
     if (!entry) return false;
     
     entry->cell = cell;
@@ -122,37 +105,20 @@ static bool get_shared_edge(
     SylvesVector3* end) {
     
     // Get corners of both cells
-    SylvesVector3 corners1_buf[16];
-    SylvesVector3 corners2_buf[16];
-    int corners1_count = sylves_grid_get_cell_corners(grid, cell1, corners1_buf, 16);
-    int corners2_count = sylves_grid_get_cell_corners(grid, cell2, corners2_buf, 16);
+    SylvesVector3 corners1[16];
+    SylvesVector3 corners2[16];
+    int corners1_count = sylves_grid_get_cell_corners(grid, cell1, corners1, 16);
+    int corners2_count = sylves_grid_get_cell_corners(grid, cell2, corners2, 16);
     
     if (corners1_count <= 0 || corners2_count <= 0) return false;
     
-    SylvesVector3* corners1 = (SylvesVector3*)sylves_alloc(sizeof(SylvesVector3) * corners1_count);
-    SylvesVector3* corners2 = (SylvesVector3*)sylves_alloc(sizeof(SylvesVector3) * corners2_count);
-    
-    if (!corners1 || !corners2) {
-        sylves_free(corners1);
-        sylves_free(corners2);
-        return false;
-    }
-    
-    // Get actual corners
-    for (int i = 0; i < corners1_count; i++) {
-        corners1[i] = corners1_buf[i];
-    }
-    for (int i = 0; i < corners2_count; i++) {
-        corners2[i] = corners2_buf[i];
-    }
-    
     // Find shared corners
     SylvesVector3 shared[2];
     size_t shared_count = 0;
     const float epsilon = 1e-6f;
     
-    for (size_t i = 0; i < corners1_count && shared_count < 2; i++) {
-        for (size_t j = 0; j < corners2_count; j++) {
+    for (int i = 0; i < corners1_count && shared_count < 2; i++) {
+        for (int j = 0; j < corners2_count; j++) {
             if (vector3_approx_equal(corners1[i], corners2[j], epsilon)) {
                 shared[shared_count++] = corners1[i];
                 break;
@@ -160,9 +126,6 @@ static bool get_shared_edge(
         }
     }
     
-    sylves_free(corners1);
-    sylves_free(corners2);
-    
     if (shared_count == 2) {
         *start = shared[0];
         *end = shared[1];
@@ -174,12 +137,13 @@ static bool get_shared_edge(
 
 /* Collect boundary edges */
 static OutlineEdge* collect_boundary_edges(
+    SylvesArena* arena,
     SylvesGrid* grid,
     const CellSet* cell_set,
     size_t* edge_count) {
     
     size_t capacity = cell_set->entry_count * 6; // Overestimate
-    OutlineEdge* edges = (OutlineEdge*)sylves_alloc(sizeof(OutlineEdge) * capacity);
+    OutlineEdge* edges = (OutlineEdge*)sylves_arena_alloc(arena, sizeof(OutlineEdge) * capacity);
     if (!edges) return NULL;
     
     size_t count = 0;
@@ -304,45 +268,38 @@ static size_t build_chains(
     return chain_count;
 }
 
-/* Main outlining function */
-SylvesError sylves_outline_cells(
+/* Outlining over arena-backed temporaries */
+static SylvesError outline_cells_in_arena(
+    SylvesArena* arena,
     SylvesGrid* grid,
     const SylvesCell* cells,
     size_t cell_count,
     SylvesOutlineSegment** segments,
     size_t* segment_count) {
     
-    if (!grid || !cells || cell_count == 0 || !segments || !segment_count) {
-        return SYLVES_ERROR_INVALID_ARGUMENT;
-    }
-    
     // Create cell set for fast lookup
-    CellSet* cell_set = cell_set_create(cell_count * 2);
+    CellSet* cell_set = cell_set_create(arena, cell_count * 2);
     if (!cell_set) {
         return SYLVES_ERROR_OUT_OF_MEMORY;
     }
     
     // Add all cells to set
     for (size_t i = 0; i < cell_count; i++) {
-        if (!cell_set_insert(cell_set, cells[i])) {
-            cell_set_destroy(cell_set);
+        if (!cell_set_insert(arena, cell_set, cells[i])) {
             return SYLVES_ERROR_OUT_OF_MEMORY;
         }
     }
     
     // Collect boundary edges
-    size_t edge_count;
-    OutlineEdge* edges = collect_boundary_edges(grid, cell_set, &edge_count);
-    if (!edges && edge_count > 0) {
-        cell_set_destroy(cell_set);
+    size_t edge_count = 0;
+    OutlineEdge* edges = collect_boundary_edges(arena, grid, cell_set, &edge_count);
+    if (!edges) {
         return SYLVES_ERROR_OUT_OF_MEMORY;
     }
     
     // Build chains
-    OutlineEdge** chain_starts = (OutlineEdge**)sylves_alloc(sizeof(OutlineEdge*) * edge_count);
+    OutlineEdge** chain_starts = (OutlineEdge**)sylves_arena_alloc(arena, sizeof(OutlineEdge*) * edge_count);
     if (!chain_starts) {
-        sylves_free(edges);
-        cell_set_destroy(cell_set);
         return SYLVES_ERROR_OUT_OF_MEMORY;
     }
     
@@ -358,13 +315,16 @@ SylvesError sylves_outline_cells(
         }
     }
     
+    if (total_segments == 0) {
+        *segments = NULL;
+        *segment_count = 0;
+        return SYLVES_SUCCESS;
+    }
+
     // Allocate output segments
     SylvesOutlineSegment* output_segments = (SylvesOutlineSegment*)sylves_alloc(
         sizeof(SylvesOutlineSegment) * total_segments);
     if (!output_segments) {
-        sylves_free(chain_starts);
-        sylves_free(edges);
-        cell_set_destroy(cell_set);
         return SYLVES_ERROR_OUT_OF_MEMORY;
     }
     
@@ -380,14 +340,44 @@ SylvesError sylves_outline_cells(
         }
     }
     
-    // Clean up
-    sylves_free(chain_starts);
-    sylves_free(edges);
-    cell_set_destroy(cell_set);
-    
     // Return results
     *segments = output_segments;
     *segment_count = segment_index;
     
     return SYLVES_SUCCESS;
 }
+
+SylvesError sylves_outline_cells_with_arena(
+    SylvesGrid* grid,
+    const SylvesCell* cells,
+    size_t cell_count,
+    SylvesArena* scratch,
+    SylvesOutlineSegment** segments,
+    size_t* segment_count) {
+    
+    if (!grid || !cells || cell_count == 0 || !segments || !segment_count) {
+        return SYLVES_ERROR_INVALID_ARGUMENT;
+    }
+    
+    SylvesArena* arena = scratch ? scratch : sylves_get_thread_scratch_arena();
+    if (!arena) {
+        return SYLVES_ERROR_OUT_OF_MEMORY;
+    }
+    
+    // Every temporary structure is released by the one pop
+    SylvesArenaMark mark = sylves_arena_push(arena);
+    SylvesError err = outline_cells_in_arena(arena, grid, cells, cell_count, segments, segment_count);
+    sylves_arena_pop(arena, mark);
+    return err;
+}
+
+/* Main outlining function */
+SylvesError sylves_outline_cells(
+    SylvesGrid* grid,
+    const SylvesCell* cells,
+    size_t cell_count,
+    SylvesOutlineSegment** segments,
+    size_t* segment_count) {
+    
+    return sylves_outline_cells_with_arena(grid, cells, cell_count, NULL, segments, segment_count);
+}
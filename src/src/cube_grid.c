@@ -12,12 +12,15 @@
 #include "sylves/cell_type.h"
 #include "sylves/errors.h"
 #include "internal/grid_internal.h"
+#include "internal/simd_internal.h"
+#include "sylves/cell_buffer.h"
 #include "sylves/cube_cell_type.h"
 #include "sylves/utils.h"
 #include "sylves/mesh.h"
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <limits.h>
 
 typedef struct {
     SylvesGrid base;
@@ -31,6 +34,7 @@ typedef struct {
 
 /* Forward declarations */
 static void cube_grid_destroy(SylvesGrid* grid);
+static bool cube_grid_is_finite(const SylvesGrid* grid);
 static bool cube_grid_is_cell_in_grid(const SylvesGrid* grid, SylvesCell cell);
 static bool cube_grid_try_move(const SylvesGrid* grid, SylvesCell cell, SylvesCellDir dir,
                                SylvesCell* dest, SylvesCellDir* inverse_dir, SylvesConnection* connection);
@@ -38,6 +42,15 @@ static SylvesVector3 cube_grid_get_cell_center(const SylvesGrid* grid, SylvesCel
 static SylvesVector3 cube_grid_get_cell_corner_pos(const SylvesGrid* grid, SylvesCell cell, SylvesCellCorner corner);
 static SylvesError cube_grid_get_cell_aabb(const SylvesGrid* grid, SylvesCell cell, SylvesAabb* aabb);
 static bool cube_grid_find_cell(const SylvesGrid* grid, SylvesVector3 position, SylvesCell* cell);
+static int cube_grid_try_move_batch(const SylvesGrid* grid, const SylvesCell* cells,
+                                    const SylvesCellDir* dirs, size_t count,
+                                    SylvesCell* dests, SylvesCellDir* inverse_dirs,
+                                    SylvesConnection* connections, bool* ok_mask);
+static void cube_grid_get_cell_centers_soa(const SylvesGrid* grid, const SylvesCellBuffer* cells,
+                                           double* out_x, double* out_y, double* out_z);
+static void cube_grid_get_cell_corners_soa(const SylvesGrid* grid, const SylvesCellBuffer* cells,
+                                           SylvesCellCorner corner,
+                                           double* out_x, double* out_y, double* out_z);
 
 /* VTable */
 static const SylvesGridVTable cube_grid_vtable = {
@@ -47,7 +60,7 @@ static const SylvesGridVTable cube_grid_vtable = {
     .is_planar = NULL,
     .is_repeating = NULL,
     .is_orientable = NULL,
-    .is_finite = NULL,
+    .is_finite = cube_grid_is_finite,
     .get_coordinate_dimension = NULL,
     .is_cell_in_grid = cube_grid_is_cell_in_grid,
     .get_cell_type = NULL,
@@ -62,17 +75,24 @@ static const SylvesGridVTable cube_grid_vtable = {
     .raycast = NULL,
     .get_index_count = NULL,
     .get_index = NULL,
-    .get_cell_by_index = NULL
+    .get_cell_by_index = NULL,
+    .try_move_batch = cube_grid_try_move_batch,
+    .get_cell_centers_soa = cube_grid_get_cell_centers_soa,
+    .get_cell_corners_soa = cube_grid_get_cell_corners_soa
 };
 
 /* Helper functions */
 static void cube_grid_destroy(SylvesGrid* grid) {
     if (grid) {
+        /* grid->data points back at the enclosing CubeGrid, which owns grid */
         sylves_free(grid->data);
-        sylves_free(grid);
     }
 }
 
+static bool cube_grid_is_finite(const SylvesGrid* grid) {
+    return ((const CubeGrid*)grid->data)->is_bounded;
+}
+
 static bool cube_grid_is_cell_in_grid(const SylvesGrid* grid, SylvesCell cell) {
     const CubeGrid* cg = (const CubeGrid*)grid->data;
     
@@ -143,6 +163,54 @@ static bool cube_grid_try_move(const SylvesGrid* grid, SylvesCell cell, SylvesCe
     return true;
 }
 
+/* Per-direction offsets and inverses, indexed by SylvesCubeDir */
+static const int CUBE_DELTA[SYLVES_CUBE_DIR_COUNT][3] = {
+    { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 }
+};
+static const SylvesCellDir CUBE_INV[SYLVES_CUBE_DIR_COUNT] = {
+    SYLVES_CUBE_DIR_LEFT, SYLVES_CUBE_DIR_RIGHT,
+    SYLVES_CUBE_DIR_DOWN, SYLVES_CUBE_DIR_UP,
+    SYLVES_CUBE_DIR_BACK, SYLVES_CUBE_DIR_FORWARD
+};
+
+static int cube_grid_try_move_batch(const SylvesGrid* grid, const SylvesCell* cells,
+                                    const SylvesCellDir* dirs, size_t count,
+                                    SylvesCell* dests, SylvesCellDir* inverse_dirs,
+                                    SylvesConnection* connections, bool* ok_mask) {
+    const CubeGrid* cg = (const CubeGrid*)grid->data;
+    int moved = 0;
+
+    /* Unsigned range checks keep the bounded test branch-free */
+    unsigned int wx = cg->is_bounded ? (unsigned int)(cg->max_x - cg->min_x) : UINT_MAX;
+    unsigned int wy = cg->is_bounded ? (unsigned int)(cg->max_y - cg->min_y) : UINT_MAX;
+    unsigned int wz = cg->is_bounded ? (unsigned int)(cg->max_z - cg->min_z) : UINT_MAX;
+    unsigned int ox = cg->is_bounded ? (unsigned int)cg->min_x : 0u;
+    unsigned int oy = cg->is_bounded ? (unsigned int)cg->min_y : 0u;
+    unsigned int oz = cg->is_bounded ? (unsigned int)cg->min_z : 0u;
+
+    for (size_t i = 0; i < count; i++) {
+        SylvesCell c = cells[i];
+        int d = dirs[i];
+        bool valid_dir = (unsigned int)d < SYLVES_CUBE_DIR_COUNT;
+        int di = valid_dir ? d : 0;
+        SylvesCell n = { c.x + CUBE_DELTA[di][0], c.y + CUBE_DELTA[di][1], c.z + CUBE_DELTA[di][2] };
+        bool ok = valid_dir &&
+                  (unsigned int)c.x - ox <= wx && (unsigned int)c.y - oy <= wy &&
+                  (unsigned int)c.z - oz <= wz &&
+                  (unsigned int)n.x - ox <= wx && (unsigned int)n.y - oy <= wy &&
+                  (unsigned int)n.z - oz <= wz;
+        if (dests) dests[i] = n;
+        if (inverse_dirs) inverse_dirs[i] = CUBE_INV[di];
+        if (connections) {
+            connections[i].rotation = 0;
+            connections[i].is_mirror = false;
+        }
+        if (ok_mask) ok_mask[i] = ok;
+        moved += ok;
+    }
+    return moved;
+}
+
 static SylvesVector3 cube_grid_get_cell_center(const SylvesGrid* grid, SylvesCell cell) {
     const CubeGrid* cg = (const CubeGrid*)grid->data;
     
@@ -174,6 +242,29 @@ static SylvesVector3 cube_grid_get_cell_corner_pos(const SylvesGrid* grid, Sylve
     };
 }
 
+static void cube_grid_get_cell_centers_soa(const SylvesGrid* grid, const SylvesCellBuffer* cells,
+                                           double* out_x, double* out_y, double* out_z) {
+    const CubeGrid* cg = (const CubeGrid*)grid->data;
+    sylves_simd_affine_i32(cells->x, out_x, cells->count, 0.5, cg->cell_size_x);
+    sylves_simd_affine_i32(cells->y, out_y, cells->count, 0.5, cg->cell_size_y);
+    sylves_simd_affine_i32(cells->z, out_z, cells->count, 0.5, cg->cell_size_z);
+}
+
+static void cube_grid_get_cell_corners_soa(const SylvesGrid* grid, const SylvesCellBuffer* cells,
+                                           SylvesCellCorner corner,
+                                           double* out_x, double* out_y, double* out_z) {
+    const CubeGrid* cg = (const CubeGrid*)grid->data;
+    if (corner < 0 || corner >= SYLVES_CUBE_CORNER_COUNT) {
+        sylves_simd_fill(out_x, cells->count, 0.0);
+        sylves_simd_fill(out_y, cells->count, 0.0);
+        sylves_simd_fill(out_z, cells->count, 0.0);
+        return;
+    }
+    sylves_simd_affine_i32(cells->x, out_x, cells->count, (corner & 1) ? 1.0 : 0.0, cg->cell_size_x);
+    sylves_simd_affine_i32(cells->y, out_y, cells->count, (corner & 2) ? 1.0 : 0.0, cg->cell_size_y);
+    sylves_simd_affine_i32(cells->z, out_z, cells->count, (corner & 4) ? 1.0 : 0.0, cg->cell_size_z);
+}
+
 static SylvesError cube_grid_get_cell_aabb(const SylvesGrid* grid, SylvesCell cell, SylvesAabb* aabb) {
     const CubeGrid* cg = (const CubeGrid*)grid->data;
     
@@ -14,6 +14,7 @@
 /* Constants matching Sylves */
 static const double EPSILON = 2.220446049250313e-16; /* 2^-52 */
 static const int EDGE_STACK_SIZE = 512;
+static const int UNTANGLE_MAX_PASSES = 8;
 
 /* Forward declarations */
 static int hash_key(const SylvesDelaunay* d, double x, double y);
@@ -25,32 +26,50 @@ static int add_triangle(SylvesDelaunay* d, int i0, int i1, int i2, int a, int b,
 static void link_halfedge(SylvesDelaunay* d, int a, int b);
 static int legalize(SylvesDelaunay* d, int a, int* edge_stack);
 
-SylvesDelaunay* sylves_delaunay_create(
-    const SylvesVector2* points,
-    size_t num_points,
-    SylvesError* error_out
-) {
-    if (!points || num_points < 3) {
-        if (error_out) *error_out = SYLVES_ERROR_INVALID_ARGUMENT;
-        return NULL;
+/*
+ * Grow the buffers to fit num_points. Kept at their high-water mark, so
+ * re-triangulating the same number of points allocates nothing.
+ */
+static bool reserve_buffers(SylvesDelaunay* d, size_t num_points) {
+    if (!d->edge_stack) {
+        d->edge_stack = malloc(EDGE_STACK_SIZE * sizeof(int));
+        if (!d->edge_stack) return false;
     }
+    if (num_points <= d->points_capacity) return true;
+
+#define GROW(field, count) do { \
+        void* grown = realloc(d->field, (count) * sizeof(*d->field)); \
+        if (!grown) return false; \
+        d->field = grown; \
+    } while (0)
+
+    size_t max_triangles = 2 * num_points - 5;
+    size_t hash_capacity = (size_t)ceil(sqrt((double)num_points));
+    GROW(coords, num_points * 2);
+    GROW(triangles, max_triangles * 3);
+    GROW(halfedges, max_triangles * 3);
+    GROW(hull, num_points);
+    GROW(hull_prev, num_points);
+    GROW(hull_next, num_points);
+    GROW(hull_tri, num_points);
+    GROW(hull_hash, hash_capacity);
+    GROW(ids, num_points);
+    GROW(dists, num_points);
+
+#undef GROW
 
-    SylvesDelaunay* d = calloc(1, sizeof(SylvesDelaunay));
-    if (!d) {
-        if (error_out) *error_out = SYLVES_ERROR_OUT_OF_MEMORY;
-        return NULL;
-    }
+    d->triangles_capacity = max_triangles * 3;
+    d->points_capacity = num_points;
+    return true;
+}
 
-    d->points = points;
-    d->num_points = num_points;
-
-    /* Allocate flattened coordinate array */
-    d->coords = malloc(num_points * 2 * sizeof(float));
-    if (!d->coords) {
-        sylves_delaunay_destroy(d);
-        if (error_out) *error_out = SYLVES_ERROR_OUT_OF_MEMORY;
-        return NULL;
-    }
+/* Sweep-hull triangulation of d->points into the reserved buffers */
+static void triangulate(SylvesDelaunay* d) {
+    size_t num_points = d->num_points;
+    const SylvesVector2* points = d->points;
+    int* ids = d->ids;
+    double* dists = d->dists;
+    int* edge_stack = d->edge_stack;
 
     /* Copy points to flattened array */
     for (size_t i = 0; i < num_points; i++) {
@@ -58,49 +77,13 @@ SylvesDelaunay* sylves_delaunay_create(
         d->coords[2 * i + 1] = (float)points[i].y;
     }
 
-    /* Allocate triangulation arrays */
-    size_t max_triangles = num_points > 2 ? 2 * num_points - 5 : 0;
-    d->triangles_capacity = max_triangles * 3;
-    d->triangles = malloc(d->triangles_capacity * sizeof(int));
-    d->halfedges = malloc(d->triangles_capacity * sizeof(int));
-    
-    if (!d->triangles || !d->halfedges) {
-        sylves_delaunay_destroy(d);
-        if (error_out) *error_out = SYLVES_ERROR_OUT_OF_MEMORY;
-        return NULL;
-    }
-
     /* Initialize halfedges to -1 */
-    memset(d->halfedges, -1, d->triangles_capacity * sizeof(int));
-
-    /* Allocate hull arrays */
-    d->hash_size = (int)ceil(sqrt((double)num_points));
-    d->hull_prev = malloc(num_points * sizeof(int));
-    d->hull_next = malloc(num_points * sizeof(int));
-    d->hull_tri = malloc(num_points * sizeof(int));
-    d->hull_hash = malloc(d->hash_size * sizeof(int));
-
-    if (!d->hull_prev || !d->hull_next || !d->hull_tri || !d->hull_hash) {
-        sylves_delaunay_destroy(d);
-        if (error_out) *error_out = SYLVES_ERROR_OUT_OF_MEMORY;
-        return NULL;
-    }
+    memset(d->halfedges, -1, (2 * num_points - 5) * 3 * sizeof(int));
 
     /* Initialize hull hash to -1 */
+    d->hash_size = (int)ceil(sqrt((double)num_points));
     memset(d->hull_hash, -1, d->hash_size * sizeof(int));
 
-    /* Allocate working arrays */
-    int* ids = malloc(num_points * sizeof(int));
-    double* dists = malloc(num_points * sizeof(double));
-    
-    if (!ids || !dists) {
-        free(ids);
-        free(dists);
-        sylves_delaunay_destroy(d);
-        if (error_out) *error_out = SYLVES_ERROR_OUT_OF_MEMORY;
-        return NULL;
-    }
-
     /* Find bounding box */
     float min_x = FLT_MAX, min_y = FLT_MAX;
     float max_x = -FLT_MAX, max_y = -FLT_MAX;
@@ -173,27 +156,20 @@ SylvesDelaunay* sylves_delaunay_create(
         quicksort(ids, dists, 0, (int)num_points - 1);
         
         /* Build hull */
-        int* hull = malloc(num_points * sizeof(int));
         int j = 0;
         double d0 = -DBL_MAX;
         
         for (size_t i = 0; i < num_points; i++) {
             int id = ids[i];
             if (dists[id] > d0) {
-                hull[j++] = id;
+                d->hull[j++] = id;
                 d0 = dists[id];
             }
         }
         
-        d->hull = realloc(hull, j * sizeof(int));
         d->hull_size = j;
         d->num_triangles = 0;
-        
-        free(ids);
-        free(dists);
-        
-        if (error_out) *error_out = SYLVES_SUCCESS;
-        return d;
+        return;
     }
 
     /* Orient seed triangle */
@@ -237,16 +213,6 @@ SylvesDelaunay* sylves_delaunay_create(
     d->num_triangles = 0;
     add_triangle(d, i0, i1, i2, -1, -1, -1);
 
-    /* Allocate edge stack for legalization */
-    int* edge_stack = malloc(EDGE_STACK_SIZE * sizeof(int));
-    if (!edge_stack) {
-        free(ids);
-        free(dists);
-        sylves_delaunay_destroy(d);
-        if (error_out) *error_out = SYLVES_ERROR_OUT_OF_MEMORY;
-        return NULL;
-    }
-
     /* Add remaining points */
     double xp = 0, yp = 0;
     
@@ -336,41 +302,241 @@ SylvesDelaunay* sylves_delaunay_create(
     }
 
     /* Build final hull array */
-    d->hull = malloc(d->hull_size * sizeof(int));
-    if (!d->hull) {
-        free(ids);
-        free(dists);
-        free(edge_stack);
-        sylves_delaunay_destroy(d);
-        if (error_out) *error_out = SYLVES_ERROR_OUT_OF_MEMORY;
-        return NULL;
-    }
-
     int s = d->hull_start;
     for (size_t i = 0; i < d->hull_size; i++) {
         d->hull[i] = s;
         s = d->hull_next[s];
     }
+}
 
-    /* Clean up temporary arrays */
-    free(d->hull_prev);
-    free(d->hull_next);
-    free(d->hull_tri);
-    free(d->hull_hash);
-    d->hull_prev = d->hull_next = d->hull_tri = d->hull_hash = NULL;
-
-    /* Trim triangle arrays */
-    d->triangles = realloc(d->triangles, d->num_triangles * 3 * sizeof(int));
-    d->halfedges = realloc(d->halfedges, d->num_triangles * 3 * sizeof(int));
+SylvesDelaunay* sylves_delaunay_create(
+    const SylvesVector2* points,
+    size_t num_points,
+    SylvesError* error_out
+) {
+    if (!points || num_points < 3) {
+        if (error_out) *error_out = SYLVES_ERROR_INVALID_ARGUMENT;
+        return NULL;
+    }
 
-    free(ids);
-    free(dists);
-    free(edge_stack);
+    SylvesDelaunay* d = calloc(1, sizeof(SylvesDelaunay));
+    if (!d) {
+        if (error_out) *error_out = SYLVES_ERROR_OUT_OF_MEMORY;
+        return NULL;
+    }
 
-    if (error_out) *error_out = SYLVES_SUCCESS;
+    SylvesError err = sylves_delaunay_update(d, points, num_points);
+    if (err != SYLVES_SUCCESS) {
+        sylves_delaunay_destroy(d);
+        d = NULL;
+    }
+    if (error_out) *error_out = err;
     return d;
 }
 
+SylvesError sylves_delaunay_update(
+    SylvesDelaunay* delaunay,
+    const SylvesVector2* points,
+    size_t num_points
+) {
+    if (!delaunay || !points || num_points < 3) {
+        return SYLVES_ERROR_INVALID_ARGUMENT;
+    }
+    if (!reserve_buffers(delaunay, num_points)) {
+        delaunay->num_triangles = 0;
+        delaunay->hull_size = 0;
+        return SYLVES_ERROR_OUT_OF_MEMORY;
+    }
+
+    delaunay->points = points;
+    delaunay->num_points = num_points;
+    triangulate(delaunay);
+    return SYLVES_SUCCESS;
+}
+
+/* Twice the signed area of a triangle, positive for the orientation triangles are stored in */
+static double orient_value(const SylvesDelaunay* d, int i, int j, int k) {
+    const float* c = d->coords;
+    return ((double)c[2 * j + 1] - c[2 * i + 1]) * ((double)c[2 * k] - c[2 * j]) -
+           ((double)c[2 * j] - c[2 * i]) * ((double)c[2 * k + 1] - c[2 * j + 1]);
+}
+
+/* Replace the diagonal shared by a and its twin with the quad's other one, as legalize does */
+static void flip_edge(SylvesDelaunay* d, int a) {
+    int b = d->halfedges[a];
+    int a0 = a - a % 3;
+    int b0 = b - b % 3;
+    int ar = a0 + (a + 2) % 3;
+    int bl = b0 + (b + 2) % 3;
+
+    d->triangles[a] = d->triangles[bl];
+    d->triangles[b] = d->triangles[ar];
+    int hbl = d->halfedges[bl];
+    link_halfedge(d, a, hbl);
+    link_halfedge(d, b, d->halfedges[ar]);
+    link_halfedge(d, ar, bl);
+}
+
+/*
+ * Untangle triangles that moving points turned over. Flips preserve signed
+ * area, so flipping an edge of an inverted triangle whenever that lowers
+ * the inverted area of the pair converges on small local folds. Returns
+ * false once a pass makes no progress, typically where points moved
+ * across several triangles; a full rebuild is cheaper than chasing those.
+ */
+static bool untangle(SylvesDelaunay* d) {
+    size_t edge_count = d->num_triangles * 3;
+    for (int pass = 0; pass < UNTANGLE_MAX_PASSES; pass++) {
+        bool inverted = false;
+        bool flipped = false;
+        for (size_t t = 0; t < edge_count; t += 3) {
+            if (orient_value(d, d->triangles[t], d->triangles[t + 1], d->triangles[t + 2]) > 0) continue;
+            inverted = true;
+            for (int k = 0; k < 3; k++) {
+                int a = (int)t + k;
+                int b = d->halfedges[a];
+                if (b == -1) continue;
+                int p0 = d->triangles[sylves_delaunay_prev_halfedge(a)];
+                int pr = d->triangles[a];
+                int pl = d->triangles[sylves_delaunay_next_halfedge(a)];
+                int p1 = d->triangles[sylves_delaunay_prev_halfedge(b)];
+                double before = fmin(orient_value(d, pr, pl, p0), 0) + fmin(orient_value(d, pl, pr, p1), 0);
+                double after = fmin(orient_value(d, p1, pl, p0), 0) + fmin(orient_value(d, p0, pr, p1), 0);
+                if (after > before) {
+                    flip_edge(d, a);
+                    flipped = true;
+                    break;
+                }
+            }
+        }
+        if (!inverted) return true;
+        if (!flipped) return false;
+    }
+    return false;
+}
+
+/*
+ * Whether the topology, once untangled, still triangulates the moved
+ * points: every triangle keeps a positive area and the hull stays convex,
+ * collinear hull points allowed. Together these rule out any fold.
+ */
+static bool topology_still_valid(SylvesDelaunay* d) {
+    if (!untangle(d)) {
+        return false;
+    }
+
+    /* hull_tri is only needed while inserting points; here it maps a hull point to its outgoing hull edge */
+    size_t edge_count = d->num_triangles * 3;
+    int* hull_out = d->hull_tri;
+    for (size_t e = 0; e < edge_count; e++) {
+        if (d->halfedges[e] == -1) {
+            hull_out[d->triangles[e]] = (int)e;
+        }
+    }
+    for (size_t e = 0; e < edge_count; e++) {
+        if (d->halfedges[e] != -1) continue;
+        int a = d->triangles[e];
+        int b = d->triangles[sylves_delaunay_next_halfedge((int)e)];
+        int c = d->triangles[sylves_delaunay_next_halfedge(hull_out[b])];
+        if (orient_value(d, a, b, c) < 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool push_flip(SylvesDelaunay* d, size_t* count, int e) {
+    if (*count == d->flip_stack_capacity) {
+        size_t capacity = d->flip_stack_capacity > 0 ? d->flip_stack_capacity * 2 : 1024;
+        int* grown = realloc(d->flip_stack, capacity * sizeof(int));
+        if (!grown) return false;
+        d->flip_stack = grown;
+        d->flip_stack_capacity = capacity;
+    }
+    d->flip_stack[(*count)++] = e;
+    return true;
+}
+
+/*
+ * Lawson flips from every interior edge until none is illegal. Returns
+ * false if the stack cannot grow or the flips exceed a budget, which
+ * near-cocircular points flipping back and forth under rounding could.
+ */
+static bool flip_to_delaunay(SylvesDelaunay* d) {
+    size_t count = 0;
+    size_t edge_count = d->num_triangles * 3;
+    for (size_t e = 0; e < edge_count; e++) {
+        if ((int)e < d->halfedges[e] && !push_flip(d, &count, (int)e)) {
+            return false;
+        }
+    }
+
+    size_t budget = 4 * edge_count + 64;
+    while (count > 0) {
+        int a = d->flip_stack[--count];
+        int b = d->halfedges[a];
+        if (b == -1) continue;
+
+        int a0 = a - a % 3;
+        int b0 = b - b % 3;
+        int al = a0 + (a + 1) % 3;
+        int ar = a0 + (a + 2) % 3;
+        int bl = b0 + (b + 2) % 3;
+        int br = b0 + (b + 1) % 3;
+
+        int p0 = d->triangles[ar];
+        int pr = d->triangles[a];
+        int pl = d->triangles[al];
+        int p1 = d->triangles[bl];
+
+        if (!sylves_incircle(
+                d->coords[2 * p0], d->coords[2 * p0 + 1],
+                d->coords[2 * pr], d->coords[2 * pr + 1],
+                d->coords[2 * pl], d->coords[2 * pl + 1],
+                d->coords[2 * p1], d->coords[2 * p1 + 1])) {
+            continue;
+        }
+        if (budget-- == 0) return false;
+        flip_edge(d, a);
+
+        /* The four outer edges of the flipped quad may now be illegal */
+        if (!push_flip(d, &count, a) || !push_flip(d, &count, al) ||
+            !push_flip(d, &count, b) || !push_flip(d, &count, br)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+SylvesError sylves_delaunay_update_moved(
+    SylvesDelaunay* delaunay,
+    const SylvesVector2* points,
+    bool* rebuilt_out
+) {
+    if (!delaunay || !points || delaunay->num_points < 3) {
+        return SYLVES_ERROR_INVALID_ARGUMENT;
+    }
+    SylvesDelaunay* d = delaunay;
+    size_t num_points = d->num_points;
+    if (rebuilt_out) *rebuilt_out = false;
+
+    /* By Euler's formula the triangulation holds (triangles + hull + 2) / 2 points; fewer means duplicates were skipped */
+    bool complete = d->num_triangles > 0 && (d->num_triangles + d->hull_size + 2) / 2 == num_points;
+    if (complete) {
+        d->points = points;
+        for (size_t i = 0; i < num_points; i++) {
+            d->coords[2 * i] = (float)points[i].x;
+            d->coords[2 * i + 1] = (float)points[i].y;
+        }
+        if (topology_still_valid(d) && flip_to_delaunay(d)) {
+            return SYLVES_SUCCESS;
+        }
+    }
+
+    if (rebuilt_out) *rebuilt_out = true;
+    return sylves_delaunay_update(d, points, num_points);
+}
+
 void sylves_delaunay_destroy(SylvesDelaunay* delaunay) {
     if (!delaunay) return;
 
@@ -382,6 +548,10 @@ void sylves_delaunay_destroy(SylvesDelaunay* delaunay) {
     free(delaunay->hull_next);
     free(delaunay->hull_tri);
     free(delaunay->hull_hash);
+    free(delaunay->ids);
+    free(delaunay->dists);
+    free(delaunay->edge_stack);
+    free(delaunay->flip_stack);
     free(delaunay);
 }
 
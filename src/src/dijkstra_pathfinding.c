@@ -7,119 +7,179 @@
 #include "sylves/memory.h"
 #include "sylves/errors.h"
 #include "sylves/cell.h"
+#include "sylves/grid.h"
+#include "sylves/cell_type.h"
+#include "internal/path_search.h"
 #include <string.h>
+#include <stdlib.h>
 #include <float.h>
 
 /* Forward declaration */
 static float default_step_length(const SylvesStep* step, void* user_data);
 
-/* Hash table for cell lookups - reuse same structure as A* */
-#define HASH_TABLE_INITIAL_SIZE 64
-
-typedef struct CellHashEntry {
-    SylvesCell cell;
-    float distance;     // Distance from start
-    SylvesStep step;    // How we got here
-    bool has_step;      // Whether step is valid
-    struct CellHashEntry* next;
-} CellHashEntry;
-
-typedef struct {
-    CellHashEntry** buckets;
-    size_t bucket_count;
-    size_t entry_count;
-} CellHashTable;
-
 /* Dijkstra pathfinding context */
 struct SylvesDijkstraPathfinding {
     SylvesGrid* grid;
-    SylvesCell src;
+    SylvesCell src;             // first source
     SylvesStepLengthFunc step_lengths;
     void* user_data;
     
-    CellHashTable* visited;
-    SylvesHeap* open_set;
+    SylvesPathfindingContext search;
 };
 
-/* Hash function for cells */
-static size_t cell_hash(SylvesCell cell) {
-    // Simple hash combining x, y, z coordinates
-    size_t hash = 0;
-    hash ^= (size_t)cell.x + 0x9e3779b9 + (hash << 6) + (hash >> 2);
-    hash ^= (size_t)cell.y + 0x9e3779b9 + (hash << 6) + (hash >> 2);
-    hash ^= (size_t)cell.z + 0x9e3779b9 + (hash << 6) + (hash >> 2);
-    return hash;
-}
+/* Search core, shared with the context-based sylves_find_path_with_context */
 
-/* Hash table operations */
-static CellHashTable* hash_table_create(size_t initial_size) {
-    CellHashTable* table = (CellHashTable*)sylves_alloc(sizeof(CellHashTable));
-    if (!table) return NULL;
-    
-    table->buckets = (CellHashEntry**)sylves_calloc(initial_size, sizeof(CellHashEntry*));
-    if (!table->buckets) {
-        sylves_free(table);
-        return NULL;
+void sylves_path_dijkstra_seed(SylvesPathfindingContext* ctx, SylvesGrid* grid,
+                               const SylvesCell* sources, size_t source_count) {
+    sylves_pathfinding_context_reset(ctx);
+    sylves_path_map_bind(&ctx->nodes, grid);
+    
+    // Initialize source cells; each is a root of the search tree
+    for (size_t i = 0; i < source_count; i++) {
+        int32_t src_node = sylves_path_map_insert(&ctx->nodes, sources[i]);
+        if (src_node < 0) continue;
+        sylves_path_map_set_score(&ctx->nodes, src_node, 0.0f, 0.0f);
+        
+        // Add to open set
+        sylves_radix_heap_push(ctx->open_radix, (uint32_t)src_node, 0.0f);
     }
-    
-    table->bucket_count = initial_size;
-    table->entry_count = 0;
-    
-    return table;
 }
 
-static void hash_table_destroy(CellHashTable* table) {
-    if (!table) return;
-    
-    // Free all entries
-    for (size_t i = 0; i < table->bucket_count; i++) {
-        CellHashEntry* entry = table->buckets[i];
-        while (entry) {
-            CellHashEntry* next = entry->next;
-            sylves_free(entry);
-            entry = next;
-        }
-    }
-    
-    sylves_free(table->buckets);
-    sylves_free(table);
+static int compare_nodes(const void* a, const void* b) {
+    int32_t x = *(const int32_t*)a, y = *(const int32_t*)b;
+    return (x > y) - (x < y);
 }
 
-static CellHashEntry* hash_table_find(CellHashTable* table, SylvesCell cell) {
-    size_t index = cell_hash(cell) % table->bucket_count;
-    CellHashEntry* entry = table->buckets[index];
-    
-    while (entry) {
-        if (sylves_cell_equals(entry->cell, cell)) {
-            return entry;
-        }
-        entry = entry->next;
+/*
+ * Collect the distinct target nodes still waiting to be settled, sorted
+ * for bsearch. Targets are added to the map unreached, so they get ids;
+ * those the map rejects (outside a dense grid) can never be settled.
+ */
+static size_t pending_targets(SylvesPathfindingContext* ctx, const SylvesCell* targets, size_t target_count,
+                              int32_t* nodes) {
+    size_t count = 0;
+    for (size_t i = 0; i < target_count; i++) {
+        int32_t node = sylves_path_map_insert(&ctx->nodes, targets[i]);
+        if (node < 0) continue;
+        bool settled = sylves_path_map_g(&ctx->nodes, node) != FLT_MAX &&
+                       !sylves_radix_heap_contains(ctx->open_radix, (uint32_t)node);
+        if (!settled) nodes[count++] = node;
     }
-    
-    return NULL;
+    qsort(nodes, count, sizeof(int32_t), compare_nodes);
+    size_t unique = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (unique == 0 || nodes[unique - 1] != nodes[i]) nodes[unique++] = nodes[i];
+    }
+    return unique;
 }
 
-static CellHashEntry* hash_table_insert(CellHashTable* table, SylvesCell cell) {
-    size_t index = cell_hash(cell) % table->bucket_count;
-    
-    // Check if already exists
-    CellHashEntry* existing = hash_table_find(table, cell);
-    if (existing) return existing;
-    
-    // Create new entry
-    CellHashEntry* entry = (CellHashEntry*)sylves_alloc(sizeof(CellHashEntry));
-    if (!entry) return NULL;
-    
-    entry->cell = cell;
-    entry->distance = FLT_MAX;
-    entry->has_step = false;
-    entry->next = table->buckets[index];
-    table->buckets[index] = entry;
-    table->entry_count++;
+void sylves_path_dijkstra_expand(SylvesPathfindingContext* ctx, SylvesGrid* grid,
+                                 const SylvesCell* targets, size_t target_count, float max_range,
+                                 SylvesStepLengthFunc step_lengths, void* user_data) {
+    SylvesPathNodeMap* visited = &ctx->nodes;
+    SylvesRadixHeap* open_set = ctx->open_radix;
+    
+    int32_t stack_targets[16];
+    int32_t* target_nodes = stack_targets;
+    size_t pending = 0;
+    if (targets && target_count > 0) {
+        if (target_count > sizeof(stack_targets) / sizeof(stack_targets[0])) {
+            target_nodes = (int32_t*)sylves_alloc(sizeof(int32_t) * target_count);
+            if (!target_nodes) return;
+        }
+        pending = pending_targets(ctx, targets, target_count, target_nodes);
+        if (pending == 0) {
+            if (target_nodes != stack_targets) sylves_free(target_nodes);
+            return;
+        }
+    }
+    size_t target_total = pending;
     
-    // TODO: Resize table if load factor gets too high
+    // Each open node has one entry whose key is lowered in place, so no pop is stale
+    float current_dist;
+    while (sylves_radix_heap_peek_key(open_set, &current_dist)) {
+        // Check if we've exceeded max range
+        if (current_dist > max_range) {
+            break;
+        }
+        
+        uint32_t handle;
+        sylves_radix_heap_pop(open_set, &handle, NULL);
+        int32_t current_node = (int32_t)handle;
+        SylvesCell current = sylves_path_map_cell(visited, current_node);
+        float distance = sylves_path_map_g(visited, current_node);
+        
+        // Stop once the last target is settled, leaving it open so a later run expands it
+        if (pending > 0 &&
+            bsearch(&current_node, target_nodes, target_total, sizeof(int32_t), compare_nodes) &&
+            --pending == 0) {
+            sylves_radix_heap_push(open_set, handle, current_dist);
+            break;
+        }
+        
+        // Explore neighbors
+        const SylvesCellType* ct = sylves_grid_get_cell_type(grid, current);
+        if (!ct) {
+            continue;
+        }
+        int max_dirs_i = sylves_cell_type_get_dir_count(ct);
+        if (max_dirs_i <= 0) {
+            continue;
+        }
+        size_t max_dirs = (size_t)max_dirs_i;
+        SylvesCellDir stack_dirs[16];
+        SylvesCellDir* dirs_buf = stack_dirs;
+        bool heap_dirs = false;
+        if (max_dirs > (sizeof(stack_dirs) / sizeof(stack_dirs[0]))) {
+            dirs_buf = (SylvesCellDir*)sylves_alloc(sizeof(SylvesCellDir) * max_dirs);
+            if (!dirs_buf) {
+                continue;
+            }
+            heap_dirs = true;
+        }
+        int dir_count_i = sylves_grid_get_cell_dirs(grid, current, dirs_buf, max_dirs);
+        if (dir_count_i < 0) {
+            if (heap_dirs) sylves_free(dirs_buf);
+            continue;
+        }
+        size_t dir_count = (size_t)dir_count_i;
+        
+        for (size_t i = 0; i < dir_count; i++) {
+            SylvesStep step;
+            SylvesError err = sylves_step_create(
+                grid, current, dirs_buf[i], 
+                step_lengths, user_data, &step);
+            
+            if (err != SYLVES_SUCCESS) continue;
+            
+            // Check if step is valid (non-negative length)
+            if (step.length < 0) continue;
+            
+            float tentative_dist = distance + step.length;
+            
+            // Check if within max range
+            if (tentative_dist > max_range) continue;
+            
+            SylvesCell neighbor = step.dest;
+            
+            // Get or create neighbor entry
+            int32_t neighbor_node = sylves_path_map_insert(visited, neighbor);
+            if (neighbor_node < 0) continue;
+            
+            // Check if this path is better
+            if (tentative_dist < sylves_path_map_g(visited, neighbor_node)) {
+                sylves_path_map_set_score(visited, neighbor_node, tentative_dist, tentative_dist);
+                sylves_path_map_set_step(visited, neighbor_node, &step);
+                
+                // Add to open set, or move its entry to a lower bucket
+                sylves_radix_heap_push(open_set, (uint32_t)neighbor_node, tentative_dist);
+            }
+        }
+        
+        if (heap_dirs) sylves_free(dirs_buf);
+    }
     
-    return entry;
+    if (target_nodes != stack_targets) sylves_free(target_nodes);
 }
 
 /* Dijkstra implementation */
@@ -130,34 +190,32 @@ SylvesDijkstraPathfinding* sylves_dijkstra_create(
     SylvesStepLengthFunc step_lengths,
     void* user_data) {
     
-    if (!grid) return NULL;
+    return sylves_dijkstra_create_multi_source(grid, &src, 1, step_lengths, user_data);
+}
+
+SylvesDijkstraPathfinding* sylves_dijkstra_create_multi_source(
+    SylvesGrid* grid,
+    const SylvesCell* sources,
+    size_t source_count,
+    SylvesStepLengthFunc step_lengths,
+    void* user_data) {
+    
+    if (!grid || !sources || source_count == 0) return NULL;
     
     SylvesDijkstraPathfinding* dijkstra = (SylvesDijkstraPathfinding*)sylves_alloc(sizeof(SylvesDijkstraPathfinding));
     if (!dijkstra) return NULL;
     
     dijkstra->grid = grid;
-    dijkstra->src = src;
+    dijkstra->src = sources[0];
     dijkstra->step_lengths = step_lengths ? step_lengths : default_step_length;
     dijkstra->user_data = user_data;
     
-    dijkstra->visited = hash_table_create(HASH_TABLE_INITIAL_SIZE);
-    dijkstra->open_set = sylves_heap_create(16);
-    
-    if (!dijkstra->visited || !dijkstra->open_set) {
-        hash_table_destroy(dijkstra->visited);
-        sylves_heap_destroy(dijkstra->open_set);
+    if (!sylves_path_context_init(&dijkstra->search, 0)) {
         sylves_free(dijkstra);
         return NULL;
     }
     
-    // Initialize source cell
-    CellHashEntry* src_entry = hash_table_insert(dijkstra->visited, src);
-    if (src_entry) {
-        src_entry->distance = 0.0f;
-        
-        // Add to open set
-        sylves_heap_insert(dijkstra->open_set, src_entry, 0.0f);
-    }
+    sylves_path_dijkstra_seed(&dijkstra->search, grid, sources, source_count);
     
     return dijkstra;
 }
@@ -165,8 +223,7 @@ SylvesDijkstraPathfinding* sylves_dijkstra_create(
 void sylves_dijkstra_destroy(SylvesDijkstraPathfinding* dijkstra) {
     if (!dijkstra) return;
     
-    hash_table_destroy(dijkstra->visited);
-    sylves_heap_destroy(dijkstra->open_set);
+    sylves_path_context_release(&dijkstra->search);
     sylves_free(dijkstra);
 }
 
@@ -175,81 +232,41 @@ void sylves_dijkstra_run(
     const SylvesCell* target,
     float max_range) {
     
+    sylves_dijkstra_run_targets(dijkstra, target, target ? 1 : 0, max_range);
+}
+
+void sylves_dijkstra_run_targets(
+    SylvesDijkstraPathfinding* dijkstra,
+    const SylvesCell* targets,
+    size_t target_count,
+    float max_range) {
+    
     if (!dijkstra) return;
     
-    while (!sylves_heap_is_empty(dijkstra->open_set)) {
-        float current_dist;
-        if (!sylves_heap_peek_key(dijkstra->open_set, &current_dist)) {
-            break;
-        }
-        
-        // Check if we've exceeded max range
-        if (current_dist > max_range) {
-            break;
-        }
-        
-        CellHashEntry* current_entry = (CellHashEntry*)sylves_heap_pop(dijkstra->open_set);
-        if (!current_entry) break;
-        
-        SylvesCell current = current_entry->cell;
-        float distance = current_entry->distance;
-        
-        // Check if we've reached the target
-        if (target && sylves_cell_equals(current, *target)) {
-            break;
-        }
-        
-        // Skip if this is a redundant entry (we've already visited with lower distance)
-        if (distance < current_dist) {
-            continue;
-        }
-        
-        // Explore neighbors
-        size_t dir_count = 0;
-        SylvesCellDir dirs_buf[16];
-        int got = sylves_grid_get_cell_dirs(dijkstra->grid, current, dirs_buf, 16);
-        if (got <= 0) {
-            continue;
-        }
-        dir_count = (size_t)got;
-        
-        for (size_t i = 0; i < dir_count; i++) {
-            SylvesStep step;
-            SylvesError err = sylves_step_create(
-                dijkstra->grid, current, dirs_buf[i], 
-                dijkstra->step_lengths, dijkstra->user_data, &step);
-            
-            if (err != SYLVES_SUCCESS) continue;
-            
-            // Check if step is valid (non-negative length)
-            if (step.length < 0) continue;
-            
-            float tentative_dist = distance + step.length;
-            
-            // Check if within max range
-            if (tentative_dist > max_range) continue;
-            
-            SylvesCell neighbor = step.dest;
-            
-            // Get or create neighbor entry
-            CellHashEntry* neighbor_entry = hash_table_find(dijkstra->visited, neighbor);
-            if (!neighbor_entry) {
-                neighbor_entry = hash_table_insert(dijkstra->visited, neighbor);
-                if (!neighbor_entry) continue;
-            }
-            
-            // Check if this path is better
-            if (tentative_dist < neighbor_entry->distance) {
-                neighbor_entry->distance = tentative_dist;
-                neighbor_entry->step = step;
-                neighbor_entry->has_step = true;
-                
-                // Add to open set
-                sylves_heap_insert(dijkstra->open_set, neighbor_entry, tentative_dist);
-            }
-        }
-        
+    sylves_path_dijkstra_expand(&dijkstra->search, dijkstra->grid, targets, target_count, max_range,
+                                dijkstra->step_lengths, dijkstra->user_data);
+}
+
+typedef struct {
+    const SylvesPathNodeMap* map;
+    SylvesCell* cells;
+    float* distances;
+    size_t max_count;
+    size_t count;
+    bool fill;
+} DistanceCollector;
+
+static bool collect_distance(int32_t node, void* user_data) {
+    DistanceCollector* collector = (DistanceCollector*)user_data;
+    float g = sylves_path_map_g(collector->map, node);
+    if (g == FLT_MAX) return true;
+    if (collector->fill) {
+        if (collector->count >= collector->max_count) return false;
+        collector->cells[collector->count] = sylves_path_map_cell(collector->map, node);
+        collector->distances[collector->count] = g;
     }
+    collector->count++;
+    return true;
 }
 
 SylvesError sylves_dijkstra_get_distances(
@@ -262,81 +279,26 @@ SylvesError sylves_dijkstra_get_distances(
         return SYLVES_ERROR_INVALID_ARGUMENT;
     }
     
-    size_t max_count = *count;
-    size_t actual_count = 0;
+    DistanceCollector collector;
+    collector.map = &dijkstra->search.nodes;
+    collector.cells = cells;
+    collector.distances = distances;
+    collector.max_count = *count;
+    collector.count = 0;
+    collector.fill = cells && distances && *count > 0;
+    sylves_path_map_visit(collector.map, collect_distance, &collector);
     
-    // If output arrays are provided, fill them
-    if (cells && distances && max_count > 0) {
-        // Iterate through all visited cells
-        for (size_t i = 0; i < dijkstra->visited->bucket_count && actual_count < max_count; i++) {
-            CellHashEntry* entry = dijkstra->visited->buckets[i];
-            while (entry && actual_count < max_count) {
-                if (entry->distance < FLT_MAX) {
-                    cells[actual_count] = entry->cell;
-                    distances[actual_count] = entry->distance;
-                    actual_count++;
-                }
-                entry = entry->next;
-            }
-        }
-    } else {
-        // Just count the reachable cells
-        for (size_t i = 0; i < dijkstra->visited->bucket_count; i++) {
-            CellHashEntry* entry = dijkstra->visited->buckets[i];
-            while (entry) {
-                if (entry->distance < FLT_MAX) {
-                    actual_count++;
-                }
-                entry = entry->next;
-            }
-        }
-    }
-    
-    *count = actual_count;
+    *count = collector.count;
     return SYLVES_SUCCESS;
 }
 
 SylvesCellPath* sylves_dijkstra_extract_path(SylvesDijkstraPathfinding* dijkstra, SylvesCell target) {
     if (!dijkstra) return NULL;
     
-    // Check if we reached the target
-    CellHashEntry* target_entry = hash_table_find(dijkstra->visited, target);
-    if (!target_entry || target_entry->distance == FLT_MAX) {
-        // Check if target is the source
-        if (sylves_cell_equals(target, dijkstra->src)) {
-            return sylves_cell_path_create(NULL, 0);
-        }
-        return NULL;
-    }
-    
-    // Count steps
-    size_t step_count = 0;
-    SylvesCell current = target;
-    while (!sylves_cell_equals(current, dijkstra->src)) {
-        CellHashEntry* entry = hash_table_find(dijkstra->visited, current);
-        if (!entry || !entry->has_step) break;
-        step_count++;
-        current = entry->step.src;
+    SylvesCellPath* path = sylves_path_map_extract(&dijkstra->search.nodes, target);
+    if (!path && sylves_cell_equals(target, dijkstra->src)) {
+        return sylves_cell_path_create(NULL, 0);
     }
-    
-    if (!sylves_cell_equals(current, dijkstra->src)) {
-        return NULL; // Path reconstruction failed
-    }
-    
-    // Build path
-    SylvesStep* steps = (SylvesStep*)sylves_alloc(sizeof(SylvesStep) * step_count);
-    if (!steps) return NULL;
-    
-    current = target;
-    for (size_t i = step_count; i > 0; i--) {
-        CellHashEntry* entry = hash_table_find(dijkstra->visited, current);
-        steps[i - 1] = entry->step;
-        current = entry->step.src;
-    }
-    
-    SylvesCellPath* path = sylves_cell_path_create(steps, step_count);
-    sylves_free(steps);
-    
     return path;
 }
 
@@ -0,0 +1,319 @@
+/**
+ * @file dstar_lite_pathfinding.c
+ * @brief D* Lite incremental replanning
+ *
+ * The search runs backwards from the goal. Every reached cell has g, its
+ * settled distance to the goal, and rhs, a one-step lookahead over its
+ * successors; both live in the shared node map as g and f. Cells where
+ * they differ are queued by min(g, rhs) plus the heuristic to the start
+ * plus km, the heuristic distance the start has moved since the search
+ * began, which keeps older keys valid lower bounds without requeueing.
+ *
+ * Keys are the first D* Lite key only. Where two differ only in the
+ * second (min(g, rhs) alone), the cell nearer the goal is popped in
+ * either order, which costs an expansion at worst, not correctness.
+ */
+
+#include "sylves/pathfinding.h"
+#include "sylves/memory.h"
+#include "sylves/errors.h"
+#include "sylves/cell.h"
+#include "sylves/grid.h"
+#include "sylves/cell_type.h"
+#include "internal/path_search.h"
+#include <string.h>
+#include <float.h>
+
+/* D* Lite context */
+struct SylvesDStarLite {
+    SylvesGrid* grid;
+    SylvesCell start;
+    SylvesCell goal;
+    SylvesCell last_start;          /* start when km was last raised */
+    float km;
+    SylvesIsAccessibleFunc is_accessible;
+    SylvesStepLengthFunc step_lengths;
+    SylvesCellDistanceFunc heuristic;
+    void* user_data;
+
+    SylvesPathfindingContext search;    /* g in g, rhs in f; open_set holds inconsistent cells */
+    size_t expansions;
+    bool out_of_memory;
+};
+
+/* Fill dirs for cell, spilling to the heap past the stack buffer; returns the count or -1 */
+static int get_dirs(SylvesGrid* grid, SylvesCell cell, SylvesCellDir* stack_dirs, size_t stack_count,
+                    SylvesCellDir** dirs) {
+    *dirs = stack_dirs;
+    const SylvesCellType* ct = sylves_grid_get_cell_type(grid, cell);
+    if (!ct) return -1;
+    int max_dirs = sylves_cell_type_get_dir_count(ct);
+    if (max_dirs <= 0) return -1;
+    if ((size_t)max_dirs > stack_count) {
+        *dirs = (SylvesCellDir*)sylves_alloc(sizeof(SylvesCellDir) * (size_t)max_dirs);
+        if (!*dirs) return -1;
+    }
+    int count = sylves_grid_get_cell_dirs(grid, cell, *dirs, (size_t)max_dirs);
+    if (count < 0 && *dirs != stack_dirs) {
+        sylves_free(*dirs);
+        *dirs = stack_dirs;
+    }
+    return count;
+}
+
+/* Cost of a step, FLT_MAX when it is blocked */
+static float step_cost(const SylvesDStarLite* dstar, const SylvesStep* step) {
+    if (dstar->is_accessible && !dstar->is_accessible(step->dest, dstar->user_data)) return FLT_MAX;
+    float length = dstar->step_lengths ? dstar->step_lengths(step, dstar->user_data) : 1.0f;
+    return length < 0 ? FLT_MAX : length;
+}
+
+static inline float add_cost(float cost, float g) {
+    return (cost == FLT_MAX || g == FLT_MAX) ? FLT_MAX : cost + g;
+}
+
+static inline float node_g(const SylvesDStarLite* dstar, int32_t node) {
+    return sylves_path_map_g(&dstar->search.nodes, node);
+}
+
+static inline float node_rhs(const SylvesDStarLite* dstar, int32_t node) {
+    return sylves_path_map_f(&dstar->search.nodes, node);
+}
+
+static float node_key(const SylvesDStarLite* dstar, int32_t node) {
+    float g = node_g(dstar, node), rhs = node_rhs(dstar, node);
+    float k = g < rhs ? g : rhs;
+    SylvesCell cell = sylves_path_map_cell(&dstar->search.nodes, node);
+    float h = dstar->heuristic ? dstar->heuristic(dstar->start, cell, dstar->user_data) : 0.0f;
+    return k + h + dstar->km;
+}
+
+/* Queue the cell if g and rhs disagree, otherwise make sure it is out of the queue */
+static void update_vertex(SylvesDStarLite* dstar, int32_t node) {
+    if (node_g(dstar, node) != node_rhs(dstar, node)) {
+        if (!sylves_indexed_heap_update(dstar->search.open_set, (uint32_t)node, node_key(dstar, node))) {
+            dstar->out_of_memory = true;
+        }
+    } else {
+        sylves_indexed_heap_remove(dstar->search.open_set, (uint32_t)node);
+    }
+}
+
+/* Cheapest step plus g over the successors of cell; FLT_MAX if none leads anywhere */
+static float best_successor(const SylvesDStarLite* dstar, SylvesCell cell, SylvesStep* best_step) {
+    SylvesCellDir stack_dirs[16];
+    SylvesCellDir* dirs;
+    int dir_count = get_dirs(dstar->grid, cell, stack_dirs, 16, &dirs);
+    float best = FLT_MAX;
+    for (int i = 0; i < dir_count; i++) {
+        SylvesStep step;
+        if (sylves_step_create(dstar->grid, cell, dirs[i], NULL, NULL, &step) != SYLVES_SUCCESS) continue;
+        int32_t next = sylves_path_map_find(&dstar->search.nodes, step.dest);
+        if (next < 0) continue;
+        float cost = step_cost(dstar, &step);
+        float total = add_cost(cost, node_g(dstar, next));
+        if (total < best) {
+            best = total;
+            if (best_step) {
+                *best_step = step;
+                best_step->length = cost;
+            }
+        }
+    }
+    if (dirs != stack_dirs) sylves_free(dirs);
+    return best;
+}
+
+/* Recompute rhs of a cell from its successors and requeue it */
+static void refresh(SylvesDStarLite* dstar, int32_t node) {
+    SylvesCell cell = sylves_path_map_cell(&dstar->search.nodes, node);
+    if (!sylves_cell_equals(cell, dstar->goal)) {
+        sylves_path_map_set_score(&dstar->search.nodes, node, node_g(dstar, node),
+                                  best_successor(dstar, cell, NULL));
+    }
+    update_vertex(dstar, node);
+}
+
+/*
+ * Visit every predecessor s of u with the cost of its step into u.
+ * Predecessors are u's neighbours, reached back through inverse dirs.
+ */
+static void expand(SylvesDStarLite* dstar, int32_t u, float g_old) {
+    SylvesCell cell = sylves_path_map_cell(&dstar->search.nodes, u);
+    float g_u = node_g(dstar, u);
+    bool lowered = g_u != FLT_MAX;
+
+    SylvesCellDir stack_dirs[16];
+    SylvesCellDir* dirs;
+    int dir_count = get_dirs(dstar->grid, cell, stack_dirs, 16, &dirs);
+    for (int i = 0; i < dir_count; i++) {
+        SylvesStep out, in;
+        if (sylves_step_create(dstar->grid, cell, dirs[i], NULL, NULL, &out) != SYLVES_SUCCESS) continue;
+        if (sylves_step_create(dstar->grid, out.dest, out.inverse_dir, NULL, NULL, &in) != SYLVES_SUCCESS ||
+            !sylves_cell_equals(in.dest, cell)) continue;
+        if (sylves_cell_equals(out.dest, dstar->goal)) continue;
+
+        int32_t s = sylves_path_map_insert(&dstar->search.nodes, out.dest);
+        if (s < 0) {
+            dstar->out_of_memory = true;
+            continue;
+        }
+        float through_u = add_cost(step_cost(dstar, &in), lowered ? g_u : g_old);
+        if (lowered) {
+            // u's distance settled lower: s may now route through u
+            if (through_u < node_rhs(dstar, s)) {
+                sylves_path_map_set_score(&dstar->search.nodes, s, node_g(dstar, s), through_u);
+                update_vertex(dstar, s);
+            }
+        } else if (through_u != FLT_MAX && node_rhs(dstar, s) == through_u) {
+            // u's distance was raised and s relied on it
+            refresh(dstar, s);
+        }
+    }
+    if (dirs != stack_dirs) sylves_free(dirs);
+    if (!lowered) refresh(dstar, u);
+}
+
+/* D* Lite implementation */
+
+SylvesDStarLite* sylves_dstar_create(
+    SylvesGrid* grid,
+    SylvesCell start,
+    SylvesCell goal,
+    SylvesIsAccessibleFunc is_accessible,
+    SylvesStepLengthFunc step_lengths,
+    SylvesCellDistanceFunc heuristic,
+    void* user_data) {
+
+    if (!grid) return NULL;
+
+    SylvesDStarLite* dstar = (SylvesDStarLite*)sylves_calloc(1, sizeof(SylvesDStarLite));
+    if (!dstar) return NULL;
+
+    dstar->grid = grid;
+    dstar->start = start;
+    dstar->goal = goal;
+    dstar->last_start = start;
+    dstar->is_accessible = is_accessible;
+    dstar->step_lengths = step_lengths;
+    dstar->heuristic = heuristic;
+    dstar->user_data = user_data;
+
+    if (!sylves_path_context_init(&dstar->search, 0)) {
+        sylves_free(dstar);
+        return NULL;
+    }
+    sylves_path_map_bind(&dstar->search.nodes, grid);
+
+    int32_t goal_node = sylves_path_map_insert(&dstar->search.nodes, goal);
+    if (goal_node < 0) {
+        sylves_dstar_destroy(dstar);
+        return NULL;
+    }
+    sylves_path_map_set_score(&dstar->search.nodes, goal_node, FLT_MAX, 0.0f);
+    update_vertex(dstar, goal_node);
+    if (dstar->out_of_memory) {
+        sylves_dstar_destroy(dstar);
+        return NULL;
+    }
+    return dstar;
+}
+
+void sylves_dstar_destroy(SylvesDStarLite* dstar) {
+    if (!dstar) return;
+    sylves_path_context_release(&dstar->search);
+    sylves_free(dstar);
+}
+
+SylvesError sylves_dstar_compute(SylvesDStarLite* dstar) {
+    if (!dstar) return SYLVES_ERROR_INVALID_ARGUMENT;
+
+    int32_t start = sylves_path_map_insert(&dstar->search.nodes, dstar->start);
+    if (start < 0) return SYLVES_ERROR_OUT_OF_MEMORY;
+
+    SylvesIndexedHeap* open_set = dstar->search.open_set;
+    uint32_t handle;
+    float k_old;
+    while (!dstar->out_of_memory && sylves_indexed_heap_pop(open_set, &handle, &k_old)) {
+        // Done once nothing queued can beat the start and the start is consistent
+        float g_start = node_g(dstar, start), rhs_start = node_rhs(dstar, start);
+        float k_start = (g_start < rhs_start ? g_start : rhs_start) + dstar->km;
+        if (k_old > k_start && g_start == rhs_start) {
+            sylves_indexed_heap_push(open_set, handle, k_old);
+            break;
+        }
+
+        int32_t u = (int32_t)handle;
+        float k_new = node_key(dstar, u);
+        if (k_old < k_new) {
+            // Queued before the start moved; requeue under its current key
+            if (!sylves_indexed_heap_push(open_set, handle, k_new)) dstar->out_of_memory = true;
+            continue;
+        }
+
+        dstar->expansions++;
+        float g_old = node_g(dstar, u), rhs = node_rhs(dstar, u);
+        sylves_path_map_set_score(&dstar->search.nodes, u, g_old > rhs ? rhs : FLT_MAX, rhs);
+        expand(dstar, u, g_old);
+    }
+
+    if (dstar->out_of_memory) return SYLVES_ERROR_OUT_OF_MEMORY;
+    return node_g(dstar, start) == FLT_MAX ? SYLVES_ERROR_PATH_NOT_FOUND : SYLVES_SUCCESS;
+}
+
+SylvesCellPath* sylves_dstar_extract_path(SylvesDStarLite* dstar) {
+    if (!dstar) return NULL;
+    int32_t start = sylves_path_map_find(&dstar->search.nodes, dstar->start);
+    if (start < 0 || node_g(dstar, start) == FLT_MAX) return NULL;
+
+    // Each step goes downhill in g; the node count bounds walks along zero-length steps
+    size_t limit = dstar->search.nodes.dense_grid ? (size_t)sylves_grid_get_index_count(dstar->grid)
+                                                  : dstar->search.nodes.node_count;
+    SylvesStep* steps = NULL;
+    size_t count = 0, capacity = 0;
+    SylvesCell cell = dstar->start;
+    while (!sylves_cell_equals(cell, dstar->goal)) {
+        if (count == capacity) {
+            capacity = capacity ? capacity * 2 : 32;
+            SylvesStep* grown = (SylvesStep*)sylves_realloc(steps, sizeof(SylvesStep) * capacity);
+            if (!grown) break;
+            steps = grown;
+        }
+        if (count >= limit || best_successor(dstar, cell, &steps[count]) == FLT_MAX) break;
+        cell = steps[count++].dest;
+    }
+
+    SylvesCellPath* path = sylves_cell_equals(cell, dstar->goal) ? sylves_cell_path_create(steps, count) : NULL;
+    sylves_free(steps);
+    return path;
+}
+
+void sylves_dstar_move_start(SylvesDStarLite* dstar, SylvesCell start) {
+    if (!dstar) return;
+    if (dstar->heuristic) {
+        dstar->km += dstar->heuristic(dstar->last_start, start, dstar->user_data);
+    }
+    dstar->last_start = start;
+    dstar->start = start;
+}
+
+SylvesError sylves_dstar_notify_cell_changed(SylvesDStarLite* dstar, SylvesCell cell) {
+    if (!dstar) return SYLVES_ERROR_INVALID_ARGUMENT;
+
+    // Only steps into cell change, so only its predecessors' lookaheads need redoing
+    SylvesCellDir stack_dirs[16];
+    SylvesCellDir* dirs;
+    int dir_count = get_dirs(dstar->grid, cell, stack_dirs, 16, &dirs);
+    for (int i = 0; i < dir_count; i++) {
+        SylvesCell neighbor;
+        if (!sylves_grid_try_move(dstar->grid, cell, dirs[i], &neighbor, NULL, NULL)) continue;
+        int32_t node = sylves_path_map_find(&dstar->search.nodes, neighbor);
+        if (node >= 0) refresh(dstar, node);
+    }
+    if (dirs != stack_dirs) sylves_free(dirs);
+    return dstar->out_of_memory ? SYLVES_ERROR_OUT_OF_MEMORY : SYLVES_SUCCESS;
+}
+
+size_t sylves_dstar_get_expansions(const SylvesDStarLite* dstar) {
+    return dstar ? dstar->expansions : 0;
+}
@@ -51,7 +51,8 @@ struct SylvesDualMeshBuilder {
     bool* is_far_vertex;      /* Whether vertex is at infinity */
     size_t face_count;
     
-    /* Halfedge connectivity */
+    /* Halfedge connectivity, allocated from the builder's arena */
+    SylvesArena* arena;
     HalfEdgeMap* halfedge_map;
     
     /* Temporary buffers */
@@ -64,15 +65,14 @@ static size_t halfedge_hash(HalfEdgeKey key, size_t bucket_count) {
     return ((size_t)key.face * 73856093u + (size_t)key.edge * 83492791u) % bucket_count;
 }
 
-/* Create halfedge map */
-static HalfEdgeMap* halfedge_map_create(size_t expected_size) {
-    HalfEdgeMap* map = (HalfEdgeMap*)sylves_alloc(sizeof(HalfEdgeMap));
+/* Create halfedge map; it lives until the arena is destroyed */
+static HalfEdgeMap* halfedge_map_create(SylvesArena* arena, size_t expected_size) {
+    HalfEdgeMap* map = (HalfEdgeMap*)sylves_arena_alloc(arena, sizeof(HalfEdgeMap));
     if (!map) return NULL;
     
-    map->bucket_count = expected_size * 2;
-    map->buckets = (HalfEdgeEntry**)sylves_calloc(map->bucket_count, sizeof(HalfEdgeEntry*));
+    map->bucket_count = expected_size * 2 > 0 ? expected_size * 2 : 1;
+    map->buckets = (HalfEdgeEntry**)sylves_arena_calloc(arena, map->bucket_count, sizeof(HalfEdgeEntry*));
     if (!map->buckets) {
-        sylves_free(map);
         return NULL;
     }
     
@@ -80,34 +80,19 @@ static HalfEdgeMap* halfedge_map_create(size_t expected_size) {
     return map;
 }
 
-/* Destroy halfedge map */
-static void halfedge_map_destroy(HalfEdgeMap* map) {
-    if (!map) return;
-    
-    for (size_t i = 0; i < map->bucket_count; i++) {
-        HalfEdgeEntry* entry = map->buckets[i];
-        while (entry) {
-            HalfEdgeEntry* next = entry->next;
-            sylves_free(entry);
-            entry = next;
-        }
-    }
-    
-    sylves_free(map->buckets);
-    sylves_free(map);
-}
-
 /* Add halfedge to map */
-static void halfedge_map_add(HalfEdgeMap* map, HalfEdgeKey key, HalfEdgeKey flip) {
+static bool halfedge_map_add(SylvesArena* arena, HalfEdgeMap* map, HalfEdgeKey key, HalfEdgeKey flip) {
     size_t hash = halfedge_hash(key, map->bucket_count);
     
-    HalfEdgeEntry* entry = (HalfEdgeEntry*)sylves_alloc(sizeof(HalfEdgeEntry));
+    HalfEdgeEntry* entry = (HalfEdgeEntry*)sylves_arena_alloc(arena, sizeof(HalfEdgeEntry));
+    if (!entry) return false;
     entry->key = key;
     entry->flip = flip;
     entry->has_flip = true;
     entry->next = map->buckets[hash];
     map->buckets[hash] = entry;
     map->entry_count++;
+    return true;
 }
 
 /* Find flip of halfedge */
@@ -129,15 +114,15 @@ static bool halfedge_map_find_flip(HalfEdgeMap* map, HalfEdgeKey key, HalfEdgeKe
     return false;
 }
 
-/* Build halfedge connectivity from mesh */
-static HalfEdgeMap* build_halfedge_map(const SylvesMeshDataEx* mesh) {
+/* Build halfedge connectivity from mesh; the edge table is scratch memory */
+static HalfEdgeMap* build_halfedge_map(SylvesArena* arena, const SylvesMeshDataEx* mesh) {
     /* Count approximate edges */
     size_t approx_edges = 0;
     for (size_t s = 0; s < mesh->submesh_count; s++) {
         approx_edges += mesh->submeshes[s].index_count;
     }
     
-    HalfEdgeMap* map = halfedge_map_create(approx_edges);
+    HalfEdgeMap* map = halfedge_map_create(arena, approx_edges);
     if (!map) return NULL;
     
     /* Build edge lookup table */
@@ -146,13 +131,22 @@ static HalfEdgeMap* build_halfedge_map(const SylvesMeshDataEx* mesh) {
     } EdgeKey;
     
     typedef struct EdgeRecord {
+        EdgeKey key;
         int face;
         int edge;
+        struct EdgeRecord* next;
     } EdgeRecord;
     
+    SylvesArena* scratch = sylves_get_thread_scratch_arena();
+    SylvesArenaMark mark = sylves_arena_push(scratch);
+    
     /* Simple hash table for edge lookups */
-    size_t edge_buckets = approx_edges * 2;
-    EdgeRecord** edge_table = (EdgeRecord**)sylves_calloc(edge_buckets, sizeof(EdgeRecord*));
+    size_t edge_buckets = map->bucket_count;
+    EdgeRecord** edge_table = (EdgeRecord**)sylves_arena_calloc(scratch, edge_buckets, sizeof(EdgeRecord*));
+    if (!edge_table) {
+        sylves_arena_pop(scratch, mark);
+        return NULL;
+    }
     
     /* Process all faces */
     int face_idx = 0;
@@ -174,39 +168,38 @@ static HalfEdgeMap* build_halfedge_map(const SylvesMeshDataEx* mesh) {
                 EdgeRecord* rec = edge_table[hash];
                 while (rec) {
                     /* Check if this completes a pair */
-                    if (rec->face != face_idx) {
+                    if (rec->key.v0 == key.v0 && rec->key.v1 == key.v1 && rec->face != face_idx) {
                         /* Found matching edge - add both halfedges */
                         HalfEdgeKey he1 = {rec->face, rec->edge};
                         HalfEdgeKey he2 = {face_idx, e};
-                        halfedge_map_add(map, he1, he2);
-                        halfedge_map_add(map, he2, he1);
+                        if (!halfedge_map_add(arena, map, he1, he2) ||
+                            !halfedge_map_add(arena, map, he2, he1)) {
+                            sylves_arena_pop(scratch, mark);
+                            return NULL;
+                        }
                         break;
                     }
-                    rec = (EdgeRecord*)((char*)rec + sizeof(EdgeRecord));
+                    rec = rec->next;
                 }
                 
                 /* Add new edge record */
-                EdgeRecord* new_rec = (EdgeRecord*)sylves_alloc(sizeof(EdgeRecord));
+                EdgeRecord* new_rec = (EdgeRecord*)sylves_arena_alloc(scratch, sizeof(EdgeRecord));
+                if (!new_rec) {
+                    sylves_arena_pop(scratch, mark);
+                    return NULL;
+                }
+                new_rec->key = key;
                 new_rec->face = face_idx;
                 new_rec->edge = e;
-                /* Simple linked list in hash bucket */
-                void* next = edge_table[hash];
+                new_rec->next = edge_table[hash];
                 edge_table[hash] = new_rec;
             }
             face_idx++;
         }
     }
     
-    /* Clean up edge table */
-    for (size_t i = 0; i < edge_buckets; i++) {
-        EdgeRecord* rec = edge_table[i];
-        while (rec) {
-            EdgeRecord* next = (EdgeRecord*)((char*)rec + sizeof(EdgeRecord));
-            sylves_free(rec);
-            rec = next;
-        }
-    }
-    sylves_free(edge_table);
+    /* Drop the edge table in one step */
+    sylves_arena_pop(scratch, mark);
     
     return map;
 }
@@ -245,7 +238,8 @@ SylvesDualMeshBuilder* sylves_dual_mesh_builder_create(const SylvesMeshDataEx* p
     builder->face_centroids = (int*)sylves_alloc(sizeof(int) * builder->face_count);
     builder->is_far_vertex = (bool*)sylves_alloc(sizeof(bool) * primal_mesh->vertex_count);
     
-    builder->halfedge_map = build_halfedge_map(primal_mesh);
+    builder->arena = sylves_arena_create(0);
+    builder->halfedge_map = builder->arena ? build_halfedge_map(builder->arena, primal_mesh) : NULL;
     
     builder->face_buffer = NULL;
     builder->face_buffer_capacity = 0;
@@ -272,7 +266,7 @@ void sylves_dual_mesh_builder_destroy(SylvesDualMeshBuilder* builder) {
     sylves_free(builder->mappings);
     sylves_free(builder->face_centroids);
     sylves_free(builder->is_far_vertex);
-    halfedge_map_destroy(builder->halfedge_map);
+    sylves_arena_destroy(builder->arena);
     sylves_free(builder->face_buffer);
     sylves_free(builder);
 }
@@ -363,14 +357,19 @@ SylvesError sylves_dual_mesh_builder_build(SylvesDualMeshBuilder* builder) {
         }
     }
     
-    /* Build dual faces around each vertex */
-    int* dual_indices = (int*)sylves_alloc(sizeof(int) * builder->face_count * 10);
+    /* Build dual faces around each vertex in scratch memory */
+    SylvesArena* scratch = sylves_get_thread_scratch_arena();
+    SylvesArenaMark mark = sylves_arena_push(scratch);
+    int* dual_indices = (int*)sylves_arena_alloc(scratch, sizeof(int) * builder->face_count * 10);
     size_t dual_index_count = 0;
     int dual_face_count = 0;
     
     /* Track visited halfedges */
-    size_t visited_size = builder->halfedge_map->entry_count;
-    bool* visited = (bool*)sylves_calloc(builder->face_count * 10, sizeof(bool));
+    bool* visited = (bool*)sylves_arena_calloc(scratch, builder->face_count * 10, sizeof(bool));
+    if (!dual_indices || !visited) {
+        sylves_arena_pop(scratch, mark);
+        return SYLVES_ERROR_OUT_OF_MEMORY;
+    }
     
     /* Process arcs first (boundary), then loops (interior) */
     for (int is_arc = 1; is_arc >= 0; is_arc--) {
@@ -398,8 +397,7 @@ SylvesError sylves_dual_mesh_builder_build(SylvesDualMeshBuilder* builder) {
                     
                     /* Walk around vertex */
                     if (!ensure_face_buffer(builder, 100)) {
-                        sylves_free(dual_indices);
-                        sylves_free(visited);
+                        sylves_arena_pop(scratch, mark);
                         return SYLVES_ERROR_OUT_OF_MEMORY;
                     }
                     
@@ -471,8 +469,7 @@ SylvesError sylves_dual_mesh_builder_build(SylvesDualMeshBuilder* builder) {
                         if (is_arc) {
                             /* Add start infinity vertex */
                             if (dual_index_count + face_vertex_count + 2 >= builder->face_count * 10) {
-                                sylves_free(dual_indices);
-                                sylves_free(visited);
+                                sylves_arena_pop(scratch, mark);
                                 return SYLVES_ERROR_OUT_OF_MEMORY;
                             }
                             
@@ -506,8 +503,7 @@ SylvesError sylves_dual_mesh_builder_build(SylvesDualMeshBuilder* builder) {
     sylves_mesh_data_ex_set_submesh(
         builder->dual_mesh, 0, dual_indices, dual_index_count, SYLVES_MESH_TOPOLOGY_NGON);
     
-    sylves_free(dual_indices);
-    sylves_free(visited);
+    sylves_arena_pop(scratch, mark);
     
     return SYLVES_SUCCESS;
 }
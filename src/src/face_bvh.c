@@ -0,0 +1,299 @@
+/**
+ * @file face_bvh.c
+ * @brief Bounding volume hierarchy over mesh face AABBs
+ *
+ * Nodes are stored depth-first in one array: an inner node's left child
+ * directly follows it and its right child index is kept in `start`.
+ * Leaves reference a contiguous run of the permuted face index array.
+ * Splits are at the centroid median of the widest axis, which keeps the
+ * tree balanced so traversal fits a small fixed stack.
+ */
+
+#include "internal/face_bvh.h"
+#include "sylves/memory.h"
+#include <math.h>
+#include <float.h>
+#include <stdlib.h>
+
+#define FACE_BVH_LEAF_SIZE 4
+#define FACE_BVH_STACK_SIZE 64
+#define FACE_BVH_EPSILON 1e-9
+
+typedef struct {
+    SylvesAabb bounds;
+    int start;  /* first slot in faces[] for leaves, right child for inner nodes */
+    int count;  /* number of faces for leaves, 0 for inner nodes */
+} FaceBvhNode;
+
+struct SylvesFaceBvh {
+    FaceBvhNode* nodes;
+    int node_count;
+    int* faces;              /* face indices, permuted so leaves are contiguous */
+    int leaf_face_count;
+    SylvesAabb* face_bounds; /* indexed by mesh face */
+    bool planar;
+};
+
+typedef struct {
+    SylvesFaceBvh* bvh;
+    const SylvesVector3* centroids;
+} FaceBvhBuilder;
+
+static double centroid_axis(const SylvesVector3* c, int axis) {
+    return axis == 0 ? c->x : (axis == 1 ? c->y : c->z);
+}
+
+static void aabb_grow(SylvesAabb* box, const SylvesAabb* other) {
+    if (other->min.x < box->min.x) box->min.x = other->min.x;
+    if (other->min.y < box->min.y) box->min.y = other->min.y;
+    if (other->min.z < box->min.z) box->min.z = other->min.z;
+    if (other->max.x > box->max.x) box->max.x = other->max.x;
+    if (other->max.y > box->max.y) box->max.y = other->max.y;
+    if (other->max.z > box->max.z) box->max.z = other->max.z;
+}
+
+/* Partially order faces[lo, hi) so the element at k has its sorted centroid */
+static void select_median(int* faces, int lo, int hi, int k, const SylvesVector3* centroids, int axis) {
+    while (hi - lo > 1) {
+        int mid = lo + (hi - lo) / 2;
+        double pivot = centroid_axis(&centroids[faces[mid]], axis);
+        int i = lo, j = hi - 1;
+        while (i <= j) {
+            while (centroid_axis(&centroids[faces[i]], axis) < pivot) i++;
+            while (centroid_axis(&centroids[faces[j]], axis) > pivot) j--;
+            if (i <= j) {
+                int tmp = faces[i]; faces[i] = faces[j]; faces[j] = tmp;
+                i++; j--;
+            }
+        }
+        if (k <= j) hi = j + 1;
+        else if (k >= i) lo = i;
+        else return;
+    }
+}
+
+static int build_node(FaceBvhBuilder* b, int lo, int hi) {
+    SylvesFaceBvh* bvh = b->bvh;
+    int index = bvh->node_count++;
+    FaceBvhNode* node = &bvh->nodes[index];
+
+    node->bounds = bvh->face_bounds[bvh->faces[lo]];
+    SylvesAabb centroid_bounds = { b->centroids[bvh->faces[lo]], b->centroids[bvh->faces[lo]] };
+    for (int i = lo + 1; i < hi; i++) {
+        int f = bvh->faces[i];
+        SylvesAabb c = { b->centroids[f], b->centroids[f] };
+        aabb_grow(&node->bounds, &bvh->face_bounds[f]);
+        aabb_grow(&centroid_bounds, &c);
+    }
+
+    if (hi - lo <= FACE_BVH_LEAF_SIZE) {
+        node->start = lo;
+        node->count = hi - lo;
+        return index;
+    }
+
+    double ex = centroid_bounds.max.x - centroid_bounds.min.x;
+    double ey = centroid_bounds.max.y - centroid_bounds.min.y;
+    double ez = centroid_bounds.max.z - centroid_bounds.min.z;
+    int axis = (ex >= ey && ex >= ez) ? 0 : (ey >= ez ? 1 : 2);
+
+    int mid = lo + (hi - lo) / 2;
+    select_median(bvh->faces, lo, hi, mid, b->centroids, axis);
+
+    node->count = 0;
+    build_node(b, lo, mid);
+    node->start = build_node(b, mid, hi);
+    return index;
+}
+
+SylvesFaceBvh* sylves_face_bvh_build(const SylvesMeshData* mesh) {
+    if (!mesh || !mesh->faces || !mesh->vertices || mesh->face_count == 0) {
+        return NULL;
+    }
+
+    SylvesFaceBvh* bvh = sylves_calloc(1, sizeof(SylvesFaceBvh));
+    if (!bvh) return NULL;
+
+    size_t n = mesh->face_count;
+    bvh->face_bounds = sylves_alloc(sizeof(SylvesAabb) * n);
+    bvh->faces = sylves_alloc(sizeof(int) * n);
+    SylvesVector3* centroids = sylves_alloc(sizeof(SylvesVector3) * n);
+    if (!bvh->face_bounds || !bvh->faces || !centroids) {
+        sylves_free(centroids);
+        sylves_face_bvh_destroy(bvh);
+        return NULL;
+    }
+
+    bvh->planar = true;
+    double plane_z = mesh->vertices[0].z;
+    for (size_t v = 1; v < mesh->vertex_count; v++) {
+        if (mesh->vertices[v].z != plane_z) {
+            bvh->planar = false;
+            break;
+        }
+    }
+
+    /* Unused face slots (vertex_count == 0) are left out of the tree, with empty bounds */
+    const SylvesAabb empty = { { DBL_MAX, DBL_MAX, DBL_MAX }, { -DBL_MAX, -DBL_MAX, -DBL_MAX } };
+    int used = 0;
+    for (size_t f = 0; f < n; f++) {
+        const SylvesMeshFace* face = &mesh->faces[f];
+        if (face->vertex_count <= 0 || !face->vertices) {
+            bvh->face_bounds[f] = empty;
+            continue;
+        }
+
+        SylvesVector3 p = mesh->vertices[face->vertices[0]];
+        SylvesAabb box = { p, p };
+        SylvesVector3 sum = p;
+        for (int i = 1; i < face->vertex_count; i++) {
+            p = mesh->vertices[face->vertices[i]];
+            SylvesAabb pb = { p, p };
+            aabb_grow(&box, &pb);
+            sum.x += p.x; sum.y += p.y; sum.z += p.z;
+        }
+        bvh->face_bounds[f] = box;
+        double inv = 1.0 / face->vertex_count;
+        centroids[f] = (SylvesVector3){ sum.x * inv, sum.y * inv, sum.z * inv };
+        bvh->faces[used++] = (int)f;
+    }
+
+    if (used == 0) {
+        sylves_free(centroids);
+        sylves_face_bvh_destroy(bvh);
+        return NULL;
+    }
+
+    bvh->leaf_face_count = used;
+    bvh->nodes = sylves_alloc(sizeof(FaceBvhNode) * (size_t)(2 * used - 1));
+    if (!bvh->nodes) {
+        sylves_free(centroids);
+        sylves_face_bvh_destroy(bvh);
+        return NULL;
+    }
+
+    FaceBvhBuilder builder = { bvh, centroids };
+    build_node(&builder, 0, used);
+    sylves_free(centroids);
+    return bvh;
+}
+
+void sylves_face_bvh_destroy(SylvesFaceBvh* bvh) {
+    if (!bvh) return;
+    sylves_free(bvh->nodes);
+    sylves_free(bvh->faces);
+    sylves_free(bvh->face_bounds);
+    sylves_free(bvh);
+}
+
+bool sylves_face_bvh_is_planar(const SylvesFaceBvh* bvh) {
+    return bvh && bvh->planar;
+}
+
+const SylvesAabb* sylves_face_bvh_get_face_aabb(const SylvesFaceBvh* bvh, int face) {
+    return bvh ? &bvh->face_bounds[face] : NULL;
+}
+
+static bool box_overlaps(const SylvesAabb* box, const SylvesVector3* min, const SylvesVector3* max,
+                         bool planar) {
+    if (box->min.x > max->x + FACE_BVH_EPSILON || box->max.x < min->x - FACE_BVH_EPSILON) return false;
+    if (box->min.y > max->y + FACE_BVH_EPSILON || box->max.y < min->y - FACE_BVH_EPSILON) return false;
+    if (planar) return true;
+    return box->min.z <= max->z + FACE_BVH_EPSILON && box->max.z >= min->z - FACE_BVH_EPSILON;
+}
+
+/* Slab test; planar trees only clip against the x and y slabs */
+static bool box_hit_by_ray(const SylvesAabb* box, const SylvesVector3* origin,
+                           const SylvesVector3* inv_dir, double max_distance, bool planar) {
+    double t0 = 0.0, t1 = max_distance;
+    const double o[3] = { origin->x, origin->y, origin->z };
+    const double inv[3] = { inv_dir->x, inv_dir->y, inv_dir->z };
+    const double lo[3] = { box->min.x, box->min.y, box->min.z };
+    const double hi[3] = { box->max.x, box->max.y, box->max.z };
+    int axes = planar ? 2 : 3;
+
+    for (int a = 0; a < axes; a++) {
+        if (isinf(inv[a])) {
+            if (o[a] < lo[a] - FACE_BVH_EPSILON || o[a] > hi[a] + FACE_BVH_EPSILON) return false;
+            continue;
+        }
+        double ta = (lo[a] - FACE_BVH_EPSILON - o[a]) * inv[a];
+        double tb = (hi[a] + FACE_BVH_EPSILON - o[a]) * inv[a];
+        if (ta > tb) { double t = ta; ta = tb; tb = t; }
+        if (ta > t0) t0 = ta;
+        if (tb < t1) t1 = tb;
+        if (t0 > t1) return false;
+    }
+    return true;
+}
+
+typedef enum {
+    FACE_BVH_QUERY_BOX,
+    FACE_BVH_QUERY_RAY
+} FaceBvhQueryKind;
+
+typedef struct {
+    FaceBvhQueryKind kind;
+    SylvesVector3 a;  /* box min or ray origin */
+    SylvesVector3 b;  /* box max or inverse ray direction */
+    double max_distance;
+} FaceBvhQuery;
+
+static bool query_accepts(const SylvesFaceBvh* bvh, const FaceBvhQuery* q, const SylvesAabb* box) {
+    if (q->kind == FACE_BVH_QUERY_BOX) {
+        return box_overlaps(box, &q->a, &q->b, bvh->planar);
+    }
+    return box_hit_by_ray(box, &q->a, &q->b, q->max_distance, bvh->planar);
+}
+
+static void run_query(const SylvesFaceBvh* bvh, const FaceBvhQuery* q,
+                      SylvesFaceBvhVisitor visit, void* user_data) {
+    if (!bvh || !visit) return;
+
+    int stack[FACE_BVH_STACK_SIZE];
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0) {
+        const FaceBvhNode* node = &bvh->nodes[stack[--top]];
+        if (!query_accepts(bvh, q, &node->bounds)) continue;
+
+        if (node->count > 0) {
+            for (int i = node->start; i < node->start + node->count; i++) {
+                int face = bvh->faces[i];
+                if (node->count > 1 && !query_accepts(bvh, q, &bvh->face_bounds[face])) continue;
+                if (!visit(face, user_data)) return;
+            }
+            continue;
+        }
+
+        int left = (int)(node - bvh->nodes) + 1;
+        /* Median splits bound the depth by log2(faces), far below the stack size */
+        stack[top++] = node->start;
+        stack[top++] = left;
+    }
+}
+
+void sylves_face_bvh_query_point(const SylvesFaceBvh* bvh, SylvesVector3 point,
+                                 SylvesFaceBvhVisitor visit, void* user_data) {
+    FaceBvhQuery q = { FACE_BVH_QUERY_BOX, point, point, 0.0 };
+    run_query(bvh, &q, visit, user_data);
+}
+
+void sylves_face_bvh_query_aabb(const SylvesFaceBvh* bvh, SylvesVector3 min, SylvesVector3 max,
+                                SylvesFaceBvhVisitor visit, void* user_data) {
+    FaceBvhQuery q = { FACE_BVH_QUERY_BOX, min, max, 0.0 };
+    run_query(bvh, &q, visit, user_data);
+}
+
+void sylves_face_bvh_query_ray(const SylvesFaceBvh* bvh, SylvesVector3 origin,
+                               SylvesVector3 direction, double max_distance,
+                               SylvesFaceBvhVisitor visit, void* user_data) {
+    SylvesVector3 inv = {
+        direction.x != 0.0 ? 1.0 / direction.x : INFINITY,
+        direction.y != 0.0 ? 1.0 / direction.y : INFINITY,
+        direction.z != 0.0 ? 1.0 / direction.z : INFINITY
+    };
+    FaceBvhQuery q = { FACE_BVH_QUERY_RAY, origin, inv, max_distance };
+    run_query(bvh, &q, visit, user_data);
+}
@@ -0,0 +1,456 @@
+/**
+ * @file flow_field.c
+ * @brief Multi-goal flow fields: parallel wavefront BFS and fast marching
+ *
+ * Both modes fill dense per-index arrays. BFS runs level by level as one
+ * thread pool task: each worker expands a slice of the frontier into its
+ * own buffer, then after a barrier copies it into the next frontier at an
+ * offset from the other workers' counts. Cells are claimed by swapping
+ * their level in from UINT32_MAX, so each joins exactly one frontier.
+ */
+
+#include "sylves/pathfinding.h"
+#include "sylves/memory.h"
+#include "sylves/errors.h"
+#include "sylves/cell.h"
+#include "sylves/grid.h"
+#include "sylves/square_grid.h"
+#include "internal/thread_pool.h"
+#include "internal/sync.h"
+#include <math.h>
+#include <float.h>
+#include <string.h>
+
+/* Largest neighbour count of any cell type */
+#define FLOW_MAX_NEIGHBOURS 16
+
+#define UNREACHED UINT32_MAX
+
+/* Fast marching cell states, kept in levels */
+enum { MARCH_FAR = 0, MARCH_TRIAL = 1, MARCH_KNOWN = 2 };
+
+struct SylvesFlowField {
+    SylvesGrid* grid;
+    int32_t count;
+    SylvesThreadPool* pool;
+
+    /* Bounded square grids index row by row, so neighbours are arithmetic */
+    bool lattice;
+    int min_x, min_y;
+    int32_t width;
+
+    /* Neighbour table for other grids */
+    int32_t* offsets;           /* count + 1 */
+    int32_t* neighbours;
+    uint8_t* neighbour_dirs;
+
+    float* distances;
+    uint8_t* directions;
+    uint8_t* open;
+    float* costs;
+    uint32_t* levels;           /* BFS level, or fast marching state */
+
+    int32_t* frontier[2];
+    int32_t* local[SYLVES_THREAD_POOL_MAX_WORKERS];
+    size_t local_count[SYLVES_THREAD_POOL_MAX_WORKERS];
+    size_t local_capacity[SYLVES_THREAD_POOL_MAX_WORKERS];
+
+    SylvesIndexedHeap* heap;    /* fast marching trial cells */
+};
+
+static inline int neighbours_of(const SylvesFlowField* field, int32_t i, int32_t* out, uint8_t* dirs) {
+    if (field->lattice) {
+        int32_t w = field->width;
+        int32_t x = i % w;
+        int count = 0;
+        if (x + 1 < w) { out[count] = i + 1; dirs[count++] = SYLVES_SQUARE_DIR_RIGHT; }
+        if (i + w < field->count) { out[count] = i + w; dirs[count++] = SYLVES_SQUARE_DIR_UP; }
+        if (x > 0) { out[count] = i - 1; dirs[count++] = SYLVES_SQUARE_DIR_LEFT; }
+        if (i >= w) { out[count] = i - w; dirs[count++] = SYLVES_SQUARE_DIR_DOWN; }
+        return count;
+    }
+    int begin = field->offsets[i], end = field->offsets[i + 1];
+    memcpy(out, field->neighbours + begin, sizeof(int32_t) * (size_t)(end - begin));
+    memcpy(dirs, field->neighbour_dirs + begin, (size_t)(end - begin));
+    return end - begin;
+}
+
+static inline SylvesCell cell_of(const SylvesFlowField* field, int32_t i) {
+    SylvesCell cell = { 0, 0, 0 };
+    if (field->lattice) {
+        cell.x = field->min_x + i % field->width;
+        cell.y = field->min_y + i / field->width;
+    } else {
+        sylves_grid_get_cell_by_index(field->grid, i, &cell);
+    }
+    return cell;
+}
+
+/* Indices of in-grid goals */
+static int32_t goal_index(const SylvesFlowField* field, SylvesCell goal) {
+    int index = sylves_grid_get_index(field->grid, goal);
+    return index >= 0 && index < field->count ? (int32_t)index : -1;
+}
+
+static inline void worker_range(int32_t count, int worker, int worker_count, int32_t* begin, int32_t* end) {
+    *begin = (int32_t)((int64_t)count * worker / worker_count);
+    *end = (int32_t)((int64_t)count * (worker + 1) / worker_count);
+}
+
+/* Topology */
+
+static bool detect_lattice(SylvesFlowField* field) {
+    if (sylves_grid_get_type(field->grid) != SYLVES_GRID_TYPE_SQUARE) return false;
+    SylvesCell first, last;
+    if (sylves_grid_get_cell_by_index(field->grid, 0, &first) != SYLVES_SUCCESS ||
+        sylves_grid_get_cell_by_index(field->grid, field->count - 1, &last) != SYLVES_SUCCESS) {
+        return false;
+    }
+    field->min_x = first.x;
+    field->min_y = first.y;
+    field->width = last.x - first.x + 1;
+    return field->width > 0 && field->count == field->width * (last.y - first.y + 1);
+}
+
+static bool build_neighbour_table(SylvesFlowField* field) {
+    size_t capacity = (size_t)field->count * 6;
+    field->offsets = (int32_t*)sylves_alloc(sizeof(int32_t) * ((size_t)field->count + 1));
+    field->neighbours = (int32_t*)sylves_alloc(sizeof(int32_t) * capacity);
+    field->neighbour_dirs = (uint8_t*)sylves_alloc(capacity);
+    if (!field->offsets || !field->neighbours || !field->neighbour_dirs) return false;
+
+    size_t used = 0;
+    for (int32_t i = 0; i < field->count; i++) {
+        field->offsets[i] = (int32_t)used;
+        SylvesCell cell;
+        if (sylves_grid_get_cell_by_index(field->grid, i, &cell) != SYLVES_SUCCESS) continue;
+        SylvesCellDir dirs[FLOW_MAX_NEIGHBOURS];
+        int dir_count = sylves_grid_get_cell_dirs(field->grid, cell, dirs, FLOW_MAX_NEIGHBOURS);
+        for (int d = 0; d < dir_count; d++) {
+            SylvesCell dest;
+            if (!sylves_grid_try_move(field->grid, cell, dirs[d], &dest, NULL, NULL)) continue;
+            int32_t j = goal_index(field, dest);
+            if (j < 0) continue;
+            if (used == capacity) {
+                capacity *= 2;
+                int32_t* neighbours = (int32_t*)sylves_realloc(field->neighbours, sizeof(int32_t) * capacity);
+                if (neighbours) field->neighbours = neighbours;
+                uint8_t* neighbour_dirs = (uint8_t*)sylves_realloc(field->neighbour_dirs, capacity);
+                if (neighbour_dirs) field->neighbour_dirs = neighbour_dirs;
+                if (!neighbours || !neighbour_dirs) return false;
+            }
+            field->neighbours[used] = j;
+            field->neighbour_dirs[used++] = (uint8_t)dirs[d];
+        }
+    }
+    field->offsets[field->count] = (int32_t)used;
+    return true;
+}
+
+/* Flow field implementation */
+
+SylvesFlowField* sylves_flow_field_create(SylvesGrid* grid, int thread_count) {
+    int count = grid ? sylves_grid_get_index_count(grid) : 0;
+    if (count <= 0) return NULL;
+
+    SylvesFlowField* field = (SylvesFlowField*)sylves_calloc(1, sizeof(SylvesFlowField));
+    if (!field) return NULL;
+    field->grid = grid;
+    field->count = count;
+    field->pool = sylves_thread_pool_create(thread_count);
+    field->distances = (float*)sylves_alloc(sizeof(float) * (size_t)count);
+    field->directions = (uint8_t*)sylves_alloc((size_t)count);
+    field->open = (uint8_t*)sylves_alloc((size_t)count);
+    field->levels = (uint32_t*)sylves_alloc(sizeof(uint32_t) * (size_t)count);
+    field->frontier[0] = (int32_t*)sylves_alloc(sizeof(int32_t) * (size_t)count);
+    field->frontier[1] = (int32_t*)sylves_alloc(sizeof(int32_t) * (size_t)count);
+    field->lattice = detect_lattice(field);
+
+    if (!field->pool || !field->distances || !field->directions || !field->open || !field->levels ||
+        !field->frontier[0] || !field->frontier[1] || (!field->lattice && !build_neighbour_table(field))) {
+        sylves_flow_field_destroy(field);
+        return NULL;
+    }
+    return field;
+}
+
+void sylves_flow_field_destroy(SylvesFlowField* field) {
+    if (!field) return;
+
+    sylves_thread_pool_destroy(field->pool);
+    sylves_free(field->offsets);
+    sylves_free(field->neighbours);
+    sylves_free(field->neighbour_dirs);
+    sylves_free(field->distances);
+    sylves_free(field->directions);
+    sylves_free(field->open);
+    sylves_free(field->costs);
+    sylves_free(field->levels);
+    sylves_free(field->frontier[0]);
+    sylves_free(field->frontier[1]);
+    for (int i = 0; i < SYLVES_THREAD_POOL_MAX_WORKERS; i++) {
+        sylves_free(field->local[i]);
+    }
+    sylves_indexed_heap_destroy(field->heap);
+    sylves_free(field);
+}
+
+/* Point every cell at its lowest neighbour; goals and unreached cells get no direction */
+static void assign_directions(SylvesFlowField* field, int32_t begin, int32_t end) {
+    int32_t next[FLOW_MAX_NEIGHBOURS];
+    uint8_t dirs[FLOW_MAX_NEIGHBOURS];
+    for (int32_t i = begin; i < end; i++) {
+        float best = field->distances[i];
+        uint8_t dir = SYLVES_FLOW_FIELD_NO_DIR;
+        if (best != FLT_MAX && best > 0.0f) {
+            int n = neighbours_of(field, i, next, dirs);
+            for (int k = 0; k < n; k++) {
+                if (field->distances[next[k]] < best) {
+                    best = field->distances[next[k]];
+                    dir = dirs[k];
+                }
+            }
+        }
+        field->directions[i] = dir;
+    }
+}
+
+/* Parallel wavefront BFS */
+
+typedef struct BfsTask {
+    SylvesFlowField* field;
+    const SylvesCell* goals;
+    size_t goal_count;
+    SylvesIsAccessibleFunc is_accessible;
+    void* user_data;
+    size_t frontier_size;
+    uint32_t failed;
+} BfsTask;
+
+static bool append_local(SylvesFlowField* field, int worker, int32_t index) {
+    if (field->local_count[worker] == field->local_capacity[worker]) {
+        size_t capacity = field->local_capacity[worker] ? field->local_capacity[worker] * 2 : 1024;
+        int32_t* grown = (int32_t*)sylves_realloc(field->local[worker], sizeof(int32_t) * capacity);
+        if (!grown) return false;
+        field->local[worker] = grown;
+        field->local_capacity[worker] = capacity;
+    }
+    field->local[worker][field->local_count[worker]++] = index;
+    return true;
+}
+
+static void bfs_task(int worker, int worker_count, void* user_data) {
+    BfsTask* task = (BfsTask*)user_data;
+    SylvesFlowField* field = task->field;
+    int32_t begin, end;
+
+    worker_range(field->count, worker, worker_count, &begin, &end);
+    for (int32_t i = begin; i < end; i++) {
+        field->open[i] = !task->is_accessible || task->is_accessible(cell_of(field, i), task->user_data);
+        field->levels[i] = UNREACHED;
+    }
+    sylves_thread_pool_barrier(field->pool, worker);
+
+    if (worker == 0) {
+        size_t size = 0;
+        for (size_t g = 0; g < task->goal_count; g++) {
+            int32_t index = goal_index(field, task->goals[g]);
+            if (index < 0 || !field->open[index] || field->levels[index] == 0) continue;
+            field->levels[index] = 0;
+            field->frontier[0][size++] = index;
+        }
+        task->frontier_size = size;
+    }
+    sylves_thread_pool_barrier(field->pool, worker);
+
+    int32_t next[FLOW_MAX_NEIGHBOURS];
+    uint8_t dirs[FLOW_MAX_NEIGHBOURS];
+    size_t size = task->frontier_size;
+    int current = 0;
+    for (uint32_t level = 1; size > 0; level++) {
+        const int32_t* frontier = field->frontier[current];
+        field->local_count[worker] = 0;
+        worker_range((int32_t)size, worker, worker_count, &begin, &end);
+        for (int32_t f = begin; f < end; f++) {
+            int n = neighbours_of(field, frontier[f], next, dirs);
+            for (int k = 0; k < n; k++) {
+                int32_t j = next[k];
+                if (!field->open[j] || sylves_atomic_load_u32(&field->levels[j]) != UNREACHED) continue;
+                if (!sylves_atomic_cas_u32(&field->levels[j], UNREACHED, level)) continue;
+                if (!append_local(field, worker, j)) sylves_atomic_store_u32_release(&task->failed, 1u);
+            }
+        }
+        sylves_thread_pool_barrier(field->pool, worker);
+
+        size_t offset = 0, total = 0;
+        for (int w = 0; w < worker_count; w++) {
+            if (w < worker) offset += field->local_count[w];
+            total += field->local_count[w];
+        }
+        if (field->local_count[worker] > 0) {
+            memcpy(field->frontier[current ^ 1] + offset, field->local[worker],
+                   sizeof(int32_t) * field->local_count[worker]);
+        }
+        sylves_thread_pool_barrier(field->pool, worker);
+        size = total;
+        current ^= 1;
+    }
+
+    worker_range(field->count, worker, worker_count, &begin, &end);
+    for (int32_t i = begin; i < end; i++) {
+        field->distances[i] = field->levels[i] == UNREACHED ? FLT_MAX : (float)field->levels[i];
+    }
+    sylves_thread_pool_barrier(field->pool, worker);
+    assign_directions(field, begin, end);
+}
+
+SylvesError sylves_flow_field_compute_bfs(
+    SylvesFlowField* field,
+    const SylvesCell* goals,
+    size_t goal_count,
+    SylvesIsAccessibleFunc is_accessible,
+    void* user_data) {
+
+    if (!field || (!goals && goal_count > 0)) return SYLVES_ERROR_INVALID_ARGUMENT;
+
+    BfsTask task = { field, goals, goal_count, is_accessible, user_data, 0, 0 };
+    sylves_thread_pool_run(field->pool, bfs_task, &task);
+    return task.failed ? SYLVES_ERROR_OUT_OF_MEMORY : SYLVES_SUCCESS;
+}
+
+/* Fast marching */
+
+typedef struct MarchTask {
+    SylvesFlowField* field;
+    SylvesCellCostFunc cell_costs;
+    void* user_data;
+    bool directions_only;
+} MarchTask;
+
+static void march_task(int worker, int worker_count, void* user_data) {
+    MarchTask* task = (MarchTask*)user_data;
+    SylvesFlowField* field = task->field;
+    int32_t begin, end;
+    worker_range(field->count, worker, worker_count, &begin, &end);
+
+    if (task->directions_only) {
+        assign_directions(field, begin, end);
+        return;
+    }
+    for (int32_t i = begin; i < end; i++) {
+        field->costs[i] = task->cell_costs ? task->cell_costs(cell_of(field, i), task->user_data) : 1.0f;
+        field->distances[i] = FLT_MAX;
+        field->levels[i] = MARCH_FAR;
+    }
+}
+
+/* Smallest known distance among neighbours of i along one lattice axis */
+static inline float axis_min(const SylvesFlowField* field, int32_t a, int32_t b) {
+    float ta = a >= 0 && field->levels[a] == MARCH_KNOWN ? field->distances[a] : FLT_MAX;
+    float tb = b >= 0 && field->levels[b] == MARCH_KNOWN ? field->distances[b] : FLT_MAX;
+    return ta < tb ? ta : tb;
+}
+
+/* First-order upwind solution of |grad T| = cost at a lattice cell */
+static float eikonal_update(const SylvesFlowField* field, int32_t i) {
+    int32_t w = field->width;
+    int32_t x = i % w;
+    float a = axis_min(field, x > 0 ? i - 1 : -1, x + 1 < w ? i + 1 : -1);
+    float b = axis_min(field, i >= w ? i - w : -1, i + w < field->count ? i + w : -1);
+    if (a > b) {
+        float t = a;
+        a = b;
+        b = t;
+    }
+    float f = field->costs[i];
+    if (b == FLT_MAX || b - a >= f) return a + f;
+    float d = b - a;
+    return 0.5f * (a + b + sqrtf(2.0f * f * f - d * d));
+}
+
+/* Dijkstra relaxation for grids without axes: steps cost the mean of both cells */
+static float graph_update(const SylvesFlowField* field, int32_t i) {
+    int32_t next[FLOW_MAX_NEIGHBOURS];
+    uint8_t dirs[FLOW_MAX_NEIGHBOURS];
+    int n = neighbours_of(field, i, next, dirs);
+    float best = FLT_MAX;
+    for (int k = 0; k < n; k++) {
+        int32_t j = next[k];
+        if (field->levels[j] != MARCH_KNOWN) continue;
+        float t = field->distances[j] + 0.5f * (field->costs[i] + field->costs[j]);
+        if (t < best) best = t;
+    }
+    return best;
+}
+
+SylvesError sylves_flow_field_compute_fast_marching(
+    SylvesFlowField* field,
+    const SylvesCell* goals,
+    size_t goal_count,
+    SylvesCellCostFunc cell_costs,
+    void* user_data) {
+
+    if (!field || (!goals && goal_count > 0)) return SYLVES_ERROR_INVALID_ARGUMENT;
+    if (!field->costs) {
+        field->costs = (float*)sylves_alloc(sizeof(float) * (size_t)field->count);
+        if (!field->costs) return SYLVES_ERROR_OUT_OF_MEMORY;
+    }
+    if (!field->heap) {
+        field->heap = sylves_indexed_heap_create(1024);
+        if (!field->heap) return SYLVES_ERROR_OUT_OF_MEMORY;
+    }
+
+    MarchTask task = { field, cell_costs, user_data, false };
+    sylves_thread_pool_run(field->pool, march_task, &task);
+
+    SylvesIndexedHeap* heap = field->heap;
+    sylves_indexed_heap_clear(heap);
+    for (size_t g = 0; g < goal_count; g++) {
+        int32_t index = goal_index(field, goals[g]);
+        if (index < 0 || field->costs[index] < 0) continue;
+        field->distances[index] = 0.0f;
+        field->levels[index] = MARCH_TRIAL;
+        if (!sylves_indexed_heap_push(heap, (uint32_t)index, 0.0f)) return SYLVES_ERROR_OUT_OF_MEMORY;
+    }
+
+    int32_t next[FLOW_MAX_NEIGHBOURS];
+    uint8_t dirs[FLOW_MAX_NEIGHBOURS];
+    uint32_t handle;
+    while (sylves_indexed_heap_pop(heap, &handle, NULL)) {
+        int32_t i = (int32_t)handle;
+        field->levels[i] = MARCH_KNOWN;
+        int n = neighbours_of(field, i, next, dirs);
+        for (int k = 0; k < n; k++) {
+            int32_t j = next[k];
+            if (field->levels[j] == MARCH_KNOWN || field->costs[j] < 0) continue;
+            float t = field->lattice ? eikonal_update(field, j) : graph_update(field, j);
+            if (t < field->distances[j]) {
+                field->distances[j] = t;
+                field->levels[j] = MARCH_TRIAL;
+                if (!sylves_indexed_heap_push(heap, (uint32_t)j, t)) return SYLVES_ERROR_OUT_OF_MEMORY;
+            }
+        }
+    }
+
+    task.directions_only = true;
+    sylves_thread_pool_run(field->pool, march_task, &task);
+    return SYLVES_SUCCESS;
+}
+
+/* Results */
+
+const float* sylves_flow_field_get_distances(const SylvesFlowField* field) {
+    return field ? field->distances : NULL;
+}
+
+const uint8_t* sylves_flow_field_get_directions(const SylvesFlowField* field) {
+    return field ? field->directions : NULL;
+}
+
+bool sylves_flow_field_get_direction(const SylvesFlowField* field, SylvesCell cell, SylvesCellDir* dir) {
+    if (!field || !dir) return false;
+    int32_t index = goal_index(field, cell);
+    if (index < 0 || field->directions[index] == SYLVES_FLOW_FIELD_NO_DIR) return false;
+    *dir = (SylvesCellDir)field->directions[index];
+    return true;
+}
@@ -6,11 +6,14 @@
 #include "sylves/grid.h"
 #include "sylves/vector.h"
 #include "sylves/mesh.h"
+#include "sylves/cell_buffer.h"
 #include "grid_internal.h"
 #include "grid_defaults.h"
 #include "square_grid_internal.h"
 #include "hex_grid_internal.h"
+#include "mesh_grid_internal.h"
 #include <stdlib.h>
+#include <limits.h>
 
 /* Grid destruction */
 void sylves_grid_destroy(SylvesGrid* grid) {
@@ -72,6 +75,37 @@ bool sylves_grid_try_move(const SylvesGrid* grid, SylvesCell cell, SylvesCellDir
     return grid->vtable->try_move(grid, cell, dir, dest, inverse_dir, connection);
 }
 
+int sylves_grid_try_move_batch(const SylvesGrid* grid, const SylvesCell* cells,
+                               const SylvesCellDir* dirs, size_t count,
+                               SylvesCell* dests, SylvesCellDir* inverse_dirs,
+                               SylvesConnection* connections, bool* ok_mask) {
+    if (!grid || !grid->vtable) return SYLVES_ERROR_NULL_POINTER;
+    if (count == 0) return 0;
+    if (!cells || !dirs) return SYLVES_ERROR_NULL_POINTER;
+    if (grid->vtable->try_move_batch) {
+        return grid->vtable->try_move_batch(grid, cells, dirs, count, dests,
+                                            inverse_dirs, connections, ok_mask);
+    }
+    if (!grid->vtable->try_move) return SYLVES_ERROR_NOT_IMPLEMENTED;
+
+    /* Generic fallback: one try_move per entry */
+    int moved = 0;
+    for (size_t i = 0; i < count; i++) {
+        SylvesCell dest;
+        SylvesCellDir inv;
+        SylvesConnection conn;
+        bool ok = grid->vtable->try_move(grid, cells[i], dirs[i], &dest, &inv, &conn);
+        if (ok) {
+            if (dests) dests[i] = dest;
+            if (inverse_dirs) inverse_dirs[i] = inv;
+            if (connections) connections[i] = conn;
+            moved++;
+        }
+        if (ok_mask) ok_mask[i] = ok;
+    }
+    return moved;
+}
+
 int sylves_grid_get_cell_dirs(const SylvesGrid* grid, SylvesCell cell,
                               SylvesCellDir* dirs, size_t max_dirs) {
     if (!grid || !grid->vtable || !grid->vtable->get_cell_dirs) {
@@ -104,6 +138,48 @@ SylvesVector3 sylves_grid_get_cell_corner(const SylvesGrid* grid, SylvesCell cel
     return grid->vtable->get_cell_corner_pos(grid, cell, corner);
 }
 
+int sylves_grid_get_cell_centers_soa(const SylvesGrid* grid, const SylvesCellBuffer* cells,
+                                     double* out_x, double* out_y, double* out_z) {
+    if (!grid || !grid->vtable || !cells || !out_x || !out_y || !out_z) {
+        return SYLVES_ERROR_NULL_POINTER;
+    }
+    if (cells->count > INT_MAX) return SYLVES_ERROR_INVALID_ARGUMENT;
+    if (grid->vtable->get_cell_centers_soa) {
+        grid->vtable->get_cell_centers_soa(grid, cells, out_x, out_y, out_z);
+        return (int)cells->count;
+    }
+    if (!grid->vtable->get_cell_center) return SYLVES_ERROR_NOT_IMPLEMENTED;
+    for (size_t i = 0; i < cells->count; i++) {
+        SylvesVector3 p = grid->vtable->get_cell_center(grid, sylves_cell_buffer_get(cells, i));
+        out_x[i] = p.x;
+        out_y[i] = p.y;
+        out_z[i] = p.z;
+    }
+    return (int)cells->count;
+}
+
+int sylves_grid_get_cell_corners_soa(const SylvesGrid* grid, const SylvesCellBuffer* cells,
+                                     SylvesCellCorner corner,
+                                     double* out_x, double* out_y, double* out_z) {
+    if (!grid || !grid->vtable || !cells || !out_x || !out_y || !out_z) {
+        return SYLVES_ERROR_NULL_POINTER;
+    }
+    if (cells->count > INT_MAX) return SYLVES_ERROR_INVALID_ARGUMENT;
+    if (grid->vtable->get_cell_corners_soa) {
+        grid->vtable->get_cell_corners_soa(grid, cells, corner, out_x, out_y, out_z);
+        return (int)cells->count;
+    }
+    if (!grid->vtable->get_cell_corner_pos) return SYLVES_ERROR_NOT_IMPLEMENTED;
+    for (size_t i = 0; i < cells->count; i++) {
+        SylvesVector3 p = grid->vtable->get_cell_corner_pos(grid, sylves_cell_buffer_get(cells, i),
+                                                            corner);
+        out_x[i] = p.x;
+        out_y[i] = p.y;
+        out_z[i] = p.z;
+    }
+    return (int)cells->count;
+}
+
 int sylves_grid_get_polygon(const SylvesGrid* grid, SylvesCell cell,
                             SylvesVector3* vertices, size_t max_vertices) {
     if (!grid || !grid->vtable || !grid->vtable->get_polygon) {
@@ -282,6 +358,8 @@ int sylves_grid_get_cells_in_aabb(const SylvesGrid* grid, SylvesVector3 min, Syl
             return sylves_square_grid_get_cells_in_aabb(grid, min, max, cells, max_cells);
         case SYLVES_GRID_TYPE_HEX:
             return sylves_hex_grid_get_cells_in_aabb(grid, min, max, cells, max_cells);
+        case SYLVES_GRID_TYPE_MESH:
+            return sylves_mesh_grid_get_cells_in_aabb(grid, min, max, cells, max_cells);
         default:
             return SYLVES_ERROR_NOT_IMPLEMENTED;
     }
@@ -16,6 +16,7 @@ struct SylvesHash {
     Entry* entries;
     size_t capacity; // power of two
     size_t size;
+    size_t tombstones; // counted against the load factor so probes always reach an empty slot
 };
 
 static inline uint64_t mix64(uint64_t x){
@@ -48,6 +49,7 @@ SylvesHash* sylves_hash_create(size_t capacity){
     if(!h->entries){ sylves_free(h); return NULL; }
     h->capacity = cap;
     h->size = 0;
+    h->tombstones = 0;
     return h;
 }
 
@@ -61,6 +63,7 @@ void sylves_hash_clear(SylvesHash* h){
     if(!h) return;
     memset(h->entries, 0, h->capacity * sizeof(Entry));
     h->size = 0;
+    h->tombstones = 0;
 }
 
 static bool insert_impl(SylvesHash* h, const SylvesCell* key, int value, bool replace){
@@ -72,6 +75,7 @@ static bool insert_impl(SylvesHash* h, const SylvesCell* key, int value, bool re
         Entry* e = &h->entries[idx];
         if(e->state == 0){
             size_t use = (tomb >= 0) ? (size_t)tomb : (size_t)idx;
+            if (tomb >= 0) h->tombstones--;
             Entry* t = &h->entries[use];
             t->key = *key; t->value = value; t->state = 1; h->size++;
             return true;
@@ -88,13 +92,14 @@ static bool insert_impl(SylvesHash* h, const SylvesCell* key, int value, bool re
 }
 
 static bool ensure_capacity(SylvesHash* h, size_t min_free){
-    if ((h->size + min_free) * 2 < h->capacity) return true;
-    size_t newcap = h->capacity << 1;
+    if ((h->size + h->tombstones + min_free) * 2 < h->capacity) return true;
+    // Mostly tombstones (remove/insert churn): rehash in place instead of growing
+    size_t newcap = (h->size + min_free) * 4 < h->capacity ? h->capacity : h->capacity << 1;
     Entry* old = h->entries;
     size_t oldcap = h->capacity;
     Entry* ne = (Entry*)sylves_calloc(newcap, sizeof(Entry));
     if(!ne) return false;
-    h->entries = ne; h->capacity = newcap; h->size = 0;
+    h->entries = ne; h->capacity = newcap; h->size = 0; h->tombstones = 0;
     for(size_t i=0;i<oldcap;i++){
         if(old[i].state == 1){ insert_impl(h, &old[i].key, old[i].value, true); }
     }
@@ -130,7 +135,7 @@ bool sylves_hash_remove(SylvesHash* h, const SylvesCell* key){
         Entry* e = &h->entries[idx];
         if(e->state == 0) return false;
         if(e->state == 1 && cell_eq(&e->key, key)){
-            e->state = 2; h->size--; return true;
+            e->state = 2; h->size--; h->tombstones++; return true;
         }
         idx = (idx + 1) & mask;
     }
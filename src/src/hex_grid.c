@@ -11,9 +11,12 @@
 #include "sylves/hex_rotation.h"
 #include "grid_internal.h"
 #include "square_grid_internal.h" /* reuse patterns */
+#include "simd_internal.h"
+#include "sylves/cell_buffer.h"
 #include "sylves/bounds.h"
 #include <stdlib.h>
 #include <math.h>
+#include <limits.h>
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
@@ -51,9 +54,21 @@ static SylvesError hex_get_cell_aabb(const SylvesGrid* grid, SylvesCell cell, Sy
 static int hex_get_polygon(const SylvesGrid* grid, SylvesCell cell,
                            SylvesVector3* vertices, size_t max_vertices);
 static bool hex_find_cell(const SylvesGrid* grid, SylvesVector3 position, SylvesCell* cell);
+static int hex_get_index_count(const SylvesGrid* grid);
+static int hex_get_index(const SylvesGrid* grid, SylvesCell cell);
+static SylvesError hex_get_cell_by_index(const SylvesGrid* grid, int index, SylvesCell* cell);
 
 static int hex_raycast(const SylvesGrid* grid, SylvesVector3 origin, SylvesVector3 direction,
                         double max_distance, SylvesRaycastInfo* hits, size_t max_hits);
+static int hex_try_move_batch(const SylvesGrid* grid, const SylvesCell* cells,
+                              const SylvesCellDir* dirs, size_t count,
+                              SylvesCell* dests, SylvesCellDir* inverse_dirs,
+                              SylvesConnection* connections, bool* ok_mask);
+static void hex_get_cell_centers_soa(const SylvesGrid* grid, const SylvesCellBuffer* cells,
+                                     double* out_x, double* out_y, double* out_z);
+static void hex_get_cell_corners_soa(const SylvesGrid* grid, const SylvesCellBuffer* cells,
+                                     SylvesCellCorner corner,
+                                     double* out_x, double* out_y, double* out_z);
 
 static const SylvesGridVTable HEX_VT = {
     .destroy = hex_destroy,
@@ -75,7 +90,12 @@ static const SylvesGridVTable HEX_VT = {
     .get_cell_aabb = hex_get_cell_aabb,
     .find_cell = hex_find_cell,
     .raycast = hex_raycast,
-    /* index ops provided via helpers for bounded grids */
+    .try_move_batch = hex_try_move_batch,
+    .get_cell_centers_soa = hex_get_cell_centers_soa,
+    .get_cell_corners_soa = hex_get_cell_corners_soa,
+    .get_index_count = hex_get_index_count,
+    .get_index = hex_get_index,
+    .get_cell_by_index = hex_get_cell_by_index,
 };
 
 /* Public API */
@@ -270,6 +290,38 @@ const HexGridData* d = (const HexGridData*)grid->data;
     return q >= d->min_q && q <= d->max_q && r >= d->min_r && r <= d->max_r;
 }
 
+/* Bounded grids index the q,r parallelogram row-major in r, like the square grid */
+static int hex_get_index_count(const SylvesGrid* grid) {
+    const HexGridData* d = (const HexGridData*)grid->data;
+    if (!d->is_bounded) return SYLVES_ERROR_INFINITE_GRID;
+    long long w = (long long)d->max_q - (long long)d->min_q + 1;
+    long long h = (long long)d->max_r - (long long)d->min_r + 1;
+    long long total = w * h;
+    if (total < 0 || total > INT_MAX) return SYLVES_ERROR_INVALID_STATE;
+    return (int)total;
+}
+
+static int hex_get_index(const SylvesGrid* grid, SylvesCell cell) {
+    const HexGridData* d = (const HexGridData*)grid->data;
+    if (!d->is_bounded) return SYLVES_ERROR_INFINITE_GRID;
+    if (!hex_is_cell_in_grid(grid, cell)) return SYLVES_ERROR_CELL_NOT_IN_GRID;
+    long long w = (long long)d->max_q - (long long)d->min_q + 1;
+    long long idx = (long long)(cell.y - d->min_r) * w + (long long)(cell.x - d->min_q);
+    if (idx < 0 || idx > INT_MAX) return SYLVES_ERROR_INVALID_STATE;
+    return (int)idx;
+}
+
+static SylvesError hex_get_cell_by_index(const SylvesGrid* grid, int index, SylvesCell* cell) {
+    const HexGridData* d = (const HexGridData*)grid->data;
+    if (!d->is_bounded) return SYLVES_ERROR_INFINITE_GRID;
+    int count = hex_get_index_count(grid);
+    if (count < 0) return (SylvesError)count;
+    if (index < 0 || index >= count) return SYLVES_ERROR_OUT_OF_BOUNDS;
+    int w = d->max_q - d->min_q + 1;
+    if (cell) *cell = (SylvesCell){ d->min_q + index % w, d->min_r + index / w, 0 };
+    return SYLVES_SUCCESS;
+}
+
 static const SylvesCellType* hex_get_cell_type(const SylvesGrid* grid, SylvesCell cell) {
     (void)grid; (void)cell;
     /* Return a basic hex cell type; using flat-topped vs pointy-topped symmetry may differ later */
@@ -307,6 +359,31 @@ static bool hex_try_move(const SylvesGrid* grid, SylvesCell cell, SylvesCellDir
     return true;
 }
 
+static int hex_try_move_batch(const SylvesGrid* grid, const SylvesCell* cells,
+                              const SylvesCellDir* dirs, size_t count,
+                              SylvesCell* dests, SylvesCellDir* inverse_dirs,
+                              SylvesConnection* connections, bool* ok_mask) {
+    const HexGridData* d = (const HexGridData*)grid->data;
+    bool bounded = d->is_bounded != 0;
+    int moved = 0;
+    for (size_t i = 0; i < count; i++) {
+        SylvesCell c = cells[i];
+        int di = dirs[i] % 6; if (di < 0) di += 6;
+        SylvesCell next = { c.x + HEX_DQ[di], c.y + HEX_DR[di], c.z };
+        bool ok = c.z == 0;
+        if (bounded) {
+            ok = ok && c.x >= d->min_q && c.x <= d->max_q && c.y >= d->min_r && c.y <= d->max_r &&
+                 next.x >= d->min_q && next.x <= d->max_q && next.y >= d->min_r && next.y <= d->max_r;
+        }
+        if (dests) dests[i] = next;
+        if (inverse_dirs) inverse_dirs[i] = (di + 3) % 6;
+        if (connections) { connections[i].rotation = 0; connections[i].is_mirror = false; }
+        if (ok_mask) ok_mask[i] = ok;
+        moved += ok;
+    }
+    return moved;
+}
+
 /* Raycast for hex grid: temporary conservative approach walking AABB-overlapped cells.
    TODO: Replace with TriangleGrid-backed raycast with exact Sylves logic. */
 static int hex_raycast(const SylvesGrid* grid, SylvesVector3 origin, SylvesVector3 direction,
@@ -379,6 +456,48 @@ static SylvesVector3 hex_get_cell_center(const SylvesGrid* grid, SylvesCell cell
     return sylves_vector3_create(wx, wy, 0.0);
 }
 
+/* Bulk form of hex_get_cell_center with cube y = -q - r folded into the coefficients */
+static void hex_centers_soa(const HexGridData* d, const int* restrict q, const int* restrict r,
+                            size_t n, double ox, double oy,
+                            double* restrict out_x, double* restrict out_y) {
+    double sx = d->cell_size_x;
+    double sy = d->cell_size_y;
+    if (d->orient == SYLVES_HEX_ORIENTATION_FLAT_TOP) {
+        /* wx = (0.5x - 0.25y - 0.25z) sx = 0.75 q sx; wy = (0.5y - 0.5z) sy = (-0.5q - r) sy */
+        for (size_t i = 0; i < n; i++) {
+            out_x[i] = 0.75 * sx * q[i] + ox;
+            out_y[i] = (-0.5 * q[i] - (double)r[i]) * sy + oy;
+        }
+    } else {
+        /* wx = (0.5x - 0.5z) sx; wy = (0.5y - 0.25x - 0.25z) sy = (-0.75q - 0.75r) sy */
+        for (size_t i = 0; i < n; i++) {
+            out_x[i] = (0.5 * q[i] - 0.5 * r[i]) * sx + ox;
+            out_y[i] = -0.75 * sy * ((double)q[i] + (double)r[i]) + oy;
+        }
+    }
+}
+
+static void hex_get_cell_centers_soa(const SylvesGrid* grid, const SylvesCellBuffer* cells,
+                                     double* out_x, double* out_y, double* out_z) {
+    const HexGridData* d = (const HexGridData*)grid->data;
+    hex_centers_soa(d, cells->x, cells->y, cells->count, 0.0, 0.0, out_x, out_y);
+    sylves_simd_fill(out_z, cells->count, 0.0);
+}
+
+static void hex_get_cell_corners_soa(const SylvesGrid* grid, const SylvesCellBuffer* cells,
+                                     SylvesCellCorner corner,
+                                     double* out_x, double* out_y, double* out_z) {
+    const HexGridData* d = (const HexGridData*)grid->data;
+    /* Corner offset is the same for every cell, so it is computed once */
+    double angle_offset = (d->orient == SYLVES_HEX_ORIENTATION_FLAT_TOP) ? 0.0 : (acos(-1.0)/6.0);
+    int idx = ((int)corner) % 6; if (idx < 0) idx += 6;
+    double ang = angle_offset + idx * (acos(-1.0)/3.0);
+    double ox = d->cell_size_x * 0.5 * cos(ang);
+    double oy = d->cell_size_y * 0.5 * sin(ang);
+    hex_centers_soa(d, cells->x, cells->y, cells->count, ox, oy, out_x, out_y);
+    sylves_simd_fill(out_z, cells->count, 0.0);
+}
+
 static int hex_get_polygon(const SylvesGrid* grid, SylvesCell cell,
                            SylvesVector3* vertices, size_t max_vertices) {
     if (cell.z != 0) return SYLVES_ERROR_CELL_NOT_IN_GRID;
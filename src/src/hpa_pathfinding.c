@@ -0,0 +1,847 @@
+/**
+ * @file hpa_pathfinding.c
+ * @brief Hierarchical pathfinding (HPA*) over clusters of a finite grid
+ */
+
+#include "sylves/pathfinding.h"
+#include "sylves/cache.h"
+#include "sylves/memory.h"
+#include "sylves/errors.h"
+#include "sylves/cell.h"
+#include "sylves/grid.h"
+#include "sylves/cell_type.h"
+#include "internal/path_search.h"
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+
+/* Runs of border crossings at least this long get a transition at each end instead of one in the middle */
+#define HPA_LONG_ENTRANCE 6
+
+typedef struct HpaEdge {
+    int32_t to;
+    float cost;
+    bool inter;         /* a single step across a border; otherwise a path inside the cluster */
+} HpaEdge;
+
+typedef struct HpaNode {
+    SylvesCell cell;
+    int32_t cluster;
+    int32_t across;     /* cluster on the other side of this node's entrance; -1 while the slot is free */
+    HpaEdge* edges;
+    uint32_t edge_count;
+    uint32_t edge_capacity;
+} HpaNode;
+
+typedef struct HpaCluster {
+    SylvesCell key;
+    int32_t* nodes;
+    uint32_t node_count;
+    uint32_t node_capacity;
+} HpaCluster;
+
+/* Adjacent accessible cells on either side of a border */
+typedef struct HpaCrossing {
+    SylvesCell inside;
+    SylvesCell outside;
+    int32_t other;      /* cluster of outside */
+} HpaCrossing;
+
+/* Hierarchical pathfinding context */
+struct SylvesHierarchicalPathfinding {
+    SylvesGrid* grid;
+    int cluster_size;
+    bool cluster_z;                     /* 3D grids are split along z too */
+    SylvesIsAccessibleFunc is_accessible;
+    SylvesStepLengthFunc step_lengths;
+    SylvesCellDistanceFunc heuristic;
+    void* user_data;
+    struct SylvesPathCache* path_cache;
+
+    SylvesPathNodeMap cluster_ids;      /* cluster key -> index into clusters */
+    HpaCluster* clusters;
+    size_t cluster_count;
+    size_t cluster_capacity;
+
+    HpaNode* nodes;
+    size_t node_count;                  /* slots in use or freed */
+    size_t node_capacity;
+    int32_t* free_nodes;
+    size_t free_count;
+    size_t free_capacity;
+    size_t live_nodes;
+
+    SylvesPathfindingContext search;    /* in-cluster searches, kept sparse since they stay small */
+
+    /* Abstract search state for node ids plus the query's src and dest */
+    float* g;
+    int32_t* parent;
+    uint8_t* parent_inter;
+    uint32_t* stamp;
+    uint32_t generation;
+    size_t search_capacity;
+    SylvesIndexedHeap* open_set;
+};
+
+/* Grow an array so it holds at least needed elements */
+static bool reserve(void** array, size_t* capacity, size_t needed, size_t element_size) {
+    if (needed <= *capacity) return true;
+    size_t new_capacity = *capacity ? *capacity * 2 : 8;
+    while (new_capacity < needed) new_capacity *= 2;
+    void* grown = sylves_realloc(*array, element_size * new_capacity);
+    if (!grown) return false;
+    *array = grown;
+    *capacity = new_capacity;
+    return true;
+}
+
+static inline int floor_div(int a, int b) {
+    int q = a / b;
+    return (a % b != 0 && a < 0) ? q - 1 : q;
+}
+
+static SylvesCell cluster_key(const SylvesHierarchicalPathfinding* hpa, SylvesCell cell) {
+    SylvesCell key = {
+        floor_div(cell.x, hpa->cluster_size),
+        floor_div(cell.y, hpa->cluster_size),
+        hpa->cluster_z ? floor_div(cell.z, hpa->cluster_size) : cell.z
+    };
+    return key;
+}
+
+static int32_t cluster_of(const SylvesHierarchicalPathfinding* hpa, SylvesCell cell) {
+    return sylves_path_map_find(&hpa->cluster_ids, cluster_key(hpa, cell));
+}
+
+static bool is_open(const SylvesHierarchicalPathfinding* hpa, SylvesCell cell) {
+    return !hpa->is_accessible || hpa->is_accessible(cell, hpa->user_data);
+}
+
+/* Fill dirs for cell, spilling to the heap past the stack buffer; returns the count or -1 */
+static int get_dirs(SylvesGrid* grid, SylvesCell cell, SylvesCellDir* stack_dirs, size_t stack_count,
+                    SylvesCellDir** dirs) {
+    *dirs = stack_dirs;
+    const SylvesCellType* ct = sylves_grid_get_cell_type(grid, cell);
+    if (!ct) return -1;
+    int max_dirs = sylves_cell_type_get_dir_count(ct);
+    if (max_dirs <= 0) return -1;
+    if ((size_t)max_dirs > stack_count) {
+        *dirs = (SylvesCellDir*)sylves_alloc(sizeof(SylvesCellDir) * (size_t)max_dirs);
+        if (!*dirs) return -1;
+    }
+    int count = sylves_grid_get_cell_dirs(grid, cell, *dirs, (size_t)max_dirs);
+    if (count < 0 && *dirs != stack_dirs) {
+        sylves_free(*dirs);
+        *dirs = stack_dirs;
+    }
+    return count;
+}
+
+/* Accessibility and step lengths folded into one step length, negative when blocked */
+static float step_length(const SylvesHierarchicalPathfinding* hpa, const SylvesStep* step) {
+    if (!is_open(hpa, step->dest)) return -1.0f;
+    return hpa->step_lengths ? hpa->step_lengths(step, hpa->user_data) : 1.0f;
+}
+
+/* The step from one cell to an adjacent one, measured; false if they are not adjacent or it is blocked */
+static bool measure_step(const SylvesHierarchicalPathfinding* hpa, SylvesCell from, SylvesCell to, SylvesStep* step) {
+    SylvesCellDir stack_dirs[16];
+    SylvesCellDir* dirs;
+    int dir_count = get_dirs(hpa->grid, from, stack_dirs, 16, &dirs);
+    bool found = false;
+    for (int i = 0; i < dir_count && !found; i++) {
+        if (sylves_step_create(hpa->grid, from, dirs[i], NULL, NULL, step) == SYLVES_SUCCESS &&
+            sylves_cell_equals(step->dest, to)) {
+            step->length = step_length(hpa, step);
+            found = step->length >= 0;
+            if (!found) break;
+        }
+    }
+    if (dirs != stack_dirs) sylves_free(dirs);
+    return found;
+}
+
+/* In-cluster searches */
+
+typedef struct ClusterStepData {
+    const SylvesHierarchicalPathfinding* hpa;
+    SylvesCell key;
+} ClusterStepData;
+
+static float cluster_step_length(const SylvesStep* step, void* user_data) {
+    const ClusterStepData* data = (const ClusterStepData*)user_data;
+    if (!sylves_cell_equals(cluster_key(data->hpa, step->dest), data->key)) return -1.0f;
+    return step_length(data->hpa, step);
+}
+
+/* Dijkstra from src that never leaves cluster; stops once every target is settled */
+static void search_cluster(SylvesHierarchicalPathfinding* hpa, int32_t cluster, SylvesCell src,
+                           const SylvesCell* targets, size_t target_count) {
+    ClusterStepData data = { hpa, hpa->clusters[cluster].key };
+    sylves_path_dijkstra_seed(&hpa->search, hpa->grid, &src, 1);
+    sylves_path_dijkstra_expand(&hpa->search, hpa->grid, targets, target_count, FLT_MAX,
+                                cluster_step_length, &data);
+}
+
+static float searched_distance(const SylvesHierarchicalPathfinding* hpa, SylvesCell cell) {
+    int32_t node = sylves_path_map_find(&hpa->search.nodes, cell);
+    return node < 0 ? FLT_MAX : sylves_path_map_g(&hpa->search.nodes, node);
+}
+
+/* Abstract graph */
+
+static int32_t add_node(SylvesHierarchicalPathfinding* hpa, SylvesCell cell, int32_t cluster, int32_t across) {
+    HpaCluster* c = &hpa->clusters[cluster];
+    size_t list_capacity = c->node_capacity;
+    if (!reserve((void**)&c->nodes, &list_capacity, c->node_count + 1, sizeof(int32_t))) return -1;
+    c->node_capacity = (uint32_t)list_capacity;
+
+    int32_t id;
+    if (hpa->free_count > 0) {
+        id = hpa->free_nodes[--hpa->free_count];
+    } else {
+        if (hpa->node_count >= (size_t)INT32_MAX - 2 ||
+            !reserve((void**)&hpa->nodes, &hpa->node_capacity, hpa->node_count + 1, sizeof(HpaNode))) {
+            return -1;
+        }
+        id = (int32_t)hpa->node_count++;
+        hpa->nodes[id].edges = NULL;
+        hpa->nodes[id].edge_capacity = 0;
+    }
+
+    HpaNode* node = &hpa->nodes[id];
+    node->cell = cell;
+    node->cluster = cluster;
+    node->across = across;
+    node->edge_count = 0;
+    c->nodes[c->node_count++] = id;
+    hpa->live_nodes++;
+    return id;
+}
+
+static void free_node(SylvesHierarchicalPathfinding* hpa, int32_t id) {
+    HpaNode* node = &hpa->nodes[id];
+    HpaCluster* c = &hpa->clusters[node->cluster];
+    for (uint32_t i = 0; i < c->node_count; i++) {
+        if (c->nodes[i] == id) {
+            c->nodes[i] = c->nodes[--c->node_count];
+            break;
+        }
+    }
+    node->across = -1;
+    node->edge_count = 0;
+    if (reserve((void**)&hpa->free_nodes, &hpa->free_capacity, hpa->free_count + 1, sizeof(int32_t))) {
+        hpa->free_nodes[hpa->free_count++] = id;
+    }
+    hpa->live_nodes--;
+}
+
+static bool add_edge(HpaNode* node, int32_t to, float cost, bool inter) {
+    size_t capacity = node->edge_capacity;
+    if (!reserve((void**)&node->edges, &capacity, node->edge_count + 1, sizeof(HpaEdge))) return false;
+    node->edge_capacity = (uint32_t)capacity;
+    node->edges[node->edge_count++] = (HpaEdge){ to, cost, inter };
+    return true;
+}
+
+static bool cells_adjacent(SylvesGrid* grid, SylvesCell a, SylvesCell b) {
+    SylvesCellDir stack_dirs[16];
+    SylvesCellDir* dirs;
+    int dir_count = get_dirs(grid, a, stack_dirs, 16, &dirs);
+    bool adjacent = false;
+    for (int i = 0; i < dir_count && !adjacent; i++) {
+        SylvesCell n;
+        adjacent = sylves_grid_try_move(grid, a, dirs[i], &n, NULL, NULL) && sylves_cell_equals(n, b);
+    }
+    if (dirs != stack_dirs) sylves_free(dirs);
+    return adjacent;
+}
+
+static int compare_keys(SylvesCell a, SylvesCell b) {
+    if (a.z != b.z) return a.z < b.z ? -1 : 1;
+    if (a.y != b.y) return a.y < b.y ? -1 : 1;
+    if (a.x != b.x) return a.x < b.x ? -1 : 1;
+    return 0;
+}
+
+/*
+ * Crossings out of cluster into the cluster only, or when only is -1
+ * into every neighbour with a greater key, so each border is seen once.
+ */
+static bool collect_crossings(SylvesHierarchicalPathfinding* hpa, int32_t cluster, int32_t only,
+                              HpaCrossing** crossings, size_t* count, size_t* capacity) {
+    SylvesCell key = hpa->clusters[cluster].key;
+    int s = hpa->cluster_size;
+    int z_lo = hpa->cluster_z ? key.z * s : key.z;
+    int z_hi = hpa->cluster_z ? z_lo + s : z_lo + 1;
+    *count = 0;
+
+    for (int z = z_lo; z < z_hi; z++) {
+        for (int y = key.y * s; y < key.y * s + s; y++) {
+            for (int x = key.x * s; x < key.x * s + s; x++) {
+                SylvesCell cell = { x, y, z };
+                if (!sylves_grid_is_cell_in_grid(hpa->grid, cell) || !is_open(hpa, cell)) continue;
+
+                SylvesCellDir stack_dirs[16];
+                SylvesCellDir* dirs;
+                int dir_count = get_dirs(hpa->grid, cell, stack_dirs, 16, &dirs);
+                for (int i = 0; i < dir_count; i++) {
+                    SylvesCell n;
+                    if (!sylves_grid_try_move(hpa->grid, cell, dirs[i], &n, NULL, NULL)) continue;
+                    SylvesCell n_key = cluster_key(hpa, n);
+                    if (sylves_cell_equals(n_key, key) || !is_open(hpa, n)) continue;
+                    int32_t other = sylves_path_map_find(&hpa->cluster_ids, n_key);
+                    if (other < 0) continue;
+                    if (only >= 0 ? other != only : compare_keys(n_key, key) < 0) continue;
+                    if (!reserve((void**)crossings, capacity, *count + 1, sizeof(HpaCrossing))) {
+                        if (dirs != stack_dirs) sylves_free(dirs);
+                        return false;
+                    }
+                    (*crossings)[(*count)++] = (HpaCrossing){ cell, n, other };
+                }
+                if (dirs != stack_dirs) sylves_free(dirs);
+            }
+        }
+    }
+    return true;
+}
+
+static int compare_crossings(const void* a, const void* b) {
+    int32_t x = ((const HpaCrossing*)a)->other, y = ((const HpaCrossing*)b)->other;
+    return (x > y) - (x < y);
+}
+
+static bool add_transition(SylvesHierarchicalPathfinding* hpa, int32_t cluster, const HpaCrossing* crossing) {
+    int32_t inside = add_node(hpa, crossing->inside, cluster, crossing->other);
+    if (inside < 0) return false;
+    int32_t outside = add_node(hpa, crossing->outside, crossing->other, cluster);
+    if (outside < 0) return false;
+
+    SylvesStep step;
+    if (measure_step(hpa, crossing->inside, crossing->outside, &step) &&
+        !add_edge(&hpa->nodes[inside], outside, step.length, true)) return false;
+    if (measure_step(hpa, crossing->outside, crossing->inside, &step) &&
+        !add_edge(&hpa->nodes[outside], inside, step.length, true)) return false;
+    return true;
+}
+
+/*
+ * Split the crossings of one border into runs of neighbouring crossings
+ * and place transitions on each. A run is walked from one of its ends, so
+ * on a straight border its order follows the border.
+ */
+static bool add_entrances(SylvesHierarchicalPathfinding* hpa, int32_t cluster, HpaCrossing* crossings, size_t count) {
+    if (count == 0) return true;
+    bool ok = false;
+    uint8_t* seen = (uint8_t*)sylves_calloc(count, 1);
+    size_t* order = (size_t*)sylves_alloc(sizeof(size_t) * count);
+    if (!seen || !order) goto done;
+
+    #define NEIGHBOURS(i, j) (cells_adjacent(hpa->grid, crossings[i].inside, crossings[j].inside) && \
+                              cells_adjacent(hpa->grid, crossings[i].outside, crossings[j].outside))
+
+    for (size_t first = 0; first < count; first++) {
+        if (seen[first]) continue;
+
+        // Gather the run, then find an end: a member with at most one neighbour in it
+        size_t length = 0;
+        order[length++] = first;
+        seen[first] = 1;
+        for (size_t k = 0; k < length; k++) {
+            for (size_t j = 0; j < count; j++) {
+                if (!seen[j] && NEIGHBOURS(order[k], j)) {
+                    seen[j] = 1;
+                    order[length++] = j;
+                }
+            }
+        }
+        size_t end = order[0];
+        for (size_t k = 0; k < length; k++) {
+            size_t neighbours = 0;
+            for (size_t j = 0; j < length && neighbours < 2; j++) {
+                if (j != k && NEIGHBOURS(order[k], order[j])) neighbours++;
+            }
+            if (neighbours < 2) {
+                end = order[k];
+                break;
+            }
+        }
+
+        // Re-walk the run breadth first from that end
+        for (size_t k = 0; k < length; k++) seen[order[k]] = 2;
+        size_t walked = 0;
+        order[walked++] = end;
+        seen[end] = 1;
+        for (size_t k = 0; k < walked; k++) {
+            for (size_t j = 0; j < count; j++) {
+                if (seen[j] == 2 && NEIGHBOURS(order[k], j)) {
+                    seen[j] = 1;
+                    order[walked++] = j;
+                }
+            }
+        }
+
+        if (walked >= HPA_LONG_ENTRANCE) {
+            if (!add_transition(hpa, cluster, &crossings[order[0]]) ||
+                !add_transition(hpa, cluster, &crossings[order[walked - 1]])) goto done;
+        } else if (!add_transition(hpa, cluster, &crossings[order[walked / 2]])) {
+            goto done;
+        }
+    }
+    #undef NEIGHBOURS
+    ok = true;
+
+done:
+    sylves_free(seen);
+    sylves_free(order);
+    return ok;
+}
+
+/* Build entrances out of cluster into only, or into every greater neighbour when only is -1 */
+static bool build_entrances(SylvesHierarchicalPathfinding* hpa, int32_t cluster, int32_t only,
+                            HpaCrossing** crossings, size_t* capacity) {
+    size_t count;
+    if (!collect_crossings(hpa, cluster, only, crossings, &count, capacity)) return false;
+    if (count > 1) qsort(*crossings, count, sizeof(HpaCrossing), compare_crossings);
+    for (size_t start = 0; start < count;) {
+        size_t end = start + 1;
+        while (end < count && (*crossings)[end].other == (*crossings)[start].other) end++;
+        if (!add_entrances(hpa, cluster, *crossings + start, end - start)) return false;
+        start = end;
+    }
+    return true;
+}
+
+static void remove_border(SylvesHierarchicalPathfinding* hpa, int32_t a, int32_t b) {
+    for (int side = 0; side < 2; side++) {
+        int32_t cluster = side == 0 ? a : b;
+        int32_t other = side == 0 ? b : a;
+        HpaCluster* c = &hpa->clusters[cluster];
+        for (uint32_t i = c->node_count; i > 0; i--) {
+            int32_t id = c->nodes[i - 1];
+            if (hpa->nodes[id].across == other) free_node(hpa, id);
+        }
+    }
+}
+
+/* Replace the in-cluster edges of every node in cluster with fresh distances */
+static bool build_cluster_edges(SylvesHierarchicalPathfinding* hpa, int32_t cluster) {
+    HpaCluster* c = &hpa->clusters[cluster];
+    if (c->node_count == 0) return true;
+
+    SylvesCell* targets = (SylvesCell*)sylves_alloc(sizeof(SylvesCell) * c->node_count);
+    if (!targets) return false;
+    for (uint32_t i = 0; i < c->node_count; i++) {
+        HpaNode* node = &hpa->nodes[c->nodes[i]];
+        targets[i] = node->cell;
+
+        // Keep only the step across the border
+        uint32_t kept = 0;
+        for (uint32_t e = 0; e < node->edge_count; e++) {
+            if (node->edges[e].inter) node->edges[kept++] = node->edges[e];
+        }
+        node->edge_count = kept;
+    }
+
+    bool ok = true;
+    for (uint32_t i = 0; i < c->node_count && ok; i++) {
+        search_cluster(hpa, cluster, targets[i], targets, c->node_count);
+        for (uint32_t j = 0; j < c->node_count && ok; j++) {
+            float distance = searched_distance(hpa, targets[j]);
+            if (j != i && distance != FLT_MAX) {
+                ok = add_edge(&hpa->nodes[c->nodes[i]], c->nodes[j], distance, false);
+            }
+        }
+    }
+    sylves_free(targets);
+    return ok;
+}
+
+static bool register_clusters(SylvesHierarchicalPathfinding* hpa) {
+    int count = sylves_grid_get_index_count(hpa->grid);
+    for (int i = 0; i < count; i++) {
+        SylvesCell cell;
+        if (sylves_grid_get_cell_by_index(hpa->grid, i, &cell) != SYLVES_SUCCESS) return false;
+        int32_t id = sylves_path_map_insert(&hpa->cluster_ids, cluster_key(hpa, cell));
+        if (id < 0) return false;
+        if ((size_t)id < hpa->cluster_count) continue;
+
+        if (!reserve((void**)&hpa->clusters, &hpa->cluster_capacity, hpa->cluster_count + 1, sizeof(HpaCluster))) {
+            return false;
+        }
+        HpaCluster* c = &hpa->clusters[hpa->cluster_count++];
+        memset(c, 0, sizeof(*c));
+        c->key = cluster_key(hpa, cell);
+    }
+    return true;
+}
+
+/* HPA* implementation */
+
+SylvesHierarchicalPathfinding* sylves_hpa_create(
+    SylvesGrid* grid,
+    int cluster_size,
+    SylvesIsAccessibleFunc is_accessible,
+    SylvesStepLengthFunc step_lengths,
+    SylvesCellDistanceFunc heuristic,
+    void* user_data) {
+
+    if (!grid || cluster_size < 2 || sylves_grid_get_index_count(grid) <= 0) return NULL;
+
+    SylvesHierarchicalPathfinding* hpa =
+        (SylvesHierarchicalPathfinding*)sylves_calloc(1, sizeof(SylvesHierarchicalPathfinding));
+    if (!hpa) return NULL;
+
+    hpa->grid = grid;
+    hpa->cluster_size = cluster_size;
+    hpa->cluster_z = sylves_grid_get_coordinate_dimension(grid) >= 3;
+    hpa->is_accessible = is_accessible;
+    hpa->step_lengths = step_lengths;
+    hpa->heuristic = heuristic;
+    hpa->user_data = user_data;
+
+    bool ok = sylves_path_map_init(&hpa->cluster_ids, 0);
+    if (ok && sylves_path_context_init(&hpa->search, 0)) {
+        hpa->search.nodes.sparse_only = true;
+    } else {
+        ok = false;
+    }
+    hpa->open_set = sylves_indexed_heap_create(0);
+    ok = ok && hpa->open_set && register_clusters(hpa);
+
+    HpaCrossing* crossings = NULL;
+    size_t crossing_capacity = 0;
+    for (size_t i = 0; ok && i < hpa->cluster_count; i++) {
+        ok = build_entrances(hpa, (int32_t)i, -1, &crossings, &crossing_capacity);
+    }
+    sylves_free(crossings);
+    for (size_t i = 0; ok && i < hpa->cluster_count; i++) {
+        ok = build_cluster_edges(hpa, (int32_t)i);
+    }
+
+    if (!ok) {
+        sylves_hpa_destroy(hpa);
+        return NULL;
+    }
+    return hpa;
+}
+
+void sylves_hpa_destroy(SylvesHierarchicalPathfinding* hpa) {
+    if (!hpa) return;
+
+    for (size_t i = 0; i < hpa->node_count; i++) {
+        sylves_free(hpa->nodes[i].edges);
+    }
+    for (size_t i = 0; i < hpa->cluster_count; i++) {
+        sylves_free(hpa->clusters[i].nodes);
+    }
+    sylves_free(hpa->nodes);
+    sylves_free(hpa->clusters);
+    sylves_free(hpa->free_nodes);
+    sylves_free(hpa->g);
+    sylves_free(hpa->parent);
+    sylves_free(hpa->parent_inter);
+    sylves_free(hpa->stamp);
+    sylves_indexed_heap_destroy(hpa->open_set);
+    sylves_path_map_release(&hpa->cluster_ids);
+    sylves_path_context_release(&hpa->search);
+    sylves_free(hpa);
+}
+
+void sylves_hpa_set_path_cache(SylvesHierarchicalPathfinding* hpa, struct SylvesPathCache* cache) {
+    if (!hpa) return;
+    hpa->path_cache = cache;
+}
+
+size_t sylves_hpa_get_node_count(const SylvesHierarchicalPathfinding* hpa) {
+    return hpa ? hpa->live_nodes : 0;
+}
+
+/* Size the abstract search arrays for every node id plus src and dest */
+static bool reserve_search(SylvesHierarchicalPathfinding* hpa) {
+    size_t needed = hpa->node_count + 2;
+    if (needed <= hpa->search_capacity) return true;
+    size_t capacity = needed * 2;
+    float* g = (float*)sylves_realloc(hpa->g, sizeof(float) * capacity);
+    if (g) hpa->g = g;
+    int32_t* parent = (int32_t*)sylves_realloc(hpa->parent, sizeof(int32_t) * capacity);
+    if (parent) hpa->parent = parent;
+    uint8_t* parent_inter = (uint8_t*)sylves_realloc(hpa->parent_inter, capacity);
+    if (parent_inter) hpa->parent_inter = parent_inter;
+    uint32_t* stamp = (uint32_t*)sylves_realloc(hpa->stamp, sizeof(uint32_t) * capacity);
+    if (stamp) {
+        memset(stamp + hpa->search_capacity, 0, sizeof(uint32_t) * (capacity - hpa->search_capacity));
+        hpa->stamp = stamp;
+    }
+    if (!g || !parent || !parent_inter || !stamp) return false;
+    hpa->search_capacity = capacity;
+    return true;
+}
+
+static inline float abstract_g(const SylvesHierarchicalPathfinding* hpa, int32_t id) {
+    return hpa->stamp[id] == hpa->generation ? hpa->g[id] : FLT_MAX;
+}
+
+typedef struct HpaQuery {
+    SylvesCell src, dest;
+    int32_t src_id, dest_id;
+    int32_t src_cluster, dest_cluster;
+    HpaEdge* src_edges;         /* src to the nodes of its cluster, and to dest if it shares it */
+    size_t src_edge_count;
+    HpaEdge* dest_edges;        /* .to is the node in dest's cluster the edge leaves from */
+    size_t dest_edge_count;
+} HpaQuery;
+
+static SylvesCell query_cell(const SylvesHierarchicalPathfinding* hpa, const HpaQuery* q, int32_t id) {
+    if (id == q->src_id) return q->src;
+    if (id == q->dest_id) return q->dest;
+    return hpa->nodes[id].cell;
+}
+
+static void relax(SylvesHierarchicalPathfinding* hpa, const HpaQuery* q, int32_t from, const HpaEdge* edge) {
+    float tentative_g = hpa->g[from] + edge->cost;
+    if (tentative_g >= abstract_g(hpa, edge->to)) return;
+    hpa->stamp[edge->to] = hpa->generation;
+    hpa->g[edge->to] = tentative_g;
+    hpa->parent[edge->to] = from;
+    hpa->parent_inter[edge->to] = edge->inter;
+    float h = hpa->heuristic ? hpa->heuristic(query_cell(hpa, q, edge->to), q->dest, hpa->user_data) : 0.0f;
+    sylves_indexed_heap_push(hpa->open_set, (uint32_t)edge->to, tentative_g + h);
+}
+
+/* Link src and dest into the abstract graph through in-cluster searches */
+static bool connect_query(SylvesHierarchicalPathfinding* hpa, HpaQuery* q) {
+    const HpaCluster* a = &hpa->clusters[q->src_cluster];
+    const HpaCluster* b = &hpa->clusters[q->dest_cluster];
+    bool same = q->src_cluster == q->dest_cluster;
+
+    size_t target_count = a->node_count + (same ? 1 : 0);
+    SylvesCell* targets = (SylvesCell*)sylves_alloc(sizeof(SylvesCell) * (target_count + 1));
+    q->src_edges = (HpaEdge*)sylves_alloc(sizeof(HpaEdge) * (target_count + 1));
+    q->dest_edges = (HpaEdge*)sylves_alloc(sizeof(HpaEdge) * (b->node_count + 1));
+    if (!targets || !q->src_edges || !q->dest_edges) {
+        sylves_free(targets);
+        return false;
+    }
+
+    for (uint32_t i = 0; i < a->node_count; i++) targets[i] = hpa->nodes[a->nodes[i]].cell;
+    if (same) targets[a->node_count] = q->dest;
+    search_cluster(hpa, q->src_cluster, q->src, targets, target_count);
+    for (uint32_t i = 0; i < a->node_count; i++) {
+        float distance = searched_distance(hpa, targets[i]);
+        if (distance != FLT_MAX) q->src_edges[q->src_edge_count++] = (HpaEdge){ a->nodes[i], distance, false };
+    }
+    if (same) {
+        float distance = searched_distance(hpa, q->dest);
+        if (distance != FLT_MAX) q->src_edges[q->src_edge_count++] = (HpaEdge){ q->dest_id, distance, false };
+    }
+    sylves_free(targets);
+
+    for (uint32_t i = 0; i < b->node_count; i++) {
+        search_cluster(hpa, q->dest_cluster, hpa->nodes[b->nodes[i]].cell, &q->dest, 1);
+        float distance = searched_distance(hpa, q->dest);
+        if (distance != FLT_MAX) q->dest_edges[q->dest_edge_count++] = (HpaEdge){ b->nodes[i], distance, false };
+    }
+    return true;
+}
+
+static bool abstract_search(SylvesHierarchicalPathfinding* hpa, const HpaQuery* q) {
+    if (++hpa->generation == 0) {
+        memset(hpa->stamp, 0, sizeof(uint32_t) * hpa->search_capacity);
+        hpa->generation = 1;
+    }
+    sylves_indexed_heap_clear(hpa->open_set);
+
+    hpa->stamp[q->src_id] = hpa->generation;
+    hpa->g[q->src_id] = 0.0f;
+    float h = hpa->heuristic ? hpa->heuristic(q->src, q->dest, hpa->user_data) : 0.0f;
+    sylves_indexed_heap_push(hpa->open_set, (uint32_t)q->src_id, h);
+
+    uint32_t handle;
+    while (sylves_indexed_heap_pop(hpa->open_set, &handle, NULL)) {
+        int32_t current = (int32_t)handle;
+        if (current == q->dest_id) return true;
+
+        if (current == q->src_id) {
+            for (size_t i = 0; i < q->src_edge_count; i++) relax(hpa, q, current, &q->src_edges[i]);
+            continue;
+        }
+
+        const HpaNode* node = &hpa->nodes[current];
+        for (uint32_t i = 0; i < node->edge_count; i++) relax(hpa, q, current, &node->edges[i]);
+        if (node->cluster == q->dest_cluster) {
+            for (size_t i = 0; i < q->dest_edge_count; i++) {
+                if (q->dest_edges[i].to != current) continue;
+                HpaEdge to_dest = { q->dest_id, q->dest_edges[i].cost, false };
+                relax(hpa, q, current, &to_dest);
+            }
+        }
+    }
+    return false;
+}
+
+/* Expand the abstract path ending at dest into grid steps */
+static SylvesCellPath* refine(SylvesHierarchicalPathfinding* hpa, const HpaQuery* q) {
+    size_t hops = 0;
+    for (int32_t id = q->dest_id; id != q->src_id; id = hpa->parent[id]) hops++;
+    int32_t* ids = (int32_t*)sylves_alloc(sizeof(int32_t) * (hops + 1));
+    if (!ids) return NULL;
+    size_t k = hops + 1;
+    for (int32_t id = q->dest_id; ; id = hpa->parent[id]) {
+        ids[--k] = id;
+        if (id == q->src_id) break;
+    }
+
+    SylvesStep* steps = NULL;
+    size_t step_count = 0, step_capacity = 0;
+    bool ok = true;
+    for (size_t i = 0; i < hops && ok; i++) {
+        SylvesCell from = query_cell(hpa, q, ids[i]);
+        SylvesCell to = query_cell(hpa, q, ids[i + 1]);
+        if (sylves_cell_equals(from, to)) continue;
+
+        if (hpa->parent_inter[ids[i + 1]]) {
+            ok = reserve((void**)&steps, &step_capacity, step_count + 1, sizeof(SylvesStep)) &&
+                 measure_step(hpa, from, to, &steps[step_count]);
+            if (ok) step_count++;
+            continue;
+        }
+
+        int32_t cluster = ids[i] == q->src_id ? q->src_cluster : hpa->nodes[ids[i]].cluster;
+        search_cluster(hpa, cluster, from, &to, 1);
+        SylvesCellPath* segment = sylves_path_map_extract(&hpa->search.nodes, to);
+        ok = segment && reserve((void**)&steps, &step_capacity, step_count + segment->step_count, sizeof(SylvesStep));
+        if (ok && segment->step_count > 0) {
+            memcpy(steps + step_count, segment->steps, sizeof(SylvesStep) * segment->step_count);
+            step_count += segment->step_count;
+        }
+        sylves_cell_path_destroy(segment);
+    }
+
+    SylvesCellPath* path = ok ? sylves_cell_path_create(steps, step_count) : NULL;
+    sylves_free(steps);
+    sylves_free(ids);
+    return path;
+}
+
+SylvesCellPath* sylves_hpa_find_path(
+    SylvesHierarchicalPathfinding* hpa,
+    SylvesCell src,
+    SylvesCell dest) {
+
+    if (!hpa) return NULL;
+
+    if (hpa->path_cache) {
+        SylvesCellPath* cached = sylves_path_cache_get(hpa->path_cache, &src, &dest);
+        if (cached) return sylves_cell_path_create(cached->steps, cached->step_count);
+    }
+
+    HpaQuery q;
+    memset(&q, 0, sizeof(q));
+    q.src = src;
+    q.dest = dest;
+    q.src_cluster = cluster_of(hpa, src);
+    q.dest_cluster = cluster_of(hpa, dest);
+    if (q.src_cluster < 0 || q.dest_cluster < 0 || !reserve_search(hpa)) return NULL;
+    if (sylves_cell_equals(src, dest)) return sylves_cell_path_create(NULL, 0);
+    q.src_id = (int32_t)hpa->node_count;
+    q.dest_id = (int32_t)hpa->node_count + 1;
+
+    SylvesCellPath* path = NULL;
+    if (connect_query(hpa, &q) && abstract_search(hpa, &q)) {
+        path = refine(hpa, &q);
+    }
+    sylves_free(q.src_edges);
+    sylves_free(q.dest_edges);
+
+    if (path && hpa->path_cache) {
+        SylvesCellPath* copy = sylves_cell_path_create(path->steps, path->step_count);
+        if (copy && sylves_path_cache_put(hpa->path_cache, &src, &dest, copy) != SYLVES_SUCCESS) {
+            sylves_cell_path_destroy(copy);
+        }
+    }
+    return path;
+}
+
+/* Incremental updates */
+
+typedef struct HpaRegion {
+    const SylvesHierarchicalPathfinding* hpa;
+    const int32_t* clusters;
+    size_t count;
+} HpaRegion;
+
+static bool in_dirty_cluster(SylvesCell cell, void* user_data) {
+    const HpaRegion* region = (const HpaRegion*)user_data;
+    int32_t cluster = cluster_of(region->hpa, cell);
+    for (size_t i = 0; i < region->count; i++) {
+        if (region->clusters[i] == cluster) return true;
+    }
+    return false;
+}
+
+static bool add_unique(int32_t** items, size_t* count, size_t* capacity, const int32_t* item, size_t width) {
+    for (size_t i = 0; i < *count; i += width) {
+        if (memcmp(*items + i, item, sizeof(int32_t) * width) == 0) return true;
+    }
+    if (!reserve((void**)items, capacity, *count + width, sizeof(int32_t))) return false;
+    memcpy(*items + *count, item, sizeof(int32_t) * width);
+    *count += width;
+    return true;
+}
+
+SylvesError sylves_hpa_notify_cells_changed(
+    SylvesHierarchicalPathfinding* hpa,
+    const SylvesCell* cells,
+    size_t cell_count) {
+
+    if (!hpa || (!cells && cell_count > 0)) return SYLVES_ERROR_INVALID_ARGUMENT;
+
+    int32_t* dirty = NULL;      // clusters whose in-cluster edges are recomputed
+    int32_t* borders = NULL;    // cluster pairs whose entrances are rebuilt
+    size_t dirty_count = 0, dirty_capacity = 0;
+    size_t border_count = 0, border_capacity = 0;
+    HpaCrossing* crossings = NULL;
+    size_t crossing_capacity = 0;
+    bool ok = true;
+
+    for (size_t i = 0; i < cell_count && ok; i++) {
+        int32_t a = cluster_of(hpa, cells[i]);
+        if (a < 0) continue;
+        ok = add_unique(&dirty, &dirty_count, &dirty_capacity, &a, 1);
+
+        // A changed cell beside another cluster may change the entrances on that border
+        SylvesCellDir stack_dirs[16];
+        SylvesCellDir* dirs;
+        int dir_count = get_dirs(hpa->grid, cells[i], stack_dirs, 16, &dirs);
+        for (int d = 0; d < dir_count && ok; d++) {
+            SylvesCell n;
+            if (!sylves_grid_try_move(hpa->grid, cells[i], dirs[d], &n, NULL, NULL)) continue;
+            int32_t b = cluster_of(hpa, n);
+            if (b < 0 || b == a) continue;
+            int32_t pair[2] = { a < b ? a : b, a < b ? b : a };
+            ok = add_unique(&borders, &border_count, &border_capacity, pair, 2);
+        }
+        if (dirs != stack_dirs) sylves_free(dirs);
+    }
+
+    for (size_t i = 0; i < border_count && ok; i += 2) {
+        remove_border(hpa, borders[i], borders[i + 1]);
+        ok = build_entrances(hpa, borders[i], borders[i + 1], &crossings, &crossing_capacity) &&
+             add_unique(&dirty, &dirty_count, &dirty_capacity, &borders[i], 1) &&
+             add_unique(&dirty, &dirty_count, &dirty_capacity, &borders[i + 1], 1);
+    }
+    for (size_t i = 0; i < dirty_count && ok; i++) {
+        ok = build_cluster_edges(hpa, dirty[i]);
+    }
+
+    if (hpa->path_cache && dirty_count > 0) {
+        HpaRegion region = { hpa, dirty, dirty_count };
+        sylves_path_cache_invalidate_region(hpa->path_cache, in_dirty_cluster, &region);
+    }
+
+    sylves_free(dirty);
+    sylves_free(borders);
+    sylves_free(crossings);
+    return ok ? SYLVES_SUCCESS : SYLVES_ERROR_OUT_OF_MEMORY;
+}
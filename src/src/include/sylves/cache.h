@@ -17,12 +17,17 @@ extern "C" {
 
 /**
  * Cache eviction policies
+ *
+ * Every policy picks its victim in constant time.
  */
 typedef enum SylvesCachePolicy {
-    SYLVES_CACHE_POLICY_LRU,      /**< Least Recently Used */
-    SYLVES_CACHE_POLICY_LFU,      /**< Least Frequently Used */
+    SYLVES_CACHE_POLICY_LRU,      /**< Least Recently Used, approximated by CLOCK (second chance) */
+    SYLVES_CACHE_POLICY_LFU,      /**< Least Frequently Used, oldest first among equals */
     SYLVES_CACHE_POLICY_FIFO,     /**< First In First Out */
-    SYLVES_CACHE_POLICY_RANDOM    /**< Random eviction */
+    SYLVES_CACHE_POLICY_RANDOM,   /**< Random eviction */
+    SYLVES_CACHE_POLICY_TINYLFU   /**< W-TinyLFU: a small LRU window in front of a segmented LRU
+                                       main area that only admits keys looked up more often than
+                                       its own victim; resists scans */
 } SylvesCachePolicy;
 
 /**
@@ -40,6 +45,12 @@ typedef struct SylvesCacheStats {
 
 /**
  * Cache configuration
+ *
+ * Thread-safe caches split their keys over independently locked shards.
+ * Lookups take a shard's lock shared, so concurrent hits do not serialise,
+ * except under LFU and TinyLFU whose hits reorder the shard and take it
+ * exclusively. The entry and memory limits are divided evenly between
+ * shards.
  */
 typedef struct SylvesCacheConfig {
     size_t max_entries;           /**< Maximum number of entries (0 for unlimited) */
@@ -47,6 +58,7 @@ typedef struct SylvesCacheConfig {
     SylvesCachePolicy policy;     /**< Eviction policy */
     bool thread_safe;             /**< Enable thread safety */
     bool track_stats;             /**< Enable statistics tracking */
+    size_t shard_count;           /**< Lock shards when thread_safe (0 for default, rounded to a power of two) */
 } SylvesCacheConfig;
 
 /**
@@ -99,10 +111,22 @@ typedef void (*SylvesCacheDestroyFunc)(void* value);
  */
 typedef size_t (*SylvesCacheSizeFunc)(const void* value);
 
+/**
+ * Entry selection function
+ * @param key Entry key
+ * @param value Entry value
+ * @param user_data User data
+ * @return true to select the entry
+ */
+typedef bool (*SylvesCacheEntryPredicate)(const void* key, const void* value, void* user_data);
+
 /* General cache functions */
 
 /**
  * Create a cache with configuration
+ *
+ * Keys are copied into their entries. Without hash_func and compare_func,
+ * keys are hashed and compared bytewise with no calls through pointers.
  * @param config Cache configuration
  * @param key_size Size of keys in bytes
  * @param hash_func Hash function for keys (NULL for default)
@@ -151,6 +175,19 @@ SYLVES_EXPORT SylvesError sylves_cache_put(SylvesCache* cache, const void* key,
  */
 SYLVES_EXPORT SylvesError sylves_cache_remove(SylvesCache* cache, const void* key);
 
+/**
+ * Remove every entry a predicate selects
+ * @param cache Cache
+ * @param predicate Called once per entry, under the entry's shard lock
+ * @param user_data User data for predicate
+ * @return Number of entries removed
+ */
+SYLVES_EXPORT size_t sylves_cache_remove_if(
+    SylvesCache* cache,
+    SylvesCacheEntryPredicate predicate,
+    void* user_data
+);
+
 /**
  * Clear all entries from cache
  * @param cache Cache
@@ -302,8 +339,21 @@ SYLVES_EXPORT SylvesError sylves_path_cache_put(
     SylvesCellPath* path
 );
 
+/**
+ * Path cache invalidation statistics
+ */
+typedef struct SylvesPathCacheInvalidationStats {
+    size_t invalidated;           /**< Paths dropped by invalidation */
+    size_t kept;                  /**< Paths still cached after each invalidation, summed over calls */
+    size_t indexed_cells;         /**< Distinct cells on cached paths */
+} SylvesPathCacheInvalidationStats;
+
 /**
  * Invalidate paths containing a specific cell
+ *
+ * The path cache indexes every cached path by the cells it visits, its
+ * start included, so invalidation only touches the paths through the
+ * changed cells.
  * @param cache Path cache
  * @param cell Cell that changed
  */
@@ -312,6 +362,45 @@ SYLVES_EXPORT void sylves_path_cache_invalidate_cell(
     const SylvesCell* cell
 );
 
+/**
+ * Invalidate paths containing any of several cells
+ * @param cache Path cache
+ * @param cells Cells that changed
+ * @param count Number of cells
+ * @return Number of paths removed
+ */
+SYLVES_EXPORT size_t sylves_path_cache_invalidate_cells(
+    SylvesPathCache* cache,
+    const SylvesCell* cells,
+    size_t count
+);
+
+/**
+ * Invalidate paths that pass through a region
+ *
+ * in_region is called once per distinct cell on a cached path, with the
+ * cache's index locked, so it must not call back into the cache.
+ * @param cache Path cache
+ * @param in_region Returns true for cells inside the region
+ * @param user_data User data for in_region
+ * @return Number of paths removed
+ */
+SYLVES_EXPORT size_t sylves_path_cache_invalidate_region(
+    SylvesPathCache* cache,
+    bool (*in_region)(SylvesCell cell, void* user_data),
+    void* user_data
+);
+
+/**
+ * Get path cache invalidation statistics
+ * @param cache Path cache
+ * @param stats Output statistics
+ */
+SYLVES_EXPORT void sylves_path_cache_get_invalidation_stats(
+    const SylvesPathCache* cache,
+    SylvesPathCacheInvalidationStats* stats
+);
+
 /* Mesh cache functions */
 
 /**
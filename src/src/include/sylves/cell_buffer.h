@@ -0,0 +1,92 @@
+/**
+ * @file cell_buffer.h
+ * @brief Struct-of-arrays cell storage for bulk grid kernels
+ */
+
+#ifndef SYLVES_CELL_BUFFER_H
+#define SYLVES_CELL_BUFFER_H
+
+#include "types.h"
+#include "errors.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Alignment in bytes of every coordinate array in a SylvesCellBuffer
+ */
+#define SYLVES_CELL_BUFFER_ALIGNMENT 64
+
+/**
+ * @brief Cells stored as separate x/y/z arrays
+ *
+ * Each array is SYLVES_CELL_BUFFER_ALIGNMENT-aligned and holds
+ * capacity elements, of which the first count are valid.
+ */
+struct SylvesCellBuffer {
+    int* x;             /**< X coordinates */
+    int* y;             /**< Y coordinates */
+    int* z;             /**< Z coordinates */
+    size_t count;       /**< Number of cells stored */
+    size_t capacity;    /**< Allocated cells per array */
+};
+
+/**
+ * @brief Create an empty cell buffer
+ * @param capacity Initial capacity in cells (may be 0)
+ * @return New buffer, or NULL on allocation failure
+ */
+SylvesCellBuffer* sylves_cell_buffer_create(size_t capacity);
+
+/**
+ * @brief Destroy a cell buffer
+ * @param buffer The buffer to destroy
+ */
+void sylves_cell_buffer_destroy(SylvesCellBuffer* buffer);
+
+/**
+ * @brief Ensure the buffer can hold at least capacity cells
+ * @param buffer The buffer
+ * @param capacity Required capacity
+ * @return Error code
+ */
+SylvesError sylves_cell_buffer_reserve(SylvesCellBuffer* buffer, size_t capacity);
+
+/**
+ * @brief Remove all cells without releasing storage
+ * @param buffer The buffer
+ */
+void sylves_cell_buffer_clear(SylvesCellBuffer* buffer);
+
+/**
+ * @brief Append one cell
+ * @param buffer The buffer
+ * @param cell The cell to append
+ * @return Error code
+ */
+SylvesError sylves_cell_buffer_push(SylvesCellBuffer* buffer, SylvesCell cell);
+
+/**
+ * @brief Append cells from an array-of-structs array
+ * @param buffer The buffer
+ * @param cells Cells to append
+ * @param count Number of cells
+ * @return Error code
+ */
+SylvesError sylves_cell_buffer_append(SylvesCellBuffer* buffer, const SylvesCell* cells,
+                                      size_t count);
+
+/**
+ * @brief Read back one cell
+ * @param buffer The buffer
+ * @param index Index of the cell (must be < count)
+ * @return The cell
+ */
+SylvesCell sylves_cell_buffer_get(const SylvesCellBuffer* buffer, size_t index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SYLVES_CELL_BUFFER_H */
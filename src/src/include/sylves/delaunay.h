@@ -54,8 +54,16 @@ typedef struct SylvesDelaunay {
     /* Hull start for legalize function */
     int hull_start;
     
+    /* Scratch for sorting and legalization */
+    int* ids;              /**< Point indices sorted by distance from the seed */
+    double* dists;         /**< Distance of each point from the seed circumcenter */
+    int* edge_stack;       /**< Pending edges during legalization */
+    int* flip_stack;       /**< Pending edges while repairing moved points */
+    size_t flip_stack_capacity;
+    
     /* Allocation info */
     size_t triangles_capacity;
+    size_t points_capacity; /**< Points the buffers can hold without growing */
 } SylvesDelaunay;
 
 /**
@@ -71,6 +79,51 @@ SylvesDelaunay* sylves_delaunay_create(
     SylvesError* error_out
 );
 
+/**
+ * @brief Re-triangulate a new set of points into an existing triangulation
+ *
+ * Reuses the buffers of the triangulation, growing them only when there
+ * are more points than it has held before, so iterative algorithms such
+ * as Lloyd relaxation can re-triangulate moved points each step without
+ * allocating. The points are referenced, not copied, and must outlive
+ * the triangulation or the next update.
+ *
+ * @param delaunay Triangulation to update
+ * @param points Array of 2D points
+ * @param num_points Number of points
+ * @return SYLVES_SUCCESS, SYLVES_ERROR_INVALID_ARGUMENT, or
+ *         SYLVES_ERROR_OUT_OF_MEMORY, which leaves the triangulation empty
+ */
+SylvesError sylves_delaunay_update(
+    SylvesDelaunay* delaunay,
+    const SylvesVector2* points,
+    size_t num_points
+);
+
+/**
+ * @brief Re-triangulate points that have moved a little, by flipping edges
+ *
+ * The points must be the same ones, in the same order, as the current
+ * triangulation's, at new positions. Triangles the moves turned over are
+ * untangled by local flips; if that leaves every triangle upright and the
+ * hull convex, the triangulation is repaired in place by flipping edges
+ * until it is Delaunay again, which for small moves, such as an iteration
+ * of Lloyd relaxation, touches few edges. Otherwise, or if the current
+ * triangulation left out duplicate points, the points are re-triangulated
+ * from scratch as by sylves_delaunay_update.
+ *
+ * @param delaunay Triangulation to update
+ * @param points The moved points, num_points of them as before
+ * @param rebuilt_out Optional; set to whether a full re-triangulation was needed
+ * @return SYLVES_SUCCESS, SYLVES_ERROR_INVALID_ARGUMENT, or
+ *         SYLVES_ERROR_OUT_OF_MEMORY, which leaves the triangulation empty
+ */
+SylvesError sylves_delaunay_update_moved(
+    SylvesDelaunay* delaunay,
+    const SylvesVector2* points,
+    bool* rebuilt_out
+);
+
 /**
  * @brief Destroy Delaunay triangulation
  * @param delaunay Delaunay triangulation to destroy
@@ -139,6 +139,29 @@ bool sylves_grid_try_move(const SylvesGrid* grid, SylvesCell cell, SylvesCellDir
                           SylvesCell* dest, SylvesCellDir* inverse_dir, 
                           SylvesConnection* connection);
 
+/**
+ * @brief Try many moves at once
+ *
+ * Equivalent to calling sylves_grid_try_move for each (cells[i], dirs[i])
+ * pair, but dispatched through a single vtable call so grids can run a
+ * specialised loop. Entries of dests/inverse_dirs/connections for failed
+ * moves are unspecified.
+ *
+ * @param grid The grid
+ * @param cells Starting cells
+ * @param dirs Direction to move from each cell
+ * @param count Number of moves
+ * @param dests Output: destination cells (optional)
+ * @param inverse_dirs Output: directions back to each start cell (optional)
+ * @param connections Output: connection information (optional)
+ * @param ok_mask Output: per-move success flags (optional)
+ * @return Number of successful moves, or negative error code
+ */
+int sylves_grid_try_move_batch(const SylvesGrid* grid, const SylvesCell* cells,
+                               const SylvesCellDir* dirs, size_t count,
+                               SylvesCell* dests, SylvesCellDir* inverse_dirs,
+                               SylvesConnection* connections, bool* ok_mask);
+
 /**
  * @brief Get all valid directions from a cell
  * @param grid The grid
@@ -194,6 +217,37 @@ SylvesVector3 sylves_grid_get_cell_center(const SylvesGrid* grid, SylvesCell cel
 SylvesVector3 sylves_grid_get_cell_corner(const SylvesGrid* grid, SylvesCell cell,
                                           SylvesCellCorner corner);
 
+/**
+ * @brief Get the center positions of many cells
+ *
+ * Writes cells->count positions as separate coordinate arrays. Grids with a
+ * bulk kernel compute these in vectorisable loops; others fall back to
+ * per-cell sylves_grid_get_cell_center calls.
+ *
+ * @param grid The grid
+ * @param cells Cells to evaluate
+ * @param out_x Output: x coordinates (cells->count entries)
+ * @param out_y Output: y coordinates (cells->count entries)
+ * @param out_z Output: z coordinates (cells->count entries)
+ * @return Number of positions written, or negative error code
+ */
+int sylves_grid_get_cell_centers_soa(const SylvesGrid* grid, const SylvesCellBuffer* cells,
+                                     double* out_x, double* out_y, double* out_z);
+
+/**
+ * @brief Get the position of one corner for many cells
+ * @param grid The grid
+ * @param cells Cells to evaluate
+ * @param corner The corner
+ * @param out_x Output: x coordinates (cells->count entries)
+ * @param out_y Output: y coordinates (cells->count entries)
+ * @param out_z Output: z coordinates (cells->count entries)
+ * @return Number of positions written, or negative error code
+ */
+int sylves_grid_get_cell_corners_soa(const SylvesGrid* grid, const SylvesCellBuffer* cells,
+                                     SylvesCellCorner corner,
+                                     double* out_x, double* out_y, double* out_z);
+
 /**
  * @brief Get the transform (TRS) for a cell
  * @param grid The grid
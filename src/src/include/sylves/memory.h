@@ -71,6 +71,114 @@ void* sylves_calloc(size_t count, size_t size);
  */
 void* sylves_memdup(const void* src, size_t size);
 
+/**
+ * @brief Allocate memory aligned to a power-of-two boundary
+ *
+ * The block comes from the current allocator and must be released with
+ * sylves_aligned_free().
+ */
+void* sylves_aligned_alloc(size_t size, size_t alignment);
+
+/**
+ * @brief Free memory returned by sylves_aligned_alloc
+ */
+void sylves_aligned_free(void* ptr);
+
+/**
+ * @brief Bump-pointer arena for transient scratch memory
+ *
+ * Allocations are carved from chained blocks obtained from the current
+ * allocator and are never freed one by one. Take a mark with
+ * sylves_arena_push() before a query and hand it to sylves_arena_pop()
+ * afterwards to release everything allocated since, in one step. Marks
+ * nest, so a function may push and pop on an arena its caller is using.
+ * An arena is not thread-safe; use one per thread.
+ */
+typedef struct SylvesArena SylvesArena;
+
+/**
+ * @brief Position in an arena returned by sylves_arena_push
+ *
+ * Treat the fields as opaque.
+ */
+typedef struct SylvesArenaMark {
+    void* block;
+    size_t offset;
+    size_t used;
+} SylvesArenaMark;
+
+/**
+ * @brief Alignment of every arena allocation
+ */
+#define SYLVES_ARENA_ALIGNMENT 16
+
+/**
+ * @brief Create an arena
+ *
+ * @param block_size Size of each block (0 for 64 KiB); larger requests
+ *                   get a block of their own
+ */
+SylvesArena* sylves_arena_create(size_t block_size);
+
+/**
+ * @brief Destroy an arena and everything allocated from it
+ */
+void sylves_arena_destroy(SylvesArena* arena);
+
+/**
+ * @brief Allocate from an arena, aligned to SYLVES_ARENA_ALIGNMENT
+ */
+void* sylves_arena_alloc(SylvesArena* arena, size_t size);
+
+/**
+ * @brief Allocate zeroed memory from an arena
+ */
+void* sylves_arena_calloc(SylvesArena* arena, size_t count, size_t size);
+
+/**
+ * @brief Record the current position of an arena
+ */
+SylvesArenaMark sylves_arena_push(const SylvesArena* arena);
+
+/**
+ * @brief Release everything allocated since the mark was taken
+ *
+ * Blocks emptied by the pop are kept for reuse. Marks taken after
+ * @p mark become invalid.
+ */
+void sylves_arena_pop(SylvesArena* arena, SylvesArenaMark mark);
+
+/**
+ * @brief Release every allocation, keeping blocks for reuse
+ */
+void sylves_arena_reset(SylvesArena* arena);
+
+/**
+ * @brief Free the blocks kept for reuse by earlier pops and resets
+ */
+void sylves_arena_trim(SylvesArena* arena);
+
+/**
+ * @brief Get the bytes currently allocated from an arena
+ */
+size_t sylves_arena_get_used(const SylvesArena* arena);
+
+/**
+ * @brief Get the bytes an arena holds in blocks, live or kept for reuse
+ */
+size_t sylves_arena_get_capacity(const SylvesArena* arena);
+
+/**
+ * @brief Get this thread's scratch arena, created on first use
+ *
+ * Library functions that take an optional arena fall back to it. Callers
+ * may use it too, as long as every push is paired with a pop before
+ * returning.
+ *
+ * @return Scratch arena or NULL if it could not be created
+ */
+SylvesArena* sylves_get_thread_scratch_arena(void);
+
 /**
  * @brief Helper macros for type-safe allocation
  */
@@ -206,6 +206,156 @@ SYLVES_EXPORT void* sylves_generic_pool_alloc(SylvesGenericPool* pool, size_t si
  */
 SYLVES_EXPORT void sylves_generic_pool_free(SylvesGenericPool* pool, void* ptr, size_t size);
 
+/* Concurrent pools */
+
+/**
+ * Fixed-size pool that any thread may allocate from and free to, without locks
+ *
+ * Each thread allocates from its own heap inside the pool. A block freed
+ * by the thread that allocated it goes straight back on that heap's free
+ * list; a block freed by any other thread is pushed onto the owning heap's
+ * atomic remote-free stack, which the owner takes in one exchange when its
+ * free list runs dry. Only a thread's first use of a pool takes a lock.
+ * Heaps stay with the pool until it is destroyed, even after their
+ * thread exits.
+ */
+typedef struct SylvesConcurrentPool SylvesConcurrentPool;
+
+/**
+ * Create a concurrent pool
+ * @param block_size Size of each block
+ * @param blocks_per_chunk Blocks carved per heap refill (0 for a default)
+ * @return New concurrent pool or NULL on failure
+ */
+SYLVES_EXPORT SylvesConcurrentPool* sylves_concurrent_pool_create(size_t block_size, size_t blocks_per_chunk);
+
+/**
+ * Destroy a concurrent pool and every block it handed out
+ * @param pool Pool to destroy; no other thread may still be using it
+ */
+SYLVES_EXPORT void sylves_concurrent_pool_destroy(SylvesConcurrentPool* pool);
+
+/**
+ * Allocate a block from the calling thread's heap
+ * @param pool Concurrent pool
+ * @return Pointer to block or NULL on failure
+ */
+SYLVES_EXPORT void* sylves_concurrent_pool_alloc(SylvesConcurrentPool* pool);
+
+/**
+ * Return a block to the heap that allocated it, from any thread
+ * @param pool Concurrent pool
+ * @param ptr Block allocated from this pool
+ */
+SYLVES_EXPORT void sylves_concurrent_pool_free(SylvesConcurrentPool* pool, void* ptr);
+
+/**
+ * Get pool statistics summed over all heaps
+ *
+ * Remote frees count once their owner has taken them back, so
+ * active_allocations may include blocks still waiting on a remote stack.
+ * @param pool Concurrent pool
+ * @param stats Output statistics structure
+ */
+SYLVES_EXPORT void sylves_concurrent_pool_get_stats(SylvesConcurrentPool* pool, SylvesPoolStats* stats);
+
+/* Slab allocator */
+
+/**
+ * Size-class allocator that can back every library allocation
+ *
+ * Requests up to the largest class are rounded up to a ladder of size
+ * classes (16-byte steps to 128 bytes, then four per doubling), each
+ * served by per-thread heaps like SylvesConcurrentPool: allocation and
+ * same-thread frees take no lock, and a block freed on another thread is
+ * queued back to its owner. Larger requests fall through to malloc. A
+ * 16-byte header on every block records where it came from, so free and
+ * realloc need no size.
+ *
+ * Install it with sylves_set_allocator(sylves_slab_allocator_get_interface(slab))
+ * before the library allocates anything, and keep it alive until every
+ * block allocated through it is freed. Building with
+ * SYLVES_DEFAULT_SLAB_ALLOCATOR makes the global slab the default.
+ */
+typedef struct SylvesSlabAllocator SylvesSlabAllocator;
+
+/**
+ * Create a slab allocator
+ * @param max_block_size Largest request served from size classes (0 for 1024, at most 4096)
+ * @return New slab allocator or NULL on failure
+ */
+SYLVES_EXPORT SylvesSlabAllocator* sylves_slab_allocator_create(size_t max_block_size);
+
+/**
+ * Destroy a slab allocator and every block it handed out
+ * @param slab Slab allocator; must not be the current allocator
+ */
+SYLVES_EXPORT void sylves_slab_allocator_destroy(SylvesSlabAllocator* slab);
+
+/**
+ * Get the SylvesAllocator that routes to this slab
+ * @param slab Slab allocator
+ * @return Allocator for sylves_set_allocator, valid while the slab lives
+ */
+SYLVES_EXPORT const SylvesAllocator* sylves_slab_allocator_get_interface(SylvesSlabAllocator* slab);
+
+/**
+ * Get the process-wide slab allocator, created on first use and never destroyed
+ * @return Global slab allocator or NULL on failure
+ */
+SYLVES_EXPORT SylvesSlabAllocator* sylves_get_global_slab_allocator(void);
+
+/**
+ * Allocate from a slab allocator
+ * @param slab Slab allocator
+ * @param size Requested size
+ * @return Block aligned to two pointers, or NULL
+ */
+SYLVES_EXPORT void* sylves_slab_alloc(SylvesSlabAllocator* slab, size_t size);
+
+/**
+ * Free a block from this slab allocator, from any thread
+ * @param slab Slab allocator
+ * @param ptr Block to free
+ */
+SYLVES_EXPORT void sylves_slab_free(SylvesSlabAllocator* slab, void* ptr);
+
+/**
+ * Resize a block, staying in place while the size class still fits
+ * @param slab Slab allocator
+ * @param ptr Block to resize, or NULL to allocate
+ * @param new_size New size; 0 frees
+ * @return Resized block or NULL
+ */
+SYLVES_EXPORT void* sylves_slab_realloc(SylvesSlabAllocator* slab, void* ptr, size_t new_size);
+
+/**
+ * Get the number of size classes
+ * @param slab Slab allocator
+ * @return Class count; stats index class_count reports malloc pass-through
+ */
+SYLVES_EXPORT size_t sylves_slab_allocator_get_class_count(const SylvesSlabAllocator* slab);
+
+/**
+ * Get the block size of a size class
+ * @param slab Slab allocator
+ * @param class_index Class index
+ * @return Block size, or 0 if out of range
+ */
+SYLVES_EXPORT size_t sylves_slab_allocator_get_class_size(const SylvesSlabAllocator* slab, size_t class_index);
+
+/**
+ * Get statistics for one size class
+ *
+ * class_index == class count reports allocations passed through to malloc
+ * (counts and live bytes only).
+ * @param slab Slab allocator
+ * @param class_index Class index
+ * @param stats Output statistics structure
+ */
+SYLVES_EXPORT void sylves_slab_allocator_get_stats(SylvesSlabAllocator* slab, size_t class_index,
+                                                   SylvesPoolStats* stats);
+
 /* Thread-local pools */
 
 /**
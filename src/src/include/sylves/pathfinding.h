@@ -13,6 +13,7 @@
 #include "grid.h"
 #include "cell.h"
 #include "connection.h"
+#include "memory.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -23,6 +24,8 @@ typedef struct SylvesStep SylvesStep;
 typedef struct SylvesCellPath SylvesCellPath;
 typedef struct SylvesPathfindingContext SylvesPathfindingContext;
 typedef struct SylvesHeap SylvesHeap;
+typedef struct SylvesIndexedHeap SylvesIndexedHeap;
+typedef struct SylvesRadixHeap SylvesRadixHeap;
 
 /**
  * @brief Step in a path between cells
@@ -78,6 +81,18 @@ typedef float (*SylvesStepLengthFunc)(const SylvesStep* step, void* user_data);
  */
 typedef float (*SylvesHeuristicFunc)(SylvesCell cell, void* user_data);
 
+/**
+ * @brief Callback for symmetric heuristics between two cells
+ * 
+ * Used by searches whose goal changes with direction, like bidirectional A*.
+ * 
+ * @param a First cell
+ * @param b Second cell
+ * @param user_data User-provided context
+ * @return Admissible estimate of the distance between a and b
+ */
+typedef float (*SylvesCellDistanceFunc)(SylvesCell a, SylvesCell b, void* user_data);
+
 /* Basic pathfinding functions */
 
 /**
@@ -120,6 +135,87 @@ SylvesError sylves_find_distance(
     void* user_data,
     float* distance);
 
+/* Reusable search state */
+
+/**
+ * @brief Create a pathfinding context
+ * 
+ * A context keeps its node map, node storage and open set between
+ * queries, so repeated searches on the same grid stop allocating once
+ * they have grown to the largest search seen. Each query resets it in
+ * O(1). A context must not be shared by concurrent queries.
+ * 
+ * @param expected_nodes Nodes to reserve up front, or 0 for a small default
+ * @return New context, or NULL on allocation failure
+ */
+SylvesPathfindingContext* sylves_pathfinding_context_create(size_t expected_nodes);
+
+/**
+ * @brief Destroy a pathfinding context
+ * 
+ * @param ctx Context to destroy
+ */
+void sylves_pathfinding_context_destroy(SylvesPathfindingContext* ctx);
+
+/**
+ * @brief Forget all search state in O(1), keeping allocated capacity
+ * 
+ * The *_with_context functions do this themselves at the start of a query.
+ * 
+ * @param ctx Context to reset
+ */
+void sylves_pathfinding_context_reset(SylvesPathfindingContext* ctx);
+
+/**
+ * @brief Find shortest path between two cells using reusable search state
+ * 
+ * Same as sylves_find_path, but searches within ctx instead of
+ * allocating fresh state. Only the returned path is allocated.
+ * 
+ * @param ctx Pathfinding context
+ * @param grid Grid to search
+ * @param src Source cell
+ * @param dest Destination cell
+ * @param is_accessible Optional accessibility check
+ * @param step_lengths Optional step length function
+ * @param user_data User data for callbacks
+ * @return Path from src to dest, or NULL if no path exists
+ */
+SylvesCellPath* sylves_find_path_with_context(
+    SylvesPathfindingContext* ctx,
+    SylvesGrid* grid,
+    SylvesCell src,
+    SylvesCell dest,
+    SylvesIsAccessibleFunc is_accessible,
+    SylvesStepLengthFunc step_lengths,
+    void* user_data);
+
+/**
+ * @brief Find distance between two cells using reusable search state
+ * 
+ * Same as sylves_find_distance without building a path; a warmed-up
+ * context makes this allocation free.
+ * 
+ * @param ctx Pathfinding context
+ * @param grid Grid to search
+ * @param src Source cell
+ * @param dest Destination cell
+ * @param is_accessible Optional accessibility check
+ * @param step_lengths Optional step length function
+ * @param user_data User data for callbacks
+ * @param distance Output distance
+ * @return SYLVES_SUCCESS if path exists, error otherwise
+ */
+SylvesError sylves_find_distance_with_context(
+    SylvesPathfindingContext* ctx,
+    SylvesGrid* grid,
+    SylvesCell src,
+    SylvesCell dest,
+    SylvesIsAccessibleFunc is_accessible,
+    SylvesStepLengthFunc step_lengths,
+    void* user_data,
+    float* distance);
+
 /* Path management */
 
 /**
@@ -295,6 +391,25 @@ SylvesDijkstraPathfinding* sylves_dijkstra_create(
     SylvesStepLengthFunc step_lengths,
     void* user_data);
 
+/**
+ * @brief Create Dijkstra pathfinding context searching from several sources
+ * 
+ * Distances are to the nearest source, and extracted paths start at it.
+ * 
+ * @param grid Grid to search
+ * @param sources Source cells, all at distance 0
+ * @param source_count Number of sources (at least 1)
+ * @param step_lengths Step length function
+ * @param user_data User data for callbacks
+ * @return New Dijkstra context
+ */
+SylvesDijkstraPathfinding* sylves_dijkstra_create_multi_source(
+    SylvesGrid* grid,
+    const SylvesCell* sources,
+    size_t source_count,
+    SylvesStepLengthFunc step_lengths,
+    void* user_data);
+
 /**
  * @brief Run Dijkstra algorithm
  * 
@@ -307,6 +422,24 @@ void sylves_dijkstra_run(
     const SylvesCell* target,
     float max_range);
 
+/**
+ * @brief Run Dijkstra algorithm until every target is settled
+ * 
+ * Stops as soon as the last target's distance is final, or when max_range
+ * is exceeded. Targets that were already settled by an earlier run are
+ * skipped, so runs can be resumed with new targets.
+ * 
+ * @param dijkstra Dijkstra context
+ * @param targets Target cells (pass NULL or 0 targets for all cells)
+ * @param target_count Number of targets
+ * @param max_range Maximum range to search
+ */
+void sylves_dijkstra_run_targets(
+    SylvesDijkstraPathfinding* dijkstra,
+    const SylvesCell* targets,
+    size_t target_count,
+    float max_range);
+
 /**
  * @brief Get computed distances
  * 
@@ -340,6 +473,518 @@ SylvesCellPath* sylves_dijkstra_extract_path(
  */
 void sylves_dijkstra_destroy(SylvesDijkstraPathfinding* dijkstra);
 
+/* Bidirectional A* Pathfinding */
+
+/**
+ * @brief Bidirectional A* pathfinding context
+ * 
+ * Searches forward from the source and backward from the destination,
+ * alternating by frontier size, and stops once neither frontier can
+ * improve on the best meeting point. Backward steps are found with
+ * try_move and re-measured in the forward direction, so asymmetric step
+ * lengths are respected.
+ */
+typedef struct SylvesBidirAStarPathfinding SylvesBidirAStarPathfinding;
+
+/**
+ * @brief Create bidirectional A* pathfinding context
+ * 
+ * @param grid Grid to search
+ * @param src Source cell
+ * @param dest Destination cell
+ * @param step_lengths Step length function (negative lengths block a step)
+ * @param heuristic Optional admissible distance estimate; NULL searches
+ *        like bidirectional Dijkstra
+ * @param user_data User data for callbacks
+ * @return New bidirectional A* context
+ */
+SylvesBidirAStarPathfinding* sylves_bidir_astar_create(
+    SylvesGrid* grid,
+    SylvesCell src,
+    SylvesCell dest,
+    SylvesStepLengthFunc step_lengths,
+    SylvesCellDistanceFunc heuristic,
+    void* user_data);
+
+/**
+ * @brief Run bidirectional A* to completion
+ * 
+ * @param bidir Bidirectional A* context
+ * @return true if dest is reachable from src
+ */
+bool sylves_bidir_astar_run(SylvesBidirAStarPathfinding* bidir);
+
+/**
+ * @brief Get the length of the path found by the last run
+ * 
+ * @param bidir Bidirectional A* context
+ * @param distance Output distance
+ * @return SYLVES_SUCCESS, or SYLVES_ERROR_CELL_NOT_FOUND if no path was found
+ */
+SylvesError sylves_bidir_astar_get_distance(
+    SylvesBidirAStarPathfinding* bidir,
+    float* distance);
+
+/**
+ * @brief Extract the path found by the last run
+ * 
+ * @param bidir Bidirectional A* context
+ * @return Path from src to dest, or NULL if no path exists
+ */
+SylvesCellPath* sylves_bidir_astar_extract_path(SylvesBidirAStarPathfinding* bidir);
+
+/**
+ * @brief Destroy bidirectional A* context
+ * 
+ * @param bidir Context to destroy
+ */
+void sylves_bidir_astar_destroy(SylvesBidirAStarPathfinding* bidir);
+
+/**
+ * @brief Find shortest path between two cells with bidirectional A*
+ * 
+ * Same contract as sylves_find_path; uses the Manhattan heuristic where
+ * sylves_find_path would use A*.
+ * 
+ * @param grid Grid to search
+ * @param src Source cell
+ * @param dest Destination cell
+ * @param is_accessible Optional accessibility check
+ * @param step_lengths Optional step length function
+ * @param user_data User data for callbacks
+ * @return Path from src to dest, or NULL if no path exists
+ */
+SylvesCellPath* sylves_find_path_bidirectional(
+    SylvesGrid* grid,
+    SylvesCell src,
+    SylvesCell dest,
+    SylvesIsAccessibleFunc is_accessible,
+    SylvesStepLengthFunc step_lengths,
+    void* user_data);
+
+/* Jump Point Search */
+
+/**
+ * @brief Jump point search pathfinding context
+ *
+ * Shortest paths on uniform-cost square and cube grids, where every step
+ * costs 1. Instead of queueing each neighbour like A*, the search scans
+ * along straight lines and only queues cells where a path may need to
+ * turn, so open areas cost a handful of expansions. Moves along the
+ * highest axis (y on square grids, z on cube grids) scan every lower axis
+ * as they go, and lower-axis scans stop where an obstacle beside them
+ * ends. On infinite grids each scan stops after SYLVES_JPS_MAX_JUMP cells
+ * and carries on from there.
+ */
+typedef struct SylvesJPSPathfinding SylvesJPSPathfinding;
+
+/**
+ * @brief Precomputed jump distances for JPS+ on a bounded square grid
+ *
+ * Stores, per cell and direction, how far a scan goes before it finds a
+ * jump point or hits a wall, so searches read jumps instead of scanning.
+ * The accessibility mask is sampled once when the table is built; rebuild
+ * it when the mask changes.
+ */
+typedef struct SylvesJPSJumpTable SylvesJPSJumpTable;
+
+/** @brief Longest single scan on an infinite grid */
+#define SYLVES_JPS_MAX_JUMP 64
+
+/**
+ * @brief Create jump point search context
+ *
+ * @param grid Square or cube grid to search
+ * @param src Source cell
+ * @param is_accessible Optional accessibility check
+ * @param user_data User data for callback
+ * @return New JPS context, or NULL for other grid types
+ */
+SylvesJPSPathfinding* sylves_jps_create(
+    SylvesGrid* grid,
+    SylvesCell src,
+    SylvesIsAccessibleFunc is_accessible,
+    void* user_data);
+
+/**
+ * @brief Create jump point search context that reads jumps from a table
+ *
+ * @param table Jump table; must outlive the context
+ * @param src Source cell
+ * @return New JPS context
+ */
+SylvesJPSPathfinding* sylves_jps_create_with_table(
+    const SylvesJPSJumpTable* table,
+    SylvesCell src);
+
+/**
+ * @brief Run jump point search to target
+ *
+ * Each run starts a fresh search from the source.
+ *
+ * @param jps JPS context
+ * @param target Target cell
+ */
+void sylves_jps_run(
+    SylvesJPSPathfinding* jps,
+    SylvesCell target);
+
+/**
+ * @brief Extract path to the target of the last run
+ *
+ * Jumps are expanded back into unit steps.
+ *
+ * @param jps JPS context
+ * @param target Target cell
+ * @return Path to target, or NULL if no path exists
+ */
+SylvesCellPath* sylves_jps_extract_path(
+    SylvesJPSPathfinding* jps,
+    SylvesCell target);
+
+/**
+ * @brief Destroy JPS context
+ *
+ * @param jps Context to destroy
+ */
+void sylves_jps_destroy(SylvesJPSPathfinding* jps);
+
+/**
+ * @brief Precompute jump distances for a static accessibility mask
+ *
+ * @param grid Bounded square grid
+ * @param is_accessible Optional accessibility check, sampled once per cell
+ * @param user_data User data for callback
+ * @return New jump table, or NULL if the grid is not a bounded square grid
+ */
+SylvesJPSJumpTable* sylves_jps_jump_table_create(
+    SylvesGrid* grid,
+    SylvesIsAccessibleFunc is_accessible,
+    void* user_data);
+
+/**
+ * @brief Destroy a jump table
+ *
+ * @param table Table to destroy
+ */
+void sylves_jps_jump_table_destroy(SylvesJPSJumpTable* table);
+
+/**
+ * @brief Find shortest path between two cells with jump point search
+ *
+ * Every step costs 1; falls back to sylves_find_path on grids JPS does
+ * not support.
+ *
+ * @param grid Grid to search
+ * @param src Source cell
+ * @param dest Destination cell
+ * @param is_accessible Optional accessibility check
+ * @param user_data User data for callback
+ * @return Path from src to dest, or NULL if no path exists
+ */
+SylvesCellPath* sylves_find_path_jps(
+    SylvesGrid* grid,
+    SylvesCell src,
+    SylvesCell dest,
+    SylvesIsAccessibleFunc is_accessible,
+    void* user_data);
+
+/* Hierarchical Pathfinding (HPA*) */
+
+/**
+ * @brief Hierarchical pathfinding context
+ *
+ * Splits a finite indexed grid into square (or cubic) clusters of cell
+ * coordinates. Adjacent accessible cells on either side of a cluster
+ * border form entrances. Each run of them becomes one transition (two
+ * if the run is long), whose two cells are abstract nodes linked by the
+ * step between them. Nodes in the same cluster are linked by their
+ * distance inside it, found with Dijkstra. Queries search this abstract
+ * graph with A*, then refine each abstract edge into cells. Paths may
+ * be slightly longer than optimal.
+ */
+typedef struct SylvesHierarchicalPathfinding SylvesHierarchicalPathfinding;
+
+struct SylvesPathCache;
+
+/**
+ * @brief Build the abstract graph for a grid
+ *
+ * @param grid Finite grid with get_index
+ * @param cluster_size Cluster edge length in cells (at least 2)
+ * @param is_accessible Optional accessibility check
+ * @param step_lengths Optional step length function
+ * @param heuristic Optional admissible distance estimate for the abstract search
+ * @param user_data User data for callbacks
+ * @return New context, or NULL if the grid is not finite and indexed
+ */
+SylvesHierarchicalPathfinding* sylves_hpa_create(
+    SylvesGrid* grid,
+    int cluster_size,
+    SylvesIsAccessibleFunc is_accessible,
+    SylvesStepLengthFunc step_lengths,
+    SylvesCellDistanceFunc heuristic,
+    void* user_data);
+
+/**
+ * @brief Destroy hierarchical pathfinding context
+ *
+ * @param hpa Context to destroy
+ */
+void sylves_hpa_destroy(SylvesHierarchicalPathfinding* hpa);
+
+/**
+ * @brief Find a path through the abstract graph
+ *
+ * @param hpa Hierarchical pathfinding context
+ * @param src Source cell
+ * @param dest Destination cell
+ * @return Path from src to dest, or NULL if no path exists
+ */
+SylvesCellPath* sylves_hpa_find_path(
+    SylvesHierarchicalPathfinding* hpa,
+    SylvesCell src,
+    SylvesCell dest);
+
+/**
+ * @brief Repair the abstract graph after accessibility or step lengths changed
+ *
+ * Recomputes the in-cluster edges of each cluster holding a changed
+ * cell. Entrances are rebuilt only on borders that a changed cell
+ * touches, and then the cluster across the border is recomputed too.
+ * Cached paths through any recomputed cluster are dropped.
+ *
+ * @param hpa Hierarchical pathfinding context
+ * @param cells Cells whose accessibility or step lengths changed
+ * @param cell_count Number of cells
+ * @return SYLVES_SUCCESS, or SYLVES_ERROR_OUT_OF_MEMORY
+ */
+SylvesError sylves_hpa_notify_cells_changed(
+    SylvesHierarchicalPathfinding* hpa,
+    const SylvesCell* cells,
+    size_t cell_count);
+
+/**
+ * @brief Serve repeated queries from a path cache
+ *
+ * Found paths are stored in the cache and served from it, and
+ * sylves_hpa_notify_cells_changed invalidates entries through clusters it
+ * recomputes. Pass NULL to detach. The cache must outlive the context or
+ * be detached first.
+ *
+ * @param hpa Hierarchical pathfinding context
+ * @param cache Path cache, or NULL
+ */
+void sylves_hpa_set_path_cache(
+    SylvesHierarchicalPathfinding* hpa,
+    struct SylvesPathCache* cache);
+
+/**
+ * @brief Get the number of abstract nodes
+ *
+ * @param hpa Hierarchical pathfinding context
+ * @return Entrance nodes currently in the abstract graph
+ */
+size_t sylves_hpa_get_node_count(const SylvesHierarchicalPathfinding* hpa);
+
+/* Incremental Replanning (D* Lite) */
+
+/**
+ * @brief D* Lite incremental replanning context
+ *
+ * Keeps a shortest-path tree rooted at the goal, searched backwards, so
+ * that the start may move freely. When cells change accessibility or
+ * cost, sylves_dstar_notify_cell_changed repairs only the part of the
+ * tree whose distances change; the next sylves_dstar_compute expands
+ * those cells instead of searching from scratch. Steps are assumed to
+ * be reversible, as on every grid whose try_move reports inverse dirs.
+ */
+typedef struct SylvesDStarLite SylvesDStarLite;
+
+/**
+ * @brief Create D* Lite context
+ *
+ * @param grid Grid to search
+ * @param start Start cell; moves with sylves_dstar_move_start
+ * @param goal Goal cell
+ * @param is_accessible Optional accessibility check; read again for notified cells
+ * @param step_lengths Optional step length function
+ * @param heuristic Optional consistent distance estimate between two cells
+ * @param user_data User data for callbacks
+ * @return New context, or NULL on allocation failure
+ */
+SylvesDStarLite* sylves_dstar_create(
+    SylvesGrid* grid,
+    SylvesCell start,
+    SylvesCell goal,
+    SylvesIsAccessibleFunc is_accessible,
+    SylvesStepLengthFunc step_lengths,
+    SylvesCellDistanceFunc heuristic,
+    void* user_data);
+
+/**
+ * @brief Destroy D* Lite context
+ *
+ * @param dstar Context to destroy
+ */
+void sylves_dstar_destroy(SylvesDStarLite* dstar);
+
+/**
+ * @brief Bring the search up to date with the start and every notified change
+ *
+ * @param dstar D* Lite context
+ * @return SYLVES_SUCCESS, SYLVES_ERROR_PATH_NOT_FOUND if the goal cannot be
+ *         reached, or SYLVES_ERROR_OUT_OF_MEMORY
+ */
+SylvesError sylves_dstar_compute(SylvesDStarLite* dstar);
+
+/**
+ * @brief Extract the current shortest path from start to goal
+ *
+ * Call after sylves_dstar_compute.
+ *
+ * @param dstar D* Lite context
+ * @return Path, or NULL if the goal cannot be reached
+ */
+SylvesCellPath* sylves_dstar_extract_path(SylvesDStarLite* dstar);
+
+/**
+ * @brief Move the start, e.g. after the unit takes a step
+ *
+ * @param dstar D* Lite context
+ * @param start New start cell
+ */
+void sylves_dstar_move_start(SylvesDStarLite* dstar, SylvesCell start);
+
+/**
+ * @brief Report that a cell's accessibility or step lengths into it changed
+ *
+ * @param dstar D* Lite context
+ * @param cell Changed cell
+ * @return SYLVES_SUCCESS or SYLVES_ERROR_OUT_OF_MEMORY
+ */
+SylvesError sylves_dstar_notify_cell_changed(SylvesDStarLite* dstar, SylvesCell cell);
+
+/**
+ * @brief Total cells expanded by every compute so far
+ *
+ * @param dstar D* Lite context
+ * @return Expansion count
+ */
+size_t sylves_dstar_get_expansions(const SylvesDStarLite* dstar);
+
+/* Flow Fields */
+
+/** @brief Direction stored for goals and for blocked or unreachable cells */
+#define SYLVES_FLOW_FIELD_NO_DIR 0xFF
+
+/**
+ * @brief Callback for the cost of crossing a cell
+ *
+ * @param cell Cell to cross
+ * @param user_data User-provided context
+ * @return Cost per unit of distance (> 0), or negative if the cell is blocked
+ */
+typedef float (*SylvesCellCostFunc)(SylvesCell cell, void* user_data);
+
+/**
+ * @brief Distance to the nearest of many goals, and the direction to step
+ * towards it, for every cell of a finite indexed grid
+ *
+ * Results are dense arrays indexed by sylves_grid_get_index, overwritten
+ * by each compute. Neighbour indices are worked out once at creation:
+ * bounded square grids derive them from the row layout, other grids keep
+ * a table of them. Callbacks run on the field's worker threads and must
+ * be safe to call concurrently.
+ */
+typedef struct SylvesFlowField SylvesFlowField;
+
+/**
+ * @brief Create a flow field for a grid
+ *
+ * @param grid Finite grid with get_index; must outlive the field
+ * @param thread_count Workers including the caller; <= 0 for one per processor
+ * @return New flow field, or NULL if the grid is not finite and indexed
+ */
+SylvesFlowField* sylves_flow_field_create(SylvesGrid* grid, int thread_count);
+
+/**
+ * @brief Destroy a flow field
+ *
+ * @param field Flow field to destroy
+ */
+void sylves_flow_field_destroy(SylvesFlowField* field);
+
+/**
+ * @brief Compute unit-cost distances by parallel wavefront BFS
+ *
+ * Every worker expands its share of the current frontier, claiming cells
+ * with an atomic compare-and-swap, so results do not depend on the
+ * thread count.
+ *
+ * @param field Flow field
+ * @param goals Goal cells; cells outside the grid or blocked are skipped
+ * @param goal_count Number of goals
+ * @param is_accessible Optional accessibility check
+ * @param user_data User data for callback
+ * @return SYLVES_SUCCESS or an error code
+ */
+SylvesError sylves_flow_field_compute_bfs(
+    SylvesFlowField* field,
+    const SylvesCell* goals,
+    size_t goal_count,
+    SylvesIsAccessibleFunc is_accessible,
+    void* user_data);
+
+/**
+ * @brief Compute weighted distances by fast marching
+ *
+ * On square grids this solves the eikonal equation |grad T| = cost, so
+ * distances across open ground follow straight lines instead of
+ * 4-connected staircases. Other grids fall back to Dijkstra with each
+ * step costing the mean of the two cells' costs. Cell costs are sampled
+ * in parallel; the march itself runs on the calling thread.
+ *
+ * @param field Flow field
+ * @param goals Goal cells; cells outside the grid or blocked are skipped
+ * @param goal_count Number of goals
+ * @param cell_costs Optional cell costs; NULL costs 1 everywhere
+ * @param user_data User data for callback
+ * @return SYLVES_SUCCESS or an error code
+ */
+SylvesError sylves_flow_field_compute_fast_marching(
+    SylvesFlowField* field,
+    const SylvesCell* goals,
+    size_t goal_count,
+    SylvesCellCostFunc cell_costs,
+    void* user_data);
+
+/**
+ * @brief Distances from the last compute, FLT_MAX where no goal can be reached
+ *
+ * @param field Flow field
+ * @return One distance per grid index
+ */
+const float* sylves_flow_field_get_distances(const SylvesFlowField* field);
+
+/**
+ * @brief Directions from the last compute: the dir of each cell's lowest neighbour
+ *
+ * @param field Flow field
+ * @return One SylvesCellDir per grid index, or SYLVES_FLOW_FIELD_NO_DIR
+ */
+const uint8_t* sylves_flow_field_get_directions(const SylvesFlowField* field);
+
+/**
+ * @brief Direction to step from a cell towards the nearest goal
+ *
+ * @param field Flow field
+ * @param cell Cell to step from
+ * @param dir Output direction
+ * @return false for goals and for cells that are blocked, unreachable or not in the grid
+ */
+bool sylves_flow_field_get_direction(const SylvesFlowField* field, SylvesCell cell, SylvesCellDir* dir);
+
 /* Breadth-First Search */
 
 /**
@@ -366,7 +1011,7 @@ SylvesBFSPathfinding* sylves_bfs_create(
  * @brief Run BFS algorithm
  * 
  * @param bfs BFS context
- * @param targets Optional target cells
+ * @param targets Optional target cells; the search stops once all are reached
  * @param target_count Number of targets
  * @param max_distance Maximum distance to search
  */
@@ -439,6 +1084,25 @@ SylvesError sylves_kruskal_mst(
     SylvesEdge** edges,
     size_t* edge_count);
 
+/**
+ * @brief Kruskal's minimum spanning tree with caller-provided scratch memory
+ * 
+ * Same as sylves_kruskal_mst, but the cell index, edge list and union-find
+ * live in @p scratch and are popped before returning. The output edges are
+ * still allocated with sylves_alloc.
+ * 
+ * @param scratch Arena for temporary memory, or NULL for the thread's scratch arena
+ */
+SylvesError sylves_kruskal_mst_with_arena(
+    SylvesGrid* grid,
+    const SylvesCell* cells,
+    size_t cell_count,
+    SylvesStepLengthFunc step_lengths,
+    void* user_data,
+    SylvesArena* scratch,
+    SylvesEdge** edges,
+    size_t* edge_count);
+
 /* Cell Outlining */
 
 /**
@@ -466,6 +1130,23 @@ SylvesError sylves_outline_cells(
     SylvesOutlineSegment** segments,
     size_t* segment_count);
 
+/**
+ * @brief Outline a cell region with caller-provided scratch memory
+ * 
+ * Same as sylves_outline_cells, but the cell set and boundary edges live
+ * in @p scratch and are popped before returning. The output segments are
+ * still allocated with sylves_alloc.
+ * 
+ * @param scratch Arena for temporary memory, or NULL for the thread's scratch arena
+ */
+SylvesError sylves_outline_cells_with_arena(
+    SylvesGrid* grid,
+    const SylvesCell* cells,
+    size_t cell_count,
+    SylvesArena* scratch,
+    SylvesOutlineSegment** segments,
+    size_t* segment_count);
+
 /* Priority Queue (Heap) Implementation */
 
 /**
@@ -534,6 +1215,214 @@ bool sylves_heap_is_empty(SylvesHeap* heap);
  */
 void sylves_heap_clear(SylvesHeap* heap);
 
+/* Indexed Priority Queues */
+
+/**
+ * @brief Handle and key of a queued entry
+ */
+typedef struct SylvesQueueEntry {
+    float key;
+    uint32_t handle;
+} SylvesQueueEntry;
+
+/**
+ * @brief 4-ary min-heap of integer handles with decrease-key
+ *
+ * Each handle is queued at most once: pushing a queued handle lowers its
+ * key instead of adding a duplicate. Positions are only trusted when the
+ * entry they point at holds the handle, so clearing is O(1).
+ */
+struct SylvesIndexedHeap {
+    SylvesQueueEntry* entries;
+    size_t size;
+    size_t capacity;
+    uint32_t* positions;        /**< Entry index per handle, validated on use */
+    size_t position_capacity;
+};
+
+/**
+ * @brief Create an indexed heap
+ *
+ * @param initial_capacity Initial entry capacity
+ * @return New heap, or NULL on allocation failure
+ */
+SylvesIndexedHeap* sylves_indexed_heap_create(size_t initial_capacity);
+
+/**
+ * @brief Destroy an indexed heap
+ *
+ * @param heap Heap to destroy
+ */
+void sylves_indexed_heap_destroy(SylvesIndexedHeap* heap);
+
+/**
+ * @brief Queue a handle, or lower its key if it is already queued
+ *
+ * A queued handle with a key at or below the new one is left alone.
+ *
+ * @param heap Heap to push into
+ * @param handle Handle to queue
+ * @param key Priority key
+ * @return false on allocation failure
+ */
+bool sylves_indexed_heap_push(SylvesIndexedHeap* heap, uint32_t handle, float key);
+
+/**
+ * @brief Lower the key of a queued handle
+ *
+ * @param heap Heap holding the handle
+ * @param handle Queued handle
+ * @param key New key, below the current one
+ * @return false if the handle is not queued or key is not lower
+ */
+bool sylves_indexed_heap_decrease_key(SylvesIndexedHeap* heap, uint32_t handle, float key);
+
+/**
+ * @brief Queue a handle, or move it to a new key in either direction
+ *
+ * @param heap Heap to update
+ * @param handle Handle to queue
+ * @param key New priority key
+ * @return false on allocation failure
+ */
+bool sylves_indexed_heap_update(SylvesIndexedHeap* heap, uint32_t handle, float key);
+
+/**
+ * @brief Take a handle out of the heap
+ *
+ * @param heap Heap holding the handle
+ * @param handle Handle to remove
+ * @return false if the handle was not queued
+ */
+bool sylves_indexed_heap_remove(SylvesIndexedHeap* heap, uint32_t handle);
+
+/**
+ * @brief Pop the handle with the smallest key
+ *
+ * @param heap Heap to pop from
+ * @param handle Output handle
+ * @param key Output key (may be NULL)
+ * @return false if the heap is empty
+ */
+bool sylves_indexed_heap_pop(SylvesIndexedHeap* heap, uint32_t* handle, float* key);
+
+/**
+ * @brief Peek at the smallest key
+ *
+ * @param heap Heap to peek at
+ * @param key Output key
+ * @return true if heap is non-empty
+ */
+bool sylves_indexed_heap_peek_key(const SylvesIndexedHeap* heap, float* key);
+
+/**
+ * @brief Check whether a handle is queued
+ */
+bool sylves_indexed_heap_contains(const SylvesIndexedHeap* heap, uint32_t handle);
+
+/**
+ * @brief Check if an indexed heap is empty
+ */
+bool sylves_indexed_heap_is_empty(const SylvesIndexedHeap* heap);
+
+/**
+ * @brief Remove every handle in O(1), keeping capacity
+ */
+void sylves_indexed_heap_clear(SylvesIndexedHeap* heap);
+
+/** @brief Bucket count of a radix heap: one for the last key, one per differing bit */
+#define SYLVES_RADIX_BUCKETS 33
+
+/**
+ * @brief Location of a queued handle inside a radix heap
+ */
+typedef struct SylvesRadixPosition {
+    uint32_t bucket;
+    uint32_t slot;
+} SylvesRadixPosition;
+
+/**
+ * @brief Monotone radix heap of integer handles with decrease-key
+ *
+ * Keys must be non-negative and never below the last popped key, which
+ * holds for Dijkstra with non-negative step lengths. Keys are bucketed by
+ * the highest bit in which they differ from the last popped key, so each
+ * entry moves between buckets at most 32 times and a pop does no
+ * comparisons beyond the bucket it refills from. Integer step lengths
+ * keep most entries in the low buckets. Like SylvesIndexedHeap, each
+ * handle is queued at most once and clearing is O(1).
+ */
+struct SylvesRadixHeap {
+    SylvesQueueEntry* buckets[SYLVES_RADIX_BUCKETS];
+    uint32_t bucket_size[SYLVES_RADIX_BUCKETS];
+    uint32_t bucket_capacity[SYLVES_RADIX_BUCKETS];
+    size_t size;
+    float last_key;             /**< Last popped key; pushes below it are raised to it */
+    SylvesRadixPosition* positions;
+    size_t position_capacity;
+};
+
+/**
+ * @brief Create a radix heap
+ *
+ * @return New heap, or NULL on allocation failure
+ */
+SylvesRadixHeap* sylves_radix_heap_create(void);
+
+/**
+ * @brief Destroy a radix heap
+ *
+ * @param heap Heap to destroy
+ */
+void sylves_radix_heap_destroy(SylvesRadixHeap* heap);
+
+/**
+ * @brief Queue a handle, or lower its key if it is already queued
+ *
+ * Keys below the last popped key are raised to it, keeping the heap
+ * monotone.
+ *
+ * @param heap Heap to push into
+ * @param handle Handle to queue
+ * @param key Non-negative priority key
+ * @return false on allocation failure
+ */
+bool sylves_radix_heap_push(SylvesRadixHeap* heap, uint32_t handle, float key);
+
+/**
+ * @brief Pop the handle with the smallest key
+ *
+ * @param heap Heap to pop from
+ * @param handle Output handle
+ * @param key Output key (may be NULL)
+ * @return false if the heap is empty
+ */
+bool sylves_radix_heap_pop(SylvesRadixHeap* heap, uint32_t* handle, float* key);
+
+/**
+ * @brief Peek at the smallest key
+ *
+ * @param heap Heap to peek at
+ * @param key Output key
+ * @return true if heap is non-empty
+ */
+bool sylves_radix_heap_peek_key(SylvesRadixHeap* heap, float* key);
+
+/**
+ * @brief Check whether a handle is queued
+ */
+bool sylves_radix_heap_contains(const SylvesRadixHeap* heap, uint32_t handle);
+
+/**
+ * @brief Check if a radix heap is empty
+ */
+bool sylves_radix_heap_is_empty(const SylvesRadixHeap* heap);
+
+/**
+ * @brief Remove every handle and reset the last key to 0, keeping capacity
+ */
+void sylves_radix_heap_clear(SylvesRadixHeap* heap);
+
 #ifdef __cplusplus
 }
 #endif
@@ -9,6 +9,7 @@
 #include "sylves/grid.h"
 #include "sylves/mesh_data.h"
 #include "sylves/bounds.h"
+#include "sylves/cache.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -46,9 +47,14 @@ typedef struct {
  */
 typedef enum {
     SYLVES_CACHE_NONE = 0,      /**< Don't cache chunks */
-    SYLVES_CACHE_LRU = 1,        /**< LRU cache with limited size */
+    SYLVES_CACHE_LRU = 1,        /**< LRU cache bounded by chunk count and bytes */
     SYLVES_CACHE_ALWAYS = 2,     /**< Cache all chunks (unbounded) */
-} SylvesCachePolicy;
+} SylvesChunkCachePolicy;
+
+/**
+ * @brief Default chunk limit of a SYLVES_CACHE_LRU grid
+ */
+#define SYLVES_CHUNK_CACHE_DEFAULT_MAX_CHUNKS 100
 
 /**
  * @brief Create a planar lazy mesh grid with rectangular chunks
@@ -74,7 +80,7 @@ SylvesGrid* sylves_planar_lazy_mesh_grid_create(
     bool translate_mesh_data,
     const SylvesMeshGridOptions* options,
     const SylvesBound* bound,
-    SylvesCachePolicy cache_policy,
+    SylvesChunkCachePolicy cache_policy,
     void* user_data
 );
 
@@ -98,7 +104,7 @@ SylvesGrid* sylves_planar_lazy_mesh_grid_create_square(
     bool translate_mesh_data,
     const SylvesMeshGridOptions* options,
     const SylvesBound* bound,
-    SylvesCachePolicy cache_policy,
+    SylvesChunkCachePolicy cache_policy,
     void* user_data
 );
 
@@ -122,10 +128,161 @@ SylvesGrid* sylves_planar_lazy_mesh_grid_create_hex(
     bool translate_mesh_data,
     const SylvesMeshGridOptions* options,
     const SylvesBound* bound,
-    SylvesCachePolicy cache_policy,
+    SylvesChunkCachePolicy cache_policy,
     void* user_data
 );
 
+/**
+ * @brief Get the chunk holding a cell
+ * 
+ * @param grid Planar lazy mesh grid
+ * @param cell Cell in the grid
+ * @return Chunk coordinates (z is always 0)
+ */
+SylvesCell sylves_planar_lazy_mesh_grid_get_chunk(const SylvesGrid* grid, SylvesCell cell);
+
+/**
+ * @brief Bound the chunk cache of a SYLVES_CACHE_LRU grid
+ * 
+ * When a new chunk would exceed either limit, unpinned chunks are evicted
+ * in approximately least recently used order: a second-chance clock, so
+ * that lookups from several threads never contend on a shared list. The
+ * newest chunk and pinned chunks are always kept, so a cache can run over
+ * its limits while they are in use. An evicted chunk that a concurrent
+ * lookup may still be reading counts against max_bytes until it is
+ * freed. Lowering the limits evicts immediately. Other policies ignore
+ * them.
+ * 
+ * @param grid Planar lazy mesh grid
+ * @param max_chunks Maximum cached chunks (0 for unlimited)
+ * @param max_bytes Maximum estimated bytes held by cached chunks (0 for unlimited)
+ * @return SYLVES_SUCCESS, or SYLVES_ERROR_INVALID_ARGUMENT if grid is not a planar lazy mesh grid
+ */
+SylvesError sylves_planar_lazy_mesh_grid_set_cache_limits(
+    SylvesGrid* grid,
+    size_t max_chunks,
+    size_t max_bytes
+);
+
+/**
+ * @brief Pin a chunk so it is never evicted, generating it if needed
+ * 
+ * Pins nest; each must be matched by sylves_planar_lazy_mesh_grid_unpin_chunk.
+ * 
+ * @param grid Planar lazy mesh grid with a caching policy
+ * @param chunk_cell Chunk coordinates
+ * @return SYLVES_SUCCESS, SYLVES_ERROR_INVALID_ARGUMENT for SYLVES_CACHE_NONE
+ *         grids, or SYLVES_ERROR_NOT_FOUND if the chunk could not be generated
+ */
+SylvesError sylves_planar_lazy_mesh_grid_pin_chunk(SylvesGrid* grid, SylvesCell chunk_cell);
+
+/**
+ * @brief Release one pin on a chunk
+ * 
+ * Only pins taken by sylves_planar_lazy_mesh_grid_pin_chunk are released;
+ * an unpin with none outstanding is ignored. A chunk whose last pin is
+ * released becomes the most recently used and may be evicted to bring the
+ * cache back within its limits.
+ * 
+ * @param grid Planar lazy mesh grid
+ * @param chunk_cell Chunk coordinates
+ */
+void sylves_planar_lazy_mesh_grid_unpin_chunk(SylvesGrid* grid, SylvesCell chunk_cell);
+
+/**
+ * @brief Get chunk cache statistics
+ * 
+ * total_entries describes the chunks currently cached, and memory_used
+ * also counts evicted chunks a concurrent lookup kept from being freed yet;
+ * hits, misses and evictions count since the grid was created. A miss is
+ * every chunk generation. average_access_time_us is not tracked.
+ * 
+ * @param grid Planar lazy mesh grid
+ * @param stats Output statistics
+ */
+void sylves_planar_lazy_mesh_grid_get_cache_stats(const SylvesGrid* grid, SylvesCacheStats* stats);
+
+/**
+ * @brief How grid queries treat a chunk that is not built yet
+ */
+typedef enum {
+    SYLVES_CHUNK_LOOKUP_BLOCK = 0,       /**< Build it, or wait for its background build */
+    SYLVES_CHUNK_LOOKUP_NONBLOCKING = 1, /**< Queue a background build and report the cell as missing */
+} SylvesChunkLookupMode;
+
+/**
+ * @brief Build state of a chunk
+ */
+typedef enum {
+    SYLVES_CHUNK_NOT_LOADED = 0,  /**< Never built, or evicted */
+    SYLVES_CHUNK_BUILDING = 1,    /**< Queued or being generated */
+    SYLVES_CHUNK_READY = 2,       /**< Cached and ready for queries */
+    SYLVES_CHUNK_FAILED = 3,      /**< Generation returned no mesh */
+} SylvesChunkState;
+
+/**
+ * @brief Generate chunks on background workers
+ *
+ * Chunks missed by nonblocking queries and chunks requested with
+ * sylves_planar_lazy_mesh_grid_prefetch_region are then built by a pool
+ * of workers, so get_mesh_data may be called from several threads at
+ * once and must be thread-safe. In SYLVES_CHUNK_LOOKUP_NONBLOCKING mode
+ * a query on a chunk that is not ready fails as if the cell were outside
+ * the grid: is_cell_in_grid and try_move return false, get_polygon
+ * returns -1 and get_cell_center returns the origin.
+ *
+ * Queries are safe to make from several threads whether or not async
+ * generation is enabled, so worker threads can share one grid. Lookups
+ * of cached chunks take no lock, and each chunk is generated by exactly
+ * one thread while others needing it wait. Calling this again only
+ * changes the lookup mode.
+ *
+ * @param grid Planar lazy mesh grid with a caching policy
+ * @param worker_count Number of workers (0 for one per processor)
+ * @param mode Lookup mode for grid queries
+ * @return SYLVES_SUCCESS, SYLVES_ERROR_INVALID_ARGUMENT for SYLVES_CACHE_NONE
+ *         grids, or SYLVES_ERROR_OUT_OF_MEMORY if the workers could not be started
+ */
+SylvesError sylves_planar_lazy_mesh_grid_enable_async(
+    SylvesGrid* grid,
+    int worker_count,
+    SylvesChunkLookupMode mode
+);
+
+/**
+ * @brief Start building every chunk whose bounding box overlaps a region
+ *
+ * With async generation enabled the chunks are queued and this returns
+ * at once; otherwise they are built before it returns. Only the x and y
+ * extents of the region are used. Prefetched chunks count against the
+ * cache limits like any other, so prefetching more than the cache holds
+ * evicts the earliest of them.
+ *
+ * @param grid Planar lazy mesh grid with a caching policy
+ * @param region Region to cover
+ * @return Number of chunks that were not already cached or building
+ */
+size_t sylves_planar_lazy_mesh_grid_prefetch_region(SylvesGrid* grid, const SylvesAabb* region);
+
+/**
+ * @brief Get the build state of a chunk without building it
+ */
+SylvesChunkState sylves_planar_lazy_mesh_grid_get_chunk_state(const SylvesGrid* grid, SylvesCell chunk_cell);
+
+/**
+ * @brief Wait for a chunk's background build to finish
+ *
+ * Does not start a build.
+ *
+ * @return State of the chunk once it is no longer building
+ */
+SylvesChunkState sylves_planar_lazy_mesh_grid_wait_chunk(SylvesGrid* grid, SylvesCell chunk_cell);
+
+/**
+ * @brief Wait until every queued background build has finished
+ */
+void sylves_planar_lazy_mesh_grid_wait_for_builds(SylvesGrid* grid);
+
 /**
  * @brief Initialize default mesh grid options
  */
@@ -36,7 +36,7 @@ typedef struct SylvesSpatialIndexConfig {
     size_t max_depth;                  /**< Maximum tree depth */
     size_t max_items_per_node;         /**< Max items before split */
     bool dynamic_rebalance;            /**< Enable dynamic rebalancing */
-    bool thread_safe;                  /**< Enable thread safety */
+    bool thread_safe;                  /**< Guard with a reader-writer lock; queries run concurrently */
 } SylvesSpatialIndexConfig;
 
 /**
@@ -20,6 +20,7 @@
 
 // Grid system
 #include "cell.h"
+#include "cell_buffer.h"
 #include "cell_type.h"
 #include "grid.h"
 #include "connection.h"
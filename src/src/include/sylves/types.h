@@ -17,6 +17,7 @@ typedef struct SylvesCellType SylvesCellType;
 typedef struct SylvesBound SylvesBound;
 typedef struct SylvesMesh SylvesMesh;
 typedef struct SylvesDeformation SylvesDeformation;
+typedef struct SylvesCellBuffer SylvesCellBuffer;
 
 /**
  * @brief Represents a single cell in a grid
@@ -28,13 +28,56 @@ typedef struct {
     
     /** @brief Whether to pin border points during relaxation */
     bool pin_border_during_relaxation;
+    
+    /** @brief Stop relaxing once no point moves farther than this in an iteration (0 to run every iteration) */
+    double relaxation_tolerance;
+    
+    /** @brief Workers for relaxation, the caller included; <= 0 for one per processor */
+    int relaxation_thread_count;
 } SylvesVoronoiGridOptions;
 
+/**
+ * @brief Statistics of a relaxation run
+ */
+typedef struct {
+    int iterations;            /**< Iterations run, fewer than asked if the tolerance was met */
+    double max_displacement;   /**< Farthest any point moved in the last iteration */
+    int incremental_updates;   /**< Iterations that repaired the previous triangulation by edge flips */
+    int full_rebuilds;         /**< Iterations that re-triangulated from scratch, the first included */
+} SylvesVoronoiRelaxStats;
+
+/**
+ * @brief Reusable Lloyd relaxation engine
+ *
+ * Holds a worker pool and the triangulation and cell buffers of the last
+ * run, so batches of grids can be relaxed without re-creating threads or
+ * re-allocating. Cell centroids are computed in parallel across the
+ * workers. After the first iteration, each re-triangulation repairs the
+ * previous one by edge flips, as points move little between iterations,
+ * and only starts over when a point moved far enough to invalidate it.
+ *
+ * A relaxer runs one relaxation at a time; use one per thread to relax
+ * several point sets at once.
+ */
+typedef struct SylvesVoronoiRelaxer SylvesVoronoiRelaxer;
+
 /**
  * @brief Create a Voronoi grid from a set of points
  * 
  * The Voronoi grid creates cells where each cell contains all points
  * closer to its generating point than to any other generating point.
+ * Cells are the duals of a Delaunay triangulation of the points, clipped
+ * to the clip box; without one, cells on the convex hull are closed by a
+ * margin around the points. Cell i belongs to point i, and neighbors
+ * share an edge, unless a point has no cell: a duplicate, or a point
+ * whose cell lies outside the clip box. Those are skipped and later cells
+ * take their indices.
+ * 
+ * Each Lloyd relaxation iteration moves every point to the centroid of
+ * its cell and re-triangulates. Points are kept inside the clip box, and
+ * without one, points on the convex hull stay where they are.
+ * 
+ * Collinear points have no triangulation, and give no grid.
  * 
  * @param points Array of 2D points that generate the Voronoi cells
  * @param num_points Number of points
@@ -47,6 +90,53 @@ SylvesGrid* sylves_voronoi_grid_create(
     const SylvesVoronoiGridOptions* options
 );
 
+/**
+ * @brief Create a relaxation engine
+ * @param thread_count Workers including the caller; <= 0 for one per processor
+ * @return New relaxer, or NULL on failure
+ */
+SylvesVoronoiRelaxer* sylves_voronoi_relaxer_create(int thread_count);
+
+/**
+ * @brief Destroy a relaxation engine
+ */
+void sylves_voronoi_relaxer_destroy(SylvesVoronoiRelaxer* relaxer);
+
+/**
+ * @brief Apply Lloyd relaxation to points in place
+ * 
+ * Runs options->lloyd_relaxation_iterations iterations, or fewer if
+ * options->relaxation_tolerance is met, with the clip box and pinning of
+ * sylves_voronoi_grid_create. options->relaxation_thread_count is
+ * ignored in favour of the relaxer's workers.
+ * 
+ * @param relaxer Relaxation engine
+ * @param points Points to relax
+ * @param num_points Number of points
+ * @param options Optional configuration (can be NULL for defaults)
+ * @param stats_out Optional statistics of the run
+ * @return SYLVES_SUCCESS, SYLVES_ERROR_INVALID_ARGUMENT, or SYLVES_ERROR_OUT_OF_MEMORY
+ */
+SylvesError sylves_voronoi_relaxer_relax(
+    SylvesVoronoiRelaxer* relaxer,
+    SylvesVector2* points,
+    size_t num_points,
+    const SylvesVoronoiGridOptions* options,
+    SylvesVoronoiRelaxStats* stats_out
+);
+
+/**
+ * @brief Create a Voronoi grid, relaxing with an existing relaxer
+ * 
+ * As sylves_voronoi_grid_create, reusing the relaxer's workers and buffers.
+ */
+SylvesGrid* sylves_voronoi_grid_create_with_relaxer(
+    SylvesVoronoiRelaxer* relaxer,
+    const SylvesVector2* points,
+    size_t num_points,
+    const SylvesVoronoiGridOptions* options
+);
+
 /**
  * @brief Create default Voronoi grid options
  * @return Default options structure
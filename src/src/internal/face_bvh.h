@@ -0,0 +1,48 @@
+/**
+ * @file face_bvh.h
+ * @brief Bounding volume hierarchy over mesh face AABBs
+ */
+
+#ifndef FACE_BVH_H
+#define FACE_BVH_H
+
+#include "sylves/types.h"
+
+
+typedef struct SylvesFaceBvh SylvesFaceBvh;
+
+/* Called for each candidate face; return false to stop the query early */
+typedef bool (*SylvesFaceBvhVisitor)(int face, void* user_data);
+
+/**
+ * @brief Build a BVH over every face of a mesh
+ * Returns NULL on allocation failure or an empty mesh.
+ */
+SylvesFaceBvh* sylves_face_bvh_build(const SylvesMeshData* mesh);
+
+void sylves_face_bvh_destroy(SylvesFaceBvh* bvh);
+
+/**
+ * @brief Whether every mesh vertex shares one z value
+ * Planar BVHs ignore z in all queries.
+ */
+bool sylves_face_bvh_is_planar(const SylvesFaceBvh* bvh);
+
+/* Bounds of a single face, as stored in the BVH; min > max for a face with no vertices */
+const SylvesAabb* sylves_face_bvh_get_face_aabb(const SylvesFaceBvh* bvh, int face);
+
+/* Visit faces whose AABB contains the point (within a small tolerance) */
+void sylves_face_bvh_query_point(const SylvesFaceBvh* bvh, SylvesVector3 point,
+                                 SylvesFaceBvhVisitor visit, void* user_data);
+
+/* Visit faces whose AABB overlaps the box */
+void sylves_face_bvh_query_aabb(const SylvesFaceBvh* bvh, SylvesVector3 min, SylvesVector3 max,
+                                SylvesFaceBvhVisitor visit, void* user_data);
+
+/* Visit faces whose AABB is crossed by the ray within [0, max_distance] */
+void sylves_face_bvh_query_ray(const SylvesFaceBvh* bvh, SylvesVector3 origin,
+                               SylvesVector3 direction, double max_distance,
+                               SylvesFaceBvhVisitor visit, void* user_data);
+
+
+#endif /* FACE_BVH_H */
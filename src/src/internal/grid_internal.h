@@ -56,6 +56,19 @@ typedef struct {
     int (*get_index_count)(const SylvesGrid* grid);
     int (*get_index)(const SylvesGrid* grid, SylvesCell cell);
     SylvesError (*get_cell_by_index)(const SylvesGrid* grid, int index, SylvesCell* cell);
+
+    /* Batch topology (optional; NULL falls back to a try_move loop) */
+    int (*try_move_batch)(const SylvesGrid* grid, const SylvesCell* cells,
+                          const SylvesCellDir* dirs, size_t count,
+                          SylvesCell* dests, SylvesCellDir* inverse_dirs,
+                          SylvesConnection* connections, bool* ok_mask);
+
+    /* Bulk positions over struct-of-arrays cells (optional; NULL falls back to per-cell calls) */
+    void (*get_cell_centers_soa)(const SylvesGrid* grid, const SylvesCellBuffer* cells,
+                                 double* out_x, double* out_y, double* out_z);
+    void (*get_cell_corners_soa)(const SylvesGrid* grid, const SylvesCellBuffer* cells,
+                                 SylvesCellCorner corner,
+                                 double* out_x, double* out_y, double* out_z);
 } SylvesGridVTable;
 
 /* Base grid structure */
@@ -0,0 +1,196 @@
+/**
+ * @file path_search.h
+ * @brief Search state shared by the A*, Dijkstra and BFS pathfinders
+ *
+ * Searches address nodes by integer id through the accessors below; the
+ * map picks one of two layouts when bound to a grid.
+ *
+ * Sparse (any grid): node records live in one contiguous array and a flat
+ * linear-probing table maps cells to their ids. There are no deletions,
+ * so it needs no tombstones. Both arrays grow by doubling, so a search
+ * touching n cells makes O(log n) allocations. Slots are live only when
+ * their generation matches the map's, so a reset bumps one counter
+ * instead of clearing memory.
+ *
+ * Dense (finite grids with get_index): the node id is the grid index and
+ * g, f and the parent direction sit in flat arrays beside a visited
+ * bitset, so the inner loop does no hashing. A list of bitset words
+ * touched keeps reset proportional to the last search, not the grid.
+ */
+
+#ifndef PATH_SEARCH_H
+#define PATH_SEARCH_H
+
+#include "sylves/pathfinding.h"
+#include <stdint.h>
+#include <float.h>
+
+/* Parent direction of a dense node with no step (the source) */
+#define SYLVES_PATH_NO_PARENT 0xFF
+
+typedef struct SylvesPathNode {
+    SylvesCell cell;
+    float g;            /* cost from the source; BFS stores the hop count */
+    float f;            /* g plus heuristic, A* only */
+    SylvesStep step;    /* step that reached this node, valid when has_step */
+    bool has_step;
+} SylvesPathNode;
+
+typedef struct SylvesPathSlot {
+    SylvesCell cell;
+    int32_t node;           /* index into nodes */
+    uint32_t generation;    /* slot is empty unless this matches the map */
+} SylvesPathSlot;
+
+typedef struct SylvesPathNodeMap {
+    /* Sparse layout */
+    SylvesPathSlot* slots;
+    size_t slot_mask;       /* slot count - 1; slot count is a power of two */
+    uint32_t generation;    /* never 0, which marks never-used slots */
+    SylvesPathNode* nodes;
+    size_t node_count;
+    size_t node_capacity;
+
+    bool sparse_only;           /* never bind dense, e.g. for small searches on huge grids */
+
+    /* Dense layout, active while dense_grid is set */
+    const SylvesGrid* dense_grid;
+    size_t dense_capacity;      /* cells the arrays below can hold */
+    float* dense_g;
+    float* dense_f;
+    uint8_t* dense_parent;      /* dir leading back to the parent */
+    uint64_t* dense_visited;    /* one bit per grid index */
+    uint32_t* dense_dirty;      /* words of dense_visited with bits set */
+    size_t dense_dirty_count;
+    size_t dense_dirty_capacity;
+} SylvesPathNodeMap;
+
+/*
+ * Search state reused across queries; public as an opaque type. Node ids
+ * are the queue handles, so each open node has exactly one queue entry.
+ */
+struct SylvesPathfindingContext {
+    SylvesPathNodeMap nodes;
+    SylvesIndexedHeap* open_set;    /* A*; f keys need not be monotone */
+    SylvesRadixHeap* open_radix;    /* Dijkstra; distances are popped in order */
+};
+
+/* FIFO of node indices in a power-of-two ring */
+typedef struct SylvesPathQueue {
+    int32_t* items;
+    size_t mask;
+    size_t head;
+    size_t count;
+} SylvesPathQueue;
+
+bool sylves_path_map_init(SylvesPathNodeMap* map, size_t expected_nodes);
+
+void sylves_path_map_release(SylvesPathNodeMap* map);
+
+/* Forget every node, keeping capacity; O(1) sparse, O(words touched) dense */
+void sylves_path_map_reset(SylvesPathNodeMap* map);
+
+/*
+ * Choose the layout for searches on grid. Call on an empty map. Falls
+ * back to sparse if the grid is not indexed or the arrays cannot be had.
+ */
+void sylves_path_map_bind(SylvesPathNodeMap* map, const SylvesGrid* grid);
+
+/* Returns the node id for a cell, or -1 if it has not been reached */
+int32_t sylves_path_map_find(const SylvesPathNodeMap* map, SylvesCell cell);
+
+/*
+ * Returns the node for a cell, adding it with g = f = FLT_MAX and no step
+ * if missing. Returns -1 on allocation failure or, when dense, for cells
+ * outside the grid.
+ */
+int32_t sylves_path_map_insert(SylvesPathNodeMap* map, SylvesCell cell);
+
+SylvesCell sylves_path_map_cell(const SylvesPathNodeMap* map, int32_t node);
+
+static inline float sylves_path_map_g(const SylvesPathNodeMap* map, int32_t node) {
+    return map->dense_grid ? map->dense_g[node] : map->nodes[node].g;
+}
+
+static inline float sylves_path_map_f(const SylvesPathNodeMap* map, int32_t node) {
+    return map->dense_grid ? map->dense_f[node] : map->nodes[node].f;
+}
+
+static inline void sylves_path_map_set_score(SylvesPathNodeMap* map, int32_t node, float g, float f) {
+    if (map->dense_grid) {
+        map->dense_g[node] = g;
+        map->dense_f[node] = f;
+    } else {
+        map->nodes[node].g = g;
+        map->nodes[node].f = f;
+    }
+}
+
+/* Record the step that reached node; dense maps keep only its inverse dir */
+static inline void sylves_path_map_set_step(SylvesPathNodeMap* map, int32_t node, const SylvesStep* step) {
+    if (map->dense_grid) {
+        map->dense_parent[node] = (uint8_t)step->inverse_dir;
+    } else {
+        map->nodes[node].step = *step;
+        map->nodes[node].has_step = true;
+    }
+}
+
+/* Calls visit for every node reached, in no particular order, until it returns false */
+void sylves_path_map_visit(const SylvesPathNodeMap* map,
+                           bool (*visit)(int32_t node, void* user_data), void* user_data);
+
+/* Dir from node back to its parent; false for roots (sources) */
+static inline bool sylves_path_map_parent_dir(const SylvesPathNodeMap* map, int32_t node, SylvesCellDir* dir) {
+    if (map->dense_grid) {
+        if (map->dense_parent[node] == SYLVES_PATH_NO_PARENT) return false;
+        *dir = (SylvesCellDir)map->dense_parent[node];
+        return true;
+    }
+    if (!map->nodes[node].has_step) return false;
+    *dir = map->nodes[node].step.inverse_dir;
+    return true;
+}
+
+/* Walk parent steps back from target to its root; NULL if target was not reached */
+SylvesCellPath* sylves_path_map_extract(const SylvesPathNodeMap* map, SylvesCell target);
+
+bool sylves_path_context_init(SylvesPathfindingContext* ctx, size_t expected_nodes);
+
+void sylves_path_context_release(SylvesPathfindingContext* ctx);
+
+/* A* over ctx; seed resets it, expand runs until target is popped or the open set drains */
+void sylves_path_astar_seed(SylvesPathfindingContext* ctx, SylvesGrid* grid, SylvesCell src,
+                            SylvesHeuristicFunc heuristic, void* user_data);
+
+void sylves_path_astar_expand(SylvesPathfindingContext* ctx, SylvesGrid* grid, SylvesCell target,
+                              SylvesStepLengthFunc step_lengths, SylvesHeuristicFunc heuristic,
+                              void* user_data);
+
+/*
+ * Dijkstra over ctx from every source at once. Expand stops when all
+ * targets have been settled, or floods out to max_range if there are none.
+ */
+void sylves_path_dijkstra_seed(SylvesPathfindingContext* ctx, SylvesGrid* grid,
+                               const SylvesCell* sources, size_t source_count);
+
+void sylves_path_dijkstra_expand(SylvesPathfindingContext* ctx, SylvesGrid* grid,
+                                 const SylvesCell* targets, size_t target_count, float max_range,
+                                 SylvesStepLengthFunc step_lengths, void* user_data);
+
+bool sylves_path_queue_init(SylvesPathQueue* queue, size_t capacity);
+
+void sylves_path_queue_release(SylvesPathQueue* queue);
+
+bool sylves_path_queue_push(SylvesPathQueue* queue, int32_t node);
+
+static inline bool sylves_path_queue_pop(SylvesPathQueue* queue, int32_t* node) {
+    if (queue->count == 0) return false;
+    *node = queue->items[queue->head];
+    queue->head = (queue->head + 1) & queue->mask;
+    queue->count--;
+    return true;
+}
+
+
+#endif /* PATH_SEARCH_H */
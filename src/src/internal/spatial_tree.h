@@ -0,0 +1,65 @@
+/**
+ * @file spatial_tree.h
+ * @brief Tree backends (R-tree, k-d tree, quadtree/octree) for SylvesSpatialIndex
+ *
+ * All backends share one item store. Items are bulk loaded into the chosen
+ * tree on rebuild; inserts made after that sit in a pending tail that
+ * queries scan linearly until the next rebuild, and removals of tree items
+ * only mark them dead. Rebuilds happen automatically once the pending or
+ * dead share grows past the tree size, so inserts stay amortized O(log n).
+ */
+
+#ifndef SPATIAL_TREE_H
+#define SPATIAL_TREE_H
+
+#include "sylves/spatial_index.h"
+
+
+typedef struct SylvesSpatialTree SylvesSpatialTree;
+
+/**
+ * @brief Create an empty tree
+ * @param type RTREE, KDTREE, QUADTREE or OCTREE
+ * @param dimension 2 or 3; only the first `dimension` axes are split on
+ * @param max_items_per_node Leaf capacity (0 for the backend default)
+ * @param max_depth Depth limit for quadtree/octree subdivision (0 for default)
+ */
+SylvesSpatialTree* sylves_spatial_tree_create(SylvesSpatialIndexType type, int dimension,
+                                              size_t max_items_per_node, size_t max_depth);
+
+void sylves_spatial_tree_destroy(SylvesSpatialTree* tree);
+
+/* Insert or replace the entry for a cell */
+SylvesError sylves_spatial_tree_insert(SylvesSpatialTree* tree, const SylvesCell* cell,
+                                       const SylvesVector3* center, void* data);
+
+/* Insert many entries and bulk load them with a single rebuild */
+SylvesError sylves_spatial_tree_insert_batch(SylvesSpatialTree* tree, const SylvesCell* cells,
+                                             const SylvesVector3* centers, size_t count);
+
+SylvesError sylves_spatial_tree_remove(SylvesSpatialTree* tree, const SylvesCell* cell);
+
+void sylves_spatial_tree_clear(SylvesSpatialTree* tree);
+
+/* Fold pending inserts and removals back into a freshly bulk-loaded tree */
+SylvesError sylves_spatial_tree_rebuild(SylvesSpatialTree* tree);
+
+size_t sylves_spatial_tree_count(const SylvesSpatialTree* tree);
+
+/* Visit entries whose center lies inside the box (inclusive) */
+void sylves_spatial_tree_query_aabb(const SylvesSpatialTree* tree, const SylvesAabb* aabb,
+                                    SylvesCellDataVisitor visitor, void* user_data);
+
+/* Visit entries whose center lies within radius of the point */
+void sylves_spatial_tree_query_radius(const SylvesSpatialTree* tree, const SylvesVector3* center,
+                                      double radius, SylvesCellDataVisitor visitor, void* user_data);
+
+/* Returns false if the tree is empty */
+bool sylves_spatial_tree_find_nearest(const SylvesSpatialTree* tree, const SylvesVector3* point,
+                                      SylvesCell* out_cell, double* out_distance);
+
+/* Fills item_count, node_count, max_depth, average_items_per_node and empty_nodes */
+void sylves_spatial_tree_get_stats(const SylvesSpatialTree* tree, SylvesSpatialIndexStats* stats);
+
+
+#endif /* SPATIAL_TREE_H */
@@ -0,0 +1,242 @@
+/**
+ * @file sync.h
+ * @brief Locks, condition variables and atomics for the concurrent containers
+ *
+ * Thin wrappers over pthread_rwlock_t / SRWLOCK, mutexes and condition
+ * variables so modules share one spelling. Most atomics are
+ * statistics-grade: relaxed ordering, used only for counters and hint
+ * bits that readers update under a shared lock. The u32 compare-and-swap
+ * claims cells in parallel searches, and the acquire/release pair orders
+ * work across thread pool barriers. The pointer operations build
+ * lock-free push-only stacks that a single consumer empties with one
+ * exchange, which sidesteps ABA, and publish structures that readers
+ * walk without a lock. The sequentially consistent counter and fence let
+ * a writer tell when no such reader can still hold a pointer it has
+ * unpublished. The bit scans, undefined for zero, walk the bitsets of
+ * the dense path maps and pick radix queue buckets.
+ */
+
+#ifndef SYNC_H
+#define SYNC_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef _WIN32
+#include <windows.h>
+typedef SRWLOCK SylvesRwLock;
+typedef CRITICAL_SECTION SylvesMutex;
+typedef CONDITION_VARIABLE SylvesCond;
+#else
+#include <pthread.h>
+typedef pthread_rwlock_t SylvesRwLock;
+typedef pthread_mutex_t SylvesMutex;
+typedef pthread_cond_t SylvesCond;
+#endif
+
+static inline void sylves_rwlock_init(SylvesRwLock* lock) {
+#ifdef _WIN32
+    InitializeSRWLock(lock);
+#else
+    pthread_rwlock_init(lock, NULL);
+#endif
+}
+
+static inline void sylves_rwlock_destroy(SylvesRwLock* lock) {
+#ifdef _WIN32
+    (void)lock; /* SRW locks hold no resources */
+#else
+    pthread_rwlock_destroy(lock);
+#endif
+}
+
+static inline void sylves_rwlock_read(SylvesRwLock* lock) {
+#ifdef _WIN32
+    AcquireSRWLockShared(lock);
+#else
+    pthread_rwlock_rdlock(lock);
+#endif
+}
+
+static inline void sylves_rwlock_read_unlock(SylvesRwLock* lock) {
+#ifdef _WIN32
+    ReleaseSRWLockShared(lock);
+#else
+    pthread_rwlock_unlock(lock);
+#endif
+}
+
+static inline void sylves_rwlock_write(SylvesRwLock* lock) {
+#ifdef _WIN32
+    AcquireSRWLockExclusive(lock);
+#else
+    pthread_rwlock_wrlock(lock);
+#endif
+}
+
+static inline void sylves_rwlock_write_unlock(SylvesRwLock* lock) {
+#ifdef _WIN32
+    ReleaseSRWLockExclusive(lock);
+#else
+    pthread_rwlock_unlock(lock);
+#endif
+}
+
+static inline void sylves_mutex_init(SylvesMutex* m) {
+#ifdef _WIN32
+    InitializeCriticalSection(m);
+#else
+    pthread_mutex_init(m, NULL);
+#endif
+}
+
+static inline void sylves_mutex_destroy(SylvesMutex* m) {
+#ifdef _WIN32
+    DeleteCriticalSection(m);
+#else
+    pthread_mutex_destroy(m);
+#endif
+}
+
+static inline void sylves_mutex_lock(SylvesMutex* m) {
+#ifdef _WIN32
+    EnterCriticalSection(m);
+#else
+    pthread_mutex_lock(m);
+#endif
+}
+
+static inline bool sylves_mutex_trylock(SylvesMutex* m) {
+#ifdef _WIN32
+    return TryEnterCriticalSection(m) != 0;
+#else
+    return pthread_mutex_trylock(m) == 0;
+#endif
+}
+
+static inline void sylves_mutex_unlock(SylvesMutex* m) {
+#ifdef _WIN32
+    LeaveCriticalSection(m);
+#else
+    pthread_mutex_unlock(m);
+#endif
+}
+
+static inline void sylves_cond_init(SylvesCond* c) {
+#ifdef _WIN32
+    InitializeConditionVariable(c);
+#else
+    pthread_cond_init(c, NULL);
+#endif
+}
+
+static inline void sylves_cond_destroy(SylvesCond* c) {
+#ifdef _WIN32
+    (void)c; /* condition variables hold no resources */
+#else
+    pthread_cond_destroy(c);
+#endif
+}
+
+static inline void sylves_cond_wait(SylvesCond* c, SylvesMutex* m) {
+#ifdef _WIN32
+    SleepConditionVariableCS(c, m, INFINITE);
+#else
+    pthread_cond_wait(c, m);
+#endif
+}
+
+static inline void sylves_cond_signal(SylvesCond* c) {
+#ifdef _WIN32
+    WakeConditionVariable(c);
+#else
+    pthread_cond_signal(c);
+#endif
+}
+
+static inline void sylves_cond_broadcast(SylvesCond* c) {
+#ifdef _WIN32
+    WakeAllConditionVariable(c);
+#else
+    pthread_cond_broadcast(c);
+#endif
+}
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#define sylves_atomic_add_size(p, v) \
+    ((void)_InterlockedExchangeAdd64((volatile __int64*)(p), (__int64)(v)))
+#define sylves_atomic_add_u64(p, v) \
+    ((void)_InterlockedExchangeAdd64((volatile __int64*)(p), (__int64)(v)))
+#define sylves_atomic_load_u8(p) (*(volatile uint8_t*)(p))
+#define sylves_atomic_store_u8(p, v) (*(volatile uint8_t*)(p) = (uint8_t)(v))
+#define sylves_atomic_cas_u32(p, expected, desired) \
+    (_InterlockedCompareExchange((volatile long*)(p), (long)(desired), (long)(expected)) == (long)(expected))
+#define sylves_atomic_cas_u32_acquire(p, expected, desired) sylves_atomic_cas_u32(p, expected, desired)
+#define sylves_atomic_fetch_add_u32_acq_rel(p, v) \
+    ((uint32_t)_InterlockedExchangeAdd((volatile long*)(p), (long)(v)))
+#define sylves_atomic_load_u32(p) (*(volatile uint32_t*)(p))
+#define sylves_atomic_load_u32_acquire(p) \
+    ((uint32_t)_InterlockedCompareExchange((volatile long*)(p), 0, 0))
+#define sylves_atomic_store_u32_release(p, v) \
+    ((void)_InterlockedExchange((volatile long*)(p), (long)(v)))
+#define sylves_atomic_load_size(p) (*(volatile size_t*)(p))
+#define sylves_atomic_store_size(p, v) (*(volatile size_t*)(p) = (size_t)(v))
+#define sylves_atomic_load_ptr_acquire(p) (*(void* volatile*)(p))
+#define sylves_atomic_cas_ptr_release(p, expected, desired) \
+    (_InterlockedCompareExchangePointer((void* volatile*)(p), (desired), (expected)) == (expected))
+#define sylves_atomic_exchange_ptr_acquire(p, v) _InterlockedExchangePointer((void* volatile*)(p), (v))
+#define sylves_atomic_store_ptr_release(p, v) ((void)_InterlockedExchangePointer((void* volatile*)(p), (v)))
+#define sylves_atomic_add_u32_seq_cst(p, v) ((void)_InterlockedExchangeAdd((volatile long*)(p), (long)(v)))
+#define sylves_atomic_load_u32_seq_cst(p) \
+    ((uint32_t)_InterlockedCompareExchange((volatile long*)(p), 0, 0))
+#define sylves_atomic_fence() MemoryBarrier()
+static inline int sylves_ctz64(uint64_t x) {
+    unsigned long index;
+#if defined(_WIN64)
+    _BitScanForward64(&index, x);
+#else
+    /* _BitScanForward64 is only available on 64-bit targets */
+    if (_BitScanForward(&index, (unsigned long)x)) return (int)index;
+    _BitScanForward(&index, (unsigned long)(x >> 32));
+    index += 32;
+#endif
+    return (int)index;
+}
+static inline int sylves_clz32(uint32_t x) {
+    unsigned long index;
+    _BitScanReverse(&index, x);
+    return 31 - (int)index;
+}
+#else
+#define sylves_atomic_add_size(p, v) ((void)__atomic_fetch_add((p), (v), __ATOMIC_RELAXED))
+#define sylves_atomic_add_u64(p, v) ((void)__atomic_fetch_add((p), (v), __ATOMIC_RELAXED))
+#define sylves_atomic_load_u8(p) __atomic_load_n((p), __ATOMIC_RELAXED)
+#define sylves_atomic_store_u8(p, v) __atomic_store_n((p), (uint8_t)(v), __ATOMIC_RELAXED)
+static inline bool sylves_atomic_cas_u32(uint32_t* p, uint32_t expected, uint32_t desired) {
+    return __atomic_compare_exchange_n(p, &expected, desired, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+}
+static inline bool sylves_atomic_cas_u32_acquire(uint32_t* p, uint32_t expected, uint32_t desired) {
+    return __atomic_compare_exchange_n(p, &expected, desired, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+}
+#define sylves_atomic_fetch_add_u32_acq_rel(p, v) __atomic_fetch_add((p), (v), __ATOMIC_ACQ_REL)
+#define sylves_atomic_load_u32(p) __atomic_load_n((p), __ATOMIC_RELAXED)
+#define sylves_atomic_load_u32_acquire(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define sylves_atomic_store_u32_release(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define sylves_atomic_load_size(p) __atomic_load_n((p), __ATOMIC_RELAXED)
+#define sylves_atomic_store_size(p, v) __atomic_store_n((p), (size_t)(v), __ATOMIC_RELAXED)
+#define sylves_atomic_load_ptr_acquire(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+static inline bool sylves_atomic_cas_ptr_release(void** p, void* expected, void* desired) {
+    return __atomic_compare_exchange_n(p, &expected, desired, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+}
+#define sylves_atomic_exchange_ptr_acquire(p, v) __atomic_exchange_n((p), (v), __ATOMIC_ACQUIRE)
+#define sylves_atomic_store_ptr_release(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define sylves_atomic_add_u32_seq_cst(p, v) ((void)__atomic_fetch_add((p), (v), __ATOMIC_SEQ_CST))
+#define sylves_atomic_load_u32_seq_cst(p) __atomic_load_n((p), __ATOMIC_SEQ_CST)
+#define sylves_atomic_fence() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define sylves_ctz64(x) __builtin_ctzll(x)
+#define sylves_clz32(x) __builtin_clz(x)
+#endif
+
+#endif /* SYNC_H */
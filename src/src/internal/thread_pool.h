@@ -0,0 +1,64 @@
+/**
+ * @file thread_pool.h
+ * @brief Fixed worker pool for data-parallel kernels
+ *
+ * A run hands one task to every worker, the calling thread included as
+ * worker 0, and returns when all of them have finished. Tasks split their
+ * work by worker index and may meet at sylves_thread_pool_barrier, so a
+ * level-by-level algorithm runs as a single task instead of one run per
+ * level. Workers sleep on a condition variable between runs; barriers
+ * spin briefly, then yield.
+ *
+ * A job queue is the asynchronous counterpart: dedicated workers take
+ * submitted jobs in FIFO order while the submitting thread carries on.
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Upper bound on workers, including the caller */
+#define SYLVES_THREAD_POOL_MAX_WORKERS 64
+
+typedef struct SylvesThreadPool SylvesThreadPool;
+
+typedef void (*SylvesThreadTask)(int worker, int worker_count, void* user_data);
+
+/*
+ * Create a pool of worker_count workers, the caller counting as one.
+ * worker_count <= 0 uses one per online processor. Returns NULL on failure.
+ */
+SylvesThreadPool* sylves_thread_pool_create(int worker_count);
+
+void sylves_thread_pool_destroy(SylvesThreadPool* pool);
+
+int sylves_thread_pool_size(const SylvesThreadPool* pool);
+
+/* Run task on every worker and wait; not reentrant */
+void sylves_thread_pool_run(SylvesThreadPool* pool, SylvesThreadTask task, void* user_data);
+
+/* Wait until every worker of the current run reaches the barrier */
+void sylves_thread_pool_barrier(SylvesThreadPool* pool, int worker);
+
+typedef struct SylvesJobQueue SylvesJobQueue;
+
+typedef void (*SylvesJobFunc)(void* user_data);
+
+/*
+ * Create a queue served by worker_count background threads.
+ * worker_count <= 0 uses one per online processor. Returns NULL on failure.
+ */
+SylvesJobQueue* sylves_job_queue_create(int worker_count);
+
+/* Drop jobs that have not started, then wait for the running ones */
+void sylves_job_queue_destroy(SylvesJobQueue* queue);
+
+/* Queue a job; returns false if it could not be queued */
+bool sylves_job_queue_submit(SylvesJobQueue* queue, SylvesJobFunc job, void* user_data);
+
+/* Wait until the queue is empty and no job is running */
+void sylves_job_queue_wait_idle(SylvesJobQueue* queue);
+
+#endif /* THREAD_POOL_H */
@@ -0,0 +1,511 @@
+/**
+ * @file jps_pathfinding.c
+ * @brief Jump point search for uniform-cost square and cube grids, with JPS+ jump tables
+ *
+ * Axes are ordered x < y < z. Shortest paths are taken in a canonical
+ * form where moves along a higher axis come before moves along a lower
+ * one, unless an obstacle forces a turn back up. So a scan along an axis
+ * also scans every lower axis from each cell it passes, and stops at the
+ * cell where one of those finds something. A scan stops on its own where
+ * an obstacle beside it, along a higher axis, ends: the cell past the
+ * obstacle can only be reached canonically by turning there.
+ */
+
+#include "sylves/pathfinding.h"
+#include "sylves/memory.h"
+#include "sylves/errors.h"
+#include "sylves/cell.h"
+#include "sylves/grid.h"
+#include "sylves/square_grid.h"
+#include "sylves/cube_grid.h"
+#include "internal/path_search.h"
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <float.h>
+
+#define JPS_MAX_AXES 3
+
+/* Jump table slots per cell: +x, -x, +y, -y */
+#define JPS_TABLE_SLOTS 4
+
+struct SylvesJPSJumpTable {
+    SylvesGrid* grid;
+    int min_x, min_y;
+    int width, height;
+    uint8_t* open;      /* accessibility per grid index */
+    int32_t* jumps;     /* per index and slot: > 0 jump point that far, else -(free cells to the wall) */
+};
+
+/* JPS pathfinding context */
+struct SylvesJPSPathfinding {
+    SylvesGrid* grid;
+    SylvesCell src;
+    SylvesCell target;
+    SylvesIsAccessibleFunc is_accessible;
+    void* user_data;
+    const SylvesJPSJumpTable* table;    /* replaces is_accessible and scanning when set */
+
+    int axis_count;
+    SylvesCellDir dirs[JPS_MAX_AXES][2];   /* [axis][0] moves +1, [axis][1] moves -1 */
+    int max_jump;                           /* longest scan; INT_MAX on finite grids */
+
+    SylvesPathfindingContext search;
+};
+
+static inline SylvesCell cell_offset(SylvesCell cell, int axis, int delta) {
+    if (axis == 0) cell.x += delta;
+    else if (axis == 1) cell.y += delta;
+    else cell.z += delta;
+    return cell;
+}
+
+static inline int cell_coord(SylvesCell cell, int axis) {
+    return axis == 0 ? cell.x : axis == 1 ? cell.y : cell.z;
+}
+
+static inline bool same_cell(SylvesCell a, SylvesCell b) {
+    return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+static float manhattan(SylvesCell a, SylvesCell b) {
+    return (float)(abs(a.x - b.x) + abs(a.y - b.y) + abs(a.z - b.z));
+}
+
+/* Map each axis to its grid dirs; false for grids without axis-aligned unit moves */
+static bool init_axes(SylvesJPSPathfinding* jps) {
+    switch (sylves_grid_get_type(jps->grid)) {
+        case SYLVES_GRID_TYPE_SQUARE:
+            jps->axis_count = 2;
+            jps->dirs[0][0] = SYLVES_SQUARE_DIR_RIGHT;
+            jps->dirs[0][1] = SYLVES_SQUARE_DIR_LEFT;
+            jps->dirs[1][0] = SYLVES_SQUARE_DIR_UP;
+            jps->dirs[1][1] = SYLVES_SQUARE_DIR_DOWN;
+            return true;
+        case SYLVES_GRID_TYPE_CUBE:
+            jps->axis_count = 3;
+            jps->dirs[0][0] = SYLVES_CUBE_DIR_RIGHT;
+            jps->dirs[0][1] = SYLVES_CUBE_DIR_LEFT;
+            jps->dirs[1][0] = SYLVES_CUBE_DIR_UP;
+            jps->dirs[1][1] = SYLVES_CUBE_DIR_DOWN;
+            jps->dirs[2][0] = SYLVES_CUBE_DIR_FORWARD;
+            jps->dirs[2][1] = SYLVES_CUBE_DIR_BACK;
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool dir_axis(const SylvesJPSPathfinding* jps, SylvesCellDir dir, int* axis, int* sign) {
+    for (int a = 0; a < jps->axis_count; a++) {
+        for (int s = 0; s < 2; s++) {
+            if (jps->dirs[a][s] == dir) {
+                *axis = a;
+                *sign = s == 0 ? 1 : -1;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/* Jump table lookups */
+
+static inline int table_index(const SylvesJPSJumpTable* table, SylvesCell cell) {
+    int x = cell.x - table->min_x;
+    int y = cell.y - table->min_y;
+    if (cell.z != 0 || x < 0 || y < 0 || x >= table->width || y >= table->height) return -1;
+    return y * table->width + x;
+}
+
+static inline bool table_open_at(const SylvesJPSJumpTable* table, int x, int y) {
+    return x >= 0 && y >= 0 && x < table->width && y < table->height && table->open[y * table->width + x];
+}
+
+static bool is_open(const SylvesJPSPathfinding* jps, SylvesCell cell) {
+    if (jps->table) {
+        int index = table_index(jps->table, cell);
+        return index >= 0 && jps->table->open[index];
+    }
+    return sylves_grid_is_cell_in_grid(jps->grid, cell) &&
+           (!jps->is_accessible || jps->is_accessible(cell, jps->user_data));
+}
+
+/* Scan from cell along (axis, sign); on success jump_point is the next cell worth queueing */
+static bool scan(const SylvesJPSPathfinding* jps, SylvesCell cell, int axis, int sign, SylvesCell* jump_point) {
+    // Openness of the cells beside the current one along each higher axis, carried between steps
+    bool beside[JPS_MAX_AXES][2];
+    for (int b = axis + 1; b < jps->axis_count; b++) {
+        beside[b][0] = is_open(jps, cell_offset(cell, b, 1));
+        beside[b][1] = is_open(jps, cell_offset(cell, b, -1));
+    }
+
+    for (int steps = 1; ; steps++) {
+        SylvesCell next = cell_offset(cell, axis, sign);
+        if (!is_open(jps, next)) return false;
+        if (same_cell(next, jps->target) || steps >= jps->max_jump) {
+            *jump_point = next;
+            return true;
+        }
+
+        // An obstacle beside the scan that ends here forces a turn onto a higher axis
+        bool forced = false;
+        for (int b = axis + 1; b < jps->axis_count; b++) {
+            for (int t = 0; t < 2; t++) {
+                bool open = is_open(jps, cell_offset(next, b, t == 0 ? 1 : -1));
+                forced |= open && !beside[b][t];
+                beside[b][t] = open;
+            }
+        }
+        if (forced) {
+            *jump_point = next;
+            return true;
+        }
+
+        // Lower axes branch off every cell; anything they find makes this cell a turning point
+        SylvesCell found;
+        for (int b = 0; b < axis; b++) {
+            if (scan(jps, next, b, 1, &found) || scan(jps, next, b, -1, &found)) {
+                *jump_point = next;
+                return true;
+            }
+        }
+        cell = next;
+    }
+}
+
+/*
+ * The same scan answered from the table. The table knows nothing of the
+ * target, so a scan that passes the target's row (or the target itself)
+ * stops there when the target is in reach along that row.
+ */
+static bool table_scan(const SylvesJPSPathfinding* jps, SylvesCell cell, int axis, int sign, SylvesCell* jump_point) {
+    const SylvesJPSJumpTable* table = jps->table;
+    int index = table_index(table, cell);
+    if (index < 0) return false;
+    int32_t jump = table->jumps[index * JPS_TABLE_SLOTS + axis * 2 + (sign < 0)];
+    int32_t reach = jump > 0 ? jump : -jump;
+
+    SylvesCell target = jps->target;
+    int along = (cell_coord(target, axis) - cell_coord(cell, axis)) * sign;
+    if (target.z == cell.z && along >= 1 && along <= reach) {
+        int across = cell_coord(target, 1 - axis) - cell_coord(cell, 1 - axis);
+        if (across == 0) {
+            *jump_point = target;
+            return true;
+        }
+        if (axis == 1) {
+            SylvesCell turn = cell_offset(cell, axis, sign * along);
+            int32_t row = table->jumps[table_index(table, turn) * JPS_TABLE_SLOTS + (across < 0)];
+            if (abs(across) <= (row > 0 ? row : -row)) {
+                *jump_point = turn;
+                return true;
+            }
+        }
+    }
+
+    if (jump > 0) {
+        *jump_point = cell_offset(cell, axis, sign * jump);
+        return true;
+    }
+    return false;
+}
+
+/* Search */
+
+static void seed(SylvesJPSPathfinding* jps) {
+    SylvesPathfindingContext* ctx = &jps->search;
+    sylves_pathfinding_context_reset(ctx);
+    sylves_path_map_bind(&ctx->nodes, jps->grid);
+
+    int32_t node = sylves_path_map_insert(&ctx->nodes, jps->src);
+    if (node >= 0) {
+        float f = manhattan(jps->src, jps->target);
+        sylves_path_map_set_score(&ctx->nodes, node, 0.0f, f);
+        sylves_indexed_heap_push(ctx->open_set, (uint32_t)node, f);
+    }
+}
+
+/*
+ * Directions worth scanning from a cell reached along (axis, sign): straight
+ * on, any lower axis, and a higher axis only where the cell behind is
+ * blocked on that side. The source scans everything.
+ */
+static bool successor_allowed(const SylvesJPSPathfinding* jps, SylvesCell cell,
+                              int arrival_axis, int arrival_sign, int axis, int sign) {
+    if (arrival_axis < 0 || axis < arrival_axis) return true;
+    if (axis == arrival_axis) return sign == arrival_sign;
+    SylvesCell behind = cell_offset(cell, arrival_axis, -arrival_sign);
+    return is_open(jps, cell_offset(cell, axis, sign)) && !is_open(jps, cell_offset(behind, axis, sign));
+}
+
+static void expand(SylvesJPSPathfinding* jps) {
+    SylvesPathNodeMap* nodes = &jps->search.nodes;
+    SylvesIndexedHeap* open_set = jps->search.open_set;
+
+    uint32_t handle;
+    while (sylves_indexed_heap_pop(open_set, &handle, NULL)) {
+        int32_t current_node = (int32_t)handle;
+        SylvesCell current = sylves_path_map_cell(nodes, current_node);
+        float g_score = sylves_path_map_g(nodes, current_node);
+
+        if (same_cell(current, jps->target)) {
+            break;
+        }
+
+        int arrival_axis = -1, arrival_sign = 0;
+        SylvesCellDir back;
+        if (sylves_path_map_parent_dir(nodes, current_node, &back) &&
+            dir_axis(jps, back, &arrival_axis, &arrival_sign)) {
+            arrival_sign = -arrival_sign;
+        }
+
+        for (int axis = 0; axis < jps->axis_count; axis++) {
+            for (int s = 0; s < 2; s++) {
+                int sign = s == 0 ? 1 : -1;
+                if (!successor_allowed(jps, current, arrival_axis, arrival_sign, axis, sign)) continue;
+
+                SylvesCell jump_point;
+                bool found = jps->table ? table_scan(jps, current, axis, sign, &jump_point)
+                                        : scan(jps, current, axis, sign, &jump_point);
+                if (!found) continue;
+
+                float length = (float)abs(cell_coord(jump_point, axis) - cell_coord(current, axis));
+                float tentative_g = g_score + length;
+                int32_t neighbor_node = sylves_path_map_insert(nodes, jump_point);
+                if (neighbor_node < 0) continue;
+
+                if (tentative_g < sylves_path_map_g(nodes, neighbor_node)) {
+                    float neighbor_f = tentative_g + manhattan(jump_point, jps->target);
+
+                    // One step spanning the whole jump; extraction splits it back up
+                    SylvesStep step;
+                    memset(&step, 0, sizeof(step));
+                    step.src = current;
+                    step.dest = jump_point;
+                    step.dir = jps->dirs[axis][s];
+                    step.inverse_dir = jps->dirs[axis][1 - s];
+                    step.length = length;
+
+                    sylves_path_map_set_score(nodes, neighbor_node, tentative_g, neighbor_f);
+                    sylves_path_map_set_step(nodes, neighbor_node, &step);
+                    sylves_indexed_heap_push(open_set, (uint32_t)neighbor_node, neighbor_f);
+                }
+            }
+        }
+    }
+}
+
+/* JPS implementation */
+
+static SylvesJPSPathfinding* jps_alloc(SylvesGrid* grid, SylvesCell src) {
+    SylvesJPSPathfinding* jps = (SylvesJPSPathfinding*)sylves_calloc(1, sizeof(SylvesJPSPathfinding));
+    if (!jps) return NULL;
+
+    jps->grid = grid;
+    jps->src = src;
+    jps->target = src;
+    jps->max_jump = sylves_grid_is_finite(grid) ? INT_MAX : SYLVES_JPS_MAX_JUMP;
+
+    if (!init_axes(jps) || !sylves_path_context_init(&jps->search, 0)) {
+        sylves_free(jps);
+        return NULL;
+    }
+    return jps;
+}
+
+SylvesJPSPathfinding* sylves_jps_create(
+    SylvesGrid* grid,
+    SylvesCell src,
+    SylvesIsAccessibleFunc is_accessible,
+    void* user_data) {
+
+    if (!grid) return NULL;
+
+    SylvesJPSPathfinding* jps = jps_alloc(grid, src);
+    if (!jps) return NULL;
+
+    jps->is_accessible = is_accessible;
+    jps->user_data = user_data;
+    return jps;
+}
+
+SylvesJPSPathfinding* sylves_jps_create_with_table(
+    const SylvesJPSJumpTable* table,
+    SylvesCell src) {
+
+    if (!table) return NULL;
+
+    SylvesJPSPathfinding* jps = jps_alloc(table->grid, src);
+    if (!jps) return NULL;
+
+    jps->table = table;
+    return jps;
+}
+
+void sylves_jps_destroy(SylvesJPSPathfinding* jps) {
+    if (!jps) return;
+
+    sylves_path_context_release(&jps->search);
+    sylves_free(jps);
+}
+
+void sylves_jps_run(SylvesJPSPathfinding* jps, SylvesCell target) {
+    if (!jps) return;
+
+    jps->target = target;
+    seed(jps);
+    expand(jps);
+}
+
+SylvesCellPath* sylves_jps_extract_path(SylvesJPSPathfinding* jps, SylvesCell target) {
+    if (!jps) return NULL;
+
+    const SylvesPathNodeMap* nodes = &jps->search.nodes;
+    int32_t node = sylves_path_map_find(nodes, target);
+    if (node < 0 || sylves_path_map_g(nodes, node) == FLT_MAX) {
+        return same_cell(target, jps->src) ? sylves_cell_path_create(NULL, 0) : NULL;
+    }
+
+    // Every step costs 1, so g is the step count and the cell i steps from the source has g == i
+    size_t step_count = (size_t)sylves_path_map_g(nodes, node);
+    if (step_count == 0) {
+        return sylves_cell_path_create(NULL, 0);
+    }
+
+    SylvesStep* steps = (SylvesStep*)sylves_alloc(sizeof(SylvesStep) * step_count);
+    if (!steps) return NULL;
+
+    // Walk each jump back a cell at a time until reaching the node it was made from
+    size_t i = step_count;
+    SylvesCell current = target;
+    SylvesCellDir back;
+    int axis, sign;
+    while (i > 0 && sylves_path_map_parent_dir(nodes, node, &back) && dir_axis(jps, back, &axis, &sign)) {
+        SylvesCellDir forward = jps->dirs[axis][sign > 0 ? 1 : 0];
+        node = -1;
+        while (node < 0 && i > 0) {
+            SylvesCell prev = cell_offset(current, axis, sign);
+            if (sylves_step_create(jps->grid, prev, forward, NULL, NULL, &steps[--i]) != SYLVES_SUCCESS) {
+                sylves_free(steps);
+                return NULL;
+            }
+            current = prev;
+            int32_t found = sylves_path_map_find(nodes, current);
+            if (found >= 0 && sylves_path_map_g(nodes, found) == (float)i) {
+                node = found;
+            }
+        }
+        if (node < 0) break;
+    }
+
+    SylvesCellPath* path = NULL;
+    if (i == 0 && same_cell(current, jps->src)) {
+        path = sylves_cell_path_create(steps, step_count);
+    }
+    sylves_free(steps);
+    return path;
+}
+
+/* JPS+ jump tables */
+
+/* Moving from (x, y) to (x + 1 or - 1, y), an obstacle beside (x, y) that ends at the next cell */
+static bool table_forced(const SylvesJPSJumpTable* table, int x, int y, int next_x) {
+    return (table_open_at(table, next_x, y + 1) && !table_open_at(table, x, y + 1)) ||
+           (table_open_at(table, next_x, y - 1) && !table_open_at(table, x, y - 1));
+}
+
+/* Extend a neighbour's jump by the one step onto it */
+static inline int32_t jump_through(int32_t jump) {
+    return jump > 0 ? jump + 1 : jump - 1;
+}
+
+static void build_row_jumps(SylvesJPSJumpTable* table) {
+    int w = table->width;
+    for (int y = 0; y < table->height; y++) {
+        for (int x = w - 1; x >= 0; x--) {
+            int32_t* jump = &table->jumps[(y * w + x) * JPS_TABLE_SLOTS + 0];
+            if (!table_open_at(table, x + 1, y)) *jump = 0;
+            else if (table_forced(table, x, y, x + 1)) *jump = 1;
+            else *jump = jump_through(table->jumps[(y * w + x + 1) * JPS_TABLE_SLOTS + 0]);
+        }
+        for (int x = 0; x < w; x++) {
+            int32_t* jump = &table->jumps[(y * w + x) * JPS_TABLE_SLOTS + 1];
+            if (!table_open_at(table, x - 1, y)) *jump = 0;
+            else if (table_forced(table, x, y, x - 1)) *jump = 1;
+            else *jump = jump_through(table->jumps[(y * w + x - 1) * JPS_TABLE_SLOTS + 1]);
+        }
+    }
+}
+
+/* Column jumps stop at the first cell whose row scans find a jump point */
+static void build_column_jumps(SylvesJPSJumpTable* table) {
+    int w = table->width;
+    int h = table->height;
+    for (int x = 0; x < w; x++) {
+        for (int dir = 0; dir < 2; dir++) {
+            int step = dir == 0 ? 1 : -1;
+            int slot = 2 + dir;
+            for (int k = 0; k < h; k++) {
+                int y = dir == 0 ? h - 1 - k : k;
+                int32_t* jump = &table->jumps[(y * w + x) * JPS_TABLE_SLOTS + slot];
+                int next = (y + step) * w + x;
+                if (!table_open_at(table, x, y + step)) *jump = 0;
+                else if (table->jumps[next * JPS_TABLE_SLOTS + 0] > 0 ||
+                         table->jumps[next * JPS_TABLE_SLOTS + 1] > 0) *jump = 1;
+                else *jump = jump_through(table->jumps[next * JPS_TABLE_SLOTS + slot]);
+            }
+        }
+    }
+}
+
+SylvesJPSJumpTable* sylves_jps_jump_table_create(
+    SylvesGrid* grid,
+    SylvesIsAccessibleFunc is_accessible,
+    void* user_data) {
+
+    if (!grid || sylves_grid_get_type(grid) != SYLVES_GRID_TYPE_SQUARE) return NULL;
+
+    // Bounded square grids index row by row, so the first and last cells give the bounds
+    int count = sylves_grid_get_index_count(grid);
+    SylvesCell first, last;
+    if (count <= 0 ||
+        sylves_grid_get_cell_by_index(grid, 0, &first) != SYLVES_SUCCESS ||
+        sylves_grid_get_cell_by_index(grid, count - 1, &last) != SYLVES_SUCCESS) {
+        return NULL;
+    }
+
+    SylvesJPSJumpTable* table = (SylvesJPSJumpTable*)sylves_calloc(1, sizeof(SylvesJPSJumpTable));
+    if (!table) return NULL;
+
+    table->grid = grid;
+    table->min_x = first.x;
+    table->min_y = first.y;
+    table->width = last.x - first.x + 1;
+    table->height = last.y - first.y + 1;
+    table->open = (uint8_t*)sylves_alloc((size_t)count);
+    table->jumps = (int32_t*)sylves_alloc(sizeof(int32_t) * JPS_TABLE_SLOTS * (size_t)count);
+    if (!table->open || !table->jumps) {
+        sylves_jps_jump_table_destroy(table);
+        return NULL;
+    }
+
+    for (int y = 0; y < table->height; y++) {
+        for (int x = 0; x < table->width; x++) {
+            SylvesCell cell = { first.x + x, first.y + y, 0 };
+            table->open[y * table->width + x] = !is_accessible || is_accessible(cell, user_data);
+        }
+    }
+
+    build_row_jumps(table);
+    build_column_jumps(table);
+    return table;
+}
+
+void sylves_jps_jump_table_destroy(SylvesJPSJumpTable* table) {
+    if (!table) return;
+
+    sylves_free(table->open);
+    sylves_free(table->jumps);
+    sylves_free(table);
+}
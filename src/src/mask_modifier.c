@@ -186,6 +186,42 @@ static bool mask_try_move(const SylvesGrid* grid, SylvesCell cell, SylvesCellDir
     return data->contains_func(*dest, data->user_data);
 }
 
+// Scratch size used when the caller does not supply dests/ok_mask buffers
+#define MASK_BATCH_CHUNK 256
+
+static int mask_try_move_batch(const SylvesGrid* grid, const SylvesCell* cells,
+                               const SylvesCellDir* dirs, size_t count,
+                               SylvesCell* dests, SylvesCellDir* inverse_dirs,
+                               SylvesConnection* connections, bool* ok_mask) {
+    const SylvesGridModifier* modifier = (const SylvesGridModifier*)grid;
+    const MaskModifierData* data = (const MaskModifierData*)modifier->modifier_data;
+    SylvesCell dest_scratch[MASK_BATCH_CHUNK];
+    bool ok_scratch[MASK_BATCH_CHUNK];
+    int moved = 0;
+
+    // Move the whole batch through the underlying grid, then filter by mask
+    for (size_t base = 0; base < count; base += MASK_BATCH_CHUNK) {
+        size_t n = count - base;
+        if (n > MASK_BATCH_CHUNK) n = MASK_BATCH_CHUNK;
+        SylvesCell* d = dests ? dests + base : dest_scratch;
+        bool* ok = ok_mask ? ok_mask + base : ok_scratch;
+
+        int r = sylves_grid_try_move_batch(modifier->underlying, cells + base, dirs + base, n, d,
+                                           inverse_dirs ? inverse_dirs + base : NULL,
+                                           connections ? connections + base : NULL, ok);
+        if (r < 0) {
+            return r;
+        }
+        for (size_t i = 0; i < n; i++) {
+            if (ok[i]) {
+                ok[i] = data->contains_func(d[i], data->user_data);
+                moved += ok[i];
+            }
+        }
+    }
+    return moved;
+}
+
 static bool mask_find_cell(const SylvesGrid* grid, SylvesVector3 position, SylvesCell* cell) {
     const SylvesGridModifier* modifier = (const SylvesGridModifier*)grid;
     const MaskModifierData* data = (const MaskModifierData*)modifier->modifier_data;
@@ -266,6 +302,7 @@ static const SylvesGridVTable mask_modifier_vtable = {
     
     // Topology - filter by mask
     .try_move = mask_try_move,
+    .try_move_batch = mask_try_move_batch,
     .get_cell_dirs = NULL,  // TODO: Need filtered implementation
     .get_cell_corners = NULL,  // TODO: Need filtered implementation
     
@@ -5,7 +5,27 @@
 
 #include "sylves/memory.h"
 #include <string.h>
+#include <stdint.h>
 
+#ifdef SYLVES_DEFAULT_SLAB_ALLOCATOR
+#include "sylves/memory_pool.h"
+
+/* Default allocator functions, routed through the global slab allocator */
+static void* default_alloc(size_t size, void* user_data) {
+    (void)user_data;
+    return sylves_slab_alloc(sylves_get_global_slab_allocator(), size);
+}
+
+static void default_free(void* ptr, void* user_data) {
+    (void)user_data;
+    sylves_slab_free(sylves_get_global_slab_allocator(), ptr);
+}
+
+static void* default_realloc(void* ptr, size_t new_size, void* user_data) {
+    (void)user_data;
+    return sylves_slab_realloc(sylves_get_global_slab_allocator(), ptr, new_size);
+}
+#else
 /* Default allocator functions */
 static void* default_alloc(size_t size, void* user_data) {
     (void)user_data;
@@ -21,6 +41,7 @@ static void* default_realloc(void* ptr, size_t new_size, void* user_data) {
     (void)user_data;
     return realloc(ptr, new_size);
 }
+#endif
 
 /* Default allocator instance */
 static SylvesAllocator default_allocator = {
@@ -105,3 +126,30 @@ void* sylves_memdup(const void* src, size_t size) {
     
     return dst;
 }
+
+void* sylves_aligned_alloc(size_t size, size_t alignment) {
+    if (size == 0 || alignment == 0 || (alignment & (alignment - 1)) != 0) {
+        return NULL;
+    }
+    if (alignment < sizeof(void*)) {
+        alignment = sizeof(void*);
+    }
+    
+    /* Over-allocate and stash the raw pointer just before the aligned block */
+    void* raw = sylves_alloc(size + alignment - 1 + sizeof(void*));
+    if (!raw) {
+        return NULL;
+    }
+    
+    uintptr_t start = (uintptr_t)raw + sizeof(void*);
+    uintptr_t aligned = (start + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    ((void**)aligned)[-1] = raw;
+    return (void*)aligned;
+}
+
+void sylves_aligned_free(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+    sylves_free(((void**)ptr)[-1]);
+}
@@ -1,5 +1,6 @@
 #include "sylves/memory_pool.h"
 #include "sylves/memory.h"
+#include "internal/sync.h"
 #include <string.h>
 #include <assert.h>
 
@@ -71,9 +72,88 @@ struct SylvesGenericPool {
     bool thread_safe;         /**< Thread safety flag */
 };
 
+/**
+ * Concurrent pool block header, placed before each payload
+ */
+typedef struct ConcurrentBlock {
+    struct ThreadHeap* heap;   /**< Heap that carved this block; NULL for slab pass-through */
+    size_t size;               /**< Pass-through request size; pads payloads to two words */
+} ConcurrentBlock;
+
+/**
+ * One thread's share of a concurrent pool
+ *
+ * Free payloads are linked through their first word. Everything but
+ * remote_free is written only by the owning thread; remote_free sits on
+ * its own cache line so remote pushes do not contend with the owner.
+ */
+typedef struct ThreadHeap {
+    struct ThreadHeap* next_heap;  /**< Next heap in the pool */
+    struct SylvesConcurrentPool* pool; /**< Pool the heap belongs to */
+    const void* owner;             /**< Address of the owner's thread tag */
+    void* free_list;               /**< Payloads only the owner pops */
+    void* chunks;                  /**< Chunks, linked through their first word */
+    size_t allocations;            /**< Blocks handed out */
+    size_t local_frees;            /**< Blocks freed by the owner */
+    size_t remote_frees;           /**< Blocks taken back from remote_free */
+    size_t chunk_count;            /**< Chunks carved */
+    char padding[64];
+    void* remote_free;             /**< Payloads freed by other threads */
+} ThreadHeap;
+
+/**
+ * Concurrent pool implementation
+ */
+struct SylvesConcurrentPool {
+    size_t block_size;         /**< Payload size */
+    size_t stride;             /**< Header plus payload, rounded to the header size */
+    size_t blocks_per_chunk;   /**< Blocks carved per refill */
+    uint32_t id;               /**< Never reused, so stale thread-local slots cannot match */
+    bool raw;                  /**< Bypass sylves_alloc, for pools behind the slab allocator */
+    ThreadHeap* heaps;         /**< Every heap, guarded by lock */
+    SylvesRwLock lock;         /**< Taken on a thread's first use and for stats */
+};
+
+/* Heaps a thread used most recently; a miss falls back to the pool's list */
+#define CONCURRENT_HEAP_SLOTS 4
+
+typedef struct HeapSlot {
+    uint32_t pool_id;
+    ThreadHeap* heap;
+} HeapSlot;
+
 /* Thread-local storage */
 static THREAD_LOCAL SylvesCellPool* tls_cell_pool = NULL;
 static THREAD_LOCAL SylvesPathPool* tls_path_pool = NULL;
+static THREAD_LOCAL HeapSlot tls_heap_slots[CONCURRENT_HEAP_SLOTS];
+static THREAD_LOCAL unsigned tls_heap_next_slot;
+static THREAD_LOCAL char tls_thread_tag;    /* its address identifies the thread */
+
+static uint32_t concurrent_pool_ids;
+
+/* Slab size classes: 16-byte steps to 128, then four per doubling */
+#define SLAB_MAX_CLASSES 32
+#define SLAB_MAX_BLOCK 4096
+#define SLAB_GRANULE 16
+
+/**
+ * Slab allocator implementation
+ */
+struct SylvesSlabAllocator {
+    SylvesAllocator allocator;                          /**< Interface for sylves_set_allocator */
+    uint32_t id;                                        /**< Matches tls_slab_id while cached */
+    size_t max_block_size;                              /**< Largest class size */
+    size_t class_count;                                 /**< Number of size classes */
+    SylvesConcurrentPool* classes[SLAB_MAX_CLASSES];    /**< One pool per size class */
+    uint8_t class_of[SLAB_MAX_BLOCK / SLAB_GRANULE + 1]; /**< Granules to class index */
+    SylvesPoolStats large;                              /**< Pass-through allocations */
+};
+
+/* The calling thread's heap per size class of the slab allocator it used last */
+static THREAD_LOCAL uint32_t tls_slab_id;
+static THREAD_LOCAL ThreadHeap* tls_slab_heaps[SLAB_MAX_CLASSES];
+
+static void* global_slab;
 
 /* Helper functions */
 
@@ -535,6 +615,425 @@ void sylves_generic_pool_free(SylvesGenericPool* pool, void* ptr, size_t size) {
     sylves_free(ptr);
 }
 
+/* Concurrent pool implementation */
+
+static void count_add(size_t* counter, size_t value) {
+    /* Only the owner writes; stats readers load concurrently */
+    sylves_atomic_store_size(counter, *counter + value);
+}
+
+static void* pool_memory_alloc(const SylvesConcurrentPool* pool, size_t size) {
+    return pool->raw ? malloc(size) : sylves_alloc(size);
+}
+
+static void pool_memory_free(const SylvesConcurrentPool* pool, void* ptr) {
+    if (pool->raw) {
+        free(ptr);
+    } else {
+        sylves_free(ptr);
+    }
+}
+
+static SylvesConcurrentPool* concurrent_pool_new(size_t block_size, size_t blocks_per_chunk, bool raw) {
+    if (block_size == 0) {
+        return NULL;
+    }
+
+    SylvesConcurrentPool* pool = (SylvesConcurrentPool*)(raw ? malloc(sizeof(SylvesConcurrentPool))
+                                                             : sylves_alloc(sizeof(SylvesConcurrentPool)));
+    if (!pool) {
+        return NULL;
+    }
+
+    memset(pool, 0, sizeof(SylvesConcurrentPool));
+    size_t payload = block_size < sizeof(void*) ? sizeof(void*) : block_size;
+    pool->block_size = block_size;
+    pool->stride = sizeof(ConcurrentBlock) +
+        (payload + sizeof(ConcurrentBlock) - 1) / sizeof(ConcurrentBlock) * sizeof(ConcurrentBlock);
+    pool->blocks_per_chunk = blocks_per_chunk > 0 ? blocks_per_chunk : 256;
+    pool->id = sylves_atomic_fetch_add_u32_acq_rel(&concurrent_pool_ids, 1u) + 1u;
+    pool->raw = raw;
+    sylves_rwlock_init(&pool->lock);
+
+    return pool;
+}
+
+SylvesConcurrentPool* sylves_concurrent_pool_create(size_t block_size, size_t blocks_per_chunk) {
+    return concurrent_pool_new(block_size, blocks_per_chunk, false);
+}
+
+void sylves_concurrent_pool_destroy(SylvesConcurrentPool* pool) {
+    if (!pool) {
+        return;
+    }
+
+    ThreadHeap* heap = pool->heaps;
+    while (heap) {
+        ThreadHeap* next_heap = heap->next_heap;
+        void* chunk = heap->chunks;
+        while (chunk) {
+            void* next_chunk = *(void**)chunk;
+            pool_memory_free(pool, chunk);
+            chunk = next_chunk;
+        }
+        pool_memory_free(pool, heap);
+        heap = next_heap;
+    }
+
+    sylves_rwlock_destroy(&pool->lock);
+    pool_memory_free(pool, pool);
+}
+
+/* Find or create the calling thread's heap; the only locked path */
+static ThreadHeap* find_heap(SylvesConcurrentPool* pool) {
+    sylves_rwlock_write(&pool->lock);
+    ThreadHeap* heap = pool->heaps;
+    while (heap && heap->owner != &tls_thread_tag) {
+        heap = heap->next_heap;
+    }
+    if (!heap) {
+        heap = (ThreadHeap*)pool_memory_alloc(pool, sizeof(ThreadHeap));
+        if (heap) {
+            memset(heap, 0, sizeof(ThreadHeap));
+            heap->pool = pool;
+            heap->owner = &tls_thread_tag;
+            heap->next_heap = pool->heaps;
+            pool->heaps = heap;
+        }
+    }
+    sylves_rwlock_write_unlock(&pool->lock);
+    return heap;
+}
+
+static ThreadHeap* current_heap(SylvesConcurrentPool* pool) {
+    for (int i = 0; i < CONCURRENT_HEAP_SLOTS; i++) {
+        if (tls_heap_slots[i].pool_id == pool->id) {
+            return tls_heap_slots[i].heap;
+        }
+    }
+
+    ThreadHeap* heap = find_heap(pool);
+    if (heap) {
+        HeapSlot* slot = &tls_heap_slots[tls_heap_next_slot++ % CONCURRENT_HEAP_SLOTS];
+        slot->pool_id = pool->id;
+        slot->heap = heap;
+    }
+    return heap;
+}
+
+/* Move everything other threads have freed onto the local free list */
+static void take_remote_frees(ThreadHeap* heap) {
+    void* list = sylves_atomic_exchange_ptr_acquire(&heap->remote_free, NULL);
+    size_t count = 0;
+    for (void* block = list; block; block = *(void**)block) {
+        count++;
+    }
+    heap->free_list = list;
+    count_add(&heap->remote_frees, count);
+}
+
+static bool carve_chunk(SylvesConcurrentPool* pool, ThreadHeap* heap) {
+    char* chunk = (char*)pool_memory_alloc(pool, sizeof(ConcurrentBlock) + pool->stride * pool->blocks_per_chunk);
+    if (!chunk) {
+        return false;
+    }
+
+    *(void**)chunk = heap->chunks;
+    heap->chunks = chunk;
+    char* ptr = chunk + sizeof(ConcurrentBlock);
+    for (size_t i = 0; i < pool->blocks_per_chunk; i++) {
+        ConcurrentBlock* header = (ConcurrentBlock*)ptr;
+        header->heap = heap;
+        void* payload = header + 1;
+        *(void**)payload = heap->free_list;
+        heap->free_list = payload;
+        ptr += pool->stride;
+    }
+    count_add(&heap->chunk_count, 1);
+    return true;
+}
+
+static void* heap_alloc(ThreadHeap* heap) {
+    if (!heap->free_list) {
+        take_remote_frees(heap);
+        if (!heap->free_list && !carve_chunk(heap->pool, heap)) {
+            return NULL;
+        }
+    }
+
+    void* block = heap->free_list;
+    heap->free_list = *(void**)block;
+    count_add(&heap->allocations, 1);
+    return block;
+}
+
+static void heap_free(ThreadHeap* heap, void* ptr) {
+    if (heap->owner == &tls_thread_tag) {
+        *(void**)ptr = heap->free_list;
+        heap->free_list = ptr;
+        count_add(&heap->local_frees, 1);
+        return;
+    }
+
+    /* Push-only stack with a single consumer that takes the whole list, so no ABA */
+    void* head;
+    do {
+        head = sylves_atomic_load_ptr_acquire(&heap->remote_free);
+        *(void**)ptr = head;
+    } while (!sylves_atomic_cas_ptr_release(&heap->remote_free, head, ptr));
+}
+
+void* sylves_concurrent_pool_alloc(SylvesConcurrentPool* pool) {
+    if (!pool) {
+        return NULL;
+    }
+
+    ThreadHeap* heap = current_heap(pool);
+    return heap ? heap_alloc(heap) : NULL;
+}
+
+void sylves_concurrent_pool_free(SylvesConcurrentPool* pool, void* ptr) {
+    if (!pool || !ptr) {
+        return;
+    }
+
+    heap_free(((ConcurrentBlock*)ptr - 1)->heap, ptr);
+}
+
+void sylves_concurrent_pool_get_stats(SylvesConcurrentPool* pool, SylvesPoolStats* stats) {
+    if (!pool || !stats) {
+        return;
+    }
+
+    memset(stats, 0, sizeof(SylvesPoolStats));
+    size_t chunk_bytes = sizeof(ConcurrentBlock) + pool->stride * pool->blocks_per_chunk;
+    sylves_rwlock_read(&pool->lock);
+    for (ThreadHeap* heap = pool->heaps; heap; heap = heap->next_heap) {
+        size_t allocations = sylves_atomic_load_size(&heap->allocations);
+        size_t frees = sylves_atomic_load_size(&heap->local_frees) + sylves_atomic_load_size(&heap->remote_frees);
+        stats->total_allocations += allocations;
+        stats->active_allocations += allocations - frees;
+        stats->reuse_count += frees;
+        stats->total_memory_used += sylves_atomic_load_size(&heap->chunk_count) * chunk_bytes;
+    }
+    sylves_rwlock_read_unlock(&pool->lock);
+
+    /* Chunks are never returned before destroy */
+    stats->peak_memory_used = stats->total_memory_used;
+}
+
+/* Slab allocator implementation */
+
+static void* slab_interface_alloc(size_t size, void* user_data) {
+    return sylves_slab_alloc((SylvesSlabAllocator*)user_data, size);
+}
+
+static void slab_interface_free(void* ptr, void* user_data) {
+    sylves_slab_free((SylvesSlabAllocator*)user_data, ptr);
+}
+
+static void* slab_interface_realloc(void* ptr, size_t new_size, void* user_data) {
+    return sylves_slab_realloc((SylvesSlabAllocator*)user_data, ptr, new_size);
+}
+
+SylvesSlabAllocator* sylves_slab_allocator_create(size_t max_block_size) {
+    if (max_block_size == 0) {
+        max_block_size = 1024;
+    }
+    if (max_block_size > SLAB_MAX_BLOCK) {
+        max_block_size = SLAB_MAX_BLOCK;
+    }
+
+    /* The slab may itself be the current allocator, so its own memory comes from malloc */
+    SylvesSlabAllocator* slab = (SylvesSlabAllocator*)calloc(1, sizeof(SylvesSlabAllocator));
+    if (!slab) {
+        return NULL;
+    }
+
+    slab->allocator.alloc = slab_interface_alloc;
+    slab->allocator.free = slab_interface_free;
+    slab->allocator.realloc = slab_interface_realloc;
+    slab->allocator.user_data = slab;
+    slab->id = sylves_atomic_fetch_add_u32_acq_rel(&concurrent_pool_ids, 1u) + 1u;
+
+    size_t size = SLAB_GRANULE;
+    while (slab->class_count < SLAB_MAX_CLASSES) {
+        /* Roughly 64 KiB per chunk, whatever the class */
+        size_t stride = sizeof(ConcurrentBlock) + size;
+        size_t blocks = (size_t)65536 / stride > 16 ? (size_t)65536 / stride : 16;
+        slab->classes[slab->class_count] = concurrent_pool_new(size, blocks, true);
+        if (!slab->classes[slab->class_count]) {
+            sylves_slab_allocator_destroy(slab);
+            return NULL;
+        }
+        slab->class_count++;
+        if (size >= max_block_size) {
+            break;
+        }
+        size_t step = size < 128 ? SLAB_GRANULE : round_up_power_of_2(size + 1) / 8;
+        size += step;
+    }
+    slab->max_block_size = size;
+
+    size_t class_index = 0;
+    for (size_t granules = 0; granules * SLAB_GRANULE <= slab->max_block_size; granules++) {
+        while (slab->classes[class_index]->block_size < granules * SLAB_GRANULE) {
+            class_index++;
+        }
+        slab->class_of[granules] = (uint8_t)class_index;
+    }
+
+    return slab;
+}
+
+void sylves_slab_allocator_destroy(SylvesSlabAllocator* slab) {
+    if (!slab) {
+        return;
+    }
+
+    for (size_t i = 0; i < slab->class_count; i++) {
+        sylves_concurrent_pool_destroy(slab->classes[i]);
+    }
+    free(slab);
+}
+
+const SylvesAllocator* sylves_slab_allocator_get_interface(SylvesSlabAllocator* slab) {
+    return slab ? &slab->allocator : NULL;
+}
+
+SylvesSlabAllocator* sylves_get_global_slab_allocator(void) {
+    for (;;) {
+        SylvesSlabAllocator* slab = (SylvesSlabAllocator*)sylves_atomic_load_ptr_acquire(&global_slab);
+        if (slab) {
+            return slab;
+        }
+
+        SylvesSlabAllocator* fresh = sylves_slab_allocator_create(0);
+        if (!fresh) {
+            return NULL;
+        }
+        if (sylves_atomic_cas_ptr_release(&global_slab, NULL, fresh)) {
+            return fresh;
+        }
+        sylves_slab_allocator_destroy(fresh);
+    }
+}
+
+void* sylves_slab_alloc(SylvesSlabAllocator* slab, size_t size) {
+    if (!slab || size == 0) {
+        return NULL;
+    }
+
+    if (size > slab->max_block_size) {
+        ConcurrentBlock* header = (ConcurrentBlock*)malloc(sizeof(ConcurrentBlock) + size);
+        if (!header) {
+            return NULL;
+        }
+        header->heap = NULL;
+        header->size = size;
+        sylves_atomic_add_size(&slab->large.total_allocations, 1);
+        sylves_atomic_add_size(&slab->large.active_allocations, 1);
+        sylves_atomic_add_size(&slab->large.total_memory_used, size);
+        return header + 1;
+    }
+
+    if (tls_slab_id != slab->id) {
+        memset(tls_slab_heaps, 0, sizeof(tls_slab_heaps));
+        tls_slab_id = slab->id;
+    }
+    size_t class_index = slab->class_of[(size + SLAB_GRANULE - 1) / SLAB_GRANULE];
+    ThreadHeap* heap = tls_slab_heaps[class_index];
+    if (!heap) {
+        heap = find_heap(slab->classes[class_index]);
+        if (!heap) {
+            return NULL;
+        }
+        tls_slab_heaps[class_index] = heap;
+    }
+    return heap_alloc(heap);
+}
+
+void sylves_slab_free(SylvesSlabAllocator* slab, void* ptr) {
+    if (!slab || !ptr) {
+        return;
+    }
+
+    ConcurrentBlock* header = (ConcurrentBlock*)ptr - 1;
+    if (header->heap) {
+        heap_free(header->heap, ptr);
+        return;
+    }
+
+    sylves_atomic_add_size(&slab->large.active_allocations, (size_t)-1);
+    sylves_atomic_add_size(&slab->large.total_memory_used, (size_t)0 - header->size);
+    free(header);
+}
+
+void* sylves_slab_realloc(SylvesSlabAllocator* slab, void* ptr, size_t new_size) {
+    if (!ptr) {
+        return sylves_slab_alloc(slab, new_size);
+    }
+    if (!slab) {
+        return NULL;
+    }
+    if (new_size == 0) {
+        sylves_slab_free(slab, ptr);
+        return NULL;
+    }
+
+    ConcurrentBlock* header = (ConcurrentBlock*)ptr - 1;
+    size_t old_size = header->heap ? header->heap->pool->block_size : header->size;
+    if (header->heap && new_size <= old_size && new_size > old_size / 2) {
+        return ptr;
+    }
+    if (!header->heap && new_size > slab->max_block_size) {
+        ConcurrentBlock* grown = (ConcurrentBlock*)realloc(header, sizeof(ConcurrentBlock) + new_size);
+        if (!grown) {
+            return NULL;
+        }
+        sylves_atomic_add_size(&slab->large.total_memory_used, new_size - grown->size);
+        grown->size = new_size;
+        return grown + 1;
+    }
+
+    void* moved = sylves_slab_alloc(slab, new_size);
+    if (!moved) {
+        return NULL;
+    }
+    memcpy(moved, ptr, old_size < new_size ? old_size : new_size);
+    sylves_slab_free(slab, ptr);
+    return moved;
+}
+
+size_t sylves_slab_allocator_get_class_count(const SylvesSlabAllocator* slab) {
+    return slab ? slab->class_count : 0;
+}
+
+size_t sylves_slab_allocator_get_class_size(const SylvesSlabAllocator* slab, size_t class_index) {
+    if (!slab || class_index >= slab->class_count) {
+        return 0;
+    }
+    return slab->classes[class_index]->block_size;
+}
+
+void sylves_slab_allocator_get_stats(SylvesSlabAllocator* slab, size_t class_index, SylvesPoolStats* stats) {
+    if (!slab || !stats) {
+        return;
+    }
+
+    if (class_index < slab->class_count) {
+        sylves_concurrent_pool_get_stats(slab->classes[class_index], stats);
+        return;
+    }
+
+    memset(stats, 0, sizeof(SylvesPoolStats));
+    if (class_index == slab->class_count) {
+        stats->total_allocations = sylves_atomic_load_size(&slab->large.total_allocations);
+        stats->active_allocations = sylves_atomic_load_size(&slab->large.active_allocations);
+        stats->total_memory_used = sylves_atomic_load_size(&slab->large.total_memory_used);
+    }
+}
+
 /* Thread-local pools */
 
 SylvesCellPool* sylves_get_thread_cell_pool(void) {
@@ -13,6 +13,9 @@
 #include "sylves/utils.h"
 #include "internal/grid_internal.h"
 #include "internal/grid_defaults.h"
+#include "internal/face_bvh.h"
+#include "internal/sync.h"
+#include "mesh_grid_internal.h"
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
@@ -21,8 +24,13 @@ typedef struct {
     SylvesGrid base;
     SylvesMeshData* mesh;
     bool owns_mesh;  /* Whether we should free the mesh data */
+    void* bvh;  /* SylvesFaceBvh, built and published on first spatial query */
 } MeshGrid;
 
+/* Polygons larger than this use a heap scratch buffer for exact tests */
+#define MESH_GRID_STACK_POLYGON 32
+#define MESH_GRID_EPSILON 1e-9
+
 /* Forward declarations */
 static void mesh_grid_destroy(SylvesGrid* grid);
 static bool mesh_grid_is_cell_in_grid(const SylvesGrid* grid, SylvesCell cell);
@@ -35,6 +43,9 @@ static SylvesVector3 mesh_grid_get_cell_center(const SylvesGrid* grid, SylvesCel
 static int mesh_grid_get_polygon(const SylvesGrid* grid, SylvesCell cell, 
                                  SylvesVector3* vertices, size_t max_vertices);
 static bool mesh_grid_find_cell(const SylvesGrid* grid, SylvesVector3 position, SylvesCell* cell);
+static SylvesError mesh_grid_get_cell_aabb(const SylvesGrid* grid, SylvesCell cell, SylvesAabb* aabb);
+static int mesh_grid_raycast(const SylvesGrid* grid, SylvesVector3 origin, SylvesVector3 direction,
+                             double max_distance, SylvesRaycastInfo* hits, size_t max_hits);
 
 /* VTable */
 static const SylvesGridVTable mesh_grid_vtable = {
@@ -54,9 +65,9 @@ static const SylvesGridVTable mesh_grid_vtable = {
     .get_cell_center = mesh_grid_get_cell_center,
     .get_cell_corner_pos = NULL,
     .get_polygon = mesh_grid_get_polygon,
-    .get_cell_aabb = NULL,
+    .get_cell_aabb = mesh_grid_get_cell_aabb,
     .find_cell = mesh_grid_find_cell,
-    .raycast = NULL,
+    .raycast = mesh_grid_raycast,
     .get_index_count = NULL,
     .get_index = NULL,
     .get_cell_by_index = NULL
@@ -69,6 +80,7 @@ static void mesh_grid_destroy(SylvesGrid* grid) {
         if (mg->owns_mesh && mg->mesh) {
             sylves_mesh_data_destroy(mg->mesh);
         }
+        sylves_face_bvh_destroy(mg->bvh);
         sylves_free(mg);
         sylves_free(grid);
     }
@@ -198,31 +210,384 @@ static int mesh_grid_get_polygon(const SylvesGrid* grid, SylvesCell cell,
     return count;
 }
 
+/*
+ * Build the face BVH on first use; the grid is logically const during
+ * queries, which may run concurrently. Threads racing to build it each
+ * make a copy, one is published and the others are freed.
+ */
+static const SylvesFaceBvh* mesh_grid_get_bvh(const SylvesGrid* grid) {
+    MeshGrid* mg = (MeshGrid*)grid->data;
+    for (;;) {
+        SylvesFaceBvh* bvh = (SylvesFaceBvh*)sylves_atomic_load_ptr_acquire(&mg->bvh);
+        if (bvh || !mg->mesh) {
+            return bvh;
+        }
+
+        SylvesFaceBvh* fresh = sylves_face_bvh_build(mg->mesh);
+        if (!fresh) {
+            return NULL;
+        }
+        if (sylves_atomic_cas_ptr_release(&mg->bvh, NULL, fresh)) {
+            return fresh;
+        }
+        sylves_face_bvh_destroy(fresh);
+    }
+}
+
+static bool mesh_is_flat(const SylvesMeshData* mesh) {
+    for (size_t i = 1; i < mesh->vertex_count; i++) {
+        if (mesh->vertices[i].z != mesh->vertices[0].z) return false;
+    }
+    return true;
+}
+
+static double vector3_axis(SylvesVector3 v, int axis) {
+    return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+
+/* Newell normal of a face (unnormalized) */
+static SylvesVector3 mesh_face_normal(const SylvesMeshData* mesh, const SylvesMeshFace* face) {
+    SylvesVector3 n = {0, 0, 0};
+    for (int i = 0; i < face->vertex_count; i++) {
+        SylvesVector3 a = mesh->vertices[face->vertices[i]];
+        SylvesVector3 b = mesh->vertices[face->vertices[(i + 1) % face->vertex_count]];
+        n.x += (a.y - b.y) * (a.z + b.z);
+        n.y += (a.z - b.z) * (a.x + b.x);
+        n.z += (a.x - b.x) * (a.y + b.y);
+    }
+    return n;
+}
+
+/*
+ * Even-odd containment after dropping one axis. Points on an edge count as
+ * inside so that shared edges never leave gaps between neighbouring faces.
+ */
+static bool mesh_face_contains_projected(const SylvesMeshData* mesh, const SylvesMeshFace* face,
+                                         SylvesVector3 point, int drop_axis) {
+    int u = drop_axis == 0 ? 1 : 0;
+    int v = drop_axis == 2 ? 1 : 2;
+    double px = vector3_axis(point, u);
+    double py = vector3_axis(point, v);
+    bool inside = false;
+
+    for (int i = 0, j = face->vertex_count - 1; i < face->vertex_count; j = i++) {
+        SylvesVector3 a3 = mesh->vertices[face->vertices[j]];
+        SylvesVector3 b3 = mesh->vertices[face->vertices[i]];
+        double ax = vector3_axis(a3, u), ay = vector3_axis(a3, v);
+        double bx = vector3_axis(b3, u), by = vector3_axis(b3, v);
+        double ex = bx - ax, ey = by - ay;
+        double len2 = ex * ex + ey * ey;
+
+        double cross = ex * (py - ay) - ey * (px - ax);
+        double along = (px - ax) * ex + (py - ay) * ey;
+        if (fabs(cross) <= MESH_GRID_EPSILON * sqrt(len2) &&
+            along >= -MESH_GRID_EPSILON && along <= len2 + MESH_GRID_EPSILON) {
+            return true;
+        }
+
+        if ((ay > py) != (by > py)) {
+            double x = ax + (py - ay) * ex / ey;
+            if (px < x) inside = !inside;
+        }
+    }
+    return inside;
+}
+
+/*
+ * Exact containment test. Flat meshes test in XY; otherwise the point is
+ * projected along the face normal and its distance to the face plane is
+ * reported so callers can pick the closest of several candidate faces.
+ */
+static bool mesh_face_contains_point(const SylvesMeshData* mesh, int face_index,
+                                     SylvesVector3 point, bool flat, double* plane_distance) {
+    const SylvesMeshFace* face = &mesh->faces[face_index];
+    if (face->vertex_count < 3) return false;
+
+    if (flat) {
+        *plane_distance = 0.0;
+        return mesh_face_contains_projected(mesh, face, point, 2);
+    }
+
+    SylvesVector3 n = mesh_face_normal(mesh, face);
+    double len = sylves_vector3_length(n);
+    if (len <= 0.0) return false;
+    SylvesVector3 rel = sylves_vector3_subtract(point, mesh->vertices[face->vertices[0]]);
+    *plane_distance = fabs(sylves_vector3_dot(rel, n)) / len;
+
+    double ax = fabs(n.x), ay = fabs(n.y), az = fabs(n.z);
+    int drop = (ax >= ay && ax >= az) ? 0 : (ay >= az ? 1 : 2);
+    return mesh_face_contains_projected(mesh, face, point, drop);
+}
+
+typedef struct {
+    const SylvesMeshData* mesh;
+    SylvesVector3 point;
+    bool flat;
+    int best_face;
+    double best_distance;
+} MeshPointQuery;
+
+static bool mesh_point_visit(int face, void* user_data) {
+    MeshPointQuery* q = (MeshPointQuery*)user_data;
+    double dist;
+    if (!mesh_face_contains_point(q->mesh, face, q->point, q->flat, &dist)) {
+        return true;
+    }
+    /* Ties (points on shared edges) resolve to the lowest face index */
+    if (q->best_face < 0 || dist < q->best_distance ||
+        (dist == q->best_distance && face < q->best_face)) {
+        q->best_face = face;
+        q->best_distance = dist;
+    }
+    return true;
+}
+
 static bool mesh_grid_find_cell(const SylvesGrid* grid, SylvesVector3 position, SylvesCell* cell) {
     const MeshGrid* mg = (const MeshGrid*)grid->data;
-    
-    /* Simple brute force search - check each face */
-    /* TODO: Implement spatial acceleration structure */
-    double min_dist = INFINITY;
-    int closest_face = -1;
-    
-    for (int i = 0; i < (int)mg->mesh->face_count; i++) {
-        SylvesCell test_cell = {i, 0, 0};
-        SylvesVector3 center = mesh_grid_get_cell_center(grid, test_cell);
-        
-        double dist = sylves_vector3_distance(position, center);
-        if (dist < min_dist) {
-            min_dist = dist;
-            closest_face = i;
+    if (!mg->mesh) {
+        return false;
+    }
+
+    const SylvesFaceBvh* bvh = mesh_grid_get_bvh(grid);
+    MeshPointQuery q = { mg->mesh, position, false, -1, INFINITY };
+
+    if (bvh) {
+        q.flat = sylves_face_bvh_is_planar(bvh);
+        sylves_face_bvh_query_point(bvh, position, mesh_point_visit, &q);
+    } else {
+        /* Out of memory for the BVH: test every face instead */
+        q.flat = mesh_is_flat(mg->mesh);
+        for (int i = 0; i < (int)mg->mesh->face_count; i++) {
+            mesh_point_visit(i, &q);
         }
     }
-    
-    if (closest_face >= 0) {
-        *cell = (SylvesCell){closest_face, 0, 0};
+
+    if (q.best_face < 0) {
+        return false;
+    }
+    if (cell) {
+        *cell = (SylvesCell){q.best_face, 0, 0};
+    }
+    return true;
+}
+
+static SylvesError mesh_grid_get_cell_aabb(const SylvesGrid* grid, SylvesCell cell, SylvesAabb* aabb) {
+    if (!aabb) {
+        return SYLVES_ERROR_NULL_POINTER;
+    }
+    if (!mesh_grid_is_cell_in_grid(grid, cell)) {
+        return SYLVES_ERROR_CELL_NOT_IN_GRID;
+    }
+
+    const MeshGrid* mg = (const MeshGrid*)grid->data;
+    const SylvesFaceBvh* bvh = mesh_grid_get_bvh(grid);
+    if (bvh) {
+        *aabb = *sylves_face_bvh_get_face_aabb(bvh, cell.x);
+        return SYLVES_SUCCESS;
+    }
+
+    const SylvesMeshFace* face = &mg->mesh->faces[cell.x];
+    aabb->min = aabb->max = mg->mesh->vertices[face->vertices[0]];
+    for (int i = 1; i < face->vertex_count; i++) {
+        SylvesVector3 v = mg->mesh->vertices[face->vertices[i]];
+        aabb->min = sylves_vector3_min(aabb->min, v);
+        aabb->max = sylves_vector3_max(aabb->max, v);
+    }
+    return SYLVES_SUCCESS;
+}
+
+/* Open-interval overlap on axes where the face has extent, closed otherwise */
+static bool mesh_axis_overlaps(double fmin, double fmax, double qmin, double qmax) {
+    if (fmax > fmin) {
+        return fmin < qmax && fmax > qmin;
+    }
+    return fmin >= qmin && fmin <= qmax;
+}
+
+typedef struct {
+    const SylvesFaceBvh* bvh;
+    SylvesVector3 min;
+    SylvesVector3 max;
+    SylvesCell* cells;
+    size_t max_cells;
+    size_t count;
+} MeshAabbQuery;
+
+static bool mesh_aabb_visit(int face, void* user_data) {
+    MeshAabbQuery* q = (MeshAabbQuery*)user_data;
+    const SylvesAabb* box = sylves_face_bvh_get_face_aabb(q->bvh, face);
+
+    if (!mesh_axis_overlaps(box->min.x, box->max.x, q->min.x, q->max.x) ||
+        !mesh_axis_overlaps(box->min.y, box->max.y, q->min.y, q->max.y)) {
         return true;
     }
-    
-    return false;
+    if (!sylves_face_bvh_is_planar(q->bvh) &&
+        !mesh_axis_overlaps(box->min.z, box->max.z, q->min.z, q->max.z)) {
+        return true;
+    }
+
+    if (q->cells) {
+        q->cells[q->count] = (SylvesCell){face, 0, 0};
+    }
+    q->count++;
+    return q->count < q->max_cells;
+}
+
+int sylves_mesh_grid_get_cells_in_aabb(const SylvesGrid* grid, SylvesVector3 min, SylvesVector3 max,
+                                       SylvesCell* cells, size_t max_cells) {
+    if (!grid) return SYLVES_ERROR_NULL_POINTER;
+    /* Other grids (e.g. planar lazy) report SYLVES_GRID_TYPE_MESH too but carry different data */
+    if (grid->vtable != &mesh_grid_vtable) return SYLVES_ERROR_NOT_IMPLEMENTED;
+    if (max_cells == 0) return 0;
+
+    const SylvesFaceBvh* bvh = mesh_grid_get_bvh(grid);
+    if (!bvh) return SYLVES_ERROR_OUT_OF_MEMORY;
+
+    MeshAabbQuery q = { bvh, min, max, cells, max_cells, 0 };
+    sylves_face_bvh_query_aabb(bvh, min, max, mesh_aabb_visit, &q);
+    return (int)q.count;
+}
+
+typedef struct {
+    const SylvesMeshData* mesh;
+    SylvesVector3 origin;
+    SylvesVector3 direction;  /* unit length */
+    double max_distance;
+    bool flat;
+    SylvesRaycastInfo* hits;
+    size_t count;
+    size_t capacity;
+    bool failed;
+} MeshRayQuery;
+
+/* Flat mesh, ray in its plane: entry distance is 0 inside, else the first edge crossing */
+static bool mesh_ray_hit_2d(const MeshRayQuery* q, const SylvesMeshFace* face,
+                            double* t_out, SylvesCellDir* edge_out) {
+    if (mesh_face_contains_projected(q->mesh, face, q->origin, 2)) {
+        *t_out = 0.0;
+        *edge_out = -1;
+        return true;
+    }
+
+    double best = INFINITY;
+    int best_edge = -1;
+    double dx = q->direction.x, dy = q->direction.y;
+    for (int i = 0; i < face->vertex_count; i++) {
+        SylvesVector3 a = q->mesh->vertices[face->vertices[i]];
+        SylvesVector3 b = q->mesh->vertices[face->vertices[(i + 1) % face->vertex_count]];
+        double ex = b.x - a.x, ey = b.y - a.y;
+        double denom = dx * ey - dy * ex;
+        if (fabs(denom) < MESH_GRID_EPSILON) continue;
+        double ox = a.x - q->origin.x, oy = a.y - q->origin.y;
+        double t = (ox * ey - oy * ex) / denom;
+        double s = (ox * dy - oy * dx) / denom;
+        if (t >= 0.0 && s >= -MESH_GRID_EPSILON && s <= 1.0 + MESH_GRID_EPSILON && t < best) {
+            best = t;
+            best_edge = i;
+        }
+    }
+    if (best_edge < 0) return false;
+    *t_out = best;
+    *edge_out = best_edge;
+    return true;
+}
+
+/* General case: intersect the face plane, then test containment */
+static bool mesh_ray_hit_3d(const MeshRayQuery* q, const SylvesMeshFace* face, double* t_out) {
+    SylvesVector3 n = mesh_face_normal(q->mesh, face);
+    double denom = sylves_vector3_dot(q->direction, n);
+    if (fabs(denom) < MESH_GRID_EPSILON * sylves_vector3_length(n)) return false;
+
+    SylvesVector3 rel = sylves_vector3_subtract(q->mesh->vertices[face->vertices[0]], q->origin);
+    double t = sylves_vector3_dot(rel, n) / denom;
+    if (t < 0.0) return false;
+
+    SylvesVector3 p = sylves_vector3_add(q->origin, sylves_vector3_scale(q->direction, t));
+    double ax = fabs(n.x), ay = fabs(n.y), az = fabs(n.z);
+    int drop = (ax >= ay && ax >= az) ? 0 : (ay >= az ? 1 : 2);
+    if (!mesh_face_contains_projected(q->mesh, face, p, drop)) return false;
+    *t_out = t;
+    return true;
+}
+
+static bool mesh_ray_visit(int face_index, void* user_data) {
+    MeshRayQuery* q = (MeshRayQuery*)user_data;
+    const SylvesMeshFace* face = &q->mesh->faces[face_index];
+    if (face->vertex_count < 3) return true;
+
+    double t;
+    SylvesCellDir edge = -1;
+    bool hit = q->flat ? mesh_ray_hit_2d(q, face, &t, &edge) : mesh_ray_hit_3d(q, face, &t);
+    if (!hit || t > q->max_distance) return true;
+
+    if (q->count == q->capacity) {
+        size_t capacity = q->capacity ? q->capacity * 2 : 16;
+        SylvesRaycastInfo* grown = sylves_realloc(q->hits, capacity * sizeof(SylvesRaycastInfo));
+        if (!grown) {
+            q->failed = true;
+            return false;
+        }
+        q->hits = grown;
+        q->capacity = capacity;
+    }
+
+    SylvesRaycastInfo* info = &q->hits[q->count++];
+    info->cell = (SylvesCell){face_index, 0, 0};
+    info->distance = t;
+    info->point = sylves_vector3_add(q->origin, sylves_vector3_scale(q->direction, t));
+    info->face = edge;
+    return true;
+}
+
+static int compare_hits_by_distance(const void* a, const void* b) {
+    const SylvesRaycastInfo* ha = (const SylvesRaycastInfo*)a;
+    const SylvesRaycastInfo* hb = (const SylvesRaycastInfo*)b;
+    if (ha->distance != hb->distance) return ha->distance < hb->distance ? -1 : 1;
+    return ha->cell.x - hb->cell.x;
+}
+
+/*
+ * Hits are ordered by distance along the normalized direction. In the flat
+ * case `face` is the edge the ray enters through, or -1 if it starts inside;
+ * in the general case it is always -1. With hits == NULL the total is returned.
+ */
+static int mesh_grid_raycast(const SylvesGrid* grid, SylvesVector3 origin, SylvesVector3 direction,
+                             double max_distance, SylvesRaycastInfo* hits, size_t max_hits) {
+    const MeshGrid* mg = (const MeshGrid*)grid->data;
+    double len = sylves_vector3_length(direction);
+    if (!mg->mesh || len <= 0.0 || max_distance < 0.0) {
+        return 0;
+    }
+
+    const SylvesFaceBvh* bvh = mesh_grid_get_bvh(grid);
+    if (!bvh) {
+        return SYLVES_ERROR_OUT_OF_MEMORY;
+    }
+
+    MeshRayQuery q = {0};
+    q.mesh = mg->mesh;
+    q.origin = origin;
+    q.direction = sylves_vector3_scale(direction, 1.0 / len);
+    q.max_distance = max_distance;
+    q.flat = sylves_face_bvh_is_planar(bvh) && fabs(q.direction.z) < MESH_GRID_EPSILON;
+
+    sylves_face_bvh_query_ray(bvh, origin, q.direction, max_distance, mesh_ray_visit, &q);
+    if (q.failed) {
+        sylves_free(q.hits);
+        return SYLVES_ERROR_OUT_OF_MEMORY;
+    }
+
+    if (q.count > 1) {
+        qsort(q.hits, q.count, sizeof(SylvesRaycastInfo), compare_hits_by_distance);
+    }
+
+    size_t written = q.count;
+    if (hits) {
+        if (written > max_hits) written = max_hits;
+        if (written > 0) memcpy(hits, q.hits, written * sizeof(SylvesRaycastInfo));
+    }
+    sylves_free(q.hits);
+    return (int)written;
 }
 
 /* Mesh data management */
@@ -293,13 +658,13 @@ bool sylves_mesh_validate(const SylvesMeshData* mesh_data) {
         
         /* Check vertex indices */
         for (int j = 0; j < face->vertex_count; j++) {
-            if (face->vertices[j] < 0 || face->vertices[j] >= mesh_data->vertex_count) {
+            if (face->vertices[j] < 0 || face->vertices[j] >= (int)mesh_data->vertex_count) {
                 return false;
             }
             
             /* Check neighbor indices */
             int neighbor = face->neighbors[j];
-            if (neighbor < -1 || neighbor >= mesh_data->face_count) {
+            if (neighbor < -1 || neighbor >= (int)mesh_data->face_count) {
                 return false;
             }
         }
@@ -552,6 +917,7 @@ SylvesGrid* sylves_mesh_grid_create(const SylvesMeshData* mesh_data) {
     mg->base = *grid;  /* Copy base grid info */
     mg->mesh = mesh_copy;
     mg->owns_mesh = true;
+    mg->bvh = NULL;
     
     return grid;
 }
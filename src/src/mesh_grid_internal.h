@@ -0,0 +1,16 @@
+/**
+ * @file mesh_grid_internal.h
+ * @brief Internal helpers for mesh grid used by generic grid API
+ */
+#ifndef MESH_GRID_INTERNAL_H
+#define MESH_GRID_INTERNAL_H
+
+#include "sylves/types.h"
+
+
+/* Get faces whose bounds overlap an AABB (z ignored for flat meshes); returns number written. */
+int sylves_mesh_grid_get_cells_in_aabb(const SylvesGrid* grid, SylvesVector3 min, SylvesVector3 max,
+                                       SylvesCell* cells, size_t max_cells);
+
+
+#endif /* MESH_GRID_INTERNAL_H */
@@ -0,0 +1,409 @@
+/**
+ * @file path_search.c
+ * @brief Cell-to-node maps (sparse hashed or dense indexed) and ring queue for the pathfinders
+ */
+
+#include "internal/path_search.h"
+#include "internal/sync.h"
+#include "sylves/memory.h"
+#include "sylves/cell.h"
+#include "sylves/grid.h"
+#include "sylves/cell_type.h"
+#include "sylves/errors.h"
+#include <string.h>
+
+#define PATH_MAP_MIN_SLOTS 64
+
+static inline uint64_t mix64(uint64_t x) {
+    x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27; x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31; return x;
+}
+
+static inline size_t cell_slot(SylvesCell cell, size_t mask) {
+    uint64_t h = (uint64_t)(uint32_t)cell.x * 0x9e3779b97f4a7c15ULL
+               ^ (uint64_t)(uint32_t)cell.y * 0xc2b2ae3d27d4eb4fULL
+               ^ (uint64_t)(uint32_t)cell.z * 0x165667b19e3779f9ULL;
+    return (size_t)mix64(h) & mask;
+}
+
+static inline bool cell_eq(SylvesCell a, SylvesCell b) {
+    return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+/* Generation 0 is never live, so zeroed slots are empty */
+static SylvesPathSlot* alloc_slots(size_t slot_count) {
+    return (SylvesPathSlot*)sylves_calloc(slot_count, sizeof(SylvesPathSlot));
+}
+
+bool sylves_path_map_init(SylvesPathNodeMap* map, size_t expected_nodes) {
+    memset(map, 0, sizeof(*map));
+
+    /* Keep the load factor at or below one half */
+    size_t slot_count = PATH_MAP_MIN_SLOTS;
+    while (slot_count < expected_nodes * 2) slot_count <<= 1;
+
+    map->slots = alloc_slots(slot_count);
+    map->node_capacity = slot_count / 2;
+    map->nodes = (SylvesPathNode*)sylves_alloc(sizeof(SylvesPathNode) * map->node_capacity);
+    if (!map->slots || !map->nodes) {
+        sylves_path_map_release(map);
+        return false;
+    }
+    map->slot_mask = slot_count - 1;
+    map->generation = 1;
+    return true;
+}
+
+static void release_dense(SylvesPathNodeMap* map) {
+    sylves_free(map->dense_g);
+    sylves_free(map->dense_f);
+    sylves_free(map->dense_parent);
+    sylves_free(map->dense_visited);
+    map->dense_g = NULL;
+    map->dense_f = NULL;
+    map->dense_parent = NULL;
+    map->dense_visited = NULL;
+    map->dense_capacity = 0;
+    map->dense_grid = NULL;
+}
+
+void sylves_path_map_release(SylvesPathNodeMap* map) {
+    if (!map) return;
+    release_dense(map);
+    sylves_free(map->dense_dirty);
+    sylves_free(map->slots);
+    sylves_free(map->nodes);
+    memset(map, 0, sizeof(*map));
+}
+
+void sylves_path_map_reset(SylvesPathNodeMap* map) {
+    for (size_t i = 0; i < map->dense_dirty_count; i++) {
+        map->dense_visited[map->dense_dirty[i]] = 0;
+    }
+    map->dense_dirty_count = 0;
+
+    map->node_count = 0;
+    if (++map->generation == 0) {
+        /* Wrapped: stale stamps could now look live */
+        memset(map->slots, 0, sizeof(SylvesPathSlot) * (map->slot_mask + 1));
+        map->generation = 1;
+    }
+}
+
+/* Arrays for count cells; g, f and parents are only read behind a visited bit */
+static bool grow_dense(SylvesPathNodeMap* map, size_t count) {
+    release_dense(map);
+    size_t words = (count + 63) / 64;
+    map->dense_g = (float*)sylves_alloc(sizeof(float) * count);
+    map->dense_f = (float*)sylves_alloc(sizeof(float) * count);
+    map->dense_parent = (uint8_t*)sylves_alloc(count);
+    map->dense_visited = (uint64_t*)sylves_calloc(words, sizeof(uint64_t));
+    if (!map->dense_g || !map->dense_f || !map->dense_parent || !map->dense_visited) {
+        release_dense(map);
+        return false;
+    }
+    map->dense_capacity = count;
+    return true;
+}
+
+void sylves_path_map_bind(SylvesPathNodeMap* map, const SylvesGrid* grid) {
+    map->dense_grid = NULL;
+    if (map->sparse_only) return;
+    int count = grid ? sylves_grid_get_index_count(grid) : -1;
+    if (count <= 0) return;
+
+    /* Parent dirs are stored in a byte */
+    SylvesCell first;
+    if (sylves_grid_get_cell_by_index(grid, 0, &first) != SYLVES_SUCCESS) return;
+    const SylvesCellType* ct = sylves_grid_get_cell_type(grid, first);
+    if (!ct || sylves_cell_type_get_dir_count(ct) >= SYLVES_PATH_NO_PARENT) return;
+
+    if ((size_t)count > map->dense_capacity && !grow_dense(map, (size_t)count)) return;
+    map->dense_grid = grid;
+}
+
+static inline int dense_index(const SylvesPathNodeMap* map, SylvesCell cell) {
+    int index = sylves_grid_get_index(map->dense_grid, cell);
+    return (size_t)index < map->dense_capacity ? index : -1;
+}
+
+static inline bool dense_visited(const SylvesPathNodeMap* map, int index) {
+    return (map->dense_visited[index >> 6] >> (index & 63)) & 1;
+}
+
+static int32_t dense_insert(SylvesPathNodeMap* map, SylvesCell cell) {
+    int index = dense_index(map, cell);
+    if (index < 0) return -1;
+
+    uint64_t* word = &map->dense_visited[index >> 6];
+    uint64_t bit = 1ULL << (index & 63);
+    if (*word & bit) return index;
+
+    if (*word == 0) {
+        if (map->dense_dirty_count == map->dense_dirty_capacity) {
+            size_t capacity = map->dense_dirty_capacity ? map->dense_dirty_capacity * 2 : 256;
+            uint32_t* dirty = (uint32_t*)sylves_realloc(map->dense_dirty, sizeof(uint32_t) * capacity);
+            if (!dirty) return -1;
+            map->dense_dirty = dirty;
+            map->dense_dirty_capacity = capacity;
+        }
+        map->dense_dirty[map->dense_dirty_count++] = (uint32_t)(index >> 6);
+    }
+    *word |= bit;
+    map->dense_g[index] = FLT_MAX;
+    map->dense_f[index] = FLT_MAX;
+    map->dense_parent[index] = SYLVES_PATH_NO_PARENT;
+    return index;
+}
+
+int32_t sylves_path_map_find(const SylvesPathNodeMap* map, SylvesCell cell) {
+    if (map->dense_grid) {
+        int index = dense_index(map, cell);
+        return index >= 0 && dense_visited(map, index) ? index : -1;
+    }
+
+    size_t i = cell_slot(cell, map->slot_mask);
+    for (;;) {
+        const SylvesPathSlot* slot = &map->slots[i];
+        if (slot->generation != map->generation) return -1;
+        if (cell_eq(slot->cell, cell)) return slot->node;
+        i = (i + 1) & map->slot_mask;
+    }
+}
+
+/* Double the slot table; the nodes already carry their cells so no probing state is lost */
+static bool grow_slots(SylvesPathNodeMap* map) {
+    size_t slot_count = (map->slot_mask + 1) * 2;
+    SylvesPathSlot* slots = alloc_slots(slot_count);
+    if (!slots) return false;
+
+    size_t mask = slot_count - 1;
+    for (size_t n = 0; n < map->node_count; n++) {
+        size_t i = cell_slot(map->nodes[n].cell, mask);
+        while (slots[i].generation == map->generation) i = (i + 1) & mask;
+        slots[i].cell = map->nodes[n].cell;
+        slots[i].node = (int32_t)n;
+        slots[i].generation = map->generation;
+    }
+
+    sylves_free(map->slots);
+    map->slots = slots;
+    map->slot_mask = mask;
+    return true;
+}
+
+int32_t sylves_path_map_insert(SylvesPathNodeMap* map, SylvesCell cell) {
+    if (map->dense_grid) {
+        return dense_insert(map, cell);
+    }
+
+    size_t i = cell_slot(cell, map->slot_mask);
+    for (;;) {
+        SylvesPathSlot* slot = &map->slots[i];
+        if (slot->generation != map->generation) break;
+        if (cell_eq(slot->cell, cell)) return slot->node;
+        i = (i + 1) & map->slot_mask;
+    }
+
+    if (map->node_count >= (size_t)INT32_MAX) return -1;
+
+    if (map->node_count == map->node_capacity) {
+        size_t capacity = map->node_capacity * 2;
+        SylvesPathNode* nodes = (SylvesPathNode*)sylves_realloc(map->nodes, sizeof(SylvesPathNode) * capacity);
+        if (!nodes) return -1;
+        map->nodes = nodes;
+        map->node_capacity = capacity;
+    }
+
+    if ((map->node_count + 1) * 2 > map->slot_mask + 1) {
+        if (!grow_slots(map)) return -1;
+        i = cell_slot(cell, map->slot_mask);
+        while (map->slots[i].generation == map->generation) i = (i + 1) & map->slot_mask;
+    }
+
+    int32_t node = (int32_t)map->node_count++;
+    map->slots[i].cell = cell;
+    map->slots[i].node = node;
+    map->slots[i].generation = map->generation;
+
+    SylvesPathNode* entry = &map->nodes[node];
+    entry->cell = cell;
+    entry->g = FLT_MAX;
+    entry->f = FLT_MAX;
+    entry->has_step = false;
+    return node;
+}
+
+SylvesCell sylves_path_map_cell(const SylvesPathNodeMap* map, int32_t node) {
+    if (map->dense_grid) {
+        SylvesCell cell = { 0, 0, 0 };
+        sylves_grid_get_cell_by_index(map->dense_grid, node, &cell);
+        return cell;
+    }
+    return map->nodes[node].cell;
+}
+
+void sylves_path_map_visit(const SylvesPathNodeMap* map,
+                           bool (*visit)(int32_t node, void* user_data), void* user_data) {
+    if (map->dense_grid) {
+        for (size_t i = 0; i < map->dense_dirty_count; i++) {
+            uint32_t w = map->dense_dirty[i];
+            uint64_t bits = map->dense_visited[w];
+            while (bits) {
+                int32_t node = (int32_t)(w * 64 + (uint32_t)sylves_ctz64(bits));
+                if (!visit(node, user_data)) return;
+                bits &= bits - 1;
+            }
+        }
+        return;
+    }
+    for (size_t n = 0; n < map->node_count; n++) {
+        if (!visit((int32_t)n, user_data)) return;
+    }
+}
+
+/*
+ * Rebuild the step into node from its stored parent dir. The step length
+ * is recovered from the g scores, so no step-length callback is needed.
+ */
+static bool dense_parent_step(const SylvesPathNodeMap* map, int32_t node, SylvesCell cell, SylvesStep* step) {
+    uint8_t back = map->dense_parent[node];
+    if (back == SYLVES_PATH_NO_PARENT) return false;
+
+    SylvesCell parent;
+    SylvesCellDir forward;
+    if (!sylves_grid_try_move(map->dense_grid, cell, (SylvesCellDir)back, &parent, &forward, NULL)) return false;
+    int32_t parent_node = sylves_path_map_find(map, parent);
+    if (parent_node < 0) return false;
+
+    step->src = parent;
+    step->dest = cell;
+    step->dir = forward;
+    step->inverse_dir = (SylvesCellDir)back;
+    sylves_grid_try_move(map->dense_grid, parent, forward, NULL, NULL, &step->connection);
+    step->length = map->dense_g[node] - map->dense_g[parent_node];
+    return true;
+}
+
+static bool parent_step(const SylvesPathNodeMap* map, int32_t node, SylvesCell cell, SylvesStep* step) {
+    if (map->dense_grid) {
+        return dense_parent_step(map, node, cell, step);
+    }
+    if (!map->nodes[node].has_step) return false;
+    *step = map->nodes[node].step;
+    return true;
+}
+
+SylvesCellPath* sylves_path_map_extract(const SylvesPathNodeMap* map, SylvesCell target) {
+    int32_t node = sylves_path_map_find(map, target);
+    if (node < 0 || sylves_path_map_g(map, node) == FLT_MAX) {
+        return NULL;
+    }
+
+    /* Count steps back to the root, the source this node was reached from */
+    size_t step_count = 0;
+    SylvesCell current = target;
+    SylvesStep step;
+    while (parent_step(map, node, current, &step)) {
+        step_count++;
+        current = step.src;
+        node = sylves_path_map_find(map, current);
+        if (node < 0) return NULL;
+    }
+
+    if (step_count == 0) {
+        return sylves_cell_path_create(NULL, 0);
+    }
+
+    SylvesStep* steps = (SylvesStep*)sylves_alloc(sizeof(SylvesStep) * step_count);
+    if (!steps) return NULL;
+
+    current = target;
+    for (size_t i = step_count; i > 0; i--) {
+        parent_step(map, sylves_path_map_find(map, current), current, &steps[i - 1]);
+        current = steps[i - 1].src;
+    }
+
+    SylvesCellPath* path = sylves_cell_path_create(steps, step_count);
+    sylves_free(steps);
+    return path;
+}
+
+bool sylves_path_context_init(SylvesPathfindingContext* ctx, size_t expected_nodes) {
+    ctx->open_set = sylves_indexed_heap_create(expected_nodes);
+    ctx->open_radix = sylves_radix_heap_create();
+    if (!sylves_path_map_init(&ctx->nodes, expected_nodes) || !ctx->open_set || !ctx->open_radix) {
+        sylves_path_context_release(ctx);
+        return false;
+    }
+    return true;
+}
+
+void sylves_path_context_release(SylvesPathfindingContext* ctx) {
+    if (!ctx) return;
+    sylves_path_map_release(&ctx->nodes);
+    sylves_indexed_heap_destroy(ctx->open_set);
+    sylves_radix_heap_destroy(ctx->open_radix);
+    ctx->open_set = NULL;
+    ctx->open_radix = NULL;
+}
+
+SylvesPathfindingContext* sylves_pathfinding_context_create(size_t expected_nodes) {
+    SylvesPathfindingContext* ctx = (SylvesPathfindingContext*)sylves_alloc(sizeof(SylvesPathfindingContext));
+    if (!ctx) return NULL;
+    if (!sylves_path_context_init(ctx, expected_nodes)) {
+        sylves_free(ctx);
+        return NULL;
+    }
+    return ctx;
+}
+
+void sylves_pathfinding_context_destroy(SylvesPathfindingContext* ctx) {
+    if (!ctx) return;
+    sylves_path_context_release(ctx);
+    sylves_free(ctx);
+}
+
+void sylves_pathfinding_context_reset(SylvesPathfindingContext* ctx) {
+    if (!ctx) return;
+    sylves_path_map_reset(&ctx->nodes);
+    sylves_indexed_heap_clear(ctx->open_set);
+    sylves_radix_heap_clear(ctx->open_radix);
+}
+
+bool sylves_path_queue_init(SylvesPathQueue* queue, size_t capacity) {
+    size_t size = 16;
+    while (size < capacity) size <<= 1;
+    queue->items = (int32_t*)sylves_alloc(sizeof(int32_t) * size);
+    queue->mask = size - 1;
+    queue->head = 0;
+    queue->count = 0;
+    return queue->items != NULL;
+}
+
+void sylves_path_queue_release(SylvesPathQueue* queue) {
+    if (!queue) return;
+    sylves_free(queue->items);
+    queue->items = NULL;
+    queue->count = 0;
+}
+
+bool sylves_path_queue_push(SylvesPathQueue* queue, int32_t node) {
+    size_t size = queue->mask + 1;
+    if (queue->count == size) {
+        /* Unwrap into a ring twice the size */
+        int32_t* items = (int32_t*)sylves_alloc(sizeof(int32_t) * size * 2);
+        if (!items) return false;
+        size_t first = size - queue->head;
+        memcpy(items, queue->items + queue->head, sizeof(int32_t) * first);
+        memcpy(items + first, queue->items, sizeof(int32_t) * queue->head);
+        sylves_free(queue->items);
+        queue->items = items;
+        queue->head = 0;
+        queue->mask = size * 2 - 1;
+    }
+    queue->items[(queue->head + queue->count) & queue->mask] = node;
+    queue->count++;
+    return true;
+}
@@ -6,6 +6,7 @@
 #include "sylves/pathfinding.h"
 #include "sylves/memory.h"
 #include "sylves/errors.h"
+#include "internal/path_search.h"
 #include <math.h>
 #include <string.h>
 #include <stdlib.h>
@@ -69,8 +70,8 @@ static void heap_decreased_key(SylvesHeap* heap, size_t i) {
             // Swap with parent
             heap->keys[p] = key;
             heap->keys[i] = parent_key;
-            heap->items[p] = item;
             heap->items[i] = heap->items[p];
+            heap->items[p] = item;
             i = p;
         } else {
             break;
@@ -196,9 +197,8 @@ SylvesError sylves_step_create(
     SylvesCellDir inverse_dir;
     SylvesConnection connection;
     
-    SylvesError err = sylves_grid_try_move(grid, src, dir, &dest, &inverse_dir, &connection);
-    if (err != SYLVES_SUCCESS) {
-        return err;
+    if (!sylves_grid_try_move(grid, src, dir, &dest, &inverse_dir, &connection)) {
+        return SYLVES_ERROR_NO_NEIGHBOR;
     }
     
     step->src = src;
@@ -314,6 +314,14 @@ static float manhattan_heuristic_func(SylvesCell cell, void* user_data) {
     return sylves_heuristic_manhattan(cell, data->target, data->scale);
 }
 
+/* Grid types whose cell coordinates support the Manhattan distance */
+static bool has_manhattan_heuristic(SylvesGridType type) {
+    return type == SYLVES_GRID_TYPE_SQUARE ||
+           type == SYLVES_GRID_TYPE_CUBE ||
+           type == SYLVES_GRID_TYPE_TRIANGLE ||
+           type == SYLVES_GRID_TYPE_HEX;
+}
+
 SylvesHeuristicFunc sylves_get_admissible_heuristic(
     SylvesGrid* grid,
     SylvesCell target,
@@ -324,10 +332,7 @@ SylvesHeuristicFunc sylves_get_admissible_heuristic(
     SylvesGridType type = sylves_grid_get_type(grid);
     
     // Check for grid types that support Manhattan distance
-    if (type == SYLVES_GRID_TYPE_SQUARE || 
-        type == SYLVES_GRID_TYPE_CUBE ||
-        type == SYLVES_GRID_TYPE_TRIANGLE ||
-        type == SYLVES_GRID_TYPE_HEX) {
+    if (has_manhattan_heuristic(type)) {
         
         ManhattanHeuristicData* data = (ManhattanHeuristicData*)sylves_alloc(sizeof(ManhattanHeuristicData));
         if (!data) return NULL;
@@ -382,6 +387,97 @@ static float combined_step_length(const SylvesStep* step, void* user_data) {
     return 1.0f;
 }
 
+/* A* passes one user_data to both callbacks, so the heuristic rides along with the step data */
+typedef struct {
+    CombinedStepData step_data;
+    SylvesHeuristicFunc heuristic;
+    void* heuristic_data;
+} CombinedSearchData;
+
+static float combined_heuristic(SylvesCell cell, void* user_data) {
+    CombinedSearchData* data = (CombinedSearchData*)user_data;
+    return data->heuristic(cell, data->heuristic_data);
+}
+
+/* Run the search for dest on ctx; afterwards the dest node holds the result */
+static void search_with_context(
+    SylvesPathfindingContext* ctx,
+    SylvesGrid* grid,
+    SylvesCell src,
+    SylvesCell dest,
+    CombinedStepData* step_data) {
+    
+    // Use A* when the grid has an admissible heuristic; its data lives on the stack
+    if (!step_data->step_lengths && has_manhattan_heuristic(sylves_grid_get_type(grid))) {
+        ManhattanHeuristicData heuristic_data = { dest, 1.0f };
+        CombinedSearchData search_data = {
+            .step_data = *step_data,
+            .heuristic = manhattan_heuristic_func,
+            .heuristic_data = &heuristic_data
+        };
+        sylves_path_astar_seed(ctx, grid, src, combined_heuristic, &search_data);
+        sylves_path_astar_expand(ctx, grid, dest, combined_step_length, combined_heuristic, &search_data);
+        return;
+    }
+    
+    // Fall back to Dijkstra
+    sylves_path_dijkstra_seed(ctx, grid, &src, 1);
+    sylves_path_dijkstra_expand(ctx, grid, &dest, 1, FLT_MAX, combined_step_length, step_data);
+}
+
+SylvesCellPath* sylves_find_path_with_context(
+    SylvesPathfindingContext* ctx,
+    SylvesGrid* grid,
+    SylvesCell src,
+    SylvesCell dest,
+    SylvesIsAccessibleFunc is_accessible,
+    SylvesStepLengthFunc step_lengths,
+    void* user_data) {
+    
+    if (!ctx || !grid) return NULL;
+    
+    // Combine accessibility and step length functions
+    CombinedStepData combined_data = {
+        .is_accessible = is_accessible,
+        .step_lengths = step_lengths,
+        .user_data = user_data
+    };
+    
+    search_with_context(ctx, grid, src, dest, &combined_data);
+    return sylves_path_map_extract(&ctx->nodes, dest);
+}
+
+SylvesError sylves_find_distance_with_context(
+    SylvesPathfindingContext* ctx,
+    SylvesGrid* grid,
+    SylvesCell src,
+    SylvesCell dest,
+    SylvesIsAccessibleFunc is_accessible,
+    SylvesStepLengthFunc step_lengths,
+    void* user_data,
+    float* distance) {
+    
+    if (!ctx || !grid || !distance) {
+        return SYLVES_ERROR_INVALID_ARGUMENT;
+    }
+    
+    CombinedStepData combined_data = {
+        .is_accessible = is_accessible,
+        .step_lengths = step_lengths,
+        .user_data = user_data
+    };
+    
+    // The settled g score is the path length; no path needs building
+    search_with_context(ctx, grid, src, dest, &combined_data);
+    int32_t node = sylves_path_map_find(&ctx->nodes, dest);
+    if (node < 0 || sylves_path_map_g(&ctx->nodes, node) == FLT_MAX) {
+        return SYLVES_ERROR_CELL_NOT_FOUND;
+    }
+    
+    *distance = sylves_path_map_g(&ctx->nodes, node);
+    return SYLVES_SUCCESS;
+}
+
 SylvesCellPath* sylves_find_path(
     SylvesGrid* grid,
     SylvesCell src,
@@ -392,46 +488,72 @@ SylvesCellPath* sylves_find_path(
     
     if (!grid) return NULL;
     
-    // Combine accessibility and step length functions
+    SylvesPathfindingContext ctx;
+    if (!sylves_path_context_init(&ctx, 0)) return NULL;
+    
+    SylvesCellPath* path = sylves_find_path_with_context(
+        &ctx, grid, src, dest, is_accessible, step_lengths, user_data);
+    sylves_path_context_release(&ctx);
+    
+    return path;
+}
+
+static float manhattan_cell_distance(SylvesCell a, SylvesCell b, void* user_data) {
+    (void)user_data;
+    return sylves_heuristic_manhattan(a, b, 1.0f);
+}
+
+SylvesCellPath* sylves_find_path_bidirectional(
+    SylvesGrid* grid,
+    SylvesCell src,
+    SylvesCell dest,
+    SylvesIsAccessibleFunc is_accessible,
+    SylvesStepLengthFunc step_lengths,
+    void* user_data) {
+    
+    if (!grid) return NULL;
+    
     CombinedStepData combined_data = {
         .is_accessible = is_accessible,
         .step_lengths = step_lengths,
         .user_data = user_data
     };
     
-    // Try to use A* if we can get a heuristic
-    if (!step_lengths) {
-        void* heuristic_data = NULL;
-        SylvesHeuristicFunc heuristic = sylves_get_admissible_heuristic(grid, dest, &heuristic_data);
-        
-        if (heuristic) {
-            SylvesAStarPathfinding* astar = sylves_astar_create(
-                grid, src, combined_step_length, heuristic, 
-                is_accessible || step_lengths ? &combined_data : NULL);
-            
-            if (astar) {
-                sylves_astar_run(astar, dest);
-                SylvesCellPath* path = sylves_astar_extract_path(astar, dest);
-                sylves_astar_destroy(astar);
-                sylves_free(heuristic_data);
-                return path;
-            }
-            
-            sylves_free(heuristic_data);
-        }
+    // Same heuristic choice as search_with_context; without one both halves run as Dijkstra
+    SylvesCellDistanceFunc heuristic = NULL;
+    if (!step_lengths && has_manhattan_heuristic(sylves_grid_get_type(grid))) {
+        heuristic = manhattan_cell_distance;
     }
     
-    // Fall back to Dijkstra
-    SylvesDijkstraPathfinding* dijkstra = sylves_dijkstra_create(
-        grid, src, combined_step_length, 
-        is_accessible || step_lengths ? &combined_data : NULL);
+    SylvesBidirAStarPathfinding* bidir = sylves_bidir_astar_create(
+        grid, src, dest, combined_step_length, heuristic, &combined_data);
+    if (!bidir) return NULL;
+    
+    SylvesCellPath* path = NULL;
+    if (sylves_bidir_astar_run(bidir)) {
+        path = sylves_bidir_astar_extract_path(bidir);
+    }
+    sylves_bidir_astar_destroy(bidir);
+    return path;
+}
+
+SylvesCellPath* sylves_find_path_jps(
+    SylvesGrid* grid,
+    SylvesCell src,
+    SylvesCell dest,
+    SylvesIsAccessibleFunc is_accessible,
+    void* user_data) {
     
-    if (!dijkstra) return NULL;
+    if (!grid) return NULL;
     
-    sylves_dijkstra_run(dijkstra, &dest, FLT_MAX);
-    SylvesCellPath* path = sylves_dijkstra_extract_path(dijkstra, dest);
-    sylves_dijkstra_destroy(dijkstra);
+    SylvesJPSPathfinding* jps = sylves_jps_create(grid, src, is_accessible, user_data);
+    if (!jps) {
+        return sylves_find_path(grid, src, dest, is_accessible, NULL, user_data);
+    }
     
+    sylves_jps_run(jps, dest);
+    SylvesCellPath* path = sylves_jps_extract_path(jps, dest);
+    sylves_jps_destroy(jps);
     return path;
 }
 
@@ -448,13 +570,14 @@ SylvesError sylves_find_distance(
         return SYLVES_ERROR_INVALID_ARGUMENT;
     }
     
-    SylvesCellPath* path = sylves_find_path(grid, src, dest, is_accessible, step_lengths, user_data);
-    if (!path) {
-        return SYLVES_ERROR_CELL_NOT_FOUND;
+    SylvesPathfindingContext ctx;
+    if (!sylves_path_context_init(&ctx, 0)) {
+        return SYLVES_ERROR_OUT_OF_MEMORY;
     }
     
-    *distance = path->total_length;
-    sylves_cell_path_destroy(path);
+    SylvesError err = sylves_find_distance_with_context(
+        &ctx, grid, src, dest, is_accessible, step_lengths, user_data, distance);
+    sylves_path_context_release(&ctx);
     
-    return SYLVES_SUCCESS;
+    return err;
 }
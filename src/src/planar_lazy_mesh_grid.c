@@ -11,20 +11,46 @@
 #include "sylves/cell.h"
 #include "sylves/hash.h"
 #include "internal/grid_internal.h"
+#include "internal/sync.h"
+#include "internal/thread_pool.h"
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
 
-/* Hash table entry for cached chunks */
+struct PlanarLazyMeshGrid;
+
+/* Set in ChunkEntry.pins once an entry is claimed for eviction; no pin can be taken after */
+#define CHUNK_EVICTED 0x80000000u
+
+/* Hash table entry for cached chunks
+ *
+ * Every entry that has finished building is on the clock list, pinned or
+ * not; eviction skips pinned ones. Entries unlinked from the table are
+ * retired rather than freed while a lock-free lookup may still be on them. */
 typedef struct ChunkEntry {
     SylvesCell chunk_cell;           /* Chunk coordinates */
-    SylvesMeshData* mesh_data;       /* Mesh data for this chunk */
-    SylvesGrid* mesh_grid;           /* Mesh grid for this chunk */
-    struct ChunkEntry* next;         /* Next entry in hash chain */
+    SylvesGrid* mesh_grid;           /* Mesh grid for this chunk, NULL unless ready */
+    size_t bytes;                    /* Estimated footprint of mesh_grid */
+    uint32_t pins;                   /* User pins plus lookups in flight, and CHUNK_EVICTED */
+    uint32_t user_pins;              /* Pins taken by pin_chunk; lock held */
+    uint32_t state;                  /* SylvesChunkState, stored with release */
+    uint8_t referenced;              /* Set by hits; buys one pass of the eviction clock */
+    struct PlanarLazyMeshGrid* owner; /* Grid a background build publishes to */
+    struct ChunkEntry* next;         /* Next entry in hash chain, walked without the lock */
+    struct ChunkEntry* lru_prev;     /* Towards the most recently used */
+    struct ChunkEntry* lru_next;     /* Towards the least recently used */
+    struct ChunkEntry* retired_next; /* Next entry waiting to be freed */
 } ChunkEntry;
 
+/* Bucket array, replaced as a whole when the table grows */
+typedef struct ChunkTable {
+    size_t size;
+    struct ChunkTable* retired_next; /* Next table waiting to be freed */
+    ChunkEntry* buckets[];
+} ChunkTable;
+
 /* Planar lazy mesh grid structure */
-typedef struct {
+typedef struct PlanarLazyMeshGrid {
     SylvesGrid base;                 /* Base grid structure */
     
     /* Chunk generation */
@@ -40,13 +66,32 @@ typedef struct {
     
     /* Options */
     SylvesMeshGridOptions options;
-    SylvesCachePolicy cache_policy;
+    SylvesChunkCachePolicy cache_policy;
+    bool caching;                    /* Policy caches and the table was allocated */
     
-    /* Cache */
-    ChunkEntry** chunk_cache;        /* Hash table for cached chunks */
-    size_t cache_size;               /* Size of hash table */
+    /* Cache. Lookups of ready chunks walk the published table and pin
+     * without the lock; every change to the cache holds it. */
+    SylvesMutex lock;
+    SylvesCond built_cond;           /* Broadcast whenever a build is published */
+    ChunkTable* table;               /* Published with release */
+    uint32_t readers;                /* Lock-free lookups in progress */
+    ChunkEntry* retired_entries;     /* Unlinked, freed once readers drain */
+    ChunkTable* retired_tables;
+    size_t retired_count;            /* Retired entries and tables; read without the lock */
+    size_t retired_bytes;            /* Estimated bytes held by retired entries */
     size_t cache_count;              /* Number of cached chunks */
-    size_t cache_max;                /* Maximum cached chunks (for LRU) */
+    size_t cache_max;                /* Maximum cached chunks (for LRU, 0 for unlimited) */
+    size_t cache_max_bytes;          /* Maximum cached bytes (for LRU, 0 for unlimited) */
+    size_t cache_bytes;              /* Estimated bytes held by cached chunks */
+    ChunkEntry* lru_head;            /* Newest and second-chance chunks */
+    ChunkEntry* lru_tail;            /* Where the eviction clock looks first */
+    SylvesJobQueue* builders;        /* Background builds, NULL unless async */
+    SylvesChunkLookupMode lookup_mode;
+    
+    /* Statistics; hits are counted without the lock */
+    size_t hit_count;
+    size_t miss_count;
+    size_t eviction_count;
 } PlanarLazyMeshGrid;
 
 /* Forward declarations */
@@ -116,25 +161,198 @@ static SylvesCell combine_cells(const PlanarLazyMeshGrid* grid,
     );
 }
 
-/* Helper: Get or create mesh grid for a chunk */
-static SylvesGrid* get_chunk_grid(PlanarLazyMeshGrid* grid, SylvesCell chunk_cell) {
-    /* Check cache first */
-    if (grid->cache_policy != SYLVES_CACHE_NONE && grid->chunk_cache) {
-        /* Simple hash based on chunk coordinates */
-        size_t hash = ((size_t)chunk_cell.x * 73856093) ^ 
-                     ((size_t)chunk_cell.y * 19349663);
-        size_t bucket = hash % grid->cache_size;
-        
-        ChunkEntry* entry = grid->chunk_cache[bucket];
-        while (entry) {
-            if (sylves_cell_equals(entry->chunk_cell, chunk_cell)) {
-                return entry->mesh_grid;  /* Found in cache */
+/* Helper: Hash bucket for a chunk */
+static size_t chunk_bucket(SylvesCell chunk_cell, size_t cache_size) {
+    size_t hash = ((size_t)chunk_cell.x * 73856093) ^ 
+                 ((size_t)chunk_cell.y * 19349663);
+    return hash % cache_size;
+}
+
+/* Helper: Find a chunk, either with the lock held or as a registered reader */
+static ChunkEntry* find_chunk(PlanarLazyMeshGrid* grid, SylvesCell chunk_cell) {
+    ChunkTable* table = sylves_atomic_load_ptr_acquire(&grid->table);
+    ChunkEntry* entry = sylves_atomic_load_ptr_acquire(&table->buckets[chunk_bucket(chunk_cell, table->size)]);
+    while (entry) {
+        if (sylves_cell_equals(entry->chunk_cell, chunk_cell)) {
+            return entry;
+        }
+        entry = sylves_atomic_load_ptr_acquire(&entry->next);
+    }
+    return NULL;
+}
+
+/* Helper: Take a pin unless the entry is being evicted */
+static bool try_pin(ChunkEntry* entry) {
+    uint32_t pins = sylves_atomic_load_u32(&entry->pins);
+    while (!(pins & CHUNK_EVICTED)) {
+        if (sylves_atomic_cas_u32(&entry->pins, pins, pins + 1)) {
+            return true;
+        }
+        pins = sylves_atomic_load_u32(&entry->pins);
+    }
+    return false;
+}
+
+/* Helper: Drop a pin, returning the pins left */
+static uint32_t drop_pin(ChunkEntry* entry) {
+    return sylves_atomic_fetch_add_u32_acq_rel(&entry->pins, (uint32_t)-1) - 1;
+}
+
+/* Clock list helpers; lock held */
+static void lru_unlink(PlanarLazyMeshGrid* grid, ChunkEntry* entry) {
+    if (entry->lru_prev) entry->lru_prev->lru_next = entry->lru_next;
+    else grid->lru_head = entry->lru_next;
+    if (entry->lru_next) entry->lru_next->lru_prev = entry->lru_prev;
+    else grid->lru_tail = entry->lru_prev;
+    entry->lru_prev = entry->lru_next = NULL;
+}
+
+static void lru_push_front(PlanarLazyMeshGrid* grid, ChunkEntry* entry) {
+    entry->lru_prev = NULL;
+    entry->lru_next = grid->lru_head;
+    if (grid->lru_head) grid->lru_head->lru_prev = entry;
+    else grid->lru_tail = entry;
+    grid->lru_head = entry;
+}
+
+/* Helper: Free what was unlinked once no lock-free lookup can still hold it; lock held
+ *
+ * Lookups register in readers before loading the table. Everything on the
+ * retired lists was unlinked before the fence, so once readers is seen at
+ * zero, later lookups cannot find it. Besides the writers that retire
+ * things, the last lookup to leave tries this, so steady lookup traffic
+ * cannot hold retired chunks indefinitely. */
+static void reclaim_retired(PlanarLazyMeshGrid* grid) {
+    if (!grid->retired_entries && !grid->retired_tables) return;
+    sylves_atomic_fence();
+    if (sylves_atomic_load_u32_seq_cst(&grid->readers) != 0) return;
+    
+    while (grid->retired_entries) {
+        ChunkEntry* entry = grid->retired_entries;
+        grid->retired_entries = entry->retired_next;
+        sylves_grid_destroy(entry->mesh_grid);
+        sylves_free(entry);
+    }
+    while (grid->retired_tables) {
+        ChunkTable* table = grid->retired_tables;
+        grid->retired_tables = table->retired_next;
+        sylves_free(table);
+    }
+    grid->retired_bytes = 0;
+    sylves_atomic_store_size(&grid->retired_count, 0);
+}
+
+/* Helper: Reclaim from the last lookup out, unless a writer holds the lock */
+static void reclaim_after_lookups(PlanarLazyMeshGrid* grid) {
+    if (sylves_mutex_trylock(&grid->lock)) {
+        reclaim_retired(grid);
+        sylves_mutex_unlock(&grid->lock);
+    }
+}
+
+/* Helper: Unlink an entry claimed for eviction and retire it; lock held */
+static void remove_chunk(PlanarLazyMeshGrid* grid, ChunkEntry* entry) {
+    ChunkEntry** link = &grid->table->buckets[chunk_bucket(entry->chunk_cell, grid->table->size)];
+    while (*link != entry) {
+        link = &(*link)->next;
+    }
+    /* entry->next stays intact for lookups standing on entry */
+    sylves_atomic_store_ptr_release(link, entry->next);
+    
+    lru_unlink(grid, entry);
+    grid->cache_count--;
+    grid->cache_bytes -= entry->bytes;
+    grid->retired_bytes += entry->bytes;
+    entry->retired_next = grid->retired_entries;
+    grid->retired_entries = entry;
+    sylves_atomic_store_size(&grid->retired_count, grid->retired_count + 1);
+}
+
+/* Retired chunks still hold their memory, so they count against the byte budget until freed */
+static bool over_budget(const PlanarLazyMeshGrid* grid) {
+    return (grid->cache_max > 0 && grid->cache_count > grid->cache_max) ||
+           (grid->cache_max_bytes > 0 && grid->cache_bytes + grid->retired_bytes > grid->cache_max_bytes);
+}
+
+/* Helper: Evict until within limits, sparing keep and pinned chunks; lock held
+ *
+ * Second-chance clock: hits only set a bit, since lock-free lookups cannot
+ * reorder the list. A referenced chunk at the tail moves to the head with
+ * its bit cleared; an unreferenced one is evicted. Every chunk is seen at
+ * most twice, so a cache full of pinned chunks stops over its limits. */
+static void evict_to_budget(PlanarLazyMeshGrid* grid, const ChunkEntry* keep) {
+    if (grid->cache_policy != SYLVES_CACHE_LRU) return;
+    
+    ChunkEntry* entry = grid->lru_tail;
+    size_t visits = 2 * grid->cache_count;
+    while (entry && over_budget(grid) && visits-- > 0) {
+        ChunkEntry* prev = entry->lru_prev;
+        if (entry != keep) {
+            if (sylves_atomic_load_u8(&entry->referenced)) {
+                sylves_atomic_store_u8(&entry->referenced, 0);
+                lru_unlink(grid, entry);
+                lru_push_front(grid, entry);
+            } else if (sylves_atomic_cas_u32_acquire(&entry->pins, 0, CHUNK_EVICTED)) {
+                /* Acquire: the last reader's release of its pin happens before the free */
+                remove_chunk(grid, entry);
+                grid->eviction_count++;
+                reclaim_retired(grid);
             }
-            entry = entry->next;
         }
+        entry = prev ? prev : grid->lru_tail;
+    }
+    reclaim_retired(grid);
+}
+
+static ChunkTable* create_table(size_t size) {
+    ChunkTable* table = sylves_calloc(1, sizeof(ChunkTable) + size * sizeof(ChunkEntry*));
+    if (table) {
+        table->size = size;
     }
+    return table;
+}
+
+/* Helper: Double the hash table once chains average more than one entry; lock held
+ *
+ * Relinking entries can divert a lookup walking the old table into a
+ * chain of the new one. Chains stay finite, so the worst case is a missed
+ * entry, which the locked path finds again. */
+static void grow_cache(PlanarLazyMeshGrid* grid) {
+    ChunkTable* old = grid->table;
+    ChunkTable* table = create_table(old->size * 2);
+    if (!table) return;  /* Keep the longer chains */
     
-    /* Generate mesh data for chunk */
+    for (size_t i = 0; i < old->size; i++) {
+        ChunkEntry* entry = old->buckets[i];
+        while (entry) {
+            ChunkEntry* next = entry->next;
+            ChunkEntry** bucket = &table->buckets[chunk_bucket(entry->chunk_cell, table->size)];
+            sylves_atomic_store_ptr_release(&entry->next, *bucket);
+            *bucket = entry;
+            entry = next;
+        }
+    }
+    sylves_atomic_store_ptr_release(&grid->table, table);
+    old->retired_next = grid->retired_tables;
+    grid->retired_tables = old;
+    sylves_atomic_store_size(&grid->retired_count, grid->retired_count + 1);
+    reclaim_retired(grid);
+}
+
+/* Helper: Approximate memory held by a mesh grid built from mesh_data */
+static size_t chunk_footprint(const SylvesMeshData* mesh_data) {
+    size_t bytes = sizeof(SylvesGrid) * 2 + sizeof(SylvesMeshData) + sizeof(ChunkEntry);
+    bytes += mesh_data->vertex_count * sizeof(SylvesVector3);
+    bytes += mesh_data->face_count * sizeof(SylvesMeshFace);
+    for (size_t i = 0; i < mesh_data->face_count; i++) {
+        bytes += 2 * sizeof(int) * (size_t)mesh_data->faces[i].vertex_count;
+    }
+    return bytes;
+}
+
+/* Helper: Generate the mesh grid for a chunk; reads only immutable fields, so runs unlocked */
+static SylvesGrid* generate_chunk(const PlanarLazyMeshGrid* grid, SylvesCell chunk_cell, size_t* bytes) {
+    *bytes = sizeof(ChunkEntry);
     SylvesMeshData* mesh_data = grid->get_mesh_data(
         chunk_cell.x, chunk_cell.y, grid->user_data);
     
@@ -160,32 +378,178 @@ static SylvesGrid* get_chunk_grid(PlanarLazyMeshGrid* grid, SylvesCell chunk_cel
         sylves_mesh_compute_adjacency(mesh_data);
     }
     
-    /* Create mesh grid */
+    /* Create mesh grid; it keeps its own copy of the mesh */
     SylvesGrid* mesh_grid = sylves_mesh_grid_create(mesh_data);
+    if (mesh_grid) {
+        *bytes = chunk_footprint(mesh_data);
+    }
+    sylves_mesh_data_destroy(mesh_data);
     
-    /* Cache the result */
-    if (grid->cache_policy != SYLVES_CACHE_NONE && grid->chunk_cache && mesh_grid) {
-        size_t hash = ((size_t)chunk_cell.x * 73856093) ^ 
-                     ((size_t)chunk_cell.y * 19349663);
-        size_t bucket = hash % grid->cache_size;
-        
-        ChunkEntry* entry = sylves_alloc(sizeof(ChunkEntry));
-        if (entry) {
-            entry->chunk_cell = chunk_cell;
-            entry->mesh_data = mesh_data;
-            entry->mesh_grid = mesh_grid;
-            entry->next = grid->chunk_cache[bucket];
-            grid->chunk_cache[bucket] = entry;
-            grid->cache_count++;
-            
-            /* TODO: Implement LRU eviction for SYLVES_CACHE_LRU */
+    return mesh_grid;
+}
+
+/* Helper: Add a building entry for a chunk not in the table; lock held */
+static ChunkEntry* insert_building(PlanarLazyMeshGrid* grid, SylvesCell chunk_cell) {
+    ChunkEntry* entry = sylves_calloc(1, sizeof(ChunkEntry));
+    if (!entry) return NULL;
+    
+    if (grid->cache_count >= grid->table->size) {
+        grow_cache(grid);
+    }
+    ChunkEntry** bucket = &grid->table->buckets[chunk_bucket(chunk_cell, grid->table->size)];
+    entry->chunk_cell = chunk_cell;
+    entry->state = SYLVES_CHUNK_BUILDING;
+    entry->owner = grid;
+    entry->next = *bucket;
+    sylves_atomic_store_ptr_release(bucket, entry);
+    grid->cache_count++;
+    grid->miss_count++;
+    return entry;
+}
+
+/* Helper: Publish a finished build and wake its waiters; lock held */
+static void publish_chunk(PlanarLazyMeshGrid* grid, ChunkEntry* entry, SylvesGrid* mesh_grid, size_t bytes) {
+    entry->mesh_grid = mesh_grid;
+    entry->bytes = bytes;
+    sylves_atomic_store_u32_release(&entry->state, mesh_grid ? SYLVES_CHUNK_READY : SYLVES_CHUNK_FAILED);
+    grid->cache_bytes += bytes;
+    lru_push_front(grid, entry);
+    evict_to_budget(grid, entry);
+    sylves_cond_broadcast(&grid->built_cond);
+}
+
+/* Helper: Build a chunk on the calling thread, leaving it pinned; lock held,
+ * released while generating */
+static void build_chunk_here(PlanarLazyMeshGrid* grid, ChunkEntry* entry) {
+    try_pin(entry);
+    sylves_mutex_unlock(&grid->lock);
+    size_t bytes = 0;
+    SylvesGrid* mesh_grid = generate_chunk(grid, entry->chunk_cell, &bytes);
+    sylves_mutex_lock(&grid->lock);
+    publish_chunk(grid, entry, mesh_grid, bytes);
+}
+
+static void build_job(void* user_data) {
+    ChunkEntry* entry = (ChunkEntry*)user_data;
+    PlanarLazyMeshGrid* grid = entry->owner;
+    size_t bytes = 0;
+    SylvesGrid* mesh_grid = generate_chunk(grid, entry->chunk_cell, &bytes);
+    sylves_mutex_lock(&grid->lock);
+    publish_chunk(grid, entry, mesh_grid, bytes);
+    sylves_mutex_unlock(&grid->lock);
+}
+
+/* Helper: Hand a building entry to the background builders; lock held.
+ * Returns false when there are none, and the caller builds it instead. */
+static bool schedule_build(PlanarLazyMeshGrid* grid, ChunkEntry* entry) {
+    return grid->builders && sylves_job_queue_submit(grid->builders, build_job, entry);
+}
+
+/* Helper: Drop a pin taken under the lock; a chunk left unpinned counts
+ * as just used and is spared by the eviction that follows. Lock held. */
+static void unpin_locked(PlanarLazyMeshGrid* grid, ChunkEntry* entry) {
+    if (drop_pin(entry) == 0 && entry->state != SYLVES_CHUNK_BUILDING) {
+        sylves_atomic_store_u8(&entry->referenced, 1);
+        evict_to_budget(grid, entry);
+    }
+}
+
+/* Helper: Get a chunk for a lookup, pinned until release_chunk
+ *
+ * Ready chunks are found and pinned without the lock. Otherwise this
+ * builds a missing chunk on the calling thread, or waits for a build in
+ * progress. Unless force_wait is set, the grid's lookup mode may say
+ * otherwise: then a missing chunk is queued for the background builders
+ * and NULL returned until it is ready. Also returns NULL for chunks whose
+ * generation failed. */
+static ChunkEntry* acquire_chunk(PlanarLazyMeshGrid* grid, SylvesCell chunk_cell, bool force_wait) {
+    if (!grid->caching) {
+        /* Not caching: the lookup owns a private chunk that release_chunk frees */
+        sylves_mutex_lock(&grid->lock);
+        grid->miss_count++;
+        sylves_mutex_unlock(&grid->lock);
+        size_t bytes = 0;
+        SylvesGrid* mesh_grid = generate_chunk(grid, chunk_cell, &bytes);
+        ChunkEntry* entry = mesh_grid ? sylves_calloc(1, sizeof(ChunkEntry)) : NULL;
+        if (!entry) {
+            sylves_grid_destroy(mesh_grid);
+            return NULL;
+        }
+        entry->chunk_cell = chunk_cell;
+        entry->mesh_grid = mesh_grid;
+        entry->state = SYLVES_CHUNK_READY;
+        return entry;
+    }
+    
+    /* Fast path */
+    sylves_atomic_add_u32_seq_cst(&grid->readers, 1);
+    sylves_atomic_fence();
+    ChunkEntry* entry = find_chunk(grid, chunk_cell);
+    uint32_t state = entry ? sylves_atomic_load_u32_acquire(&entry->state) : SYLVES_CHUNK_NOT_LOADED;
+    bool pinned = state == SYLVES_CHUNK_READY && try_pin(entry);
+    if (sylves_atomic_fetch_add_u32_acq_rel(&grid->readers, (uint32_t)-1) == 1 &&
+        sylves_atomic_load_size(&grid->retired_count) > 0) {
+        reclaim_after_lookups(grid);
+    }
+    if (pinned || state == SYLVES_CHUNK_FAILED) {
+        sylves_atomic_add_size(&grid->hit_count, 1);
+        if (!pinned) return NULL;
+        if (!sylves_atomic_load_u8(&entry->referenced)) {
+            sylves_atomic_store_u8(&entry->referenced, 1);
+        }
+        return entry;
+    }
+    
+    sylves_mutex_lock(&grid->lock);
+    bool wait = force_wait || grid->lookup_mode == SYLVES_CHUNK_LOOKUP_BLOCK;
+    entry = find_chunk(grid, chunk_cell);
+    if (!entry) {
+        entry = insert_building(grid, chunk_cell);
+        if (!entry || (!wait && schedule_build(grid, entry))) {
+            sylves_mutex_unlock(&grid->lock);
+            return NULL;
+        }
+        build_chunk_here(grid, entry);
+    } else if (entry->state == SYLVES_CHUNK_BUILDING) {
+        if (!wait) {
+            sylves_mutex_unlock(&grid->lock);
+            return NULL;
+        }
+        /* The pin keeps the entry from eviction once published */
+        sylves_atomic_add_size(&grid->hit_count, 1);
+        try_pin(entry);
+        while (entry->state == SYLVES_CHUNK_BUILDING) {
+            sylves_cond_wait(&grid->built_cond, &grid->lock);
         }
     } else {
-        /* Not caching, so clean up mesh data */
-        sylves_mesh_data_destroy(mesh_data);
+        /* Lost a race with the build or the fast path was diverted; entries
+         * in the table are never claimed for eviction while the lock is held */
+        sylves_atomic_add_size(&grid->hit_count, 1);
+        try_pin(entry);
     }
     
-    return mesh_grid;
+    if (entry->state != SYLVES_CHUNK_READY) {
+        unpin_locked(grid, entry);
+        sylves_mutex_unlock(&grid->lock);
+        return NULL;
+    }
+    sylves_mutex_unlock(&grid->lock);
+    return entry;
+}
+
+static void release_chunk(PlanarLazyMeshGrid* grid, ChunkEntry* entry) {
+    if (!grid->caching) {
+        sylves_grid_destroy(entry->mesh_grid);
+        sylves_free(entry);
+        return;
+    }
+    
+    drop_pin(entry);
+}
+
+/* Helper: Lookup from a vtable function, honouring the lookup mode */
+static ChunkEntry* lookup_chunk(const SylvesGrid* grid, SylvesCell chunk_cell) {
+    return acquire_chunk((PlanarLazyMeshGrid*)grid->data, chunk_cell, false);
 }
 
 /* Implementation of vtable functions */
@@ -194,24 +558,25 @@ static void planar_lazy_destroy(SylvesGrid* grid) {
     
     PlanarLazyMeshGrid* plmg = (PlanarLazyMeshGrid*)grid->data;
     
-    /* Clean up cache */
-    if (plmg->chunk_cache) {
-        for (size_t i = 0; i < plmg->cache_size; i++) {
-            ChunkEntry* entry = plmg->chunk_cache[i];
+    /* Finish or drop background builds before freeing what they publish to */
+    sylves_job_queue_destroy(plmg->builders);
+    
+    /* Clean up cache; no lookups remain, so everything retired goes too */
+    if (plmg->table) {
+        for (size_t i = 0; i < plmg->table->size; i++) {
+            ChunkEntry* entry = plmg->table->buckets[i];
             while (entry) {
                 ChunkEntry* next = entry->next;
-                if (entry->mesh_grid) {
-                    entry->mesh_grid->vtable->destroy(entry->mesh_grid);
-                }
-                if (entry->mesh_data) {
-                    sylves_mesh_data_destroy(entry->mesh_data);
-                }
+                sylves_grid_destroy(entry->mesh_grid);
                 sylves_free(entry);
                 entry = next;
             }
         }
-        sylves_free(plmg->chunk_cache);
+        sylves_free(plmg->table);
     }
+    reclaim_retired(plmg);
+    sylves_cond_destroy(&plmg->built_cond);
+    sylves_mutex_destroy(&plmg->lock);
     
     sylves_free(plmg);
     sylves_free(grid);
@@ -230,13 +595,16 @@ static bool planar_lazy_is_cell_in_grid(const SylvesGrid* grid, SylvesCell cell)
     split_cell(plmg, cell, &chunk_cell, &local_cell);
     
     /* Get or create chunk grid */
-    SylvesGrid* chunk_grid = get_chunk_grid(plmg, chunk_cell);
-    if (!chunk_grid) {
+    ChunkEntry* chunk = lookup_chunk(grid, chunk_cell);
+    if (!chunk) {
         return false;
     }
     
     /* Check if local cell is in chunk grid */
-    return chunk_grid->vtable->is_cell_in_grid(chunk_grid, local_cell);
+    SylvesGrid* chunk_grid = chunk->mesh_grid;
+    bool in_grid = chunk_grid->vtable->is_cell_in_grid(chunk_grid, local_cell);
+    release_chunk(plmg, chunk);
+    return in_grid;
 }
 
 static SylvesVector3 planar_lazy_get_cell_center(const SylvesGrid* grid, SylvesCell cell) {
@@ -245,12 +613,14 @@ static SylvesVector3 planar_lazy_get_cell_center(const SylvesGrid* grid, SylvesC
     SylvesCell chunk_cell, local_cell;
     split_cell(plmg, cell, &chunk_cell, &local_cell);
     
-    SylvesGrid* chunk_grid = get_chunk_grid(plmg, chunk_cell);
-    if (!chunk_grid) {
+    ChunkEntry* chunk = lookup_chunk(grid, chunk_cell);
+    if (!chunk) {
         return (SylvesVector3){0, 0, 0};
     }
     
+    SylvesGrid* chunk_grid = chunk->mesh_grid;
     SylvesVector3 local_center = chunk_grid->vtable->get_cell_center(chunk_grid, local_cell);
+    release_chunk(plmg, chunk);
     
     /* Add chunk offset if not already translated */
     if (!plmg->translate_mesh_data) {
@@ -272,12 +642,14 @@ static int planar_lazy_get_polygon(const SylvesGrid* grid, SylvesCell cell,
     SylvesCell chunk_cell, local_cell;
     split_cell(plmg, cell, &chunk_cell, &local_cell);
     
-    SylvesGrid* chunk_grid = get_chunk_grid(plmg, chunk_cell);
-    if (!chunk_grid) {
+    ChunkEntry* chunk = lookup_chunk(grid, chunk_cell);
+    if (!chunk) {
         return -1;
     }
     
+    SylvesGrid* chunk_grid = chunk->mesh_grid;
     int count = chunk_grid->vtable->get_polygon(chunk_grid, local_cell, vertices, max_vertices);
+    release_chunk(plmg, chunk);
     
     /* Add chunk offset if not already translated */
     if (!plmg->translate_mesh_data && vertices && count > 0) {
@@ -303,15 +675,18 @@ static bool planar_lazy_try_move(const SylvesGrid* grid, SylvesCell cell, Sylves
     SylvesCell chunk_cell, local_cell;
     split_cell(plmg, cell, &chunk_cell, &local_cell);
     
-    SylvesGrid* chunk_grid = get_chunk_grid(plmg, chunk_cell);
-    if (!chunk_grid) {
+    ChunkEntry* chunk = lookup_chunk(grid, chunk_cell);
+    if (!chunk) {
         return false;
     }
     
     /* Try move within chunk first */
     SylvesCell local_dest;
-    if (chunk_grid->vtable->try_move(chunk_grid, local_cell, dir, 
-                                     &local_dest, inverse_dir, connection)) {
+    SylvesGrid* chunk_grid = chunk->mesh_grid;
+    bool moved = chunk_grid->vtable->try_move(chunk_grid, local_cell, dir,
+                                              &local_dest, inverse_dir, connection);
+    release_chunk(plmg, chunk);
+    if (moved) {
         /* Move succeeded within chunk */
         if (dest) {
             *dest = combine_cells(plmg, chunk_cell, local_dest);
@@ -326,6 +701,235 @@ static bool planar_lazy_try_move(const SylvesGrid* grid, SylvesCell cell, Sylves
 }
 
 /* Public API implementation */
+static PlanarLazyMeshGrid* as_planar_lazy(const SylvesGrid* grid) {
+    if (!grid || grid->vtable != &planar_lazy_vtable) return NULL;
+    return (PlanarLazyMeshGrid*)grid->data;
+}
+
+SylvesCell sylves_planar_lazy_mesh_grid_get_chunk(const SylvesGrid* grid, SylvesCell cell) {
+    SylvesCell chunk_cell = {0, 0, 0};
+    PlanarLazyMeshGrid* plmg = as_planar_lazy(grid);
+    if (plmg) {
+        split_cell(plmg, cell, &chunk_cell, NULL);
+    }
+    return chunk_cell;
+}
+
+SylvesError sylves_planar_lazy_mesh_grid_set_cache_limits(
+    SylvesGrid* grid,
+    size_t max_chunks,
+    size_t max_bytes) {
+    
+    PlanarLazyMeshGrid* plmg = as_planar_lazy(grid);
+    if (!plmg) {
+        return SYLVES_ERROR_INVALID_ARGUMENT;
+    }
+    
+    sylves_mutex_lock(&plmg->lock);
+    plmg->cache_max = max_chunks;
+    plmg->cache_max_bytes = max_bytes;
+    evict_to_budget(plmg, NULL);
+    sylves_mutex_unlock(&plmg->lock);
+    return SYLVES_SUCCESS;
+}
+
+SylvesError sylves_planar_lazy_mesh_grid_pin_chunk(SylvesGrid* grid, SylvesCell chunk_cell) {
+    PlanarLazyMeshGrid* plmg = as_planar_lazy(grid);
+    if (!plmg || !plmg->caching) {
+        return SYLVES_ERROR_INVALID_ARGUMENT;
+    }
+    
+    /* The lookup's pin is kept as the user's pin */
+    ChunkEntry* entry = acquire_chunk(plmg, chunk_cell, true);
+    if (!entry) {
+        return SYLVES_ERROR_NOT_FOUND;
+    }
+    sylves_mutex_lock(&plmg->lock);
+    entry->user_pins++;
+    sylves_mutex_unlock(&plmg->lock);
+    return SYLVES_SUCCESS;
+}
+
+void sylves_planar_lazy_mesh_grid_unpin_chunk(SylvesGrid* grid, SylvesCell chunk_cell) {
+    PlanarLazyMeshGrid* plmg = as_planar_lazy(grid);
+    if (!plmg) return;
+    
+    sylves_mutex_lock(&plmg->lock);
+    ChunkEntry* entry = find_chunk(plmg, chunk_cell);
+    /* Pins held by lookups and waits in flight are not the caller's to drop */
+    if (entry && entry->user_pins > 0) {
+        entry->user_pins--;
+        unpin_locked(plmg, entry);
+    }
+    sylves_mutex_unlock(&plmg->lock);
+}
+
+void sylves_planar_lazy_mesh_grid_get_cache_stats(const SylvesGrid* grid, SylvesCacheStats* stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    
+    PlanarLazyMeshGrid* plmg = as_planar_lazy(grid);
+    if (!plmg) return;
+    
+    sylves_mutex_lock(&plmg->lock);
+    stats->total_entries = plmg->cache_count;
+    stats->memory_used = plmg->cache_bytes + plmg->retired_bytes;
+    stats->hit_count = sylves_atomic_load_size(&plmg->hit_count);
+    stats->miss_count = plmg->miss_count;
+    stats->eviction_count = plmg->eviction_count;
+    sylves_mutex_unlock(&plmg->lock);
+    size_t lookups = stats->hit_count + stats->miss_count;
+    if (lookups > 0) {
+        stats->hit_rate = (double)stats->hit_count / lookups * 100.0;
+    }
+}
+
+SylvesError sylves_planar_lazy_mesh_grid_enable_async(
+    SylvesGrid* grid,
+    int worker_count,
+    SylvesChunkLookupMode mode) {
+
+    PlanarLazyMeshGrid* plmg = as_planar_lazy(grid);
+    if (!plmg || !plmg->caching) {
+        return SYLVES_ERROR_INVALID_ARGUMENT;
+    }
+
+    sylves_mutex_lock(&plmg->lock);
+    bool started = plmg->builders != NULL;
+    sylves_mutex_unlock(&plmg->lock);
+
+    SylvesJobQueue* builders = started ? NULL : sylves_job_queue_create(worker_count);
+    if (!started && !builders) {
+        return SYLVES_ERROR_OUT_OF_MEMORY;
+    }
+
+    sylves_mutex_lock(&plmg->lock);
+    if (!plmg->builders) {
+        plmg->builders = builders;
+        builders = NULL;
+    }
+    plmg->lookup_mode = mode;
+    sylves_mutex_unlock(&plmg->lock);
+
+    /* Lost a race with another caller */
+    sylves_job_queue_destroy(builders);
+    return SYLVES_SUCCESS;
+}
+
+/* Helper: Start building a chunk unless it is cached or building; lock held */
+static bool prefetch_chunk(PlanarLazyMeshGrid* grid, SylvesCell chunk_cell) {
+    if (find_chunk(grid, chunk_cell)) {
+        return false;
+    }
+    ChunkEntry* entry = insert_building(grid, chunk_cell);
+    if (!entry) {
+        return false;
+    }
+    if (!schedule_build(grid, entry)) {
+        build_chunk_here(grid, entry);
+        unpin_locked(grid, entry);
+    }
+    return true;
+}
+
+size_t sylves_planar_lazy_mesh_grid_prefetch_region(SylvesGrid* grid, const SylvesAabb* region) {
+    PlanarLazyMeshGrid* plmg = as_planar_lazy(grid);
+    if (!plmg || !plmg->caching || !region) {
+        return 0;
+    }
+
+    /* A chunk overlaps the region when its offset cx * stride_x + cy * stride_y
+     * lies in [region.min - aabb_max, region.max - aabb_min]. Mapping the
+     * corners of that box back through the stride matrix bounds cx and cy. */
+    double det = plmg->stride_x.x * plmg->stride_y.y - plmg->stride_y.x * plmg->stride_x.y;
+    if (fabs(det) < 1e-12) {
+        return 0;
+    }
+    double lo_x = region->min.x - plmg->aabb_max.x;
+    double lo_y = region->min.y - plmg->aabb_max.y;
+    double hi_x = region->max.x - plmg->aabb_min.x;
+    double hi_y = region->max.y - plmg->aabb_min.y;
+    if (lo_x > hi_x || lo_y > hi_y) {
+        return 0;
+    }
+
+    double min_cx = INFINITY, max_cx = -INFINITY, min_cy = INFINITY, max_cy = -INFINITY;
+    for (int corner = 0; corner < 4; corner++) {
+        double ox = (corner & 1) ? hi_x : lo_x;
+        double oy = (corner & 2) ? hi_y : lo_y;
+        double cx = (ox * plmg->stride_y.y - oy * plmg->stride_y.x) / det;
+        double cy = (oy * plmg->stride_x.x - ox * plmg->stride_x.y) / det;
+        min_cx = fmin(min_cx, cx);
+        max_cx = fmax(max_cx, cx);
+        min_cy = fmin(min_cy, cy);
+        max_cy = fmax(max_cy, cy);
+    }
+
+    size_t scheduled = 0;
+    sylves_mutex_lock(&plmg->lock);
+    for (int cy = (int)floor(min_cy); cy <= (int)ceil(max_cy); cy++) {
+        for (int cx = (int)floor(min_cx); cx <= (int)ceil(max_cx); cx++) {
+            double ox = cx * plmg->stride_x.x + cy * plmg->stride_y.x;
+            double oy = cx * plmg->stride_x.y + cy * plmg->stride_y.y;
+            if (ox < lo_x || ox > hi_x || oy < lo_y || oy > hi_y) {
+                continue;
+            }
+            if (prefetch_chunk(plmg, sylves_cell_create(cx, cy, 0))) {
+                scheduled++;
+            }
+        }
+    }
+    sylves_mutex_unlock(&plmg->lock);
+    return scheduled;
+}
+
+SylvesChunkState sylves_planar_lazy_mesh_grid_get_chunk_state(const SylvesGrid* grid, SylvesCell chunk_cell) {
+    PlanarLazyMeshGrid* plmg = as_planar_lazy(grid);
+    if (!plmg || !plmg->caching) {
+        return SYLVES_CHUNK_NOT_LOADED;
+    }
+
+    sylves_mutex_lock(&plmg->lock);
+    ChunkEntry* entry = find_chunk(plmg, chunk_cell);
+    SylvesChunkState state = entry ? entry->state : SYLVES_CHUNK_NOT_LOADED;
+    sylves_mutex_unlock(&plmg->lock);
+    return state;
+}
+
+SylvesChunkState sylves_planar_lazy_mesh_grid_wait_chunk(SylvesGrid* grid, SylvesCell chunk_cell) {
+    PlanarLazyMeshGrid* plmg = as_planar_lazy(grid);
+    if (!plmg || !plmg->caching) {
+        return SYLVES_CHUNK_NOT_LOADED;
+    }
+
+    sylves_mutex_lock(&plmg->lock);
+    ChunkEntry* entry = find_chunk(plmg, chunk_cell);
+    SylvesChunkState state = entry ? entry->state : SYLVES_CHUNK_NOT_LOADED;
+    if (state == SYLVES_CHUNK_BUILDING) {
+        /* Pinned so that it cannot be evicted between the wakeup and the read */
+        try_pin(entry);
+        while (entry->state == SYLVES_CHUNK_BUILDING) {
+            sylves_cond_wait(&plmg->built_cond, &plmg->lock);
+        }
+        state = entry->state;
+        unpin_locked(plmg, entry);
+    }
+    sylves_mutex_unlock(&plmg->lock);
+    return state;
+}
+
+void sylves_planar_lazy_mesh_grid_wait_for_builds(SylvesGrid* grid) {
+    PlanarLazyMeshGrid* plmg = as_planar_lazy(grid);
+    if (!plmg) return;
+
+    sylves_mutex_lock(&plmg->lock);
+    SylvesJobQueue* builders = plmg->builders;
+    sylves_mutex_unlock(&plmg->lock);
+    if (builders) {
+        sylves_job_queue_wait_idle(builders);
+    }
+}
+
 void sylves_mesh_grid_options_init(SylvesMeshGridOptions* options) {
     if (!options) return;
     
@@ -344,14 +948,14 @@ SylvesGrid* sylves_planar_lazy_mesh_grid_create(
     bool translate_mesh_data,
     const SylvesMeshGridOptions* options,
     const SylvesBound* bound,
-    SylvesCachePolicy cache_policy,
+    SylvesChunkCachePolicy cache_policy,
     void* user_data) {
     
     if (!get_mesh_data) {
         return NULL;
     }
     
-    PlanarLazyMeshGrid* plmg = sylves_alloc(sizeof(PlanarLazyMeshGrid));
+    PlanarLazyMeshGrid* plmg = sylves_calloc(1, sizeof(PlanarLazyMeshGrid));
     if (!plmg) {
         return NULL;
     }
@@ -365,6 +969,8 @@ SylvesGrid* sylves_planar_lazy_mesh_grid_create(
     plmg->aabb_max = aabb_max;
     plmg->translate_mesh_data = translate_mesh_data;
     plmg->cache_policy = cache_policy;
+    sylves_mutex_init(&plmg->lock);
+    sylves_cond_init(&plmg->built_cond);
     
     /* Copy or init options */
     if (options) {
@@ -375,19 +981,18 @@ SylvesGrid* sylves_planar_lazy_mesh_grid_create(
     
     /* Initialize cache */
     if (cache_policy != SYLVES_CACHE_NONE) {
-        plmg->cache_size = 256;  /* Fixed size hash table */
-        plmg->chunk_cache = sylves_alloc(sizeof(ChunkEntry*) * plmg->cache_size);
-        if (plmg->chunk_cache) {
-            memset(plmg->chunk_cache, 0, sizeof(ChunkEntry*) * plmg->cache_size);
-        }
+        plmg->table = create_table(256);  /* Doubles as chunks are added */
+        plmg->caching = plmg->table != NULL;
         plmg->cache_count = 0;
-        plmg->cache_max = (cache_policy == SYLVES_CACHE_LRU) ? 100 : SIZE_MAX;
+        plmg->cache_max = (cache_policy == SYLVES_CACHE_LRU) ? SYLVES_CHUNK_CACHE_DEFAULT_MAX_CHUNKS : 0;
     }
     
     /* Create grid */
     SylvesGrid* grid = sylves_alloc(sizeof(SylvesGrid));
     if (!grid) {
-        sylves_free(plmg->chunk_cache);
+        sylves_free(plmg->table);
+        sylves_cond_destroy(&plmg->built_cond);
+        sylves_mutex_destroy(&plmg->lock);
         sylves_free(plmg);
         return NULL;
     }
@@ -409,7 +1014,7 @@ SylvesGrid* sylves_planar_lazy_mesh_grid_create_square(
     bool translate_mesh_data,
     const SylvesMeshGridOptions* options,
     const SylvesBound* bound,
-    SylvesCachePolicy cache_policy,
+    SylvesChunkCachePolicy cache_policy,
     void* user_data) {
     
     SylvesVector2 stride_x = {chunk_size, 0};
@@ -429,7 +1034,7 @@ SylvesGrid* sylves_planar_lazy_mesh_grid_create_hex(
     bool translate_mesh_data,
     const SylvesMeshGridOptions* options,
     const SylvesBound* bound,
-    SylvesCachePolicy cache_policy,
+    SylvesChunkCachePolicy cache_policy,
     void* user_data) {
     
     /* Hexagonal chunk layout */
@@ -0,0 +1,345 @@
+/**
+ * @file priority_queue.c
+ * @brief Indexed 4-ary heap and monotone radix heap with decrease-key
+ */
+
+#include "sylves/pathfinding.h"
+#include "sylves/memory.h"
+#include "internal/sync.h"
+#include <string.h>
+
+/* Grow a per-handle position array so handle is addressable; new slots are zeroed */
+static bool reserve_positions(void** positions, size_t* capacity, size_t element_size, uint32_t handle) {
+    if ((size_t)handle < *capacity) return true;
+    size_t new_capacity = *capacity ? *capacity : 64;
+    while (new_capacity <= (size_t)handle) new_capacity *= 2;
+    void* grown = sylves_realloc(*positions, element_size * new_capacity);
+    if (!grown) return false;
+    memset((char*)grown + element_size * *capacity, 0, element_size * (new_capacity - *capacity));
+    *positions = grown;
+    *capacity = new_capacity;
+    return true;
+}
+
+/* Indexed 4-ary heap */
+
+#define HEAP_ARITY 4
+
+SylvesIndexedHeap* sylves_indexed_heap_create(size_t initial_capacity) {
+    SylvesIndexedHeap* heap = (SylvesIndexedHeap*)sylves_calloc(1, sizeof(SylvesIndexedHeap));
+    if (!heap) return NULL;
+
+    heap->capacity = initial_capacity > 16 ? initial_capacity : 16;
+    heap->entries = (SylvesQueueEntry*)sylves_alloc(sizeof(SylvesQueueEntry) * heap->capacity);
+    if (!heap->entries) {
+        sylves_free(heap);
+        return NULL;
+    }
+    return heap;
+}
+
+void sylves_indexed_heap_destroy(SylvesIndexedHeap* heap) {
+    if (!heap) return;
+    sylves_free(heap->entries);
+    sylves_free(heap->positions);
+    sylves_free(heap);
+}
+
+static inline bool indexed_heap_find(const SylvesIndexedHeap* heap, uint32_t handle, size_t* index) {
+    if ((size_t)handle >= heap->position_capacity) return false;
+    size_t i = heap->positions[handle];
+    if (i >= heap->size || heap->entries[i].handle != handle) return false;
+    *index = i;
+    return true;
+}
+
+/* Move entry up from index i, shifting larger parents down into the hole */
+static void indexed_heap_sift_up(SylvesIndexedHeap* heap, size_t i, SylvesQueueEntry entry) {
+    while (i > 0) {
+        size_t p = (i - 1) / HEAP_ARITY;
+        if (heap->entries[p].key <= entry.key) break;
+        heap->entries[i] = heap->entries[p];
+        heap->positions[heap->entries[i].handle] = (uint32_t)i;
+        i = p;
+    }
+    heap->entries[i] = entry;
+    heap->positions[entry.handle] = (uint32_t)i;
+}
+
+static void indexed_heap_sift_down(SylvesIndexedHeap* heap, size_t i, SylvesQueueEntry entry) {
+    for (;;) {
+        size_t first = i * HEAP_ARITY + 1;
+        if (first >= heap->size) break;
+        size_t last = first + HEAP_ARITY < heap->size ? first + HEAP_ARITY : heap->size;
+        size_t smallest = first;
+        for (size_t c = first + 1; c < last; c++) {
+            if (heap->entries[c].key < heap->entries[smallest].key) smallest = c;
+        }
+        if (heap->entries[smallest].key >= entry.key) break;
+        heap->entries[i] = heap->entries[smallest];
+        heap->positions[heap->entries[i].handle] = (uint32_t)i;
+        i = smallest;
+    }
+    heap->entries[i] = entry;
+    heap->positions[entry.handle] = (uint32_t)i;
+}
+
+bool sylves_indexed_heap_push(SylvesIndexedHeap* heap, uint32_t handle, float key) {
+    if (!heap) return false;
+
+    size_t i;
+    if (indexed_heap_find(heap, handle, &i)) {
+        if (key < heap->entries[i].key) {
+            SylvesQueueEntry entry = { key, handle };
+            indexed_heap_sift_up(heap, i, entry);
+        }
+        return true;
+    }
+
+    if (!reserve_positions((void**)&heap->positions, &heap->position_capacity, sizeof(uint32_t), handle)) {
+        return false;
+    }
+    if (heap->size == heap->capacity) {
+        size_t capacity = heap->capacity * 2;
+        SylvesQueueEntry* entries = (SylvesQueueEntry*)sylves_realloc(heap->entries, sizeof(SylvesQueueEntry) * capacity);
+        if (!entries) return false;
+        heap->entries = entries;
+        heap->capacity = capacity;
+    }
+
+    SylvesQueueEntry entry = { key, handle };
+    indexed_heap_sift_up(heap, heap->size++, entry);
+    return true;
+}
+
+bool sylves_indexed_heap_decrease_key(SylvesIndexedHeap* heap, uint32_t handle, float key) {
+    size_t i;
+    if (!heap || !indexed_heap_find(heap, handle, &i) || !(key < heap->entries[i].key)) {
+        return false;
+    }
+    SylvesQueueEntry entry = { key, handle };
+    indexed_heap_sift_up(heap, i, entry);
+    return true;
+}
+
+bool sylves_indexed_heap_update(SylvesIndexedHeap* heap, uint32_t handle, float key) {
+    size_t i;
+    if (!heap || !indexed_heap_find(heap, handle, &i)) {
+        return sylves_indexed_heap_push(heap, handle, key);
+    }
+    SylvesQueueEntry entry = { key, handle };
+    if (key < heap->entries[i].key) {
+        indexed_heap_sift_up(heap, i, entry);
+    } else {
+        indexed_heap_sift_down(heap, i, entry);
+    }
+    return true;
+}
+
+bool sylves_indexed_heap_remove(SylvesIndexedHeap* heap, uint32_t handle) {
+    size_t i;
+    if (!heap || !indexed_heap_find(heap, handle, &i)) return false;
+
+    heap->positions[handle] = UINT32_MAX;
+    SylvesQueueEntry last = heap->entries[--heap->size];
+    if (i < heap->size) {
+        /* The moved-in entry may belong above or below the hole */
+        if (i > 0 && last.key < heap->entries[(i - 1) / HEAP_ARITY].key) {
+            indexed_heap_sift_up(heap, i, last);
+        } else {
+            indexed_heap_sift_down(heap, i, last);
+        }
+    }
+    return true;
+}
+
+bool sylves_indexed_heap_pop(SylvesIndexedHeap* heap, uint32_t* handle, float* key) {
+    if (!heap || heap->size == 0) return false;
+
+    if (handle) *handle = heap->entries[0].handle;
+    if (key) *key = heap->entries[0].key;
+
+    /* Invalidate the popped handle's position before its entry is overwritten */
+    heap->positions[heap->entries[0].handle] = UINT32_MAX;
+    SylvesQueueEntry last = heap->entries[--heap->size];
+    if (heap->size > 0) {
+        indexed_heap_sift_down(heap, 0, last);
+    }
+    return true;
+}
+
+bool sylves_indexed_heap_peek_key(const SylvesIndexedHeap* heap, float* key) {
+    if (!heap || heap->size == 0) return false;
+    if (key) *key = heap->entries[0].key;
+    return true;
+}
+
+bool sylves_indexed_heap_contains(const SylvesIndexedHeap* heap, uint32_t handle) {
+    size_t i;
+    return heap && indexed_heap_find(heap, handle, &i);
+}
+
+bool sylves_indexed_heap_is_empty(const SylvesIndexedHeap* heap) {
+    return !heap || heap->size == 0;
+}
+
+void sylves_indexed_heap_clear(SylvesIndexedHeap* heap) {
+    if (heap) heap->size = 0;
+}
+
+/* Monotone radix heap */
+
+/* Non-negative floats order the same as their bit patterns */
+static inline uint32_t key_bits(float key) {
+    uint32_t bits;
+    if (!(key > 0.0f)) return 0; /* also folds -0.0 */
+    memcpy(&bits, &key, sizeof(bits));
+    return bits;
+}
+
+static inline uint32_t radix_bucket(uint32_t bits, uint32_t last_bits) {
+    uint32_t diff = bits ^ last_bits;
+    return diff ? 32u - (uint32_t)sylves_clz32(diff) : 0u;
+}
+
+SylvesRadixHeap* sylves_radix_heap_create(void) {
+    return (SylvesRadixHeap*)sylves_calloc(1, sizeof(SylvesRadixHeap));
+}
+
+void sylves_radix_heap_destroy(SylvesRadixHeap* heap) {
+    if (!heap) return;
+    for (int b = 0; b < SYLVES_RADIX_BUCKETS; b++) {
+        sylves_free(heap->buckets[b]);
+    }
+    sylves_free(heap->positions);
+    sylves_free(heap);
+}
+
+static inline bool radix_heap_find(const SylvesRadixHeap* heap, uint32_t handle, SylvesRadixPosition* position) {
+    if ((size_t)handle >= heap->position_capacity) return false;
+    SylvesRadixPosition p = heap->positions[handle];
+    if (p.bucket >= SYLVES_RADIX_BUCKETS || p.slot >= heap->bucket_size[p.bucket] ||
+        heap->buckets[p.bucket][p.slot].handle != handle) {
+        return false;
+    }
+    *position = p;
+    return true;
+}
+
+static bool radix_heap_append(SylvesRadixHeap* heap, uint32_t bucket, SylvesQueueEntry entry) {
+    if (heap->bucket_size[bucket] == heap->bucket_capacity[bucket]) {
+        uint32_t capacity = heap->bucket_capacity[bucket] ? heap->bucket_capacity[bucket] * 2 : 16;
+        SylvesQueueEntry* entries = (SylvesQueueEntry*)sylves_realloc(heap->buckets[bucket], sizeof(SylvesQueueEntry) * capacity);
+        if (!entries) return false;
+        heap->buckets[bucket] = entries;
+        heap->bucket_capacity[bucket] = capacity;
+    }
+    uint32_t slot = heap->bucket_size[bucket]++;
+    heap->buckets[bucket][slot] = entry;
+    heap->positions[entry.handle].bucket = bucket;
+    heap->positions[entry.handle].slot = slot;
+    return true;
+}
+
+/* Swap-remove; the entry moved into the hole has its position updated */
+static void radix_heap_remove(SylvesRadixHeap* heap, SylvesRadixPosition p) {
+    uint32_t last = --heap->bucket_size[p.bucket];
+    if (p.slot != last) {
+        SylvesQueueEntry moved = heap->buckets[p.bucket][last];
+        heap->buckets[p.bucket][p.slot] = moved;
+        heap->positions[moved.handle].slot = p.slot;
+    }
+}
+
+bool sylves_radix_heap_push(SylvesRadixHeap* heap, uint32_t handle, float key) {
+    if (!heap) return false;
+    if (key < heap->last_key) key = heap->last_key;
+
+    SylvesRadixPosition p;
+    if (radix_heap_find(heap, handle, &p)) {
+        if (!(key < heap->buckets[p.bucket][p.slot].key)) return true;
+        radix_heap_remove(heap, p);
+        heap->size--;
+    } else if (!reserve_positions((void**)&heap->positions, &heap->position_capacity,
+                                  sizeof(SylvesRadixPosition), handle)) {
+        return false;
+    }
+
+    SylvesQueueEntry entry = { key, handle };
+    if (!radix_heap_append(heap, radix_bucket(key_bits(key), key_bits(heap->last_key)), entry)) {
+        return false;
+    }
+    heap->size++;
+    return true;
+}
+
+/*
+ * Make bucket 0 hold the minimum: take the lowest non-empty bucket, adopt
+ * its smallest key as the new last key and redistribute it. Every entry
+ * lands in a strictly lower bucket.
+ */
+static bool radix_heap_refill(SylvesRadixHeap* heap) {
+    if (heap->size == 0) return false;
+    if (heap->bucket_size[0] > 0) return true;
+
+    uint32_t b = 1;
+    while (heap->bucket_size[b] == 0) b++;
+
+    SylvesQueueEntry* entries = heap->buckets[b];
+    uint32_t count = heap->bucket_size[b];
+    float min_key = entries[0].key;
+    for (uint32_t i = 1; i < count; i++) {
+        if (entries[i].key < min_key) min_key = entries[i].key;
+    }
+    heap->last_key = min_key;
+    uint32_t last_bits = key_bits(min_key);
+
+    /* Target buckets are below b, so appending cannot touch this array */
+    heap->bucket_size[b] = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (!radix_heap_append(heap, radix_bucket(key_bits(entries[i].key), last_bits), entries[i])) {
+            /* Keep what was not moved rather than losing it */
+            memmove(entries, entries + i, sizeof(SylvesQueueEntry) * (count - i));
+            heap->bucket_size[b] = count - i;
+            for (uint32_t j = 0; j < count - i; j++) {
+                heap->positions[entries[j].handle].bucket = b;
+                heap->positions[entries[j].handle].slot = j;
+            }
+            return heap->bucket_size[0] > 0;
+        }
+    }
+    return true;
+}
+
+bool sylves_radix_heap_pop(SylvesRadixHeap* heap, uint32_t* handle, float* key) {
+    if (!heap || !radix_heap_refill(heap)) return false;
+
+    SylvesQueueEntry entry = heap->buckets[0][--heap->bucket_size[0]];
+    heap->positions[entry.handle].bucket = UINT32_MAX;
+    heap->size--;
+    if (handle) *handle = entry.handle;
+    if (key) *key = entry.key;
+    return true;
+}
+
+bool sylves_radix_heap_peek_key(SylvesRadixHeap* heap, float* key) {
+    if (!heap || !radix_heap_refill(heap)) return false;
+    if (key) *key = heap->last_key;
+    return true;
+}
+
+bool sylves_radix_heap_contains(const SylvesRadixHeap* heap, uint32_t handle) {
+    SylvesRadixPosition p;
+    return heap && radix_heap_find(heap, handle, &p);
+}
+
+bool sylves_radix_heap_is_empty(const SylvesRadixHeap* heap) {
+    return !heap || heap->size == 0;
+}
+
+void sylves_radix_heap_clear(SylvesRadixHeap* heap) {
+    if (!heap) return;
+    memset(heap->bucket_size, 0, sizeof(heap->bucket_size));
+    heap->size = 0;
+    heap->last_key = 0.0f;
+}
@@ -45,18 +45,14 @@ static size_t cell_hash(SylvesCell cell) {
     return hash;
 }
 
-/* Union-Find operations */
-static UnionFind* union_find_create(size_t size) {
-    UnionFind* uf = (UnionFind*)sylves_alloc(sizeof(UnionFind));
+/* Union-Find operations; the structure lives in the caller's scratch arena */
+static UnionFind* union_find_create(SylvesArena* arena, size_t size) {
+    UnionFind* uf = (UnionFind*)sylves_arena_alloc(arena, sizeof(UnionFind));
     if (!uf) return NULL;
     
-    uf->parent = (size_t*)sylves_alloc(sizeof(size_t) * size);
-    uf->rank = (size_t*)sylves_calloc(size, sizeof(size_t));
-    
+    uf->parent = (size_t*)sylves_arena_alloc(arena, sizeof(size_t) * size);
+    uf->rank = (size_t*)sylves_arena_calloc(arena, size, sizeof(size_t));
     if (!uf->parent || !uf->rank) {
-        sylves_free(uf->parent);
-        sylves_free(uf->rank);
-        sylves_free(uf);
         return NULL;
     }
     
@@ -70,14 +66,6 @@ static UnionFind* union_find_create(size_t size) {
     return uf;
 }
 
-static void union_find_destroy(UnionFind* uf) {
-    if (!uf) return;
-    
-    sylves_free(uf->parent);
-    sylves_free(uf->rank);
-    sylves_free(uf);
-}
-
 static size_t union_find_find(UnionFind* uf, size_t x) {
     if (uf->parent[x] != x) {
         // Path compression
@@ -107,14 +95,13 @@ static bool union_find_union(UnionFind* uf, size_t x, size_t y) {
     return true;
 }
 
-/* Cell index table operations */
-static CellIndexTable* cell_index_table_create(size_t initial_size) {
-    CellIndexTable* table = (CellIndexTable*)sylves_alloc(sizeof(CellIndexTable));
+/* Cell index table operations; buckets and entries live in the scratch arena */
+static CellIndexTable* cell_index_table_create(SylvesArena* arena, size_t initial_size) {
+    CellIndexTable* table = (CellIndexTable*)sylves_arena_alloc(arena, sizeof(CellIndexTable));
     if (!table) return NULL;
     
-    table->buckets = (CellIndexEntry**)sylves_calloc(initial_size, sizeof(CellIndexEntry*));
+    table->buckets = (CellIndexEntry**)sylves_arena_calloc(arena, initial_size, sizeof(CellIndexEntry*));
     if (!table->buckets) {
-        sylves_free(table);
         return NULL;
     }
     
@@ -124,26 +111,10 @@ static CellIndexTable* cell_index_table_create(size_t initial_size) {
     return table;
 }
 
-static void cell_index_table_destroy(CellIndexTable* table) {
-    if (!table) return;
-    
-    for (size_t i = 0; i < table->bucket_count; i++) {
-        CellIndexEntry* entry = table->buckets[i];
-        while (entry) {
-            CellIndexEntry* next = entry->next;
-            sylves_free(entry);
-            entry = next;
-        }
-    }
-    
-    sylves_free(table->buckets);
-    sylves_free(table);
-}
-
-static bool cell_index_table_insert(CellIndexTable* table, SylvesCell cell, size_t index) {
+static bool cell_index_table_insert(SylvesArena* arena, CellIndexTable* table, SylvesCell cell, size_t index) {
     size_t hash_index = cell_hash(cell) % table->bucket_count;
     
-    CellIndexEntry* entry = (CellIndexEntry*)sylves_alloc(sizeof(CellIndexEntry));
+    CellIndexEntry* entry = (CellIndexEntry*)sylves_arena_alloc(arena, sizeof(CellIndexEntry));
     if (!entry) return false;
     
     entry->cell = cell;
@@ -180,8 +151,9 @@ static int edge_compare(const void* a, const void* b) {
     return 0;
 }
 
-/* Kruskal's minimum spanning tree algorithm */
-SylvesError sylves_kruskal_mst(
+/* Kruskal's algorithm over arena-backed temporaries */
+static SylvesError kruskal_mst_in_arena(
+    SylvesArena* arena,
     SylvesGrid* grid,
     const SylvesCell* cells,
     size_t cell_count,
@@ -190,29 +162,23 @@ SylvesError sylves_kruskal_mst(
     SylvesEdge** edges,
     size_t* edge_count) {
     
-    if (!grid || !cells || cell_count == 0 || !edges || !edge_count) {
-        return SYLVES_ERROR_INVALID_ARGUMENT;
-    }
-    
     // Create cell to index mapping
-    CellIndexTable* cell_indices = cell_index_table_create(cell_count * 2);
+    CellIndexTable* cell_indices = cell_index_table_create(arena, cell_count * 2);
     if (!cell_indices) {
         return SYLVES_ERROR_OUT_OF_MEMORY;
     }
     
     // Map cells to indices
     for (size_t i = 0; i < cell_count; i++) {
-        if (!cell_index_table_insert(cell_indices, cells[i], i)) {
-            cell_index_table_destroy(cell_indices);
+        if (!cell_index_table_insert(arena, cell_indices, cells[i], i)) {
             return SYLVES_ERROR_OUT_OF_MEMORY;
         }
     }
     
     // Collect all edges
     size_t max_edges = cell_count * 6; // Overestimate
-    IndexedEdge* all_edges = (IndexedEdge*)sylves_alloc(sizeof(IndexedEdge) * max_edges);
+    IndexedEdge* all_edges = (IndexedEdge*)sylves_arena_alloc(arena, sizeof(IndexedEdge) * max_edges);
     if (!all_edges) {
-        cell_index_table_destroy(cell_indices);
         return SYLVES_ERROR_OUT_OF_MEMORY;
     }
     
@@ -258,19 +224,14 @@ SylvesError sylves_kruskal_mst(
     qsort(all_edges, total_edges, sizeof(IndexedEdge), edge_compare);
     
     // Create union-find structure
-    UnionFind* uf = union_find_create(cell_count);
+    UnionFind* uf = union_find_create(arena, cell_count);
     if (!uf) {
-        sylves_free(all_edges);
-        cell_index_table_destroy(cell_indices);
         return SYLVES_ERROR_OUT_OF_MEMORY;
     }
     
     // Kruskal's algorithm: select edges that don't create cycles
     SylvesEdge* mst_edges = (SylvesEdge*)sylves_alloc(sizeof(SylvesEdge) * (cell_count - 1));
     if (!mst_edges) {
-        union_find_destroy(uf);
-        sylves_free(all_edges);
-        cell_index_table_destroy(cell_indices);
         return SYLVES_ERROR_OUT_OF_MEMORY;
     }
     
@@ -285,14 +246,50 @@ SylvesError sylves_kruskal_mst(
         }
     }
     
-    // Clean up
-    union_find_destroy(uf);
-    sylves_free(all_edges);
-    cell_index_table_destroy(cell_indices);
-    
     // Return results
     *edges = mst_edges;
     *edge_count = mst_edge_count;
     
     return SYLVES_SUCCESS;
 }
+
+SylvesError sylves_kruskal_mst_with_arena(
+    SylvesGrid* grid,
+    const SylvesCell* cells,
+    size_t cell_count,
+    SylvesStepLengthFunc step_lengths,
+    void* user_data,
+    SylvesArena* scratch,
+    SylvesEdge** edges,
+    size_t* edge_count) {
+    
+    if (!grid || !cells || cell_count == 0 || !edges || !edge_count) {
+        return SYLVES_ERROR_INVALID_ARGUMENT;
+    }
+    
+    SylvesArena* arena = scratch ? scratch : sylves_get_thread_scratch_arena();
+    if (!arena) {
+        return SYLVES_ERROR_OUT_OF_MEMORY;
+    }
+    
+    // Every temporary structure is released by the one pop
+    SylvesArenaMark mark = sylves_arena_push(arena);
+    SylvesError err = kruskal_mst_in_arena(arena, grid, cells, cell_count, step_lengths, user_data,
+                                           edges, edge_count);
+    sylves_arena_pop(arena, mark);
+    return err;
+}
+
+/* Kruskal's minimum spanning tree algorithm */
+SylvesError sylves_kruskal_mst(
+    SylvesGrid* grid,
+    const SylvesCell* cells,
+    size_t cell_count,
+    SylvesStepLengthFunc step_lengths,
+    void* user_data,
+    SylvesEdge** edges,
+    size_t* edge_count) {
+    
+    return sylves_kruskal_mst_with_arena(grid, cells, cell_count, step_lengths, user_data,
+                                         NULL, edges, edge_count);
+}
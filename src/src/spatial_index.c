@@ -2,16 +2,12 @@
 #include "sylves/memory.h"
 #include "sylves/grid.h"
 #include "sylves/hash.h"
+#include "internal/spatial_tree.h"
+#include "internal/sync.h"
 #include <string.h>
 #include <math.h>
 #include <float.h>
 
-#ifdef _WIN32
-#include <windows.h>
-#else
-#include <pthread.h>
-#endif
-
 /**
  * Hash entry for storing cells
  */
@@ -50,15 +46,11 @@ struct SylvesSpatialIndex {
     int dimension;
     union {
         GridHashIndex* grid_hash;
-        /* Other index types would go here */
+        SylvesSpatialTree* tree;   /* R-tree, k-d tree, quadtree and octree */
     } data;
     SylvesSpatialIndexStats stats;
     bool thread_safe;
-#ifdef _WIN32
-    CRITICAL_SECTION lock;
-#else
-    pthread_mutex_t lock;
-#endif
+    SylvesRwLock lock;         /* queries share it, mutations take it exclusively */
 };
 
 /**
@@ -74,41 +66,38 @@ struct SylvesGridSpatialHash {
 
 static void init_lock(SylvesSpatialIndex* index) {
     if (index->thread_safe) {
-#ifdef _WIN32
-        InitializeCriticalSection(&index->lock);
-#else
-        pthread_mutex_init(&index->lock, NULL);
-#endif
+        sylves_rwlock_init(&index->lock);
     }
 }
 
 static void destroy_lock(SylvesSpatialIndex* index) {
     if (index->thread_safe) {
-#ifdef _WIN32
-        DeleteCriticalSection(&index->lock);
-#else
-        pthread_mutex_destroy(&index->lock);
-#endif
+        sylves_rwlock_destroy(&index->lock);
     }
 }
 
 static void lock_index(SylvesSpatialIndex* index) {
     if (index->thread_safe) {
-#ifdef _WIN32
-        EnterCriticalSection(&index->lock);
-#else
-        pthread_mutex_lock(&index->lock);
-#endif
+        sylves_rwlock_write(&index->lock);
     }
 }
 
 static void unlock_index(SylvesSpatialIndex* index) {
     if (index->thread_safe) {
-#ifdef _WIN32
-        LeaveCriticalSection(&index->lock);
-#else
-        pthread_mutex_unlock(&index->lock);
-#endif
+        sylves_rwlock_write_unlock(&index->lock);
+    }
+}
+
+/* Queries only read the index, so any number of them may run together */
+static void lock_index_shared(const SylvesSpatialIndex* index) {
+    if (index->thread_safe) {
+        sylves_rwlock_read(&((SylvesSpatialIndex*)index)->lock);
+    }
+}
+
+static void unlock_index_shared(const SylvesSpatialIndex* index) {
+    if (index->thread_safe) {
+        sylves_rwlock_read_unlock(&((SylvesSpatialIndex*)index)->lock);
     }
 }
 
@@ -230,8 +219,21 @@ static SylvesError grid_hash_remove(GridHashIndex* hash, const SylvesCell* cell)
     return SYLVES_ERROR_NOT_FOUND;
 }
 
-static void grid_hash_query_aabb(const GridHashIndex* hash, SylvesAabb aabb,
-                                SylvesCellDataVisitor visitor, void* user_data) {
+/* Whether an entry hashes from the given grid cell (buckets are shared between cells) */
+static inline bool entry_in_hash_cell(const HashEntry* entry, double inv_cell_size,
+                                      int32_t x, int32_t y, int32_t z) {
+    return hash_coord(entry->center.x, inv_cell_size) == x &&
+           hash_coord(entry->center.y, inv_cell_size) == y &&
+           hash_coord(entry->center.z, inv_cell_size) == z;
+}
+
+/*
+ * Visit entries in the hash cells overlapping [min, max]. With radius_sq >= 0
+ * entries are filtered by distance to center, otherwise by containment.
+ */
+static void grid_hash_query(const GridHashIndex* hash, SylvesAabb aabb,
+                            const SylvesVector3* center, double radius_sq,
+                            SylvesCellDataVisitor visitor, void* user_data) {
     /* Calculate hash bounds */
     int32_t min_x = hash_coord(aabb.min.x, hash->inv_cell_size);
     int32_t min_y = hash_coord(aabb.min.y, hash->inv_cell_size);
@@ -254,8 +256,18 @@ static void grid_hash_query_aabb(const GridHashIndex* hash, SylvesAabb aabb,
                 HashEntry* entry = hash->buckets[bucket_idx].entries;
                 
                 while (entry) {
-                    /* Check if cell center is actually in AABB */
-                    if (sylves_aabb_contains_point(aabb, entry->center)) {
+                    bool hit;
+                    if (radius_sq >= 0) {
+                        double dx = entry->center.x - center->x;
+                        double dy = entry->center.y - center->y;
+                        double dz = entry->center.z - center->z;
+                        hit = dx * dx + dy * dy + dz * dz <= radius_sq;
+                    } else {
+                        /* Check if cell center is actually in AABB */
+                        hit = sylves_aabb_contains_point(aabb, entry->center);
+                    }
+                    /* Report each entry only from its own hash cell */
+                    if (hit && entry_in_hash_cell(entry, hash->inv_cell_size, x, y, z)) {
                         if (!visitor(&entry->cell, entry->data, user_data)) {
                             return;
                         }
@@ -267,6 +279,79 @@ static void grid_hash_query_aabb(const GridHashIndex* hash, SylvesAabb aabb,
     }
 }
 
+/* Rings searched around the query before falling back to a full scan */
+#define GRID_HASH_NEAREST_MAX_RINGS 16
+
+static void grid_hash_nearest_in_bucket(const HashBucket* bucket, const SylvesVector3* point,
+                                        const HashEntry** best, double* best_dist_sq) {
+    for (const HashEntry* entry = bucket->entries; entry; entry = entry->next) {
+        double dx = entry->center.x - point->x;
+        double dy = entry->center.y - point->y;
+        double dz = entry->center.z - point->z;
+        double d = dx * dx + dy * dy + dz * dz;
+        if (d < *best_dist_sq) {
+            *best_dist_sq = d;
+            *best = entry;
+        }
+    }
+}
+
+/*
+ * Search hash cells in growing Chebyshev rings around the query. Anything
+ * outside ring r is at least r * cell_size away, which bounds the search.
+ * 2D indexes only walk rings in the query's z layer.
+ */
+static bool grid_hash_find_nearest(const GridHashIndex* hash, const SylvesVector3* point, int dimension,
+                                   SylvesCell* out_cell, double* out_distance) {
+    if (hash->item_count == 0) {
+        return false;
+    }
+    
+    int32_t cx = hash_coord(point->x, hash->inv_cell_size);
+    int32_t cy = hash_coord(point->y, hash->inv_cell_size);
+    int32_t cz = hash_coord(point->z, hash->inv_cell_size);
+    int32_t rz_limit = dimension == 3 ? 1 : 0;
+    const HashEntry* best = NULL;
+    double best_dist_sq = INFINITY;
+    
+    for (int32_t r = 0; ; r++) {
+        if (r > GRID_HASH_NEAREST_MAX_RINGS) {
+            for (size_t i = 0; i < hash->bucket_count; i++) {
+                grid_hash_nearest_in_bucket(&hash->buckets[i], point, &best, &best_dist_sq);
+            }
+            break;
+        }
+        
+        int32_t rz = r * rz_limit;
+        for (int32_t dz = -rz; dz <= rz; dz++) {
+            for (int32_t dy = -r; dy <= r; dy++) {
+                for (int32_t dx = -r; dx <= r; dx++) {
+                    int32_t ring = abs(dx) > abs(dy) ? abs(dx) : abs(dy);
+                    if (abs(dz) > ring) ring = abs(dz);
+                    if (ring != r) continue;
+                    
+                    SylvesVector3 pos = {
+                        (cx + dx) * hash->cell_size,
+                        (cy + dy) * hash->cell_size,
+                        (cz + dz) * hash->cell_size
+                    };
+                    size_t bucket_idx = hash_position(&pos, hash->inv_cell_size, hash->bucket_count);
+                    grid_hash_nearest_in_bucket(&hash->buckets[bucket_idx], point, &best, &best_dist_sq);
+                }
+            }
+        }
+        
+        double reach = r * hash->cell_size;
+        if (best && best_dist_sq <= reach * reach) {
+            break;
+        }
+    }
+    
+    if (out_cell) *out_cell = best->cell;
+    if (out_distance) *out_distance = sqrt(best_dist_sq);
+    return true;
+}
+
 /* Public API implementation */
 
 SylvesSpatialIndex* sylves_spatial_index_create(const SylvesSpatialIndexConfig* config, int dimension) {
@@ -301,8 +386,21 @@ SylvesSpatialIndex* sylves_spatial_index_create(const SylvesSpatialIndexConfig*
             break;
         }
         
+        case SYLVES_SPATIAL_INDEX_QUADTREE:
+        case SYLVES_SPATIAL_INDEX_OCTREE:
+        case SYLVES_SPATIAL_INDEX_RTREE:
+        case SYLVES_SPATIAL_INDEX_KDTREE:
+            index->data.tree = sylves_spatial_tree_create(config->type, dimension,
+                                                          config->max_items_per_node,
+                                                          config->max_depth);
+            if (!index->data.tree) {
+                destroy_lock(index);
+                sylves_free(index);
+                return NULL;
+            }
+            break;
+        
         default:
-            /* Other index types not implemented yet */
             destroy_lock(index);
             sylves_free(index);
             return NULL;
@@ -321,6 +419,7 @@ void sylves_spatial_index_destroy(SylvesSpatialIndex* index) {
             grid_hash_destroy(index->data.grid_hash);
             break;
         default:
+            sylves_spatial_tree_destroy(index->data.tree);
             break;
     }
     
@@ -343,6 +442,7 @@ SylvesError sylves_spatial_index_insert(SylvesSpatialIndex* index, const SylvesC
             result = grid_hash_insert(index->data.grid_hash, cell, center, data);
             break;
         default:
+            result = sylves_spatial_tree_insert(index->data.tree, cell, center, data);
             break;
     }
     
@@ -368,6 +468,7 @@ SylvesError sylves_spatial_index_remove(SylvesSpatialIndex* index, const SylvesC
             result = grid_hash_remove(index->data.grid_hash, cell);
             break;
         default:
+            result = sylves_spatial_tree_remove(index->data.tree, cell);
             break;
     }
     
@@ -385,13 +486,19 @@ SylvesError sylves_spatial_index_query_aabb(const SylvesSpatialIndex* index, con
         return SYLVES_ERROR_INVALID_ARGUMENT;
     }
     
+    lock_index_shared(index);
+    
     switch (index->type) {
         case SYLVES_SPATIAL_INDEX_GRID_HASH:
-            grid_hash_query_aabb(index->data.grid_hash, *aabb, visitor, user_data);
-            return SYLVES_SUCCESS;
+            grid_hash_query(index->data.grid_hash, *aabb, NULL, -1.0, visitor, user_data);
+            break;
         default:
-            return SYLVES_ERROR_NOT_IMPLEMENTED;
+            sylves_spatial_tree_query_aabb(index->data.tree, aabb, visitor, user_data);
+            break;
     }
+    
+    unlock_index_shared(index);
+    return SYLVES_SUCCESS;
 }
 
 SylvesError sylves_spatial_index_query_radius(const SylvesSpatialIndex* index, const SylvesVector3* center,
@@ -400,28 +507,43 @@ SylvesError sylves_spatial_index_query_radius(const SylvesSpatialIndex* index, c
         return SYLVES_ERROR_INVALID_ARGUMENT;
     }
     
-    /* Convert radius query to AABB query */
-    SylvesAabb aabb = {
-        .min = { center->x - radius, center->y - radius, center->z - radius },
-        .max = { center->x + radius, center->y + radius, center->z + radius }
-    };
+    lock_index_shared(index);
     
-    /* Wrapper to filter by actual radius */
-    struct RadiusFilter {
-        SylvesVector3 center;
-        double radius_sq;
-        SylvesCellDataVisitor visitor;
-        void* user_data;
-    } filter = {
-        *center,
-        radius * radius,
-        visitor,
-        user_data
-    };
+    if (index->type != SYLVES_SPATIAL_INDEX_GRID_HASH) {
+        sylves_spatial_tree_query_radius(index->data.tree, center, radius, visitor, user_data);
+    } else {
+        SylvesAabb aabb = {
+            .min = { center->x - radius, center->y - radius, center->z - radius },
+            .max = { center->x + radius, center->y + radius, center->z + radius }
+        };
+        grid_hash_query(index->data.grid_hash, aabb, center, radius * radius, visitor, user_data);
+    }
     
-    /* TODO: Implement radius filtering wrapper */
-    /* For now, just use AABB query without radius filtering */
-    return sylves_spatial_index_query_aabb(index, &aabb, visitor, user_data);
+    unlock_index_shared(index);
+    return SYLVES_SUCCESS;
+}
+
+SylvesError sylves_spatial_index_find_nearest(const SylvesSpatialIndex* index, const SylvesVector3* point,
+                                             SylvesCell* out_cell, double* out_distance) {
+    if (!index || !point) {
+        return SYLVES_ERROR_INVALID_ARGUMENT;
+    }
+    
+    lock_index_shared(index);
+    
+    bool found;
+    switch (index->type) {
+        case SYLVES_SPATIAL_INDEX_GRID_HASH:
+            found = grid_hash_find_nearest(index->data.grid_hash, point, index->dimension,
+                                           out_cell, out_distance);
+            break;
+        default:
+            found = sylves_spatial_tree_find_nearest(index->data.tree, point, out_cell, out_distance);
+            break;
+    }
+    
+    unlock_index_shared(index);
+    return found ? SYLVES_SUCCESS : SYLVES_ERROR_NOT_FOUND;
 }
 
 void sylves_spatial_index_clear(SylvesSpatialIndex* index) {
@@ -452,6 +574,7 @@ void sylves_spatial_index_clear(SylvesSpatialIndex* index) {
             break;
         }
         default:
+            sylves_spatial_tree_clear(index->data.tree);
             break;
     }
     
@@ -465,6 +588,8 @@ void sylves_spatial_index_get_stats(const SylvesSpatialIndex* index, SylvesSpati
         return;
     }
     
+    lock_index_shared(index);
+    
     *stats = index->stats;
     
     switch (index->type) {
@@ -493,8 +618,57 @@ void sylves_spatial_index_get_stats(const SylvesSpatialIndex* index, SylvesSpati
             break;
         }
         default:
+            sylves_spatial_tree_get_stats(index->data.tree, stats);
             break;
     }
+    
+    unlock_index_shared(index);
+}
+
+SylvesError sylves_spatial_index_optimize(SylvesSpatialIndex* index) {
+    if (!index) {
+        return SYLVES_ERROR_INVALID_ARGUMENT;
+    }
+    
+    lock_index(index);
+    
+    SylvesError result = SYLVES_SUCCESS;
+    switch (index->type) {
+        case SYLVES_SPATIAL_INDEX_GRID_HASH:
+            /* Buckets are fixed; nothing to rebuild */
+            break;
+        default:
+            result = sylves_spatial_tree_rebuild(index->data.tree);
+            break;
+    }
+    
+    unlock_index(index);
+    return result;
+}
+
+SylvesError sylves_spatial_index_insert_batch(SylvesSpatialIndex* index, const SylvesCell* cells,
+                                             const SylvesVector3* centers, size_t count) {
+    if (!index || (count > 0 && (!cells || !centers))) {
+        return SYLVES_ERROR_INVALID_ARGUMENT;
+    }
+    
+    lock_index(index);
+    
+    SylvesError result = SYLVES_SUCCESS;
+    switch (index->type) {
+        case SYLVES_SPATIAL_INDEX_GRID_HASH:
+            for (size_t i = 0; i < count && result == SYLVES_SUCCESS; i++) {
+                result = grid_hash_insert(index->data.grid_hash, &cells[i], &centers[i], NULL);
+            }
+            break;
+        default:
+            /* Trees bulk load the whole batch with one rebuild */
+            result = sylves_spatial_tree_insert_batch(index->data.tree, cells, centers, count);
+            break;
+    }
+    
+    unlock_index(index);
+    return result;
 }
 
 /* Grid spatial hash implementation */
@@ -0,0 +1,914 @@
+/**
+ * @file spatial_tree.c
+ * @brief Tree backends (R-tree, k-d tree, quadtree/octree) for SylvesSpatialIndex
+ *
+ * - R-tree: Sort-Tile-Recursive bulk load, leaves hold up to
+ *   max_items_per_node entries and are packed bottom-up into parents of
+ *   the same fan-out.
+ * - k-d tree: implicit and balanced; the median entry of each range splits
+ *   it on the axis of widest spread, so no node array is needed.
+ * - Quadtree/octree: region subdivision of the bounding square/cube; only
+ *   non-empty children are stored, each with the tight bounds of its items.
+ */
+
+#include "internal/spatial_tree.h"
+#include "sylves/memory.h"
+#include "sylves/hash.h"
+#include <math.h>
+#include <float.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RTREE_DEFAULT_NODE_SIZE 16
+#define RTREE_MAX_NODE_SIZE 64
+#define KDTREE_DEFAULT_LEAF_SIZE 8
+#define REGION_TREE_DEFAULT_LEAF_SIZE 8
+#define REGION_TREE_DEFAULT_DEPTH 20
+#define REGION_TREE_MAX_DEPTH 32
+#define TREE_STACK_SIZE 1024
+#define TREE_MIN_REBUILD 64
+
+typedef struct {
+    SylvesCell cell;
+    SylvesVector3 center;
+    void* data;
+    bool alive;
+} TreeItem;
+
+typedef struct {
+    SylvesAabb bounds;
+    uint32_t first;  /* first child node, or first item for leaves */
+    uint32_t count;  /* number of children or items */
+    bool leaf;
+} TreeNode;
+
+struct SylvesSpatialTree {
+    SylvesSpatialIndexType type;
+    int dimension;
+    size_t leaf_size;
+    size_t max_depth;
+
+    TreeItem* items;      /* [0, built) in tree order, [built, item_count) pending */
+    size_t item_count;
+    size_t item_capacity;
+    size_t built;
+    size_t dead;          /* tree items removed since the last rebuild */
+    SylvesHash* slots;    /* cell -> item slot */
+
+    TreeNode* nodes;      /* R-tree and quadtree/octree */
+    size_t node_count;
+    size_t node_capacity;
+    size_t root;
+
+    uint8_t* kd_axis;     /* k-d tree split axis, indexed by median slot */
+    size_t kd_splits;
+
+    size_t depth;
+};
+
+/* Geometry helpers */
+
+static inline double axis_value(const SylvesVector3* v, int axis) {
+    return axis == 0 ? v->x : (axis == 1 ? v->y : v->z);
+}
+
+static inline double point_dist2(const SylvesVector3* a, const SylvesVector3* b) {
+    double dx = a->x - b->x, dy = a->y - b->y, dz = a->z - b->z;
+    return dx * dx + dy * dy + dz * dz;
+}
+
+static inline double box_dist2(const SylvesAabb* box, const SylvesVector3* p) {
+    double dx = p->x < box->min.x ? box->min.x - p->x : (p->x > box->max.x ? p->x - box->max.x : 0.0);
+    double dy = p->y < box->min.y ? box->min.y - p->y : (p->y > box->max.y ? p->y - box->max.y : 0.0);
+    double dz = p->z < box->min.z ? box->min.z - p->z : (p->z > box->max.z ? p->z - box->max.z : 0.0);
+    return dx * dx + dy * dy + dz * dz;
+}
+
+static inline bool box_overlaps(const SylvesAabb* a, const SylvesAabb* b) {
+    return a->min.x <= b->max.x && a->max.x >= b->min.x &&
+           a->min.y <= b->max.y && a->max.y >= b->min.y &&
+           a->min.z <= b->max.z && a->max.z >= b->min.z;
+}
+
+static inline bool box_contains(const SylvesAabb* box, const SylvesVector3* p) {
+    return p->x >= box->min.x && p->x <= box->max.x &&
+           p->y >= box->min.y && p->y <= box->max.y &&
+           p->z >= box->min.z && p->z <= box->max.z;
+}
+
+static void box_include(SylvesAabb* box, const SylvesAabb* other) {
+    if (other->min.x < box->min.x) box->min.x = other->min.x;
+    if (other->min.y < box->min.y) box->min.y = other->min.y;
+    if (other->min.z < box->min.z) box->min.z = other->min.z;
+    if (other->max.x > box->max.x) box->max.x = other->max.x;
+    if (other->max.y > box->max.y) box->max.y = other->max.y;
+    if (other->max.z > box->max.z) box->max.z = other->max.z;
+}
+
+static SylvesAabb item_bounds(const TreeItem* items, size_t lo, size_t hi) {
+    SylvesAabb box = { items[lo].center, items[lo].center };
+    for (size_t i = lo + 1; i < hi; i++) {
+        SylvesAabb p = { items[i].center, items[i].center };
+        box_include(&box, &p);
+    }
+    return box;
+}
+
+/* Creation and item store */
+
+SylvesSpatialTree* sylves_spatial_tree_create(SylvesSpatialIndexType type, int dimension,
+                                              size_t max_items_per_node, size_t max_depth) {
+    if (dimension != 2 && dimension != 3) {
+        return NULL;
+    }
+
+    size_t leaf_size;
+    switch (type) {
+        case SYLVES_SPATIAL_INDEX_RTREE:
+            leaf_size = max_items_per_node ? max_items_per_node : RTREE_DEFAULT_NODE_SIZE;
+            if (leaf_size < 2) leaf_size = 2;
+            if (leaf_size > RTREE_MAX_NODE_SIZE) leaf_size = RTREE_MAX_NODE_SIZE;
+            break;
+        case SYLVES_SPATIAL_INDEX_KDTREE:
+            leaf_size = max_items_per_node ? max_items_per_node : KDTREE_DEFAULT_LEAF_SIZE;
+            break;
+        case SYLVES_SPATIAL_INDEX_QUADTREE:
+        case SYLVES_SPATIAL_INDEX_OCTREE:
+            leaf_size = max_items_per_node ? max_items_per_node : REGION_TREE_DEFAULT_LEAF_SIZE;
+            break;
+        default:
+            return NULL;
+    }
+
+    SylvesSpatialTree* tree = (SylvesSpatialTree*)sylves_calloc(1, sizeof(SylvesSpatialTree));
+    if (!tree) {
+        return NULL;
+    }
+
+    tree->type = type;
+    /* A quadtree splits x/y only and an octree all three axes, whatever the index dimension */
+    if (type == SYLVES_SPATIAL_INDEX_QUADTREE) dimension = 2;
+    if (type == SYLVES_SPATIAL_INDEX_OCTREE) dimension = 3;
+    tree->dimension = dimension;
+    tree->leaf_size = leaf_size;
+    tree->max_depth = max_depth ? max_depth : REGION_TREE_DEFAULT_DEPTH;
+    if (tree->max_depth > REGION_TREE_MAX_DEPTH) tree->max_depth = REGION_TREE_MAX_DEPTH;
+
+    tree->slots = sylves_hash_create(64);
+    if (!tree->slots) {
+        sylves_free(tree);
+        return NULL;
+    }
+    return tree;
+}
+
+static void release_structure(SylvesSpatialTree* tree) {
+    sylves_free(tree->nodes);
+    sylves_free(tree->kd_axis);
+    tree->nodes = NULL;
+    tree->kd_axis = NULL;
+    tree->node_count = 0;
+    tree->node_capacity = 0;
+    tree->root = 0;
+    tree->kd_splits = 0;
+    tree->depth = 0;
+    tree->built = 0;
+}
+
+void sylves_spatial_tree_destroy(SylvesSpatialTree* tree) {
+    if (!tree) {
+        return;
+    }
+    release_structure(tree);
+    sylves_hash_destroy(tree->slots);
+    sylves_free(tree->items);
+    sylves_free(tree);
+}
+
+void sylves_spatial_tree_clear(SylvesSpatialTree* tree) {
+    if (!tree) {
+        return;
+    }
+    release_structure(tree);
+    sylves_hash_clear(tree->slots);
+    tree->item_count = 0;
+    tree->dead = 0;
+}
+
+size_t sylves_spatial_tree_count(const SylvesSpatialTree* tree) {
+    return tree ? tree->item_count - tree->dead : 0;
+}
+
+static bool reserve_items(SylvesSpatialTree* tree, size_t needed) {
+    if (needed <= tree->item_capacity) {
+        return true;
+    }
+    size_t capacity = tree->item_capacity ? tree->item_capacity * 2 : 64;
+    while (capacity < needed) capacity *= 2;
+    TreeItem* items = (TreeItem*)sylves_realloc(tree->items, capacity * sizeof(TreeItem));
+    if (!items) {
+        return false;
+    }
+    tree->items = items;
+    tree->item_capacity = capacity;
+    return true;
+}
+
+/* Append without triggering a rebuild; existing entries for the cell are replaced */
+static SylvesError append_item(SylvesSpatialTree* tree, const SylvesCell* cell,
+                               const SylvesVector3* center, void* data) {
+    int slot;
+    bool existed = sylves_hash_get_int(tree->slots, cell, &slot);
+    if (existed && (size_t)slot >= tree->built) {
+        tree->items[slot].center = *center;
+        tree->items[slot].data = data;
+        return SYLVES_SUCCESS;
+    }
+    if (tree->item_count >= INT32_MAX || !reserve_items(tree, tree->item_count + 1)) {
+        return SYLVES_ERROR_OUT_OF_MEMORY;
+    }
+    if (!sylves_hash_set_int(tree->slots, cell, (int)tree->item_count)) {
+        return SYLVES_ERROR_OUT_OF_MEMORY;
+    }
+
+    /* A moved tree entry is retired and re-added as pending */
+    if (existed) {
+        tree->items[slot].alive = false;
+        tree->dead++;
+    }
+    TreeItem* item = &tree->items[tree->item_count++];
+    item->cell = *cell;
+    item->center = *center;
+    item->data = data;
+    item->alive = true;
+    return SYLVES_SUCCESS;
+}
+
+static void maybe_rebuild(SylvesSpatialTree* tree) {
+    size_t pending = tree->item_count - tree->built;
+    size_t pending_limit = tree->built > TREE_MIN_REBUILD ? tree->built : TREE_MIN_REBUILD;
+    size_t dead_limit = tree->built / 2 > TREE_MIN_REBUILD ? tree->built / 2 : TREE_MIN_REBUILD;
+    if (pending > pending_limit || tree->dead > dead_limit) {
+        /* On failure the entries simply stay pending */
+        sylves_spatial_tree_rebuild(tree);
+    }
+}
+
+SylvesError sylves_spatial_tree_insert(SylvesSpatialTree* tree, const SylvesCell* cell,
+                                       const SylvesVector3* center, void* data) {
+    if (!tree || !cell || !center) {
+        return SYLVES_ERROR_INVALID_ARGUMENT;
+    }
+    SylvesError err = append_item(tree, cell, center, data);
+    if (err == SYLVES_SUCCESS) {
+        maybe_rebuild(tree);
+    }
+    return err;
+}
+
+SylvesError sylves_spatial_tree_insert_batch(SylvesSpatialTree* tree, const SylvesCell* cells,
+                                             const SylvesVector3* centers, size_t count) {
+    if (!tree || (count > 0 && (!cells || !centers))) {
+        return SYLVES_ERROR_INVALID_ARGUMENT;
+    }
+    if (!reserve_items(tree, tree->item_count + count)) {
+        return SYLVES_ERROR_OUT_OF_MEMORY;
+    }
+    for (size_t i = 0; i < count; i++) {
+        SylvesError err = append_item(tree, &cells[i], &centers[i], NULL);
+        if (err != SYLVES_SUCCESS) {
+            return err;
+        }
+    }
+    return count > 0 ? sylves_spatial_tree_rebuild(tree) : SYLVES_SUCCESS;
+}
+
+SylvesError sylves_spatial_tree_remove(SylvesSpatialTree* tree, const SylvesCell* cell) {
+    if (!tree || !cell) {
+        return SYLVES_ERROR_INVALID_ARGUMENT;
+    }
+    int slot;
+    if (!sylves_hash_get_int(tree->slots, cell, &slot)) {
+        return SYLVES_ERROR_NOT_FOUND;
+    }
+    sylves_hash_remove(tree->slots, cell);
+
+    if ((size_t)slot >= tree->built) {
+        size_t last = tree->item_count - 1;
+        if ((size_t)slot != last) {
+            tree->items[slot] = tree->items[last];
+            sylves_hash_set_int(tree->slots, &tree->items[slot].cell, slot);
+        }
+        tree->item_count--;
+        return SYLVES_SUCCESS;
+    }
+
+    tree->items[slot].alive = false;
+    tree->dead++;
+    maybe_rebuild(tree);
+    return SYLVES_SUCCESS;
+}
+
+/* R-tree: Sort-Tile-Recursive bulk load */
+
+typedef struct {
+    SylvesAabb box;
+    uint32_t ref;
+} StrEntry;
+
+static int str_compare_x(const void* a, const void* b) {
+    const StrEntry* ea = (const StrEntry*)a;
+    const StrEntry* eb = (const StrEntry*)b;
+    double ka = ea->box.min.x + ea->box.max.x, kb = eb->box.min.x + eb->box.max.x;
+    return (ka > kb) - (ka < kb);
+}
+
+static int str_compare_y(const void* a, const void* b) {
+    const StrEntry* ea = (const StrEntry*)a;
+    const StrEntry* eb = (const StrEntry*)b;
+    double ka = ea->box.min.y + ea->box.max.y, kb = eb->box.min.y + eb->box.max.y;
+    return (ka > kb) - (ka < kb);
+}
+
+static int str_compare_z(const void* a, const void* b) {
+    const StrEntry* ea = (const StrEntry*)a;
+    const StrEntry* eb = (const StrEntry*)b;
+    double ka = ea->box.min.z + ea->box.max.z, kb = eb->box.min.z + eb->box.max.z;
+    return (ka > kb) - (ka < kb);
+}
+
+static int (*const STR_COMPARE[3])(const void*, const void*) = {
+    str_compare_x, str_compare_y, str_compare_z
+};
+
+/* Sort by the first axis, cut into slabs and recurse so each run of node_size entries is a tile */
+static void str_sort(StrEntry* entries, size_t n, int axis, int dims, size_t node_size) {
+    qsort(entries, n, sizeof(StrEntry), STR_COMPARE[axis]);
+    if (axis == dims - 1 || n <= node_size) {
+        return;
+    }
+    size_t groups = (n + node_size - 1) / node_size;
+    size_t slabs = (size_t)ceil(pow((double)groups, 1.0 / (dims - axis)));
+    size_t slab_size = node_size * ((groups + slabs - 1) / slabs);
+    for (size_t s = 0; s < n; s += slab_size) {
+        size_t len = n - s < slab_size ? n - s : slab_size;
+        str_sort(entries + s, len, axis + 1, dims, node_size);
+    }
+}
+
+static SylvesError build_rtree(SylvesSpatialTree* tree) {
+    size_t n = tree->item_count;
+    size_t m = tree->leaf_size;
+
+    size_t node_total = 0;
+    for (size_t level = n; level > 1 || node_total == 0; ) {
+        level = (level + m - 1) / m;
+        node_total += level;
+    }
+
+    StrEntry* entries = (StrEntry*)sylves_alloc(n * sizeof(StrEntry));
+    TreeItem* scratch = (TreeItem*)sylves_alloc(n * sizeof(TreeItem));
+    tree->nodes = (TreeNode*)sylves_alloc(node_total * sizeof(TreeNode));
+    if (!entries || !scratch || !tree->nodes) {
+        sylves_free(entries);
+        sylves_free(scratch);
+        release_structure(tree);
+        return SYLVES_ERROR_OUT_OF_MEMORY;
+    }
+    tree->node_capacity = node_total;
+
+    for (size_t i = 0; i < n; i++) {
+        entries[i].box.min = entries[i].box.max = tree->items[i].center;
+        entries[i].ref = (uint32_t)i;
+    }
+    str_sort(entries, n, 0, tree->dimension, m);
+    for (size_t i = 0; i < n; i++) {
+        scratch[i] = tree->items[entries[i].ref];
+    }
+    memcpy(tree->items, scratch, n * sizeof(TreeItem));
+
+    for (size_t i = 0; i < n; i += m) {
+        size_t hi = i + m < n ? i + m : n;
+        TreeNode* leaf = &tree->nodes[tree->node_count++];
+        leaf->bounds = item_bounds(tree->items, i, hi);
+        leaf->first = (uint32_t)i;
+        leaf->count = (uint32_t)(hi - i);
+        leaf->leaf = true;
+    }
+    tree->depth = 1;
+
+    /* Pack each level into parents; children of a parent stay contiguous */
+    TreeNode* level_scratch = (TreeNode*)scratch;
+    size_t level_start = 0, level_end = tree->node_count;
+    while (level_end - level_start > 1) {
+        size_t k = level_end - level_start;
+        for (size_t j = 0; j < k; j++) {
+            entries[j].box = tree->nodes[level_start + j].bounds;
+            entries[j].ref = (uint32_t)(level_start + j);
+        }
+        str_sort(entries, k, 0, tree->dimension, m);
+        for (size_t j = 0; j < k; j++) {
+            level_scratch[j] = tree->nodes[entries[j].ref];
+        }
+        memcpy(&tree->nodes[level_start], level_scratch, k * sizeof(TreeNode));
+
+        for (size_t j = 0; j < k; j += m) {
+            size_t hi = j + m < k ? j + m : k;
+            TreeNode* parent = &tree->nodes[tree->node_count++];
+            parent->bounds = tree->nodes[level_start + j].bounds;
+            for (size_t c = j + 1; c < hi; c++) {
+                box_include(&parent->bounds, &tree->nodes[level_start + c].bounds);
+            }
+            parent->first = (uint32_t)(level_start + j);
+            parent->count = (uint32_t)(hi - j);
+            parent->leaf = false;
+        }
+        level_start = level_end;
+        level_end = tree->node_count;
+        tree->depth++;
+    }
+    tree->root = level_start;
+
+    sylves_free(entries);
+    sylves_free(scratch);
+    return SYLVES_SUCCESS;
+}
+
+/* k-d tree: implicit median splits */
+
+/* Reorder items[lo, hi) so the element at k is in sorted position along axis */
+static void select_nth(TreeItem* items, size_t lo, size_t hi, size_t k, int axis) {
+    ptrdiff_t left = (ptrdiff_t)lo, right = (ptrdiff_t)hi - 1, target = (ptrdiff_t)k;
+    while (left < right) {
+        double pivot = axis_value(&items[left + (right - left) / 2].center, axis);
+        ptrdiff_t i = left, j = right;
+        while (i <= j) {
+            while (axis_value(&items[i].center, axis) < pivot) i++;
+            while (axis_value(&items[j].center, axis) > pivot) j--;
+            if (i <= j) {
+                TreeItem tmp = items[i]; items[i] = items[j]; items[j] = tmp;
+                i++; j--;
+            }
+        }
+        if (target <= j) right = j;
+        else if (target >= i) left = i;
+        else return;
+    }
+}
+
+static void build_kd_range(SylvesSpatialTree* tree, size_t lo, size_t hi, size_t depth) {
+    if (depth > tree->depth) tree->depth = depth;
+    if (hi - lo <= tree->leaf_size) {
+        return;
+    }
+
+    SylvesAabb box = item_bounds(tree->items, lo, hi);
+    double ex = box.max.x - box.min.x, ey = box.max.y - box.min.y, ez = box.max.z - box.min.z;
+    int axis = (ex >= ey && (tree->dimension == 2 || ex >= ez)) ? 0 :
+               ((tree->dimension == 2 || ey >= ez) ? 1 : 2);
+
+    size_t mid = lo + (hi - lo) / 2;
+    select_nth(tree->items, lo, hi, mid, axis);
+    tree->kd_axis[mid] = (uint8_t)axis;
+    tree->kd_splits++;
+
+    build_kd_range(tree, lo, mid, depth + 1);
+    build_kd_range(tree, mid + 1, hi, depth + 1);
+}
+
+static SylvesError build_kdtree(SylvesSpatialTree* tree) {
+    size_t n = tree->item_count;
+    tree->kd_axis = (uint8_t*)sylves_alloc(n);
+    if (!tree->kd_axis) {
+        return SYLVES_ERROR_OUT_OF_MEMORY;
+    }
+    build_kd_range(tree, 0, n, 1);
+    return SYLVES_SUCCESS;
+}
+
+/* Quadtree/octree: region subdivision */
+
+static bool reserve_nodes(SylvesSpatialTree* tree, size_t extra) {
+    size_t needed = tree->node_count + extra;
+    if (needed <= tree->node_capacity) {
+        return true;
+    }
+    size_t capacity = tree->node_capacity ? tree->node_capacity * 2 : 64;
+    while (capacity < needed) capacity *= 2;
+    TreeNode* nodes = (TreeNode*)sylves_realloc(tree->nodes, capacity * sizeof(TreeNode));
+    if (!nodes) {
+        return false;
+    }
+    tree->nodes = nodes;
+    tree->node_capacity = capacity;
+    return true;
+}
+
+static bool build_region_node(SylvesSpatialTree* tree, TreeItem* scratch, size_t index,
+                              size_t lo, size_t hi, SylvesVector3 region_min, double half,
+                              size_t depth) {
+    if (depth > tree->depth) tree->depth = depth;
+    SylvesAabb bounds = item_bounds(tree->items, lo, hi);
+    tree->nodes[index].bounds = bounds;
+
+    bool collapsed = bounds.max.x == bounds.min.x && bounds.max.y == bounds.min.y &&
+                     (tree->dimension == 2 || bounds.max.z == bounds.min.z);
+    if (hi - lo <= tree->leaf_size || depth >= tree->max_depth || collapsed) {
+        tree->nodes[index].first = (uint32_t)lo;
+        tree->nodes[index].count = (uint32_t)(hi - lo);
+        tree->nodes[index].leaf = true;
+        return true;
+    }
+
+    int child_slots = tree->dimension == 3 ? 8 : 4;
+    SylvesVector3 mid = { region_min.x + half, region_min.y + half, region_min.z + half };
+    size_t counts[8] = {0};
+    for (size_t i = lo; i < hi; i++) {
+        const SylvesVector3* c = &tree->items[i].center;
+        int code = (c->x >= mid.x) | ((c->y >= mid.y) << 1) |
+                   ((tree->dimension == 3 && c->z >= mid.z) << 2);
+        counts[code]++;
+    }
+
+    size_t offsets[8];
+    size_t children = 0;
+    for (size_t k = 0, off = lo; k < (size_t)child_slots; k++) {
+        offsets[k] = off;
+        off += counts[k];
+        if (counts[k]) children++;
+    }
+    size_t cursor[8];
+    memcpy(cursor, offsets, sizeof(cursor));
+    for (size_t i = lo; i < hi; i++) {
+        const SylvesVector3* c = &tree->items[i].center;
+        int code = (c->x >= mid.x) | ((c->y >= mid.y) << 1) |
+                   ((tree->dimension == 3 && c->z >= mid.z) << 2);
+        scratch[cursor[code]++] = tree->items[i];
+    }
+    memcpy(&tree->items[lo], &scratch[lo], (hi - lo) * sizeof(TreeItem));
+
+    if (!reserve_nodes(tree, children)) {
+        return false;
+    }
+    size_t first = tree->node_count;
+    tree->node_count += children;
+    tree->nodes[index].first = (uint32_t)first;
+    tree->nodes[index].count = (uint32_t)children;
+    tree->nodes[index].leaf = false;
+
+    size_t child = first;
+    for (int k = 0; k < child_slots; k++) {
+        if (!counts[k]) continue;
+        SylvesVector3 child_min = {
+            region_min.x + ((k & 1) ? half : 0.0),
+            region_min.y + ((k & 2) ? half : 0.0),
+            region_min.z + ((k & 4) ? half : 0.0)
+        };
+        if (!build_region_node(tree, scratch, child++, offsets[k], offsets[k] + counts[k],
+                               child_min, half * 0.5, depth + 1)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static SylvesError build_region_tree(SylvesSpatialTree* tree) {
+    size_t n = tree->item_count;
+    TreeItem* scratch = (TreeItem*)sylves_alloc(n * sizeof(TreeItem));
+    if (!scratch || !reserve_nodes(tree, 1)) {
+        sylves_free(scratch);
+        release_structure(tree);
+        return SYLVES_ERROR_OUT_OF_MEMORY;
+    }
+
+    SylvesAabb box = item_bounds(tree->items, 0, n);
+    double size = fmax(box.max.x - box.min.x, box.max.y - box.min.y);
+    if (tree->dimension == 3) size = fmax(size, box.max.z - box.min.z);
+    /* Pad so the far faces of the box fall strictly inside the root region */
+    size = size > 0.0 ? size * (1.0 + 1e-9) + DBL_MIN : 1.0;
+
+    tree->node_count = 1;
+    tree->root = 0;
+    bool ok = build_region_node(tree, scratch, 0, 0, n, box.min, size * 0.5, 1);
+    sylves_free(scratch);
+    if (!ok) {
+        release_structure(tree);
+        return SYLVES_ERROR_OUT_OF_MEMORY;
+    }
+    return SYLVES_SUCCESS;
+}
+
+SylvesError sylves_spatial_tree_rebuild(SylvesSpatialTree* tree) {
+    if (!tree) {
+        return SYLVES_ERROR_INVALID_ARGUMENT;
+    }
+
+    size_t live = tree->item_count - tree->dead;
+    SylvesHash* slots = sylves_hash_create(live * 2 + 64);
+    if (!slots) {
+        return SYLVES_ERROR_OUT_OF_MEMORY;
+    }
+
+    size_t j = 0;
+    for (size_t i = 0; i < tree->item_count; i++) {
+        if (tree->items[i].alive) {
+            tree->items[j++] = tree->items[i];
+        }
+    }
+    tree->item_count = j;
+    tree->dead = 0;
+    release_structure(tree);
+
+    SylvesError err = SYLVES_SUCCESS;
+    if (tree->item_count > 0) {
+        switch (tree->type) {
+            case SYLVES_SPATIAL_INDEX_RTREE:
+                err = build_rtree(tree);
+                break;
+            case SYLVES_SPATIAL_INDEX_KDTREE:
+                err = build_kdtree(tree);
+                break;
+            default:
+                err = build_region_tree(tree);
+                break;
+        }
+        if (err == SYLVES_SUCCESS) {
+            tree->built = tree->item_count;
+        }
+    }
+
+    /* Slots change even on failure, since compaction and partitioning moved items */
+    for (size_t i = 0; i < tree->item_count; i++) {
+        sylves_hash_set_int(slots, &tree->items[i].cell, (int)i);
+    }
+    sylves_hash_destroy(tree->slots);
+    tree->slots = slots;
+    return err;
+}
+
+/* Queries */
+
+static bool visit_item(const TreeItem* item, SylvesCellDataVisitor visitor, void* user_data) {
+    return visitor(&item->cell, item->data, user_data);
+}
+
+static bool scan_aabb(const TreeItem* items, size_t lo, size_t hi, const SylvesAabb* box,
+                      SylvesCellDataVisitor visitor, void* user_data) {
+    for (size_t i = lo; i < hi; i++) {
+        if (items[i].alive && box_contains(box, &items[i].center) &&
+            !visit_item(&items[i], visitor, user_data)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool scan_radius(const TreeItem* items, size_t lo, size_t hi, const SylvesVector3* p,
+                        double r2, SylvesCellDataVisitor visitor, void* user_data) {
+    for (size_t i = lo; i < hi; i++) {
+        if (items[i].alive && point_dist2(&items[i].center, p) <= r2 &&
+            !visit_item(&items[i], visitor, user_data)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+typedef struct {
+    const TreeItem* item;
+    double dist2;
+} NearestResult;
+
+static void scan_nearest(const TreeItem* items, size_t lo, size_t hi, const SylvesVector3* p,
+                         NearestResult* best) {
+    for (size_t i = lo; i < hi; i++) {
+        if (!items[i].alive) continue;
+        double d2 = point_dist2(&items[i].center, p);
+        if (d2 < best->dist2) {
+            best->dist2 = d2;
+            best->item = &items[i];
+        }
+    }
+}
+
+/* Node trees (R-tree, quadtree/octree) */
+
+static bool nodes_query_aabb(const SylvesSpatialTree* tree, const SylvesAabb* box,
+                             SylvesCellDataVisitor visitor, void* user_data) {
+    uint32_t stack[TREE_STACK_SIZE];
+    size_t top = 0;
+    stack[top++] = (uint32_t)tree->root;
+    while (top > 0) {
+        const TreeNode* node = &tree->nodes[stack[--top]];
+        if (!box_overlaps(&node->bounds, box)) continue;
+        if (node->leaf) {
+            if (!scan_aabb(tree->items, node->first, node->first + node->count, box, visitor, user_data)) {
+                return false;
+            }
+            continue;
+        }
+        for (uint32_t c = 0; c < node->count; c++) {
+            stack[top++] = node->first + c;
+        }
+    }
+    return true;
+}
+
+static bool nodes_query_radius(const SylvesSpatialTree* tree, const SylvesVector3* p, double r2,
+                               SylvesCellDataVisitor visitor, void* user_data) {
+    uint32_t stack[TREE_STACK_SIZE];
+    size_t top = 0;
+    stack[top++] = (uint32_t)tree->root;
+    while (top > 0) {
+        const TreeNode* node = &tree->nodes[stack[--top]];
+        if (box_dist2(&node->bounds, p) > r2) continue;
+        if (node->leaf) {
+            if (!scan_radius(tree->items, node->first, node->first + node->count, p, r2, visitor, user_data)) {
+                return false;
+            }
+            continue;
+        }
+        for (uint32_t c = 0; c < node->count; c++) {
+            stack[top++] = node->first + c;
+        }
+    }
+    return true;
+}
+
+/* Branch and bound; children are pushed farthest first so the nearest is explored first */
+static void nodes_find_nearest(const SylvesSpatialTree* tree, const SylvesVector3* p, NearestResult* best) {
+    uint32_t stack[TREE_STACK_SIZE];
+    size_t top = 0;
+    stack[top++] = (uint32_t)tree->root;
+    while (top > 0) {
+        const TreeNode* node = &tree->nodes[stack[--top]];
+        if (box_dist2(&node->bounds, p) >= best->dist2) continue;
+        if (node->leaf) {
+            scan_nearest(tree->items, node->first, node->first + node->count, p, best);
+            continue;
+        }
+
+        uint32_t order[RTREE_MAX_NODE_SIZE];
+        double dist[RTREE_MAX_NODE_SIZE];
+        size_t n = 0;
+        for (uint32_t c = 0; c < node->count; c++) {
+            double d2 = box_dist2(&tree->nodes[node->first + c].bounds, p);
+            if (d2 >= best->dist2) continue;
+            size_t k = n++;
+            while (k > 0 && dist[k - 1] < d2) {
+                dist[k] = dist[k - 1];
+                order[k] = order[k - 1];
+                k--;
+            }
+            dist[k] = d2;
+            order[k] = node->first + c;
+        }
+        for (size_t k = 0; k < n; k++) {
+            stack[top++] = order[k];
+        }
+    }
+}
+
+/* k-d tree */
+
+static bool kd_query_aabb(const SylvesSpatialTree* tree, size_t lo, size_t hi, const SylvesAabb* box,
+                          SylvesCellDataVisitor visitor, void* user_data) {
+    if (hi - lo <= tree->leaf_size) {
+        return scan_aabb(tree->items, lo, hi, box, visitor, user_data);
+    }
+    size_t mid = lo + (hi - lo) / 2;
+    int axis = tree->kd_axis[mid];
+    double split = axis_value(&tree->items[mid].center, axis);
+
+    if (axis_value(&box->min, axis) <= split &&
+        !kd_query_aabb(tree, lo, mid, box, visitor, user_data)) {
+        return false;
+    }
+    if (!scan_aabb(tree->items, mid, mid + 1, box, visitor, user_data)) {
+        return false;
+    }
+    if (axis_value(&box->max, axis) >= split) {
+        return kd_query_aabb(tree, mid + 1, hi, box, visitor, user_data);
+    }
+    return true;
+}
+
+static bool kd_query_radius(const SylvesSpatialTree* tree, size_t lo, size_t hi, const SylvesVector3* p,
+                            double r, double r2, SylvesCellDataVisitor visitor, void* user_data) {
+    if (hi - lo <= tree->leaf_size) {
+        return scan_radius(tree->items, lo, hi, p, r2, visitor, user_data);
+    }
+    size_t mid = lo + (hi - lo) / 2;
+    int axis = tree->kd_axis[mid];
+    double diff = axis_value(p, axis) - axis_value(&tree->items[mid].center, axis);
+
+    if (diff - r <= 0.0 && !kd_query_radius(tree, lo, mid, p, r, r2, visitor, user_data)) {
+        return false;
+    }
+    if (!scan_radius(tree->items, mid, mid + 1, p, r2, visitor, user_data)) {
+        return false;
+    }
+    if (diff + r >= 0.0) {
+        return kd_query_radius(tree, mid + 1, hi, p, r, r2, visitor, user_data);
+    }
+    return true;
+}
+
+static void kd_find_nearest(const SylvesSpatialTree* tree, size_t lo, size_t hi, const SylvesVector3* p,
+                            NearestResult* best) {
+    if (hi - lo <= tree->leaf_size) {
+        scan_nearest(tree->items, lo, hi, p, best);
+        return;
+    }
+    size_t mid = lo + (hi - lo) / 2;
+    int axis = tree->kd_axis[mid];
+    double diff = axis_value(p, axis) - axis_value(&tree->items[mid].center, axis);
+
+    if (diff <= 0.0) {
+        kd_find_nearest(tree, lo, mid, p, best);
+        scan_nearest(tree->items, mid, mid + 1, p, best);
+        if (diff * diff < best->dist2) kd_find_nearest(tree, mid + 1, hi, p, best);
+    } else {
+        kd_find_nearest(tree, mid + 1, hi, p, best);
+        scan_nearest(tree->items, mid, mid + 1, p, best);
+        if (diff * diff < best->dist2) kd_find_nearest(tree, lo, mid, p, best);
+    }
+}
+
+void sylves_spatial_tree_query_aabb(const SylvesSpatialTree* tree, const SylvesAabb* aabb,
+                                    SylvesCellDataVisitor visitor, void* user_data) {
+    if (!tree || !aabb || !visitor) {
+        return;
+    }
+    if (tree->built > 0) {
+        bool more = tree->type == SYLVES_SPATIAL_INDEX_KDTREE
+            ? kd_query_aabb(tree, 0, tree->built, aabb, visitor, user_data)
+            : nodes_query_aabb(tree, aabb, visitor, user_data);
+        if (!more) return;
+    }
+    scan_aabb(tree->items, tree->built, tree->item_count, aabb, visitor, user_data);
+}
+
+void sylves_spatial_tree_query_radius(const SylvesSpatialTree* tree, const SylvesVector3* center,
+                                      double radius, SylvesCellDataVisitor visitor, void* user_data) {
+    if (!tree || !center || !visitor || radius < 0.0) {
+        return;
+    }
+    double r2 = radius * radius;
+    if (tree->built > 0) {
+        bool more = tree->type == SYLVES_SPATIAL_INDEX_KDTREE
+            ? kd_query_radius(tree, 0, tree->built, center, radius, r2, visitor, user_data)
+            : nodes_query_radius(tree, center, r2, visitor, user_data);
+        if (!more) return;
+    }
+    scan_radius(tree->items, tree->built, tree->item_count, center, r2, visitor, user_data);
+}
+
+bool sylves_spatial_tree_find_nearest(const SylvesSpatialTree* tree, const SylvesVector3* point,
+                                      SylvesCell* out_cell, double* out_distance) {
+    if (!tree || !point) {
+        return false;
+    }
+    NearestResult best = { NULL, INFINITY };
+    /* Pending items first: a close pending hit tightens the bound for the tree walk */
+    scan_nearest(tree->items, tree->built, tree->item_count, point, &best);
+    if (tree->built > 0) {
+        if (tree->type == SYLVES_SPATIAL_INDEX_KDTREE) {
+            kd_find_nearest(tree, 0, tree->built, point, &best);
+        } else {
+            nodes_find_nearest(tree, point, &best);
+        }
+    }
+    if (!best.item) {
+        return false;
+    }
+    if (out_cell) *out_cell = best.item->cell;
+    if (out_distance) *out_distance = sqrt(best.dist2);
+    return true;
+}
+
+void sylves_spatial_tree_get_stats(const SylvesSpatialTree* tree, SylvesSpatialIndexStats* stats) {
+    if (!tree || !stats) {
+        return;
+    }
+    stats->item_count = sylves_spatial_tree_count(tree);
+    stats->max_depth = tree->depth;
+    stats->empty_nodes = 0;
+
+    if (tree->type == SYLVES_SPATIAL_INDEX_KDTREE) {
+        size_t leaves = tree->built > 0 ? tree->kd_splits + 1 : 0;
+        stats->node_count = tree->kd_splits + leaves;
+        stats->average_items_per_node = leaves > 0
+            ? (double)(tree->built - tree->kd_splits) / leaves : 0.0;
+        return;
+    }
+
+    size_t leaves = 0;
+    for (size_t i = 0; i < tree->node_count; i++) {
+        if (tree->nodes[i].leaf) leaves++;
+    }
+    stats->node_count = tree->node_count;
+    stats->average_items_per_node = leaves > 0 ? (double)tree->built / leaves : 0.0;
+}
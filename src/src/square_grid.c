@@ -9,6 +9,8 @@
 #include "sylves/cell_type.h"
 #include "grid_internal.h"
 #include "square_grid_internal.h"
+#include "simd_internal.h"
+#include "sylves/cell_buffer.h"
 #include "sylves/bounds.h"
 #include <stdlib.h>
 #include <math.h>
@@ -46,6 +48,15 @@ static SylvesVector3 square_get_cell_corner_pos(const SylvesGrid* grid, SylvesCe
 static int square_get_polygon(const SylvesGrid* grid, SylvesCell cell,
                              SylvesVector3* vertices, size_t max_vertices);
 static bool square_find_cell(const SylvesGrid* grid, SylvesVector3 position, SylvesCell* cell);
+static int square_try_move_batch(const SylvesGrid* grid, const SylvesCell* cells,
+                                 const SylvesCellDir* dirs, size_t count,
+                                 SylvesCell* dests, SylvesCellDir* inverse_dirs,
+                                 SylvesConnection* connections, bool* ok_mask);
+static void square_get_cell_centers_soa(const SylvesGrid* grid, const SylvesCellBuffer* cells,
+                                        double* out_x, double* out_y, double* out_z);
+static void square_get_cell_corners_soa(const SylvesGrid* grid, const SylvesCellBuffer* cells,
+                                        SylvesCellCorner corner,
+                                        double* out_x, double* out_y, double* out_z);
 
 /* Forward declarations of indexing helpers used in vtable */
 static int square_get_index_count(const SylvesGrid* grid);
@@ -74,7 +85,10 @@ static const SylvesGridVTable square_vtable = {
     .find_cell = square_find_cell,
     .get_index_count = square_get_index_count,
     .get_index = square_get_index,
-    .get_cell_by_index = square_get_cell_by_index
+    .get_cell_by_index = square_get_cell_by_index,
+    .try_move_batch = square_try_move_batch,
+    .get_cell_centers_soa = square_get_cell_centers_soa,
+    .get_cell_corners_soa = square_get_cell_corners_soa
 };
 
 /* Public API */
@@ -236,6 +250,48 @@ static bool square_try_move(const SylvesGrid* grid, SylvesCell cell, SylvesCellD
     return true;
 }
 
+/* Per-direction offsets and inverses, indexed by SylvesSquareDir */
+static const int SQUARE_DX[SYLVES_SQUARE_DIR_COUNT] = { 1, 0, -1, 0 };
+static const int SQUARE_DY[SYLVES_SQUARE_DIR_COUNT] = { 0, 1, 0, -1 };
+static const SylvesCellDir SQUARE_INV[SYLVES_SQUARE_DIR_COUNT] = {
+    SYLVES_SQUARE_DIR_LEFT, SYLVES_SQUARE_DIR_DOWN,
+    SYLVES_SQUARE_DIR_RIGHT, SYLVES_SQUARE_DIR_UP
+};
+
+static int square_try_move_batch(const SylvesGrid* grid, const SylvesCell* cells,
+                                 const SylvesCellDir* dirs, size_t count,
+                                 SylvesCell* dests, SylvesCellDir* inverse_dirs,
+                                 SylvesConnection* connections, bool* ok_mask) {
+    const SquareGridData* data = (const SquareGridData*)grid->data;
+    int moved = 0;
+
+    /* Bounds are folded into unsigned range checks so the loop body stays branch-free */
+    unsigned int w = data->is_bounded ? (unsigned int)(data->max_x - data->min_x) : UINT_MAX;
+    unsigned int h = data->is_bounded ? (unsigned int)(data->max_y - data->min_y) : UINT_MAX;
+    unsigned int ox = data->is_bounded ? (unsigned int)data->min_x : 0u;
+    unsigned int oy = data->is_bounded ? (unsigned int)data->min_y : 0u;
+
+    for (size_t i = 0; i < count; i++) {
+        SylvesCell c = cells[i];
+        int d = dirs[i];
+        bool valid_dir = (unsigned int)d < SYLVES_SQUARE_DIR_COUNT;
+        int di = valid_dir ? d : 0;
+        SylvesCell n = { c.x + SQUARE_DX[di], c.y + SQUARE_DY[di], 0 };
+        bool ok = valid_dir && c.z == 0 &&
+                  (unsigned int)c.x - ox <= w && (unsigned int)c.y - oy <= h &&
+                  (unsigned int)n.x - ox <= w && (unsigned int)n.y - oy <= h;
+        if (dests) dests[i] = n;
+        if (inverse_dirs) inverse_dirs[i] = SQUARE_INV[di];
+        if (connections) {
+            connections[i].rotation = 0;
+            connections[i].is_mirror = false;
+        }
+        if (ok_mask) ok_mask[i] = ok;
+        moved += ok;
+    }
+    return moved;
+}
+
 static int square_get_cell_dirs(const SylvesGrid* grid, SylvesCell cell,
                                SylvesCellDir* dirs, size_t max_dirs) {
     if (!square_is_cell_in_grid(grid, cell)) {
@@ -305,6 +361,28 @@ static SylvesVector3 square_get_cell_corner_pos(const SylvesGrid* grid, SylvesCe
     return sylves_vector3_create(x, y, 0.0);
 }
 
+static void square_get_cell_centers_soa(const SylvesGrid* grid, const SylvesCellBuffer* cells,
+                                        double* out_x, double* out_y, double* out_z) {
+    const SquareGridData* data = (const SquareGridData*)grid->data;
+    sylves_simd_affine_i32(cells->x, out_x, cells->count, 0.5, data->cell_size);
+    sylves_simd_affine_i32(cells->y, out_y, cells->count, 0.5, data->cell_size);
+    sylves_simd_fill(out_z, cells->count, 0.0);
+}
+
+static void square_get_cell_corners_soa(const SylvesGrid* grid, const SylvesCellBuffer* cells,
+                                        SylvesCellCorner corner,
+                                        double* out_x, double* out_y, double* out_z) {
+    const SquareGridData* data = (const SquareGridData*)grid->data;
+    /* Same corner layout as square_get_cell_corner_pos; unknown corners map to bottom-left */
+    double ox = (corner == SYLVES_SQUARE_CORNER_BOTTOM_RIGHT ||
+                 corner == SYLVES_SQUARE_CORNER_TOP_RIGHT) ? 1.0 : 0.0;
+    double oy = (corner == SYLVES_SQUARE_CORNER_TOP_RIGHT ||
+                 corner == SYLVES_SQUARE_CORNER_TOP_LEFT) ? 1.0 : 0.0;
+    sylves_simd_affine_i32(cells->x, out_x, cells->count, ox, data->cell_size);
+    sylves_simd_affine_i32(cells->y, out_y, cells->count, oy, data->cell_size);
+    sylves_simd_fill(out_z, cells->count, 0.0);
+}
+
 static int square_get_polygon(const SylvesGrid* grid, SylvesCell cell,
                              SylvesVector3* vertices, size_t max_vertices) {
     if (!square_is_cell_in_grid(grid, cell)) {
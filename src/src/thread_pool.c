@@ -0,0 +1,359 @@
+/**
+ * @file thread_pool.c
+ * @brief Fixed worker pool with a spin-then-yield barrier, and a background job queue
+ */
+
+#include "internal/thread_pool.h"
+#include "internal/sync.h"
+#include "sylves/memory.h"
+
+#ifdef _WIN32
+#include <windows.h>
+typedef HANDLE SylvesThread;
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+typedef pthread_t SylvesThread;
+#endif
+
+/* Barrier spins this many times before yielding the processor */
+#define BARRIER_SPINS 256
+
+typedef struct PoolWorker {
+    SylvesThreadPool* pool;
+    int index;
+} PoolWorker;
+
+struct SylvesThreadPool {
+    int size;
+    SylvesThread* threads;          /* size - 1; worker 0 is the caller */
+    PoolWorker* workers;
+    int started;                    /* threads actually created */
+
+    SylvesMutex lock;
+    SylvesCond start_cond;
+    SylvesCond done_cond;
+    uint32_t generation;            /* bumped per run; workers wait for a new one */
+    int pending;                    /* workers still inside the current run */
+    bool stopping;
+    SylvesThreadTask task;
+    void* user_data;
+
+    /* Sense-reversing barrier */
+    uint32_t barrier_arrived;
+    uint32_t barrier_sense;
+    uint8_t worker_sense[SYLVES_THREAD_POOL_MAX_WORKERS];
+};
+
+static void yield_processor(void) {
+#ifdef _WIN32
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
+static int processor_count(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (int)count : 1;
+#endif
+}
+
+static void worker_loop(PoolWorker* worker) {
+    SylvesThreadPool* pool = worker->pool;
+    uint32_t seen = 0;
+    for (;;) {
+        sylves_mutex_lock(&pool->lock);
+        while (pool->generation == seen && !pool->stopping) {
+            sylves_cond_wait(&pool->start_cond, &pool->lock);
+        }
+        if (pool->stopping) {
+            sylves_mutex_unlock(&pool->lock);
+            return;
+        }
+        seen = pool->generation;
+        SylvesThreadTask task = pool->task;
+        void* user_data = pool->user_data;
+        sylves_mutex_unlock(&pool->lock);
+
+        task(worker->index, pool->size, user_data);
+
+        sylves_mutex_lock(&pool->lock);
+        if (--pool->pending == 0) sylves_cond_broadcast(&pool->done_cond);
+        sylves_mutex_unlock(&pool->lock);
+    }
+}
+
+#ifdef _WIN32
+static DWORD WINAPI worker_main(LPVOID arg) {
+    worker_loop((PoolWorker*)arg);
+    return 0;
+}
+#else
+static void* worker_main(void* arg) {
+    worker_loop((PoolWorker*)arg);
+    return NULL;
+}
+#endif
+
+SylvesThreadPool* sylves_thread_pool_create(int worker_count) {
+    if (worker_count <= 0) worker_count = processor_count();
+    if (worker_count > SYLVES_THREAD_POOL_MAX_WORKERS) worker_count = SYLVES_THREAD_POOL_MAX_WORKERS;
+
+    SylvesThreadPool* pool = (SylvesThreadPool*)sylves_calloc(1, sizeof(SylvesThreadPool));
+    if (!pool) return NULL;
+    pool->size = worker_count;
+    sylves_mutex_init(&pool->lock);
+    sylves_cond_init(&pool->start_cond);
+    sylves_cond_init(&pool->done_cond);
+    if (worker_count == 1) return pool;
+
+    pool->threads = (SylvesThread*)sylves_calloc((size_t)worker_count - 1, sizeof(SylvesThread));
+    pool->workers = (PoolWorker*)sylves_calloc((size_t)worker_count - 1, sizeof(PoolWorker));
+    if (!pool->threads || !pool->workers) {
+        sylves_thread_pool_destroy(pool);
+        return NULL;
+    }
+    for (int i = 0; i < worker_count - 1; i++) {
+        pool->workers[i].pool = pool;
+        pool->workers[i].index = i + 1;
+#ifdef _WIN32
+        pool->threads[i] = CreateThread(NULL, 0, worker_main, &pool->workers[i], 0, NULL);
+        bool created = pool->threads[i] != NULL;
+#else
+        bool created = pthread_create(&pool->threads[i], NULL, worker_main, &pool->workers[i]) == 0;
+#endif
+        if (!created) {
+            sylves_thread_pool_destroy(pool);
+            return NULL;
+        }
+        pool->started++;
+    }
+    return pool;
+}
+
+void sylves_thread_pool_destroy(SylvesThreadPool* pool) {
+    if (!pool) return;
+
+    sylves_mutex_lock(&pool->lock);
+    pool->stopping = true;
+    sylves_cond_broadcast(&pool->start_cond);
+    sylves_mutex_unlock(&pool->lock);
+    for (int i = 0; i < pool->started; i++) {
+#ifdef _WIN32
+        WaitForSingleObject(pool->threads[i], INFINITE);
+        CloseHandle(pool->threads[i]);
+#else
+        pthread_join(pool->threads[i], NULL);
+#endif
+    }
+
+    sylves_cond_destroy(&pool->start_cond);
+    sylves_cond_destroy(&pool->done_cond);
+    sylves_mutex_destroy(&pool->lock);
+    sylves_free(pool->threads);
+    sylves_free(pool->workers);
+    sylves_free(pool);
+}
+
+int sylves_thread_pool_size(const SylvesThreadPool* pool) {
+    return pool ? pool->size : 1;
+}
+
+void sylves_thread_pool_run(SylvesThreadPool* pool, SylvesThreadTask task, void* user_data) {
+    if (!pool || pool->size == 1) {
+        task(0, 1, user_data);
+        return;
+    }
+
+    sylves_mutex_lock(&pool->lock);
+    pool->task = task;
+    pool->user_data = user_data;
+    pool->pending = pool->size - 1;
+    pool->generation++;
+    sylves_cond_broadcast(&pool->start_cond);
+    sylves_mutex_unlock(&pool->lock);
+
+    task(0, pool->size, user_data);
+
+    sylves_mutex_lock(&pool->lock);
+    while (pool->pending > 0) {
+        sylves_cond_wait(&pool->done_cond, &pool->lock);
+    }
+    sylves_mutex_unlock(&pool->lock);
+}
+
+void sylves_thread_pool_barrier(SylvesThreadPool* pool, int worker) {
+    if (!pool || pool->size == 1) return;
+
+    uint32_t sense = pool->worker_sense[worker] ^= 1;
+    if (sylves_atomic_fetch_add_u32_acq_rel(&pool->barrier_arrived, 1u) == (uint32_t)pool->size - 1) {
+        // Last to arrive resets the count, then releases everyone
+        sylves_atomic_store_u32_release(&pool->barrier_arrived, 0u);
+        sylves_atomic_store_u32_release(&pool->barrier_sense, sense);
+        return;
+    }
+    for (int spins = 0; sylves_atomic_load_u32_acquire(&pool->barrier_sense) != sense; spins++) {
+        if (spins >= BARRIER_SPINS) yield_processor();
+    }
+}
+
+/* Job queue */
+
+typedef struct QueuedJob {
+    SylvesJobFunc job;
+    void* user_data;
+} QueuedJob;
+
+struct SylvesJobQueue {
+    SylvesThread* threads;
+    int started;
+
+    SylvesMutex lock;
+    SylvesCond job_cond;            /* signalled when a job is queued or on shutdown */
+    SylvesCond idle_cond;           /* broadcast when the queue drains */
+    QueuedJob* jobs;                /* ring buffer */
+    size_t capacity;
+    size_t head;
+    size_t count;
+    int running;                    /* jobs taken but not finished */
+    bool stopping;
+};
+
+static void job_loop(SylvesJobQueue* queue) {
+    sylves_mutex_lock(&queue->lock);
+    for (;;) {
+        while (queue->count == 0 && !queue->stopping) {
+            sylves_cond_wait(&queue->job_cond, &queue->lock);
+        }
+        if (queue->stopping) break;
+
+        QueuedJob next = queue->jobs[queue->head];
+        queue->head = (queue->head + 1) % queue->capacity;
+        queue->count--;
+        queue->running++;
+        sylves_mutex_unlock(&queue->lock);
+
+        next.job(next.user_data);
+
+        sylves_mutex_lock(&queue->lock);
+        queue->running--;
+        if (queue->count == 0 && queue->running == 0) sylves_cond_broadcast(&queue->idle_cond);
+    }
+    sylves_mutex_unlock(&queue->lock);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI job_main(LPVOID arg) {
+    job_loop((SylvesJobQueue*)arg);
+    return 0;
+}
+#else
+static void* job_main(void* arg) {
+    job_loop((SylvesJobQueue*)arg);
+    return NULL;
+}
+#endif
+
+SylvesJobQueue* sylves_job_queue_create(int worker_count) {
+    if (worker_count <= 0) worker_count = processor_count();
+    if (worker_count > SYLVES_THREAD_POOL_MAX_WORKERS) worker_count = SYLVES_THREAD_POOL_MAX_WORKERS;
+
+    SylvesJobQueue* queue = (SylvesJobQueue*)sylves_calloc(1, sizeof(SylvesJobQueue));
+    if (!queue) return NULL;
+    sylves_mutex_init(&queue->lock);
+    sylves_cond_init(&queue->job_cond);
+    sylves_cond_init(&queue->idle_cond);
+
+    queue->capacity = 64;
+    queue->jobs = (QueuedJob*)sylves_alloc(sizeof(QueuedJob) * queue->capacity);
+    queue->threads = (SylvesThread*)sylves_calloc((size_t)worker_count, sizeof(SylvesThread));
+    if (!queue->jobs || !queue->threads) {
+        sylves_job_queue_destroy(queue);
+        return NULL;
+    }
+    for (int i = 0; i < worker_count; i++) {
+#ifdef _WIN32
+        queue->threads[i] = CreateThread(NULL, 0, job_main, queue, 0, NULL);
+        bool created = queue->threads[i] != NULL;
+#else
+        bool created = pthread_create(&queue->threads[i], NULL, job_main, queue) == 0;
+#endif
+        if (!created) {
+            sylves_job_queue_destroy(queue);
+            return NULL;
+        }
+        queue->started++;
+    }
+    return queue;
+}
+
+void sylves_job_queue_destroy(SylvesJobQueue* queue) {
+    if (!queue) return;
+
+    sylves_mutex_lock(&queue->lock);
+    queue->stopping = true;
+    queue->count = 0;
+    sylves_cond_broadcast(&queue->job_cond);
+    sylves_mutex_unlock(&queue->lock);
+    for (int i = 0; i < queue->started; i++) {
+#ifdef _WIN32
+        WaitForSingleObject(queue->threads[i], INFINITE);
+        CloseHandle(queue->threads[i]);
+#else
+        pthread_join(queue->threads[i], NULL);
+#endif
+    }
+
+    sylves_cond_destroy(&queue->job_cond);
+    sylves_cond_destroy(&queue->idle_cond);
+    sylves_mutex_destroy(&queue->lock);
+    sylves_free(queue->jobs);
+    sylves_free(queue->threads);
+    sylves_free(queue);
+}
+
+bool sylves_job_queue_submit(SylvesJobQueue* queue, SylvesJobFunc job, void* user_data) {
+    if (!queue || !job) return false;
+
+    sylves_mutex_lock(&queue->lock);
+    if (queue->count == queue->capacity) {
+        // Grow and unwrap the ring so head starts at zero
+        size_t new_capacity = queue->capacity * 2;
+        QueuedJob* jobs = (QueuedJob*)sylves_alloc(sizeof(QueuedJob) * new_capacity);
+        if (!jobs) {
+            sylves_mutex_unlock(&queue->lock);
+            return false;
+        }
+        for (size_t i = 0; i < queue->count; i++) {
+            jobs[i] = queue->jobs[(queue->head + i) % queue->capacity];
+        }
+        sylves_free(queue->jobs);
+        queue->jobs = jobs;
+        queue->capacity = new_capacity;
+        queue->head = 0;
+    }
+    QueuedJob* slot = &queue->jobs[(queue->head + queue->count) % queue->capacity];
+    slot->job = job;
+    slot->user_data = user_data;
+    queue->count++;
+    sylves_cond_signal(&queue->job_cond);
+    sylves_mutex_unlock(&queue->lock);
+    return true;
+}
+
+void sylves_job_queue_wait_idle(SylvesJobQueue* queue) {
+    if (!queue) return;
+
+    sylves_mutex_lock(&queue->lock);
+    while (queue->count > 0 || queue->running > 0) {
+        sylves_cond_wait(&queue->idle_cond, &queue->lock);
+    }
+    sylves_mutex_unlock(&queue->lock);
+}
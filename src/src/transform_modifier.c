@@ -183,6 +183,15 @@ static bool transform_try_move(const SylvesGrid* grid, SylvesCell cell, SylvesCe
     return sylves_grid_try_move(modifier->underlying, cell, dir, dest, inverse_dir, connection);
 }
 
+static int transform_try_move_batch(const SylvesGrid* grid, const SylvesCell* cells,
+                                    const SylvesCellDir* dirs, size_t count,
+                                    SylvesCell* dests, SylvesCellDir* inverse_dirs,
+                                    SylvesConnection* connections, bool* ok_mask) {
+    const SylvesGridModifier* modifier = (const SylvesGridModifier*)grid;
+    return sylves_grid_try_move_batch(modifier->underlying, cells, dirs, count,
+                                      dests, inverse_dirs, connections, ok_mask);
+}
+
 static int transform_get_cell_dirs(const SylvesGrid* grid, SylvesCell cell,
                                   SylvesCellDir* dirs, size_t max_dirs) {
     const SylvesGridModifier* modifier = (const SylvesGridModifier*)grid;
@@ -231,4 +240,7 @@ static const SylvesGridVTable transform_modifier_vtable = {
     .get_index_count = NULL,  // Will use default
     .get_index = NULL,  // Will use default
     .get_cell_by_index = NULL,  // Will use default
+
+    // Batch topology - forward to underlying
+    .try_move_batch = transform_try_move_batch,
 };
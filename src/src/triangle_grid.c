@@ -9,6 +9,8 @@
 #include "sylves/cell_type.h"
 #include "sylves/bounds.h"
 #include "grid_internal.h"
+#include "simd_internal.h"
+#include "sylves/cell_buffer.h"
 #include <stdlib.h>
 #include <math.h>
 #include <string.h>
@@ -41,7 +43,18 @@ static int triangle_get_cell_corners(const SylvesGrid* grid, SylvesCell cell,
                                     SylvesCellCorner* corners, size_t max_corners);
 static int triangle_get_polygon(const SylvesGrid* grid, SylvesCell cell,
                                SylvesVector3* vertices, size_t max_vertices);
+static SylvesVector3 triangle_get_cell_corner_pos(const SylvesGrid* grid, SylvesCell cell,
+                                                  SylvesCellCorner corner);
 static bool triangle_find_cell(const SylvesGrid* grid, SylvesVector3 position, SylvesCell* cell);
+static int triangle_try_move_batch(const SylvesGrid* grid, const SylvesCell* cells,
+                                   const SylvesCellDir* dirs, size_t count,
+                                   SylvesCell* dests, SylvesCellDir* inverse_dirs,
+                                   SylvesConnection* connections, bool* ok_mask);
+static void triangle_get_cell_centers_soa(const SylvesGrid* grid, const SylvesCellBuffer* cells,
+                                          double* out_x, double* out_y, double* out_z);
+static void triangle_get_cell_corners_soa(const SylvesGrid* grid, const SylvesCellBuffer* cells,
+                                          SylvesCellCorner corner,
+                                          double* out_x, double* out_y, double* out_z);
 
 /* VTable for triangle grid */
 static const SylvesGridVTable triangle_vtable = {
@@ -59,8 +72,12 @@ static const SylvesGridVTable triangle_vtable = {
     .get_cell_dirs = triangle_get_cell_dirs,
     .get_cell_corners = triangle_get_cell_corners,
     .get_cell_center = triangle_get_cell_center,
+    .get_cell_corner_pos = triangle_get_cell_corner_pos,
     .get_polygon = triangle_get_polygon,
     .find_cell = triangle_find_cell,
+    .try_move_batch = triangle_try_move_batch,
+    .get_cell_centers_soa = triangle_get_cell_centers_soa,
+    .get_cell_corners_soa = triangle_get_cell_corners_soa,
 };
 
 /* Public API */
@@ -201,6 +218,48 @@ static bool triangle_try_move(const SylvesGrid* grid, SylvesCell cell, SylvesCel
     return triangle_is_cell_in_grid(grid, *dest);
 }
 
+/* Per-direction offsets matching triangle_try_move, [orientation][dir][axis] */
+static const int TRIANGLE_DELTA[2][6][3] = {
+    /* Flat topped: UpRight, Up, UpLeft, DownLeft, Down, DownRight */
+    { {0, 0, -1}, {0, 1, 0}, {-1, 0, 0}, {0, 0, 1}, {0, -1, 0}, {1, 0, 0} },
+    /* Flat sides: Right, UpRight, UpLeft, Left, DownLeft, DownRight */
+    { {1, 0, 0}, {0, 0, -1}, {0, 1, 0}, {-1, 0, 0}, {0, 0, 1}, {0, -1, 0} }
+};
+
+static int triangle_try_move_batch(const SylvesGrid* grid, const SylvesCell* cells,
+                                   const SylvesCellDir* dirs, size_t count,
+                                   SylvesCell* dests, SylvesCellDir* inverse_dirs,
+                                   SylvesConnection* connections, bool* ok_mask) {
+    const TriangleGridData* data = (const TriangleGridData*)grid->data;
+    const int (*delta)[3] = TRIANGLE_DELTA[data->orientation == SYLVES_TRIANGLE_ORIENTATION_FLAT_TOPPED ? 0 : 1];
+    bool bounded = data->is_bounded;
+    SylvesVector3Int lo = data->min;
+    SylvesVector3Int hi = data->max;
+    int moved = 0;
+    for (size_t i = 0; i < count; i++) {
+        SylvesCell c = cells[i];
+        int d = dirs[i];
+        bool ok = (unsigned int)d < 6;
+        int di = ok ? d : 0;
+        SylvesCell n = { c.x + delta[di][0], c.y + delta[di][1], c.z + delta[di][2] };
+        if (bounded) {
+            ok = ok && c.x >= lo.x && c.x <= hi.x && c.y >= lo.y && c.y <= hi.y &&
+                 c.z >= lo.z && c.z <= hi.z &&
+                 n.x >= lo.x && n.x <= hi.x && n.y >= lo.y && n.y <= hi.y &&
+                 n.z >= lo.z && n.z <= hi.z;
+        }
+        if (dests) dests[i] = n;
+        if (inverse_dirs) inverse_dirs[i] = (3 + di) % 6;
+        if (connections) {
+            connections[i].rotation = 0;
+            connections[i].is_mirror = false;
+        }
+        if (ok_mask) ok_mask[i] = ok;
+        moved += ok;
+    }
+    return moved;
+}
+
 static bool triangle_is_up(const SylvesGrid* grid, SylvesCell cell) {
     TriangleGridData* data = (TriangleGridData*)grid->data;
     return data->orientation == SYLVES_TRIANGLE_ORIENTATION_FLAT_TOPPED && 
@@ -315,6 +374,76 @@ static int triangle_get_polygon(const SylvesGrid* grid, SylvesCell cell,
     return 3;
 }
 
+static SylvesVector3 triangle_get_cell_corner_pos(const SylvesGrid* grid, SylvesCell cell,
+                                                  SylvesCellCorner corner) {
+    /* Corners are numbered in get_polygon vertex order */
+    SylvesVector3 vertices[3];
+    triangle_get_polygon(grid, cell, vertices, 3);
+    return vertices[((int)corner % 3 + 3) % 3];
+}
+
+static void triangle_get_cell_centers_soa(const SylvesGrid* grid, const SylvesCellBuffer* cells,
+                                          double* out_x, double* out_y, double* out_z) {
+    const TriangleGridData* data = (const TriangleGridData*)grid->data;
+    const int* restrict a = cells->x;
+    const int* restrict b = cells->y;
+    const int* restrict c = cells->z;
+    double* restrict ox = out_x;
+    double* restrict oy = out_y;
+    double side = data->cell_size;
+    size_t n = cells->count;
+    if (data->orientation == SYLVES_TRIANGLE_ORIENTATION_FLAT_TOPPED) {
+        for (size_t i = 0; i < n; i++) {
+            ox[i] = (0.5 * a[i] - 0.5 * c[i]) * side;
+            oy[i] = (-1 / 3.0 * a[i] + 2 / 3.0 * b[i] - 1 / 3.0 * c[i]) * side;
+        }
+    } else {
+        for (size_t i = 0; i < n; i++) {
+            ox[i] = (-1 / 3.0 * b[i] + 2 / 3.0 * a[i] - 1 / 3.0 * c[i]) * side;
+            oy[i] = (0.5 * b[i] - 0.5 * c[i]) * side;
+        }
+    }
+    sylves_simd_fill(out_z, n, 0.0);
+}
+
+/* Corner offsets from the center used by triangle_get_polygon, in units of cell_size:
+   [orientation][sum == 2 ? 0 : 1][corner][axis] */
+static const double TRIANGLE_CORNER_OFFSET[2][2][3][2] = {
+    { /* Flat topped: up, down */
+        { { 0.5, -1.0 / 3.0 }, { 0.0, 2.0 / 3.0 }, { -0.5, -1.0 / 3.0 } },
+        { { 0.5, 1.0 / 3.0 }, { -0.5, 1.0 / 3.0 }, { 0.0, -2.0 / 3.0 } }
+    },
+    { /* Flat sides: right, left */
+        { { 2.0 / 3.0, 0.0 }, { -1.0 / 3.0, 0.5 }, { -1.0 / 3.0, -0.5 } },
+        { { 1.0 / 3.0, 0.5 }, { -2.0 / 3.0, 0.0 }, { 1.0 / 3.0, -0.5 } }
+    }
+};
+
+static void triangle_get_cell_corners_soa(const SylvesGrid* grid, const SylvesCellBuffer* cells,
+                                          SylvesCellCorner corner,
+                                          double* out_x, double* out_y, double* out_z) {
+    const TriangleGridData* data = (const TriangleGridData*)grid->data;
+    int o = data->orientation == SYLVES_TRIANGLE_ORIENTATION_FLAT_TOPPED ? 0 : 1;
+    int k = ((int)corner % 3 + 3) % 3;
+    double side = data->cell_size;
+    double ax = TRIANGLE_CORNER_OFFSET[o][0][k][0] * side;
+    double ay = TRIANGLE_CORNER_OFFSET[o][0][k][1] * side;
+    double bx = TRIANGLE_CORNER_OFFSET[o][1][k][0] * side;
+    double by = TRIANGLE_CORNER_OFFSET[o][1][k][1] * side;
+
+    triangle_get_cell_centers_soa(grid, cells, out_x, out_y, out_z);
+    const int* restrict a = cells->x;
+    const int* restrict b = cells->y;
+    const int* restrict c = cells->z;
+    double* restrict px = out_x;
+    double* restrict py = out_y;
+    for (size_t i = 0; i < cells->count; i++) {
+        bool first = a[i] + b[i] + c[i] == 2;
+        px[i] += first ? ax : bx;
+        py[i] += first ? ay : by;
+    }
+}
+
 static bool triangle_find_cell(const SylvesGrid* grid, SylvesVector3 position, SylvesCell* cell) {
     TriangleGridData* data = (TriangleGridData*)grid->data;
     
@@ -6,361 +6,671 @@
 #include "sylves/voronoi_grid.h"
 #include "sylves/mesh_grid.h"
 #include "sylves/mesh.h"
+#include "sylves/delaunay.h"
 #include "sylves/memory.h"
+#include "internal/thread_pool.h"
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
 #include <float.h>
 
-/* Simple Delaunay triangulation for Voronoi construction */
+/* Margin around the points that closes hull cells when there is no clip box, as a fraction of their extent */
+#define UNCLIPPED_MARGIN 0.25
+
+/* Edges shorter than this fraction of the box diagonal are merged away */
+#define DEGENERATE_EDGE 1e-9
+
+/* A corner of a cell polygon */
 typedef struct {
-    int p0, p1, p2;  /* Indices of triangle vertices */
-    double cx, cy;   /* Circumcenter */
-    double r2;       /* Squared circumradius */
-} Triangle;
+    double x, y;
+    int tri;       /* Triangle whose circumcenter this is, or -1 for a corner made by clipping */
+    int neighbor;  /* Site across the edge to the next corner, or -1 */
+} CellCorner;
 
+/* Per-caller polygon scratch, grown as cells need */
 typedef struct {
-    int p0, p1;      /* Edge vertices */
-    int tri;         /* Associated triangle */
-} Edge;
+    CellCorner* corners[2];
+    size_t capacity;
+} CellScratch;
 
-/* Helper to compute circumcircle of a triangle */
-static void compute_circumcircle(const SylvesVector2* points, int p0, int p1, int p2,
-                                double* cx, double* cy, double* r2) {
-    double ax = points[p0].x, ay = points[p0].y;
-    double bx = points[p1].x, by = points[p1].y;
-    double cx_pt = points[p2].x, cy_pt = points[p2].y;
-    
-    double d = 2.0 * (ax * (by - cy_pt) + bx * (cy_pt - ay) + cx_pt * (ay - by));
-    
-    if (fabs(d) < DBL_EPSILON) {
-        /* Degenerate triangle */
-        *cx = (ax + bx + cx_pt) / 3.0;
-        *cy = (ay + by + cy_pt) / 3.0;
-        *r2 = DBL_MAX;
-        return;
+/* Triangulation of the current sites and the buffers derived from it, kept across iterations */
+typedef struct {
+    SylvesDelaunay* delaunay;
+    SylvesVector2* centers;  /* Circumcenter of each triangle */
+    size_t centers_capacity;
+    int* inedges;            /* Per site, a halfedge ending at it; a hull edge for hull sites */
+    size_t inedges_capacity;
+    SylvesVector2 box_min, box_max;
+    double far_scale;        /* Ray length that reaches past the box from anywhere near it */
+    double degenerate_edge;
+    bool rebuilt;            /* Whether the last triangulation started from scratch */
+} VoronoiBuilder;
+
+static void builder_destroy(VoronoiBuilder* b) {
+    sylves_delaunay_destroy(b->delaunay);
+    sylves_free(b->centers);
+    sylves_free(b->inedges);
+}
+
+static void scratch_destroy(CellScratch* s) {
+    sylves_free(s->corners[0]);
+    sylves_free(s->corners[1]);
+}
+
+static bool scratch_reserve(CellScratch* s, size_t count) {
+    if (count <= s->capacity) {
+        return true;
+    }
+    size_t capacity = s->capacity > 0 ? s->capacity : 32;
+    while (capacity < count) {
+        capacity *= 2;
+    }
+    for (int i = 0; i < 2; i++) {
+        CellCorner* corners = (CellCorner*)sylves_realloc(s->corners[i], capacity * sizeof(CellCorner));
+        if (!corners) {
+            return false;
+        }
+        s->corners[i] = corners;
+    }
+    s->capacity = capacity;
+    return true;
+}
+
+static SylvesVector2 circumcenter(SylvesVector2 a, SylvesVector2 b, SylvesVector2 c) {
+    double dx = b.x - a.x;
+    double dy = b.y - a.y;
+    double ex = c.x - a.x;
+    double ey = c.y - a.y;
+    double den = dx * ey - dy * ex;
+    if (den == 0) {
+        /* Collinear: no circumcenter, fall back to the centroid */
+        return (SylvesVector2){ (a.x + b.x + c.x) / 3.0, (a.y + b.y + c.y) / 3.0 };
+    }
+    double bl = dx * dx + dy * dy;
+    double cl = ex * ex + ey * ey;
+    double d = 0.5 / den;
+    return (SylvesVector2){ a.x + (ey * bl - dy * cl) * d, a.y + (dx * cl - ex * bl) * d };
+}
+
+static void builder_set_box(VoronoiBuilder* b, SylvesVector2 box_min, SylvesVector2 box_max) {
+    b->box_min = box_min;
+    b->box_max = box_max;
+    double diagonal = hypot(box_max.x - box_min.x, box_max.y - box_min.y);
+    b->far_scale = 4.0 * diagonal;
+    b->degenerate_edge = DEGENERATE_EDGE * diagonal;
+}
+
+/*
+ * (Re)triangulate the sites, reusing every buffer from the previous call.
+ * When the sites are the previous ones moved, the previous triangulation
+ * is repaired by edge flips where it can be.
+ */
+static bool builder_triangulate(VoronoiBuilder* b, const SylvesVector2* points, size_t num_points, bool moved) {
+    b->rebuilt = true;
+    if (!b->delaunay) {
+        b->delaunay = sylves_delaunay_create(points, num_points, NULL);
+        if (!b->delaunay) {
+            return false;
+        }
+    } else if (moved && b->delaunay->num_points == num_points) {
+        if (sylves_delaunay_update_moved(b->delaunay, points, &b->rebuilt) != SYLVES_SUCCESS) {
+            return false;
+        }
+    } else if (sylves_delaunay_update(b->delaunay, points, num_points) != SYLVES_SUCCESS) {
+        return false;
     }
     
-    double a2 = ax * ax + ay * ay;
-    double b2 = bx * bx + by * by;
-    double c2 = cx_pt * cx_pt + cy_pt * cy_pt;
+    const SylvesDelaunay* d = b->delaunay;
+    if (d->num_triangles > b->centers_capacity) {
+        SylvesVector2* centers = (SylvesVector2*)sylves_realloc(b->centers, d->num_triangles * sizeof(SylvesVector2));
+        if (!centers) {
+            return false;
+        }
+        b->centers = centers;
+        b->centers_capacity = d->num_triangles;
+    }
+    if (num_points > b->inedges_capacity) {
+        int* inedges = (int*)sylves_realloc(b->inedges, num_points * sizeof(int));
+        if (!inedges) {
+            return false;
+        }
+        b->inedges = inedges;
+        b->inedges_capacity = num_points;
+    }
     
-    *cx = (a2 * (by - cy_pt) + b2 * (cy_pt - ay) + c2 * (ay - by)) / d;
-    *cy = (a2 * (cx_pt - bx) + b2 * (ax - cx_pt) + c2 * (bx - ax)) / d;
+    for (size_t t = 0; t < d->num_triangles; t++) {
+        const int* tri = &d->triangles[t * 3];
+        b->centers[t] = circumcenter(points[tri[0]], points[tri[1]], points[tri[2]]);
+    }
     
-    double dx = ax - *cx;
-    double dy = ay - *cy;
-    *r2 = dx * dx + dy * dy;
+    /* Prefer a hull edge, so walks from it cover the whole fan of a hull site */
+    memset(b->inedges, -1, num_points * sizeof(int));
+    for (int e = 0; e < (int)(d->num_triangles * 3); e++) {
+        int p = d->triangles[sylves_delaunay_next_halfedge(e)];
+        if (d->halfedges[e] == -1 || b->inedges[p] == -1) {
+            b->inedges[p] = e;
+        }
+    }
+    return true;
 }
 
-/* Check if a point is inside a triangle's circumcircle */
-static bool in_circumcircle(const Triangle* tri, double px, double py) {
-    double dx = px - tri->cx;
-    double dy = py - tri->cy;
-    return (dx * dx + dy * dy) < tri->r2;
+static bool builder_is_hull_site(const VoronoiBuilder* b, int site) {
+    int e0 = b->inedges[site];
+    return e0 != -1 && b->delaunay->halfedges[e0] == -1;
 }
 
-/* Super simple Bowyer-Watson triangulation - not optimal but works for small point sets */
-static void triangulate(const SylvesVector2* points, size_t num_points,
-                       Triangle** triangles, size_t* num_triangles) {
-    /* Start with super-triangle containing all points */
-    double min_x = DBL_MAX, min_y = DBL_MAX;
-    double max_x = -DBL_MAX, max_y = -DBL_MAX;
-    
-    for (size_t i = 0; i < num_points; i++) {
-        if (points[i].x < min_x) min_x = points[i].x;
-        if (points[i].y < min_y) min_y = points[i].y;
-        if (points[i].x > max_x) max_x = points[i].x;
-        if (points[i].y > max_y) max_y = points[i].y;
-    }
-    
-    double dx = max_x - min_x;
-    double dy = max_y - min_y;
-    double delta_max = fmax(dx, dy);
-    double mid_x = (min_x + max_x) / 2.0;
-    double mid_y = (min_y + max_y) / 2.0;
-    
-    /* Create super-triangle vertices */
-    SylvesVector2* all_points = malloc((num_points + 3) * sizeof(SylvesVector2));
-    memcpy(all_points, points, num_points * sizeof(SylvesVector2));
-    
-    /* Super-triangle vertices */
-    all_points[num_points].x = mid_x - 20 * delta_max;
-    all_points[num_points].y = mid_y - delta_max;
-    all_points[num_points + 1].x = mid_x;
-    all_points[num_points + 1].y = mid_y + 20 * delta_max;
-    all_points[num_points + 2].x = mid_x + 20 * delta_max;
-    all_points[num_points + 2].y = mid_y - delta_max;
-    
-    /* Initialize triangulation with super-triangle */
-    size_t tri_capacity = num_points * 3;
-    *triangles = malloc(tri_capacity * sizeof(Triangle));
-    *num_triangles = 1;
-    
-    Triangle* tris = *triangles;
-    tris[0].p0 = num_points;
-    tris[0].p1 = num_points + 1;
-    tris[0].p2 = num_points + 2;
-    compute_circumcircle(all_points, tris[0].p0, tris[0].p1, tris[0].p2,
-                        &tris[0].cx, &tris[0].cy, &tris[0].r2);
-    
-    /* Add points one by one */
-    for (size_t i = 0; i < num_points; i++) {
-        double px = points[i].x;
-        double py = points[i].y;
-        
-        /* Find triangles whose circumcircle contains this point */
-        Edge* polygon = malloc(num_points * 3 * sizeof(Edge));
-        size_t poly_size = 0;
-        
-        size_t j = 0;
-        while (j < *num_triangles) {
-            if (in_circumcircle(&tris[j], px, py)) {
-                /* Add triangle edges to polygon */
-                Edge e0 = {tris[j].p0, tris[j].p1, j};
-                Edge e1 = {tris[j].p1, tris[j].p2, j};
-                Edge e2 = {tris[j].p2, tris[j].p0, j};
-                
-                /* Remove triangle by swapping with last */
-                tris[j] = tris[*num_triangles - 1];
-                (*num_triangles)--;
-                
-                /* Add edges, removing duplicates */
-                Edge edges[3] = {e0, e1, e2};
-                for (int k = 0; k < 3; k++) {
-                    bool duplicate = false;
-                    for (size_t m = 0; m < poly_size; m++) {
-                        if ((edges[k].p0 == polygon[m].p1 && edges[k].p1 == polygon[m].p0) ||
-                            (edges[k].p0 == polygon[m].p0 && edges[k].p1 == polygon[m].p1)) {
-                            /* Remove duplicate edge */
-                            polygon[m] = polygon[poly_size - 1];
-                            poly_size--;
-                            duplicate = true;
-                            break;
-                        }
-                    }
-                    if (!duplicate) {
-                        polygon[poly_size++] = edges[k];
-                    }
-                }
+/* Unit normal of edge a-b on the side away from the third vertex of its triangle */
+static SylvesVector2 outward_normal(SylvesVector2 a, SylvesVector2 b, SylvesVector2 inside) {
+    SylvesVector2 n = { a.y - b.y, b.x - a.x };
+    double length = hypot(n.x, n.y);
+    if (length > 0) {
+        n.x /= length;
+        n.y /= length;
+    }
+    if (n.x * (inside.x - a.x) + n.y * (inside.y - a.y) > 0) {
+        n.x = -n.x;
+        n.y = -n.y;
+    }
+    return n;
+}
+
+/*
+ * Sutherland-Hodgman against one side of the box, keeping coord * sign >= limit * sign.
+ * Each corner carries the neighbor of its outgoing edge: a kept edge keeps
+ * its neighbor, and the edge a clip opens along the box border has none.
+ */
+static size_t clip_side(const CellCorner* in, size_t count, CellCorner* out,
+                        int axis, double limit, double sign) {
+    size_t written = 0;
+    for (size_t i = 0; i < count; i++) {
+        const CellCorner* s = &in[i];
+        const CellCorner* e = &in[(i + 1) % count];
+        double sv = axis == 0 ? s->x : s->y;
+        double ev = axis == 0 ? e->x : e->y;
+        bool s_in = (sv - limit) * sign >= 0;
+        bool e_in = (ev - limit) * sign >= 0;
+        if (s_in) {
+            out[written++] = *s;
+        }
+        if (s_in != e_in) {
+            double t = (limit - sv) / (ev - sv);
+            CellCorner cut;
+            if (axis == 0) {
+                cut.x = limit;
+                cut.y = s->y + t * (e->y - s->y);
             } else {
-                j++;
+                cut.x = s->x + t * (e->x - s->x);
+                cut.y = limit;
             }
+            cut.tri = -1;
+            cut.neighbor = s_in ? -1 : s->neighbor;
+            out[written++] = cut;
+        }
+    }
+    return written;
+}
+
+static bool corners_inside(const VoronoiBuilder* b, const CellCorner* corners, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        if (corners[i].x < b->box_min.x || corners[i].x > b->box_max.x ||
+            corners[i].y < b->box_min.y || corners[i].y > b->box_max.y) {
+            return false;
         }
+    }
+    return true;
+}
+
+/* Drop edges too short to matter, such as those between circumcenters of cocircular sites */
+static size_t merge_degenerate(const VoronoiBuilder* b, CellCorner* corners, size_t count) {
+    size_t i = 0;
+    while (count > 1 && i < count) {
+        CellCorner* next = &corners[(i + 1) % count];
+        if (fabs(next->x - corners[i].x) + fabs(next->y - corners[i].y) <= b->degenerate_edge) {
+            corners[i].neighbor = next->neighbor;
+            size_t removed = (i + 1) % count;
+            memmove(&corners[removed], &corners[removed + 1], (count - removed - 1) * sizeof(CellCorner));
+            count--;
+            if (removed < i) {
+                i--;
+            }
+        } else {
+            i++;
+        }
+    }
+    return count;
+}
+
+/*
+ * Build the clipped, counter-clockwise cell of a site by walking the
+ * triangles around it through the halfedges. Hull cells are unbounded: they
+ * are closed with a ray along each hull edge's outward normal, far enough
+ * out to be clipped away. Returns the corner count, 0 for a site without a
+ * cell, or -1 if scratch could not grow; the corners are left in
+ * scratch->corners[0].
+ */
+static int build_cell(const VoronoiBuilder* b, CellScratch* scratch, int site) {
+    const SylvesDelaunay* d = b->delaunay;
+    int e0 = b->inedges[site];
+    if (e0 == -1) {
+        return 0;
+    }
+    
+    size_t count = 0;
+    int e = e0;
+    int last = e0;
+    do {
+        if (!scratch_reserve(scratch, count + 1)) {
+            return -1;
+        }
+        int out = sylves_delaunay_next_halfedge(e);
+        int t = sylves_delaunay_edge_to_triangle(e);
+        scratch->corners[0][count++] = (CellCorner){
+            b->centers[t].x, b->centers[t].y, t, d->triangles[sylves_delaunay_next_halfedge(out)]
+        };
+        last = e;
+        e = d->halfedges[out];
+    } while (e != e0 && e != -1);
+    
+    if (e == -1) {
+        if (!scratch_reserve(scratch, count + 3)) {
+            return -1;
+        }
+        const SylvesVector2* points = d->points;
+        SylvesVector2 p = points[site];
+        int first_from = d->triangles[e0];
+        int last_to = d->triangles[sylves_delaunay_prev_halfedge(last)];
+        SylvesVector2 n0 = outward_normal(points[first_from], p,
+                                          points[d->triangles[sylves_delaunay_prev_halfedge(e0)]]);
+        SylvesVector2 n1 = outward_normal(p, points[last_to], points[d->triangles[last]]);
         
-        /* Create new triangles from polygon */
-        for (size_t j = 0; j < poly_size; j++) {
-            if (*num_triangles >= tri_capacity) {
-                tri_capacity *= 2;
-                *triangles = realloc(*triangles, tri_capacity * sizeof(Triangle));
-                tris = *triangles;
+        /* Between the rays, a third far corner keeps the closing edges outside the box */
+        SylvesVector2 mid = { n0.x + n1.x, n0.y + n1.y };
+        double mid_length = hypot(mid.x, mid.y);
+        if (mid_length < 1e-9) {
+            mid = (SylvesVector2){ -n0.y, n0.x };
+            if (mid.x * (p.x - scratch->corners[0][0].x) + mid.y * (p.y - scratch->corners[0][0].y) < 0) {
+                mid.x = -mid.x;
+                mid.y = -mid.y;
             }
-            
-            tris[*num_triangles].p0 = polygon[j].p0;
-            tris[*num_triangles].p1 = polygon[j].p1;
-            tris[*num_triangles].p2 = i;
-            compute_circumcircle(all_points, 
-                               tris[*num_triangles].p0,
-                               tris[*num_triangles].p1, 
-                               tris[*num_triangles].p2,
-                               &tris[*num_triangles].cx,
-                               &tris[*num_triangles].cy,
-                               &tris[*num_triangles].r2);
-            (*num_triangles)++;
+        } else {
+            mid.x /= mid_length;
+            mid.y /= mid_length;
         }
         
-        free(polygon);
+        const CellCorner* first = &scratch->corners[0][0];
+        const CellCorner* end = &scratch->corners[0][count - 1];
+        double reach = b->far_scale +
+                       fmax(fabs(first->x - p.x) + fabs(first->y - p.y), fabs(end->x - p.x) + fabs(end->y - p.y));
+        CellCorner far_end = { end->x + n1.x * reach, end->y + n1.y * reach, -1, -1 };
+        CellCorner far_mid = { p.x + mid.x * 2.0 * reach, p.y + mid.y * 2.0 * reach, -1, -1 };
+        CellCorner far_first = { first->x + n0.x * reach, first->y + n0.y * reach, -1, first_from };
+        scratch->corners[0][count++] = far_end;
+        scratch->corners[0][count++] = far_mid;
+        scratch->corners[0][count++] = far_first;
     }
     
-    /* Remove triangles connected to super-triangle */
-    size_t j = 0;
-    while (j < *num_triangles) {
-        if (tris[j].p0 >= (int)num_points || 
-            tris[j].p1 >= (int)num_points || 
-            tris[j].p2 >= (int)num_points) {
-            tris[j] = tris[*num_triangles - 1];
-            (*num_triangles)--;
-        } else {
-            j++;
+    if (!corners_inside(b, scratch->corners[0], count)) {
+        static const int axes[4] = { 0, 0, 1, 1 };
+        static const double signs[4] = { 1.0, -1.0, 1.0, -1.0 };
+        for (int side = 0; side < 4 && count > 0; side++) {
+            if (!scratch_reserve(scratch, count * 2)) {
+                return -1;
+            }
+            double limit = axes[side] == 0 ? (signs[side] > 0 ? b->box_min.x : b->box_max.x)
+                                           : (signs[side] > 0 ? b->box_min.y : b->box_max.y);
+            count = clip_side(scratch->corners[0], count, scratch->corners[1], axes[side], limit, signs[side]);
+            CellCorner* swap = scratch->corners[0];
+            scratch->corners[0] = scratch->corners[1];
+            scratch->corners[1] = swap;
         }
     }
     
-    free(all_points);
+    count = merge_degenerate(b, scratch->corners[0], count);
+    if (count < 3) {
+        return 0;
+    }
+    
+    CellCorner* corners = scratch->corners[0];
+    double area = 0;
+    for (size_t i = 0; i < count; i++) {
+        const CellCorner* a = &corners[i];
+        const CellCorner* c = &corners[(i + 1) % count];
+        area += a->x * c->y - c->x * a->y;
+    }
+    if (area < 0) {
+        /* Reverse the corners; each edge's neighbor moves to the corner now starting it */
+        for (size_t i = 0, j = count - 1; i < j; i++, j--) {
+            CellCorner swap = corners[i];
+            corners[i] = corners[j];
+            corners[j] = swap;
+        }
+        int last_neighbor = corners[0].neighbor;
+        for (size_t i = 0; i + 1 < count; i++) {
+            corners[i].neighbor = corners[i + 1].neighbor;
+        }
+        corners[count - 1].neighbor = last_neighbor;
+    }
+    return (int)count;
 }
 
-/* Apply Lloyd relaxation to points */
-static void lloyd_relaxation(SylvesVector2* points, size_t num_points,
-                           const SylvesVoronoiGridOptions* options) {
-    Triangle* triangles = NULL;
-    size_t num_triangles = 0;
-    
-    /* Compute Delaunay triangulation */
-    triangulate(points, num_points, &triangles, &num_triangles);
-    
-    /* For each point, find its Voronoi cell centroid */
-    SylvesVector2* new_points = malloc(num_points * sizeof(SylvesVector2));
-    
-    for (size_t i = 0; i < num_points; i++) {
-        double cx = 0, cy = 0;
-        int count = 0;
+static SylvesVector2 cell_centroid(const CellCorner* corners, int count) {
+    double area = 0, cx = 0, cy = 0;
+    double mean_x = 0, mean_y = 0;
+    for (int i = 0; i < count; i++) {
+        const CellCorner* a = &corners[i];
+        const CellCorner* c = &corners[(i + 1) % count];
+        double cross = a->x * c->y - c->x * a->y;
+        area += cross;
+        cx += (a->x + c->x) * cross;
+        cy += (a->y + c->y) * cross;
+        mean_x += a->x;
+        mean_y += a->y;
+    }
+    if (fabs(area) <= DBL_EPSILON * (fabs(cx) + fabs(cy))) {
+        return (SylvesVector2){ mean_x / count, mean_y / count };
+    }
+    return (SylvesVector2){ cx / (3.0 * area), cy / (3.0 * area) };
+}
+
+static bool on_clip_border(const SylvesVoronoiGridOptions* options, SylvesVector2 p) {
+    double eps = 1e-6;
+    return fabs(p.x - options->clip_min->x) < eps ||
+           fabs(p.x - options->clip_max->x) < eps ||
+           fabs(p.y - options->clip_min->y) < eps ||
+           fabs(p.y - options->clip_max->y) < eps;
+}
+
+struct SylvesVoronoiRelaxer {
+    SylvesThreadPool* pool;
+    int worker_count;
+    VoronoiBuilder builder;
+    CellScratch* scratch;    /* One per worker */
+    SylvesVector2* moved;
+    size_t moved_capacity;
+};
+
+/* One step of Lloyd relaxation, the sites split across the workers in ranges */
+typedef struct {
+    SylvesVoronoiRelaxer* relaxer;
+    const SylvesVector2* points;
+    size_t num_points;
+    const SylvesVoronoiGridOptions* options;
+    double max_displacement[SYLVES_THREAD_POOL_MAX_WORKERS];
+    bool failed[SYLVES_THREAD_POOL_MAX_WORKERS];
+} RelaxStep;
+
+/*
+ * Move each site of the worker's range to the centroid of its cell.
+ * Without a clip box, hull cells are unbounded, so hull sites stay put.
+ */
+static void relax_step_task(int worker, int worker_count, void* user_data) {
+    RelaxStep* step = (RelaxStep*)user_data;
+    SylvesVoronoiRelaxer* r = step->relaxer;
+    const SylvesVoronoiGridOptions* options = step->options;
+    const SylvesVector2* points = step->points;
+    CellScratch* scratch = &r->scratch[worker];
+    bool clipped = options->clip_min && options->clip_max;
+    size_t begin = step->num_points * (size_t)worker / (size_t)worker_count;
+    size_t end = step->num_points * (size_t)(worker + 1) / (size_t)worker_count;
+    double max_displacement = 0;
+    
+    for (size_t i = begin; i < end; i++) {
+        SylvesVector2* moved = &r->moved[i];
+        *moved = points[i];
+        if (clipped ? options->pin_border_during_relaxation && on_clip_border(options, points[i])
+                    : builder_is_hull_site(&r->builder, (int)i)) {
+            continue;
+        }
         
-        /* Find all triangles adjacent to this point */
-        for (size_t j = 0; j < num_triangles; j++) {
-            if (triangles[j].p0 == (int)i || 
-                triangles[j].p1 == (int)i || 
-                triangles[j].p2 == (int)i) {
-                cx += triangles[j].cx;
-                cy += triangles[j].cy;
-                count++;
-            }
+        int count = build_cell(&r->builder, scratch, (int)i);
+        if (count < 0) {
+            step->failed[worker] = true;
+            return;
+        }
+        if (count == 0) {
+            continue;
         }
         
-        if (count > 0) {
-            new_points[i].x = cx / count;
-            new_points[i].y = cy / count;
-            
-            /* Apply clipping if specified */
-            if (options->clip_min && options->clip_max) {
-                if (new_points[i].x < options->clip_min->x) 
-                    new_points[i].x = options->clip_min->x;
-                if (new_points[i].y < options->clip_min->y) 
-                    new_points[i].y = options->clip_min->y;
-                if (new_points[i].x > options->clip_max->x) 
-                    new_points[i].x = options->clip_max->x;
-                if (new_points[i].y > options->clip_max->y) 
-                    new_points[i].y = options->clip_max->y;
-            }
-            
-            /* Pin border points if requested */
-            if (options->pin_border_during_relaxation && options->clip_min && options->clip_max) {
-                double eps = 1e-6;
-                bool on_border = (fabs(points[i].x - options->clip_min->x) < eps ||
-                                 fabs(points[i].x - options->clip_max->x) < eps ||
-                                 fabs(points[i].y - options->clip_min->y) < eps ||
-                                 fabs(points[i].y - options->clip_max->y) < eps);
-                if (on_border) {
-                    new_points[i] = points[i];
-                }
-            }
-        } else {
-            new_points[i] = points[i];
+        *moved = cell_centroid(scratch->corners[0], count);
+        if (clipped) {
+            moved->x = fmin(fmax(moved->x, options->clip_min->x), options->clip_max->x);
+            moved->y = fmin(fmax(moved->y, options->clip_min->y), options->clip_max->y);
+        }
+        double displacement = hypot(moved->x - points[i].x, moved->y - points[i].y);
+        if (displacement > max_displacement) {
+            max_displacement = displacement;
         }
     }
+    step->max_displacement[worker] = max_displacement;
+}
+
+/* The clip box, or without one a margin around the points that closes hull cells */
+static void builder_set_box_for(VoronoiBuilder* b, const SylvesVector2* points, size_t num_points,
+                                const SylvesVoronoiGridOptions* options) {
+    if (options->clip_min && options->clip_max) {
+        builder_set_box(b, *options->clip_min, *options->clip_max);
+        return;
+    }
     
-    /* Copy back */
-    memcpy(points, new_points, num_points * sizeof(SylvesVector2));
+    SylvesVector2 lo = points[0], hi = points[0];
+    for (size_t i = 1; i < num_points; i++) {
+        lo.x = fmin(lo.x, points[i].x);
+        lo.y = fmin(lo.y, points[i].y);
+        hi.x = fmax(hi.x, points[i].x);
+        hi.y = fmax(hi.y, points[i].y);
+    }
+    double margin = UNCLIPPED_MARGIN * fmax(hi.x - lo.x, hi.y - lo.y);
+    if (margin <= 0) {
+        margin = 1.0;
+    }
+    builder_set_box(b, (SylvesVector2){ lo.x - margin, lo.y - margin },
+                    (SylvesVector2){ hi.x + margin, hi.y + margin });
+}
+
+SylvesVoronoiRelaxer* sylves_voronoi_relaxer_create(int thread_count) {
+    SylvesVoronoiRelaxer* relaxer = (SylvesVoronoiRelaxer*)sylves_calloc(1, sizeof(SylvesVoronoiRelaxer));
+    if (!relaxer) {
+        return NULL;
+    }
     
-    free(new_points);
-    free(triangles);
+    relaxer->pool = sylves_thread_pool_create(thread_count);
+    if (relaxer->pool) {
+        relaxer->worker_count = sylves_thread_pool_size(relaxer->pool);
+        relaxer->scratch = (CellScratch*)sylves_calloc((size_t)relaxer->worker_count, sizeof(CellScratch));
+    }
+    if (!relaxer->scratch) {
+        sylves_voronoi_relaxer_destroy(relaxer);
+        return NULL;
+    }
+    return relaxer;
 }
 
-/* Create mesh data from Voronoi diagram */
-static SylvesMeshData* create_voronoi_mesh(const SylvesVector2* points, size_t num_points,
-                                          const SylvesVoronoiGridOptions* options) {
-    Triangle* triangles = NULL;
-    size_t num_triangles = 0;
+void sylves_voronoi_relaxer_destroy(SylvesVoronoiRelaxer* relaxer) {
+    if (!relaxer) {
+        return;
+    }
     
-    /* Compute Delaunay triangulation */
-    triangulate(points, num_points, &triangles, &num_triangles);
+    sylves_thread_pool_destroy(relaxer->pool);
+    if (relaxer->scratch) {
+        for (int i = 0; i < relaxer->worker_count; i++) {
+            scratch_destroy(&relaxer->scratch[i]);
+        }
+    }
+    builder_destroy(&relaxer->builder);
+    sylves_free(relaxer->scratch);
+    sylves_free(relaxer->moved);
+    sylves_free(relaxer);
+}
+
+SylvesError sylves_voronoi_relaxer_relax(SylvesVoronoiRelaxer* relaxer, SylvesVector2* points, size_t num_points,
+                                         const SylvesVoronoiGridOptions* options,
+                                         SylvesVoronoiRelaxStats* stats_out) {
+    if (!relaxer || !points || num_points < 3) {
+        return SYLVES_ERROR_INVALID_ARGUMENT;
+    }
     
-    /* Estimate mesh data size - worst case each point has as many vertices as triangles */
-    size_t max_vertices = num_triangles * 3;  /* Overestimate */
-    size_t max_faces = num_points;  /* One face per Voronoi cell */
+    SylvesVoronoiGridOptions default_opts = sylves_voronoi_grid_options_default();
+    if (!options) {
+        options = &default_opts;
+    }
     
-    /* Create mesh data */
-    SylvesMeshData* mesh_data = sylves_mesh_data_create(max_vertices, max_faces);
-    if (!mesh_data) {
-        free(triangles);
-        return NULL;
+    if (num_points > relaxer->moved_capacity) {
+        SylvesVector2* moved = (SylvesVector2*)sylves_realloc(relaxer->moved, num_points * sizeof(SylvesVector2));
+        if (!moved) {
+            return SYLVES_ERROR_OUT_OF_MEMORY;
+        }
+        relaxer->moved = moved;
+        relaxer->moved_capacity = num_points;
     }
     
-    /* Track actual vertex count */
-    size_t total_vertices = 0;
+    VoronoiBuilder* b = &relaxer->builder;
+    builder_set_box_for(b, points, num_points, options);
     
-    /* For each point, create its Voronoi cell */
-    for (size_t i = 0; i < num_points; i++) {
-        /* Collect circumcenters of adjacent triangles */
-        SylvesVector3* cell_vertices = NULL;
-        size_t num_verts = 0;
-        size_t vert_capacity = 10;
-        cell_vertices = malloc(vert_capacity * sizeof(SylvesVector3));
+    SylvesVoronoiRelaxStats stats = { 0, 0, 0, 0 };
+    SylvesError err = SYLVES_SUCCESS;
+    for (int i = 0; i < options->lloyd_relaxation_iterations; i++) {
+        /* Only the first iteration of a run starts over; later ones move the same sites */
+        if (!builder_triangulate(b, points, num_points, i > 0)) {
+            err = SYLVES_ERROR_OUT_OF_MEMORY;
+            break;
+        }
+        if (b->delaunay->num_triangles == 0) {
+            /* Collinear sites have no cells to move towards */
+            break;
+        }
+        if (b->rebuilt) {
+            stats.full_rebuilds++;
+        } else {
+            stats.incremental_updates++;
+        }
         
-        /* Find all triangles adjacent to this point */
-        for (size_t j = 0; j < num_triangles; j++) {
-            if (triangles[j].p0 == (int)i || 
-                triangles[j].p1 == (int)i || 
-                triangles[j].p2 == (int)i) {
-                
-                /* Add circumcenter as vertex */
-                if (num_verts >= vert_capacity) {
-                    vert_capacity *= 2;
-                    cell_vertices = realloc(cell_vertices, vert_capacity * sizeof(SylvesVector3));
-                }
-                
-                cell_vertices[num_verts].x = triangles[j].cx;
-                cell_vertices[num_verts].y = triangles[j].cy;
-                cell_vertices[num_verts].z = 0;
-                
-                /* Apply clipping if needed */
-                if (options->clip_min && options->clip_max) {
-                    if (cell_vertices[num_verts].x < options->clip_min->x)
-                        cell_vertices[num_verts].x = options->clip_min->x;
-                    if (cell_vertices[num_verts].y < options->clip_min->y)
-                        cell_vertices[num_verts].y = options->clip_min->y;
-                    if (cell_vertices[num_verts].x > options->clip_max->x)
-                        cell_vertices[num_verts].x = options->clip_max->x;
-                    if (cell_vertices[num_verts].y > options->clip_max->y)
-                        cell_vertices[num_verts].y = options->clip_max->y;
-                }
-                
-                num_verts++;
+        RelaxStep step;
+        memset(&step, 0, sizeof(step));
+        step.relaxer = relaxer;
+        step.points = points;
+        step.num_points = num_points;
+        step.options = options;
+        sylves_thread_pool_run(relaxer->pool, relax_step_task, &step);
+        
+        stats.max_displacement = 0;
+        for (int w = 0; w < relaxer->worker_count; w++) {
+            if (step.failed[w]) {
+                err = SYLVES_ERROR_OUT_OF_MEMORY;
             }
+            stats.max_displacement = fmax(stats.max_displacement, step.max_displacement[w]);
+        }
+        if (err != SYLVES_SUCCESS) {
+            break;
         }
         
-        /* Sort vertices by angle to create proper polygon */
-        if (num_verts > 0) {
-            double cx = points[i].x;
-            double cy = points[i].y;
-            
-            /* Simple bubble sort by angle */
-            for (size_t j = 0; j < num_verts - 1; j++) {
-                for (size_t k = j + 1; k < num_verts; k++) {
-                    double angle1 = atan2(cell_vertices[j].y - cy, cell_vertices[j].x - cx);
-                    double angle2 = atan2(cell_vertices[k].y - cy, cell_vertices[k].x - cx);
-                    if (angle2 < angle1) {
-                        SylvesVector3 temp = cell_vertices[j];
-                        cell_vertices[j] = cell_vertices[k];
-                        cell_vertices[k] = temp;
-                    }
-                }
+        memcpy(points, relaxer->moved, num_points * sizeof(SylvesVector2));
+        stats.iterations++;
+        if (options->relaxation_tolerance > 0 && stats.max_displacement <= options->relaxation_tolerance) {
+            break;
+        }
+    }
+    
+    if (stats_out) {
+        *stats_out = stats;
+    }
+    return err;
+}
+
+/*
+ * Create mesh data from the Voronoi diagram. Corners at unclipped
+ * circumcenters are shared between the cells meeting there, and neighbors
+ * come straight from the triangulation, so no adjacency search is needed.
+ */
+static SylvesMeshData* create_voronoi_mesh(VoronoiBuilder* b, CellScratch* scratch,
+                                          const SylvesVector2* points, size_t num_points, bool moved) {
+    if (!builder_triangulate(b, points, num_points, moved) || b->delaunay->num_triangles == 0) {
+        /* Collinear sites have no triangulation to take the dual of */
+        return NULL;
+    }
+    
+    /* Build every cell first, so that neighbors can be named by face index */
+    int* face_of = (int*)sylves_alloc(num_points * sizeof(int));
+    size_t* starts = (size_t*)sylves_alloc((num_points + 1) * sizeof(size_t));
+    int* tri_vertex = (int*)sylves_alloc(b->delaunay->num_triangles * sizeof(int));
+    CellCorner* corners = NULL;
+    size_t corner_count = 0;
+    size_t corner_capacity = 0;
+    size_t face_count = 0;
+    SylvesMeshData* mesh_data = NULL;
+    bool ok = face_of && starts && tri_vertex;
+    
+    for (size_t i = 0; ok && i < num_points; i++) {
+        int count = build_cell(b, scratch, (int)i);
+        if (count < 0) {
+            ok = false;
+            break;
+        }
+        face_of[i] = count > 0 ? (int)face_count : -1;
+        if (count == 0) {
+            continue;
+        }
+        
+        if (corner_count + (size_t)count > corner_capacity) {
+            size_t capacity = corner_capacity > 0 ? corner_capacity * 2 : num_points * 8;
+            while (capacity < corner_count + (size_t)count) {
+                capacity *= 2;
+            }
+            CellCorner* grown = (CellCorner*)sylves_realloc(corners, capacity * sizeof(CellCorner));
+            if (!grown) {
+                ok = false;
+                break;
             }
+            corners = grown;
+            corner_capacity = capacity;
+        }
+        memcpy(&corners[corner_count], scratch->corners[0], (size_t)count * sizeof(CellCorner));
+        starts[face_count++] = corner_count;
+        corner_count += (size_t)count;
+    }
+    
+    if (ok && face_count > 0) {
+        starts[face_count] = corner_count;
+        mesh_data = sylves_mesh_data_create(corner_count, face_count);
+    }
+    
+    if (mesh_data) {
+        memset(tri_vertex, -1, b->delaunay->num_triangles * sizeof(int));
+        size_t vertex_count = 0;
+        for (size_t f = 0; f < face_count; f++) {
+            SylvesMeshFace* face = &mesh_data->faces[f];
+            int count = (int)(starts[f + 1] - starts[f]);
+            face->vertices = (int*)sylves_alloc(count * sizeof(int));
+            face->neighbors = (int*)sylves_alloc(count * sizeof(int));
+            if (!face->vertices || !face->neighbors) {
+                sylves_mesh_data_destroy(mesh_data);
+                mesh_data = NULL;
+                break;
+            }
+            face->vertex_count = count;
             
-            /* TODO: Add face to mesh - need to implement proper face creation */
-            /* For now, just store vertices */
-            if (total_vertices + num_verts <= mesh_data->vertex_count) {
-                for (size_t j = 0; j < num_verts; j++) {
-                    mesh_data->vertices[total_vertices + j] = cell_vertices[j];
-                }
-                
-                /* Create face */
-                if (i < mesh_data->face_count) {
-                    mesh_data->faces[i].vertex_count = num_verts;
-                    mesh_data->faces[i].vertices = malloc(num_verts * sizeof(int));
-                    mesh_data->faces[i].neighbors = malloc(num_verts * sizeof(int));
-                    for (size_t j = 0; j < num_verts; j++) {
-                        mesh_data->faces[i].vertices[j] = total_vertices + j;
-                        mesh_data->faces[i].neighbors[j] = -1;  /* No neighbors for now */
+            for (int k = 0; k < count; k++) {
+                const CellCorner* c = &corners[starts[f] + k];
+                int v = c->tri >= 0 ? tri_vertex[c->tri] : -1;
+                if (v < 0) {
+                    v = (int)vertex_count++;
+                    mesh_data->vertices[v] = (SylvesVector3){ c->x, c->y, 0 };
+                    if (c->tri >= 0) {
+                        tri_vertex[c->tri] = v;
                     }
                 }
-                
-                total_vertices += num_verts;
+                face->vertices[k] = v;
+                face->neighbors[k] = c->neighbor >= 0 ? face_of[c->neighbor] : -1;
             }
         }
-        
-        free(cell_vertices);
+        if (mesh_data) {
+            mesh_data->vertex_count = vertex_count;
+        }
     }
     
-    free(triangles);
+    sylves_free(face_of);
+    sylves_free(starts);
+    sylves_free(tri_vertex);
+    sylves_free(corners);
     return mesh_data;
 }
 
@@ -369,14 +679,17 @@ SylvesVoronoiGridOptions sylves_voronoi_grid_options_default(void) {
         .clip_min = NULL,
         .clip_max = NULL,
         .lloyd_relaxation_iterations = 0,
-        .pin_border_during_relaxation = true
+        .pin_border_during_relaxation = true,
+        .relaxation_tolerance = 0,
+        .relaxation_thread_count = 1
     };
     return options;
 }
 
-SylvesGrid* sylves_voronoi_grid_create(const SylvesVector2* points, size_t num_points,
-                                      const SylvesVoronoiGridOptions* options) {
-    if (!points || num_points < 3) {
+SylvesGrid* sylves_voronoi_grid_create_with_relaxer(SylvesVoronoiRelaxer* relaxer,
+                                                   const SylvesVector2* points, size_t num_points,
+                                                   const SylvesVoronoiGridOptions* options) {
+    if (!relaxer || !points || num_points < 3) {
         return NULL;
     }
     
@@ -387,17 +700,21 @@ SylvesGrid* sylves_voronoi_grid_create(const SylvesVector2* points, size_t num_p
     }
     
     /* Copy points for modification */
-    SylvesVector2* work_points = malloc(num_points * sizeof(SylvesVector2));
+    SylvesVector2* work_points = (SylvesVector2*)sylves_alloc(num_points * sizeof(SylvesVector2));
+    if (!work_points) {
+        return NULL;
+    }
     memcpy(work_points, points, num_points * sizeof(SylvesVector2));
     
     /* Apply Lloyd relaxation if requested */
-    for (int i = 0; i < options->lloyd_relaxation_iterations; i++) {
-        lloyd_relaxation(work_points, num_points, options);
-    }
+    SylvesVoronoiRelaxStats stats = { 0, 0, 0, 0 };
+    SylvesError err = sylves_voronoi_relaxer_relax(relaxer, work_points, num_points, options, &stats);
     
-    /* Create mesh data */
-    SylvesMeshData* mesh_data = create_voronoi_mesh(work_points, num_points, options);
-    free(work_points);
+    /* Create mesh data, repairing the last relaxation's triangulation if there was one */
+    SylvesMeshData* mesh_data = err == SYLVES_SUCCESS ?
+        create_voronoi_mesh(&relaxer->builder, &relaxer->scratch[0], work_points, num_points, stats.iterations > 0) :
+        NULL;
+    sylves_free(work_points);
     
     if (!mesh_data) {
         return NULL;
@@ -409,3 +726,26 @@ SylvesGrid* sylves_voronoi_grid_create(const SylvesVector2* points, size_t num_p
     
     return grid;
 }
+
+SylvesGrid* sylves_voronoi_grid_create(const SylvesVector2* points, size_t num_points,
+                                      const SylvesVoronoiGridOptions* options) {
+    if (!points || num_points < 3) {
+        return NULL;
+    }
+    
+    SylvesVoronoiGridOptions default_opts = sylves_voronoi_grid_options_default();
+    if (!options) {
+        options = &default_opts;
+    }
+    
+    /* Workers only pay off when there is relaxation to spread over them */
+    SylvesVoronoiRelaxer* relaxer = sylves_voronoi_relaxer_create(
+        options->lloyd_relaxation_iterations > 0 ? options->relaxation_thread_count : 1);
+    if (!relaxer) {
+        return NULL;
+    }
+    
+    SylvesGrid* grid = sylves_voronoi_grid_create_with_relaxer(relaxer, points, num_points, options);
+    sylves_voronoi_relaxer_destroy(relaxer);
+    return grid;
+}
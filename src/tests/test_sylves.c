@@ -4,9 +4,27 @@
  */
 
 #include <sylves/sylves.h>
+#include <sylves/spatial_index.h>
+#include <sylves/cache.h>
+#include <sylves/memory_pool.h>
+#include <sylves/planar_lazy_mesh_grid.h>
+#include <sylves/voronoi_grid.h>
+#include <pthread.h>
+#include <stdlib.h>
 #include <stdio.h>
 #include <assert.h>
 #include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include <float.h>
+
+/* Like assert, but evaluated and checked in release builds too */
+#define CHECK(expr) do { \
+    if (!(expr)) { \
+        fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #expr); \
+        abort(); \
+    } \
+} while (0)
 
 void test_square_grid_basic() {
     printf("Testing square grid basic operations...\n");
@@ -289,6 +307,2161 @@ void test_find_basic_path() {
     printf("  find_basic_path: PASSED\n");
 }
 
+static void check_batch_matches_single(SylvesGrid* grid, int dir_count) {
+    SylvesCell cells[64];
+    SylvesCellDir dirs[64];
+    size_t n = 0;
+    for (int x = -2; x <= 2 && n < 64; x++) {
+        for (int d = -1; d <= dir_count && n < 64; d++) {
+            cells[n] = sylves_cell_create_2d(x, 1 - x);
+            dirs[n] = d;
+            n++;
+        }
+    }
+    SylvesCell dests[64];
+    SylvesCellDir inv[64];
+    SylvesConnection conns[64];
+    bool ok[64];
+    int moved = sylves_grid_try_move_batch(grid, cells, dirs, n, dests, inv, conns, ok);
+    int expected = 0;
+    for (size_t i = 0; i < n; i++) {
+        SylvesCell dest;
+        SylvesCellDir inverse_dir;
+        SylvesConnection connection;
+        bool single = sylves_grid_try_move(grid, cells[i], dirs[i], &dest, &inverse_dir, &connection);
+        CHECK(single == ok[i]);
+        if (single) {
+            CHECK(dest.x == dests[i].x && dest.y == dests[i].y && dest.z == dests[i].z);
+            CHECK(inverse_dir == inv[i]);
+            CHECK(connection.is_mirror == conns[i].is_mirror);
+            expected++;
+        }
+    }
+    CHECK(moved == expected);
+    /* Optional outputs may be omitted */
+    CHECK(sylves_grid_try_move_batch(grid, cells, dirs, n, NULL, NULL, NULL, NULL) == expected);
+}
+
+static bool batch_mask_even(SylvesCell cell, void* user_data) {
+    (void)user_data;
+    return ((cell.x + cell.y) & 1) == 0 || cell.x == 0;
+}
+
+void test_try_move_batch() {
+    printf("Testing batched try_move...\n");
+
+    SylvesGrid* square = sylves_square_grid_create(1.0);
+    check_batch_matches_single(square, 4);
+    SylvesGrid* bounded = sylves_square_grid_create_bounded(1.0, -1, -1, 1, 1);
+    check_batch_matches_single(bounded, 4);
+
+    SylvesGrid* hex = sylves_hex_grid_create_bounded(SYLVES_HEX_ORIENTATION_FLAT_TOP, 1.0, -1, -1, 2, 2);
+    check_batch_matches_single(hex, 6);
+
+    SylvesGrid* tri = sylves_triangle_grid_create(1.0, SYLVES_TRIANGLE_ORIENTATION_FLAT_SIDES);
+    check_batch_matches_single(tri, 6);
+
+    SylvesGrid* cube = sylves_cube_grid_create_bounded(1.0, -2, -2, 0, 2, 2, 0);
+    check_batch_matches_single(cube, 6);
+
+    SylvesGrid* mask = sylves_mask_modifier_create(bounded, batch_mask_even, NULL, NULL, 0);
+    check_batch_matches_single(mask, 4);
+
+    SylvesCell c = sylves_cell_create_2d(0, 0);
+    SylvesCellDir d = 0;
+    CHECK(sylves_grid_try_move_batch(NULL, &c, &d, 1, NULL, NULL, NULL, NULL) == SYLVES_ERROR_NULL_POINTER);
+    CHECK(sylves_grid_try_move_batch(square, &c, &d, 0, NULL, NULL, NULL, NULL) == 0);
+
+    sylves_grid_destroy(mask);
+    sylves_grid_destroy(cube);
+    sylves_grid_destroy(tri);
+    sylves_grid_destroy(hex);
+    sylves_grid_destroy(bounded);
+    sylves_grid_destroy(square);
+    printf("  try_move_batch: PASSED\n");
+}
+
+static void check_soa_matches_single(SylvesGrid* grid, int corner_count, bool is_3d) {
+    SylvesCellBuffer* buf = sylves_cell_buffer_create(0);
+    CHECK(buf != NULL);
+    for (int x = -5; x <= 5; x++) {
+        for (int y = -5; y <= 5; y++) {
+            SylvesCell c = { x, y, is_3d ? x - y : 0 };
+            CHECK(sylves_cell_buffer_push(buf, c) == SYLVES_SUCCESS);
+        }
+    }
+    CHECK(((uintptr_t)buf->x % SYLVES_CELL_BUFFER_ALIGNMENT) == 0);
+
+    double xs[121], ys[121], zs[121];
+    CHECK(sylves_grid_get_cell_centers_soa(grid, buf, xs, ys, zs) == (int)buf->count);
+    for (size_t i = 0; i < buf->count; i++) {
+        SylvesVector3 p = sylves_grid_get_cell_center(grid, sylves_cell_buffer_get(buf, i));
+        CHECK(fabs(p.x - xs[i]) < 1e-9 && fabs(p.y - ys[i]) < 1e-9 && fabs(p.z - zs[i]) < 1e-9);
+    }
+    for (int k = 0; k < corner_count; k++) {
+        CHECK(sylves_grid_get_cell_corners_soa(grid, buf, k, xs, ys, zs) == (int)buf->count);
+        for (size_t i = 0; i < buf->count; i++) {
+            SylvesVector3 p = sylves_grid_get_cell_corner(grid, sylves_cell_buffer_get(buf, i), k);
+            CHECK(fabs(p.x - xs[i]) < 1e-9 && fabs(p.y - ys[i]) < 1e-9 && fabs(p.z - zs[i]) < 1e-9);
+        }
+    }
+    sylves_cell_buffer_destroy(buf);
+}
+
+void test_cell_buffer_soa() {
+    printf("Testing struct-of-arrays cell positions...\n");
+
+    SylvesGrid* square = sylves_square_grid_create(2.0);
+    check_soa_matches_single(square, 4, false);
+    SylvesGrid* flat = sylves_hex_grid_create(SYLVES_HEX_ORIENTATION_FLAT_TOP, 1.5);
+    check_soa_matches_single(flat, 6, false);
+    SylvesGrid* pointy = sylves_hex_grid_create(SYLVES_HEX_ORIENTATION_POINTY_TOP, 1.0);
+    check_soa_matches_single(pointy, 6, false);
+    SylvesGrid* cube = sylves_cube_grid_create_anisotropic(1.0, 2.0, 3.0);
+    check_soa_matches_single(cube, 8, true);
+
+    /* Triangle corners follow get_polygon vertex order */
+    SylvesGrid* tri = sylves_triangle_grid_create(1.0, SYLVES_TRIANGLE_ORIENTATION_FLAT_TOPPED);
+    check_soa_matches_single(tri, 3, false);
+    SylvesCell cells[2] = { { 1, 1, 0 }, { 1, 0, 0 } };
+    SylvesCellBuffer* buf = sylves_cell_buffer_create(2);
+    CHECK(sylves_cell_buffer_append(buf, cells, 2) == SYLVES_SUCCESS);
+    double xs[2], ys[2], zs[2];
+    for (int k = 0; k < 3; k++) {
+        CHECK(sylves_grid_get_cell_corners_soa(tri, buf, k, xs, ys, zs) == 2);
+        for (int i = 0; i < 2; i++) {
+            SylvesVector3 poly[3];
+            CHECK(sylves_grid_get_polygon(tri, cells[i], poly, 3) == 3);
+            CHECK(fabs(poly[k].x - xs[i]) < 1e-9 && fabs(poly[k].y - ys[i]) < 1e-9);
+        }
+    }
+    sylves_cell_buffer_destroy(buf);
+
+    sylves_grid_destroy(tri);
+    sylves_grid_destroy(cube);
+    sylves_grid_destroy(pointy);
+    sylves_grid_destroy(flat);
+    sylves_grid_destroy(square);
+    printf("  cell_buffer_soa: PASSED\n");
+}
+
+/* Races other threads to the first spatial query, which builds the face BVH */
+static void* mesh_grid_first_query(void* arg) {
+    const SylvesGrid* grid = (const SylvesGrid*)arg;
+    SylvesCell cell;
+    for (int i = 0; i < 20; i++) {
+        if (!sylves_grid_find_cell(grid, sylves_vector3_create(i + 0.5, 3.5, 0.0), &cell) ||
+            cell.x != 3 * 20 + i) {
+            return arg;
+        }
+    }
+    return NULL;
+}
+
+void test_mesh_grid_spatial() {
+    printf("Testing mesh grid spatial queries...\n");
+
+    /* 20x20 unit quads; face index = y * 20 + x */
+    enum { N = 20 };
+    SylvesVector3 verts[(N + 1) * (N + 1)];
+    int indices[N * N * 4];
+    int sizes[N * N];
+    for (int y = 0; y <= N; y++) {
+        for (int x = 0; x <= N; x++) {
+            verts[y * (N + 1) + x] = sylves_vector3_create(x, y, 0.0);
+        }
+    }
+    for (int y = 0; y < N; y++) {
+        for (int x = 0; x < N; x++) {
+            int f = y * N + x;
+            int v = y * (N + 1) + x;
+            indices[f * 4 + 0] = v;
+            indices[f * 4 + 1] = v + 1;
+            indices[f * 4 + 2] = v + N + 2;
+            indices[f * 4 + 3] = v + N + 1;
+            sizes[f] = 4;
+        }
+    }
+    SylvesGrid* grid = sylves_mesh_grid_create_from_arrays(verts, (N + 1) * (N + 1), indices, sizes, N * N);
+    CHECK(grid != NULL);
+
+    /* Concurrent first queries share one BVH */
+    pthread_t threads[4];
+    for (int t = 0; t < 4; t++) {
+        CHECK(pthread_create(&threads[t], NULL, mesh_grid_first_query, grid) == 0);
+    }
+    for (int t = 0; t < 4; t++) {
+        void* failed;
+        pthread_join(threads[t], &failed);
+        CHECK(failed == NULL);
+    }
+
+    SylvesCell cell;
+    for (int i = 0; i < 200; i++) {
+        int cx = i * 7 % N, cy = i * 13 % N;
+        double px = cx + 0.05 + (i % 10) * 0.09, py = cy + 0.95 - (i % 7) * 0.12;
+        CHECK(sylves_grid_find_cell(grid, sylves_vector3_create(px, py, 0.0), &cell));
+        CHECK(cell.x == cy * N + cx);
+    }
+    /* Shared edges resolve to the lowest face index */
+    CHECK(sylves_grid_find_cell(grid, sylves_vector3_create(3.0, 4.5, 0.0), &cell) && cell.x == 4 * N + 2);
+    CHECK(!sylves_grid_find_cell(grid, sylves_vector3_create(-0.5, 3.0, 0.0), &cell));
+    CHECK(!sylves_grid_find_cell(grid, sylves_vector3_create(4.0, 20.5, 0.0), &cell));
+
+    /* Boxes touching a face's boundary do not select it, as for square grids */
+    SylvesCell found[16];
+    CHECK(sylves_grid_get_cells_in_aabb(grid, sylves_vector3_create(2, 3, 0),
+                                         sylves_vector3_create(4, 5, 0), found, 16) == 4);
+    CHECK(sylves_grid_get_cells_in_aabb(grid, sylves_vector3_create(2.5, 3.5, 0),
+                                         sylves_vector3_create(4.5, 5.5, 0), found, 16) == 9);
+    CHECK(sylves_grid_get_cells_in_aabb(grid, sylves_vector3_create(30, 30, 0),
+                                         sylves_vector3_create(40, 40, 0), found, 16) == 0);
+
+    /* Ray along a row enters each cell through its left edge (dir 3) */
+    SylvesRaycastInfo hits[32];
+    int n = sylves_grid_raycast(grid, sylves_vector3_create(-2.0, 7.5, 0.0),
+                                sylves_vector3_create(2.0, 0.0, 0.0), 6.5, hits, 32);
+    CHECK(n == 5);
+    for (int i = 0; i < n; i++) {
+        CHECK(hits[i].cell.x == 7 * N + i);
+        CHECK(fabs(hits[i].distance - (2.0 + i)) < 1e-9);
+        CHECK(hits[i].face == 3);
+    }
+    n = sylves_grid_raycast(grid, sylves_vector3_create(0.5, 0.5, 0.0),
+                            sylves_vector3_create(0.0, 1.0, 0.0), 100.0, hits, 3);
+    CHECK(n == 3 && hits[0].cell.x == 0 && hits[0].distance == 0.0 && hits[2].cell.x == 2 * N);
+    sylves_grid_destroy(grid);
+
+    /* Non-flat mesh: a vertical quad in the xz plane */
+    SylvesVector3 wall[4] = { {0, 0, 0}, {2, 0, 0}, {2, 0, 2}, {0, 0, 2} };
+    int wall_indices[4] = { 0, 1, 2, 3 };
+    int wall_sizes[1] = { 4 };
+    SylvesGrid* vertical = sylves_mesh_grid_create_from_arrays(wall, 4, wall_indices, wall_sizes, 1);
+    CHECK(vertical != NULL);
+    CHECK(sylves_grid_find_cell(vertical, sylves_vector3_create(1.0, 0.0, 1.5), &cell) && cell.x == 0);
+    CHECK(!sylves_grid_find_cell(vertical, sylves_vector3_create(1.0, 0.5, 1.5), &cell));
+    n = sylves_grid_raycast(vertical, sylves_vector3_create(1.0, -3.0, 1.0),
+                            sylves_vector3_create(0.0, 1.0, 0.0), 10.0, hits, 4);
+    CHECK(n == 1 && fabs(hits[0].distance - 3.0) < 1e-9 && fabs(hits[0].point.y) < 1e-9);
+    sylves_grid_destroy(vertical);
+    printf("  mesh_grid_spatial: PASSED\n");
+}
+
+/* Checks every cell of a Voronoi grid, returning the spread (max / min) of cell areas */
+static double check_voronoi_cells(const SylvesGrid* grid, int cell_count, double total_area) {
+    double sum = 0, smallest = DBL_MAX, largest = 0;
+    SylvesVector3 poly[64];
+    for (int i = 0; i < cell_count; i++) {
+        SylvesCell cell = { i, 0, 0 };
+        int n = sylves_grid_get_polygon(grid, cell, poly, 64);
+        CHECK(n >= 3);
+        double area = 0;
+        for (int k = 0; k < n; k++) {
+            area += poly[k].x * poly[(k + 1) % n].y - poly[(k + 1) % n].x * poly[k].y;
+        }
+        area /= 2;
+        CHECK(area > 0); /* Counter-clockwise */
+        sum += area;
+        if (area < smallest) smallest = area;
+        if (area > largest) largest = area;
+
+        /* Neighbors come in pairs */
+        for (int dir = 0; dir < n; dir++) {
+            SylvesCell dest, back;
+            SylvesCellDir inverse;
+            if (sylves_grid_try_move(grid, cell, dir, &dest, &inverse, NULL)) {
+                CHECK(sylves_grid_try_move(grid, dest, inverse, &back, NULL, NULL));
+                CHECK(back.x == i);
+            }
+        }
+    }
+    CHECK(!sylves_grid_is_cell_in_grid(grid, (SylvesCell){ cell_count, 0, 0 }));
+    if (total_area > 0) {
+        CHECK(fabs(sum - total_area) < 1e-6 * total_area);
+    }
+    return largest / smallest;
+}
+
+void test_voronoi_grid() {
+    printf("Testing Voronoi grid...\n");
+
+    /* Jittered 20x20 lattice in a 10x10 box */
+    enum { SIDE = 20, COUNT = SIDE * SIDE };
+    SylvesVector2 points[COUNT];
+    unsigned seed = 7;
+    for (int i = 0; i < COUNT; i++) {
+        seed = seed * 1103515245u + 12345u;
+        double jx = ((seed >> 8) & 0xFFFF) / 65536.0;
+        seed = seed * 1103515245u + 12345u;
+        double jy = ((seed >> 8) & 0xFFFF) / 65536.0;
+        points[i] = (SylvesVector2){ (i % SIDE + 0.1 + 0.8 * jx) * 0.5, (i / SIDE + 0.1 + 0.8 * jy) * 0.5 };
+    }
+
+    /* Triangulations can be rebuilt in place, here with fewer points */
+    SylvesDelaunay* delaunay = sylves_delaunay_create(points, COUNT, NULL);
+    CHECK(delaunay != NULL);
+    int* triangles = delaunay->triangles;
+    CHECK(sylves_delaunay_update(delaunay, points + 100, COUNT - 100) == SYLVES_SUCCESS);
+    CHECK(delaunay->triangles == triangles);
+    CHECK(delaunay->num_triangles > 0 && delaunay->num_triangles <= 2 * (COUNT - 100) - 5);
+    for (int e = 0; e < (int)delaunay->num_triangles * 3; e++) {
+        int twin = delaunay->halfedges[e];
+        CHECK(twin == -1 || delaunay->halfedges[twin] == e);
+    }
+    CHECK(sylves_delaunay_update(delaunay, points, 2) == SYLVES_ERROR_INVALID_ARGUMENT);
+    sylves_delaunay_destroy(delaunay);
+
+    /* Clipped cells tile the box exactly */
+    SylvesVector2 lo = { 0, 0 }, hi = { 10, 10 };
+    SylvesVoronoiGridOptions options = sylves_voronoi_grid_options_default();
+    options.clip_min = &lo;
+    options.clip_max = &hi;
+    SylvesGrid* grid = sylves_voronoi_grid_create(points, COUNT, &options);
+    CHECK(grid != NULL);
+    double raw_spread = check_voronoi_cells(grid, COUNT, 100.0);
+    SylvesCell cell;
+    CHECK(sylves_grid_find_cell(grid, sylves_vector3_create(points[42].x, points[42].y, 0), &cell));
+    CHECK(cell.x == 42);
+    sylves_grid_destroy(grid);
+
+    /* Relaxation evens the cells out */
+    options.lloyd_relaxation_iterations = 10;
+    grid = sylves_voronoi_grid_create(points, COUNT, &options);
+    CHECK(grid != NULL);
+    double relaxed_spread = check_voronoi_cells(grid, COUNT, 100.0);
+    CHECK(relaxed_spread < raw_spread);
+    sylves_grid_destroy(grid);
+
+    /* Without a clip box, hull cells are closed around the points */
+    options = sylves_voronoi_grid_options_default();
+    options.lloyd_relaxation_iterations = 3;
+    grid = sylves_voronoi_grid_create(points, COUNT, &options);
+    CHECK(grid != NULL);
+    check_voronoi_cells(grid, COUNT, 0);
+    sylves_grid_destroy(grid);
+
+    /* A duplicate site gets no cell; collinear sites give no grid */
+    SylvesVector2 square[5] = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 }, { 1, 1 } };
+    grid = sylves_voronoi_grid_create(square, 5, NULL);
+    CHECK(grid != NULL);
+    check_voronoi_cells(grid, 4, 0);
+    sylves_grid_destroy(grid);
+    SylvesVector2 line[4] = { { 0, 0 }, { 1, 1 }, { 2, 2 }, { 3, 3 } };
+    CHECK(sylves_voronoi_grid_create(line, 4, NULL) == NULL);
+    printf("  voronoi_grid: PASSED\n");
+}
+
+/* Checks halfedge twins, that no triangle is turned over, and that every edge is locally Delaunay */
+static void check_delaunay(const SylvesDelaunay* d) {
+    const float* c = d->coords;
+    for (int e = 0; e < (int)d->num_triangles * 3; e++) {
+        int twin = d->halfedges[e];
+        if (e % 3 == 0) {
+            int i = d->triangles[e], j = d->triangles[e + 1], k = d->triangles[e + 2];
+            CHECK(!sylves_orient2d(c[2 * i], c[2 * i + 1], c[2 * j], c[2 * j + 1], c[2 * k], c[2 * k + 1]));
+        }
+        if (twin == -1) continue;
+        CHECK(d->halfedges[twin] == e);
+        int p0 = d->triangles[sylves_delaunay_prev_halfedge(e)];
+        int pr = d->triangles[e];
+        int pl = d->triangles[sylves_delaunay_next_halfedge(e)];
+        int p1 = d->triangles[sylves_delaunay_prev_halfedge(twin)];
+        CHECK(!sylves_incircle(c[2 * p0], c[2 * p0 + 1], c[2 * pr], c[2 * pr + 1],
+                               c[2 * pl], c[2 * pl + 1], c[2 * p1], c[2 * p1 + 1]));
+    }
+}
+
+void test_voronoi_relaxation() {
+    printf("Testing Voronoi relaxation...\n");
+
+    enum { SIDE = 20, COUNT = SIDE * SIDE };
+    SylvesVector2 points[COUNT], moved[COUNT], relaxed[COUNT];
+    unsigned seed = 11;
+    for (int i = 0; i < COUNT; i++) {
+        seed = seed * 1103515245u + 12345u;
+        double jx = ((seed >> 8) & 0xFFFF) / 65536.0;
+        seed = seed * 1103515245u + 12345u;
+        double jy = ((seed >> 8) & 0xFFFF) / 65536.0;
+        points[i] = (SylvesVector2){ (i % SIDE + 0.1 + 0.8 * jx) * 0.5, (i / SIDE + 0.1 + 0.8 * jy) * 0.5 };
+    }
+
+    /*
+     * Small moves are repaired by flips; a point jumping across the set forces a rebuild.
+     * The outer ring stays put, as slivers along a lattice's hull fold at the slightest move.
+     */
+    SylvesDelaunay* delaunay = sylves_delaunay_create(points, COUNT, NULL);
+    CHECK(delaunay != NULL);
+    for (int i = 0; i < COUNT; i++) {
+        bool outer = i % SIDE == 0 || i % SIDE == SIDE - 1 || i / SIDE == 0 || i / SIDE == SIDE - 1;
+        double amount = outer ? 0 : 0.1;
+        moved[i] = (SylvesVector2){ points[i].x + amount * sin(i * 1.7), points[i].y + amount * cos(i * 2.3) };
+    }
+    bool rebuilt = true;
+    CHECK(sylves_delaunay_update_moved(delaunay, moved, &rebuilt) == SYLVES_SUCCESS);
+    CHECK(!rebuilt);
+    check_delaunay(delaunay);
+    moved[0] = (SylvesVector2){ 7.3, 6.1 };
+    CHECK(sylves_delaunay_update_moved(delaunay, moved, &rebuilt) == SYLVES_SUCCESS);
+    CHECK(rebuilt);
+    check_delaunay(delaunay);
+    sylves_delaunay_destroy(delaunay);
+
+    /* Later iterations repair the previous triangulation, and workers split the sites exactly */
+    SylvesVector2 lo = { 0, 0 }, hi = { 10, 10 };
+    SylvesVoronoiGridOptions options = sylves_voronoi_grid_options_default();
+    options.clip_min = &lo;
+    options.clip_max = &hi;
+    options.lloyd_relaxation_iterations = 30;
+    SylvesVoronoiRelaxer* relaxer = sylves_voronoi_relaxer_create(1);
+    CHECK(relaxer != NULL);
+    SylvesVoronoiRelaxStats stats;
+    memcpy(relaxed, points, sizeof(points));
+    CHECK(sylves_voronoi_relaxer_relax(relaxer, relaxed, COUNT, &options, &stats) == SYLVES_SUCCESS);
+    CHECK(stats.iterations == 30);
+    CHECK(stats.full_rebuilds >= 1 && stats.incremental_updates > 0);
+    CHECK(stats.full_rebuilds + stats.incremental_updates == 30);
+
+    SylvesVoronoiRelaxer* threaded = sylves_voronoi_relaxer_create(3);
+    CHECK(threaded != NULL);
+    memcpy(moved, points, sizeof(points));
+    CHECK(sylves_voronoi_relaxer_relax(threaded, moved, COUNT, &options, NULL) == SYLVES_SUCCESS);
+    CHECK(memcmp(moved, relaxed, sizeof(relaxed)) == 0);
+    sylves_voronoi_relaxer_destroy(threaded);
+
+    /* A tolerance ends the run once points settle */
+    options.lloyd_relaxation_iterations = 200;
+    options.relaxation_tolerance = 0.01;
+    memcpy(relaxed, points, sizeof(points));
+    CHECK(sylves_voronoi_relaxer_relax(relaxer, relaxed, COUNT, &options, &stats) == SYLVES_SUCCESS);
+    CHECK(stats.iterations > 1 && stats.iterations < 200);
+    CHECK(stats.max_displacement <= 0.01);
+
+    /* The relaxer is reused for grids */
+    SylvesGrid* grid = sylves_voronoi_grid_create_with_relaxer(relaxer, points, COUNT, &options);
+    CHECK(grid != NULL);
+    check_voronoi_cells(grid, COUNT, 100.0);
+    sylves_grid_destroy(grid);
+    sylves_voronoi_relaxer_destroy(relaxer);
+    printf("  voronoi_relaxation: PASSED\n");
+}
+
+typedef struct {
+    int count;
+    long long checksum;
+} SpatialCollect;
+
+static bool spatial_collect(const SylvesCell* cell, void* data, void* user_data) {
+    (void)data;
+    SpatialCollect* c = (SpatialCollect*)user_data;
+    c->count++;
+    c->checksum += (long long)cell->x * cell->x + 1;
+    return true;
+}
+
+static void check_spatial_queries(const SylvesSpatialIndex* index, const SylvesVector3* points,
+                                  const bool* live, int n) {
+    unsigned seed = 99;
+    for (int q = 0; q < 40; q++) {
+        seed = seed * 1103515245u + 12345u;
+        double qx = (seed >> 8) % 10000 / 100.0;
+        seed = seed * 1103515245u + 12345u;
+        double qy = (seed >> 8) % 10000 / 100.0;
+        double r = 0.5 + q % 8;
+
+        SylvesAabb box = { { qx - r, qy - r, -1.0 }, { qx + r, qy + r, 1.0 } };
+        SylvesVector3 center = { qx, qy, 0.0 };
+        SpatialCollect in_box = {0}, in_radius = {0}, expect_box = {0}, expect_radius = {0};
+        double nearest = INFINITY;
+        for (int i = 0; i < n; i++) {
+            if (!live[i]) continue;
+            SylvesCell cell = { i, 0, 0 };
+            double dx = points[i].x - qx, dy = points[i].y - qy;
+            if (sylves_aabb_contains_point(box, points[i])) spatial_collect(&cell, NULL, &expect_box);
+            if (dx * dx + dy * dy <= r * r) spatial_collect(&cell, NULL, &expect_radius);
+            if (sqrt(dx * dx + dy * dy) < nearest) nearest = sqrt(dx * dx + dy * dy);
+        }
+
+        CHECK(sylves_spatial_index_query_aabb(index, &box, spatial_collect, &in_box) == SYLVES_SUCCESS);
+        CHECK(in_box.count == expect_box.count && in_box.checksum == expect_box.checksum);
+        CHECK(sylves_spatial_index_query_radius(index, &center, r, spatial_collect, &in_radius) == SYLVES_SUCCESS);
+        CHECK(in_radius.count == expect_radius.count && in_radius.checksum == expect_radius.checksum);
+
+        SylvesCell found;
+        double distance;
+        CHECK(sylves_spatial_index_find_nearest(index, &center, &found, &distance) == SYLVES_SUCCESS);
+        CHECK(live[found.x] && fabs(distance - nearest) < 1e-12);
+    }
+}
+
+/* Chunk generator for the lazy grid tests: a row of ten unit quads */
+static SylvesMeshData* quad_row_chunk(int chunk_x, int chunk_y, void* user_data) {
+    (void)chunk_x;
+    (void)chunk_y;
+    (*(int*)user_data)++;
+    SylvesMeshData* mesh = sylves_mesh_data_create(22, 10);
+    if (!mesh) return NULL;
+    for (int i = 0; i <= 10; i++) {
+        mesh->vertices[i] = sylves_vector3_create(i, 0.0, 0.0);
+        mesh->vertices[11 + i] = sylves_vector3_create(i, 1.0, 0.0);
+    }
+    for (int f = 0; f < 10; f++) {
+        SylvesMeshFace* face = &mesh->faces[f];
+        face->vertex_count = 4;
+        face->vertices = (int*)sylves_alloc(sizeof(int) * 4);
+        face->neighbors = (int*)sylves_alloc(sizeof(int) * 4);
+        face->vertices[0] = f;
+        face->vertices[1] = f + 1;
+        face->vertices[2] = 12 + f;
+        face->vertices[3] = 11 + f;
+        for (int e = 0; e < 4; e++) face->neighbors[e] = -1;
+    }
+    return mesh;
+}
+
+static void touch_chunk(SylvesGrid* grid, int chunk_x) {
+    sylves_grid_get_cell_center(grid, sylves_cell_create(chunk_x * 10, 0, 0));
+}
+
+void test_lazy_grid_chunk_cache() {
+    printf("Testing lazy grid chunk cache...\n");
+    int generated = 0;
+    SylvesGrid* grid = sylves_planar_lazy_mesh_grid_create_square(quad_row_chunk, 10.0, 0.0, true, NULL, NULL,
+                                                                  SYLVES_CACHE_LRU, &generated);
+    CHECK(grid != NULL);
+    CHECK(sylves_planar_lazy_mesh_grid_set_cache_limits(grid, 3, 0) == SYLVES_SUCCESS);
+
+    /* Only the three most recently used chunks stay */
+    for (int c = 0; c < 5; c++) touch_chunk(grid, c);
+    SylvesCacheStats stats;
+    sylves_planar_lazy_mesh_grid_get_cache_stats(grid, &stats);
+    CHECK(generated == 5 && stats.total_entries == 3 && stats.miss_count == 5 && stats.eviction_count == 2);
+    CHECK(stats.memory_used > 0);
+    touch_chunk(grid, 2);
+    touch_chunk(grid, 5);     /* evicts 3, the least recently used */
+    touch_chunk(grid, 2);
+    touch_chunk(grid, 4);
+    CHECK(generated == 6);
+    touch_chunk(grid, 3);
+    CHECK(generated == 7);
+    sylves_planar_lazy_mesh_grid_get_cache_stats(grid, &stats);
+    CHECK(stats.hit_count == 3 && stats.miss_count == 7 && stats.eviction_count == 4);
+    CHECK(stats.hit_rate > 29.0 && stats.hit_rate < 31.0);
+
+    /* Pinned chunks survive any amount of churn and may exceed the limit */
+    SylvesCell chunk = sylves_planar_lazy_mesh_grid_get_chunk(grid, sylves_cell_create(17, 0, 0));
+    CHECK(chunk.x == 1 && chunk.y == 0);
+    CHECK(sylves_planar_lazy_mesh_grid_pin_chunk(grid, chunk) == SYLVES_SUCCESS);
+    CHECK(sylves_planar_lazy_mesh_grid_pin_chunk(grid, chunk) == SYLVES_SUCCESS);
+    CHECK(sylves_planar_lazy_mesh_grid_pin_chunk(grid, sylves_cell_create(2, 0, 0)) == SYLVES_SUCCESS);
+    CHECK(sylves_planar_lazy_mesh_grid_pin_chunk(grid, sylves_cell_create(3, 0, 0)) == SYLVES_SUCCESS);
+    for (int c = 6; c < 12; c++) touch_chunk(grid, c);
+    sylves_planar_lazy_mesh_grid_get_cache_stats(grid, &stats);
+    CHECK(stats.total_entries == 4);    /* three pinned plus the newest */
+    int before = generated;
+    touch_chunk(grid, 1);
+    touch_chunk(grid, 2);
+    touch_chunk(grid, 3);
+    CHECK(generated == before);
+    sylves_planar_lazy_mesh_grid_unpin_chunk(grid, chunk);
+    sylves_planar_lazy_mesh_grid_get_cache_stats(grid, &stats);
+    CHECK(stats.total_entries == 4);
+    sylves_planar_lazy_mesh_grid_unpin_chunk(grid, chunk);   /* last pin: back under the limit */
+    sylves_planar_lazy_mesh_grid_get_cache_stats(grid, &stats);
+    CHECK(stats.total_entries == 3);
+    sylves_planar_lazy_mesh_grid_unpin_chunk(grid, sylves_cell_create(2, 0, 0));
+    sylves_planar_lazy_mesh_grid_unpin_chunk(grid, sylves_cell_create(3, 0, 0));
+    sylves_planar_lazy_mesh_grid_unpin_chunk(grid, sylves_cell_create(3, 0, 0));   /* unbalanced: ignored */
+    before = generated;
+    touch_chunk(grid, 1);
+    CHECK(generated == before);
+
+    /* A byte budget bounds the cache the same way */
+    size_t chunk_bytes = stats.memory_used / stats.total_entries;
+    CHECK(sylves_planar_lazy_mesh_grid_set_cache_limits(grid, 0, chunk_bytes * 2) == SYLVES_SUCCESS);
+    sylves_planar_lazy_mesh_grid_get_cache_stats(grid, &stats);
+    CHECK(stats.total_entries == 2 && stats.memory_used <= chunk_bytes * 2);
+    for (int c = 20; c < 30; c++) touch_chunk(grid, c);
+    sylves_planar_lazy_mesh_grid_get_cache_stats(grid, &stats);
+    CHECK(stats.total_entries == 2);
+    sylves_grid_destroy(grid);
+
+    /* Without caching every access regenerates and nothing is retained */
+    generated = 0;
+    grid = sylves_planar_lazy_mesh_grid_create_square(quad_row_chunk, 10.0, 0.0, true, NULL, NULL,
+                                                      SYLVES_CACHE_NONE, &generated);
+    touch_chunk(grid, 0);
+    touch_chunk(grid, 0);
+    sylves_planar_lazy_mesh_grid_get_cache_stats(grid, &stats);
+    CHECK(generated == 2 && stats.total_entries == 0 && stats.miss_count == 2);
+    CHECK(sylves_planar_lazy_mesh_grid_pin_chunk(grid, chunk) == SYLVES_ERROR_INVALID_ARGUMENT);
+
+    /* Lazy grids report the mesh type but have no BVH to query */
+    SylvesCell found[4];
+    CHECK(sylves_grid_get_cells_in_aabb(grid, sylves_vector3_create(0, 0, -1), sylves_vector3_create(5, 5, 1),
+                                        found, 4) == SYLVES_ERROR_NOT_IMPLEMENTED);
+    sylves_grid_destroy(grid);
+
+    SylvesGrid* square = sylves_square_grid_create(1.0);
+    CHECK(sylves_planar_lazy_mesh_grid_set_cache_limits(square, 1, 0) == SYLVES_ERROR_INVALID_ARGUMENT);
+    sylves_grid_destroy(square);
+    printf("  lazy grid chunk cache: PASSED\n");
+}
+
+/* Thread-safe chunk generator that holds builds until opened; rows below 0 fail */
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t opened;
+    bool open;
+    int generated;
+    int waiting;  /* Builds held at the gate */
+} GatedGenerator;
+
+static SylvesMeshData* gated_quad_row_chunk(int chunk_x, int chunk_y, void* user_data) {
+    GatedGenerator* gen = (GatedGenerator*)user_data;
+    pthread_mutex_lock(&gen->lock);
+    gen->waiting++;
+    pthread_cond_broadcast(&gen->opened);
+    while (!gen->open) pthread_cond_wait(&gen->opened, &gen->lock);
+    gen->waiting--;
+    SylvesMeshData* mesh = chunk_y < 0 ? NULL : quad_row_chunk(chunk_x, chunk_y, &gen->generated);
+    if (!mesh) gen->generated++;
+    pthread_mutex_unlock(&gen->lock);
+    return mesh;
+}
+
+static void* lazy_grid_lookup(void* arg) {
+    SylvesGrid* grid = (SylvesGrid*)arg;
+    return sylves_grid_is_cell_in_grid(grid, sylves_cell_create(5, 0, 0)) ? grid : NULL;
+}
+
+typedef struct {
+    SylvesGrid* grid;
+    int seed;
+    int wrong;
+} LazyGridReader;
+
+static void* lazy_grid_reader(void* arg) {
+    LazyGridReader* reader = (LazyGridReader*)arg;
+    unsigned seed = (unsigned)reader->seed;
+    for (int i = 0; i < 2000; i++) {
+        seed = seed * 1103515245u + 12345u;
+        int x = (int)((seed >> 8) % 200);
+        SylvesVector3 center = sylves_grid_get_cell_center(reader->grid, sylves_cell_create(x, 0, 0));
+        if (fabs(center.x - (x + 0.5)) > 1e-9 || fabs(center.y - 0.5) > 1e-9) reader->wrong++;
+    }
+    return NULL;
+}
+
+void test_lazy_grid_async() {
+    printf("Testing lazy grid async chunk builds...\n");
+    GatedGenerator gen = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, false, 0 };
+    SylvesGrid* grid = sylves_planar_lazy_mesh_grid_create_square(gated_quad_row_chunk, 10.0, 0.0, true, NULL, NULL,
+                                                                  SYLVES_CACHE_LRU, &gen);
+    CHECK(grid != NULL);
+    CHECK(sylves_planar_lazy_mesh_grid_enable_async(grid, 2, SYLVES_CHUNK_LOOKUP_NONBLOCKING) == SYLVES_SUCCESS);
+
+    /* Nonblocking queries report a missing chunk as absent and queue it once */
+    SylvesCell chunk0 = sylves_cell_create(0, 0, 0);
+    CHECK(sylves_planar_lazy_mesh_grid_get_chunk_state(grid, chunk0) == SYLVES_CHUNK_NOT_LOADED);
+    CHECK(!sylves_grid_is_cell_in_grid(grid, sylves_cell_create(5, 0, 0)));
+    CHECK(!sylves_grid_is_cell_in_grid(grid, sylves_cell_create(6, 0, 0)));
+    CHECK(sylves_planar_lazy_mesh_grid_get_chunk_state(grid, chunk0) == SYLVES_CHUNK_BUILDING);
+    SylvesCacheStats stats;
+    sylves_planar_lazy_mesh_grid_get_cache_stats(grid, &stats);
+    CHECK(stats.miss_count == 1);
+
+    /* Prefetch covers chunks 0-3 of row 0; chunk 0 is already on its way */
+    SylvesAabb region = { { 0.5, 0.5, 0.0 }, { 34.5, 0.5, 0.0 } };
+    CHECK(sylves_planar_lazy_mesh_grid_prefetch_region(grid, &region) == 3);
+    CHECK(sylves_planar_lazy_mesh_grid_prefetch_region(grid, &region) == 0);
+    SylvesAabb failing = { { 0.5, -9.5, 0.0 }, { 0.5, -9.5, 0.0 } };
+    CHECK(sylves_planar_lazy_mesh_grid_prefetch_region(grid, &failing) == 1);
+
+    pthread_mutex_lock(&gen.lock);
+    gen.open = true;
+    pthread_cond_broadcast(&gen.opened);
+    pthread_mutex_unlock(&gen.lock);
+    CHECK(sylves_planar_lazy_mesh_grid_wait_chunk(grid, sylves_cell_create(3, 0, 0)) == SYLVES_CHUNK_READY);
+    CHECK(sylves_planar_lazy_mesh_grid_wait_chunk(grid, sylves_cell_create(0, -1, 0)) == SYLVES_CHUNK_FAILED);
+    sylves_planar_lazy_mesh_grid_wait_for_builds(grid);
+    CHECK(gen.generated == 5);
+    CHECK(sylves_grid_is_cell_in_grid(grid, sylves_cell_create(5, 0, 0)));
+    SylvesVector3 center = sylves_grid_get_cell_center(grid, sylves_cell_create(37, 0, 0));
+    CHECK(fabs(center.x - 37.5) < 1e-9);
+    CHECK(gen.generated == 5);
+
+    /* Blocking mode waits for the build instead */
+    CHECK(sylves_planar_lazy_mesh_grid_enable_async(grid, 0, SYLVES_CHUNK_LOOKUP_BLOCK) == SYLVES_SUCCESS);
+    CHECK(sylves_grid_is_cell_in_grid(grid, sylves_cell_create(75, 0, 0)));
+    CHECK(gen.generated == 6);
+
+    /* Concurrent readers under eviction churn always see the right chunk */
+    CHECK(sylves_planar_lazy_mesh_grid_set_cache_limits(grid, 6, 0) == SYLVES_SUCCESS);
+    pthread_t threads[4];
+    LazyGridReader readers[4];
+    for (int t = 0; t < 4; t++) {
+        readers[t] = (LazyGridReader){ grid, 17 + t, 0 };
+        pthread_create(&threads[t], NULL, lazy_grid_reader, &readers[t]);
+    }
+    for (int t = 0; t < 4; t++) {
+        pthread_join(threads[t], NULL);
+        CHECK(readers[t].wrong == 0);
+    }
+    sylves_planar_lazy_mesh_grid_get_cache_stats(grid, &stats);
+    CHECK(stats.total_entries <= 6 + 4);
+    sylves_grid_destroy(grid);
+
+    /* Without async workers a prefetch builds before returning */
+    gen.generated = 0;
+    grid = sylves_planar_lazy_mesh_grid_create_square(gated_quad_row_chunk, 10.0, 0.0, true, NULL, NULL,
+                                                      SYLVES_CACHE_ALWAYS, &gen);
+    CHECK(sylves_planar_lazy_mesh_grid_prefetch_region(grid, &region) == 4);
+    CHECK(gen.generated == 4);
+    CHECK(sylves_planar_lazy_mesh_grid_get_chunk_state(grid, sylves_cell_create(2, 0, 0)) == SYLVES_CHUNK_READY);
+    sylves_grid_destroy(grid);
+
+    /* Unpinning a chunk nobody pinned leaves the pin of a lookup building it alone */
+    gen.open = false;
+    grid = sylves_planar_lazy_mesh_grid_create_square(gated_quad_row_chunk, 10.0, 0.0, true, NULL, NULL,
+                                                      SYLVES_CACHE_LRU, &gen);
+    pthread_t lookup;
+    pthread_create(&lookup, NULL, lazy_grid_lookup, grid);
+    pthread_mutex_lock(&gen.lock);
+    while (gen.waiting == 0) pthread_cond_wait(&gen.opened, &gen.lock);
+    pthread_mutex_unlock(&gen.lock);
+    sylves_planar_lazy_mesh_grid_unpin_chunk(grid, chunk0);
+    pthread_mutex_lock(&gen.lock);
+    gen.open = true;
+    pthread_cond_broadcast(&gen.opened);
+    pthread_mutex_unlock(&gen.lock);
+    void* found = NULL;
+    pthread_join(lookup, &found);
+    CHECK(found == grid);
+    /* Once the lookup is done the chunk is evictable again */
+    CHECK(sylves_planar_lazy_mesh_grid_set_cache_limits(grid, 1, 0) == SYLVES_SUCCESS);
+    CHECK(sylves_grid_is_cell_in_grid(grid, sylves_cell_create(15, 0, 0)));
+    CHECK(sylves_planar_lazy_mesh_grid_get_chunk_state(grid, chunk0) == SYLVES_CHUNK_NOT_LOADED);
+    sylves_grid_destroy(grid);
+
+    grid = sylves_planar_lazy_mesh_grid_create_square(gated_quad_row_chunk, 10.0, 0.0, true, NULL, NULL,
+                                                      SYLVES_CACHE_NONE, &gen);
+    CHECK(sylves_planar_lazy_mesh_grid_enable_async(grid, 1, SYLVES_CHUNK_LOOKUP_BLOCK) == SYLVES_ERROR_INVALID_ARGUMENT);
+    sylves_grid_destroy(grid);
+    printf("  lazy grid async chunk builds: PASSED\n");
+}
+
+void test_lazy_grid_shared_readers() {
+    printf("Testing lazy grid shared by concurrent readers...\n");
+    GatedGenerator gen = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, true, 0 };
+    SylvesGrid* grid = sylves_planar_lazy_mesh_grid_create_square(gated_quad_row_chunk, 10.0, 0.0, true, NULL, NULL,
+                                                                  SYLVES_CACHE_ALWAYS, &gen);
+    CHECK(grid != NULL);
+
+    /* Every chunk is built by exactly one reader while the rest wait or hit */
+    enum { READERS = 6 };
+    pthread_t threads[READERS];
+    LazyGridReader readers[READERS];
+    for (int t = 0; t < READERS; t++) {
+        readers[t] = (LazyGridReader){ grid, 101 + t, 0 };
+        pthread_create(&threads[t], NULL, lazy_grid_reader, &readers[t]);
+    }
+    for (int t = 0; t < READERS; t++) {
+        pthread_join(threads[t], NULL);
+        CHECK(readers[t].wrong == 0);
+    }
+    SylvesCacheStats stats;
+    sylves_planar_lazy_mesh_grid_get_cache_stats(grid, &stats);
+    CHECK(gen.generated == 20 && stats.miss_count == 20 && stats.total_entries == 20);
+    CHECK(stats.hit_count + stats.miss_count == READERS * 2000);
+    sylves_grid_destroy(grid);
+
+    /* A cache far smaller than the working set keeps evicting under the readers */
+    gen.generated = 0;
+    grid = sylves_planar_lazy_mesh_grid_create_square(gated_quad_row_chunk, 10.0, 0.0, true, NULL, NULL,
+                                                      SYLVES_CACHE_LRU, &gen);
+    CHECK(sylves_planar_lazy_mesh_grid_set_cache_limits(grid, 2, 0) == SYLVES_SUCCESS);
+    CHECK(sylves_grid_is_cell_in_grid(grid, sylves_cell_create(0, 0, 0)));
+    sylves_planar_lazy_mesh_grid_get_cache_stats(grid, &stats);
+    size_t chunk_bytes = stats.memory_used;
+    for (int t = 0; t < READERS; t++) {
+        readers[t] = (LazyGridReader){ grid, 211 + t, 0 };
+        pthread_create(&threads[t], NULL, lazy_grid_reader, &readers[t]);
+    }
+    for (int t = 0; t < READERS; t++) {
+        pthread_join(threads[t], NULL);
+        CHECK(readers[t].wrong == 0);
+    }
+    sylves_planar_lazy_mesh_grid_get_cache_stats(grid, &stats);
+    CHECK(stats.eviction_count > 0 && stats.total_entries <= 2 + READERS);
+    CHECK(stats.miss_count - stats.eviction_count == stats.total_entries);
+
+    /* Chunks evicted under readers count until freed; the next lookup out frees them */
+    CHECK(stats.memory_used >= stats.total_entries * chunk_bytes);
+    CHECK(sylves_grid_is_cell_in_grid(grid, sylves_cell_create(0, 0, 0)));
+    sylves_planar_lazy_mesh_grid_get_cache_stats(grid, &stats);
+    CHECK(stats.memory_used == stats.total_entries * chunk_bytes);
+    sylves_grid_destroy(grid);
+    printf("  lazy grid shared by concurrent readers: PASSED\n");
+}
+
+void test_spatial_index_backends() {
+    printf("Testing spatial index backends...\n");
+
+    enum { COUNT = 3000, BATCH = 1000 };
+    static SylvesVector3 points[COUNT];
+    static SylvesCell cells[COUNT];
+    static bool live[COUNT];
+    unsigned seed = 7;
+    for (int i = 0; i < COUNT; i++) {
+        seed = seed * 1103515245u + 12345u;
+        double u = (seed >> 8) % 100000 / 100000.0;
+        seed = seed * 1103515245u + 12345u;
+        double v = (seed >> 8) % 100000 / 100000.0;
+        /* Half uniform over [0, 100)^2, half packed into a 2x2 cluster */
+        points[i] = i % 2 ? sylves_vector3_create(u * 100.0, v * 100.0, 0.0)
+                          : sylves_vector3_create(20.0 + u * 2.0, 30.0 + v * 2.0, 0.0);
+        cells[i] = (SylvesCell){ i, 0, 0 };
+    }
+
+    SylvesSpatialIndexType types[] = {
+        SYLVES_SPATIAL_INDEX_GRID_HASH, SYLVES_SPATIAL_INDEX_QUADTREE, SYLVES_SPATIAL_INDEX_OCTREE,
+        SYLVES_SPATIAL_INDEX_RTREE, SYLVES_SPATIAL_INDEX_KDTREE
+    };
+    for (size_t t = 0; t < sizeof(types) / sizeof(types[0]); t++) {
+        SylvesSpatialIndexConfig config = { .type = types[t], .bucket_size = 1024 };
+        SylvesSpatialIndex* index = sylves_spatial_index_create(&config, 2);
+        CHECK(index != NULL);
+
+        /* Single inserts go through the pending tail and automatic rebuilds */
+        for (int i = 0; i < COUNT - BATCH; i++) {
+            CHECK(sylves_spatial_index_insert(index, &cells[i], &points[i], NULL) == SYLVES_SUCCESS);
+            live[i] = true;
+        }
+        CHECK(sylves_spatial_index_insert_batch(index, &cells[COUNT - BATCH], &points[COUNT - BATCH],
+                                                 BATCH) == SYLVES_SUCCESS);
+        for (int i = COUNT - BATCH; i < COUNT; i++) live[i] = true;
+        for (int i = 0; i < COUNT; i += 7) {
+            CHECK(sylves_spatial_index_remove(index, &cells[i]) == SYLVES_SUCCESS);
+            live[i] = false;
+        }
+        check_spatial_queries(index, points, live, COUNT);
+
+        CHECK(sylves_spatial_index_optimize(index) == SYLVES_SUCCESS);
+        check_spatial_queries(index, points, live, COUNT);
+
+        SylvesSpatialIndexStats stats;
+        sylves_spatial_index_get_stats(index, &stats);
+        CHECK(stats.item_count == (size_t)(COUNT - (COUNT + 6) / 7));
+
+        sylves_spatial_index_clear(index);
+        SylvesCell found;
+        SylvesVector3 origin = { 0, 0, 0 };
+        CHECK(sylves_spatial_index_find_nearest(index, &origin, &found, NULL) == SYLVES_ERROR_NOT_FOUND);
+        sylves_spatial_index_destroy(index);
+    }
+    printf("  spatial_index_backends: PASSED\n");
+}
+
+typedef struct {
+    SylvesCache* cache;
+    SylvesSpatialIndex* index;
+    int id;
+    int bad;
+} ConcurrencyWorker;
+
+static int concurrent_cache_values[512];
+
+static void* concurrent_cache_worker(void* arg) {
+    ConcurrencyWorker* w = (ConcurrencyWorker*)arg;
+    unsigned seed = 17u + (unsigned)w->id;
+    for (int i = 0; i < 20000; i++) {
+        seed = seed * 1103515245u + 12345u;
+        int key = (int)((seed >> 8) % 512);
+        if (i % 8 == 0) {
+            sylves_cache_put(w->cache, &key, &concurrent_cache_values[key]);
+        } else {
+            /* Values are unowned here, so a hit stays valid after a racing eviction */
+            int* value = (int*)sylves_cache_get(w->cache, &key);
+            if (value && value != &concurrent_cache_values[key]) w->bad++;
+        }
+    }
+    return NULL;
+}
+
+static void* concurrent_index_worker(void* arg) {
+    ConcurrencyWorker* w = (ConcurrencyWorker*)arg;
+    for (int i = 0; i < 2000; i++) {
+        SylvesCell cell = { 10000 + w->id * 2000 + i, 0, 0 };
+        SylvesVector3 p = { (double)(i % 50), (double)(i / 50), 0.0 };
+        if (w->id == 0 && i % 4 == 0) {
+            /* One writer moving its own cells while the others query */
+            if (sylves_spatial_index_insert(w->index, &cell, &p, NULL) != SYLVES_SUCCESS) w->bad++;
+        } else {
+            SpatialCollect found = {0};
+            SylvesAabb box = { { p.x - 1.5, p.y - 1.5, 0.0 }, { p.x + 1.5, p.y + 1.5, 0.0 } };
+            sylves_spatial_index_query_aabb(w->index, &box, spatial_collect, &found);
+            if (found.count < 9 && p.x >= 1.0 && p.x <= 48.0 && p.y >= 1.0 && p.y <= 38.0) w->bad++;
+        }
+    }
+    return NULL;
+}
+
+void test_concurrent_containers() {
+    printf("Testing sharded cache and concurrent spatial index...\n");
+
+    /* CLOCK keeps LRU's answer for the classic case: a hit earns a second chance */
+    SylvesCacheConfig config = { .max_entries = 3, .policy = SYLVES_CACHE_POLICY_LRU, .track_stats = true };
+    SylvesCache* cache = sylves_cache_create(&config, sizeof(int), NULL, NULL, free, NULL);
+    CHECK(cache != NULL);
+    for (int key = 1; key <= 4; key++) {
+        int* value = (int*)malloc(sizeof(int));
+        *value = key * 10;
+        CHECK(sylves_cache_put(cache, &key, value) == SYLVES_SUCCESS);
+        if (key == 1) CHECK(sylves_cache_get(cache, &key) != NULL);
+    }
+    int key = 2;
+    CHECK(sylves_cache_get(cache, &key) == NULL);
+    for (key = 1; key <= 4; key += 2) CHECK(*(int*)sylves_cache_get(cache, &key) == key * 10);
+    SylvesCacheStats stats;
+    sylves_cache_get_stats(cache, &stats);
+    CHECK(stats.eviction_count == 1 && stats.total_entries == 3);
+    CHECK(stats.hit_count == 3 && stats.miss_count == 1);
+    sylves_cache_destroy(cache);
+
+    /* Sharded cache: per-shard limits still bound the total */
+    SylvesCacheConfig shared = { .max_entries = 256, .policy = SYLVES_CACHE_POLICY_LRU,
+                                 .thread_safe = true, .track_stats = true, .shard_count = 8 };
+    cache = sylves_cache_create(&shared, sizeof(int), NULL, NULL, NULL, NULL);
+    CHECK(cache != NULL);
+
+    enum { THREADS = 4 };
+    pthread_t threads[THREADS];
+    ConcurrencyWorker workers[THREADS];
+    for (int t = 0; t < THREADS; t++) {
+        workers[t] = (ConcurrencyWorker){ cache, NULL, t, 0 };
+        CHECK(pthread_create(&threads[t], NULL, concurrent_cache_worker, &workers[t]) == 0);
+    }
+    for (int t = 0; t < THREADS; t++) {
+        pthread_join(threads[t], NULL);
+        CHECK(workers[t].bad == 0);
+    }
+    sylves_cache_get_stats(cache, &stats);
+    CHECK(stats.hit_count + stats.miss_count == (size_t)THREADS * 17500);
+    CHECK(stats.total_entries > 0 && stats.total_entries <= 256 + 8);
+    sylves_cache_destroy(cache);
+
+    /* Readers share the index lock while one thread inserts */
+    SylvesSpatialIndexConfig index_config = { .type = SYLVES_SPATIAL_INDEX_KDTREE, .thread_safe = true };
+    SylvesSpatialIndex* index = sylves_spatial_index_create(&index_config, 2);
+    CHECK(index != NULL);
+    for (int i = 0; i < 2000; i++) {
+        SylvesCell cell = { i, 0, 0 };
+        SylvesVector3 p = { (double)(i % 50), (double)(i / 50), 0.0 };
+        CHECK(sylves_spatial_index_insert(index, &cell, &p, NULL) == SYLVES_SUCCESS);
+    }
+    for (int t = 0; t < THREADS; t++) {
+        workers[t] = (ConcurrencyWorker){ NULL, index, t, 0 };
+        CHECK(pthread_create(&threads[t], NULL, concurrent_index_worker, &workers[t]) == 0);
+    }
+    for (int t = 0; t < THREADS; t++) {
+        pthread_join(threads[t], NULL);
+        CHECK(workers[t].bad == 0);
+    }
+    SylvesSpatialIndexStats index_stats;
+    sylves_spatial_index_get_stats(index, &index_stats);
+    CHECK(index_stats.item_count == 2000 + 500);
+    sylves_spatial_index_destroy(index);
+    printf("  concurrent_containers: PASSED\n");
+}
+
+static void cache_put_int(SylvesCache* cache, int key) {
+    int* value = (int*)malloc(sizeof(int));
+    *value = key * 10;
+    CHECK(sylves_cache_put(cache, &key, value) == SYLVES_SUCCESS);
+}
+
+static bool cache_has_int(SylvesCache* cache, int key) {
+    int* value = (int*)sylves_cache_get(cache, &key);
+    return value && *value == key * 10;
+}
+
+void test_cache_eviction_policies() {
+    printf("Testing cache eviction policies...\n");
+
+    /* LFU evicts the least hit entry, the oldest among equals */
+    SylvesCacheConfig config = { .max_entries = 3, .policy = SYLVES_CACHE_POLICY_LFU, .track_stats = true };
+    SylvesCache* cache = sylves_cache_create(&config, sizeof(int), NULL, NULL, free, NULL);
+    CHECK(cache != NULL);
+    for (int key = 1; key <= 3; key++) cache_put_int(cache, key);
+    for (int i = 0; i < 3; i++) CHECK(cache_has_int(cache, 1));
+    for (int i = 0; i < 2; i++) CHECK(cache_has_int(cache, 2));
+    cache_put_int(cache, 4);                 /* evicts 3, the only entry never hit */
+    cache_put_int(cache, 5);                 /* evicts 4 */
+    cache_put_int(cache, 6);                 /* evicts 5 */
+    CHECK(cache_has_int(cache, 6));
+    cache_put_int(cache, 7);                 /* 6 has fewer hits than 1 and 2: evicts 6 */
+    SylvesCacheStats stats;
+    sylves_cache_get_stats(cache, &stats);
+    CHECK(stats.eviction_count == 4 && stats.total_entries == 3);
+    CHECK(cache_has_int(cache, 1) && cache_has_int(cache, 2) && cache_has_int(cache, 7));
+    for (int key = 3; key <= 6; key++) CHECK(!cache_has_int(cache, key));
+    sylves_cache_destroy(cache);
+
+    /* RANDOM holds its bound through evictions and removals */
+    config = (SylvesCacheConfig){ .max_entries = 64, .policy = SYLVES_CACHE_POLICY_RANDOM, .track_stats = true };
+    cache = sylves_cache_create(&config, sizeof(int), NULL, NULL, free, NULL);
+    CHECK(cache != NULL);
+    for (int key = 0; key < 1000; key++) cache_put_int(cache, key);
+    int present = 0;
+    for (int key = 0; key < 1000; key++) {
+        if (cache_has_int(cache, key)) {
+            present++;
+            if (key % 2 == 0) CHECK(sylves_cache_remove(cache, &key) == SYLVES_SUCCESS);
+        }
+    }
+    CHECK(present == 64);
+    for (int key = 1000; key < 1100; key++) cache_put_int(cache, key);
+    sylves_cache_get_stats(cache, &stats);
+    CHECK(stats.total_entries == 64);
+    present = 0;
+    for (int key = 0; key < 1100; key++) present += cache_has_int(cache, key);
+    CHECK(present == 64);
+    sylves_cache_destroy(cache);
+
+    /* TinyLFU keeps a hot set that a one-pass scan would flush out of an LRU cache */
+    SylvesCachePolicy scanned[2] = { SYLVES_CACHE_POLICY_LRU, SYLVES_CACHE_POLICY_TINYLFU };
+    int hot_kept[2] = { 0, 0 };
+    for (int p = 0; p < 2; p++) {
+        config = (SylvesCacheConfig){ .max_entries = 100, .policy = scanned[p] };
+        cache = sylves_cache_create(&config, sizeof(int), NULL, NULL, free, NULL);
+        CHECK(cache != NULL);
+        for (int round = 0; round < 10; round++) {
+            for (int key = 0; key < 50; key++) {
+                if (!cache_has_int(cache, key)) cache_put_int(cache, key);
+            }
+        }
+        for (int key = 1000; key < 5000; key++) {
+            if (!cache_has_int(cache, key)) cache_put_int(cache, key);
+        }
+        for (int key = 0; key < 50; key++) {
+            int k = key;
+            hot_kept[p] += sylves_cache_get(cache, &k) != NULL;
+        }
+        sylves_cache_get_stats(cache, &stats);
+        CHECK(stats.total_entries == 100);
+        sylves_cache_destroy(cache);
+    }
+    CHECK(hot_kept[0] == 0);
+    CHECK(hot_kept[1] >= 45);
+
+    /* Hits restructure LFU and TinyLFU shards, so they run under the exclusive lock */
+    SylvesCachePolicy threaded[3] = { SYLVES_CACHE_POLICY_LFU, SYLVES_CACHE_POLICY_RANDOM, SYLVES_CACHE_POLICY_TINYLFU };
+    for (int p = 0; p < 3; p++) {
+        SylvesCacheConfig shared = { .max_entries = 256, .policy = threaded[p],
+                                     .thread_safe = true, .track_stats = true, .shard_count = 8 };
+        cache = sylves_cache_create(&shared, sizeof(int), NULL, NULL, NULL, NULL);
+        CHECK(cache != NULL);
+        enum { THREADS = 4 };
+        pthread_t threads[THREADS];
+        ConcurrencyWorker workers[THREADS];
+        for (int t = 0; t < THREADS; t++) {
+            workers[t] = (ConcurrencyWorker){ cache, NULL, t, 0 };
+            CHECK(pthread_create(&threads[t], NULL, concurrent_cache_worker, &workers[t]) == 0);
+        }
+        for (int t = 0; t < THREADS; t++) {
+            pthread_join(threads[t], NULL);
+            CHECK(workers[t].bad == 0);
+        }
+        sylves_cache_get_stats(cache, &stats);
+        CHECK(stats.hit_count + stats.miss_count == (size_t)THREADS * 17500);
+        CHECK(stats.total_entries > 0 && stats.total_entries <= 256 + 8);
+        sylves_cache_destroy(cache);
+    }
+    printf("  cache_eviction_policies: PASSED\n");
+}
+
+/* Keys whose hashes all collide, so every lookup walks one long probe run */
+static size_t colliding_hash(const void* key, size_t key_size) {
+    (void)key; (void)key_size;
+    return 42;
+}
+
+static int int_compare(const void* key1, const void* key2, size_t key_size) {
+    (void)key_size;
+    return *(const int*)key1 != *(const int*)key2;
+}
+
+void test_cache_hash_table() {
+    printf("Testing cache hash table...\n");
+
+    /* An unbounded cache grows its table; deletions keep every probe run intact */
+    SylvesCacheConfig config = { .policy = SYLVES_CACHE_POLICY_LRU };
+    SylvesCache* cache = sylves_cache_create(&config, sizeof(int), NULL, NULL, free, NULL);
+    CHECK(cache != NULL);
+    for (int key = 0; key < 20000; key++) cache_put_int(cache, key);
+    for (int key = 0; key < 20000; key += 3) CHECK(sylves_cache_remove(cache, &key) == SYLVES_SUCCESS);
+    int found = 0;
+    for (int key = 0; key < 20000; key++) {
+        bool has = cache_has_int(cache, key);
+        CHECK(has == (key % 3 != 0));
+        found += has;
+    }
+    SylvesCacheStats stats;
+    sylves_cache_get_stats(cache, &stats);
+    CHECK(stats.total_entries == (size_t)found);
+    sylves_cache_destroy(cache);
+
+    /* Custom functions still decide equality, even when every hash collides */
+    config = (SylvesCacheConfig){ .max_entries = 50, .policy = SYLVES_CACHE_POLICY_FIFO };
+    cache = sylves_cache_create(&config, sizeof(int), colliding_hash, int_compare, free, NULL);
+    CHECK(cache != NULL);
+    for (int key = 0; key < 80; key++) cache_put_int(cache, key);
+    for (int key = 30; key < 80; key += 2) CHECK(sylves_cache_remove(cache, &key) == SYLVES_SUCCESS);
+    for (int key = 0; key < 80; key++) CHECK(cache_has_int(cache, key) == (key >= 30 && key % 2 == 1));
+    sylves_cache_destroy(cache);
+
+    /* Wrappers use their built-in key layouts */
+    SylvesMeshCache* meshes = sylves_mesh_cache_create(0, true);
+    CHECK(meshes != NULL);
+    SylvesMeshData* mesh = sylves_mesh_data_create(3, 1);
+    CHECK(mesh != NULL);
+    CHECK(sylves_mesh_cache_put(meshes, 0x123456789ABCull, mesh) == SYLVES_SUCCESS);
+    CHECK(sylves_mesh_cache_get(meshes, 0x123456789ABCull) == mesh);
+    CHECK(sylves_mesh_cache_get(meshes, 0x123456789ABDull) == NULL);
+    sylves_mesh_cache_destroy(meshes);
+
+    SylvesGrid* square = sylves_square_grid_create(1.0);
+    SylvesCellCache* cells = sylves_cell_cache_create(square, 16, false);
+    CHECK(cells != NULL);
+    SylvesVector3 triangle[3] = { { 0, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 } };
+    SylvesMatrix4x4 identity = sylves_matrix4x4_identity();
+    for (int x = 0; x < 20; x++) {
+        SylvesCell cell = { x, -x, 0 };
+        CHECK(sylves_cell_cache_put_polygon(cells, &cell, triangle, 3, &identity) == SYLVES_SUCCESS);
+    }
+    SylvesVector3* vertices;
+    int vertex_count;
+    SylvesMatrix4x4 transform;
+    SylvesCell recent = { 19, -19, 0 }, absent = { 19, 19, 0 };
+    CHECK(sylves_cell_cache_get_polygon(cells, &recent, &vertices, &vertex_count, &transform));
+    CHECK(vertex_count == 3 && vertices[1].x == 1.0);
+    CHECK(!sylves_cell_cache_get_polygon(cells, &absent, &vertices, &vertex_count, &transform));
+    sylves_cell_cache_destroy(cells);
+    sylves_grid_destroy(square);
+    printf("  cache_hash_table: PASSED\n");
+}
+
+/* Producer hands cells to the main thread, which frees them remotely */
+typedef struct {
+    SylvesConcurrentPool* pool;
+    SylvesCell* cells[1000];
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    int stage;
+    size_t chunks_before;
+    size_t chunks_after;
+} PoolHandoff;
+
+static void pool_handoff_wait(PoolHandoff* h, int stage) {
+    pthread_mutex_lock(&h->lock);
+    while (h->stage < stage) pthread_cond_wait(&h->cond, &h->lock);
+    pthread_mutex_unlock(&h->lock);
+}
+
+static void pool_handoff_signal(PoolHandoff* h, int stage) {
+    pthread_mutex_lock(&h->lock);
+    h->stage = stage;
+    pthread_cond_broadcast(&h->cond);
+    pthread_mutex_unlock(&h->lock);
+}
+
+static void* pool_producer(void* arg) {
+    PoolHandoff* h = (PoolHandoff*)arg;
+    for (int i = 0; i < 1000; i++) {
+        h->cells[i] = (SylvesCell*)sylves_concurrent_pool_alloc(h->pool);
+        *h->cells[i] = (SylvesCell){ i, -i, 0 };
+    }
+    pool_handoff_signal(h, 1);
+    pool_handoff_wait(h, 2);
+
+    /* Allocating again takes back what the main thread freed instead of carving */
+    SylvesPoolStats stats;
+    sylves_concurrent_pool_get_stats(h->pool, &stats);
+    h->chunks_before = stats.total_memory_used;
+    for (int i = 0; i < 1000; i++) {
+        h->cells[i] = (SylvesCell*)sylves_concurrent_pool_alloc(h->pool);
+    }
+    sylves_concurrent_pool_get_stats(h->pool, &stats);
+    h->chunks_after = stats.total_memory_used;
+    for (int i = 0; i < 1000; i++) {
+        sylves_concurrent_pool_free(h->pool, h->cells[i]);
+    }
+    return NULL;
+}
+
+void test_concurrent_pool() {
+    printf("Testing concurrent memory pool...\n");
+    SylvesConcurrentPool* pool = sylves_concurrent_pool_create(sizeof(SylvesCell), 64);
+    CHECK(pool != NULL);
+
+    /* Same-thread frees are reused first */
+    void* a = sylves_concurrent_pool_alloc(pool);
+    void* b = sylves_concurrent_pool_alloc(pool);
+    CHECK(a != NULL && b != NULL && a != b);
+    sylves_concurrent_pool_free(pool, a);
+    CHECK(sylves_concurrent_pool_alloc(pool) == a);
+    sylves_concurrent_pool_free(pool, a);
+    sylves_concurrent_pool_free(pool, b);
+
+    PoolHandoff h;
+    memset(&h, 0, sizeof(h));
+    h.pool = pool;
+    pthread_mutex_init(&h.lock, NULL);
+    pthread_cond_init(&h.cond, NULL);
+    pthread_t producer;
+    CHECK(pthread_create(&producer, NULL, pool_producer, &h) == 0);
+    pool_handoff_wait(&h, 1);
+    for (int i = 0; i < 1000; i++) {
+        CHECK(h.cells[i] != NULL && h.cells[i]->x == i && h.cells[i]->y == -i);
+        sylves_concurrent_pool_free(pool, h.cells[i]);
+    }
+    SylvesPoolStats stats;
+    sylves_concurrent_pool_get_stats(pool, &stats);
+    CHECK(stats.total_allocations == 1003 && stats.active_allocations == 1000);
+    pool_handoff_signal(&h, 2);
+    pthread_join(producer, NULL);
+    CHECK(h.chunks_after == h.chunks_before);
+
+    sylves_concurrent_pool_get_stats(pool, &stats);
+    CHECK(stats.total_allocations == 2003 && stats.active_allocations == 0);
+    pthread_mutex_destroy(&h.lock);
+    pthread_cond_destroy(&h.cond);
+    sylves_concurrent_pool_destroy(pool);
+    printf("  concurrent_pool: PASSED\n");
+}
+
+/* A wall at x == 5 with a single gap at y == 8 */
+static bool path_wall_accessible(SylvesCell cell, void* user_data) {
+    (void)user_data;
+    return cell.x != 5 || cell.y == 8;
+}
+
+void test_pathfinding_searches() {
+    printf("Testing A*, Dijkstra and BFS searches...\n");
+    SylvesGrid* grid = sylves_square_grid_create(1.0);
+    CHECK(grid != NULL);
+    SylvesCell src = { 0, 0, 0 };
+    SylvesCell dest = { 10, 0, 0 };
+
+    /* Detour through the gap: 5 across + 8 up + 8 down + 5 across */
+    SylvesCellPath* path = sylves_find_path(grid, src, dest, path_wall_accessible, NULL, NULL);
+    CHECK(path != NULL && path->step_count == 26);
+    CHECK(sylves_cell_equals(path->steps[path->step_count - 1].dest, dest));
+    sylves_cell_path_destroy(path);
+
+    float distance = 0.0f;
+    CHECK(sylves_find_distance(grid, src, (SylvesCell){ 3, -4, 0 }, NULL, NULL, NULL, &distance) == SYLVES_SUCCESS);
+    CHECK(distance == 7.0f);
+
+    SylvesBFSPathfinding* bfs = sylves_bfs_create(grid, src, path_wall_accessible, NULL);
+    CHECK(bfs != NULL);
+    sylves_bfs_run(bfs, &dest, 1, -1);
+    int hops = 0;
+    CHECK(sylves_bfs_is_reachable(bfs, dest, &hops) && hops == 26);
+    path = sylves_bfs_extract_path(bfs, dest);
+    CHECK(path != NULL && path->step_count == 26);
+    sylves_cell_path_destroy(path);
+    sylves_bfs_destroy(bfs);
+
+    /* Flood a radius-150 diamond: ~45k nodes through map, arena and heap growth */
+    const int radius = 150;
+    SylvesDijkstraPathfinding* dijkstra = sylves_dijkstra_create(grid, src, NULL, NULL);
+    CHECK(dijkstra != NULL);
+    sylves_dijkstra_run(dijkstra, NULL, (float)radius);
+    size_t count = 0;
+    CHECK(sylves_dijkstra_get_distances(dijkstra, NULL, NULL, &count) == SYLVES_SUCCESS);
+    CHECK(count == (size_t)(2 * radius * (radius + 1) + 1));
+    SylvesCell* cells = (SylvesCell*)malloc(sizeof(SylvesCell) * count);
+    float* distances = (float*)malloc(sizeof(float) * count);
+    CHECK(sylves_dijkstra_get_distances(dijkstra, cells, distances, &count) == SYLVES_SUCCESS);
+    for (size_t i = 0; i < count; i++) {
+        CHECK(distances[i] == (float)(abs(cells[i].x) + abs(cells[i].y)));
+    }
+    free(cells);
+    free(distances);
+    path = sylves_dijkstra_extract_path(dijkstra, (SylvesCell){ -radius, 0, 0 });
+    CHECK(path != NULL && path->step_count == (size_t)radius);
+    sylves_cell_path_destroy(path);
+    sylves_dijkstra_destroy(dijkstra);
+
+    sylves_grid_destroy(grid);
+    printf("  pathfinding_searches: PASSED\n");
+}
+
+/* Blocks the ring around (20, 20) so that cell is unreachable */
+static bool path_ring_accessible(SylvesCell cell, void* user_data) {
+    (void)user_data;
+    int dx = abs(cell.x - 20), dy = abs(cell.y - 20);
+    return !(dx <= 1 && dy <= 1 && (dx | dy) != 0);
+}
+
+void test_pathfinding_context() {
+    printf("Testing reusable pathfinding context...\n");
+    SylvesGrid* grid = sylves_square_grid_create(1.0);
+    SylvesPathfindingContext* ctx = sylves_pathfinding_context_create(0);
+    CHECK(grid != NULL && ctx != NULL);
+
+    /* Reused state must answer exactly like fresh state, query after query */
+    unsigned seed = 7;
+    for (int q = 0; q < 200; q++) {
+        seed = seed * 1103515245u + 12345u;
+        SylvesCell src = { (int)((seed >> 8) % 40) - 20, (int)((seed >> 16) % 40) - 20, 0 };
+        SylvesCell dest = { -src.y / 2, src.x, 0 };
+        if (dest.x == 5) dest.x = 6; /* a walled-in dest would flood the unbounded grid forever */
+        float fresh = -1.0f, reused = -2.0f;
+        CHECK(sylves_find_distance(grid, src, dest, path_wall_accessible, NULL, NULL, &fresh) == SYLVES_SUCCESS);
+        CHECK(sylves_find_distance_with_context(ctx, grid, src, dest, path_wall_accessible, NULL, NULL,
+                                                &reused) == SYLVES_SUCCESS);
+        CHECK(fresh == reused);
+    }
+
+    /* Nodes from a previous query must not leak into the next one */
+    float distance = 0.0f;
+    SylvesCell origin = { 0, 0, 0 }, enclosed = { 20, 20, 0 };
+    CHECK(sylves_find_distance_with_context(ctx, grid, origin, enclosed, NULL, NULL, NULL, &distance) == SYLVES_SUCCESS);
+    CHECK(distance == 40.0f);
+    SylvesCellPath* path = sylves_find_path_with_context(ctx, grid, enclosed, origin, NULL, NULL, NULL);
+    CHECK(path != NULL && path->step_count == 40);
+    sylves_cell_path_destroy(path);
+    /* Unreachable: the search floods the bounded grid and stops when the open set drains */
+    SylvesGrid* bounded = sylves_square_grid_create_bounded(1.0, 0, 0, 40, 40);
+    CHECK(bounded != NULL);
+    CHECK(sylves_find_distance_with_context(ctx, bounded, origin, enclosed, path_ring_accessible, NULL, NULL,
+                                            &distance) == SYLVES_ERROR_CELL_NOT_FOUND);
+    CHECK(sylves_find_path_with_context(ctx, bounded, origin, enclosed, path_ring_accessible, NULL, NULL) == NULL);
+    sylves_pathfinding_context_reset(ctx);
+    CHECK(sylves_find_distance_with_context(ctx, bounded, origin, origin, NULL, NULL, NULL, &distance) == SYLVES_SUCCESS);
+    CHECK(distance == 0.0f);
+
+    sylves_grid_destroy(bounded);
+    sylves_pathfinding_context_destroy(ctx);
+    sylves_grid_destroy(grid);
+    printf("  pathfinding_context: PASSED\n");
+}
+
+static bool path_steps_connected(const SylvesCellPath* path, SylvesCell src, SylvesCell dest) {
+    SylvesCell at = src;
+    for (size_t i = 0; i < path->step_count; i++) {
+        if (!sylves_cell_equals(path->steps[i].src, at) || path->steps[i].length != 1.0f) return false;
+        at = path->steps[i].dest;
+    }
+    return sylves_cell_equals(at, dest);
+}
+
+void test_pathfinding_dense() {
+    printf("Testing dense-index pathfinding on bounded grids...\n");
+    SylvesGrid* sparse = sylves_square_grid_create(1.0);
+    SylvesGrid* dense = sylves_square_grid_create_bounded(1.0, 0, 0, 63, 63);
+    SylvesPathfindingContext* ctx = sylves_pathfinding_context_create(0);
+    CHECK(sparse != NULL && dense != NULL && ctx != NULL);
+
+    /* The wall column spans the box and its gap is inside, so no shortest path needs to leave it */
+    unsigned seed = 11;
+    for (int q = 0; q < 200; q++) {
+        seed = seed * 1103515245u + 12345u;
+        SylvesCell src = { (int)((seed >> 8) % 64), (int)((seed >> 16) % 64), 0 };
+        seed = seed * 1103515245u + 12345u;
+        SylvesCell dest = { (int)((seed >> 8) % 64), (int)((seed >> 16) % 64), 0 };
+        if (src.x == 5) src.x = 6;
+        if (dest.x == 5) dest.x = 6;
+        /* Alternate grids on one context so each query rebinds the layout */
+        float expected = -1.0f, distance = -2.0f;
+        CHECK(sylves_find_distance_with_context(ctx, sparse, src, dest, path_wall_accessible, NULL, NULL,
+                                                &expected) == SYLVES_SUCCESS);
+        CHECK(sylves_find_distance_with_context(ctx, dense, src, dest, path_wall_accessible, NULL, NULL,
+                                                &distance) == SYLVES_SUCCESS);
+        CHECK(distance == expected);
+        SylvesCellPath* path = sylves_find_path_with_context(ctx, dense, src, dest, path_wall_accessible, NULL, NULL);
+        CHECK(path != NULL && (float)path->step_count == expected && path_steps_connected(path, src, dest));
+        sylves_cell_path_destroy(path);
+    }
+
+    /* The enclosed cell stays unreachable after the dense arrays were reused */
+    float distance = 0.0f;
+    SylvesCell origin = { 0, 0, 0 }, enclosed = { 20, 20, 0 };
+    CHECK(sylves_find_distance_with_context(ctx, dense, origin, enclosed, path_ring_accessible, NULL, NULL,
+                                            &distance) == SYLVES_ERROR_CELL_NOT_FOUND);
+    CHECK(sylves_find_distance_with_context(ctx, dense, origin, (SylvesCell){ 63, 63, 0 }, NULL, NULL, NULL,
+                                            &distance) == SYLVES_SUCCESS);
+    CHECK(distance == 126.0f);
+
+    /* A bounded Dijkstra flood reports every cell of the box once */
+    SylvesDijkstraPathfinding* dijkstra = sylves_dijkstra_create(dense, origin, NULL, NULL);
+    CHECK(dijkstra != NULL);
+    sylves_dijkstra_run(dijkstra, NULL, FLT_MAX);
+    size_t count = 0;
+    CHECK(sylves_dijkstra_get_distances(dijkstra, NULL, NULL, &count) == SYLVES_SUCCESS);
+    CHECK(count == 64 * 64);
+    SylvesCell* cells = (SylvesCell*)malloc(sizeof(SylvesCell) * count);
+    float* distances = (float*)malloc(sizeof(float) * count);
+    CHECK(sylves_dijkstra_get_distances(dijkstra, cells, distances, &count) == SYLVES_SUCCESS);
+    for (size_t i = 0; i < count; i++) {
+        CHECK(distances[i] == (float)(cells[i].x + cells[i].y));
+    }
+    free(cells);
+    free(distances);
+    sylves_dijkstra_destroy(dijkstra);
+
+    /* Bounded hex grids index their parallelogram; BFS hops are hex distances */
+    SylvesGrid* hex = sylves_hex_grid_create_bounded(SYLVES_HEX_ORIENTATION_FLAT_TOP, 1.0, -8, -8, 8, 8);
+    CHECK(hex != NULL && sylves_grid_get_index_count(hex) == 17 * 17);
+    SylvesBFSPathfinding* bfs = sylves_bfs_create(hex, origin, NULL, NULL);
+    CHECK(bfs != NULL);
+    sylves_bfs_run(bfs, NULL, 0, -1);
+    for (int r = -8; r <= 8; r++) {
+        for (int q = -8; q <= 8; q++) {
+            int hops = -1;
+            int expected = (abs(q) + abs(r) + abs(q + r)) / 2;
+            CHECK(sylves_bfs_is_reachable(bfs, (SylvesCell){ q, r, 0 }, &hops) && hops == expected);
+        }
+    }
+    CHECK(!sylves_bfs_is_reachable(bfs, (SylvesCell){ 9, 0, 0 }, NULL));
+    SylvesCellPath* path = sylves_bfs_extract_path(bfs, (SylvesCell){ 8, -8, 0 });
+    CHECK(path != NULL && path->step_count == 8 && path_steps_connected(path, origin, (SylvesCell){ 8, -8, 0 }));
+    sylves_cell_path_destroy(path);
+    sylves_bfs_destroy(bfs);
+
+    sylves_grid_destroy(hex);
+    sylves_pathfinding_context_destroy(ctx);
+    sylves_grid_destroy(dense);
+    sylves_grid_destroy(sparse);
+    printf("  pathfinding_dense: PASSED\n");
+}
+
+static void* slab_remote_free(void* arg) {
+    void** args = (void**)arg;
+    sylves_slab_free((SylvesSlabAllocator*)args[0], args[1]);
+    return NULL;
+}
+
+void test_slab_allocator() {
+    printf("Testing slab allocator...\n");
+    SylvesSlabAllocator* slab = sylves_slab_allocator_create(0);
+    CHECK(slab != NULL);
+    size_t class_count = sylves_slab_allocator_get_class_count(slab);
+    CHECK(class_count > 8 && sylves_slab_allocator_get_class_size(slab, 0) == 16);
+    CHECK(sylves_slab_allocator_get_class_size(slab, class_count - 1) >= 1024);
+    CHECK(sylves_slab_allocator_get_class_size(slab, class_count) == 0);
+
+    /* Sizes round up to their class; same-class frees are reused */
+    void* small = sylves_slab_alloc(slab, 24);
+    CHECK(small != NULL && ((uintptr_t)small & 15) == 0);
+    sylves_slab_free(slab, small);
+    CHECK(sylves_slab_alloc(slab, 32) == small);
+    SylvesPoolStats stats;
+    sylves_slab_allocator_get_stats(slab, 1, &stats);
+    CHECK(stats.total_allocations == 2 && stats.active_allocations == 1);
+
+    /* Realloc keeps contents across classes and into pass-through sizes */
+    memset(small, 0x5A, 32);
+    unsigned char* grown = (unsigned char*)sylves_slab_realloc(slab, small, 200);
+    CHECK(grown != NULL && grown[0] == 0x5A && grown[31] == 0x5A);
+    CHECK(sylves_slab_realloc(slab, grown, 190) == grown);
+    grown = (unsigned char*)sylves_slab_realloc(slab, grown, 100000);
+    CHECK(grown != NULL && grown[31] == 0x5A);
+    sylves_slab_allocator_get_stats(slab, class_count, &stats);
+    CHECK(stats.active_allocations == 1 && stats.total_memory_used == 100000);
+    sylves_slab_free(slab, grown);
+    sylves_slab_allocator_get_stats(slab, class_count, &stats);
+    CHECK(stats.active_allocations == 0 && stats.total_memory_used == 0);
+
+    /* Frees from another thread go back to the allocating heap */
+    void* args[2] = { slab, sylves_slab_alloc(slab, 48) };
+    pthread_t thread;
+    CHECK(pthread_create(&thread, NULL, slab_remote_free, args) == 0);
+    pthread_join(thread, NULL);
+    sylves_slab_free(slab, small);
+
+    /* Installed as the library allocator it serves real workloads */
+    sylves_set_allocator(sylves_slab_allocator_get_interface(slab));
+    SylvesGrid* grid = sylves_square_grid_create_bounded(1.0, 0, 0, 40, 40);
+    SylvesCacheConfig config = { .max_entries = 64, .policy = SYLVES_CACHE_POLICY_LRU };
+    SylvesCache* cache = sylves_cache_create(&config, sizeof(int), NULL, NULL, NULL, NULL);
+    CHECK(grid != NULL && cache != NULL);
+    for (int key = 0; key < 1000; key++) {
+        sylves_cache_put(cache, &key, NULL);
+    }
+    SylvesCellPath* path = sylves_find_path(grid, (SylvesCell){ 7, 1, 0 }, (SylvesCell){ 38, 36, 0 },
+                                            NULL, NULL, NULL);
+    CHECK(path != NULL && path_steps_connected(path, (SylvesCell){ 7, 1, 0 }, (SylvesCell){ 38, 36, 0 }));
+    sylves_cell_path_destroy(path);
+    sylves_cache_destroy(cache);
+    sylves_grid_destroy(grid);
+    sylves_set_allocator(NULL);
+
+    size_t total = 0, active = 0;
+    for (size_t i = 0; i <= class_count; i++) {
+        sylves_slab_allocator_get_stats(slab, i, &stats);
+        total += stats.total_allocations;
+        active += stats.active_allocations;
+    }
+    CHECK(total > 20);
+    /* At most the 48-byte block, if it is still queued from the other thread */
+    CHECK(active <= 1);
+    sylves_slab_allocator_destroy(slab);
+    printf("  slab_allocator: PASSED\n");
+}
+
+void test_scratch_arena() {
+    printf("Testing scratch arena...\n");
+    SylvesArena* arena = sylves_arena_create(256);
+    CHECK(arena != NULL);
+    CHECK(sylves_arena_get_used(arena) == 0 && sylves_arena_get_capacity(arena) == 0);
+
+    /* Bump allocations are aligned and contiguous within a block */
+    char* a = (char*)sylves_arena_alloc(arena, 10);
+    char* b = (char*)sylves_arena_alloc(arena, 20);
+    CHECK(a && b && ((uintptr_t)a % SYLVES_ARENA_ALIGNMENT) == 0 && ((uintptr_t)b % SYLVES_ARENA_ALIGNMENT) == 0);
+    CHECK(b == a + SYLVES_ARENA_ALIGNMENT);
+    CHECK(sylves_arena_get_used(arena) == 30 && sylves_arena_get_capacity(arena) == 256);
+
+    /* Marks nest; popping one spills back into the same memory */
+    SylvesArenaMark outer = sylves_arena_push(arena);
+    int* zeros = (int*)sylves_arena_calloc(arena, 50, sizeof(int));
+    CHECK(zeros && zeros[0] == 0 && zeros[49] == 0);
+    SylvesArenaMark inner = sylves_arena_push(arena);
+    void* spill = sylves_arena_alloc(arena, 200);      /* needs a second block */
+    void* large = sylves_arena_alloc(arena, 4096);     /* gets a block of its own */
+    CHECK(spill && large && sylves_arena_get_capacity(arena) == 256 * 2 + 4096);
+    sylves_arena_pop(arena, inner);
+    CHECK(sylves_arena_get_used(arena) == 30 + 200);
+    CHECK(sylves_arena_get_capacity(arena) == 256 * 2);  /* oversized block freed, standard one kept */
+    CHECK(sylves_arena_alloc(arena, 200) == spill);
+    sylves_arena_pop(arena, outer);
+    CHECK(sylves_arena_get_used(arena) == 30);
+    CHECK(sylves_arena_calloc(arena, 50, sizeof(int)) == zeros);
+
+    sylves_arena_reset(arena);
+    CHECK(sylves_arena_get_used(arena) == 0 && sylves_arena_get_capacity(arena) == 256 * 2);
+    sylves_arena_trim(arena);
+    CHECK(sylves_arena_get_capacity(arena) == 0);
+    sylves_arena_destroy(arena);
+
+    /* Spanning tree and outline temporaries come from the arena and are popped */
+    SylvesGrid* grid = sylves_square_grid_create_bounded(1.0, 0, 0, 9, 9);
+    SylvesCell cells[100];
+    for (int i = 0; i < 100; i++) cells[i] = sylves_cell_create(i % 10, i / 10, 0);
+    arena = sylves_arena_create(0);
+    char* before = (char*)sylves_arena_alloc(arena, 1);
+    SylvesEdge* edges = NULL;
+    size_t edge_count = 0;
+    CHECK(sylves_kruskal_mst_with_arena(grid, cells, 100, NULL, NULL, arena, &edges, &edge_count) == SYLVES_SUCCESS);
+    CHECK(edge_count == 99);
+    CHECK(sylves_arena_get_used(arena) == 1 && sylves_arena_get_capacity(arena) > 0);
+    CHECK(sylves_arena_alloc(arena, 1) == before + SYLVES_ARENA_ALIGNMENT);
+    sylves_free(edges);
+
+    SylvesArena* scratch = sylves_get_thread_scratch_arena();
+    CHECK(scratch != NULL && scratch == sylves_get_thread_scratch_arena());
+    size_t scratch_used = sylves_arena_get_used(scratch);
+    CHECK(sylves_kruskal_mst(grid, cells, 100, NULL, NULL, &edges, &edge_count) == SYLVES_SUCCESS);
+    CHECK(edge_count == 99);
+    sylves_free(edges);
+    SylvesOutlineSegment* segments = NULL;
+    size_t segment_count = 0;
+    CHECK(sylves_outline_cells(grid, cells, 100, &segments, &segment_count) == SYLVES_SUCCESS);
+    sylves_free(segments);
+    CHECK(sylves_arena_get_used(scratch) == scratch_used);
+
+    /* BFS direction buffers are scratch memory too */
+    SylvesBFSPathfinding* bfs = sylves_bfs_create(grid, cells[0], NULL, NULL);
+    sylves_bfs_run(bfs, NULL, 0, -1);
+    CHECK(sylves_bfs_is_reachable(bfs, cells[99], NULL));
+    CHECK(sylves_arena_get_used(scratch) == scratch_used);
+    sylves_bfs_destroy(bfs);
+
+    sylves_arena_destroy(arena);
+    sylves_grid_destroy(grid);
+    printf("  scratch arena: PASSED\n");
+}
+
+void test_priority_queues() {
+    printf("Testing indexed and radix heaps...\n");
+    enum { HANDLES = 500 };
+    static float best[HANDLES], radix_best[HANDLES];
+    SylvesIndexedHeap* heap = sylves_indexed_heap_create(0);
+    SylvesRadixHeap* radix = sylves_radix_heap_create();
+    CHECK(heap != NULL && radix != NULL);
+
+    /* Several rounds, so clear has to hide the previous round's positions */
+    unsigned seed = 3;
+    for (int round = 0; round < 3; round++) {
+        for (int h = 0; h < HANDLES; h++) best[h] = FLT_MAX;
+        sylves_indexed_heap_clear(heap);
+        sylves_radix_heap_clear(radix);
+
+        /* Repeated pushes per handle keep only the lowest key */
+        size_t queued = 0;
+        for (int i = 0; i < 4 * HANDLES; i++) {
+            seed = seed * 1103515245u + 12345u;
+            uint32_t h = (seed >> 8) % HANDLES;
+            float key = (float)((seed >> 4) % 1000) * 0.25f;
+            if (best[h] == FLT_MAX) queued++;
+            if (key < best[h]) best[h] = key;
+            CHECK(sylves_indexed_heap_push(heap, h, key));
+            CHECK(sylves_radix_heap_push(radix, h, key));
+        }
+        memcpy(radix_best, best, sizeof(best));
+        CHECK(sylves_indexed_heap_contains(heap, 0) == (best[0] != FLT_MAX));
+        CHECK(!sylves_indexed_heap_decrease_key(heap, 0, FLT_MAX));
+
+        /* Both pop every queued handle exactly once, at its best key, in key order */
+        size_t popped = 0;
+        float previous = -1.0f;
+        uint32_t h, radix_h;
+        float key, radix_key;
+        while (sylves_indexed_heap_pop(heap, &h, &key)) {
+            CHECK(sylves_radix_heap_pop(radix, &radix_h, &radix_key));
+            /* Ties may pop in either order, so each queue is checked against its own copy */
+            CHECK(key >= previous && key == best[h] && radix_key == key && radix_best[radix_h] == key);
+            best[h] = -1.0f;
+            radix_best[radix_h] = -1.0f;
+            previous = key;
+            popped++;
+        }
+        CHECK(popped == queued && sylves_radix_heap_is_empty(radix));
+    }
+
+    /* Radix keys below the last pop are raised to it */
+    sylves_radix_heap_clear(radix);
+    CHECK(sylves_radix_heap_push(radix, 1, 10.0f));
+    CHECK(sylves_radix_heap_pop(radix, NULL, NULL));
+    CHECK(sylves_radix_heap_push(radix, 2, 4.0f));
+    float key = 0.0f;
+    CHECK(sylves_radix_heap_peek_key(radix, &key) && key == 10.0f);
+
+    /* Indexed keys can also rise, and handles can leave from the middle */
+    sylves_indexed_heap_clear(heap);
+    for (uint32_t h = 0; h < 64; h++) {
+        CHECK(sylves_indexed_heap_push(heap, h, (float)h));
+    }
+    CHECK(sylves_indexed_heap_update(heap, 0, 100.0f) && sylves_indexed_heap_update(heap, 63, 0.5f));
+    CHECK(sylves_indexed_heap_remove(heap, 20) && !sylves_indexed_heap_remove(heap, 20));
+    float previous = -1.0f;
+    size_t popped = 0;
+    uint32_t h;
+    while (sylves_indexed_heap_pop(heap, &h, &key)) {
+        CHECK(key >= previous && h != 20);
+        previous = key;
+        popped++;
+    }
+    CHECK(popped == 63 && h == 0);
+
+    sylves_radix_heap_destroy(radix);
+    sylves_indexed_heap_destroy(heap);
+    printf("  priority_queues: PASSED\n");
+}
+
+/* Entering a cell costs 1-4, so a step and its reverse usually differ */
+static float path_terrain_cost(const SylvesStep* step, void* user_data) {
+    (void)user_data;
+    if (!path_wall_accessible(step->dest, NULL)) return -1.0f;
+    return (float)(1 + ((step->dest.x * 7 + step->dest.y * 3) & 3));
+}
+
+void test_pathfinding_bidirectional() {
+    printf("Testing bidirectional A* and multi-target Dijkstra...\n");
+    SylvesGrid* grid = sylves_square_grid_create(1.0);
+    SylvesGrid* bounded = sylves_square_grid_create_bounded(1.0, 0, 0, 40, 40);
+    CHECK(grid != NULL && bounded != NULL);
+    SylvesCell origin = { 0, 0, 0 };
+
+    SylvesCellPath* path = sylves_find_path_bidirectional(grid, origin, (SylvesCell){ 10, 0, 0 },
+                                                          path_wall_accessible, NULL, NULL);
+    CHECK(path != NULL && path->step_count == 26 && path_steps_connected(path, origin, (SylvesCell){ 10, 0, 0 }));
+    sylves_cell_path_destroy(path);
+
+    /* Must agree with one-directional search, including on asymmetric costs */
+    unsigned seed = 5;
+    for (int q = 0; q < 100; q++) {
+        seed = seed * 1103515245u + 12345u;
+        SylvesCell src = { (int)((seed >> 8) % 41), (int)((seed >> 16) % 41), 0 };
+        seed = seed * 1103515245u + 12345u;
+        SylvesCell dest = { (int)((seed >> 8) % 41), (int)((seed >> 16) % 41), 0 };
+        if (src.x == 5) src.x = 6;
+        if (dest.x == 5) dest.x = 6;
+        float expected = -1.0f, distance = -2.0f;
+        CHECK(sylves_find_distance(bounded, src, dest, NULL, path_terrain_cost, NULL, &expected) == SYLVES_SUCCESS);
+        SylvesBidirAStarPathfinding* bidir = sylves_bidir_astar_create(bounded, src, dest, path_terrain_cost, NULL, NULL);
+        CHECK(bidir != NULL && sylves_bidir_astar_run(bidir));
+        CHECK(sylves_bidir_astar_get_distance(bidir, &distance) == SYLVES_SUCCESS && distance == expected);
+        path = sylves_bidir_astar_extract_path(bidir);
+        CHECK(path != NULL && path->total_length == expected);
+        CHECK(path->step_count == 0 ? sylves_cell_equals(src, dest) : sylves_cell_equals(path->steps[0].src, src));
+        CHECK(path->step_count == 0 || sylves_cell_equals(path->steps[path->step_count - 1].dest, dest));
+        sylves_cell_path_destroy(path);
+        sylves_bidir_astar_destroy(bidir);
+    }
+    CHECK(sylves_find_path_bidirectional(bounded, origin, (SylvesCell){ 20, 20, 0 }, path_ring_accessible,
+                                         NULL, NULL) == NULL);
+
+    /* Two sources: every target is measured from the nearer one */
+    SylvesCell sources[2] = { { 0, 0, 0 }, { 30, 0, 0 } };
+    SylvesCell targets[3] = { { 10, 0, 0 }, { 25, 3, 0 }, { 10, 0, 0 } };
+    SylvesDijkstraPathfinding* dijkstra = sylves_dijkstra_create_multi_source(grid, sources, 2, NULL, NULL);
+    CHECK(dijkstra != NULL);
+    sylves_dijkstra_run_targets(dijkstra, targets, 3, FLT_MAX);
+    path = sylves_dijkstra_extract_path(dijkstra, targets[1]);
+    CHECK(path != NULL && path->step_count == 8 && sylves_cell_equals(path->steps[0].src, sources[1]));
+    sylves_cell_path_destroy(path);
+    path = sylves_dijkstra_extract_path(dijkstra, targets[0]);
+    CHECK(path != NULL && path->step_count == 10 && sylves_cell_equals(path->steps[0].src, sources[0]));
+    sylves_cell_path_destroy(path);
+    /* Stopped at the farthest target (10): nothing much beyond radius 10 was settled */
+    size_t count = 0;
+    CHECK(sylves_dijkstra_get_distances(dijkstra, NULL, NULL, &count) == SYLVES_SUCCESS);
+    CHECK(count <= 2 * (size_t)(2 * 11 * 12 + 1));
+    CHECK(sylves_dijkstra_extract_path(dijkstra, (SylvesCell){ 15, 15, 0 }) == NULL);
+    /* Resuming with a farther target continues the same search */
+    sylves_dijkstra_run_targets(dijkstra, &(SylvesCell){ 15, 15, 0 }, 1, FLT_MAX);
+    path = sylves_dijkstra_extract_path(dijkstra, (SylvesCell){ 15, 15, 0 });
+    CHECK(path != NULL && path->step_count == 30);
+    sylves_cell_path_destroy(path);
+    sylves_dijkstra_destroy(dijkstra);
+
+    /* Resuming must expand the target the last run stopped at: on a line it is the only way on,
+       and on the open grid skipping it detours */
+    SylvesGrid* line = sylves_square_grid_create_bounded(1.0, 0, 0, 9, 0);
+    SylvesGrid* lines[2] = { line, grid };
+    for (int g = 0; g < 2; g++) {
+        dijkstra = sylves_dijkstra_create(lines[g], origin, NULL, NULL);
+        CHECK(dijkstra != NULL);
+        sylves_dijkstra_run(dijkstra, &(SylvesCell){ 3, 0, 0 }, FLT_MAX);
+        sylves_dijkstra_run(dijkstra, &(SylvesCell){ 6, 0, 0 }, FLT_MAX);
+        path = sylves_dijkstra_extract_path(dijkstra, (SylvesCell){ 6, 0, 0 });
+        CHECK(path != NULL && path->step_count == 6);
+        sylves_cell_path_destroy(path);
+        sylves_dijkstra_destroy(dijkstra);
+    }
+    sylves_grid_destroy(line);
+
+    sylves_grid_destroy(bounded);
+    sylves_grid_destroy(grid);
+    printf("  pathfinding_bidirectional: PASSED\n");
+}
+
+/* Scattered single-cell pillars in a 41x41 box, plus the wall column */
+static bool path_pillar_accessible(SylvesCell cell, void* user_data) {
+    (void)user_data;
+    if (cell.x < 0 || cell.y < 0 || cell.x > 40 || cell.y > 40) return false;
+    return path_wall_accessible(cell, NULL) && ((cell.x * 13 + cell.y * 7 + cell.z * 5) % 9 != 0);
+}
+
+void test_pathfinding_jps() {
+    printf("Testing jump point search...\n");
+    SylvesGrid* grid = sylves_square_grid_create(1.0);
+    SylvesGrid* bounded = sylves_square_grid_create_bounded(1.0, 0, 0, 40, 40);
+    SylvesGrid* cube = sylves_cube_grid_create_bounded(1.0, 0, 0, 0, 40, 40, 6);
+    CHECK(grid != NULL && bounded != NULL && cube != NULL);
+    SylvesCell origin = { 0, 0, 0 };
+
+    SylvesCellPath* path = sylves_find_path_jps(grid, origin, (SylvesCell){ 10, 0, 0 }, path_wall_accessible, NULL);
+    CHECK(path != NULL && path->step_count == 26 && path_steps_connected(path, origin, (SylvesCell){ 10, 0, 0 }));
+    sylves_cell_path_destroy(path);
+    /* Open field on an infinite grid: scans stop at SYLVES_JPS_MAX_JUMP instead of running forever */
+    path = sylves_find_path_jps(grid, origin, (SylvesCell){ -150, 90, 0 }, NULL, NULL);
+    CHECK(path != NULL && path->step_count == 240 && path_steps_connected(path, origin, (SylvesCell){ -150, 90, 0 }));
+    sylves_cell_path_destroy(path);
+
+    /* Scanned and table-driven searches must both match A* step counts */
+    SylvesJPSJumpTable* table = sylves_jps_jump_table_create(bounded, path_pillar_accessible, NULL);
+    CHECK(table != NULL);
+    CHECK(sylves_jps_jump_table_create(grid, NULL, NULL) == NULL);
+    unsigned seed = 13;
+    for (int q = 0; q < 200; q++) {
+        seed = seed * 1103515245u + 12345u;
+        SylvesCell src = { (int)((seed >> 8) % 41), (int)((seed >> 16) % 41), 0 };
+        seed = seed * 1103515245u + 12345u;
+        SylvesCell dest = { (int)((seed >> 8) % 41), (int)((seed >> 16) % 41), 0 };
+        if (!path_pillar_accessible(src, NULL) || !path_pillar_accessible(dest, NULL)) continue;
+
+        float expected = -1.0f;
+        bool reachable = sylves_find_distance(bounded, src, dest, path_pillar_accessible, NULL, NULL,
+                                              &expected) == SYLVES_SUCCESS;
+        path = sylves_find_path_jps(bounded, src, dest, path_pillar_accessible, NULL);
+        CHECK(reachable == (path != NULL));
+        CHECK(!path || (path->total_length == expected && path_steps_connected(path, src, dest)));
+        sylves_cell_path_destroy(path);
+
+        SylvesJPSPathfinding* jps = sylves_jps_create_with_table(table, src);
+        CHECK(jps != NULL);
+        sylves_jps_run(jps, dest);
+        path = sylves_jps_extract_path(jps, dest);
+        CHECK(reachable == (path != NULL));
+        CHECK(!path || (path->total_length == expected && path_steps_connected(path, src, dest)));
+        sylves_cell_path_destroy(path);
+        sylves_jps_destroy(jps);
+    }
+    sylves_jps_jump_table_destroy(table);
+
+    /* Cube grids scan z, then y, then x; pillars stand in every layer */
+    SylvesJPSPathfinding* jps = sylves_jps_create(cube, (SylvesCell){ 1, 1, 0 }, path_pillar_accessible, NULL);
+    CHECK(jps != NULL);
+    sylves_jps_run(jps, (SylvesCell){ 38, 36, 6 });
+    path = sylves_jps_extract_path(jps, (SylvesCell){ 38, 36, 6 });
+    CHECK(path != NULL && path->step_count == 78);
+    CHECK(path_steps_connected(path, (SylvesCell){ 1, 1, 0 }, (SylvesCell){ 38, 36, 6 }));
+    for (size_t i = 0; i < path->step_count; i++) {
+        CHECK(path_pillar_accessible(path->steps[i].dest, NULL));
+    }
+    sylves_cell_path_destroy(path);
+    sylves_jps_destroy(jps);
+
+    sylves_grid_destroy(cube);
+    sylves_grid_destroy(bounded);
+    sylves_grid_destroy(grid);
+    printf("  pathfinding_jps: PASSED\n");
+}
+
+/* Straight path of `length` steps from start along (dx, dy) */
+static SylvesCellPath* make_line_path(SylvesCell start, int dx, int dy, int length) {
+    SylvesStep steps[32];
+    SylvesCell cell = start;
+    for (int i = 0; i < length; i++) {
+        steps[i] = (SylvesStep){ .src = cell, .length = 1.0f };
+        cell.x += dx;
+        cell.y += dy;
+        steps[i].dest = cell;
+    }
+    return sylves_cell_path_create(steps, (size_t)length);
+}
+
+static bool beyond_column_7(SylvesCell cell, void* user_data) {
+    (void)user_data;
+    return cell.x > 7;
+}
+
+void test_path_cache_invalidation() {
+    printf("Testing path cache invalidation...\n");
+
+    /* Ten row paths and ten column paths over a 10x10 block */
+    SylvesPathCache* cache = sylves_path_cache_create(64, true);
+    CHECK(cache != NULL);
+    for (int i = 0; i < 10; i++) {
+        SylvesCell row = { 0, i, 0 }, row_end = { 9, i, 0 };
+        SylvesCell column = { i, 0, 0 }, column_end = { i, 9, 0 };
+        CHECK(sylves_path_cache_put(cache, &row, &row_end, make_line_path(row, 1, 0, 9)) == SYLVES_SUCCESS);
+        CHECK(sylves_path_cache_put(cache, &column, &column_end, make_line_path(column, 0, 1, 9)) == SYLVES_SUCCESS);
+    }
+    SylvesPathCacheInvalidationStats stats;
+    sylves_path_cache_get_invalidation_stats(cache, &stats);
+    CHECK(stats.indexed_cells == 100 && stats.invalidated == 0);
+
+    /* Only the row and the column through a cell are dropped */
+    SylvesCell door = { 3, 5, 0 };
+    sylves_path_cache_invalidate_cell(cache, &door);
+    SylvesCell row5 = { 0, 5, 0 }, row5_end = { 9, 5, 0 }, row6 = { 0, 6, 0 }, row6_end = { 9, 6, 0 };
+    CHECK(sylves_path_cache_get(cache, &row5, &row5_end) == NULL);
+    CHECK(sylves_path_cache_get(cache, &row6, &row6_end) != NULL);
+
+    SylvesCell doors[3] = { { 7, 7, 0 }, { 7, 8, 0 }, { 50, 50, 0 } };
+    CHECK(sylves_path_cache_invalidate_cells(cache, doors, 3) == 3);
+    CHECK(sylves_path_cache_invalidate_cells(cache, &doors[2], 1) == 0);
+    sylves_path_cache_get_invalidation_stats(cache, &stats);
+    CHECK(stats.invalidated == 5 && stats.kept == 18 + 15 + 15);
+
+    /* A replaced path is indexed by its new cells only */
+    SylvesCell row0 = { 0, 0, 0 }, row0_end = { 9, 0, 0 };
+    SylvesCellPath* detour = make_line_path(row0, 0, -1, 3);
+    CHECK(sylves_path_cache_put(cache, &row0, &row0_end, detour) == SYLVES_SUCCESS);
+    SylvesCell old_cell = { 4, 0, 0 }, new_cell = { 0, -2, 0 };
+    CHECK(sylves_path_cache_invalidate_cells(cache, &old_cell, 1) == 1);    /* column 4 alone */
+    CHECK(sylves_path_cache_get(cache, &row0, &row0_end) == detour);
+    CHECK(sylves_path_cache_invalidate_cells(cache, &new_cell, 1) == 1);
+    CHECK(sylves_path_cache_get(cache, &row0, &row0_end) == NULL);
+
+    /* Region invalidation tests each indexed cell: all six rows left and columns 8 and 9 go */
+    CHECK(sylves_path_cache_invalidate_region(cache, beyond_column_7, NULL) == 6 + 2);
+    sylves_path_cache_get_invalidation_stats(cache, &stats);
+    CHECK(stats.indexed_cells == 5 * 10);
+    sylves_path_cache_destroy(cache);
+
+    /* Evicted paths leave the index */
+    cache = sylves_path_cache_create(4, false);
+    CHECK(cache != NULL);
+    for (int i = 0; i < 10; i++) {
+        SylvesCell row = { 0, i, 0 }, row_end = { 9, i, 0 };
+        CHECK(sylves_path_cache_put(cache, &row, &row_end, make_line_path(row, 1, 0, 9)) == SYLVES_SUCCESS);
+    }
+    sylves_path_cache_get_invalidation_stats(cache, &stats);
+    CHECK(stats.indexed_cells == 4 * 10);
+    SylvesCell evicted = { 5, 0, 0 }, cached = { 5, 9, 0 };
+    CHECK(sylves_path_cache_invalidate_cells(cache, &evicted, 1) == 0);
+    CHECK(sylves_path_cache_invalidate_cells(cache, &cached, 1) == 1);
+    sylves_path_cache_destroy(cache);
+    printf("  path_cache_invalidation: PASSED\n");
+}
+
+/* Pillars plus one cell closed by test_pathfinding_hpa */
+static SylvesCell hpa_closed = { -1, -1, 0 };
+
+static bool path_hpa_accessible(SylvesCell cell, void* user_data) {
+    return path_pillar_accessible(cell, user_data) && !sylves_cell_equals(cell, hpa_closed);
+}
+
+static float path_hpa_heuristic(SylvesCell a, SylvesCell b, void* user_data) {
+    (void)user_data;
+    return sylves_heuristic_manhattan(a, b, 1.0f);
+}
+
+void test_pathfinding_hpa() {
+    printf("Testing hierarchical pathfinding...\n");
+    SylvesGrid* grid = sylves_square_grid_create(1.0);
+    SylvesGrid* bounded = sylves_square_grid_create_bounded(1.0, 0, 0, 40, 40);
+    CHECK(grid != NULL && bounded != NULL);
+    CHECK(sylves_hpa_create(grid, 8, NULL, NULL, NULL, NULL) == NULL);
+
+    SylvesHierarchicalPathfinding* hpa = sylves_hpa_create(bounded, 8, path_hpa_accessible, NULL,
+                                                           path_hpa_heuristic, NULL);
+    CHECK(hpa != NULL && sylves_hpa_get_node_count(hpa) > 0);
+
+    /* Refined paths are connected and close to optimal; reachability matches exactly */
+    unsigned seed = 29;
+    float total = 0.0f, optimal = 0.0f;
+    for (int q = 0; q < 200; q++) {
+        seed = seed * 1103515245u + 12345u;
+        SylvesCell src = { (int)((seed >> 8) % 41), (int)((seed >> 16) % 41), 0 };
+        seed = seed * 1103515245u + 12345u;
+        SylvesCell dest = { (int)((seed >> 8) % 41), (int)((seed >> 16) % 41), 0 };
+        if (!path_hpa_accessible(src, NULL) || !path_hpa_accessible(dest, NULL)) continue;
+
+        float expected = -1.0f;
+        bool reachable = sylves_find_distance(bounded, src, dest, path_hpa_accessible, NULL, NULL,
+                                              &expected) == SYLVES_SUCCESS;
+        SylvesCellPath* path = sylves_hpa_find_path(hpa, src, dest);
+        CHECK(reachable == (path != NULL));
+        CHECK(!path || (path->total_length >= expected && path_steps_connected(path, src, dest)));
+        if (path) {
+            total += path->total_length;
+            optimal += expected;
+        }
+        sylves_cell_path_destroy(path);
+    }
+    CHECK(total <= optimal * 1.1f);
+
+    /* Closing a cell on a cached path rebuilds its cluster and drops the cached path */
+    SylvesPathCache* cache = sylves_path_cache_create(64, false);
+    CHECK(cache != NULL);
+    sylves_hpa_set_path_cache(hpa, cache);
+    SylvesCell src = { 7, 1, 0 }, dest = { 38, 36, 0 };
+    SylvesCellPath* path = sylves_hpa_find_path(hpa, src, dest);
+    CHECK(path != NULL && path->step_count > 20);
+    CHECK(sylves_path_cache_get(cache, &src, &dest) != NULL);
+    hpa_closed = path->steps[path->step_count / 2].dest;
+    sylves_cell_path_destroy(path);
+
+    CHECK(sylves_hpa_notify_cells_changed(hpa, &hpa_closed, 1) == SYLVES_SUCCESS);
+    CHECK(sylves_path_cache_get(cache, &src, &dest) == NULL);
+    path = sylves_hpa_find_path(hpa, src, dest);
+    CHECK(path != NULL && path_steps_connected(path, src, dest));
+    for (size_t i = 0; i < path->step_count; i++) {
+        CHECK(!sylves_cell_equals(path->steps[i].dest, hpa_closed));
+    }
+    sylves_cell_path_destroy(path);
+
+    /* Reopening it restores the original abstract graph */
+    SylvesCell reopened = hpa_closed;
+    hpa_closed = (SylvesCell){ -1, -1, 0 };
+    CHECK(sylves_hpa_notify_cells_changed(hpa, &reopened, 1) == SYLVES_SUCCESS);
+    SylvesHierarchicalPathfinding* fresh = sylves_hpa_create(bounded, 8, path_hpa_accessible, NULL,
+                                                             path_hpa_heuristic, NULL);
+    CHECK(fresh != NULL && sylves_hpa_get_node_count(fresh) == sylves_hpa_get_node_count(hpa));
+    sylves_hpa_destroy(fresh);
+
+    sylves_hpa_destroy(hpa);
+    sylves_path_cache_destroy(cache);
+    sylves_grid_destroy(bounded);
+    sylves_grid_destroy(grid);
+    printf("  pathfinding_hpa: PASSED\n");
+}
+
+/* Pillars plus the cells closed by test_pathfinding_dstar: one per tick, then the 4 walls around the goal */
+static SylvesCell dstar_closed[12];
+static size_t dstar_closed_count;
+
+static bool path_dstar_accessible(SylvesCell cell, void* user_data) {
+    for (size_t i = 0; i < dstar_closed_count; i++) {
+        if (sylves_cell_equals(cell, dstar_closed[i])) return false;
+    }
+    return path_pillar_accessible(cell, user_data);
+}
+
+void test_pathfinding_dstar() {
+    printf("Testing D* Lite replanning...\n");
+    SylvesGrid* bounded = sylves_square_grid_create_bounded(1.0, 0, 0, 40, 40);
+    CHECK(bounded != NULL);
+    SylvesCell start = { 7, 1, 0 }, goal = { 38, 36, 0 };
+    dstar_closed_count = 0;
+
+    SylvesDStarLite* dstar = sylves_dstar_create(bounded, start, goal, path_dstar_accessible, NULL,
+                                                 path_hpa_heuristic, NULL);
+    CHECK(dstar != NULL);
+    CHECK(sylves_dstar_compute(dstar) == SYLVES_SUCCESS);
+    size_t initial_expansions = sylves_dstar_get_expansions(dstar);
+
+    /* Walk the path, closing a cell a few steps ahead every tick; each replan must stay optimal */
+    size_t replan_expansions = 0;
+    for (int tick = 0; tick < 8; tick++) {
+        SylvesCellPath* path = sylves_dstar_extract_path(dstar);
+        float expected = -1.0f;
+        CHECK(sylves_find_distance(bounded, start, goal, path_dstar_accessible, NULL, NULL, &expected) == SYLVES_SUCCESS);
+        CHECK(path != NULL && path->total_length == expected && path_steps_connected(path, start, goal));
+        CHECK(path->step_count > 4);
+
+        dstar_closed[dstar_closed_count++] = path->steps[4].dest;
+        start = path->steps[0].dest;
+        sylves_cell_path_destroy(path);
+        sylves_dstar_move_start(dstar, start);
+        CHECK(sylves_dstar_notify_cell_changed(dstar, dstar_closed[dstar_closed_count - 1]) == SYLVES_SUCCESS);
+
+        size_t before = sylves_dstar_get_expansions(dstar);
+        CHECK(sylves_dstar_compute(dstar) == SYLVES_SUCCESS);
+        replan_expansions += sylves_dstar_get_expansions(dstar) - before;
+    }
+    /* Repairs touch a small part of the tree compared to searching again */
+    CHECK(replan_expansions * 10 < initial_expansions * 8);
+
+    /* Walling in the goal makes it unreachable until a wall reopens */
+    SylvesCell around[4] = { { 37, 36, 0 }, { 39, 36, 0 }, { 38, 35, 0 }, { 38, 37, 0 } };
+    size_t open_count = dstar_closed_count;
+    for (int i = 0; i < 4; i++) {
+        dstar_closed[dstar_closed_count] = around[i];
+        if (path_dstar_accessible(around[i], NULL)) dstar_closed_count++;
+        CHECK(sylves_dstar_notify_cell_changed(dstar, around[i]) == SYLVES_SUCCESS);
+    }
+    CHECK(sylves_dstar_compute(dstar) == SYLVES_ERROR_PATH_NOT_FOUND);
+    CHECK(sylves_dstar_extract_path(dstar) == NULL);
+    dstar_closed_count = open_count;
+    for (int i = 0; i < 4; i++) {
+        CHECK(sylves_dstar_notify_cell_changed(dstar, around[i]) == SYLVES_SUCCESS);
+    }
+    CHECK(sylves_dstar_compute(dstar) == SYLVES_SUCCESS);
+    SylvesCellPath* path = sylves_dstar_extract_path(dstar);
+    float expected = -1.0f;
+    CHECK(sylves_find_distance(bounded, start, goal, path_dstar_accessible, NULL, NULL, &expected) == SYLVES_SUCCESS);
+    CHECK(path != NULL && path->total_length == expected && path_steps_connected(path, start, goal));
+    sylves_cell_path_destroy(path);
+
+    sylves_dstar_destroy(dstar);
+    sylves_grid_destroy(bounded);
+    printf("  pathfinding_dstar: PASSED\n");
+}
+
+static float flow_field_cost(SylvesCell cell, void* user_data) {
+    (void)user_data;
+    if (!path_pillar_accessible(cell, NULL)) return -1.0f;
+    return cell.x >= 20 ? 2.0f : 1.0f;
+}
+
+void test_flow_field() {
+    printf("Testing flow fields...\n");
+    SylvesGrid* grid = sylves_square_grid_create(1.0);
+    SylvesGrid* bounded = sylves_square_grid_create_bounded(1.0, 0, 0, 40, 40);
+    CHECK(grid != NULL && bounded != NULL);
+    CHECK(sylves_flow_field_create(grid, 1) == NULL);
+
+    SylvesFlowField* serial = sylves_flow_field_create(bounded, 1);
+    SylvesFlowField* parallel = sylves_flow_field_create(bounded, 4);
+    CHECK(serial != NULL && parallel != NULL);
+
+    /* BFS distances match the nearest goal and do not depend on the thread count */
+    SylvesCell goals[3] = { { 7, 1, 0 }, { 38, 36, 0 }, { 20, 33, 0 } };
+    CHECK(sylves_flow_field_compute_bfs(serial, goals, 3, path_pillar_accessible, NULL) == SYLVES_SUCCESS);
+    CHECK(sylves_flow_field_compute_bfs(parallel, goals, 3, path_pillar_accessible, NULL) == SYLVES_SUCCESS);
+    int count = sylves_grid_get_index_count(bounded);
+    const float* distances = sylves_flow_field_get_distances(parallel);
+    CHECK(memcmp(distances, sylves_flow_field_get_distances(serial), sizeof(float) * (size_t)count) == 0);
+    CHECK(memcmp(sylves_flow_field_get_directions(parallel), sylves_flow_field_get_directions(serial),
+                 (size_t)count) == 0);
+
+    for (int i = 0; i < count; i += 7) {
+        SylvesCell cell;
+        CHECK(sylves_grid_get_cell_by_index(bounded, i, &cell) == SYLVES_SUCCESS);
+        float nearest = FLT_MAX;
+        for (int g = 0; g < 3; g++) {
+            float d;
+            if (path_pillar_accessible(cell, NULL) &&
+                sylves_find_distance(bounded, cell, goals[g], path_pillar_accessible, NULL, NULL, &d) == SYLVES_SUCCESS &&
+                d < nearest) {
+                nearest = d;
+            }
+        }
+        CHECK(distances[i] == nearest);
+
+        /* Following directions walks downhill to a goal */
+        if (nearest == FLT_MAX) continue;
+        SylvesCellDir dir;
+        int steps = 0;
+        while (sylves_flow_field_get_direction(parallel, cell, &dir)) {
+            CHECK(sylves_grid_try_move(bounded, cell, dir, &cell, NULL, NULL));
+            CHECK(path_pillar_accessible(cell, NULL));
+            steps++;
+        }
+        CHECK(steps == (int)nearest && distances[sylves_grid_get_index(bounded, cell)] == 0.0f);
+    }
+
+    /* Fast marching follows straight lines across open ground */
+    SylvesCell corner = { 0, 0, 0 };
+    CHECK(sylves_flow_field_compute_fast_marching(serial, &corner, 1, NULL, NULL) == SYLVES_SUCCESS);
+    distances = sylves_flow_field_get_distances(serial);
+    float diagonal = distances[sylves_grid_get_index(bounded, (SylvesCell){ 10, 10, 0 })];
+    CHECK(diagonal > 14.0f && diagonal < 15.5f);
+    CHECK(distances[sylves_grid_get_index(bounded, (SylvesCell){ 10, 0, 0 })] == 10.0f);
+
+    /* Weighted costs rise across the expensive half and skip blocked cells */
+    CHECK(sylves_flow_field_compute_fast_marching(parallel, goals, 3, flow_field_cost, NULL) == SYLVES_SUCCESS);
+    distances = sylves_flow_field_get_distances(parallel);
+    const float* bfs = sylves_flow_field_get_distances(serial);
+    CHECK(sylves_flow_field_compute_bfs(serial, goals, 3, path_pillar_accessible, NULL) == SYLVES_SUCCESS);
+    for (int i = 0; i < count; i++) {
+        CHECK((distances[i] == FLT_MAX) == (bfs[i] == FLT_MAX));
+    }
+    sylves_flow_field_destroy(serial);
+    sylves_flow_field_destroy(parallel);
+
+    /* Hex grids use the neighbour table and agree with Dijkstra */
+    SylvesGrid* hex = sylves_hex_grid_create_bounded(SYLVES_HEX_ORIENTATION_FLAT_TOP, 1.0, -6, -6, 6, 6);
+    CHECK(hex != NULL);
+    SylvesFlowField* field = sylves_flow_field_create(hex, 3);
+    CHECK(field != NULL);
+    SylvesCell hex_goal;
+    CHECK(sylves_grid_get_cell_by_index(hex, 0, &hex_goal) == SYLVES_SUCCESS);
+    CHECK(sylves_flow_field_compute_bfs(field, &hex_goal, 1, NULL, NULL) == SYLVES_SUCCESS);
+    distances = sylves_flow_field_get_distances(field);
+    count = sylves_grid_get_index_count(hex);
+    for (int i = 0; i < count; i++) {
+        SylvesCell cell;
+        float expected;
+        CHECK(sylves_grid_get_cell_by_index(hex, i, &cell) == SYLVES_SUCCESS);
+        CHECK(sylves_find_distance(hex, cell, hex_goal, NULL, NULL, NULL, &expected) == SYLVES_SUCCESS);
+        CHECK(distances[i] == expected);
+    }
+    CHECK(sylves_flow_field_compute_fast_marching(field, &hex_goal, 1, NULL, NULL) == SYLVES_SUCCESS);
+    for (int i = 0; i < count; i++) {
+        SylvesCell cell;
+        float expected;
+        CHECK(sylves_grid_get_cell_by_index(hex, i, &cell) == SYLVES_SUCCESS);
+        CHECK(sylves_find_distance(hex, cell, hex_goal, NULL, NULL, NULL, &expected) == SYLVES_SUCCESS);
+        CHECK(fabsf(distances[i] - expected) < 1e-4f);
+    }
+    sylves_flow_field_destroy(field);
+
+    sylves_grid_destroy(hex);
+    sylves_grid_destroy(bounded);
+    sylves_grid_destroy(grid);
+    printf("  flow_field: PASSED\n");
+}
+
 int main() {
     printf("\n=== Sylves C Library Test Suite ===\n\n");
     
@@ -298,6 +2471,31 @@ int main() {
     test_square_grid_bounded();
     test_square_grid_find_cell();
     test_square_grid_polygon();
+    test_try_move_batch();
+    test_cell_buffer_soa();
+    test_mesh_grid_spatial();
+    test_voronoi_grid();
+    test_voronoi_relaxation();
+    test_lazy_grid_chunk_cache();
+    test_lazy_grid_async();
+    test_lazy_grid_shared_readers();
+    test_spatial_index_backends();
+    test_concurrent_containers();
+    test_cache_eviction_policies();
+    test_cache_hash_table();
+    test_concurrent_pool();
+    test_priority_queues();
+    test_pathfinding_searches();
+    test_pathfinding_context();
+    test_pathfinding_dense();
+    test_slab_allocator();
+    test_scratch_arena();
+    test_pathfinding_bidirectional();
+    test_pathfinding_jps();
+    test_pathfinding_hpa();
+    test_path_cache_invalidation();
+    test_pathfinding_dstar();
+    test_flow_field();
     
     printf("\n=== All tests PASSED ===\n\n");
     